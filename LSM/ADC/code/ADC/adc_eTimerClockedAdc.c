@@ -24,11 +24,15 @@
  * the SIUL to route the MCU pins to the ADC inputs needs to be done by the client code
  * prior to starting the conversions with adc_startConversions().\n
  *   The set of channels, which is converted in every cycle is statically configured at
- * compile time. It is not possible to define or change this set at run-time. Moreover, it
- * is not possible to sample different channels at different rates. The conversion cycle is
+ * compile time. It is not possible to define new sets at run-time. The conversion cycle is
  * defined (set of channels, cycle time and settings for a single conversion) and this
  * cycle is repeated all time long. The configuration is done with preprocessor macros,
  * mainly found in the header file adc_eTimerClockedAdc.h.\n
+ *   Up to three such cycles can be configured as so called channel groups. A channel group
+ * is a subset of the enabled channels with its own cycle time. All groups are compiled
+ * into the CTU command list at initialization time and the application can switch between
+ * them at run-time, without stopping the timer, see adc_selectChannelGroup() and
+ * #ADC_NO_CHANNEL_GROUPS.\n
  *   The internal signals (TSENS_0 and TSENS_1) and VREG_1.2V can be configured for
  * conversion as any other channel, however this has specific side effects:\n
  *   - If and only if the temperature signals TSENS_0 and TSENS_1, channels 15, ADC_0 and
@@ -43,8 +47,22 @@
  * the driver can become subject to modifications. A prominent example is the conversion
  * timing. The related settings are chosen for a rather slow sampling rate but better
  * accuracy; a rate of a few kilohertz is targeted. Higher rates may require another
- * timing configuration and much higher rates could even require structural code changes,
- * like DMA support.
+ * timing configuration.
+ *   @remark
+ * Per default, the conversion results are fetched by an interrupt at the end of each
+ * conversion cycle. For higher sampling rates (10 .. 50 kHz), this interrupt becomes too
+ * expensive. The driver can be configured to let the eDMA fetch the results of each cycle
+ * into a ping-pong buffer instead. Then there's only one interrupt per block of cycles
+ * and the client code reads the sample blocks lock-free with adc_getSampleBlock(). See
+ * #ADC_USE_DMA for details.
+ *   @remark
+ * The sampling is triggered by hardware and it is equidistant, but the software sees the
+ * results only at the entry into the end-of-conversion interrupt. The driver measures
+ * this time with the CPU's time base, reconstructs the equidistant time grid from the
+ * measurements and counts the cycles, which are lost because the interrupt is served
+ * too late. The results can be read together with their time stamp, see
+ * adc_getAllChannelRawValues(), and the jitter and latency statistics are available
+ * through adc_getTimingStatistics().
  *   @remark
  * The configuration settings depend on one another. There are several constraints like: A
  * very short cycle time is impossible if the number of active channels is large. Because
@@ -80,12 +98,34 @@
  *   adc_getChannelVoltageAndAge
  *   adc_getTsens0
  *   adc_getTsens1
+ *   adc_getChannelVoltageInMillivolt
+ *   adc_getAllChannelVoltagesInMillivolt
+ *   adc_getAllChannelRawValues
+ *   adc_getTimingStatistics
+ *   adc_getTsens0InCentiDegree
+ *   adc_getTsens1InCentiDegree
+ *   adc_getSampleBlock
+ *   adc_selectChannelGroup
+ *   adc_getActiveChannelGroup
  * Local functions
+ *   initChannelGroups
  *   initETimer
  *   initCTU
  *   compileAdcCommandList
  *   initADC
+ *   initDmaChannel
+ *   initDMA
+ *   computeScaleMillivolt
+ *   toCentiDegree
+ *   filterInternalSignals
+ *   updateDiagnosis
+ *   updateTimestamp
+ *   activateChannelGroup
  *   isrAdcAllConversionsDone
+ *   getIdxDmaCycle
+ *   getIdxDmaBufWr
+ *   fetchDmaCycle
+ *   isrDmaSampleBlockComplete
  */
 
 /*
@@ -148,11 +188,301 @@
     on the configured reference voltage. Here for ADC_1. Do not change the definition. */
 #define ADC_1_BIT_REF_RANGE ((ADC_ADC_1_REF_VOLTAGE >= (3.6f + 4.5f)/2.0f)? 0x80000u: 0x0u)
 
+/* Channel groups: Check the configuration. */
+#if ADC_NO_CHANNEL_GROUPS < 1  ||  ADC_NO_CHANNEL_GROUPS > 3
+# error Bad configuration of ADC_NO_CHANNEL_GROUPS, the range is 1..3
+#endif
+#if ADC_NO_CHANNEL_GROUPS > 1  &&  ADC_USE_DMA == 1
+# error Channel groups are not supported in DMA mode
+#endif
+
+/** The longest cycle time of all channel groups. The prescaler of the eTimer is chosen
+    such that this cycle time can be implemented. */
+#if ADC_NO_CHANNEL_GROUPS == 1
+# define T_CYCLE_MAX_IN_US  (ADC_T_CYCLE_IN_US)
+#elif ADC_NO_CHANNEL_GROUPS == 2
+# define T_CYCLE_MAX_IN_US  (ADC_T_CYCLE_IN_US > ADC_GROUP_1_T_CYCLE_IN_US                 \
+                             ? ADC_T_CYCLE_IN_US                                            \
+                             : ADC_GROUP_1_T_CYCLE_IN_US                                    \
+                            )
+#else
+# define T_CYCLE_MAX_IN_US  (ADC_T_CYCLE_IN_US > ADC_GROUP_1_T_CYCLE_IN_US                 \
+                             ? (ADC_T_CYCLE_IN_US > ADC_GROUP_2_T_CYCLE_IN_US               \
+                                ? ADC_T_CYCLE_IN_US                                         \
+                                : ADC_GROUP_2_T_CYCLE_IN_US                                 \
+                               )                                                            \
+                             : (ADC_GROUP_1_T_CYCLE_IN_US > ADC_GROUP_2_T_CYCLE_IN_US       \
+                                ? ADC_GROUP_1_T_CYCLE_IN_US                                 \
+                                : ADC_GROUP_2_T_CYCLE_IN_US                                 \
+                               )                                                            \
+                            )
+#endif
+
+/* Which prescaler do we need to implement the wanted cycle times? The lower boundary of
+   10us is weak and a bit arbitrary. It will work only if the client code demands only a
+   single conversion per cycle and if the data evaluation is very fast.
+     The macros down here implicitly assume a particular clock rate. The boundaries for the
+   selection of the prescaler need adaptation for another clock rate. */
+#if PERIPHERAL_CLOCK_RATE != 120000000l
+# error The configuration of the eTimer is based on a fixed clock rate of 120 MHz
+#endif
+#if ADC_T_CYCLE_IN_US < 10                                                              \
+    ||  ADC_NO_CHANNEL_GROUPS >= 2  &&  ADC_GROUP_1_T_CYCLE_IN_US < 10                  \
+    ||  ADC_NO_CHANNEL_GROUPS >= 3  &&  ADC_GROUP_2_T_CYCLE_IN_US < 10
+# define DIV_AS_PWR_OF_2 0
+# error A cycle time ADC_T_CYCLE_IN_US or ADC_GROUP_n_T_CYCLE_IN_US is configured too \
+        little. Values below 10us are not supported
+#elif T_CYCLE_MAX_IN_US <= 1092
+# define DIV_AS_PWR_OF_2 0
+#elif T_CYCLE_MAX_IN_US <= 2184
+# define DIV_AS_PWR_OF_2 1
+#elif T_CYCLE_MAX_IN_US <= 4368
+# define DIV_AS_PWR_OF_2 2
+#elif T_CYCLE_MAX_IN_US <= 8737
+# define DIV_AS_PWR_OF_2 3
+#elif T_CYCLE_MAX_IN_US <= 17475
+# define DIV_AS_PWR_OF_2 4
+#elif T_CYCLE_MAX_IN_US <= 34951
+# define DIV_AS_PWR_OF_2 5
+#elif T_CYCLE_MAX_IN_US <= 69903
+# define DIV_AS_PWR_OF_2 6
+#elif T_CYCLE_MAX_IN_US <= 139807
+# define DIV_AS_PWR_OF_2 7
+#else
+# define DIV_AS_PWR_OF_2 7
+# error A cycle time ADC_T_CYCLE_IN_US or ADC_GROUP_n_T_CYCLE_IN_US is configured too \
+        large. Values above 139ms are not supported
+#endif
+
+/** The value of the LOAD register of the eTimer, which implements a given cycle time.
+      +1: Because of the output toggle mode the period is twice the counter cycle time. */
+#define T_CYCLE_REGVAL(type, tiCycleInUs)                                                   \
+            ((type)(0.5 + ((float)PERIPHERAL_CLOCK_RATE / (1u<<(DIV_AS_PWR_OF_2+1)))        \
+                          * ((float)(tiCycleInUs)/1e6)                                      \
+                   )                                                                        \
+             - 1                                                                            \
+            )
+
+/** The duration of a conversion cycle in ticks of the CPU's time base. It is computed
+    from the value of the eTimer's LOAD register, which implements the cycle time, see
+    #T_CYCLE_REGVAL; the rounding of the cycle time to the timer resolution is considered
+    and the time grid of the time stamps doesn't drift. */
+#define T_CYCLE_IN_TICKS(regValLoad)                                                        \
+            ((2u*((uint32_t)(regValLoad)+1u)) << DIV_AS_PWR_OF_2)
+
+_Static_assert( ADC_TIMESTAMP_TICKS_PER_US * 1000000ul == PERIPHERAL_CLOCK_RATE
+              , "The time base and the eTimer are expected to run with the same clock"
+              );
+
+/** The time we need to fetch the results after the conversions of a cycle. See initCTU()
+    for details. */
+#if ADC_USE_DMA == 1
+# define T_DATA_FETCH   1e-6 /* data fetch by DMA */
+#else
+# define T_DATA_FETCH   5e-6 /* data fetch in ISR */
+#endif
+
+/** The number of conversions for a channel group, which is specified by the bit masks of
+    its channels. Both ADCs work in parallel. */
+#define NO_CONVERSIONS(maskAdc0, maskAdc1)                                                  \
+            (__builtin_popcount(maskAdc0) > __builtin_popcount(maskAdc1)                    \
+             ? __builtin_popcount(maskAdc0)                                                 \
+             : __builtin_popcount(maskAdc1)                                                 \
+            )
+
+/** Check a cycle time against the number of conversions it needs to contain. The
+    estimation of the conversion time is explained in initCTU(). */
+#define IS_CYCLE_TIME_SUFFICIENT(noConversions, tiCycleInUs)                                \
+            ((int64_t)(0.5 + 2e-6*(noConversions) * (float)PERIPHERAL_CLOCK_RATE)           \
+             + (int64_t)(T_DATA_FETCH * (float)PERIPHERAL_CLOCK_RATE)                       \
+             + (int64_t)(2e-6 * (float)PERIPHERAL_CLOCK_RATE) /* 2us margin */              \
+             < (int64_t)((tiCycleInUs)*1e-6 * (float)PERIPHERAL_CLOCK_RATE)                 \
+            )
+
+#if ADC_NO_CHANNEL_GROUPS >= 2
+_Static_assert( (ADC_GROUP_1_ADC_0_CHANNELS & ~ADC_ADC_0_CHANNEL_BIT_MASK) == 0
+                &&  (ADC_GROUP_1_ADC_1_CHANNELS & ~ADC_ADC_1_CHANNEL_BIT_MASK) == 0
+                &&  (ADC_GROUP_1_ADC_0_CHANNELS | ADC_GROUP_1_ADC_1_CHANNELS) != 0
+              , "Channel group 1 needs to be a non empty subset of the enabled channels"
+              );
+_Static_assert( IS_CYCLE_TIME_SUFFICIENT( NO_CONVERSIONS( ADC_GROUP_1_ADC_0_CHANNELS
+                                                        , ADC_GROUP_1_ADC_1_CHANNELS
+                                                        )
+                                        , ADC_GROUP_1_T_CYCLE_IN_US
+                                        )
+              , "ADC_GROUP_1_T_CYCLE_IN_US is chosen too little for the number of channels"
+                " of group 1"
+              );
+#endif
+#if ADC_NO_CHANNEL_GROUPS >= 3
+_Static_assert( (ADC_GROUP_2_ADC_0_CHANNELS & ~ADC_ADC_0_CHANNEL_BIT_MASK) == 0
+                &&  (ADC_GROUP_2_ADC_1_CHANNELS & ~ADC_ADC_1_CHANNEL_BIT_MASK) == 0
+                &&  (ADC_GROUP_2_ADC_0_CHANNELS | ADC_GROUP_2_ADC_1_CHANNELS) != 0
+              , "Channel group 2 needs to be a non empty subset of the enabled channels"
+              );
+_Static_assert( IS_CYCLE_TIME_SUFFICIENT( NO_CONVERSIONS( ADC_GROUP_2_ADC_0_CHANNELS
+                                                        , ADC_GROUP_2_ADC_1_CHANNELS
+                                                        )
+                                        , ADC_GROUP_2_T_CYCLE_IN_US
+                                        )
+              , "ADC_GROUP_2_T_CYCLE_IN_US is chosen too little for the number of channels"
+                " of group 2"
+              );
+#endif
+
+/** The number of CTU commands, which are required for all channel groups. The command lists
+    of the groups are stored one after another in the CTU register file CLR[]. A list is
+    terminated by the first command of the next list and the last list by an additional
+    dummy command. */
+#define NO_CTU_COMMANDS                                                                     \
+            (ADC_NO_CONVERSIONS_PER_CYCLE                                                   \
+             + (ADC_NO_CHANNEL_GROUPS >= 2                                                  \
+                ? NO_CONVERSIONS(ADC_GROUP_1_ADC_0_CHANNELS, ADC_GROUP_1_ADC_1_CHANNELS)    \
+                : 0                                                                         \
+               )                                                                            \
+             + (ADC_NO_CHANNEL_GROUPS >= 3                                                  \
+                ? NO_CONVERSIONS(ADC_GROUP_2_ADC_0_CHANNELS, ADC_GROUP_2_ADC_1_CHANNELS)    \
+                : 0                                                                         \
+               )                                                                            \
+             + 1                                                                            \
+            )
+
+#if ADC_USE_DMA == 1
+/** The eDMA channels, which fetch the conversion results from ADC_0 and ADC_1,
+    respectively. Channel 15 is occupied by the serial output. */
+# define DMA_CHN_FOR_ADC_0      (14)
+# define DMA_CHN_FOR_ADC_1      (13)
+
+/** The index of the DMA requests of ADC_0 and ADC_1 at the DMAMUX. The devices are
+    hardwired to the DMAMUX, see table 18-4, MCU ref. manual, p. 388. */
+# define DMAMUX_SOURCE_ADC_0    (26)
+# define DMAMUX_SOURCE_ADC_1    (27)
+
+/* The ADC with more conversions per cycle ends the cycle. The conversion of its last
+   channel raises the DMA request and its DMA channel is the primary one. The other ADC
+   has already completed its conversions at this time. Its results are fetched by a
+   secondary DMA channel, which is linked to the primary one. The secondary channel
+   completes the cycle and raises the interrupt. There's deliberately no DMA request
+   from the other ADC; see initDMA() why its results can't get lost.
+     If both ADCs have the same number of conversions then ADC_0 is the primary one. This
+   is the same rule as for the end-of-conversion interrupt, see initChannelGroups(). */
+# if ADC_ADC_0_NO_ACTIVE_CHNS >= ADC_ADC_1_NO_ACTIVE_CHNS
+#  define IDX_ADC_PRIMARY       0u
+#  define DMA_CHN_PRIMARY       DMA_CHN_FOR_ADC_0
+#  define DMAMUX_SOURCE_PRIMARY DMAMUX_SOURCE_ADC_0
+#  if ADC_ADC_1_NO_ACTIVE_CHNS > 0
+#   define DMA_CHN_SECONDARY    DMA_CHN_FOR_ADC_1
+#  endif
+# else
+#  define IDX_ADC_PRIMARY       1u
+#  define DMA_CHN_PRIMARY       DMA_CHN_FOR_ADC_1
+#  define DMAMUX_SOURCE_PRIMARY DMAMUX_SOURCE_ADC_1
+#  if ADC_ADC_0_NO_ACTIVE_CHNS > 0
+#   define DMA_CHN_SECONDARY    DMA_CHN_FOR_ADC_0
+#  endif
+# endif
+# ifdef DMA_CHN_SECONDARY
+#  define DMA_CHN_IRQ           DMA_CHN_SECONDARY
+# else
+#  define DMA_CHN_IRQ           DMA_CHN_PRIMARY
+# endif
+
+/** Abbreviation for the length of the ping-pong buffer in conversion cycles. */
+# define NO_DMA_CYCLES          (2u*ADC_DMA_NO_CYCLES_PER_BUFFER)
+
+/* The DMA copies a block of CDR registers in each cycle. It uses the modulo addressing to
+   return to the beginning of the block, which requires a block of 2^n registers at an
+   address aligned to its size. The smallest such block, which contains the first and the
+   last enabled channel of an ADC, is determined from the channel masks. */
+# define FIRST_CHN(mask)        ((unsigned int)__builtin_ctz(mask))
+# define LAST_CHN(mask)         (31u - (unsigned int)__builtin_clz(mask))
+# define LOG2_NO_CDRS(f, l)     ((f)==(l)? 0u: ((f)>>1)==((l)>>1)? 1u: ((f)>>2)==((l)>>2)? 2u \
+                                 : ((f)>>3)==((l)>>3)? 3u: 4u                                \
+                                )
+# if ADC_ADC_0_NO_ACTIVE_CHNS > 0
+#  define ADC_0_LOG2_NO_CDRS    LOG2_NO_CDRS( FIRST_CHN(ADC_ADC_0_CHANNEL_BIT_MASK)          \
+                                            , LAST_CHN(ADC_ADC_0_CHANNEL_BIT_MASK)           \
+                                            )
+#  define ADC_0_NO_CDRS         (1u << ADC_0_LOG2_NO_CDRS)
+#  define ADC_0_FIRST_CDR       (FIRST_CHN(ADC_ADC_0_CHANNEL_BIT_MASK) & ~(ADC_0_NO_CDRS-1u))
+# endif
+# if ADC_ADC_1_NO_ACTIVE_CHNS > 0
+#  define ADC_1_LOG2_NO_CDRS    LOG2_NO_CDRS( FIRST_CHN(ADC_ADC_1_CHANNEL_BIT_MASK)          \
+                                            , LAST_CHN(ADC_ADC_1_CHANNEL_BIT_MASK)           \
+                                            )
+#  define ADC_1_NO_CDRS         (1u << ADC_1_LOG2_NO_CDRS)
+#  define ADC_1_FIRST_CDR       (FIRST_CHN(ADC_ADC_1_CHANNEL_BIT_MASK) & ~(ADC_1_NO_CDRS-1u))
+# endif
+#endif /* ADC_USE_DMA == 1 */
+
+
+/** The binary exponent of the fixed-point scaling factors, which convert ADC counts into
+    Millivolt. A factor holds the voltage in mV of one count of the 16 Bit left aligned
+    result, multiplied with 2^#Q_SCALE_MV. */
+#define Q_SCALE_MV      19
+
+/** The scaling factor, which is applied if channel 10, VREG_1.2V, is not converted. It is
+    derived from the nominal reference voltage. */
+#define SCALE_MV_NOMINAL(vRef)                                                              \
+            ((uint32_t)(1000.0f * (float)(1u<<Q_SCALE_MV) * (vRef) / 65536.0f + 0.5f))
+
+/** The upper limit of the scaling factors. The product of a count and the factor plus the
+    rounding constant needs to fit into 32 Bit. The limit corresponds to a reference
+    voltage of about 8V and is never reached with a working device. */
+#define MAX_SCALE_MV    65531u
+
+/* The limit is not reached by the nominal configuration. */
+_Static_assert( SCALE_MV_NOMINAL(ADC_ADC_0_REF_VOLTAGE) < MAX_SCALE_MV
+                &&  SCALE_MV_NOMINAL(ADC_ADC_1_REF_VOLTAGE) < MAX_SCALE_MV
+                &&  (uint64_t)UINT16_MAX*MAX_SCALE_MV + (1u<<(Q_SCALE_MV-1)) <= UINT32_MAX
+              , "Bad definition of fixed-point scaling"
+              );
+
 
 /*
  * Local type definitions
  */
 
+/** Two 32 Bit lanes, which are processed at once. With the SPE of the e200z4 the compiler
+    maps the arithmetic operations onto single SIMD instructions. */
+typedef uint32_t v2u32_t __attribute__((vector_size(8)));
+
+/** The description of a channel group. The channels and the cycle time are taken from the
+    configuration, all other fields are derived at initialization time, see
+    initChannelGroups() and initCTU(). */
+typedef struct channelGroup_t
+{
+    /** The channels of the group as bit masks of the hardware channel numbers. The masks
+        are also the expected values of the registers CEOCFR0 of ADC_0 and ADC_1 at the
+        end of a conversion cycle. */
+    uint16_t maskAdc0, maskAdc1;
+
+    /** The value of the LOAD register of the eTimer, which implements the cycle time. */
+    uint16_t regValLoad;
+
+    /** The index of the first command of the group in the CTU command list CLR[]. */
+    unsigned int idxCmdFirst;
+
+    /** The ADC, which raises the end-of-conversion interrupt of the group. */
+    unsigned int idxAdcWithIrq;
+
+    /** The hardware channel number of the last conversion of the cycle in ADC 
+        idxAdcWithIrq. */
+    unsigned int idxLastChn;
+
+    /** The number of channels in the group. */
+    unsigned int noChns;
+
+    /** The indexes of the channels of the group in _conversionResAry,  noChns entries are
+        in use. */
+    uint8_t idxChnAry[ADC_NO_ACTIVE_CHNS];
+
+    /** The group contains all enabled internal channels (VREG_1.2V and TSENS) and they can
+        be filtered after each cycle. */
+    bool isInternalSignalsInGroup;
+
+} channelGroup_t;
+
 
 /*
  * Local prototypes
@@ -213,73 +543,193 @@ static float _TSENS_0[2] = {[0] = 32500.0f, [1] = 31000.0f};
 static float _TSENS_1[2] = {[0] = 32500.0f, [1] = 31000.0f};
 #endif
 
-/* Some constants from the device individual test and calibration data, required later for
-   the computation of the chip temperature. */
+/* The computation of the chip temperature uses the coefficients, which are precomputed
+   from the device individual test and calibration data by module mcuTestAndCalData. */
+#if ADC_USE_ADC_0_CHANNEL_15 == 1  ||  ADC_USE_ADC_1_CHANNEL_15 == 1
+# define TSENS_T2   TAC_TSENS_T2
+# define TSENS_T1   TAC_TSENS_T1
+#endif
+
+/** The fixed-point scaling factors of the results of ADC_0 and ADC_1, see #Q_SCALE_MV.
+    They are precomputed in the ISR from the readings of VREG_1.2V, whenever these are
+    updated. A 32 Bit word is written and read atomically; no critical section is
+    required. */
+static volatile uint32_t _scaleMillivoltAdc0 = SCALE_MV_NOMINAL(ADC_ADC_0_REF_VOLTAGE)
+                       , _scaleMillivoltAdc1 = SCALE_MV_NOMINAL(ADC_ADC_1_REF_VOLTAGE);
+
 #if ADC_USE_ADC_0_CHANNEL_15 == 1
-static float TSENS_0_P1 = 1.0f
-           , TSENS_0_P2 = 0.0f
-           , TSENS_0_C1 = 1.0f
-           , TSENS_0_C2 = 0.0f;
+/** The chip temperature TSENS_0 in hundredths of a degree centigrade. It is precomputed
+    in the ISR whenever both sensor readings have been updated. */
+static volatile int32_t _tsens0InCentiDegree = 0;
 #endif
 #if ADC_USE_ADC_1_CHANNEL_15 == 1
-static float TSENS_1_P1 = 1.0f
-           , TSENS_1_P2 = 0.0f
-           , TSENS_1_C1 = 1.0f
-           , TSENS_1_C2 = 0.0f;
+/** The chip temperature TSENS_1 in hundredths of a degree centigrade. */
+static volatile int32_t _tsens1InCentiDegree = 0;
 #endif
-#if ADC_USE_ADC_0_CHANNEL_15 == 1  ||  ADC_USE_ADC_1_CHANNEL_15 == 1
-# define TSENS_T2   (-40)
-# define TSENS_T1   (150)
+
+/** A sequence counter for the lock-free, coherent reading of all results. It is
+    incremented before and after an update of the results by the ISR and it is odd while
+    the update is in progress. */
+static volatile unsigned int _seqNoResults = 0;
+
+/** Time stamping: The time stamp of the last recent results. Updated by the ISR together
+    with the results, guarded by #_seqNoResults. Field \a age is not used. */
+static adc_timestamp_t _timestamp = { .idxCycle = 0
+                                    , .tiNominalInTicks = 0
+                                    , .tiIsrInTicks = 0
+                                    , .age = USHRT_MAX
+                                    };
+
+/** Time stamping: \a true until the first end-of-conversion interrupt has been served. */
+static bool _isFirstInterrupt = true;
+
+/** Diagnosis: The statistics about the timing of the end-of-conversion interrupt. Updated
+    by the ISR, guarded by #_seqNoResults. */
+static adc_timingStatistics_t _timingStatistics =
+    { .noInterrupts = 0
+    , .noMissedCycles = 0
+    , .tiMinDistanceInTicks = UINT32_MAX
+    , .tiMaxDistanceInTicks = 0
+    , .tiMaxLatencyInTicks = 0
+    , .tiSumLatencyInTicks = 0
+    };
+
+/** Diagnosis: The application requests the reset of the statistics. The reset is done by
+    the ISR, which is the only writer of the statistics. */
+static volatile bool _isResetOfTimingStatisticsRequested = false;
+
+#if ADC_USE_DMA != 1
+/** Time stamping: The expected duration of the currently running conversion cycle and of
+    the cycle after, in ticks of the time base. The two differ only after a switch of the
+    channel group, see activateChannelGroup(). */
+static uint32_t _tiCycleInTicks = 0
+              , _tiNextCycleInTicks = 0;
 #endif
 
+#if ADC_USE_DMA == 1
+# if ADC_ADC_0_NO_ACTIVE_CHNS > 0
+/** DMA mode: The ping-pong buffer for the CDR registers of ADC_0. The first half of the
+    rows is the first buffer, the second half is the other one. */
+static uint32_t _dmaBufAdc0[NO_DMA_CYCLES][ADC_0_NO_CDRS];
+# endif
+# if ADC_ADC_1_NO_ACTIVE_CHNS > 0
+/** DMA mode: The ping-pong buffer for the CDR registers of ADC_1. */
+static uint32_t _dmaBufAdc1[NO_DMA_CYCLES][ADC_1_NO_CDRS];
+# endif
+
+/** DMA mode: The number of sample blocks, which have been completed by the DMA since
+    start of the conversions. Updated by the DMA interrupt. */
+static volatile unsigned long _noCompletedSampleBlocks = 0;
+#endif
+
+/** The configured channel groups. Group 0 is the set of all enabled channels. */
+static channelGroup_t _channelGroupAry[ADC_NO_CHANNEL_GROUPS] =
+{
+    [0] = { .maskAdc0 = ADC_ADC_0_CHANNEL_BIT_MASK
+          , .maskAdc1 = ADC_ADC_1_CHANNEL_BIT_MASK
+          , .regValLoad = T_CYCLE_REGVAL(uint16_t, ADC_T_CYCLE_IN_US)
+          },
+#if ADC_NO_CHANNEL_GROUPS >= 2
+    [1] = { .maskAdc0 = ADC_GROUP_1_ADC_0_CHANNELS
+          , .maskAdc1 = ADC_GROUP_1_ADC_1_CHANNELS
+          , .regValLoad = T_CYCLE_REGVAL(uint16_t, ADC_GROUP_1_T_CYCLE_IN_US)
+          },
+#endif
+#if ADC_NO_CHANNEL_GROUPS >= 3
+    [2] = { .maskAdc0 = ADC_GROUP_2_ADC_0_CHANNELS
+          , .maskAdc1 = ADC_GROUP_2_ADC_1_CHANNELS
+          , .regValLoad = T_CYCLE_REGVAL(uint16_t, ADC_GROUP_2_T_CYCLE_IN_US)
+          },
+#endif
+};
+
+/** The index of the channel group, which is currently converted. */
+static volatile unsigned int _idxActiveGroup = 0;
+
+/** The index of the channel group, which has been requested by the application. The ISR
+    switches to this group at the end of the current cycle. */
+static volatile unsigned int _idxRequestedGroup = 0;
+
 
 /*
  * Function implementation
  */
 
+/**
+ * Complete the descriptions of the channel groups. The fields, which can't be easily
+ * computed by the preprocessor are derived from the channel masks.
+ */
+static void initChannelGroups(void)
+{
+    unsigned int idxGroup;
+    for(idxGroup=0; idxGroup<ADC_NO_CHANNEL_GROUPS; ++idxGroup)
+    {
+        channelGroup_t * const pGroup = &_channelGroupAry[idxGroup];
+        assert(pGroup->maskAdc0 != 0  ||  pGroup->maskAdc1 != 0);
+
+        /* The end-of-conversion interrupt is raised by the ADC, which has more conversions
+           to do. If both have the same number then ADC_0 is chosen. The last conversion is
+           the one of the highest channel number, see compileAdcCommandList(). */
+        if(__builtin_popcount(pGroup->maskAdc0) >= __builtin_popcount(pGroup->maskAdc1))
+        {
+            pGroup->idxAdcWithIrq = 0;
+            pGroup->idxLastChn = 31u - (unsigned int)__builtin_clz(pGroup->maskAdc0);
+        }
+        else
+        {
+            pGroup->idxAdcWithIrq = 1;
+            pGroup->idxLastChn = 31u - (unsigned int)__builtin_clz(pGroup->maskAdc1);
+        }
+
+        /* The warning "-Wtype-limits" is locally switched off. We intentionally permit
+           arrays of size zero (no channel configured for single ADC) but this leads to
+           never visited code paths. */
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wtype-limits"
+
+        /* The results of all enabled channels are stored in _conversionResAry; the
+           channels of ADC_0 first. Find the indexes of the channels of the group. */
+        unsigned int idxChn;
+        pGroup->noChns = 0;
+        for(idxChn=0; idxChn<ADC_ADC_0_NO_ACTIVE_CHNS; ++idxChn)
+        {
+            if((pGroup->maskAdc0 & (0x1u << adc_adc0_idxEnabledChannelAry[idxChn])) != 0)
+                pGroup->idxChnAry[pGroup->noChns++] = (uint8_t)idxChn;
+        }
+        for(idxChn=0; idxChn<ADC_ADC_1_NO_ACTIVE_CHNS; ++idxChn)
+        {
+            if((pGroup->maskAdc1 & (0x1u << adc_adc1_idxEnabledChannelAry[idxChn])) != 0)
+            {
+                pGroup->idxChnAry[pGroup->noChns++] =
+                                                (uint8_t)(ADC_ADC_0_NO_ACTIVE_CHNS + idxChn);
+            }
+        }
+        #pragma GCC diagnostic pop
+
+        /* The filtering of the internal signals refers to all of them. Only a group, which
+           converts all of the enabled ones, can update the filters. */
+        pGroup->isInternalSignalsInGroup =
+                (pGroup->maskAdc0 & ADC_ADC_0_CHANNEL_BIT_MASK & 0x8400u)
+                == (ADC_ADC_0_CHANNEL_BIT_MASK & 0x8400u)
+                &&  (pGroup->maskAdc1 & ADC_ADC_1_CHANNEL_BIT_MASK & 0x8400u)
+                    == (ADC_ADC_1_CHANNEL_BIT_MASK & 0x8400u);
+
+    } /* for(All configured channel groups) */
+
+} /* End of initChannelGroups */
+
+
+
 /**
  * Initialize the common part of the eTimer module and its counter channel 2.\n
  *   Which eTimer module to use is configured by #ETIMER at compile time.\n
- *   The cycle time is configured as #ADC_T_CYCLE_IN_US at compile time.\n
+ *   The cycle time is configured as #ADC_T_CYCLE_IN_US at compile time. The prescaler of
+ * the timer is chosen such that the cycle times of all channel groups can be implemented
+ * by reloading register LOAD only, see #T_CYCLE_MAX_IN_US.\n
  *   The timer is not yet started. Later use startETimer() to do so.
  */
 static void initETimer()
 {
-    /* The macros down here implicitly assumes a particular clock rate. The boundaries for
-       the selection of the prescaler need adaptation for another clock rate. */
-    #if PERIPHERAL_CLOCK_RATE != 120000000l
-    # error The configuration of the eTimer is based on a fixed clock rate of 120 MHz
-    #endif
-
-    /* Which prescaler do we need to implement the wanted cycle time? The lower boundary of
-       10us is weak and a bit arbitrary. It will work only if the client code demands only
-       a single conversion per cycle and if the data evaluation is very fast. */
-    #if ADC_T_CYCLE_IN_US < 10
-    # define DIV_AS_PWR_OF_2 0
-    # error Cycle time ADC_T_CYCLE_IN_US is configured too little. Values below 10us are \
-            not supported
-    #elif ADC_T_CYCLE_IN_US <= 1092
-    # define DIV_AS_PWR_OF_2 0
-    #elif ADC_T_CYCLE_IN_US <= 2184
-    # define DIV_AS_PWR_OF_2 1
-    #elif ADC_T_CYCLE_IN_US <= 4368
-    # define DIV_AS_PWR_OF_2 2
-    #elif ADC_T_CYCLE_IN_US <= 8737
-    # define DIV_AS_PWR_OF_2 3
-    #elif ADC_T_CYCLE_IN_US <= 17475
-    # define DIV_AS_PWR_OF_2 4
-    #elif ADC_T_CYCLE_IN_US <= 34951
-    # define DIV_AS_PWR_OF_2 5
-    #elif ADC_T_CYCLE_IN_US <= 69903
-    # define DIV_AS_PWR_OF_2 6
-    #elif ADC_T_CYCLE_IN_US <= 139807
-    # define DIV_AS_PWR_OF_2 7
-    #else
-    # define DIV_AS_PWR_OF_2 7
-    # error Cycle time ADC_T_CYCLE_IN_US is configured too large. Values above 139ms are \
-            not supported
-    #endif
-
 #if ENABLE_OUTPUT_OF_ETIMER_CHN2 == 1  &&  defined(DEBUG)
     /* Note, this setting is useful for testing but correct only if the macros select
        counter/channel 2 of eTimer 1.
@@ -332,23 +782,27 @@ static void initETimer()
        comp1 on counting down. */
     COUNTER.CCCTRL.R = 0x0100;
 
-    /* The period of the output signal is configured.
-         +1: Because of the output toggle mode the period is twice the counter cycle time.
+    /* The period of the output signal is configured. We start with the cycle time of
+       channel group 0.
          The compare registers are set such that they don't affect the timing. COMP1
-       triggers the reload at counter value 0 and comp2 never matches at all. */
-    #define T_CYCLE_REGVAL(type)                                                            \
-                ((type)(0.5 + ((float)PERIPHERAL_CLOCK_RATE / (1u<<(DIV_AS_PWR_OF_2+1)))    \
-                              * ((float)ADC_T_CYCLE_IN_US/1e6)                              \
-                       )                                                                    \
-                 - 1                                                                        \
-                )
-    _Static_assert( T_CYCLE_REGVAL(int64_t) > 0  &&  T_CYCLE_REGVAL(int64_t) <= 65535
+       triggers the reload at counter value 0 and comp2 never matches at all. The reload
+       from register LOAD is the means to change the cycle time at run-time, see
+       activateChannelGroup(). */
+    _Static_assert( T_CYCLE_REGVAL(int64_t, ADC_T_CYCLE_IN_US) > 0
+                    &&  T_CYCLE_REGVAL(int64_t, ADC_T_CYCLE_IN_US) <= 65535
+#if ADC_NO_CHANNEL_GROUPS >= 2
+                    &&  T_CYCLE_REGVAL(int64_t, ADC_GROUP_1_T_CYCLE_IN_US) > 0
+                    &&  T_CYCLE_REGVAL(int64_t, ADC_GROUP_1_T_CYCLE_IN_US) <= 65535
+#endif
+#if ADC_NO_CHANNEL_GROUPS >= 3
+                    &&  T_CYCLE_REGVAL(int64_t, ADC_GROUP_2_T_CYCLE_IN_US) > 0
+                    &&  T_CYCLE_REGVAL(int64_t, ADC_GROUP_2_T_CYCLE_IN_US) <= 65535
+#endif
                   , "Cycle time out of range"
                   );
-    COUNTER.LOAD.R = T_CYCLE_REGVAL(uint16_t);
+    COUNTER.LOAD.R = _channelGroupAry[0].regValLoad;
     COUNTER.COMP1.R = 0;
     COUNTER.COMP2.R = 0xffff;
-    #undef T_CYCLE_REGVAL
 
     /* Initialize the counter. */
     COUNTER.CNTR.R = 1;
@@ -360,17 +814,30 @@ static void initETimer()
     //COUNTER.INTDMA.B.TCF1IE = 1;
 
 #undef COUNTER
-#undef DIV_AS_PWR_OF_2
 } /* End of initETimer */
 
 
 
 /**
  * All ADC conversions are started by the CTU according to the ADC command list it stores
- * in its register file CLR[]. This function fills the command list based on the user
- * configuration.
+ * in its register file CLR[]. This function fills the command list of one channel group.
+ * The lists of all groups are stored one after another in CLR[]; the CTU is told by
+ * CLCR1.T0INDEX, which list to process.
+ *   @return
+ * Get the index of the terminating dummy command in CLR[]. This is the index of the first
+ * command of the next channel group, which overwrites the dummy command; its first
+ * command will be the terminating command of this group.
+ *   @param idxCmdFirst
+ * The index of the first command of the list in CLR[].
+ *   @param maskAdc0
+ * The channels of ADC_0 to convert as bit mask of the hardware channel numbers.
+ *   @param maskAdc1
+ * The channels of ADC_1 to convert as bit mask of the hardware channel numbers.
  */
-static void compileAdcCommandList()
+static unsigned int compileAdcCommandList( unsigned int idxCmdFirst
+                                         , unsigned int maskAdc0
+                                         , unsigned int maskAdc1
+                                         )
 {
     /* ADC commands:
        0x8000: CIR, interrupt on done
@@ -379,40 +846,26 @@ static void compileAdcCommandList()
        0x0020: ADC index in single conversion mode
        0x000f: Channel number for ADC 0
        0x0170: Channel number for ADC 1 in dual conversion mode */
-    CTU.CLR[0].R = 0x4001;  /* Command 0 - Convert chn1 with ADC 0. */
-    CTU.CLR[1].R = 0x000a;  /* Command 1 - Convert chn10 with ADC 0. */
-    CTU.CLR[2].R = 0x000f;  /* Command 2 - Convert chn15 with ADC 0. */
-
-    unsigned int idxCmd
-               , idxChnAdc0 = 0
-               , idxChnAdc1 = 0;
-    const unsigned int noCmds = ADC_ADC_0_NO_ACTIVE_CHNS >= ADC_ADC_1_NO_ACTIVE_CHNS
-                                ? ADC_ADC_0_NO_ACTIVE_CHNS
-                                : ADC_ADC_1_NO_ACTIVE_CHNS
-                     , noDualConversions = ADC_ADC_0_NO_ACTIVE_CHNS <= ADC_ADC_1_NO_ACTIVE_CHNS
-                                           ? ADC_ADC_0_NO_ACTIVE_CHNS
-                                           : ADC_ADC_1_NO_ACTIVE_CHNS
-                     , SU = ADC_ADC_0_NO_ACTIVE_CHNS >= ADC_ADC_1_NO_ACTIVE_CHNS? 0: 1;
-    _Static_assert(noCmds <= 15, "No more than 15 channels must be configured per ADC unit");
-    for(idxCmd=0; idxCmd<noCmds; ++idxCmd)
-    {
-        /* The warning "-Wtype-limits" is locally switched off. We intentionally permit
-           arrays of size zero (no channel configured for single ADC) but this leads to
-           never visited code paths. */
-        #pragma GCC diagnostic push
-        #pragma GCC diagnostic ignored "-Wtype-limits"
+    _Static_assert( ADC_ADC_0_NO_ACTIVE_CHNS <= 15  &&  ADC_ADC_1_NO_ACTIVE_CHNS <= 15
+                  , "No more than 15 channels must be configured per ADC unit"
+                  );
+    _Static_assert( NO_CTU_COMMANDS <= sizeOfAry(CTU.CLR)
+                  , "The command lists of all channel groups don't fit into the CTU"
+                  );
 
+    unsigned int idxCmd = idxCmdFirst;
+    while(maskAdc0 != 0  ||  maskAdc1 != 0)
+    {
         uint16_t CLR = 0;
-        if(idxCmd < noDualConversions)
+        if(maskAdc0 != 0  &&  maskAdc1 != 0)
         {
             /* We begin the command list with dual mode conversions. Both ADC are
-               simultaneously converting a channel. */
-
-            assert(idxChnAdc0 < sizeOfAry(adc_adc0_idxEnabledChannelAry)
-                   &&  idxChnAdc1 < sizeOfAry(adc_adc1_idxEnabledChannelAry)
-                  );
-            const unsigned int chnAdc0 = adc_adc0_idxEnabledChannelAry[idxChnAdc0++]
-                             , chnAdc1 = adc_adc1_idxEnabledChannelAry[idxChnAdc1++];
+               simultaneously converting a channel. The channels are taken in ascending
+               order. */
+            const unsigned int chnAdc0 = (unsigned int)__builtin_ctz(maskAdc0)
+                             , chnAdc1 = (unsigned int)__builtin_ctz(maskAdc1);
+            maskAdc0 &= maskAdc0 - 1u;
+            maskAdc1 &= maskAdc1 - 1u;
 
             /* Set CMS to dual conversion. */
             CLR |= 0x2000;
@@ -428,16 +881,18 @@ static void compileAdcCommandList()
             /* One ADC has more active channels than the other. The command list ends with
                a number of single mode conversion commands. */
 
-            unsigned int chnAdc;
-            if(SU == 0)
+            unsigned int chnAdc, SU;
+            if(maskAdc0 != 0)
             {
-                assert(idxChnAdc0 < sizeOfAry(adc_adc0_idxEnabledChannelAry));
-                chnAdc = adc_adc0_idxEnabledChannelAry[idxChnAdc0++];
+                SU = 0;
+                chnAdc = (unsigned int)__builtin_ctz(maskAdc0);
+                maskAdc0 &= maskAdc0 - 1u;
             }
             else
             {
-                assert(idxChnAdc1 < sizeOfAry(adc_adc1_idxEnabledChannelAry));
-                chnAdc = adc_adc1_idxEnabledChannelAry[idxChnAdc1++];
+                SU = 1;
+                chnAdc = (unsigned int)__builtin_ctz(maskAdc1);
+                maskAdc1 &= maskAdc1 - 1u;
             }
 
             /* ST is set to 0 as it needs to be. */
@@ -450,23 +905,22 @@ static void compileAdcCommandList()
 
         } /* End if(Is there a conversion still for both ADC units?) */
 
-        #pragma GCC diagnostic pop
-
         /* The field CIR is not used. The related interrupt is raised on successful
            submission of the command but not after the end of the demanded conversion -
            this interrupt must not be used as an end-of-conversion notification. */
 
         /* Set FC, the indication of the first command in a sequence. */
-        if(idxCmd == 0)
+        if(idxCmd == idxCmdFirst)
             CLR |= 0x4000;
 
         /* The field FIFO doesn't care, we fetch the results by ISR from the ADCs
            themselves. We leave it at zero. */
 
         /* CLR now holds the next command. Write it into the CTU. */
-        CTU.CLR[idxCmd].R = CLR;
+        assert(idxCmd+1 < sizeOfAry(CTU.CLR));
+        CTU.CLR[idxCmd++].R = CLR;
 
-    } /* for(All conversions required to fulfill the user configuration demands) */
+    } /* while(Still channels of the group left, which require a conversion command) */
 
     /* Finalize the list of commands by another, no more executed command with bit FC
        (first bit) set.
@@ -476,8 +930,11 @@ static void compileAdcCommandList()
        description also says that the bit is sometimes referred to as FC instead of LC;
        this may support the "first bit" interpretation. By try and error we found that the
        first bit interpretation is the correct one and so we require a dummy command, which
-       is the first command of a subsequent (but never used) sequence. */
+       is the first command of a subsequent (but never used) sequence.
+         If another channel group follows then its first command replaces the dummy
+       command. */
     CTU.CLR[idxCmd].R = 0x4000;
+    return idxCmd;
 
 } /* End of compileAdcCommandList */
 
@@ -545,7 +1002,7 @@ static void initCTU(void)
                   , "Internal error, conversion time out of range"
                   );
     _Static_assert( T_CONV_CYCLE_REGVAL(int64_t)
-                    + (int64_t)(5e-6 * (float)PERIPHERAL_CLOCK_RATE) /* data fetch in ISR */
+                    + (int64_t)(T_DATA_FETCH * (float)PERIPHERAL_CLOCK_RATE)
                     + (int64_t)(2e-6 * (float)PERIPHERAL_CLOCK_RATE) /* 2us margin */
                     < (int64_t)(ADC_T_CYCLE_IN_US*1e-6 * (float)PERIPHERAL_CLOCK_RATE)
                   , "ADC_T_CYCLE_IN_US is chosen too little for the configured number of ADC"
@@ -570,9 +1027,19 @@ static void initCTU(void)
 #endif
 
     /* All conversions are started by the CTU according to the ADC command list it stores
-       in its register file CLR[]. The command list is filled based on the user
-       configuration. */
-    compileAdcCommandList();
+       in its register file CLR[]. The command lists of all channel groups are filled based
+       on the user configuration. */
+    unsigned int idxGroup
+               , idxCmd = 0;
+    for(idxGroup=0; idxGroup<ADC_NO_CHANNEL_GROUPS; ++idxGroup)
+    {
+        channelGroup_t * const pGroup = &_channelGroupAry[idxGroup];
+        pGroup->idxCmdFirst = idxCmd;
+        idxCmd = compileAdcCommandList(idxCmd, pGroup->maskAdc0, pGroup->maskAdc1);
+    }
+
+    /* Trigger 0 starts the command list of group 0. */
+    CTU.CLCR1.B.T0INDEX = _channelGroupAry[0].idxCmdFirst;
 
     /* COTR: The length of the impulses in the external trigger output in clock ticks
        impacts their visibility on the scope. */
@@ -634,7 +1101,7 @@ static void initADC(unsigned int idxAdc)
     pADC->IMR.R = 0;
     pADC->CIMR0.R = 0;
 
-    /* Don't use DMA. */
+    /* DMA is not used by default. See below for the DMA mode. */
     pADC->DMAE.B.DMAEN = 0;
 
     /* Timing of conversion. We use a slow timing for this driver.
@@ -673,16 +1140,24 @@ static void initADC(unsigned int idxAdc)
        conversion of the cycle.
          Note, this will work only under the presumption, that both ADCs operate perfectly
        synchronously and end in the same clock tick; if the last conversion is a dual
-       conversion then we need to arbitrarily choose one of both ADCs as interrupt source. */
-#if ADC_ADC_0_NO_ACTIVE_CHNS >= ADC_ADC_1_NO_ACTIVE_CHNS
-    const unsigned int idxAdcWithEOCTUIrq = 0
-                     , idxLastChn = adc_adc0_idxEnabledChannelAry[ADC_ADC_0_NO_ACTIVE_CHNS-1];
-#else
-    const unsigned int idxAdcWithEOCTUIrq = 1
-                     , idxLastChn = adc_adc1_idxEnabledChannelAry[ADC_ADC_1_NO_ACTIVE_CHNS-1];
-#endif
+       conversion then we need to arbitrarily choose one of both ADCs as interrupt source.
+         The interrupt source is configured for channel group 0, which is active after
+       startup. The other groups may require another source, see activateChannelGroup(). */
+    const unsigned int idxAdcWithEOCTUIrq = _channelGroupAry[0].idxAdcWithIrq
+                     , idxLastChn = _channelGroupAry[0].idxLastChn;
     if(idxAdc == idxAdcWithEOCTUIrq)
     {
+#if ADC_USE_DMA == 1
+        /* DMA mode: No interrupt is raised by the ADC. Instead, the conversion of the last
+           channel in the cycle raises the DMA request. The DMA request is cleared by the
+           acknowledge of the DMA controller (DCLR=0).
+             Note, the completion flags in CEOCFR0 are not cleared any more in this mode.
+           We don't need them, the validation is based on the CDR registers only. */
+        pADC->DMAR0.R = 0x1u << idxLastChn;
+        pADC->DMAE.B.DCLR = 0;
+        pADC->DMAE.B.DMAEN = 1;
+        pADC->CEOCFR0.R = 0x0000fffful;
+#else
         /* Enable channel interrupts only for last channel in conversion cycle. */
         pADC->CIMR0.R = 0x1u << idxLastChn;
         
@@ -691,7 +1166,7 @@ static void initADC(unsigned int idxAdc)
         
         /* Generally enable the end of CTU conversion interrupts and disable all others. */
         pADC->IMR.R = 0x00000010ul;
-        
+#endif
     } /* End if(Function is called for ADC with longer list of conversions to do) */
 
     /* Leave power down mode, goto operation. */
@@ -702,36 +1177,521 @@ static void initADC(unsigned int idxAdc)
 } /* End of initADC */
 
 
+
+#if ADC_USE_DMA == 1
+/**
+ * DMA mode: Initialization of one of the eDMA channels, which copy the CDR registers of an
+ * ADC into the ping-pong buffer.\n
+ *   Each request of the ADC (or the link from the other channel) copies the block of CDR
+ * registers into the next row of the buffer. The modulo addressing of the source makes the
+ * source address return to the beginning of the block. After #NO_DMA_CYCLES rows, the
+ * major loop is complete and the destination address is reset to the beginning of the
+ * buffer. The channel runs forever without any intervention by the CPU.
+ *   @param idxDmaChn
+ * The DMA channel to configure.
+ *   @param pFirstCDR
+ * The address of the first CDR register of the copied block. It needs to be aligned to
+ * the size of the block.
+ *   @param log2NoCDRs
+ * The number of CDR registers in the block as power of two.
+ *   @param pBuf
+ * The ping-pong buffer of NO_DMA_CYCLES * 2^ \a log2NoCDRs words.
+ *   @param idxLinkedDmaChn
+ * The channel, which is started after each minor loop of this channel or -1 if there's
+ * no linked channel.
+ *   @param enableIrq
+ * If \a true then the half-complete and complete interrupts are raised by this channel.
+ */
+static void initDmaChannel( unsigned int idxDmaChn
+                          , const volatile uint32_t *pFirstCDR
+                          , unsigned int log2NoCDRs
+                          , uint32_t *pBuf
+                          , signed int idxLinkedDmaChn
+                          , bool enableIrq
+                          )
+{
+    _Static_assert( ADC_DMA_NO_CYCLES_PER_BUFFER >= 1  &&  ADC_DMA_NO_CYCLES_PER_BUFFER <= 255
+                  , "ADC_DMA_NO_CYCLES_PER_BUFFER is out of range"
+                  );
+    const unsigned int noBytesPerCycle = sizeof(uint32_t) << log2NoCDRs;
+    assert(((uintptr_t)pFirstCDR & (noBytesPerCycle-1u)) == 0);
+
+#define TCD (EDMA.CHANNEL[idxDmaChn])
+
+    /* Source is the block of CDR registers. Read 32 Bit per transfer, to get the validity
+       information together with the result. */
+    TCD.TCDWORD0_.B.SADDR = (vuint32_t)pFirstCDR;
+    TCD.TCDWORD4_.B.SSIZE = 2;
+    TCD.TCDWORD4_.B.SOFF = sizeof(uint32_t);
+    TCD.TCDWORD4_.B.SMOD = log2NoCDRs + 2u;
+    TCD.TCDWORD12_.B.SLAST = 0;
+
+    /* Destination is the ping-pong buffer. After the major loop, go back to its beginning. */
+    TCD.TCDWORD16_.B.DADDR = (vuint32_t)pBuf;
+    TCD.TCDWORD4_.B.DSIZE = 2;
+    TCD.TCDWORD4_.B.DMOD = 0;
+    TCD.TCDWORD24_.B.DLAST_SGA = (vuint32_t)-(int32_t)(NO_DMA_CYCLES * noBytesPerCycle);
+
+    /* One minor loop copies the block of CDRs of one conversion cycle. */
+    TCD.TCDWORD8_.B.SMLOE = 0;
+    TCD.TCDWORD8_.B.DMLOE = 0;
+    TCD.TCDWORD8_.B.MLOFF = 0;
+    TCD.TCDWORD8_.B.NBYTES = noBytesPerCycle;
+
+    /* The major loop is the complete ping-pong buffer. The iteration count fields CITER
+       and BITER have 9 or 15 Bit, depending on the channel-to-channel linking bit
+       E_LINK. MPC5643L.h defines them unconditionally, so we compose the register
+       contents ourselves. */
+    uint32_t iterCnt = NO_DMA_CYCLES;
+    if(idxLinkedDmaChn >= 0)
+        iterCnt |= 0x8000u | ((uint32_t)idxLinkedDmaChn << 9);
+    TCD.TCDWORD20_.R = (iterCnt << 16) | sizeof(uint32_t) /* DOFF */;
+    TCD.TCDWORD28_.R = iterCnt << 16;
+
+    /* The minor loop link is not executed after the last minor loop of the major loop.
+       The linked channel is started in this case by the major loop link. */
+    if(idxLinkedDmaChn >= 0)
+    {
+        TCD.TCDWORD28_.B.MAJOR_LINKCH = (unsigned)idxLinkedDmaChn;
+        TCD.TCDWORD28_.B.MAJOR_E_LINK = 1;
+    }
+
+    /* Run forever, don't disable the request after the major loop. */
+    TCD.TCDWORD28_.B.D_REQ = 0;
+    TCD.TCDWORD28_.B.E_SG = 0;
+
+    /* One interrupt per completed half of the buffer. */
+    TCD.TCDWORD28_.B.INT_HALF = enableIrq? 1: 0;
+    TCD.TCDWORD28_.B.INT_MAJ = enableIrq? 1: 0;
+
+    /* 0: No stalling, the transfer needs to complete long before the next cycle. */
+    TCD.TCDWORD28_.B.BWC = 0;
+
+#undef TCD
+} /* End of initDmaChannel */
+
+
+
+/**
+ * DMA mode: Initialization of the eDMA channels, which fetch the conversion results from
+ * the ADCs. The primary channel is connected to the DMA request of the ADC with more
+ * conversions per cycle. If both ADCs are in use then the secondary channel is linked to
+ * the primary one and raises the interrupts.\n
+ *   The results of the secondary ADC can't be overwritten before they are fetched, even
+ * if both ADCs have the same number of conversions and end the cycle with a dual
+ * conversion:
+ *   - The secondary ADC doesn't request a transfer on its own. Its transfer is chained
+ * in hardware to the primary one: The minor loop link of the primary channel sets the
+ * start bit of the secondary channel as soon as the primary block is copied. There's no
+ * CPU and no interrupt latency involved.
+ *   - Both channels have fixed, distinct priorities and they can't be preempted. The
+ * serial output (channel 15) may delay the chain by no more than a single byte transfer.
+ *   - Any CDR of the secondary ADC is written the next time not before the first
+ * conversion of the next cycle has completed, i.e. earliest after the cycle gap plus one
+ * conversion time, which is about 2us. The cycle time check in initCTU() reserves
+ * #T_DATA_FETCH for the data transfer of both channels in this gap; the two chained
+ * transfers of up to 16 words each take less than a Microsecond.
+ *   - Conversely, in a final dual conversion the secondary ADC's result is not later
+ * than the primary one's by more than one ADC clock (the sample time of channels 10 and
+ * 15 differs by this amount). The primary transfer takes longer than that.
+ *
+ * Should the timing still be violated, e.g. by a debugger halting the DMA, then the
+ * validation of the CDR contents (bits VALID and OVERW) recognizes the bad cycle and it is
+ * counted as failed; the values are not silently wrong.
+ */
+static void initDMA(void)
+{
+    /* The DMA request needs to come from the ADC, which ends the cycle. */
+    assert(_channelGroupAry[0].idxAdcWithIrq == IDX_ADC_PRIMARY);
+
+#ifdef DMA_CHN_SECONDARY
+    const signed int idxLinkedChnOfPrimary = DMA_CHN_SECONDARY;
+#else
+    const signed int idxLinkedChnOfPrimary = -1;
+#endif
+
+#if ADC_ADC_0_NO_ACTIVE_CHNS > 0
+    initDmaChannel( DMA_CHN_FOR_ADC_0
+                  , &ADC_0.CDR[ADC_0_FIRST_CDR].R
+                  , ADC_0_LOG2_NO_CDRS
+                  , &_dmaBufAdc0[0][0]
+                  , DMA_CHN_FOR_ADC_0 == DMA_CHN_PRIMARY? idxLinkedChnOfPrimary: -1
+                  , /* enableIrq */ DMA_CHN_FOR_ADC_0 == DMA_CHN_IRQ
+                  );
+#endif
+#if ADC_ADC_1_NO_ACTIVE_CHNS > 0
+    initDmaChannel( DMA_CHN_FOR_ADC_1
+                  , &ADC_1.CDR[ADC_1_FIRST_CDR].R
+                  , ADC_1_LOG2_NO_CDRS
+                  , &_dmaBufAdc1[0][0]
+                  , DMA_CHN_FOR_ADC_1 == DMA_CHN_PRIMARY? idxLinkedChnOfPrimary: -1
+                  , /* enableIrq */ DMA_CHN_FOR_ADC_1 == DMA_CHN_IRQ
+                  );
+#endif
+
+    /* The channel priorities are set explicitly rather than relying on the reset
+       default, which is the same. Priority controlled arbitration needs distinct
+       priorities; the serial output uses channel 15 with priority 15.
+         ECP, 0x80: 0: Channel can't be preempted
+         DPA, 0x40: 0: Channel may preempt channels, which have ECP set
+         CHPRI, 0x0f: Priority */
+#if ADC_ADC_0_NO_ACTIVE_CHNS > 0
+    EDMA.DCHPRI[DMA_CHN_FOR_ADC_0].R = DMA_CHN_FOR_ADC_0;
+#endif
+#if ADC_ADC_1_NO_ACTIVE_CHNS > 0
+    EDMA.DCHPRI[DMA_CHN_FOR_ADC_1].R = DMA_CHN_FOR_ADC_1;
+#endif
+
+    /* Route the DMA request of the ADC to the primary channel.
+         ENBL, 0x80: Enable channel
+         SOURCE, 0x3f: Selection of DMAMUX input
+       The secondary channel is started by link only. */
+    DMAMUX.CHCONFIG[DMA_CHN_PRIMARY].R = 0x80 + DMAMUX_SOURCE_PRIMARY;
+#ifdef DMA_CHN_SECONDARY
+    DMAMUX.CHCONFIG[DMA_CHN_SECONDARY].R = 0;
+#endif
+
+    /* The DMA request is enabled in adc_startConversions(). */
+
+} /* End of initDMA */
+#endif /* ADC_USE_DMA == 1 */
+
+
+
+/**
+ * Compute the fixed-point scaling factor for the conversion of ADC counts into Millivolt.
+ *   @return
+ * Get the factor, see #Q_SCALE_MV. It is saturated at #MAX_SCALE_MV.
+ *   @param cntPerVolt
+ * The filtered reading of VREG_1.2V, expressed as ADC counts per Volt.
+ */
+static inline uint32_t computeScaleMillivolt(float cntPerVolt)
+{
+    const float scale = 1000.0f * (float)(1u<<Q_SCALE_MV) / cntPerVolt;
+    if(scale >= 0.0f  &&  scale < (float)MAX_SCALE_MV)
+        return (uint32_t)(scale + 0.5f);
+    else
+        return MAX_SCALE_MV;
+
+} /* End of computeScaleMillivolt */
+
+
+
+/**
+ * Convert a temperature into fixed-point representation.
+ *   @return
+ * Get the temperature in hundredths of a degree centigrade. The value is rounded and
+ * saturated to the range of int16_t.
+ *   @param T
+ * The temperature in degree centigrade.
+ */
+static inline int32_t toCentiDegree(float T)
+{
+    T *= 100.0f;
+    if(T >= (float)INT16_MAX)
+        return INT16_MAX;
+    else if(T > (float)INT16_MIN)
+        return (int32_t)(T >= 0.0f? T+0.5f: T-0.5f);
+    else
+        return INT16_MIN;
+
+} /* End of toCentiDegree */
+
+
+
+/**
+ * Filtering of the internal signals VREG_1.2V and TSENS. The function is called after a
+ * successful conversion cycle with the new results in _conversionResAry.
+ */
+static inline void filterInternalSignals(void)
+{
+    /* Channel 10 is hardwired to the internal reference voltage source VREG_1.2V. We store
+       the averaged reading of this channel, know the nominal voltage and can thus compute a
+       calibration factor. This factor is then applied to all the channels of the given ADC.
+         Nominal voltage: The signal name says 1.2 V but we have measured 1.24 V at two real
+       devices and literature mostly says around 1.25 V for a bandgap reference. Moreover,
+       most purchasable reference voltage products have a nominal voltage of 1.24 V. This
+       value is what we use. */
+#if ADC_USE_ADC_0_CHANNEL_10 == 1  ||  ADC_USE_ADC_1_CHANNEL_10 == 1
+    _Static_assert( ADC_FILTER_COEF_VREG_1_2V >= 0.0f
+                    &&  ADC_FILTER_COEF_VREG_1_2V < 1.0f
+                  , "Bad filter constant configured for smoothing VREG_1.2V"
+                  );
+#endif
+#if ADC_USE_ADC_0_CHANNEL_10 == 1
+    _adc0_chn10 = _adc0_chn10 * ADC_FILTER_COEF_VREG_1_2V
+                  + (1.0f - ADC_FILTER_COEF_VREG_1_2V) / 1.24f
+                    * (float)_conversionResAry[adc_adc0_idxChn10];
+    _scaleMillivoltAdc0 = computeScaleMillivolt(_adc0_chn10);
+#endif
+#if ADC_USE_ADC_1_CHANNEL_10 == 1
+    _adc1_chn10 = _adc1_chn10 * ADC_FILTER_COEF_VREG_1_2V
+                  + (1.0f - ADC_FILTER_COEF_VREG_1_2V) / 1.24f
+                    * (float)_conversionResAry[adc_adc1_idxChn10];
+    _scaleMillivoltAdc1 = computeScaleMillivolt(_adc1_chn10);
+#endif
+
+    /* The reading of the TSENS channels is averaged with a simple first order low pass. */
+#if ADC_USE_ADC_0_CHANNEL_15 == 1  ||  ADC_USE_ADC_1_CHANNEL_15 == 1
+    _Static_assert( ADC_FILTER_COEF_TSENS >= 0.0f  &&  ADC_FILTER_COEF_TSENS < 1.0f
+                  , "Bad filter constant configured for smoothing TSENS"
+                  );
+    assert((_TSENSOR_SEL & ~0x1u) == 0);
+#endif
+#if ADC_USE_ADC_0_CHANNEL_15 == 1
+    _TSENS_0[_TSENSOR_SEL] = _TSENS_0[_TSENSOR_SEL] * ADC_FILTER_COEF_TSENS
+                             + (1.0f - ADC_FILTER_COEF_TSENS)
+                               * (float)_conversionResAry[adc_adc0_idxChn15];
+#endif
+#if ADC_USE_ADC_1_CHANNEL_15 == 1
+    _TSENS_1[_TSENSOR_SEL] = _TSENS_1[_TSENSOR_SEL] * ADC_FILTER_COEF_TSENS
+                             + (1.0f - ADC_FILTER_COEF_TSENS)
+                               * (float)_conversionResAry[adc_adc1_idxChn15];
+#endif
+#if ADC_USE_ADC_0_CHANNEL_15 == 1  ||  ADC_USE_ADC_1_CHANNEL_15 == 1
+    _TSENSOR_SEL = (_TSENSOR_SEL+1) & 0x1;
+#endif
+#if ADC_USE_ADC_0_CHANNEL_15 == 1
+    ADC_0.CTR1.B.TSENSOR_SEL = _TSENSOR_SEL;
+#endif
+#if ADC_USE_ADC_1_CHANNEL_15 == 1
+    ADC_1.CTR1.B.TSENSOR_SEL = _TSENSOR_SEL;
+#endif
+
+    /* Both sensor modes have been measured after each second cycle. This is when the
+       fixed-point temperatures are refreshed. */
+#if ADC_USE_ADC_0_CHANNEL_15 == 1  ||  ADC_USE_ADC_1_CHANNEL_15 == 1
+    if(_TSENSOR_SEL == 0)
+    {
+# if ADC_USE_ADC_0_CHANNEL_15 == 1
+        _tsens0InCentiDegree = toCentiDegree(adc_getTsens0());
+# endif
+# if ADC_USE_ADC_1_CHANNEL_15 == 1
+        _tsens1InCentiDegree = toCentiDegree(adc_getTsens1());
+# endif
+    }
+#endif
+} /* End of filterInternalSignals */
+
+
+
+/**
+ * Diagnosis: Keep track of ever failed conversions (debugging) and provide a measure how
+ * long it is ago that we could successfully sample all channels.
+ *   @param success
+ * \a true if the recent conversion cycle was successful.
+ *   @param noCycles
+ * The number of conversion cycles since the previous call of this function.
+ */
+static inline void updateDiagnosis(bool success, unsigned int noCycles)
+{
+    if(success)
+        _ageOfConversionResults = 0;
+    else
+    {
+        unsigned int noFailedConversions = _noFailedConversions + 1;
+        if(noFailedConversions != 0)
+            _noFailedConversions = noFailedConversions;
+
+        const unsigned int ageOfConversionResults = _ageOfConversionResults + noCycles;
+        _ageOfConversionResults = ageOfConversionResults <= USHRT_MAX
+                                  ? (unsigned short)ageOfConversionResults
+                                  : USHRT_MAX;
+    }
+} /* End of updateDiagnosis */
+
+
+
+/**
+ * Time stamping and timing diagnosis: Called once per end-of-conversion interrupt to
+ * update the time stamp of the results and the statistics.\n
+ *   The measured entry time of the interrupt is mapped onto the equidistant time grid of
+ * the hardware triggered conversion cycles. The interrupt belongs to the last grid point
+ * before its entry; if it is more than a cycle late then the results of the missed cycle
+ * have been overwritten by the hardware and the interrupt fetches the results of the
+ * later cycle. The grid is aligned with the earliest seen entry: If an interrupt is found
+ * to be up to a quarter of a cycle ahead of the grid then the grid is shifted. (As a
+ * consequence, latencies of more than three quarters of a cycle are taken for a lost
+ * cycle.)
+ *   @return
+ * Get the number of periods since the previous interrupt. Normally one, more if periods
+ * have been lost.
+ *   @param tiNow
+ * The time of entry into the interrupt, read from the time base.
+ *   @param tiPeriodInTicks
+ * The expected distance of two interrupts, i.e. the duration of the conversion cycle or,
+ * in DMA mode, of a block of cycles, in ticks of the time base.
+ *   @param noCyclesPerPeriod
+ * The number of conversion cycles per period; 1 or #ADC_DMA_NO_CYCLES_PER_BUFFER in DMA
+ * mode.
+ *   @param isPeriodStable
+ * \a false if the period differs from the previous one; the distance to the previous
+ * interrupt is then not considered for the jitter statistics.
+ *   @remark
+ * The function needs to be called inside the update phase of the results, see
+ * #_seqNoResults.
+ */
+static unsigned int updateTimestamp( uint32_t tiNow
+                                   , uint32_t tiPeriodInTicks
+                                   , unsigned int noCyclesPerPeriod
+                                   , bool isPeriodStable
+                                   )
+{
+    adc_timingStatistics_t * const pStat = &_timingStatistics;
+    if(_isResetOfTimingStatisticsRequested)
+    {
+        pStat->noInterrupts = 0;
+        pStat->noMissedCycles = 0;
+        pStat->tiMinDistanceInTicks = UINT32_MAX;
+        pStat->tiMaxDistanceInTicks = 0;
+        pStat->tiMaxLatencyInTicks = 0;
+        pStat->tiSumLatencyInTicks = 0;
+        _isResetOfTimingStatisticsRequested = false;
+    }
+
+    unsigned int noPeriods;
+    uint32_t tiLatency;
+    if(_isFirstInterrupt)
+    {
+        _isFirstInterrupt = false;
+        noPeriods = 1;
+        tiLatency = 0;
+        _timestamp.idxCycle = noCyclesPerPeriod - 1u;
+        _timestamp.tiNominalInTicks = tiNow;
+    }
+    else
+    {
+        /* The modulo arithmetic of the differences is correct as long as the distance of
+           two interrupts is less than the wrap-around time of TBL. */
+        const uint32_t tiElapsed = tiNow - _timestamp.tiNominalInTicks;
+        noPeriods = (tiElapsed + tiPeriodInTicks/4u) / tiPeriodInTicks;
+        if(noPeriods == 0)
+            noPeriods = 1;
+
+        uint32_t tiNominal = _timestamp.tiNominalInTicks + noPeriods*tiPeriodInTicks;
+        if((int32_t)(tiNow - tiNominal) < 0)
+        {
+            /* Earlier than ever seen: The grid is moved to this interrupt. */
+            tiNominal = tiNow;
+        }
+        tiLatency = tiNow - tiNominal;
+
+        _timestamp.idxCycle += noPeriods*noCyclesPerPeriod;
+        _timestamp.tiNominalInTicks = tiNominal;
+
+        /* Jitter: Only the distances of adjacent interrupts are considered. */
+        if(noPeriods == 1  &&  isPeriodStable)
+        {
+            const uint32_t tiDistance = tiNow - _timestamp.tiIsrInTicks;
+            if(tiDistance < pStat->tiMinDistanceInTicks)
+                pStat->tiMinDistanceInTicks = tiDistance;
+            if(tiDistance > pStat->tiMaxDistanceInTicks)
+                pStat->tiMaxDistanceInTicks = tiDistance;
+        }
+        pStat->noMissedCycles += (noPeriods-1u)*noCyclesPerPeriod;
+    }
+    _timestamp.tiIsrInTicks = tiNow;
+
+    ++ pStat->noInterrupts;
+    if(tiLatency > pStat->tiMaxLatencyInTicks)
+        pStat->tiMaxLatencyInTicks = tiLatency;
+    pStat->tiSumLatencyInTicks += tiLatency;
+
+    return noPeriods;
+
+} /* End of updateTimestamp */
+
+
+
+#if ADC_USE_DMA != 1
+/**
+ * Switch the hardware to another channel group. The function is called from the
+ * end-of-conversion interrupt, i.e. at the beginning of a conversion cycle, and the
+ * switch becomes effective with the next cycle:\n
+ *   The start index of the CTU command list is held in the double-buffered register
+ * CLCR1. The new value is taken over at the next master reload, which is the trigger of
+ * the next cycle, if the general reload enable GRE is set.\n
+ *   The eTimer reloads its counter at the end of each counter period from register LOAD.
+ * One conversion cycle consists of two counter periods, see initETimer(). The second
+ * period of the current cycle will already have the new duration; the cycle, in which the
+ * switch is done, has the mean length of old and new cycle time.\n
+ *   The end-of-conversion interrupt is moved to the ADC and channel, which complete the
+ * new cycle.
+ *   @param idxGroup
+ * The index of the new channel group.
+ */
+static void activateChannelGroup(unsigned int idxGroup)
+{
+    assert(idxGroup < ADC_NO_CHANNEL_GROUPS);
+    const channelGroup_t * const pOldGroup = &_channelGroupAry[_idxActiveGroup]
+                       , * const pNewGroup = &_channelGroupAry[idxGroup];
+
+    /* Select the command list of the new group. CTUCR is written as a whole: Writing a 0
+       has no effect for all of its bits, so only GRE is set. */
+    CTU.CLCR1.B.T0INDEX = pNewGroup->idxCmdFirst;
+    CTU.CTUCR.R = 0x0002;
+
+    /* The new cycle time. The cycle, which is currently running, has the mean length of
+       old and new cycle time; the time stamping needs to know. */
+    ETIMER.CHANNEL[TIMER_CHN].LOAD.R = pNewGroup->regValLoad;
+    _tiCycleInTicks = T_CYCLE_IN_TICKS(pOldGroup->regValLoad)/2u
+                      + T_CYCLE_IN_TICKS(pNewGroup->regValLoad)/2u;
+    _tiNextCycleInTicks = T_CYCLE_IN_TICKS(pNewGroup->regValLoad);
+
+    /* Move the end-of-conversion interrupt. The interrupt flag of the old source is still
+       set and will be reset by the calling ISR. A possibly set flag of the new source is
+       not related to the end of a cycle and needs to be reset before enabling. */
+    volatile ADC_tag * const pOldADC = pOldGroup->idxAdcWithIrq == 0? &ADC_0: &ADC_1
+                   , * const pNewADC = pNewGroup->idxAdcWithIrq == 0? &ADC_0: &ADC_1;
+    pOldADC->CIMR0.R = 0;
+    if(pOldADC != pNewADC)
+    {
+        pOldADC->IMR.R = 0;
+        pNewADC->ISR.R = 0x00000010ul;
+    }
+    pNewADC->CIMR0.R = 0x1u << pNewGroup->idxLastChn;
+    pNewADC->IMR.R = 0x00000010ul;
+
+    _idxActiveGroup = idxGroup;
+
+} /* End of activateChannelGroup */
+
+
+
 /**
  * The end-of-conversion interrupt handler. This interrupt is notified by the ADC unit,
  * which has more conversions to do. The first conversions of a cycle, as long as both
  * units still have to convert enabled channels, are commanded by the CTU in dual mode. If
  * one unit has more conversion then these are appended in single mode. If the last
  * conversion is done in dual mode than unit ADC_0 notifies the interrupt. In either case
- * is this the EOCTU interrupt of the last converted channel in the cycle.\n
+ * is this the EOCTU interrupt of the last converted channel in the cycle. Which unit and
+ * channel this is, depends on the currently active channel group.\n
  *   The ISR checks the status of the active ADC units (register MSR). The results are
  * marked good only if both ADCs are idle and signal the completion of all channels. In
- * this case all enabled channel conversion results are fetched from the registers CDRn.
- * These registers contain further validity information dedicated to the channel. The API
- * data is updated with the new conversion result only if this validity information is as
- * expected. Otherwise the overall validity of the conversion cycle is set to bad.\n
+ * this case all channel conversion results of the active group are fetched from the
+ * registers CDRn. These registers contain further validity information dedicated to the
+ * channel. The API data is updated with the new conversion result only if this validity
+ * information is as expected. Otherwise the overall validity of the conversion cycle is
+ * set to bad.\n
  *   Since we maintain only a single validity information for the entire conversion cycle
  * it may happen that this indicates bad although single channels have been found good and
  * have been updated in the API. However, it'll not happen that any channel is found bad
  * while the cycle related validity says good. The summarized validity information is
  * justified by the very low likelihood of ever seeing a bad result (once the configuration
- * is proven to work well).
+ * is proven to work well).\n
+ *   At the end of the cycle, the ISR switches to another channel group if this has been
+ * requested by the application.
  *   @remark 
  * See https://community.nxp.com/message/978486 for a discussion of possible interrupt
  * sources for the given purpose.
  */
 static void isrAdcAllConversionsDone(void)
 {
-#if ADC_ADC_0_NO_ACTIVE_CHNS >= ADC_ADC_1_NO_ACTIVE_CHNS
-    volatile ADC_tag * const pADC = &ADC_0;
-#else
-    volatile ADC_tag * const pADC = &ADC_1;
-#endif
+    /* The time stamp is taken as early as possible. */
+    const uint32_t tiNow = ihw_getTBL();
+
+    const channelGroup_t * const pGroup = &_channelGroupAry[_idxActiveGroup];
+    volatile ADC_tag * const pADC = pGroup->idxAdcWithIrq == 0? &ADC_0: &ADC_1;
 
     /* Check status of the ADCs. We expect the bit CTUSTART to be set and the reference
        voltage range bit depending on the configured reference voltage, but most other bits
@@ -742,126 +1702,87 @@ static void isrAdcAllConversionsDone(void)
        very low likelihood of ever seeing a problem. In this very rare case we are still on
        the safe side - we don't use a bad result but only loose some maybe still alright
        results. */
-    bool success =
+    bool success = true;
 #if ADC_ADC_0_NO_ACTIVE_CHNS > 0
-        (((ADC_0.MSR.R) ^ (0x10000u | ADC_0_BIT_REF_RANGE)) & 0x019d0027u) == 0
-        &&  ADC_0.CEOCFR0.R == ADC_ADC_0_CHANNEL_BIT_MASK
-#endif
-#if ADC_ADC_0_NO_ACTIVE_CHNS > 0  &&  ADC_ADC_1_NO_ACTIVE_CHNS > 0
-        &&
+    if(pGroup->maskAdc0 != 0)
+    {
+        success = (((ADC_0.MSR.R) ^ (0x10000u | ADC_0_BIT_REF_RANGE)) & 0x019d0027u) == 0
+                  &&  ADC_0.CEOCFR0.R == pGroup->maskAdc0;
+    }
 #endif
 #if ADC_ADC_1_NO_ACTIVE_CHNS > 0
-        (((ADC_1.MSR.R) ^ (0x10000u | ADC_0_BIT_REF_RANGE)) & 0x019d0027u) == 0
-        &&  ADC_1.CEOCFR0.R == ADC_ADC_1_CHANNEL_BIT_MASK
+    if(pGroup->maskAdc1 != 0)
+    {
+        success = success
+                  &&  (((ADC_1.MSR.R) ^ (0x10000u | ADC_1_BIT_REF_RANGE)) & 0x019d0027u) == 0
+                  &&  ADC_1.CEOCFR0.R == pGroup->maskAdc1;
+    }
 #endif
-        ;
+
+    /* The update of the results begins. A lock-free reader recognizes this by the odd
+       sequence counter, see adc_getAllChannelVoltagesInMillivolt(). */
+    ++ _seqNoResults;
+    atomic_thread_fence(memory_order_seq_cst);
+
+    /* Time stamping. The number of elapsed cycles is normally one. */
+    const unsigned int noCycles = updateTimestamp( tiNow
+                                                 , _tiCycleInTicks
+                                                 , /* noCyclesPerPeriod */ 1
+                                                 , _tiCycleInTicks == _tiNextCycleInTicks
+                                                 );
+    _tiCycleInTicks = _tiNextCycleInTicks;
 
     if(success)
     {
         _Static_assert( sizeOfAry(_conversionResAry) == sizeOfAry(adc_pCDRAry)
                       , "Internal implementation error"
                       );
-        unsigned int idxChn;
-        const volatile uint32_t * const *ppCDR = &adc_pCDRAry[0];
-        uint16_t *pConvRes = &_conversionResAry[0];
-        for(idxChn=0; idxChn<ADC_NO_ACTIVE_CHNS; ++idxChn)
+        const uint8_t *pIdxChn = &pGroup->idxChnAry[0];
+        unsigned int u;
+        for(u=0; u<pGroup->noChns; ++u)
         {
-            const uint32_t CDR = ** ppCDR++;
+            const unsigned int idxChn = *pIdxChn++;
+            const uint32_t CDR = *adc_pCDRAry[idxChn];
             if((CDR & 0x000f0000) == 0x000a0000)
-                * pConvRes++ = (uint16_t)(CDR & 0x0000ffff);
+                _conversionResAry[idxChn] = (uint16_t)(CDR & 0x0000ffff);
             else
                 success = false;
         }        
         
-        if(success)
-        {
-            /* Channel 10 is hardwired to the internal reference voltage source VREG_1.2V.
-               We store the averaged reading of this channel, know the nominal voltage and
-               can thus compute a calibration factor. This factor is then applied to all
-               the channels of the given ADC.
-                 Nominal voltage: The signal name says 1.2 V but we have measured 1.24 V at
-               two real devices and literature mostly says around 1.25 V for a bandgap
-               reference. Moreover, most purchasable reference voltage products have a
-               nominal voltage of 1.24 V. This value is what we use. */
-# if ADC_USE_ADC_0_CHANNEL_10 == 1  ||  ADC_USE_ADC_1_CHANNEL_10 == 1
-            _Static_assert( ADC_FILTER_COEF_VREG_1_2V >= 0.0f
-                            &&  ADC_FILTER_COEF_VREG_1_2V < 1.0f
-                          , "Bad filter constant configured for smoothing VREG_1.2V"
-                          );
-#endif
-# if ADC_USE_ADC_0_CHANNEL_10 == 1
-            _adc0_chn10 = _adc0_chn10 * ADC_FILTER_COEF_VREG_1_2V
-                          + (1.0f - ADC_FILTER_COEF_VREG_1_2V) / 1.24f
-                            * (float)_conversionResAry[adc_adc0_idxChn10];
-
-# endif
-# if ADC_USE_ADC_1_CHANNEL_10 == 1
-            _adc1_chn10 = _adc1_chn10 * ADC_FILTER_COEF_VREG_1_2V
-                          + (1.0f - ADC_FILTER_COEF_VREG_1_2V) / 1.24f
-                            * (float)_conversionResAry[adc_adc1_idxChn10];
-# endif
-
-            /* The reading of the TSENS channels is averaged with a simple first order low
-               pass. */
-# if ADC_USE_ADC_0_CHANNEL_15 == 1  ||  ADC_USE_ADC_1_CHANNEL_15 == 1
-            _Static_assert( ADC_FILTER_COEF_TSENS >= 0.0f  &&  ADC_FILTER_COEF_TSENS < 1.0f
-                          , "Bad filter constant configured for smoothing TSENS"
-                          );
-            assert((_TSENSOR_SEL & ~0x1u) == 0);
-#endif
-# if ADC_USE_ADC_0_CHANNEL_15 == 1
-            _TSENS_0[_TSENSOR_SEL] = _TSENS_0[_TSENSOR_SEL] * ADC_FILTER_COEF_TSENS
-                                     + (1.0f - ADC_FILTER_COEF_TSENS)
-                                       * (float)_conversionResAry[adc_adc0_idxChn15];
-#endif
-# if ADC_USE_ADC_1_CHANNEL_15 == 1
-            _TSENS_1[_TSENSOR_SEL] = _TSENS_1[_TSENSOR_SEL] * ADC_FILTER_COEF_TSENS
-                                     + (1.0f - ADC_FILTER_COEF_TSENS)
-                                       * (float)_conversionResAry[adc_adc1_idxChn15];
-#endif
-# if ADC_USE_ADC_0_CHANNEL_15 == 1  ||  ADC_USE_ADC_1_CHANNEL_15 == 1
-            _TSENSOR_SEL = (_TSENSOR_SEL+1) & 0x1;
-# endif
-# if ADC_USE_ADC_0_CHANNEL_15 == 1
-            ADC_0.CTR1.B.TSENSOR_SEL = _TSENSOR_SEL;
-# endif
-# if ADC_USE_ADC_1_CHANNEL_15 == 1
-            ADC_1.CTR1.B.TSENSOR_SEL = _TSENSOR_SEL;
-# endif
-        } /* End if(Processing of data of channels 10 and 15 possible?) */
+        /* Processing of data of channels 10 and 15 is possible only with good results. */
+        if(success  &&  pGroup->isInternalSignalsInGroup)
+            filterInternalSignals();
     } /* End if(MSR shows idle state of ADC?) */
 
 
-    /* Diagnosis: Keep track of ever failed conversions (debugging) and provide a measure
-       how long it is ago that we could successfully sample all channels. */
-    if(success)
-        _ageOfConversionResults = 0;
-    else
-    {
-        unsigned int noFailedConversions = _noFailedConversions + 1;
-        if(noFailedConversions != 0)
-            _noFailedConversions = noFailedConversions;
-        
-        unsigned short ageOfConversionResults = _ageOfConversionResults + 1;
-        if(ageOfConversionResults != 0)
-            _ageOfConversionResults = ageOfConversionResults;
-    }
+    /* Diagnosis: Keep track of ever failed conversions. */
+    updateDiagnosis(success, noCycles);
+
+    /* The update of the results is complete. */
+    atomic_thread_fence(memory_order_seq_cst);
+    ++ _seqNoResults;
     
     /* Call the user's notification function - if any. */
     if(_cbEndOfConversion != NULL)
         (*_cbEndOfConversion)();
 
-    /* Clear the channel related EOC interrupt flag to be ready for the next conversion
+    /* Clear the channel related EOC interrupt flags to be ready for the next conversion
        cycle. The interrupt is enabled for only one channel (the last one in the cycle) but
        we clear all other channels, too, to stay able to do the validity test on next entry
-       into this ISR again. */
-#if defined(DEBUG) &&  ADC_ADC_0_NO_ACTIVE_CHNS >= ADC_ADC_1_NO_ACTIVE_CHNS
-    ADC_1.CEOCFR0.R = 0x0000fffful;
-#else
+       into this ISR again. This is done for both ADCs; a channel group switch may change
+       the set of channels of either of them. */
+#if ADC_ADC_0_NO_ACTIVE_CHNS > 0
     ADC_0.CEOCFR0.R = 0x0000fffful;
 #endif
-    pADC->CEOCFR0.R = 0x0000fffful;
-    
+#if ADC_ADC_1_NO_ACTIVE_CHNS > 0
+    ADC_1.CEOCFR0.R = 0x0000fffful;
+#endif
+
+    /* Switch to another channel group if the application demands this. */
+    const unsigned int idxRequestedGroup = _idxRequestedGroup;
+    if(idxRequestedGroup != _idxActiveGroup)
+        activateChannelGroup(idxRequestedGroup);
+
     /* Clear the general interrupt flag in register ISR. We except to serve an end-of-CTU
        interrupt. This assertion would e.g. fire if the reference voltage is not found as
        expected. */
@@ -869,6 +1790,170 @@ static void isrAdcAllConversionsDone(void)
     pADC->ISR.R = 0x00000010ul;
 
 } /* End of isrAdcAllConversionsDone */
+#endif /* ADC_USE_DMA != 1 */
+
+
+
+#if ADC_USE_DMA == 1
+/**
+ * DMA mode: Get the current position of a DMA channel in the ping-pong buffer.
+ *   @return
+ * Get the index of the row of the buffer, which is written next by the channel. The range
+ * is 0 .. #NO_DMA_CYCLES-1.
+ *   @param idxDmaChn
+ * The channel to query.
+ */
+static inline unsigned int getIdxDmaCycle(unsigned int idxDmaChn)
+{
+    /* CITER has 9 Bit if channel linking is enabled and 15 Bit otherwise. It counts down
+       from BITER=NO_DMA_CYCLES to 1 and is reloaded after the last minor loop. */
+    const uint32_t tcdWord5 = EDMA.CHANNEL[idxDmaChn].TCDWORD20_.R;
+    const unsigned int CITER = (tcdWord5 & 0x80000000u) != 0
+                               ? (tcdWord5 >> 16) & 0x1ffu
+                               : (tcdWord5 >> 16) & 0x7fffu;
+    assert(CITER >= 1  &&  CITER <= NO_DMA_CYCLES);
+    return NO_DMA_CYCLES - CITER;
+
+} /* End of getIdxDmaCycle */
+
+
+
+/**
+ * DMA mode: Get the half of the ping-pong buffer, which is currently written by the DMA.
+ *   @return
+ * Get 0 or 1 for the first or second half of the buffer, respectively. If both ADCs are
+ * in use then 2 is returned in the short moment, when the primary channel has already
+ * entered the next half but the secondary channel is still busy with the last row of the
+ * other one.
+ *   @param pIdxCycleInBuf
+ * The index of the next written row in the returned half is put into * \a pIdxCycleInBuf.
+ * This is the number of cycles, which have been completed since the other half has been
+ * completed.
+ */
+static inline unsigned int getIdxDmaBufWr(unsigned int * const pIdxCycleInBuf)
+{
+    /* Note, the order of reading matters. The secondary channel is behind the primary
+       channel. We read it first. */
+    const unsigned int idxCycle = getIdxDmaCycle(DMA_CHN_IRQ);
+#ifdef DMA_CHN_SECONDARY
+    const unsigned int idxCyclePrimary = getIdxDmaCycle(DMA_CHN_PRIMARY);
+    if(idxCyclePrimary / ADC_DMA_NO_CYCLES_PER_BUFFER
+       != idxCycle / ADC_DMA_NO_CYCLES_PER_BUFFER
+      )
+    {
+        return 2;
+    }
+#endif
+    *pIdxCycleInBuf = idxCycle % ADC_DMA_NO_CYCLES_PER_BUFFER;
+    return idxCycle / ADC_DMA_NO_CYCLES_PER_BUFFER;
+
+} /* End of getIdxDmaBufWr */
+
+
+
+/**
+ * DMA mode: Extract the results of one conversion cycle from the ping-pong buffer.
+ *   @return
+ * Get \a true if all channel results passed the validation.
+ *   @param resAry
+ * The results are written into this array, ADC_0 first, followed by ADC_1; same as
+ * _conversionResAry. A result, which fails the validation, is written, too. It holds the
+ * last recent value of the ADC's CDR register.
+ *   @param idxRow
+ * The row of the buffer, i.e. the conversion cycle, to extract.
+ */
+static bool fetchDmaCycle(uint16_t resAry[ADC_NO_ACTIVE_CHNS], unsigned int idxRow)
+{
+    assert(idxRow < NO_DMA_CYCLES);
+
+    /* The validity check is the same as in the normal mode: The result needs to be new
+       (VALID), it must not be overwritten (OVERW) and it needs to come from a CTU
+       triggered conversion (RESULT). */
+    bool success = true;
+    unsigned int u;
+#if ADC_ADC_0_NO_ACTIVE_CHNS > 0
+    const uint32_t * const pRow0 = &_dmaBufAdc0[idxRow][0];
+    for(u=0; u<ADC_ADC_0_NO_ACTIVE_CHNS; ++u)
+    {
+        const uint32_t CDR = pRow0[adc_adc0_idxEnabledChannelAry[u] - ADC_0_FIRST_CDR];
+        if((CDR & 0x000f0000) != 0x000a0000)
+            success = false;
+        * resAry++ = (uint16_t)(CDR & 0x0000ffff);
+    }
+#endif
+#if ADC_ADC_1_NO_ACTIVE_CHNS > 0
+    const uint32_t * const pRow1 = &_dmaBufAdc1[idxRow][0];
+    for(u=0; u<ADC_ADC_1_NO_ACTIVE_CHNS; ++u)
+    {
+        const uint32_t CDR = pRow1[adc_adc1_idxEnabledChannelAry[u] - ADC_1_FIRST_CDR];
+        if((CDR & 0x000f0000) != 0x000a0000)
+            success = false;
+        * resAry++ = (uint16_t)(CDR & 0x0000ffff);
+    }
+#endif
+    return success;
+
+} /* End of fetchDmaCycle */
+
+
+
+/**
+ * DMA mode: The interrupt handler, which is invoked once per completed half of the
+ * ping-pong buffer, i.e. every #ADC_DMA_NO_CYCLES_PER_BUFFER conversion cycles.\n
+ *   The handler counts the completed sample blocks; this count is the base of the
+ * lock-free read access by adc_getSampleBlock(). Moreover, it takes the last cycle of the
+ * completed block to update the results of the single channel API (e.g.
+ * adc_getChannelVoltage()) and to filter the internal signals VREG_1.2V and TSENS. All
+ * other samples are not touched by the CPU in interrupt context.
+ *   @remark
+ * The measurement of TSENS requires toggling of the sensor mode. In DMA mode, the mode
+ * is toggled once per block. The handler needs to be completed before the last cycle of
+ * the next block is converted; this is the case for any reasonable interrupt priority.
+ */
+static void isrDmaSampleBlockComplete(void)
+{
+    /* The time stamp is taken as early as possible. */
+    const uint32_t tiNow = ihw_getTBL();
+
+    /* Acknowledge the interrupt. */
+    EDMA.DMACINT.R = DMA_CHN_IRQ;
+
+    /* Normally, the count is incremented by one. If the DMA is found in the same half as
+       at the previous interrupt then an interrupt has been lost and a complete block has
+       been skipped. We keep the count consistent with the DMA position. */
+    const unsigned int idxBufWr = getIdxDmaCycle(DMA_CHN_IRQ) / ADC_DMA_NO_CYCLES_PER_BUFFER;
+    unsigned long noCompletedSampleBlocks = _noCompletedSampleBlocks + 1u;
+    if((noCompletedSampleBlocks & 0x1u) != idxBufWr)
+        ++ noCompletedSampleBlocks;
+    _noCompletedSampleBlocks = noCompletedSampleBlocks;
+
+    /* The last cycle of the completed block provides the results for the single channel
+       API. */
+    ++ _seqNoResults;
+    atomic_thread_fence(memory_order_seq_cst);
+    updateTimestamp( tiNow
+                   , ADC_DMA_NO_CYCLES_PER_BUFFER
+                     * T_CYCLE_IN_TICKS(_channelGroupAry[0].regValLoad)
+                   , /* noCyclesPerPeriod */ ADC_DMA_NO_CYCLES_PER_BUFFER
+                   , /* isPeriodStable */ true
+                   );
+    const unsigned int idxRow = (1u-idxBufWr) * ADC_DMA_NO_CYCLES_PER_BUFFER
+                                + ADC_DMA_NO_CYCLES_PER_BUFFER - 1u;
+    const bool success = fetchDmaCycle(_conversionResAry, idxRow);
+    if(success)
+        filterInternalSignals();
+
+    /* Diagnosis: Keep track of ever failed conversions. */
+    updateDiagnosis(success, /* noCycles */ ADC_DMA_NO_CYCLES_PER_BUFFER);
+    atomic_thread_fence(memory_order_seq_cst);
+    ++ _seqNoResults;
+
+    /* Call the user's notification function - if any. */
+    if(_cbEndOfConversion != NULL)
+        (*_cbEndOfConversion)();
+
+} /* End of isrDmaSampleBlockComplete */
+#endif /* ADC_USE_DMA == 1 */
 
 
 
@@ -878,7 +1963,8 @@ static void isrAdcAllConversionsDone(void)
  *   Note, most settings of the driver are either hard-coded (e.g. conversion timing) or
  * made by compile-time configuration switches (preprocessor macros). Particularly, the set
  * of channels to convert are made in the latter way. It is not possible to select specific
- * ADC channels at run-time.\n
+ * ADC channels at run-time; only switching between the configured channel groups is
+ * possible, see adc_selectChannelGroup().\n
  *   The configuration and initialization only relates to ADC channels but not to MCU pins.
  * The routing of signals from external accessible MCU pins to the ADC channel inputs needs
  * to be one by the client code (see SIUL programming in the MCU reference manual),
@@ -896,7 +1982,9 @@ static void isrAdcAllConversionsDone(void)
  *   @param cbEndOfConversion
  * A callback can be passed to the driver which is invoked from the context of the
  * end-of-conversion interrupt every time a new set of conversion result has been read from
- * the ADCs. Pass NULL if not required.
+ * the ADCs. Pass NULL if not required.\n
+ *   In DMA mode (see #ADC_USE_DMA), the callback is invoked once per completed block of
+ * #ADC_DMA_NO_CYCLES_PER_BUFFER conversion cycles.
  *   @remark
  * This function must be called once and only once at system startup time. Reconfiguration
  * of the driver is not supported.
@@ -920,6 +2008,11 @@ void adc_initDriver(unsigned int priorityOfIRQ, void (*cbEndOfConversion)(void))
     assert(_cbEndOfConversion == NULL);
     _cbEndOfConversion = cbEndOfConversion;
 
+    initChannelGroups();
+#if ADC_USE_DMA != 1
+    _tiCycleInTicks = T_CYCLE_IN_TICKS(_channelGroupAry[0].regValLoad);
+    _tiNextCycleInTicks = _tiCycleInTicks;
+#endif
     initETimer();
     initCTU();
 #if ADC_ADC_0_NO_ACTIVE_CHNS > 0
@@ -929,33 +2022,46 @@ void adc_initDriver(unsigned int priorityOfIRQ, void (*cbEndOfConversion)(void))
     initADC(/* idxAdc */ 1);
 #endif
 
+#if ADC_USE_DMA == 1
+    /* DMA mode: The eDMA fetches the results of each cycle. The last channel of the DMA
+       chain raises an interrupt for each completed half of the ping-pong buffer. The
+       interrupt vector of DMA channel n is 11+n. */
+    initDMA();
+    const unsigned int vectorNumAdcEOC = 11 + DMA_CHN_IRQ;
+    assert(priorityOfIRQ > 0  &&  priorityOfIRQ <= 15);
+    ihw_installINTCInterruptHandler( isrDmaSampleBlockComplete
+                                   , vectorNumAdcEOC
+                                   , /* psrPriority */ priorityOfIRQ
+                                   , /* isPreemptable */ true
+                                   );
+#else
     /* The ADC width the most enabled conversions per cycle is programmed to raise an
        interrupt on completion of the last ADC command from the CTU. Install service
-       routine. */
-#if ADC_ADC_0_NO_ACTIVE_CHNS >= ADC_ADC_1_NO_ACTIVE_CHNS
-    const unsigned int vectorNumAdcEOC = 62; /* ADC_0 */
-#else
-    const unsigned int vectorNumAdcEOC = 82; /* ADC_1 */
-#endif
+       routine. Which ADC this is depends on the channel group; we install the service
+       routine for both ADCs in use. */
     assert(priorityOfIRQ > 0  &&  priorityOfIRQ <= 15);
+# if ADC_ADC_0_NO_ACTIVE_CHNS > 0
     ihw_installINTCInterruptHandler( isrAdcAllConversionsDone
-                                   , vectorNumAdcEOC
+                                   , /* vectorNum */ 62 /* ADC_0 */
                                    , /* psrPriority */ priorityOfIRQ
                                    , /* isPreemptable */ true
                                    );
+# endif
+# if ADC_ADC_1_NO_ACTIVE_CHNS > 0
+    ihw_installINTCInterruptHandler( isrAdcAllConversionsDone
+                                   , /* vectorNum */ 82 /* ADC_1 */
+                                   , /* psrPriority */ priorityOfIRQ
+                                   , /* isPreemptable */ true
+                                   );
+# endif
+#endif
                                   
-    /* Prepare the constants for the computation of the chip temperature. */
+    /* The fixed-point temperatures start with the same values as the floating point API. */
 #if ADC_USE_ADC_0_CHANNEL_15 == 1
-    TSENS_0_P1 = (signed long)(tac_mcuTestAndCalibrationDataAry[4] & 0x0fff);
-    TSENS_0_P2 = (signed long)(tac_mcuTestAndCalibrationDataAry[0] & 0x0fff);
-    TSENS_0_C1 = (signed long)(tac_mcuTestAndCalibrationDataAry[5] & 0x0fff);
-    TSENS_0_C2 = (signed long)(tac_mcuTestAndCalibrationDataAry[1] & 0x0fff);
+    _tsens0InCentiDegree = toCentiDegree(adc_getTsens0());
 #endif
 #if ADC_USE_ADC_1_CHANNEL_15 == 1
-    TSENS_1_P1 = (signed long)(tac_mcuTestAndCalibrationDataAry[6] & 0x0fff);
-    TSENS_1_P2 = (signed long)(tac_mcuTestAndCalibrationDataAry[2] & 0x0fff);
-    TSENS_1_C1 = (signed long)(tac_mcuTestAndCalibrationDataAry[7] & 0x0fff);
-    TSENS_1_C2 = (signed long)(tac_mcuTestAndCalibrationDataAry[3] & 0x0fff);
+    _tsens1InCentiDegree = toCentiDegree(adc_getTsens1());
 #endif
 } /* End of adc_initDriver */
 
@@ -981,6 +2087,14 @@ void adc_startConversions()
     CTU.CTUIFR.R = 0x0fff;
     CTU.CTUEFR.R = 0x1fff;
 
+#if ADC_USE_DMA == 1
+    /* Enable the primary DMA channel to accept the ADC's requests.
+         NOP, 0x80: 1: Ignore write to register
+         SERQ, 0x40: 0: Address channel with SERQ, 1: Enable all channels
+         SERQ, 0xf: Channel number */
+    EDMA.DMASERQ.R = DMA_CHN_PRIMARY;
+#endif
+
     /* Start the timer channel we are working with. */
     ETIMER.ENBL.R |= (1<<TIMER_CHN);
 
@@ -1215,11 +2329,13 @@ float adc_getChannelVoltageAndAge(unsigned short *pAge, adc_idxEnabledChannel_t
  */
 float adc_getTsens0(void)
 {
-    /* TSENS temperature calculation. */
-    const float A = _TSENS_0[0]*TSENS_0_C2 - TSENS_0_P2*_TSENS_0[1]
-              , B = _TSENS_0[1]*TSENS_0_P1 - _TSENS_0[0]*TSENS_0_C1;
+    /* TSENS temperature calculation. Numerator and denominator of the interpolation are
+       linear in the two sensor readings; the coefficients are precomputed. */
+    const tac_tsensCalibration_t * const pCal = &tac_pCalibrationRecord->tsensAry[0];
+    const float A = _TSENS_0[0]*(float)pCal->numCoef0 + _TSENS_0[1]*(float)pCal->numCoef1
+              , AB = _TSENS_0[0]*(float)pCal->denCoef0 + _TSENS_0[1]*(float)pCal->denCoef1;
 
-    return (float)TSENS_T2 + ((float)(TSENS_T1-TSENS_T2)*A)/(float)(A+B);
+    return (float)TSENS_T2 + ((float)(TSENS_T1-TSENS_T2)*A)/AB;
 
 } /* End of adc_getTsens0 */
 #endif
@@ -1233,13 +2349,366 @@ float adc_getTsens0(void)
  */
 float adc_getTsens1(void)
 {
-    /* TSENS temperature calculation. */
-    const float A = _TSENS_1[0]*TSENS_1_C2 - TSENS_1_P2*_TSENS_1[1]
-              , B = _TSENS_1[1]*TSENS_1_P1 - _TSENS_1[0]*TSENS_1_C1;
+    /* TSENS temperature calculation. Numerator and denominator of the interpolation are
+       linear in the two sensor readings; the coefficients are precomputed. */
+    const tac_tsensCalibration_t * const pCal = &tac_pCalibrationRecord->tsensAry[1];
+    const float A = _TSENS_1[0]*(float)pCal->numCoef0 + _TSENS_1[1]*(float)pCal->numCoef1
+              , AB = _TSENS_1[0]*(float)pCal->denCoef0 + _TSENS_1[1]*(float)pCal->denCoef1;
 
-    return (float)TSENS_T2 + ((float)(TSENS_T1-TSENS_T2)*A)/(float)(A+B);
+    return (float)TSENS_T2 + ((float)(TSENS_T1-TSENS_T2)*A)/AB;
 
 } /* End of adc_getTsens1 */
 #endif
 
 
+
+/**
+ * Get the last recent conversion result for a single channel in fixed-point
+ * representation. This is the counterpart of adc_getChannelVoltage() for clients, which
+ * avoid floating point operations. The calibration is the same; the scaling factors are
+ * precomputed by the end-of-conversion interrupt, the function does a single integer
+ * multiplication.
+ *   @return
+ * Get the conversion result in Millivolt.
+ *   @param idxChn
+ * The index of the channel to be read. Note, this index doesn't relate to the sixteen ADC
+ * channels available in hardware but to the set of user configured channels. A
+ * configuration dependent enumeration is offered for that.
+ *   @remark
+ * The function is lock-free. See adc_getAllChannelVoltagesInMillivolt() for the coherent
+ * reading of all channels.
+ */
+uint16_t adc_getChannelVoltageInMillivolt(adc_idxEnabledChannel_t idxChn)
+{
+    assert((unsigned)idxChn < sizeOfAry(_conversionResAry));
+    const uint32_t scale = (unsigned)idxChn < ADC_ADC_0_NO_ACTIVE_CHNS
+                           ? _scaleMillivoltAdc0
+                           : _scaleMillivoltAdc1;
+    return (uint16_t)(((uint32_t)_conversionResAry[(unsigned)idxChn] * scale
+                       + (1u<<(Q_SCALE_MV-1))
+                      ) >> Q_SCALE_MV
+                     );
+} /* End of adc_getChannelVoltageInMillivolt */
+
+
+
+/**
+ * Get the last recent conversion results of all channels in Millivolt. The results are
+ * coherently read, they all belong to the same conversion cycle, and they are returned
+ * together with their common age, see adc_getChannelAge().\n
+ *   The coherence is achieved without a critical section: The function copies the
+ * results and checks if the ISR had updated them meanwhile; in this case it retries. The
+ * conversion of two channels at a time is done with the SIMD instructions of the SPE.
+ *   @return
+ * Get \a true if the results could be read. \a false is returned only if the function is
+ * called from a context, which has interrupted the update of the results by the ADC
+ * interrupt. This must not happen if the function is called from a context of lower or
+ * same priority as the ADC interrupt, see adc_initDriver(), which is the normal use case.
+ * The contents of \a mVAry and * \a pAge are undefined in this case.
+ *   @param mVAry
+ * The results of all configured channels are written into this array. The index into the
+ * array is the enumeration adc_idxEnabledChannel_t.
+ *   @param pAge
+ * The age of the results is written into * \a pAge. See adc_getChannelAge() for details.
+ *   @remark
+ * The results of channels 15 of both ADCs are rather useless, see
+ * adc_getChannelVoltage(). Use adc_getTsens0InCentiDegree() and
+ * adc_getTsens1InCentiDegree() to read the chip temperatures.
+ */
+bool adc_getAllChannelVoltagesInMillivolt( uint16_t mVAry[adc_linkElement1]
+                                         , unsigned short * const pAge
+                                         )
+{
+    const v2u32_t round = {1u<<(Q_SCALE_MV-1), 1u<<(Q_SCALE_MV-1)};
+    unsigned int seqNo;
+    do
+    {
+        seqNo = _seqNoResults;
+        if((seqNo & 0x1u) != 0)
+            return false;
+        atomic_thread_fence(memory_order_seq_cst);
+
+        const uint32_t scaleAdc0 = _scaleMillivoltAdc0
+                     , scaleAdc1 = _scaleMillivoltAdc1;
+        unsigned int idxChn;
+        for(idxChn=0; idxChn<ADC_NO_ACTIVE_CHNS; idxChn+=2u)
+        {
+            /* The last pair may be incomplete. The second lane then computes garbage,
+               which is not stored. */
+            const unsigned int idxChn2 = idxChn+1u < ADC_NO_ACTIVE_CHNS? idxChn+1u: idxChn;
+            const v2u32_t cnt = { _conversionResAry[idxChn], _conversionResAry[idxChn2] }
+                        , scale = { idxChn < ADC_ADC_0_NO_ACTIVE_CHNS? scaleAdc0: scaleAdc1
+                                  , idxChn2 < ADC_ADC_0_NO_ACTIVE_CHNS? scaleAdc0: scaleAdc1
+                                  };
+            const v2u32_t mV = (cnt*scale + round) >> Q_SCALE_MV;
+            mVAry[idxChn] = (uint16_t)mV[0];
+            mVAry[idxChn2] = (uint16_t)mV[1];
+        }
+        *pAge = _ageOfConversionResults;
+
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+    while(_seqNoResults != seqNo);
+
+    return true;
+
+} /* End of adc_getAllChannelVoltagesInMillivolt */
+
+
+
+/**
+ * Get the raw conversion results of all configured channels together with their time
+ * stamp. All results and the time stamp belong to the same conversion cycle. The
+ * function is lock-free, it uses the same sequence counter as
+ * adc_getAllChannelVoltagesInMillivolt().
+ *   @return
+ * Get \a true if the results could be read. \a false is returned only if the function is
+ * called from a context, which has interrupted the update of the results by the ADC
+ * interrupt. See adc_getAllChannelVoltagesInMillivolt() for details.
+ *   @param rawAry
+ * The results of all configured channels are written into this array. The index into the
+ * array is the enumeration adc_idxEnabledChannel_t. The values are the same as returned by
+ * adc_getChannelRawValue(). Pass NULL if only the time stamp is required.
+ *   @param pTimestamp
+ * The time stamp of the results is written into * \a pTimestamp.
+ *   @remark
+ * In DMA mode, see #ADC_USE_DMA, the results are those of the last cycle of the last
+ * recently completed block.
+ */
+bool adc_getAllChannelRawValues( uint16_t rawAry[adc_linkElement1]
+                               , adc_timestamp_t * const pTimestamp
+                               )
+{
+    unsigned int seqNo;
+    do
+    {
+        seqNo = _seqNoResults;
+        if((seqNo & 0x1u) != 0)
+            return false;
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if(rawAry != NULL)
+        {
+            unsigned int idxChn;
+            for(idxChn=0; idxChn<ADC_NO_ACTIVE_CHNS; ++idxChn)
+                rawAry[idxChn] = _conversionResAry[idxChn];
+        }
+        *pTimestamp = _timestamp;
+        pTimestamp->age = _ageOfConversionResults;
+
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+    while(_seqNoResults != seqNo);
+
+    return true;
+
+} /* End of adc_getAllChannelRawValues */
+
+
+
+/**
+ * Get the statistics about the timing of the end-of-conversion interrupt: The jitter, the
+ * latency with respect to the equidistant time grid and the number of lost conversion
+ * cycles. The statistics are the proof, whether the sampled data is equidistant under
+ * the given load.
+ *   @return
+ * Get \a true if the statistics could be read. \a false is returned only if the function
+ * is called from a context, which has interrupted the update by the ADC interrupt. See
+ * adc_getAllChannelVoltagesInMillivolt() for details.
+ *   @param pStatistics
+ * The statistics are written into * \a pStatistics.
+ *   @param reset
+ * If \a true then the statistics are reset after reading. The reset is done by the next
+ * end-of-conversion interrupt; the statistics of this interrupt are still counted.
+ */
+bool adc_getTimingStatistics(adc_timingStatistics_t * const pStatistics, bool reset)
+{
+    unsigned int seqNo;
+    do
+    {
+        seqNo = _seqNoResults;
+        if((seqNo & 0x1u) != 0)
+            return false;
+        atomic_thread_fence(memory_order_seq_cst);
+        *pStatistics = _timingStatistics;
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+    while(_seqNoResults != seqNo);
+
+    if(reset)
+        _isResetOfTimingStatisticsRequested = true;
+
+    return true;
+
+} /* End of adc_getTimingStatistics */
+
+
+
+#if ADC_USE_ADC_0_CHANNEL_15 == 1
+/**
+ * Get the current chip temperature TSENS_0 in fixed-point representation. The value is
+ * precomputed by the end-of-conversion interrupt; the function doesn't do any floating
+ * point operation.
+ *   @return
+ * Get the temperature in hundredths of a degree centigrade.
+ */
+int16_t adc_getTsens0InCentiDegree(void)
+{
+    return (int16_t)_tsens0InCentiDegree;
+
+} /* End of adc_getTsens0InCentiDegree */
+#endif
+
+
+#if ADC_USE_ADC_1_CHANNEL_15 == 1
+/**
+ * Get the current chip temperature TSENS_1 in fixed-point representation.
+ *   @return
+ * Get the temperature in hundredths of a degree centigrade.
+ */
+int16_t adc_getTsens1InCentiDegree(void)
+{
+    return (int16_t)_tsens1InCentiDegree;
+
+} /* End of adc_getTsens1InCentiDegree */
+#endif
+
+
+#if ADC_USE_DMA == 1
+/**
+ * DMA mode: Get the last recently completed block of samples. The block contains the
+ * results of #ADC_DMA_NO_CYCLES_PER_BUFFER consecutive conversion cycles.\n
+ *   The function is lock-free; it doesn't inhibit the interrupts and it can be called
+ * from any context, also from the callback \a cbEndOfConversion, see adc_initDriver().
+ * The DMA keeps on writing while the samples are copied. The function double-checks after
+ * copying that the DMA hasn't entered the copied half of the ping-pong buffer and repeats
+ * the operation otherwise. The copying needs to complete within
+ * #ADC_DMA_NO_CYCLES_PER_BUFFER conversion cycles, otherwise the function won't return.
+ *   @return
+ * Get \a true if the block has been returned or \a false if no block has been completed
+ * yet since start of the conversions.
+ *   @param sampleAry
+ * The samples are returned in this array of #ADC_DMA_SIZE_OF_SAMPLE_BLOCK elements. The
+ * samples of a conversion cycle are consecutive, the cycles are in chronological order:
+ * The result of the enabled channel i in cycle j is found at index j*N+i, where N is
+ * the number of enabled channels. The channel indexes are the same as for the other APIs,
+ * see \a adc_idxEnabledChannel_t. The samples are the uncalibrated ADC counts, see
+ * adc_getChannelRawValue().
+ *   @param pInfo
+ * The sequence number, time stamp, age and validity of the returned block are put into
+ * * \a pInfo.
+ *   @remark
+ * The client code can use the sequence number to recognize, whether it has already
+ * processed a block. A regular task, which is due every #ADC_DMA_NO_CYCLES_PER_BUFFER
+ * cycles or more often, will not lose blocks.
+ */
+bool adc_getSampleBlock( uint16_t sampleAry[ADC_DMA_SIZE_OF_SAMPLE_BLOCK]
+                       , adc_sampleBlockInfo_t * const pInfo
+                       )
+{
+    _Static_assert( ADC_DMA_SIZE_OF_SAMPLE_BLOCK
+                    == ADC_DMA_NO_CYCLES_PER_BUFFER * ADC_NO_ACTIVE_CHNS
+                  , "Internal implementation error"
+                  );
+    while(true)
+    {
+        const unsigned long noCompletedSampleBlocks = _noCompletedSampleBlocks;
+        unsigned int idxCycleInBuf;
+        const unsigned int idxBufWr = getIdxDmaBufWr(&idxCycleInBuf);
+        if(idxBufWr > 1)
+            continue;
+
+        /* The block in the other half of the buffer is the last recently completed one.
+           The interrupt may still be pending, which is seen from the parity of the
+           count: The count is the sequence number of the block, which is currently
+           written by the DMA, or one less if the interrupt has not been served yet. */
+        unsigned long sequenceNo;
+        if((noCompletedSampleBlocks & 0x1u) == idxBufWr)
+        {
+            if(noCompletedSampleBlocks == 0)
+                return false;
+            sequenceNo = noCompletedSampleBlocks - 1u;
+        }
+        else
+            sequenceNo = noCompletedSampleBlocks;
+
+        atomic_thread_fence(memory_order_seq_cst);
+        unsigned int noFailedCycles = 0
+                   , idxRow = (1u-idxBufWr) * ADC_DMA_NO_CYCLES_PER_BUFFER
+                   , idxCycle;
+        uint16_t *pSample = &sampleAry[0];
+        for(idxCycle=0; idxCycle<ADC_DMA_NO_CYCLES_PER_BUFFER; ++idxCycle)
+        {
+            if(!fetchDmaCycle(pSample, idxRow++))
+                ++ noFailedCycles;
+            pSample += ADC_NO_ACTIVE_CHNS;
+        }
+        atomic_thread_fence(memory_order_seq_cst);
+
+        /* The copied data is consistent if the DMA is still in the other half. The count
+           may have been incremented by the interrupt, which had been pending, but by no
+           more; a complete round of the DMA would otherwise not be recognized. */
+        unsigned int dummy;
+        if(getIdxDmaBufWr(&dummy) == idxBufWr
+           &&  _noCompletedSampleBlocks - noCompletedSampleBlocks <= 1u
+          )
+        {
+            pInfo->sequenceNo = sequenceNo;
+            pInfo->idxFirstCycle = sequenceNo * ADC_DMA_NO_CYCLES_PER_BUFFER;
+            pInfo->age = idxCycleInBuf;
+            pInfo->noFailedCycles = noFailedCycles;
+            return true;
+        }
+    } /* while(Copied block is inconsistent) */
+} /* End of adc_getSampleBlock */
+#endif
+
+
+
+/**
+ * Request a switch to another channel group. The switch is done at the end of the current
+ * conversion cycle, without stopping the timer or the CTU. The first results of the new
+ * group are available after the next conversion cycle; the cycle, in which the switch
+ * happens, has the mean length of the old and the new cycle time.\n
+ *   The results of the channels, which don't belong to the new group, are no longer
+ * updated; adc_getChannelRawValue() and the other getters continue to return their last
+ * recent values. The age of the conversion results, see adc_getChannelAge(), relates to
+ * the channels of the active group only.
+ *   @return
+ * Get \a true if the request has been accepted or \a false if \a idxGroup is out of range.
+ *   @param idxGroup
+ * The index of the channel group, 0 .. #ADC_NO_CHANNEL_GROUPS-1. Group 0 is the set of all
+ * enabled channels, converted with cycle time #ADC_T_CYCLE_IN_US.
+ *   @remark
+ * The function can be called from any context. If it is called several times within the
+ * same conversion cycle then the last request wins. Use adc_getActiveChannelGroup() to
+ * find out when the switch has been done.
+ *   @remark
+ * In DMA mode, see #ADC_USE_DMA, only group 0 is available.
+ */
+bool adc_selectChannelGroup(unsigned int idxGroup)
+{
+    if(idxGroup >= ADC_NO_CHANNEL_GROUPS)
+        return false;
+
+    _idxRequestedGroup = idxGroup;
+    return true;
+
+} /* End of adc_selectChannelGroup */
+
+
+
+/**
+ * Get the index of the channel group, which is currently converted.
+ *   @return
+ * Get the index of the group in the range 0 .. #ADC_NO_CHANNEL_GROUPS-1. If the function
+ * is called from the end-of-conversion callback then the index relates to the results,
+ * which have just been fetched.
+ */
+unsigned int adc_getActiveChannelGroup(void)
+{
+    return _idxActiveGroup;
+
+} /* End of adc_getActiveChannelGroup */
+
+
@@ -93,6 +93,38 @@
     The value of the macro is an unsigned long literal, unit is Microsecond. */
 #define ADC_T_CYCLE_IN_US   (1000ul)
 
+/** Driver configuration: The number of channel groups. A channel group is a subset of the
+    enabled channels, which is converted with its own cycle time. One group is active at a
+    time and the application can switch between the groups at run-time, see
+    adc_selectChannelGroup(). Typical use case is a fast scan of a few channels and a slow
+    scan of the other, housekeeping channels.\n
+      Group 0 is always the set of all enabled channels, which is converted with cycle
+    time #ADC_T_CYCLE_IN_US. This is the group, which is active after startup. The other
+    groups are configured by the macros ADC_GROUP_n_*. The range is 1 .. 3.\n
+      The results of the channels, which don't belong to the active group, are not
+    updated. They keep their last recent value.\n
+      Channel groups are not supported in DMA mode, see #ADC_USE_DMA. */
+#define ADC_NO_CHANNEL_GROUPS       1
+
+/** Driver configuration: The channels of group 1. The channels are specified as bit mask
+    of the hardware channel numbers of ADC_0 and ADC_1, respectively. All channels need to
+    be enabled by the macros ADC_USE_ADC_x_CHANNEL_yy, too. */
+#define ADC_GROUP_1_ADC_0_CHANNELS  (0x0002u)   /// Group 1: ADC_0, channel 1
+#define ADC_GROUP_1_ADC_1_CHANNELS  (0x0000u)   /// Group 1: No channel of ADC_1
+
+/** Driver configuration: The cycle time of channel group 1. See #ADC_T_CYCLE_IN_US for
+    details. The prescaler of the eTimer is chosen for the longest cycle time of all
+    groups. The difference between shortest and longest cycle time must not be too large;
+    otherwise the resolution of the short cycle time becomes poor. */
+#define ADC_GROUP_1_T_CYCLE_IN_US   (100ul)
+
+/** Driver configuration: The channels of group 2. See #ADC_GROUP_1_ADC_0_CHANNELS. */
+#define ADC_GROUP_2_ADC_0_CHANNELS  (0x8400u)   /// Group 2: ADC_0, channels 10 and 15
+#define ADC_GROUP_2_ADC_1_CHANNELS  (0xfc00u)   /// Group 2: ADC_1, channels 10 .. 15
+
+/** Driver configuration: The cycle time of channel group 2. */
+#define ADC_GROUP_2_T_CYCLE_IN_US   (10000ul)
+
 /** The reference voltage of ADC_0. This value is used for proper configuration of ADC_0
     and for the aboslute calibration of the ADC readings in Volt. See
     adc_getChannelVoltage().\n
@@ -122,6 +154,35 @@
     from the same conversion cycle. */
 #define ADC_FILTER_COEF_VREG_1_2V   (0.99f)
 
+/** Driver configuration: The conversion results can be fetched from the ADCs in two ways.
+    If this macro is set to 0 then an interrupt is raised at the end of each conversion
+    cycle and the CPU reads the results from the ADC registers. This is appropriate for
+    cycle times down to some hundred Microseconds.\n
+      If this macro is set to 1 then the eDMA fetches the results of each cycle from the
+    ADC registers and writes them into a ping-pong buffer. An interrupt is raised only
+    once per #ADC_DMA_NO_CYCLES_PER_BUFFER cycles, when one half of the buffer is
+    complete. The client code reads the samples with adc_getSampleBlock(). This mode
+    targets sampling rates of 10 .. 50 kHz.\n
+      Note, the DMA mode uses the eDMA channels 13 and 14. Channel 15 is used by the serial
+    I/O. */
+#define ADC_USE_DMA     0
+
+/** The number of conversion cycles, whose results make up one block of samples in DMA
+    mode, see #ADC_USE_DMA. The number of interrupts is reduced by this factor in
+    comparison to the normal mode. The range is 1 .. 255.\n
+      Note, the RAM consumption of the driver is proportional to this value. */
+#define ADC_DMA_NO_CYCLES_PER_BUFFER    (32u)
+
+/** The number of samples, which is returned by adc_getSampleBlock(). The samples of one
+    conversion cycle are consecutive in the returned array, see adc_getSampleBlock(). */
+#define ADC_DMA_SIZE_OF_SAMPLE_BLOCK                                                        \
+                    (ADC_DMA_NO_CYCLES_PER_BUFFER * (unsigned int)adc_linkElement1)
+
+/** The unit of the time stamps, see adc_timestamp_t: The number of ticks per Microsecond.
+    The time stamps are taken from the time base of the CPU (register TBL), which is
+    clocked with the system clock of 120 MHz. Do not change. */
+#define ADC_TIMESTAMP_TICKS_PER_US      (120u)
+
 
 /* The software is written as portable as reasonably possible. This requires the awareness
    of the C language standard it is compiled with. */
@@ -252,6 +313,102 @@ typedef enum adc_idxEnabledChannel_t
 } adc_idxEnabledChannel_t;
 
 
+#if ADC_USE_DMA == 1
+/** The information about a block of samples, which is returned together with the samples
+    by adc_getSampleBlock(). */
+typedef struct adc_sampleBlockInfo_t
+{
+    /** The sequence number of the block. The blocks are counted from zero since start of
+        the conversions. A gap in the sequence of fetched blocks means, that the client
+        code has missed blocks. */
+    unsigned long sequenceNo;
+
+    /** The time stamp of the block. It is the index of the conversion cycle, which the
+        first sample of the block belongs to. Cycles are counted from zero since start of
+        the conversions; the sampling time is \a idxFirstCycle * #ADC_T_CYCLE_IN_US. */
+    unsigned long idxFirstCycle;
+
+    /** The age of the block at the time it is returned. The unit is #ADC_T_CYCLE_IN_US
+        and the value relates to the last sample of the block. The value is in the range 0
+        .. #ADC_DMA_NO_CYCLES_PER_BUFFER-1. */
+    unsigned int age;
+
+    /** The number of conversion cycles in the block, which have at least one channel
+        result, which didn't pass the validation. Such a result holds the last recent
+        value, which the ADC had written into its register. Normally zero. */
+    unsigned int noFailedCycles;
+
+} adc_sampleBlockInfo_t;
+#endif
+
+
+/** The time stamp of a set of conversion results. See adc_getAllChannelRawValues().\n
+      The sampling is triggered by hardware and it is strictly equidistant. The time at
+    which the results become available to the software is not; it is the time of entry
+    into the end-of-conversion interrupt, which undergoes a jitter and which is delayed
+    under load. Moreover, a cycle is entirely lost if the interrupt is served later than
+    the end of the next cycle. The time stamp provides both, the measured time and the
+    reconstructed, equidistant time grid. */
+typedef struct adc_timestamp_t
+{
+    /** The index of the conversion cycle, which the results belong to. The cycles are
+        counted from zero since start of the conversions, including the lost cycles. The
+        difference of two indexes is the number of cycle times between the two sets of
+        results. In DMA mode, see #ADC_USE_DMA, it is the index of the last cycle of the
+        last recently completed block. */
+    unsigned long idxCycle;
+
+    /** The end of the conversion cycle on the equidistant time grid. The grid is
+        reconstructed from all measured times of entry into the end-of-conversion interrupt;
+        it is aligned with the earliest ever seen entry. The unit is
+        1/#ADC_TIMESTAMP_TICKS_PER_US Microseconds; the value wraps around after about 35s.
+        This time is the right one for signal processing, which relies on equidistant
+        samples. */
+    uint32_t tiNominalInTicks;
+
+    /** The measured time of entry into the end-of-conversion interrupt. Same unit as \a
+        tiNominalInTicks. The difference \a tiIsrInTicks - \a tiNominalInTicks is the
+        latency of the interrupt in this cycle. */
+    uint32_t tiIsrInTicks;
+
+    /** The age of the results, see adc_getChannelAge(). */
+    unsigned short age;
+
+} adc_timestamp_t;
+
+
+/** Statistics about the timing of the end-of-conversion interrupt. See
+    adc_getTimingStatistics(). All times are in the unit 1/#ADC_TIMESTAMP_TICKS_PER_US
+    Microseconds. */
+typedef struct adc_timingStatistics_t
+{
+    /** The number of served end-of-conversion interrupts. */
+    unsigned long noInterrupts;
+
+    /** The number of conversion cycles, which were lost because the end-of-conversion
+        interrupt was served too late. The conversions of such a cycle are done by the
+        hardware, but the results are overwritten by the next cycle before they are
+        fetched. In DMA mode, it's the number of lost cycles, which are due to skipped
+        blocks, see adc_sampleBlockInfo_t. */
+    unsigned long noMissedCycles;
+
+    /** The minimum and maximum measured distance between two interrupts, which belong to
+        adjacent cycles (or blocks in DMA mode). The nominal value is the cycle time. The
+        difference between maximum and minimum is the peak-to-peak jitter. The distances
+        across a lost cycle or across a switch of the channel group are not considered. */
+    uint32_t tiMinDistanceInTicks, tiMaxDistanceInTicks;
+
+    /** The maximum latency of the interrupt in relation to the equidistant time grid, see
+        adc_timestamp_t. */
+    uint32_t tiMaxLatencyInTicks;
+
+    /** The sum of the latencies of all served interrupts. Divided by \a noInterrupts, it
+        is the average latency. */
+    uint64_t tiSumLatencyInTicks;
+
+} adc_timingStatistics_t;
+
+
 /*
  * Global data declarations
  */
@@ -279,14 +436,49 @@ float adc_getChannelVoltage(adc_idxEnabledChannel_t idxChn);
 /** Get the last recent conversion result for a single channel together with its age. */
 float adc_getChannelVoltageAndAge(unsigned short *pAge, adc_idxEnabledChannel_t idxChn);
 
+/** Get the last recent conversion result for a single channel in Millivolt. */
+uint16_t adc_getChannelVoltageInMillivolt(adc_idxEnabledChannel_t idxChn);
+
+/** Get the coherent conversion results of all channels in Millivolt. Lock-free. */
+bool adc_getAllChannelVoltagesInMillivolt( uint16_t mVAry[adc_linkElement1]
+                                         , unsigned short * const pAge
+                                         );
+
+/** Get the coherent raw conversion results of all channels and their time stamp. */
+bool adc_getAllChannelRawValues( uint16_t rawAry[adc_linkElement1]
+                               , adc_timestamp_t * const pTimestamp
+                               );
+
+/** Get the statistics about the timing of the end-of-conversion interrupt. */
+bool adc_getTimingStatistics(adc_timingStatistics_t * const pStatistics, bool reset);
+
+/** Switch to another channel group at the next cycle boundary. */
+bool adc_selectChannelGroup(unsigned int idxGroup);
+
+/** Get the index of the currently converted channel group. */
+unsigned int adc_getActiveChannelGroup(void);
+
+#if ADC_USE_DMA == 1
+/** DMA mode: Get the last recently completed block of samples. Lock-free. */
+bool adc_getSampleBlock( uint16_t sampleAry[ADC_DMA_SIZE_OF_SAMPLE_BLOCK]
+                       , adc_sampleBlockInfo_t * const pInfo
+                       );
+#endif
+
 #if ADC_USE_ADC_0_CHANNEL_15 == 1
 /** Get the current chip temperature TSENS_0. */
 float adc_getTsens0(void);
+
+/** Get the current chip temperature TSENS_0 in hundredths of a degree centigrade. */
+int16_t adc_getTsens0InCentiDegree(void);
 #endif
 
 #if ADC_USE_ADC_1_CHANNEL_15 == 1
 /** Get the current chip temperature TSENS_1. */
 float adc_getTsens1(void);
+
+/** Get the current chip temperature TSENS_1 in hundredths of a degree centigrade. */
+int16_t adc_getTsens1InCentiDegree(void);
 #endif
 
 #endif  /* ADC_ETIMERCLOCKEDADC_INCLUDED */
@@ -0,0 +1,304 @@
+/**
+ * @file flt_decimationFilter.c
+ * Oversampling and decimation of ADC channels in fixed-point arithmetic.\n
+ *   The ADC driver can sample at high rates, see #ADC_USE_DMA. The additional samples can
+ * be used to improve the effective resolution and to reduce the noise of the channels by
+ * low pass filtering and decimation. This module implements a CIC (cascaded
+ * integrator-comb) filter of configurable order and decimation ratio, which is followed by
+ * an optional FIR filter. The CIC filter of order one is the moving average with
+ * decimation.\n
+ *   The filter operates on blocks of samples, as returned by adc_getSampleBlock(), rather
+ * than on single samples. The integrators, which run at the input rate, process two
+ * channels at once; on the e200z4 the compiler maps this to the SIMD instructions of the
+ * SPE. The comb stages and the FIR filter run at the decimated rate only.\n
+ *   All arithmetic is integer arithmetic with well-defined results (unsigned modulo
+ * arithmetic in the CIC filter, 64 Bit accumulation and saturation in the FIR filter).
+ * The module doesn't depend on the MCU and compiles on any platform; the results are
+ * bit-exact the same on the target and on a host machine.
+ *   @remark
+ * The CIC filter has a gain of R^N, where R is the decimation ratio and N the order. The
+ * output is normalized by a right shift, so that the output has the same scaling as the
+ * input: 0x10000 means the reference voltage. The ADC results are 12 Bit, left aligned
+ * in 16 Bit; the gained resolution appears in the four lower bits of the output.
+ *   @remark
+ * Usage: Create a filter object per group of channels with same filter settings. Fetch
+ * the sample blocks from the ADC driver and pass each block to flt_processBlock() of all
+ * filter objects:\n
+ *   if(adc_getSampleBlock(sampleAry, &info))\n
+ *     noOut = flt_processBlock(&filter, outAry, 4, sampleAry, ADC_DMA_NO_CYCLES_PER_BUFFER,
+ * adc_linkElement1);
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   flt_initFilter
+ *   flt_processBlock
+ * Local functions
+ *   combAndNormalize
+ *   fir
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include "flt_decimationFilter.h"
+
+
+/*
+ * Defines
+ */
+
+/** The number of vectors, which are needed to hold all channels. */
+#define NO_VECTORS  (FLT_MAX_NO_CHNS/2)
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * The comb stages of the CIC filter and the normalization of the output. Called once per
+ * decimated output sample.
+ *   @param pFilter
+ * The filter object.
+ *   @param outAry
+ * The output samples of all channels are written into the first \a noChns elements of
+ * this array.
+ */
+static void combAndNormalize(flt_filter_t * const pFilter, uint16_t outAry[])
+{
+    const flt_filterConfig_t * const pConfig = pFilter->pConfig;
+    const unsigned int order = pConfig->order
+                     , noVectors = (pConfig->noChns+1u) / 2u
+                     , shift = order * pConfig->log2Decimation;
+
+    /* The rounding constant. Because of the limitation of shift to 16 the sum can't
+       overflow. */
+    const uint32_t round = shift > 0? 1u << (shift-1u): 0u;
+
+    unsigned int idxVec, idxStage;
+    for(idxVec=0; idxVec<noVectors; ++idxVec)
+    {
+        flt_v2u32_t y = pFilter->integAry[order-1u][idxVec];
+        for(idxStage=0; idxStage<order; ++idxStage)
+        {
+            const flt_v2u32_t tmp = y;
+            y = y - pFilter->combAry[idxStage][idxVec];
+            pFilter->combAry[idxStage][idxVec] = tmp;
+        }
+
+        /* The modulo arithmetic of the integrators and combs yields the correct result as
+           long as the true result fits into 32 Bit. */
+        outAry[2u*idxVec] = (uint16_t)((y[0] + round) >> shift);
+        if(2u*idxVec+1u < pConfig->noChns)
+            outAry[2u*idxVec+1u] = (uint16_t)((y[1] + round) >> shift);
+    }
+} /* End of combAndNormalize */
+
+
+
+/**
+ * The FIR filter, which is applied to the decimated output of the CIC filter.
+ *   @param pFilter
+ * The filter object.
+ *   @param sampleAry
+ * Prior to call: The input samples of all channels in the first \a noChns elements.\n
+ *   After return: The filtered samples. The result is rounded and saturated to the range
+ * of uint16_t.
+ */
+static void fir(flt_filter_t * const pFilter, uint16_t sampleAry[])
+{
+    const flt_filterConfig_t * const pConfig = pFilter->pConfig;
+    const unsigned int noTaps = pConfig->noFirTaps;
+
+    /* Put the new samples into the ring buffers. */
+    unsigned int idxFir = pFilter->idxFir + 1u;
+    if(idxFir >= noTaps)
+        idxFir = 0;
+    pFilter->idxFir = idxFir;
+
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<pConfig->noChns; ++idxChn)
+    {
+        const uint16_t * const delayAry = &pFilter->firDelayAry[idxChn][0];
+        pFilter->firDelayAry[idxChn][idxFir] = sampleAry[idxChn];
+
+        /* c[0] is applied to the most recent sample, c[k] to the sample k steps ago. */
+        int64_t acc = 1 << 14;
+        unsigned int idxTap
+                   , idxDelay = idxFir;
+        for(idxTap=0; idxTap<noTaps; ++idxTap)
+        {
+            acc += (int32_t)pConfig->firCoefAry[idxTap] * (int32_t)delayAry[idxDelay];
+            idxDelay = idxDelay > 0? idxDelay-1u: noTaps-1u;
+        }
+
+        /* Q15 to integer with saturation. The arithmetic right shift of a negative value
+           is implementation defined in C; GCC shifts arithmetically on all targets. */
+        acc >>= 15;
+        if(acc < 0)
+            acc = 0;
+        else if(acc > UINT16_MAX)
+            acc = UINT16_MAX;
+        sampleAry[idxChn] = (uint16_t)acc;
+    }
+} /* End of fir */
+
+
+
+/**
+ * Initialize a filter object. The filter state is reset; the first output samples will be
+ * affected by the transient response of the filter.
+ *   @return
+ * Get \a true if the configuration is valid, otherwise \a false. The filter object must
+ * not be used in the latter case.
+ *   @param pFilter
+ * The filter object to initialize.
+ *   @param pConfig
+ * The configuration of the filter. The object is referenced by the filter and needs to
+ * stay alive as long as the filter is used.
+ *   @remark
+ * The CIC filter is implemented with 32 Bit modulo arithmetic. This requires the product
+ * of order and \a log2Decimation not to exceed 16 - the input samples have 16 Bit. The
+ * function fails if the condition is not fulfilled.
+ */
+bool flt_initFilter(flt_filter_t * const pFilter, const flt_filterConfig_t * const pConfig)
+{
+    if(pConfig->noChns == 0  ||  pConfig->noChns > FLT_MAX_NO_CHNS
+       ||  pConfig->idxChnAry == NULL
+       ||  pConfig->order == 0  ||  pConfig->order > FLT_MAX_ORDER
+       ||  pConfig->log2Decimation > FLT_MAX_LOG2_DECIMATION
+       ||  pConfig->order * pConfig->log2Decimation > 16u
+       ||  (pConfig->firCoefAry == NULL) != (pConfig->noFirTaps == 0)
+       ||  pConfig->noFirTaps > FLT_MAX_NO_FIR_TAPS
+      )
+    {
+        return false;
+    }
+
+    memset(pFilter, 0, sizeof(*pFilter));
+    pFilter->pConfig = pConfig;
+    return true;
+
+} /* End of flt_initFilter */
+
+
+
+/**
+ * Filter a block of input samples.
+ *   @return
+ * Get the number of produced output rows. Each output row holds one sample of each of the
+ * \a noChns configured channels, see flt_filterConfig_t.
+ *   @param pFilter
+ * The filter object, which had been initialized with flt_initFilter().
+ *   @param outAry
+ * The output samples are written into this array. It has room for \a maxNoOutRows rows
+ * of \a noChns samples each. The scaling of the output is the same as of the input.
+ *   @param maxNoOutRows
+ * The capacity of \a outAry in rows. If the input block yields more output rows then the
+ * surplus output samples are lost but the filter state is still properly updated.
+ *   @param sampleAry
+ * The input samples. The block has \a noRows rows of \a noSamplesPerRow samples each. One
+ * row is one conversion cycle; this is the layout of the blocks returned by
+ * adc_getSampleBlock().
+ *   @param noRows
+ * The number of input rows. The number doesn't need to be a multiple of the decimation
+ * ratio, the filter state is kept across the calls.
+ *   @param noSamplesPerRow
+ * The number of samples in an input row, i.e. the distance between two samples of the
+ * same channel. Only the samples of the configured channels are processed.
+ */
+unsigned int flt_processBlock( flt_filter_t * const pFilter
+                             , uint16_t outAry[]
+                             , unsigned int maxNoOutRows
+                             , const uint16_t sampleAry[]
+                             , unsigned int noRows
+                             , unsigned int noSamplesPerRow
+                             )
+{
+    const flt_filterConfig_t * const pConfig = pFilter->pConfig;
+    const uint8_t * const idxChnAry = pConfig->idxChnAry;
+    const unsigned int noChns = pConfig->noChns
+                     , noVectors = (noChns+1u) / 2u
+                     , order = pConfig->order
+                     , decimation = 1u << pConfig->log2Decimation;
+
+    unsigned int noOutRows = 0
+               , idxRow;
+    for(idxRow=0; idxRow<noRows; ++idxRow)
+    {
+        const uint16_t * const pRow = &sampleAry[idxRow*noSamplesPerRow];
+
+        /* The integrators run at the input rate. This is the inner loop, which decides
+           about the performance. The vector operations process two channels at once. */
+        unsigned int idxVec;
+        for(idxVec=0; idxVec<noVectors; ++idxVec)
+        {
+            const unsigned int idxChn = 2u*idxVec;
+            assert(idxChnAry[idxChn] < noSamplesPerRow);
+            const uint32_t x1 = idxChn+1u < noChns? pRow[idxChnAry[idxChn+1u]]: 0u;
+            flt_v2u32_t x = {pRow[idxChnAry[idxChn]], x1};
+
+            unsigned int idxStage;
+            for(idxStage=0; idxStage<order; ++idxStage)
+            {
+                x = x + pFilter->integAry[idxStage][idxVec];
+                pFilter->integAry[idxStage][idxVec] = x;
+            }
+        }
+
+        /* Decimation: The comb stages run at the output rate. */
+        if(++pFilter->idxPhase >= decimation)
+        {
+            pFilter->idxPhase = 0;
+
+            uint16_t outRow[FLT_MAX_NO_CHNS];
+            combAndNormalize(pFilter, outRow);
+            if(pConfig->noFirTaps > 0)
+                fir(pFilter, outRow);
+
+            if(noOutRows < maxNoOutRows)
+            {
+                memcpy(&outAry[noOutRows*noChns], outRow, noChns*sizeof(outRow[0]));
+                ++ noOutRows;
+            }
+        }
+    } /* for(All input rows) */
+
+    return noOutRows;
+
+} /* End of flt_processBlock */
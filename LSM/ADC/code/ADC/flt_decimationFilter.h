@@ -0,0 +1,136 @@
+#ifndef FLT_DECIMATIONFILTER_INCLUDED
+#define FLT_DECIMATIONFILTER_INCLUDED
+/**
+ * @file flt_decimationFilter.h
+ * Definition of global interface of module flt_decimationFilter.c
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*
+ * Defines
+ */
+
+/** The maximum number of channels, which can be filtered by one filter object. */
+#define FLT_MAX_NO_CHNS         8u
+
+/** The maximum order of the CIC filter. */
+#define FLT_MAX_ORDER           4u
+
+/** The maximum decimation ratio as power of two. The product of order and this value must
+    not exceed 16, see flt_initFilter(). */
+#define FLT_MAX_LOG2_DECIMATION 8u
+
+/** The maximum number of taps of the optional FIR filter. */
+#define FLT_MAX_NO_FIR_TAPS     16u
+
+
+/*
+ * Global type definitions
+ */
+
+/** Two 32 Bit lanes, which are processed at once. With the SPE of the e200z4 the compiler
+    maps the arithmetic operations onto single SIMD instructions (e.g. evaddw). On other
+    targets, the compiler emulates the operations; the results are identical. */
+typedef uint32_t flt_v2u32_t __attribute__((vector_size(8)));
+
+/** The configuration of a filter. It is a constant object, which is referenced by the
+    filter object and which needs to stay alive as long as the filter is used. */
+typedef struct flt_filterConfig_t
+{
+    /** The number of channels, which are filtered. Range is 1 .. #FLT_MAX_NO_CHNS. */
+    unsigned int noChns;
+
+    /** The channels to filter. These are the indexes of the channels in a row of input
+        samples, see flt_processBlock(). \a noChns entries are required. */
+    const uint8_t *idxChnAry;
+
+    /** The order N of the CIC filter, 1 .. #FLT_MAX_ORDER. Order 1 is a moving average with
+        decimation. */
+    unsigned int order;
+
+    /** The decimation ratio R as power of two, 0 .. #FLT_MAX_LOG2_DECIMATION. The CIC
+        filter yields one output sample per 2^ \a log2Decimation input samples. 0 means no
+        decimation and no CIC filtering. */
+    unsigned int log2Decimation;
+
+    /** The coefficients of the optional FIR filter, which is applied to the output of the
+        CIC filter. The coefficients are in Q15 format; the gain of the filter is the sum
+        of all coefficients. Pass NULL if no FIR filter is required. */
+    const int16_t *firCoefAry;
+
+    /** The number of FIR coefficients, 1 .. #FLT_MAX_NO_FIR_TAPS, or 0 if \a firCoefAry is
+        NULL. */
+    unsigned int noFirTaps;
+
+} flt_filterConfig_t;
+
+
+/** A filter object. It holds the state of the filters of all configured channels. The
+    object is initialized by flt_initFilter() and must not be touched by the client code. */
+typedef struct flt_filter_t
+{
+    /** The configuration of the filter. */
+    const flt_filterConfig_t *pConfig;
+
+    /** The integrator stages of the CIC filter. Two channels share one vector. */
+    flt_v2u32_t integAry[FLT_MAX_ORDER][FLT_MAX_NO_CHNS/2];
+
+    /** The delay elements of the comb stages of the CIC filter. */
+    flt_v2u32_t combAry[FLT_MAX_ORDER][FLT_MAX_NO_CHNS/2];
+
+    /** The number of input samples since the last output sample of the CIC filter. */
+    unsigned int idxPhase;
+
+    /** The delay line of the FIR filter, implemented as ring buffer per channel. */
+    uint16_t firDelayAry[FLT_MAX_NO_CHNS][FLT_MAX_NO_FIR_TAPS];
+
+    /** The index of the most recent input sample in the FIR delay lines. */
+    unsigned int idxFir;
+
+} flt_filter_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize a filter object. */
+bool flt_initFilter(flt_filter_t * const pFilter, const flt_filterConfig_t * const pConfig);
+
+/** Filter a block of input samples. */
+unsigned int flt_processBlock( flt_filter_t * const pFilter
+                             , uint16_t outAry[]
+                             , unsigned int maxNoOutRows
+                             , const uint16_t sampleAry[]
+                             , unsigned int noRows
+                             , unsigned int noSamplesPerRow
+                             );
+
+#endif  /* FLT_DECIMATIONFILTER_INCLUDED */
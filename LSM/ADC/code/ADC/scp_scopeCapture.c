@@ -0,0 +1,443 @@
+/**
+ * @file scp_scopeCapture.c
+ * Triggered capture of ADC channels, like a digital storage oscilloscope does.\n
+ *   The ADC driver offers only the most recent conversion result of a channel. Transients,
+ * which happen between two activations of an application task, remain invisible. This
+ * module records a configurable set of channels in every conversion cycle into a ring
+ * buffer, which holds the pre-trigger history. A trigger condition is evaluated for one
+ * of the channels; if it is met then the module records a configurable number of
+ * post-trigger samples and hands the completed capture over to the application.\n
+ *   There are two capture buffers. While the application processes the one, the other one
+ * is filled. If the application doesn't release a capture in time then the recording is
+ * suspended until a buffer becomes free again. The hand-over between the interrupt and
+ * the application is lock-free.\n
+ *   A completed capture can be streamed out through the serial interface. The binary
+ * format is specified in sfr_scopeFrame.c; a decoder for the host is found in folder
+ * host/scopeDecoder.
+ *   @remark
+ * Usage: Call scp_onNewSample() from the end-of-conversion callback of the ADC driver, see
+ * adc_initDriver(). A low priority task polls scp_getCompletedCapture(), streams the
+ * capture with scp_streamCapture() and returns it with scp_releaseCapture().
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   scp_initCapture
+ *   scp_onNewSample
+ *   scp_getCompletedCapture
+ *   scp_releaseCapture
+ *   scp_streamCapture
+ * Local functions
+ *   isTriggerConditionMet
+ *   completeCapture
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <assert.h>
+
+#include "typ_types.h"
+#include "sio_serialIO.h"
+#include "adc_eTimerClockedAdc.h"
+#include "sfr_scopeFrame.h"
+#include "scp_scopeCapture.h"
+
+
+/*
+ * Defines
+ */
+
+/** The number of capture buffers. The implementation of the buffer hand-over is based on
+    two buffers; don't change. */
+#define NO_BUFFERS  2u
+
+/** The maximum number of frames, which are queued for serial output in one call of
+    scp_streamCapture(). Limits the share of the output buffer, which is occupied by the
+    capture, and the execution time of the call. */
+#define MAX_NO_FRAMES_PER_CALL  4u
+
+
+/*
+ * Local type definitions
+ */
+
+/** The states of a capture buffer. Only the owner of the buffer changes the state; the
+    interrupt changes free to recording to completed and the application changes completed
+    to free. */
+typedef enum bufState_t
+{
+    bufStateFree,
+    bufStateRecording,
+    bufStateCompleted,
+
+} bufState_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The configuration of the capture engine or NULL if it is not configured. */
+static const scp_captureConfig_t *_pConfig = NULL;
+
+/** The capture buffers. */
+static scp_capture_t _captureAry[NO_BUFFERS];
+
+/** The states of the capture buffers. */
+static volatile bufState_t _bufStateAry[NO_BUFFERS] = {[0 ... NO_BUFFERS-1] = bufStateFree};
+
+/** The buffer, which is recorded or which will be recorded next. Owned by the interrupt. */
+static unsigned int _idxBufRec = 0;
+
+/** The buffer, which will be handed out next to the application. Owned by the
+    application. */
+static unsigned int _idxBufRd = 0;
+
+/** The sequence number of the next capture. */
+static unsigned long _sequenceNo = 0;
+
+/* The recording state, owned by the interrupt: The next row to write, the number of rows
+   since start of recording (saturated), whether the trigger has been seen, the number of
+   still missing post-trigger rows and the previous sample of the trigger channel. */
+static unsigned int _idxWrRow = 0
+                  , _noRowsSinceArm = 0
+                  , _noPostTriggerRowsToGo = 0;
+static bool _isTriggered = false;
+static uint16_t _lastTriggerSample = 0;
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Evaluate the trigger condition for the latest sample of the trigger channel.
+ *   @return
+ * Get \a true if the condition is met.
+ *   @param sample
+ * The latest sample of the trigger channel.
+ */
+static inline bool isTriggerConditionMet(uint16_t sample)
+{
+    /* The edge detection requires the previous sample, too. */
+    const uint16_t level = _pConfig->triggerLevel;
+    const bool hasPrev = _noRowsSinceArm >= 2;
+    switch(_pConfig->triggerMode)
+    {
+    case scp_trgModeRisingEdge:
+        return hasPrev  &&  _lastTriggerSample < level  &&  sample >= level;
+    case scp_trgModeFallingEdge:
+        return hasPrev  &&  _lastTriggerSample >= level  &&  sample < level;
+    case scp_trgModeLevelAbove:
+        return sample >= level;
+    case scp_trgModeLevelBelow:
+        return sample < level;
+    case scp_trgModeImmediate:
+    default:
+        return true;
+    }
+} /* End of isTriggerConditionMet */
+
+
+
+/**
+ * Finalize the recorded capture and hand it over to the application.
+ *   @param pCapture
+ * The completed capture.
+ */
+static void completeCapture(scp_capture_t * const pCapture)
+{
+    /* The ring buffer is full. The next row to write is the oldest one. */
+    pCapture->idxFirstRow = _idxWrRow;
+    pCapture->sequenceNo = _sequenceNo++;
+
+    unsigned int noStaleSamples = 0
+               , u;
+    for(u=0; u<sizeOfAry(pCapture->isStaleBitAry); ++u)
+        noStaleSamples += (unsigned int)__builtin_popcount(pCapture->isStaleBitAry[u]);
+    pCapture->noStaleSamples = noStaleSamples;
+
+    /* The reader must not see the buffer as completed before all writes of sample data
+       and meta information are visible. */
+    atomic_thread_fence(memory_order_release);
+    _bufStateAry[_idxBufRec] = bufStateCompleted;
+    _idxBufRec = (_idxBufRec+1u) % NO_BUFFERS;
+
+} /* End of completeCapture */
+
+
+
+/**
+ * Configure the capture engine. The recording starts with the next call of
+ * scp_onNewSample().
+ *   @return
+ * Get \a true if the configuration is valid, otherwise \a false. Nothing is recorded in
+ * the latter case.
+ *   @param pConfig
+ * The configuration. The object is referenced by the capture engine and needs to stay
+ * alive.
+ *   @remark
+ * The function must be called once, before the ADC conversions are started.
+ */
+bool scp_initCapture(const scp_captureConfig_t *pConfig)
+{
+    assert(_pConfig == NULL);
+
+    if(pConfig->noChns == 0  ||  pConfig->noChns > SCP_MAX_NO_CHNS
+       ||  pConfig->idxTriggerChn >= pConfig->noChns
+       ||  (unsigned)pConfig->triggerMode > (unsigned)scp_trgModeImmediate
+       ||  pConfig->noPostTriggerSamples == 0
+       ||  pConfig->noPreTriggerSamples + pConfig->noPostTriggerSamples > SCP_MAX_NO_SAMPLES
+      )
+    {
+        return false;
+    }
+
+    unsigned int u;
+    for(u=0; u<pConfig->noChns; ++u)
+    {
+        if((unsigned)pConfig->idxChnAry[u] >= (unsigned)adc_linkElement1)
+            return false;
+    }
+
+    _pConfig = pConfig;
+    return true;
+
+} /* End of scp_initCapture */
+
+
+
+/**
+ * Record the latest conversion results of the configured channels and evaluate the
+ * trigger condition.
+ *   @remark
+ * This function needs to be called from the end-of-conversion callback of the ADC driver,
+ * once per conversion cycle, see adc_initDriver().
+ */
+void scp_onNewSample(void)
+{
+    if(_pConfig == NULL)
+        return;
+
+    scp_capture_t * const pCapture = &_captureAry[_idxBufRec];
+    const unsigned int noSamples = _pConfig->noPreTriggerSamples
+                                   + _pConfig->noPostTriggerSamples;
+    if(_bufStateAry[_idxBufRec] != bufStateRecording)
+    {
+        /* The application still uses the buffer, recording is suspended. */
+        if(_bufStateAry[_idxBufRec] != bufStateFree)
+            return;
+
+        /* Pairs with the release fence in scp_releaseCapture(). */
+        atomic_thread_fence(memory_order_acquire);
+
+        /* Start recording into the free buffer. */
+        pCapture->pConfig = _pConfig;
+        pCapture->noSamples = noSamples;
+        unsigned int u;
+        for(u=0; u<sizeOfAry(pCapture->isStaleBitAry); ++u)
+            pCapture->isStaleBitAry[u] = 0;
+        _idxWrRow = 0;
+        _noRowsSinceArm = 0;
+        _isTriggered = false;
+        _bufStateAry[_idxBufRec] = bufStateRecording;
+    }
+
+    /* Record the current row. */
+    uint16_t * const pRow = &pCapture->sampleAry[_idxWrRow][0];
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<_pConfig->noChns; ++idxChn)
+        pRow[idxChn] = adc_getChannelRawValue(_pConfig->idxChnAry[idxChn]);
+
+    const uint32_t staleBit = 0x1u << (_idxWrRow % 32u);
+    if(adc_getChannelAge() != 0)
+        pCapture->isStaleBitAry[_idxWrRow / 32u] |= staleBit;
+    else
+        pCapture->isStaleBitAry[_idxWrRow / 32u] &= ~staleBit;
+
+    if(++_idxWrRow >= noSamples)
+        _idxWrRow = 0;
+
+    /* Trigger evaluation. The trigger is accepted only after recording the complete
+       pre-trigger history. */
+    const uint16_t triggerSample = pRow[_pConfig->idxTriggerChn];
+    if(_noRowsSinceArm < UINT_MAX)
+        ++ _noRowsSinceArm;
+    if(!_isTriggered)
+    {
+        if(_noRowsSinceArm > _pConfig->noPreTriggerSamples
+           &&  isTriggerConditionMet(triggerSample)
+          )
+        {
+            /* The current row is the first of the post-trigger samples. */
+            _isTriggered = true;
+            _noPostTriggerRowsToGo = _pConfig->noPostTriggerSamples - 1u;
+        }
+    }
+    else
+    {
+        assert(_noPostTriggerRowsToGo > 0);
+        -- _noPostTriggerRowsToGo;
+    }
+    _lastTriggerSample = triggerSample;
+
+    if(_isTriggered  &&  _noPostTriggerRowsToGo == 0)
+        completeCapture(pCapture);
+
+} /* End of scp_onNewSample */
+
+
+
+/**
+ * Get the next completed capture. The captures are returned in the order of recording.
+ *   @return
+ * Get the capture or NULL if there's none. The same capture is returned again until it is
+ * released with scp_releaseCapture().
+ *   @remark
+ * This function and scp_releaseCapture() must be called from the same task.
+ */
+const scp_capture_t *scp_getCompletedCapture(void)
+{
+    if(_bufStateAry[_idxBufRd] == bufStateCompleted)
+    {
+        /* Pairs with the release fence in completeCapture(): The buffer contents must not
+           be read before the state. */
+        atomic_thread_fence(memory_order_acquire);
+        return &_captureAry[_idxBufRd];
+    }
+    else
+        return NULL;
+
+} /* End of scp_getCompletedCapture */
+
+
+
+/**
+ * Return a capture to the capture engine after use. The buffer becomes available for
+ * recording again.
+ *   @param pCapture
+ * The capture, which had been returned by scp_getCompletedCapture(). It must not be used
+ * any more after return.
+ */
+void scp_releaseCapture(const scp_capture_t *pCapture)
+{
+    assert(pCapture == &_captureAry[_idxBufRd]
+           &&  _bufStateAry[_idxBufRd] == bufStateCompleted
+          );
+    (void)pCapture;
+
+    /* All reads of the buffer contents need to be completed before the interrupt can
+       start overwriting them. */
+    atomic_thread_fence(memory_order_release);
+    _bufStateAry[_idxBufRd] = bufStateFree;
+    _idxBufRd = (_idxBufRd+1u) % NO_BUFFERS;
+
+} /* End of scp_releaseCapture */
+
+
+
+/**
+ * Stream a completed capture through the serial interface in the binary format of module
+ * sfr_scopeFrame.c. The function is non-blocking; it queues a few frames for output and
+ * returns. It needs to be called repeatedly until it reports completion.
+ *   @return
+ * Get \a true if the capture has been transmitted completely. The capture can then be
+ * released.
+ *   @param pCapture
+ * The capture, which had been returned by scp_getCompletedCapture().
+ *   @remark
+ * Each frame is queued in a single call of sio_writeSerial(), which means that the frames
+ * are not torn apart by other output, like text written with printf. If the output buffer
+ * is too full then the frame is truncated and it is repeated in the next call; the
+ * decoder on the host drops the truncated frame.
+ */
+bool scp_streamCapture(const scp_capture_t *pCapture)
+{
+    /* The streamed capture and the progress. */
+    static const scp_capture_t *pStreamedCapture_ = NULL;
+    static unsigned int idxNextRow_ = 0;
+    if(pCapture != pStreamedCapture_)
+    {
+        pStreamedCapture_ = pCapture;
+        idxNextRow_ = 0;
+    }
+
+    const scp_captureConfig_t * const pConfig = pCapture->pConfig;
+    sfr_frameHeader_t header =
+        { .sequenceNo = (uint16_t)pCapture->sequenceNo
+        , .noChns = pConfig->noChns
+        , .idxTriggerChn = pConfig->idxTriggerChn
+        , .noSamples = (uint16_t)pCapture->noSamples
+        , .idxTrigger = (uint16_t)pConfig->noPreTriggerSamples
+        , .tiCycleInUs = pConfig->tiCycleInUs
+        , .noStaleSamples = (uint16_t)pCapture->noStaleSamples
+        };
+    unsigned int u;
+    for(u=0; u<pConfig->noChns; ++u)
+        header.idxChnAry[u] = (uint8_t)pConfig->idxChnAry[u];
+
+    unsigned int noFrames = MAX_NO_FRAMES_PER_CALL;
+    while(idxNextRow_ < pCapture->noSamples  &&  noFrames-- > 0)
+    {
+        header.idxFirstRow = (uint16_t)idxNextRow_;
+        header.noRows = pCapture->noSamples - idxNextRow_;
+        if(header.noRows > SFR_MAX_NO_ROWS)
+            header.noRows = SFR_MAX_NO_ROWS;
+
+        /* Collect the rows of the frame in chronological order from the ring buffer. */
+        uint16_t sampleAry[SFR_MAX_NO_ROWS*SFR_MAX_NO_CHNS];
+        uint16_t *pSample = &sampleAry[0];
+        unsigned int idxRow = (pCapture->idxFirstRow + idxNextRow_) % pCapture->noSamples;
+        for(u=0; u<header.noRows; ++u)
+        {
+            unsigned int idxChn;
+            for(idxChn=0; idxChn<pConfig->noChns; ++idxChn)
+                * pSample++ = pCapture->sampleAry[idxRow][idxChn];
+            if(++idxRow >= pCapture->noSamples)
+                idxRow = 0;
+        }
+
+        uint8_t frameBuf[SFR_MAX_SIZE_OF_FRAME];
+        const unsigned int sizeOfFrame = sfr_encodeFrame(frameBuf, &header, sampleAry);
+        if(sio_writeSerial((const char*)frameBuf, sizeOfFrame) < sizeOfFrame)
+            return false;
+
+        idxNextRow_ += header.noRows;
+    }
+
+    if(idxNextRow_ >= pCapture->noSamples)
+    {
+        /* The buffer may be reused for another capture, which will be streamed from the
+           beginning. */
+        pStreamedCapture_ = NULL;
+        return true;
+    }
+    else
+        return false;
+
+} /* End of scp_streamCapture */
@@ -0,0 +1,147 @@
+#ifndef SCP_SCOPECAPTURE_INCLUDED
+#define SCP_SCOPECAPTURE_INCLUDED
+/**
+ * @file scp_scopeCapture.h
+ * Definition of global interface of module scp_scopeCapture.c
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "adc_eTimerClockedAdc.h"
+#include "sfr_scopeFrame.h"
+
+
+/*
+ * Defines
+ */
+
+/** The maximum number of channels, which are recorded in a capture. */
+#define SCP_MAX_NO_CHNS         (SFR_MAX_NO_CHNS)
+
+/** The maximum length of a capture, i.e. the sum of pre-trigger and post-trigger samples
+    per channel. Note, the RAM consumption of the module is twice this number times
+    #SCP_MAX_NO_CHNS times two Byte. */
+#define SCP_MAX_NO_SAMPLES      256u
+
+
+/*
+ * Global type definitions
+ */
+
+/** The trigger conditions. */
+typedef enum scp_triggerMode_t
+{
+    scp_trgModeRisingEdge,   /// The trigger channel passes the level upwards
+    scp_trgModeFallingEdge,  /// The trigger channel passes the level downwards
+    scp_trgModeLevelAbove,   /// The trigger channel is at or above the level
+    scp_trgModeLevelBelow,   /// The trigger channel is below the level
+    scp_trgModeImmediate,    /// Free running: Trigger as soon as the pre-trigger history is full
+
+} scp_triggerMode_t;
+
+
+/** The configuration of the capture engine. */
+typedef struct scp_captureConfig_t
+{
+    /** The number of recorded channels, 1 .. #SCP_MAX_NO_CHNS. */
+    unsigned int noChns;
+
+    /** The recorded channels. */
+    adc_idxEnabledChannel_t idxChnAry[SCP_MAX_NO_CHNS];
+
+    /** The channel, which is evaluated for the trigger condition, as index into \a
+        idxChnAry. */
+    unsigned int idxTriggerChn;
+
+    /** The trigger condition. */
+    scp_triggerMode_t triggerMode;
+
+    /** The trigger level as raw ADC value, see adc_getChannelRawValue(). */
+    uint16_t triggerLevel;
+
+    /** The number of samples per channel before the trigger event. */
+    unsigned int noPreTriggerSamples;
+
+    /** The number of samples per channel from the trigger event on; at least one. */
+    unsigned int noPostTriggerSamples;
+
+    /** The sampling time in Microseconds. Only used as meta data of the transmitted
+        captures. */
+    uint32_t tiCycleInUs;
+
+} scp_captureConfig_t;
+
+
+/** A completed capture. The samples are stored in a ring buffer; the oldest row is found
+    at index \a idxFirstRow. */
+typedef struct scp_capture_t
+{
+    /** The configuration, which the capture had been recorded with. */
+    const scp_captureConfig_t *pConfig;
+
+    /** A sequence number of the captures. */
+    unsigned long sequenceNo;
+
+    /** The number of rows, \a noPreTriggerSamples + \a noPostTriggerSamples. */
+    unsigned int noSamples;
+
+    /** The index of the oldest row in \a sampleAry. */
+    unsigned int idxFirstRow;
+
+    /** The number of rows, which were recorded in a cycle with failing conversions. */
+    unsigned int noStaleSamples;
+
+    /** One bit per row: The row was recorded in a cycle with failing conversions. */
+    uint32_t isStaleBitAry[(SCP_MAX_NO_SAMPLES+31u)/32u];
+
+    /** The samples, one row per conversion cycle. */
+    uint16_t sampleAry[SCP_MAX_NO_SAMPLES][SCP_MAX_NO_CHNS];
+
+} scp_capture_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Configure the capture engine and start waiting for the first trigger. */
+bool scp_initCapture(const scp_captureConfig_t *pConfig);
+
+/** Record the latest conversion results. Call from the ADC end-of-conversion callback. */
+void scp_onNewSample(void);
+
+/** Get the next completed capture or NULL. */
+const scp_capture_t *scp_getCompletedCapture(void);
+
+/** Return a completed capture to the engine after use. */
+void scp_releaseCapture(const scp_capture_t *pCapture);
+
+/** Stream a completed capture through the serial interface. Non-blocking, call repeatedly. */
+bool scp_streamCapture(const scp_capture_t *pCapture);
+
+#endif  /* SCP_SCOPECAPTURE_INCLUDED */
@@ -0,0 +1,356 @@
+/**
+ * @file sfr_scopeFrame.c
+ * The binary format for streaming captured ADC data, see scp_scopeCapture.c. The module
+ * implements the encoding of frames on the target and the decoding of a byte stream on the
+ * host. It doesn't depend on the MCU and it is compiled for both.\n
+ *   A capture is transmitted as a sequence of frames. A frame is small and self-contained:
+ * It carries a slice of rows of the capture together with all meta data. The frames can
+ * be embedded into other output, e.g. text written with printf. The decoder finds the
+ * frames by synchronization pattern and CRC and ignores all other bytes.\n
+ *   Frame layout, all multi-byte fields are little endian:\n
+ *   Offset  Size  Contents\n
+ *   0       2     Synchronization pattern 0xA5, 0x5A\n
+ *   2       1     Format version, #SFR_FORMAT_VERSION\n
+ *   3       1     Bits 0..3: Number of channels N, bits 4..7: Index of trigger channel\n
+ *   4       2     Sequence number of capture\n
+ *   6       2     Number of rows of the capture\n
+ *   8       2     Index of trigger row\n
+ *   10      2     Index of first row in this frame\n
+ *   12      1     Number of rows R in this frame\n
+ *   13      2     Number of stale samples in the capture\n
+ *   15      4     Sampling time in Microseconds\n
+ *   19      N     Indexes of the channels\n
+ *   19+N    2*R*N Samples, row by row\n
+ *   19+N+2*R*N 2  CRC-16-CCITT (initial value 0xffff) of all bytes from offset 2 on\n
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   sfr_crc16
+ *   sfr_encodeFrame
+ *   sfr_initDecoder
+ *   sfr_decodeByte
+ * Local functions
+ *   putU16
+ *   getU16
+ *   getSizeOfFrame
+ *   parseFrame
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+
+#include "sfr_scopeFrame.h"
+
+
+/*
+ * Defines
+ */
+
+/** The two bytes of the synchronization pattern. */
+#define SYNC_0  0xa5u
+#define SYNC_1  0x5au
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Write a 16 Bit word into a byte buffer, little endian.
+ *   @param p
+ * The destination address.
+ *   @param w
+ * The word to write.
+ */
+static inline void putU16(uint8_t *p, uint16_t w)
+{
+    p[0] = (uint8_t)(w & 0xffu);
+    p[1] = (uint8_t)(w >> 8);
+
+} /* End of putU16 */
+
+
+
+/**
+ * Read a 16 Bit word from a byte buffer, little endian.
+ *   @return
+ * Get the word.
+ *   @param p
+ * The source address.
+ */
+static inline uint16_t getU16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+
+} /* End of getU16 */
+
+
+
+/**
+ * Get the size of a frame from its header.
+ *   @return
+ * Get the size in Byte or 0 if the header is invalid.
+ *   @param frameBuf
+ * The first #SFR_SIZE_OF_HEADER bytes of the frame.
+ */
+static unsigned int getSizeOfFrame(const uint8_t frameBuf[])
+{
+    const unsigned int noChns = frameBuf[3] & 0x0fu
+                     , idxTriggerChn = frameBuf[3] >> 4
+                     , noRows = frameBuf[12];
+    if(frameBuf[0] != SYNC_0  ||  frameBuf[1] != SYNC_1
+       ||  frameBuf[2] != SFR_FORMAT_VERSION
+       ||  noChns == 0  ||  noChns > SFR_MAX_NO_CHNS  ||  idxTriggerChn >= noChns
+       ||  noRows == 0  ||  noRows > SFR_MAX_NO_ROWS
+      )
+    {
+        return 0;
+    }
+    return SFR_SIZE_OF_HEADER + noChns + 2u*noRows*noChns + 2u;
+
+} /* End of getSizeOfFrame */
+
+
+
+/**
+ * Extract header and samples from a complete, validated frame.
+ *   @param frameBuf
+ * The frame.
+ *   @param pHeader
+ * The meta data of the frame is returned in * \a pHeader.
+ *   @param sampleAry
+ * The samples of the frame are returned in this array, row by row.
+ */
+static void parseFrame( const uint8_t frameBuf[]
+                      , sfr_frameHeader_t *pHeader
+                      , uint16_t sampleAry[]
+                      )
+{
+    pHeader->noChns = frameBuf[3] & 0x0fu;
+    pHeader->idxTriggerChn = frameBuf[3] >> 4;
+    pHeader->sequenceNo = getU16(&frameBuf[4]);
+    pHeader->noSamples = getU16(&frameBuf[6]);
+    pHeader->idxTrigger = getU16(&frameBuf[8]);
+    pHeader->idxFirstRow = getU16(&frameBuf[10]);
+    pHeader->noRows = frameBuf[12];
+    pHeader->noStaleSamples = getU16(&frameBuf[13]);
+    pHeader->tiCycleInUs = (uint32_t)getU16(&frameBuf[15])
+                           | ((uint32_t)getU16(&frameBuf[17]) << 16);
+
+    const uint8_t *p = &frameBuf[SFR_SIZE_OF_HEADER];
+    unsigned int u;
+    for(u=0; u<pHeader->noChns; ++u)
+        pHeader->idxChnAry[u] = *p++;
+    for(u=0; u<pHeader->noRows*pHeader->noChns; ++u, p+=2)
+        sampleAry[u] = getU16(p);
+
+} /* End of parseFrame */
+
+
+
+/**
+ * Compute the CRC-16-CCITT (polynomial 0x1021) of a byte sequence. The computation can be
+ * split into several calls.
+ *   @return
+ * Get the CRC.
+ *   @param crc
+ * The initial value, 0xffff, or the result of the previous call for the preceding
+ * portion of the byte sequence.
+ *   @param pData
+ * The bytes.
+ *   @param noBytes
+ * The number of bytes.
+ */
+uint16_t sfr_crc16(uint16_t crc, const uint8_t *pData, size_t noBytes)
+{
+    while(noBytes-- > 0)
+    {
+        crc ^= (uint16_t)(*pData++ << 8);
+        unsigned int u;
+        for(u=0; u<8; ++u)
+            crc = (crc & 0x8000u) != 0? (uint16_t)((crc << 1) ^ 0x1021u): (uint16_t)(crc << 1);
+    }
+    return crc;
+
+} /* End of sfr_crc16 */
+
+
+
+/**
+ * Encode a slice of a capture as a frame.
+ *   @return
+ * Get the size of the frame in Byte.
+ *   @param frameBuf
+ * The frame is written into this buffer.
+ *   @param pHeader
+ * The meta data of the frame. The number of channels and rows are in the range
+ * 1..#SFR_MAX_NO_CHNS and 1..#SFR_MAX_NO_ROWS, respectively.
+ *   @param sampleAry
+ * The samples of the frame, \a pHeader->noRows rows of \a pHeader->noChns samples.
+ */
+unsigned int sfr_encodeFrame( uint8_t frameBuf[SFR_MAX_SIZE_OF_FRAME]
+                            , const sfr_frameHeader_t *pHeader
+                            , const uint16_t sampleAry[]
+                            )
+{
+    assert(pHeader->noChns > 0  &&  pHeader->noChns <= SFR_MAX_NO_CHNS
+           &&  pHeader->idxTriggerChn < pHeader->noChns
+           &&  pHeader->noRows > 0  &&  pHeader->noRows <= SFR_MAX_NO_ROWS
+          );
+
+    frameBuf[0] = SYNC_0;
+    frameBuf[1] = SYNC_1;
+    frameBuf[2] = SFR_FORMAT_VERSION;
+    frameBuf[3] = (uint8_t)(pHeader->noChns | (pHeader->idxTriggerChn << 4));
+    putU16(&frameBuf[4], pHeader->sequenceNo);
+    putU16(&frameBuf[6], pHeader->noSamples);
+    putU16(&frameBuf[8], pHeader->idxTrigger);
+    putU16(&frameBuf[10], pHeader->idxFirstRow);
+    frameBuf[12] = (uint8_t)pHeader->noRows;
+    putU16(&frameBuf[13], pHeader->noStaleSamples);
+    putU16(&frameBuf[15], (uint16_t)(pHeader->tiCycleInUs & 0xffffu));
+    putU16(&frameBuf[17], (uint16_t)(pHeader->tiCycleInUs >> 16));
+
+    uint8_t *p = &frameBuf[SFR_SIZE_OF_HEADER];
+    unsigned int u;
+    for(u=0; u<pHeader->noChns; ++u)
+        *p++ = pHeader->idxChnAry[u];
+    for(u=0; u<pHeader->noRows*pHeader->noChns; ++u, p+=2)
+        putU16(p, sampleAry[u]);
+
+    putU16(p, sfr_crc16(0xffffu, &frameBuf[2], (size_t)(p - &frameBuf[2])));
+    p += 2;
+
+    assert((unsigned int)(p - &frameBuf[0]) == getSizeOfFrame(frameBuf));
+    return (unsigned int)(p - &frameBuf[0]);
+
+} /* End of sfr_encodeFrame */
+
+
+
+/**
+ * Initialize a stream decoder.
+ *   @param pDecoder
+ * The decoder object.
+ */
+void sfr_initDecoder(sfr_decoder_t *pDecoder)
+{
+    memset(pDecoder, 0, sizeof(*pDecoder));
+
+} /* End of sfr_initDecoder */
+
+
+
+/**
+ * Feed the next byte of a received stream into the decoder.
+ *   @return
+ * Get \a true if the byte completes a valid frame. The frame contents are returned in * \a
+ * pHeader and \a sampleAry. Otherwise \a false is returned and the output arguments are
+ * not touched.
+ *   @param pDecoder
+ * The decoder object.
+ *   @param byte
+ * The next byte of the stream.
+ *   @param pHeader
+ * The meta data of a completed frame is returned in * \a pHeader.
+ *   @param sampleAry
+ * The samples of a completed frame are returned in this array, row by row.
+ *   @remark
+ * All bytes outside of valid frames are ignored. If a frame is found corrupted then the
+ * decoder continues the search for the synchronization pattern at the second byte of the
+ * corrupted frame; no frame is lost because of the preceding garbage.
+ */
+bool sfr_decodeByte( sfr_decoder_t *pDecoder
+                   , uint8_t byte
+                   , sfr_frameHeader_t *pHeader
+                   , uint16_t sampleAry[SFR_MAX_NO_ROWS*SFR_MAX_NO_CHNS]
+                   )
+{
+    assert(pDecoder->noBytes < sizeof(pDecoder->frameBuf));
+    pDecoder->frameBuf[pDecoder->noBytes++] = byte;
+
+    /* The loop is left as soon as the buffered bytes are either a still incomplete frame or
+       a complete, valid frame. On error, the first byte is discarded and the rest is
+       checked again. */
+    while(pDecoder->noBytes > 0)
+    {
+        const uint8_t * const frameBuf = &pDecoder->frameBuf[0];
+        const unsigned int noBytes = pDecoder->noBytes;
+        bool isBad = false;
+        if(frameBuf[0] != SYNC_0  ||  (noBytes >= 2  &&  frameBuf[1] != SYNC_1))
+            isBad = true;
+        else if(noBytes < SFR_SIZE_OF_HEADER)
+            return false;
+        else
+        {
+            const unsigned int sizeOfFrame = getSizeOfFrame(frameBuf);
+            if(sizeOfFrame == 0)
+                isBad = true;
+            else if(noBytes < sizeOfFrame)
+                return false;
+            else if(sfr_crc16(0xffffu, &frameBuf[2], sizeOfFrame-4u)
+                    == getU16(&frameBuf[sizeOfFrame-2u])
+                   )
+            {
+                /* Normally, the buffer holds exactly the frame. After resynchronization,
+                   there may be some more bytes, which are kept for the next call. */
+                parseFrame(frameBuf, pHeader, sampleAry);
+                memmove( &pDecoder->frameBuf[0]
+                       , &pDecoder->frameBuf[sizeOfFrame]
+                       , noBytes-sizeOfFrame
+                       );
+                pDecoder->noBytes = noBytes-sizeOfFrame;
+                return true;
+            }
+            else
+                isBad = true;
+        }
+
+        /* Resynchronize: Drop the first byte and look for the pattern in the rest. */
+        assert(isBad);
+        if(frameBuf[0] == SYNC_0  &&  noBytes >= SFR_SIZE_OF_HEADER)
+            ++ pDecoder->noBadFrames;
+        memmove(&pDecoder->frameBuf[0], &pDecoder->frameBuf[1], noBytes-1u);
+        pDecoder->noBytes = noBytes-1u;
+
+    } /* while(Buffered bytes need to be (re-)evaluated) */
+
+    return false;
+
+} /* End of sfr_decodeByte */
@@ -0,0 +1,145 @@
+#ifndef SFR_SCOPEFRAME_INCLUDED
+#define SFR_SCOPEFRAME_INCLUDED
+/**
+ * @file sfr_scopeFrame.h
+ * Definition of global interface of module sfr_scopeFrame.c
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/*
+ * Defines
+ */
+
+/** The version of the frame format. It is the third byte of each frame. */
+#define SFR_FORMAT_VERSION      1u
+
+/** The maximum number of channels in a frame. */
+#define SFR_MAX_NO_CHNS         4u
+
+/** The maximum number of rows of samples in a frame. A row holds one sample of each
+    channel. The number is kept small so that a frame can be queued for serial output as a
+    whole; it isn't torn apart by other output. */
+#define SFR_MAX_NO_ROWS         16u
+
+/** The size of the frame header in Byte, not including the channel list. */
+#define SFR_SIZE_OF_HEADER      19u
+
+/** The maximum size of a frame in Byte. */
+#define SFR_MAX_SIZE_OF_FRAME                                                               \
+                (SFR_SIZE_OF_HEADER + SFR_MAX_NO_CHNS                                       \
+                 + 2u*SFR_MAX_NO_ROWS*SFR_MAX_NO_CHNS + 2u /* CRC */                        \
+                )
+
+
+/*
+ * Global type definitions
+ */
+
+/** The meta data of a frame. A capture is transmitted as a sequence of frames; each frame
+    carries a slice of rows of the capture and all information needed to put the slices
+    together again. */
+typedef struct sfr_frameHeader_t
+{
+    /** The sequence number of the capture, which the frame belongs to. */
+    uint16_t sequenceNo;
+
+    /** The number of channels, 1 .. #SFR_MAX_NO_CHNS. */
+    unsigned int noChns;
+
+    /** The channels as indexes into the set of enabled ADC channels. */
+    uint8_t idxChnAry[SFR_MAX_NO_CHNS];
+
+    /** The index of the trigger channel in \a idxChnAry. */
+    unsigned int idxTriggerChn;
+
+    /** The total number of rows of the capture. */
+    uint16_t noSamples;
+
+    /** The index of the row, at which the trigger condition was met. */
+    uint16_t idxTrigger;
+
+    /** The index of the first row of this frame in the capture. */
+    uint16_t idxFirstRow;
+
+    /** The number of rows in this frame, 1 .. #SFR_MAX_NO_ROWS. */
+    unsigned int noRows;
+
+    /** The sampling time in Microseconds. */
+    uint32_t tiCycleInUs;
+
+    /** The number of samples in the capture, which are known to be stale, because the ADC
+        had reported a failing conversion. */
+    uint16_t noStaleSamples;
+
+} sfr_frameHeader_t;
+
+
+/** The state of the stream decoder. The object is initialized by sfr_initDecoder() and
+    must not be touched by the client code. */
+typedef struct sfr_decoder_t
+{
+    /** The bytes of the frame, which is currently received. */
+    uint8_t frameBuf[SFR_MAX_SIZE_OF_FRAME];
+
+    /** The number of bytes in \a frameBuf. */
+    unsigned int noBytes;
+
+    /** Statistics: The number of frames, which had been dropped because of a bad header or
+        CRC. */
+    unsigned long noBadFrames;
+
+} sfr_decoder_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Compute the CRC-16-CCITT of a byte sequence. */
+uint16_t sfr_crc16(uint16_t crc, const uint8_t *pData, size_t noBytes);
+
+/** Encode a slice of a capture as a frame. */
+unsigned int sfr_encodeFrame( uint8_t frameBuf[SFR_MAX_SIZE_OF_FRAME]
+                            , const sfr_frameHeader_t *pHeader
+                            , const uint16_t sampleAry[]
+                            );
+
+/** Initialize a stream decoder. */
+void sfr_initDecoder(sfr_decoder_t *pDecoder);
+
+/** Feed a received byte into the decoder. */
+bool sfr_decodeByte( sfr_decoder_t *pDecoder
+                   , uint8_t byte
+                   , sfr_frameHeader_t *pHeader
+                   , uint16_t sampleAry[SFR_MAX_NO_ROWS*SFR_MAX_NO_CHNS]
+                   );
+
+#endif  /* SFR_SCOPEFRAME_INCLUDED */
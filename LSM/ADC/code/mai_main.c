@@ -14,7 +14,11 @@
  * must to have a hardware timer to regularly trigger all conversions. If the same clock
  * can be used for the scheduler of the application tasks then a design becomes possible,
  * where the ADC results are synchronously acquired by hardware and processed by software
- * and this without fearing any race conditions. This is, what the sample shows.
+ * and this without fearing any race conditions. This is, what the sample shows.\n
+ *   Optionally, the sample records triggered captures of some channels with module
+ * scp_scopeCapture.c and streams them in binary format through the serial interface,
+ * interleaved with the normal text output. See #USE_SCOPE_CAPTURE; the frames can be
+ * decoded on the host with the tool in folder host/scopeDecoder.
  *
  * Copyright (C) 2017-2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -34,6 +38,7 @@
 /* Module interface
  *   main
  * Local functions
+ *   onEndOfConversion
  *   task1ms
  *   task5ms
  *   task10ms
@@ -65,12 +70,22 @@
 #include "lbd_ledAndButtonDriver.h"
 #include "tac_mcuTestAndCalibrationData.h"
 #include "adc_eTimerClockedAdc.h"
+#include "scp_scopeCapture.h"
 
 
 /*
  * Defines
  */
 
+/** Enable the triggered capture of some channels and the binary streaming of the captures
+    through the serial interface. The trigger is the rising edge of the temperature
+    reading of chip u4 at 30 degree Celsius; blow warm air at the chip to see a capture.
+    The capture is done on the ADC channels, which this sample enables by default. */
+#define USE_SCOPE_CAPTURE   (ADC_USE_ADC_0_CHANNEL_01 == 1 && ADC_USE_ADC_0_CHANNEL_10 == 1 \
+                             && ADC_USE_ADC_0_CHANNEL_15 == 1                               \
+                             && ADC_USE_ADC_1_CHANNEL_15 == 1                               \
+                            )
+
 
 /*
  * Local type definitions
@@ -142,11 +157,48 @@ volatile unsigned int mai_cntTaskIdle = 0;
 volatile unsigned long mai_noConversionsFailed = 0
                      , mai_noConversionsOk = 0;
 
+#if USE_SCOPE_CAPTURE == 1
+/** The configuration of the triggered capture. The trigger level of the temperature
+    reading of chip u4 is 0.6V + 10mV/C * 30C. */
+static const scp_captureConfig_t _scopeConfig =
+    { .noChns = 4
+    , .idxChnAry = { adc_adc0_idxChn01
+                   , adc_adc0_idxChn10
+                   , adc_adc0_idxChn15
+                   , adc_adc1_idxChn15
+                   }
+    , .idxTriggerChn = 0
+    , .triggerMode = scp_trgModeRisingEdge
+    , .triggerLevel = (uint16_t)(0.9f / ADC_ADC_0_REF_VOLTAGE * 0x10000)
+    , .noPreTriggerSamples = 64
+    , .noPostTriggerSamples = 192
+    , .tiCycleInUs = ADC_T_CYCLE_IN_US
+    };
+
+/** The number of captures, which have been streamed out. */
+volatile unsigned long mai_noCapturesSent = 0;
+#endif
+
 
 /*
  * Function implementation
  */
 
+/**
+ * The end-of-conversion callback of the ADC driver. It feeds the capture engine with the
+ * new conversion results and clocks the RTOS.
+ */
+static void onEndOfConversion(void)
+{
+#if USE_SCOPE_CAPTURE == 1
+    scp_onNewSample();
+#endif
+    rtos_onOsTimerTick();
+
+} /* End of onEndOfConversion */
+
+
+
 /**
  * Task function, cyclically activated every n Milliseconds. Does nothing.
  */
@@ -156,13 +208,32 @@ static void task##tiCycleInMs##ms(void)                  \
 //TASK(1)
 TASK(5)
 TASK(10)
-TASK(100)
+//TASK(100)
 //TASK(1000)
 TASK(10000)
 #undef TASK
 
 
 
+/**
+ * Task function, cyclically activated every 100 ms. It streams the completed captures of
+ * the capture engine through the serial interface. The task has a low priority; the
+ * streaming doesn't disturb the other tasks.
+ */
+static void task100ms(void)
+{
+#if USE_SCOPE_CAPTURE == 1
+    const scp_capture_t * const pCapture = scp_getCompletedCapture();
+    if(pCapture != NULL  &&  scp_streamCapture(pCapture))
+    {
+        scp_releaseCapture(pCapture);
+        ++ mai_noCapturesSent;
+    }
+#endif
+} /* End of task100ms */
+
+
+
 /**
  * Task function, cyclically activated every 1 ms. It checks the up and down of the
  * measured temperatures and controls the LEDs accordingly.
@@ -456,6 +527,23 @@ static void task1000ms(void)
               , f2d(tsens1)
               );
         printAllChannelResults();
+
+        /* Proof of equidistant sampling: Print the timing of the ADC interrupt. */
+        adc_timingStatistics_t stat;
+        if(adc_getTimingStatistics(&stat, /* reset */ true)  &&  stat.noInterrupts > 0)
+        {
+            printf( "ADC timing: %lu cycles, %lu lost, distance %.2f..%.2fus,"
+                    " latency avg %.2fus, max %.2fus\r\n"
+                  , stat.noInterrupts
+                  , stat.noMissedCycles
+                  , f2d((float)stat.tiMinDistanceInTicks / ADC_TIMESTAMP_TICKS_PER_US)
+                  , f2d((float)stat.tiMaxDistanceInTicks / ADC_TIMESTAMP_TICKS_PER_US)
+                  , f2d((float)stat.tiSumLatencyInTicks
+                        / (stat.noInterrupts * ADC_TIMESTAMP_TICKS_PER_US)
+                       )
+                  , f2d((float)stat.tiMaxLatencyInTicks / ADC_TIMESTAMP_TICKS_PER_US)
+                  );
+        }
     }
     else
     {
@@ -503,19 +591,27 @@ void main(void)
     lbd_setLED(lbd_led_D5_grn, /* isOn */ true);
 
     /* Initialize ADC hardware for measuring the temperatures.\n
-         The RTOS' main clock tick function is specified as callback, which is called from
-       the end-of-conversion interrupt of the ADC driver, after it has fetched the new data
-       from the ADC hardware; this way the application tasks are running strictly in sync
-       with the conversions (and an application task can access the data without fearing
-       any race condition).\n
+         The RTOS' main clock tick function is called from the callback (besides the
+       capture engine), which is called from the end-of-conversion interrupt of the ADC
+       driver, after it has fetched the new data from the ADC hardware; this way the
+       application tasks are running strictly in sync with the conversions (and an
+       application task can access the data without fearing any race condition).\n
          Note, we use the notification callback to trigger the RTOS scheduler. This
        requires the highest available interrupt priority. */
-    adc_initDriver(/* priorityOfIRQ */ 15, /* cbEndOfConversion */ rtos_onOsTimerTick);
+    adc_initDriver(/* priorityOfIRQ */ 15, /* cbEndOfConversion */ onEndOfConversion);
     
     /* Route analog input voltage to ADC. We use AN1 of ADC_0, port B8, PCR[24]. This
        connects the output of temperature chip u4 on the TRK-USB-MPC5643L to the ADC. */
     SIUL.PCR[24].B.APC = 1;
 
+#if USE_SCOPE_CAPTURE == 1
+    /* The capture engine is fed from the ADC callback, it needs to be configured prior to
+       starting the conversions. */
+    const bool isScopeOk = scp_initCapture(&_scopeConfig);
+    assert(isScopeOk);
+    (void)isScopeOk;
+#endif
+
     /* The RTOS is restricted to eight tasks at maximum. */
     _Static_assert(noTasks <= 8, "RTOS only supports eight tasks");
 
@@ -6,7 +6,15 @@
  * constraint is that the read function must be used only once per power cycle. It is not
  * possible to let every client of the information read the data on demand. Instead, this
  * module uses the read function and stores the fetched information in a global array for
- * everybody else.
+ * everybody else.\n
+ *   Besides the raw data, the module provides a structured record with the calibration of
+ * the chip temperature sensors. The data is validated by plausibility checks and the
+ * coefficients of the temperature computation are precomputed, such that the clients
+ * don't need to derive them.\n
+ *   The record is located in a dedicated RAM section, which is not initialized by the
+ * startup code at a functional (warm) reset, see zeroizeSRAM in sup_startup.S. It is
+ * secured by a CRC. After a warm reset, the record is reused and the flash ROM is not
+ * read again.
  *
  * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -24,7 +32,12 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 /* Module interface
+ *   tac_initTestAndCalibrationDataAry
+ *   tac_isRestoredAfterWarmReset
  * Local functions
+ *   computeCrc
+ *   getCalibrationPoint
+ *   prepareTsensCalibration
  */
 
 /*
@@ -42,51 +55,212 @@
 /*
  * Defines
  */
- 
+
+/** The magic number, which marks an initialized record in the persistent RAM. The last
+    Byte is a version designation of the layout of the record. Change it with any change
+    of tac_calibrationRecord_t. */
+#define PERSISTENT_RECORD_MAGIC     0x54414301u
+
 
 /*
  * Local type definitions
  */
- 
- 
+
+/** The record in the persistent RAM section. */
+typedef struct persistentRecord_t
+{
+    /** #PERSISTENT_RECORD_MAGIC if the record had been initialized. */
+    uint32_t magic;
+
+    /** The data. */
+    tac_calibrationRecord_t record;
+
+    /** The CRC of \a record. */
+    uint32_t crc;
+
+} persistentRecord_t;
+
+
 /*
  * Local prototypes
  */
- 
- 
+
+
 /*
  * Data definitions
  */
- 
-/** The test and calibration of the MCU instance the code is running on. The array is
-    filled with the complete test data page at system startup. It can be considered const
-    at run time. */
-static uint16_t _mcuTestAndCalibrationDataAry[TAC_NO_TEST_AND_CAL_UINT16_DATA_WORDS] =
-                                { [0 ... TAC_NO_TEST_AND_CAL_UINT16_DATA_WORDS-1] = 0 };
+
+/** The test and calibration data of the MCU instance the code is running on. The record
+    is filled from the complete test data page at system startup. It can be considered
+    const at run time.\n
+      The record is located in RAM, which is zeroized by the startup code only after a
+    destructive reset (e.g. power-on). */
+static persistentRecord_t _persistentRecord __attribute__((section(".persistentData")));
+
+/** The record has been found valid in the persistent RAM after a warm reset. */
+static bool _isRestoredAfterWarmReset = false;
 
 /** This array (implemented as a pointer) grants global read access to the test and
     calibration data of the MCU, the code is running on. I/O drivers and application code
     can read the data through this pointer.\n
       The referenced array is organized in #TAC_NO_TEST_AND_CAL_UINT16_DATA_WORDS 16 Bit
     words. */
-const uint16_t * const tac_mcuTestAndCalibrationDataAry = &_mcuTestAndCalibrationDataAry[0];
-    
+const uint16_t * const tac_mcuTestAndCalibrationDataAry =
+                                                &_persistentRecord.record.rawDataAry[0];
+
+/** The test and calibration data in structured form and with precomputed coefficients. */
+const tac_calibrationRecord_t * const tac_pCalibrationRecord = &_persistentRecord.record;
+
 
 /*
  * Function implementation
  */
 
+/**
+ * Compute the CRC-32 (polynomial 0x04C11DB7, reflected) of the calibration record.
+ *   @return
+ * Get the CRC.
+ *   @param pRecord
+ * The record.
+ */
+static uint32_t computeCrc(const tac_calibrationRecord_t * const pRecord)
+{
+    const uint8_t *pByte = (const uint8_t*)pRecord;
+    uint32_t crc = 0xffffffffu;
+    unsigned int u;
+    for(u=0; u<sizeof(*pRecord); ++u)
+    {
+        crc ^= *pByte++;
+        unsigned int idxBit;
+        for(idxBit=0; idxBit<8; ++idxBit)
+            crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 0x1u)));
+    }
+    return ~crc;
+
+} /* End of computeCrc */
+
+
+
+/**
+ * Fetch a calibration point of TSENS from the raw test and calibration data and check it.
+ *   @return
+ * Get \a true if the value is plausible.
+ *   @param pValue
+ * The 12 Bit value is returned in * \a pValue.
+ *   @param idxWord
+ * The index of the 16 Bit word in the test and calibration data.
+ */
+static bool getCalibrationPoint(int16_t * const pValue, unsigned int idxWord)
+{
+    /* The values are 12 Bit words. Unused bits read as one in flash ROM. A value of all
+       zeros or all ones is not a plausible sensor reading but an unprogrammed cell. */
+    const uint16_t value = _persistentRecord.record.rawDataAry[idxWord] & 0x0fffu;
+    *pValue = (int16_t)value;
+    return value != 0x0000u  &&  value != 0x0fffu;
+
+} /* End of getCalibrationPoint */
+
+
+
+/**
+ * Prepare the calibration of the temperature sensors TSENS_0 and TSENS_1 from the raw
+ * test and calibration data. The data is checked for plausibility and the coefficients
+ * of the temperature computation are derived.
+ *   @return
+ * Get \a true if the data of both sensors is plausible.
+ */
+static bool prepareTsensCalibration(void)
+{
+    /* The words of the test and calibration data for TSENS_n: P2 at 2n, C2 at 2n+1, P1 at
+       2n+4, C1 at 2n+5. See MCU reference manual, section 23.1.8, table 23-24. */
+    bool isValid = true;
+    unsigned int idxSensor;
+    for(idxSensor=0; idxSensor<2; ++idxSensor)
+    {
+        tac_tsensCalibration_t * const pCal = &_persistentRecord.record.tsensAry[idxSensor];
+        isValid = getCalibrationPoint(&pCal->P2, 2u*idxSensor + 0u) && isValid;
+        isValid = getCalibrationPoint(&pCal->C2, 2u*idxSensor + 1u) && isValid;
+        isValid = getCalibrationPoint(&pCal->P1, 2u*idxSensor + 4u) && isValid;
+        isValid = getCalibrationPoint(&pCal->C1, 2u*idxSensor + 5u) && isValid;
+
+        /* The computation of the temperature is:
+             A = V0*C2 - V1*P2, B = V1*P1 - V0*C1,
+             T = T2 + (T1-T2) * A/(A+B)
+           The denominator A+B is linear in the readings. At both calibration points it
+           becomes P1*C2 - P2*C1, which must not be null. */
+        const int32_t P1 = pCal->P1
+                    , C1 = pCal->C1
+                    , P2 = pCal->P2
+                    , C2 = pCal->C2;
+        if(P1 == P2  ||  C1 == C2  ||  P1*C2 - P2*C1 == 0)
+            isValid = false;
+
+        pCal->numCoef0 = C2;
+        pCal->numCoef1 = -P2;
+        pCal->denCoef0 = C2 - C1;
+        pCal->denCoef1 = P1 - P2;
+    }
+
+    if(!isValid)
+    {
+        /* Neutral coefficients, the temperature computation yields T2 for all readings. */
+        for(idxSensor=0; idxSensor<2; ++idxSensor)
+        {
+            tac_tsensCalibration_t * const pCal = &_persistentRecord.record.tsensAry[idxSensor];
+            pCal->numCoef0 = 0;
+            pCal->numCoef1 = 0;
+            pCal->denCoef0 = -1;
+            pCal->denCoef1 = 1;
+        }
+    }
+
+    return isValid;
+
+} /* End of prepareTsensCalibration */
+
+
+
 /**
  * Module initialization. Call this function once after power-up and before your
  * application code (and maybe drivers) start up. The global array \a
- * initTestAndCalibrationDataAry is filled with the device specific test and calibration
- * data, which is stored in the ROM at production time.\n
- *   Application and drivers may later access the initTestAndCalibrationDataAry for
- * reading.
+ * tac_mcuTestAndCalibrationDataAry is filled with the device specific test and
+ * calibration data, which is stored in the ROM at production time, and the structured
+ * record \a tac_pCalibrationRecord is prepared.\n
+ *   Application and drivers may later access both for reading.
+ *   @remark
+ * After a functional (warm) reset, the record is found in RAM and validated by magic
+ * number and CRC. The flash ROM is not read again in this case.
  */
 void tac_initTestAndCalibrationDataAry(void)
 {
-    rcc_readTestData( _mcuTestAndCalibrationDataAry
-                    , /* noUInt16Words */ sizeOfAry(_mcuTestAndCalibrationDataAry)
+    if(_persistentRecord.magic == PERSISTENT_RECORD_MAGIC
+       &&  _persistentRecord.crc == computeCrc(&_persistentRecord.record)
+      )
+    {
+        _isRestoredAfterWarmReset = true;
+        return;
+    }
+
+    _isRestoredAfterWarmReset = false;
+    rcc_readTestData( _persistentRecord.record.rawDataAry
+                    , /* noUInt16Words */ sizeOfAry(_persistentRecord.record.rawDataAry)
                     );
+    _persistentRecord.record.isTsensDataValid = prepareTsensCalibration();
+    _persistentRecord.crc = computeCrc(&_persistentRecord.record);
+    _persistentRecord.magic = PERSISTENT_RECORD_MAGIC;
+
 } /* End of initTestAndCalibrationDataAry */
+
+
+
+/**
+ * Diagnosis: Check if the test and calibration data has been restored from RAM after a
+ * warm reset or if it had been read from flash ROM.
+ *   @return
+ * Get \a true if tac_initTestAndCalibrationDataAry() found a valid record in RAM.
+ */
+bool tac_isRestoredAfterWarmReset(void)
+{
+    return _isRestoredAfterWarmReset;
+
+} /* End of tac_isRestoredAfterWarmReset */
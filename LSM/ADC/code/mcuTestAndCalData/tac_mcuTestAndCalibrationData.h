@@ -46,11 +46,54 @@
     size. */
 #define TAC_NO_TEST_AND_CAL_UINT16_DATA_WORDS   (0x6c/2)
 
+/** The temperatures in degree centigrade of the two calibration points of the chip
+    temperature sensors TSENS_0 and TSENS_1, see tac_tsensCalibration_t. */
+#define TAC_TSENS_T1    (150)
+#define TAC_TSENS_T2    (-40)
+
 
 /*
  * Global type definitions
  */
 
+/** The calibration data of one of the chip temperature sensors, TSENS_0 or TSENS_1,
+    prepared for the computation of the temperature. */
+typedef struct tac_tsensCalibration_t
+{
+    /** The sensor readings at the calibration points in 12 Bit ADC counts, as found in the
+        test and calibration data. P1 and P2 are taken in sensor mode 0, C1 and C2 in
+        sensor mode 1. P1 and C1 at temperature #TAC_TSENS_T1, P2 and C2 at
+        #TAC_TSENS_T2. */
+    int16_t P1, C1, P2, C2;
+
+    /** The precomputed integer coefficients of the temperature computation. With the
+        readings V0 in sensor mode 0 and V1 in sensor mode 1 the temperature is:\n
+          T = T2 + (T1-T2) * (V0*numCoef0 + V1*numCoef1) / (V0*denCoef0 + V1*denCoef1)\n
+        The scaling of V0 and V1 is irrelevant as long as both have the same. */
+    int32_t numCoef0, numCoef1, denCoef0, denCoef1;
+
+} tac_tsensCalibration_t;
+
+
+/** The test and calibration data of the MCU in structured form. The record is read from
+    flash ROM, validated and prepared once after a power-on reset and kept in RAM, which
+    is not initialized at a functional (warm) reset. */
+typedef struct tac_calibrationRecord_t
+{
+    /** The test and calibration data page as an array of 16 Bit words. All bits are
+        stored as found in ROM. See #tac_mcuTestAndCalibrationDataAry. */
+    uint16_t rawDataAry[TAC_NO_TEST_AND_CAL_UINT16_DATA_WORDS];
+
+    /** The calibration of TSENS_0 and TSENS_1. */
+    tac_tsensCalibration_t tsensAry[2];
+
+    /** The TSENS calibration data has passed the plausibility checks. If not, then \a
+        tsensAry holds neutral coefficients, which yield the constant temperature
+        #TAC_TSENS_T2. */
+    bool isTsensDataValid;
+
+} tac_calibrationRecord_t;
+
 
 /*
  * Global data declarations
@@ -66,6 +109,10 @@
     mask them. */
 extern const uint16_t * const tac_mcuTestAndCalibrationDataAry;
 
+/** The test and calibration data in structured form and with precomputed coefficients.
+    Valid after tac_initTestAndCalibrationDataAry(). */
+extern const tac_calibrationRecord_t * const tac_pCalibrationRecord;
+
 
 /*
  * Global prototypes
@@ -74,4 +121,7 @@ extern const uint16_t * const tac_mcuTestAndCalibrationDataAry;
 /** Module initialization. */
 void tac_initTestAndCalibrationDataAry(void);
 
+/** Diagnosis: The data has been restored from RAM after a warm reset. */
+bool tac_isRestoredAfterWarmReset(void);
+
 #endif  /* TAC_MCUTESTANDCALIBRATIONDATA_INCLUDED */
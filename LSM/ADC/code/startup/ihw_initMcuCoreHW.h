@@ -26,6 +26,7 @@
  *   ihw_resumeAllInterrupts
  *   ihw_enterCriticalSection
  *   ihw_leaveCriticalSection
+ *   ihw_getTBL
  */
 
 /*
@@ -159,6 +160,28 @@ static ALWAYS_INLINE void ihw_leaveCriticalSection(uint32_t msr)
 
 
 
+/**
+ * Read the lower half of the time base of the CPU. The register wraps around after about
+ * 35s.
+ *   @return
+ * Get the current register value. The value is incremented with the system clock, every
+ * 1/120MHz = (8+1/3)ns, regardless of the CPU activity.
+ */
+static ALWAYS_INLINE uint32_t ihw_getTBL()
+{
+    uint32_t TBL;
+    asm volatile ( /* AssemblerTemplate */
+                   "mfspr %0, 268\n\r" /* SPR 268 = TBL, 269 = TBU */
+                 : /* OutputOperands */ "=r" (TBL)
+                 : /* InputOperands */
+                 : /* Clobbers */
+                 );
+    return TBL;
+
+} /* End of ihw_getTBL */
+
+
+
 /*
  * Global prototypes
  */
@@ -0,0 +1,926 @@
+/**
+ * @file ads_adcDriverSimulation.c
+ * Regression test and benchmark of the ADC driver adc_eTimerClockedAdc.c on a Linux host.
+ * The unmodified driver runs against the register level peripheral model
+ * hpm_hostPeripheralModel.c. The test applies defined signals to the ADC inputs, lets the
+ * simulated time elapse and double-checks the results of the driver API: Raw values,
+ * calibrated voltages, chip temperatures, time stamps and jitter statistics, reporting of
+ * failed conversions, switching of channel groups and, in DMA mode, the sample blocks.
+ * The decimation filter is compared with a reference implementation.\n
+ *   The driver configuration is taken from adc_eTimerClockedAdc.h. The makefile can build
+ * variants of the test with patched configuration, e.g. DMA mode at high sample rate.
+ *   The process returns 0 if all tests pass.
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   main
+ * Local functions
+ *   check
+ *   onEndOfConversion
+ *   setConstant
+ *   userFctStaircase
+ *   runCycles
+ *   testDataPath
+ *   testCalibration
+ *   testTemperature
+ *   testTiming
+ *   testFailedConversion
+ *   testChannelGroups
+ *   testSampleBlocks
+ *   refDecimationFilter
+ *   testDecimationFilter
+ *   benchmarkFilter
+ *   printStatistics
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+
+#include "MPC5643L.h"
+#include "typ_types.h"
+#include "ihw_initMcuCoreHW.h"
+#include "tac_mcuTestAndCalibrationData.h"
+#include "adc_eTimerClockedAdc.h"
+#include "flt_decimationFilter.h"
+#include "hpm_hostPeripheralModel.h"
+
+
+/*
+ * Defines
+ */
+
+/** The cycle time of the default channel group in ticks of the simulated time. */
+#define TI_CYCLE    HPM_US_TO_TICKS(ADC_T_CYCLE_IN_US)
+
+/** The number of conversion cycles per end-of-conversion interrupt. */
+#if ADC_USE_DMA == 1
+# define ADC_DMA_CYCLES_PER_IRQ ADC_DMA_NO_CYCLES_PER_BUFFER
+#else
+# define ADC_DMA_CYCLES_PER_IRQ 1u
+#endif
+
+/** The maximum number of input rows of the reference implementation of the decimation
+    filter. */
+#define MAX_NO_ROWS_REF_FILTER  4096u
+
+/** Check a condition and count the failure. */
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+
+/*
+ * Local type definitions
+ */
+
+/** The mapping of an enabled channel onto the hardware. */
+typedef struct hwChn_t
+{
+    unsigned int idxAdc, idxChn;
+
+} hwChn_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The hardware channels in the order of the enumeration adc_idxEnabledChannel_t. */
+static hwChn_t _hwChnAry[adc_linkElement1];
+
+/** The number of failed checks. */
+static unsigned int _noErrors = 0;
+
+/** The number of invocations of the driver callback. */
+static unsigned long _noCallbacks = 0;
+
+/** The maximum age of the results, which was seen in the callback. */
+static unsigned short _maxAge = 0;
+
+#if ADC_USE_DMA != 1
+/** The number of channel results, which had been compared with the model in the
+    callback and the number of mismatches. */
+static unsigned long _noComparedResults = 0
+                   , _noMismatchingResults = 0;
+
+/** The number of conversions of each channel as seen in the previous callback. */
+static unsigned long _noConversionsAry[adc_linkElement1];
+
+#else
+/** The fetched sample blocks: The next expected sequence number, the number of gaps, the
+    number of samples, which broke the staircase signal, and the number of reported failed
+    cycles. */
+static unsigned long _nextSequenceNo = 0
+                   , _noBlockGaps = 0
+                   , _noBlocks = 0
+                   , _noBadSteps = 0
+                   , _noFailedCycles = 0;
+
+/** The last sample of the staircase channel of the previous block. */
+static int32_t _lastStaircaseSample = -1;
+
+/** The last fetched sample block. */
+static uint16_t _sampleAry[ADC_DMA_SIZE_OF_SAMPLE_BLOCK];
+#endif
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Report a failing check.
+ *   @param condition
+ * The result of the check.
+ *   @param pCondition
+ * The checked condition as text.
+ *   @param line
+ * The source line of the check.
+ */
+static void check(bool condition, const char *pCondition, unsigned int line)
+{
+    if(!condition)
+    {
+        ++ _noErrors;
+        printf("Line %u: Check failed: %s\n", line, pCondition);
+    }
+} /* End of check */
+
+
+
+/**
+ * The notification callback of the ADC driver. It is invoked from the end-of-conversion
+ * interrupt, after the driver fetched the results of a cycle, or of a block of cycles in
+ * DMA mode. The results are compared with the conversions done by the model.
+ */
+static void onEndOfConversion(void)
+{
+    ++ _noCallbacks;
+
+    const unsigned short age = adc_getChannelAge();
+    if(age > _maxAge)
+        _maxAge = age;
+
+#if ADC_USE_DMA != 1
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<(unsigned)adc_linkElement1; ++idxChn)
+    {
+        /* Channel 15 is not compared; the driver toggles the sensor mode and the model
+           already sees the changed register. Only channels converted in this cycle with
+           valid result can be compared. */
+        const hwChn_t * const pHwChn = &_hwChnAry[idxChn];
+        const hpm_sampleInfo_t * const pSample = hpm_getLastSample(pHwChn->idxAdc
+                                                                  , pHwChn->idxChn
+                                                                  );
+        if(pHwChn->idxChn != 15
+           &&  pSample->noConversions != _noConversionsAry[idxChn]
+           &&  pSample->isValid
+           &&  age == 0
+          )
+        {
+            ++ _noComparedResults;
+            if(adc_getChannelRawValue((adc_idxEnabledChannel_t)idxChn) != pSample->result)
+                ++ _noMismatchingResults;
+        }
+        _noConversionsAry[idxChn] = pSample->noConversions;
+    }
+#else
+    adc_sampleBlockInfo_t info;
+    if(adc_getSampleBlock(_sampleAry, &info))
+    {
+        ++ _noBlocks;
+        if(info.sequenceNo != _nextSequenceNo)
+            ++ _noBlockGaps;
+        _nextSequenceNo = info.sequenceNo + 1;
+        _noFailedCycles += info.noFailedCycles;
+
+        /* ADC_0, channel 1 carries a staircase signal with a step of 8 counts per cycle,
+           which wraps around at full scale. */
+        unsigned int u;
+        for(u=0; u<ADC_DMA_NO_CYCLES_PER_BUFFER; ++u)
+        {
+            const int32_t sample = _sampleAry[u*(unsigned)adc_linkElement1
+                                              + (unsigned)adc_adc0_idxChn01
+                                             ];
+            if(_lastStaircaseSample >= 0
+               &&  ((sample - _lastStaircaseSample) & 0xffff) != (8 << 4)
+              )
+            {
+                ++ _noBadSteps;
+            }
+            _lastStaircaseSample = sample;
+        }
+    }
+#endif
+} /* End of onEndOfConversion */
+
+
+
+/**
+ * Apply a constant signal to an ADC input.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ *   @param idxChn
+ * The channel.
+ *   @param value
+ * The voltage in Volt or the temperature in degree centigrade for channel 15.
+ *   @param noise
+ * The peak value of the noise.
+ */
+static void setConstant(unsigned int idxAdc, unsigned int idxChn, double value, double noise)
+{
+    const hpm_waveform_t waveform = { .kind = hpm_wfConstant
+                                    , .offset = value
+                                    , .noise = noise
+                                    };
+    hpm_setWaveform(idxAdc, idxChn, &waveform);
+
+} /* End of setConstant */
+
+
+
+#if ADC_USE_DMA == 1
+/**
+ * A staircase signal, which has one step of 8 ADC counts per conversion cycle. Used to
+ * check the continuity of the sample blocks in DMA mode.
+ *   @return
+ * Get the signal value in Volt.
+ *   @param tiInS
+ * The time in s.
+ */
+static double userFctStaircase(double tiInS)
+{
+    const long idxCycle = (long)floor(tiInS / (ADC_T_CYCLE_IN_US * 1e-6));
+    return (8.0*(double)(idxCycle % 512) + 0.25) * 3.3 / 4096.0;
+
+} /* End of userFctStaircase */
+#endif
+
+
+
+/**
+ * Advance the simulated time by a number of conversion cycles of the default channel
+ * group.
+ *   @param noCycles
+ * The number of cycles.
+ */
+static void runCycles(unsigned long noCycles)
+{
+    hpm_runFor(noCycles * TI_CYCLE);
+
+} /* End of runCycles */
+
+
+
+/**
+ * Test the data path: All raw results, which the driver reports, are identical to the
+ * conversion results of the model.
+ */
+static void testDataPath(void)
+{
+    printf("Test data path\n");
+#if ADC_USE_DMA != 1
+    const unsigned long noComparedResults = _noComparedResults;
+#endif
+    runCycles(500u * ADC_DMA_CYCLES_PER_IRQ);
+    CHECK(_noCallbacks >= 499);
+#if ADC_USE_DMA != 1
+    CHECK(_noComparedResults - noComparedResults >= 500);
+    CHECK(_noMismatchingResults == 0);
+#endif
+
+} /* End of testDataPath */
+
+
+
+/**
+ * Test the calibration of the voltages with VREG_1.2V: ADC_1 has a true reference voltage
+ * of 3.2V instead of the configured 3.3V. After settling of the filtered VREG reading, the
+ * voltages need to be correct anyway.
+ */
+static void testCalibration(void)
+{
+    printf("Test calibration with VREG_1.2V\n");
+
+    /* The filter of VREG_1.2V is clocked once per interrupt. */
+    runCycles(2000u * ADC_DMA_CYCLES_PER_IRQ);
+
+#if ADC_USE_DMA != 1
+    /* ADC_0 has the nominal reference voltage. Its input is a slow sine wave. */
+    const float u0 = adc_getChannelVoltage(adc_adc0_idxChn01);
+    const double u0Model = hpm_getLastSample(0, 1)->input;
+    CHECK(fabs(u0 - u0Model) < 0.003);
+    printf("  ADC_0, chn 1: %.4f V (model: %.4f V)\n", u0, u0Model);
+#endif
+
+    /* ADC_1 has 3.2V. Without calibration we would see about 515mV. */
+    const float u1 = adc_getChannelVoltage(adc_adc1_idxChn11);
+    CHECK(fabs(u1 - 0.5) < 0.003);
+    const uint16_t u1InMv = adc_getChannelVoltageInMillivolt(adc_adc1_idxChn11);
+    CHECK(u1InMv >= 497  &&  u1InMv <= 503);
+    printf("  ADC_1, chn 11: %.4f V, %u mV\n", u1, (unsigned)u1InMv);
+} /* End of testCalibration */
+
+
+
+/**
+ * Test the chip temperature measurement: A step from 25 to 80 degree centigrade.
+ */
+static void testTemperature(void)
+{
+    printf("Test temperature sensors\n");
+
+    /* The modelled calibration data is plausible. A second initialization, like after a
+       warm reset, finds the record in RAM and doesn't read the data again. */
+    CHECK(tac_pCalibrationRecord->isTsensDataValid  &&  !tac_isRestoredAfterWarmReset());
+    tac_initTestAndCalibrationDataAry();
+    CHECK(tac_isRestoredAfterWarmReset());
+
+    float T0 = adc_getTsens0()
+        , T1 = adc_getTsens1();
+    CHECK(fabsf(T0 - 25.0f) < 1.0f  &&  fabsf(T1 - 25.0f) < 1.0f);
+    printf("  TSENS_0: %.2f C, TSENS_1: %.2f C\n", T0, T1);
+
+    setConstant(0, 15, 80.0, /* noise */ 0.0);
+    setConstant(1, 15, 80.0, /* noise */ 0.0);
+    runCycles(2000u * ADC_DMA_CYCLES_PER_IRQ);
+    T0 = adc_getTsens0();
+    T1 = adc_getTsens1();
+    CHECK(fabsf(T0 - 80.0f) < 1.0f  &&  fabsf(T1 - 80.0f) < 1.0f);
+    CHECK(abs(adc_getTsens0InCentiDegree() - 8000) < 100);
+    CHECK(abs(adc_getTsens1InCentiDegree() - 8000) < 100);
+    printf( "  TSENS_0: %.2f C (%d cC), TSENS_1: %.2f C (%d cC)\n"
+          , T0, adc_getTsens0InCentiDegree(), T1, adc_getTsens1InCentiDegree()
+          );
+} /* End of testTemperature */
+
+
+
+/**
+ * Test time stamping and jitter statistics under a random interrupt latency and with a
+ * single, extremely delayed interrupt.
+ */
+static void testTiming(void)
+{
+    printf("Test time stamps and jitter\n");
+    const hpm_time_t tiMinLatency = HPM_US_TO_TICKS(1)
+                   , tiMaxLatency = HPM_US_TO_TICKS(ADC_T_CYCLE_IN_US) / 5u;
+    hpm_setIrqLatency(tiMinLatency, tiMaxLatency);
+
+    adc_timingStatistics_t stat;
+    adc_getTimingStatistics(&stat, /* reset */ true);
+    runCycles(1000);
+    CHECK(adc_getTimingStatistics(&stat, /* reset */ true));
+    CHECK(stat.noMissedCycles == 0);
+    CHECK(stat.noInterrupts >= 1000u / ADC_DMA_CYCLES_PER_IRQ - 1u);
+    /* The distance of two interrupts is the cycle time plus the difference of their
+       latencies. */
+    CHECK(stat.tiMaxDistanceInTicks - stat.tiMinDistanceInTicks
+          <= 2u * (uint32_t)(tiMaxLatency - tiMinLatency) + 1u
+         );
+    CHECK(stat.tiMaxLatencyInTicks <= (uint32_t)tiMaxLatency + HPM_US_TO_TICKS(10));
+    printf( "  %lu interrupts, distance %u .. %u ticks, max. latency %u ticks\n"
+          , stat.noInterrupts
+          , stat.tiMinDistanceInTicks
+          , stat.tiMaxDistanceInTicks
+          , stat.tiMaxLatencyInTicks
+          );
+
+    /* An interrupt, which is served later than the end of the next cycle (or block), loses
+       one cycle (or block). */
+    adc_timestamp_t timestamp;
+    uint16_t rawAry[adc_linkElement1];
+    adc_getAllChannelRawValues(rawAry, &timestamp);
+    const unsigned long idxCycle = timestamp.idxCycle;
+    hpm_delayNextIrq(TI_CYCLE * ADC_DMA_CYCLES_PER_IRQ * 3u / 2u);
+    runCycles(10u * ADC_DMA_CYCLES_PER_IRQ);
+    CHECK(adc_getTimingStatistics(&stat, /* reset */ true));
+    CHECK(stat.noMissedCycles == ADC_DMA_CYCLES_PER_IRQ);
+    adc_getAllChannelRawValues(rawAry, &timestamp);
+    CHECK(timestamp.idxCycle - idxCycle >= 9u * ADC_DMA_CYCLES_PER_IRQ);
+    printf("  Delayed interrupt: %lu missed cycles\n", stat.noMissedCycles);
+
+    hpm_setIrqLatency(HPM_US_TO_TICKS(1)/2u, HPM_US_TO_TICKS(1));
+
+} /* End of testTiming */
+
+
+
+/**
+ * Test the reporting of a failed conversion: The age of the results rises. In DMA mode,
+ * the failure is reported with the sample block.
+ */
+static void testFailedConversion(void)
+{
+    printf("Test failed conversion\n");
+    runCycles(10);
+    _maxAge = 0;
+#if ADC_USE_DMA == 1
+    const unsigned long noFailedCycles = _noFailedCycles;
+#endif
+    hpm_failNextConversions(1, 1);
+    runCycles(10u * ADC_DMA_CYCLES_PER_IRQ);
+#if ADC_USE_DMA == 1
+    CHECK(_noFailedCycles - noFailedCycles == 1);
+#else
+    CHECK(_maxAge >= 1);
+#endif
+    CHECK(adc_getChannelAge() == 0);
+
+} /* End of testFailedConversion */
+
+
+
+/**
+ * Test the switching of channel groups: The interrupt distance follows the cycle time of
+ * the group and all groups can be activated.
+ */
+static void testChannelGroups(void)
+{
+#if ADC_NO_CHANNEL_GROUPS >= 2
+    printf("Test channel groups\n");
+    static const unsigned long tiCycleAry[] = { ADC_T_CYCLE_IN_US
+                                              , ADC_GROUP_1_T_CYCLE_IN_US
+# if ADC_NO_CHANNEL_GROUPS >= 3
+                                              , ADC_GROUP_2_T_CYCLE_IN_US
+# endif
+                                              };
+    unsigned int idxGroup, idxPrevGroup = 0;
+    for(idxGroup=ADC_NO_CHANNEL_GROUPS; idxGroup>0; --idxGroup)
+    {
+        /* The switch is done at the end of the current cycle of the previous group. */
+        const unsigned int idx = idxGroup - 1u;
+        CHECK(adc_selectChannelGroup(idx));
+        hpm_runFor(2u * HPM_US_TO_TICKS(tiCycleAry[idxPrevGroup])
+                   + 2u * HPM_US_TO_TICKS(tiCycleAry[idx])
+                  );
+        CHECK(adc_getActiveChannelGroup() == idx);
+        idxPrevGroup = idx;
+
+        adc_timingStatistics_t stat;
+        adc_getTimingStatistics(&stat, /* reset */ true);
+        hpm_runFor(20u * HPM_US_TO_TICKS(tiCycleAry[idx]));
+        CHECK(adc_getTimingStatistics(&stat, /* reset */ true));
+        const uint32_t tiNominal = (uint32_t)HPM_US_TO_TICKS(tiCycleAry[idx]);
+        CHECK(stat.noMissedCycles == 0);
+        CHECK(stat.tiMinDistanceInTicks + HPM_US_TO_TICKS(1) >= tiNominal
+              &&  stat.tiMaxDistanceInTicks <= tiNominal + HPM_US_TO_TICKS(1)
+             );
+        printf( "  Group %u: %lu interrupts, distance %u .. %u ticks\n"
+              , idx
+              , stat.noInterrupts
+              , stat.tiMinDistanceInTicks
+              , stat.tiMaxDistanceInTicks
+              );
+    }
+#endif
+} /* End of testChannelGroups */
+
+
+
+/**
+ * Test DMA mode: The sample blocks are complete and continuous.
+ */
+static void testSampleBlocks(void)
+{
+#if ADC_USE_DMA == 1
+    printf("Test sample blocks\n");
+    const unsigned long noBlocks = _noBlocks;
+    _noBlockGaps = 0;
+    _noBadSteps = 0;
+    _lastStaircaseSample = -1;
+    runCycles(100u * ADC_DMA_NO_CYCLES_PER_BUFFER);
+    CHECK(_noBlocks - noBlocks >= 99);
+    CHECK(_noBlockGaps == 0);
+    CHECK(_noBadSteps == 0);
+    printf( "  %lu blocks, %lu gaps, %lu bad samples\n"
+          , _noBlocks - noBlocks
+          , _noBlockGaps
+          , _noBadSteps
+          );
+#endif
+} /* End of testSampleBlocks */
+
+
+
+/**
+ * Reference implementation of the decimation filter for testDecimationFilter(). It is
+ * written as plain as possible, independent of the fixed-point tricks of
+ * flt_decimationFilter.c: The CIC filter of order N and ratio R is computed as cascade of
+ * N moving sums of length R in 64 Bit arithmetic, which can't overflow, and its output is
+ * taken at every R-th input sample. The FIR filter is computed in double, which is exact
+ * for the occurring magnitudes.
+ *   @return
+ * Get the number of output rows.
+ *   @param pConfig
+ * The filter configuration.
+ *   @param outAry
+ * The output rows are written into this array.
+ *   @param sampleAry
+ * The input samples, \a noRows rows of \a noSamplesPerRow samples. The filter starts with
+ * zero state at the first row.
+ *   @param noRows
+ * The number of input rows, not more than #MAX_NO_ROWS_REF_FILTER.
+ *   @param noSamplesPerRow
+ * The number of samples per input row.
+ *   @param pNoSaturations
+ * The number of output samples, which had been saturated by the FIR filter, is added to
+ * * \a pNoSaturations.
+ */
+static unsigned int refDecimationFilter( const flt_filterConfig_t * const pConfig
+                                       , uint16_t outAry[]
+                                       , const uint16_t sampleAry[]
+                                       , unsigned int noRows
+                                       , unsigned int noSamplesPerRow
+                                       , unsigned long *pNoSaturations
+                                       )
+{
+    static int64_t sumAry[FLT_MAX_ORDER+1u][MAX_NO_ROWS_REF_FILTER];
+    static int64_t cicOutAry[MAX_NO_ROWS_REF_FILTER];
+    assert(noRows <= MAX_NO_ROWS_REF_FILTER);
+
+    const unsigned int order = pConfig->order
+                     , R = 1u << pConfig->log2Decimation
+                     , shift = order * pConfig->log2Decimation;
+    unsigned int noOutRows = 0;
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<pConfig->noChns; ++idxChn)
+    {
+        unsigned int n, k, j;
+        for(n=0; n<noRows; ++n)
+            sumAry[0][n] = sampleAry[n*noSamplesPerRow + pConfig->idxChnAry[idxChn]];
+        for(k=1; k<=order; ++k)
+        {
+            for(n=0; n<noRows; ++n)
+            {
+                sumAry[k][n] = 0;
+                for(j=0; j<R && j<=n; ++j)
+                    sumAry[k][n] += sumAry[k-1u][n-j];
+            }
+        }
+
+        /* Decimation and normalization with rounding. */
+        unsigned int m = 0;
+        for(n=R-1u; n<noRows; n+=R, ++m)
+        {
+            const int64_t round = shift > 0? (int64_t)1 << (shift-1u): 0;
+            cicOutAry[m] = (sumAry[order][n] + round) >> shift;
+            assert(cicOutAry[m] >= 0  &&  cicOutAry[m] <= UINT16_MAX);
+
+            int64_t y = cicOutAry[m];
+            if(pConfig->noFirTaps > 0)
+            {
+                double acc = 0.0;
+                unsigned int idxTap;
+                for(idxTap=0; idxTap<pConfig->noFirTaps && idxTap<=m; ++idxTap)
+                    acc += (double)pConfig->firCoefAry[idxTap] * (double)cicOutAry[m-idxTap];
+                const double yD = floor((acc + 16384.0) / 32768.0);
+                if(yD < 0.0)
+                {
+                    y = 0;
+                    ++ *pNoSaturations;
+                }
+                else if(yD > (double)UINT16_MAX)
+                {
+                    y = UINT16_MAX;
+                    ++ *pNoSaturations;
+                }
+                else
+                    y = (int64_t)yD;
+            }
+            outAry[m*pConfig->noChns + idxChn] = (uint16_t)y;
+        }
+        noOutRows = m;
+    }
+
+    return noOutRows;
+
+} /* End of refDecimationFilter */
+
+
+
+/**
+ * Test the decimation filter flt_processBlock(): The output of the filter needs to be
+ * bit-exact the same as of the reference implementation refDecimationFilter(). Several
+ * configurations are tested with random input, with permanent full scale input, which
+ * lets the 32 Bit integrators of the CIC filter wrap around, and with full scale steps,
+ * which drive the FIR filter into saturation at both ends. The input is passed in blocks
+ * of random length, which are not multiples of the decimation ratio.
+ */
+static void testDecimationFilter(void)
+{
+    printf("Test decimation filter\n");
+
+    enum {noSamplesPerRow = 9, noRows = MAX_NO_ROWS_REF_FILTER};
+
+    static const uint8_t idxChnAry1[] = {3}
+                       , idxChnAry3[] = {4, 0, 8}
+                       , idxChnAry8[] = {7, 6, 5, 4, 3, 2, 1, 0};
+    static const int16_t firGain2[] = {32767, 32767}
+                       , firHighPass[] = {32767, -32768, 16384}
+                       , firLowPass[] = { -300, -600, 0, 2000, 5000, 8000, 9500, 9000
+                                        , 7000, 4000, 1200, -200, -700, -500, -200, -100
+                                        };
+    static const struct
+    {
+        flt_filterConfig_t config;
+        enum {inRandom, inFullScale, inSteps} input;
+        bool expectSaturation;
+    } testCaseAry[] =
+    {
+        /* No decimation: The CIC filter of order 1 is the identity. */
+        { {1, idxChnAry1, 1, 0, NULL, 0}, inRandom, false },
+
+        /* Odd number of channels: One lane of the last vector is unused. */
+        { {3, idxChnAry3, 3, 3, NULL, 0}, inRandom, false },
+
+        /* Maximum gain 2^16 of the CIC filter: The integrators wrap around. */
+        { {8, idxChnAry8, 4, 4, NULL, 0}, inFullScale, false },
+        { {3, idxChnAry3, 2, 8, NULL, 0}, inFullScale, false },
+        { {1, idxChnAry1, 1, 8, NULL, 0}, inRandom, false },
+
+        /* FIR filter: Saturation at the upper and the lower end. */
+        { {3, idxChnAry3, 2, 8, firGain2, 2}, inFullScale, true },
+        { {8, idxChnAry8, 1, 2, firHighPass, 3}, inSteps, true },
+        { {8, idxChnAry8, 2, 5, firLowPass, 16}, inRandom, true },
+        { {1, idxChnAry1, 4, 4, firLowPass, 16}, inSteps, true },
+    };
+
+    static uint16_t inAry[noRows * noSamplesPerRow]
+                  , outAry[noRows * FLT_MAX_NO_CHNS]
+                  , refOutAry[noRows * FLT_MAX_NO_CHNS];
+
+    /* A simple, deterministic pseudo random number generator. */
+    uint32_t seed = 12345;
+    #define RAND() (seed = seed*1103515245u + 12345u, seed >> 16)
+
+    unsigned long noComparedSamples = 0;
+    unsigned int idxTest;
+    for(idxTest=0; idxTest<sizeOfAry(testCaseAry); ++idxTest)
+    {
+        const flt_filterConfig_t * const pConfig = &testCaseAry[idxTest].config;
+
+        unsigned int u;
+        for(u=0; u<sizeOfAry(inAry); ++u)
+        {
+            const unsigned int idxRow = u / noSamplesPerRow;
+            switch(testCaseAry[idxTest].input)
+            {
+            case inRandom: inAry[u] = (uint16_t)RAND(); break;
+            case inFullScale: inAry[u] = UINT16_MAX; break;
+            case inSteps: inAry[u] = (idxRow/100u) % 2u == 0? UINT16_MAX: 0; break;
+            }
+        }
+
+        /* The filter under test gets the input in blocks of random length. */
+        static flt_filter_t filter;
+        CHECK(flt_initFilter(&filter, pConfig));
+        unsigned int noOutRows = 0
+                   , idxRow = 0;
+        while(idxRow < noRows)
+        {
+            unsigned int noRowsBlock = 1u + RAND() % 97u;
+            if(noRowsBlock > noRows - idxRow)
+                noRowsBlock = noRows - idxRow;
+            noOutRows += flt_processBlock( &filter
+                                         , &outAry[noOutRows * pConfig->noChns]
+                                         , /* maxNoOutRows */ noRows - noOutRows
+                                         , &inAry[idxRow * noSamplesPerRow]
+                                         , noRowsBlock
+                                         , noSamplesPerRow
+                                         );
+            idxRow += noRowsBlock;
+        }
+
+        unsigned long noSaturations = 0;
+        const unsigned int noRefOutRows = refDecimationFilter( pConfig
+                                                             , refOutAry
+                                                             , inAry
+                                                             , noRows
+                                                             , noSamplesPerRow
+                                                             , &noSaturations
+                                                             );
+        CHECK(noOutRows == noRefOutRows  &&  noOutRows == (unsigned)noRows >> pConfig->log2Decimation);
+        CHECK(memcmp(outAry, refOutAry, noOutRows*pConfig->noChns*sizeof(outAry[0])) == 0);
+        CHECK((noSaturations > 0) == testCaseAry[idxTest].expectSaturation);
+        noComparedSamples += noOutRows*pConfig->noChns;
+    }
+    #undef RAND
+
+    /* The CIC filter can't exceed 32 Bit. And the FIR configuration needs to be coherent. */
+    static const flt_filterConfig_t badConfigAry[] =
+        { {1, idxChnAry1, 4, 5, NULL, 0}
+        , {1, idxChnAry1, 0, 2, NULL, 0}
+        , {9, idxChnAry8, 1, 2, NULL, 0}
+        , {1, idxChnAry1, 1, 2, firLowPass, 0}
+        , {1, idxChnAry1, 1, 2, NULL, 3}
+        };
+    unsigned int idxBad;
+    for(idxBad=0; idxBad<sizeOfAry(badConfigAry); ++idxBad)
+    {
+        static flt_filter_t filter;
+        CHECK(!flt_initFilter(&filter, &badConfigAry[idxBad]));
+    }
+
+    printf( "  %u configurations, %lu output samples compared with reference\n"
+          , (unsigned)sizeOfAry(testCaseAry)
+          , noComparedSamples
+          );
+} /* End of testDecimationFilter */
+
+
+
+/**
+ * Benchmark of the decimation filter flt_processBlock() on the host. In DMA mode, the
+ * last fetched sample block is the input.
+ */
+static void benchmarkFilter(void)
+{
+    static const uint8_t idxChnAry[] = {0};
+    static const flt_filterConfig_t config = { .noChns = 1
+                                             , .idxChnAry = idxChnAry
+                                             , .order = 3
+                                             , .log2Decimation = 3
+                                             , .firCoefAry = NULL
+                                             , .noFirTaps = 0
+                                             };
+    static flt_filter_t filter;
+    if(!flt_initFilter(&filter, &config))
+    {
+        CHECK(false);
+        return;
+    }
+
+    enum {noRows = 256, noSamplesPerRow = adc_linkElement1, noLoops = 2000};
+    static uint16_t inAry[noRows * noSamplesPerRow]
+                  , outAry[noRows * noSamplesPerRow];
+    unsigned int u;
+    for(u=0; u<sizeOfAry(inAry); ++u)
+        inAry[u] = (uint16_t)(u * 37u);
+#if ADC_USE_DMA == 1
+    memcpy(inAry, _sampleAry, sizeof(_sampleAry) < sizeof(inAry)? sizeof(_sampleAry): sizeof(inAry));
+#endif
+
+    struct timespec tiStart, tiEnd;
+    clock_gettime(CLOCK_MONOTONIC, &tiStart);
+    unsigned long noOut = 0;
+    for(u=0; u<noLoops; ++u)
+        noOut += flt_processBlock(&filter, outAry, noRows, inAry, noRows, noSamplesPerRow);
+    clock_gettime(CLOCK_MONOTONIC, &tiEnd);
+
+    const double tiInNs = (double)(tiEnd.tv_sec - tiStart.tv_sec) * 1e9
+                          + (double)(tiEnd.tv_nsec - tiStart.tv_nsec);
+    CHECK(noOut == (unsigned long)noLoops * noRows / 8u);
+    printf( "Benchmark flt_processBlock: %.2f ns per input row (host)\n"
+          , tiInNs / ((double)noLoops * noRows)
+          );
+} /* End of benchmarkFilter */
+
+
+
+/**
+ * Print the statistics of the simulated hardware.
+ */
+static void printStatistics(void)
+{
+    hpm_statistics_t stat;
+    hpm_getStatistics(&stat);
+    printf( "Simulated %.3f s: %lu CTU triggers, %lu overruns, %lu+%lu conversions"
+            ", %lu DMA minor loops, %lu interrupts, %lu unacknowledged"
+            ", %lu register writes, %.1f us host time per interrupt\n"
+          , (double)hpm_getTime() / HPM_TICKS_PER_SECOND
+          , stat.noCtuTriggers
+          , stat.noCtuOverruns
+          , stat.noConversionsAry[0]
+          , stat.noConversionsAry[1]
+          , stat.noDmaMinorLoops
+          , stat.noInterrupts
+          , stat.noUnacknowledgedInterrupts
+          , stat.noRegisterWrites
+          , stat.noInterrupts > 0? (double)stat.tiHostInIsrsInNs/1e3/stat.noInterrupts: 0.0
+          );
+    CHECK(stat.noCtuOverruns == 0);
+    CHECK(stat.noUnacknowledgedInterrupts == 0);
+
+} /* End of printStatistics */
+
+
+
+/**
+ * Entry point into the test application.
+ *   @return
+ * Get 0 if all tests passed, 1 otherwise.
+ */
+int main(void)
+{
+    /* The mapping of enabled channels to hardware channels. */
+    unsigned int idxChn, idxEnabledChn = 0;
+    for(idxChn=0; idxChn<32; ++idxChn)
+    {
+        static const uint32_t enabledChnMask =
+                        ADC_USE_ADC_0_CHANNEL_00 << 0  | ADC_USE_ADC_0_CHANNEL_01 << 1
+                      | ADC_USE_ADC_0_CHANNEL_02 << 2  | ADC_USE_ADC_0_CHANNEL_03 << 3
+                      | ADC_USE_ADC_0_CHANNEL_04 << 4  | ADC_USE_ADC_0_CHANNEL_05 << 5
+                      | ADC_USE_ADC_0_CHANNEL_06 << 6  | ADC_USE_ADC_0_CHANNEL_07 << 7
+                      | ADC_USE_ADC_0_CHANNEL_08 << 8  | ADC_USE_ADC_0_CHANNEL_09 << 9
+                      | ADC_USE_ADC_0_CHANNEL_10 << 10 | ADC_USE_ADC_0_CHANNEL_11 << 11
+                      | ADC_USE_ADC_0_CHANNEL_12 << 12 | ADC_USE_ADC_0_CHANNEL_13 << 13
+                      | ADC_USE_ADC_0_CHANNEL_14 << 14 | ADC_USE_ADC_0_CHANNEL_15 << 15
+                      | ADC_USE_ADC_1_CHANNEL_00 << 16 | ADC_USE_ADC_1_CHANNEL_01 << 17
+                      | ADC_USE_ADC_1_CHANNEL_02 << 18 | ADC_USE_ADC_1_CHANNEL_03 << 19
+                      | ADC_USE_ADC_1_CHANNEL_04 << 20 | ADC_USE_ADC_1_CHANNEL_05 << 21
+                      | ADC_USE_ADC_1_CHANNEL_06 << 22 | ADC_USE_ADC_1_CHANNEL_07 << 23
+                      | ADC_USE_ADC_1_CHANNEL_08 << 24 | ADC_USE_ADC_1_CHANNEL_09 << 25
+                      | ADC_USE_ADC_1_CHANNEL_10 << 26 | ADC_USE_ADC_1_CHANNEL_11 << 27
+                      | ADC_USE_ADC_1_CHANNEL_12 << 28 | ADC_USE_ADC_1_CHANNEL_13 << 29
+                      | ADC_USE_ADC_1_CHANNEL_14 << 30 | (uint32_t)ADC_USE_ADC_1_CHANNEL_15 << 31;
+        if((enabledChnMask & (1ul << idxChn)) != 0)
+        {
+            assert(idxEnabledChn < (unsigned)adc_linkElement1);
+            _hwChnAry[idxEnabledChn].idxAdc = idxChn / 16u;
+            _hwChnAry[idxEnabledChn].idxChn = idxChn % 16u;
+            ++ idxEnabledChn;
+        }
+    }
+    assert(idxEnabledChn == (unsigned)adc_linkElement1);
+
+    /* The test relies on the default configuration of channels. */
+    _Static_assert( ADC_USE_ADC_0_CHANNEL_01 == 1  &&  ADC_USE_ADC_0_CHANNEL_15 == 1
+                    &&  ADC_USE_ADC_1_CHANNEL_11 == 1  &&  ADC_USE_ADC_1_CHANNEL_15 == 1
+                  , "Test requires ADC_0, channels 1 and 15 and ADC_1, channels 11 and 15"
+                  );
+
+    /* Startup as in mai_main.c. */
+    hpm_initModel();
+    ihw_initMcuCoreHW();
+    tac_initTestAndCalibrationDataAry();
+
+    /* The input signals. */
+#if ADC_USE_DMA == 1
+    const hpm_waveform_t staircase = {.kind = hpm_wfUser, .userFct = userFctStaircase};
+    hpm_setWaveform(0, 1, &staircase);
+#else
+    const hpm_waveform_t sine = { .kind = hpm_wfSine
+                                , .offset = 1.5
+                                , .amplitude = 1.0
+                                , .frequency = 7.0
+                                , .phase = 0.0
+                                };
+    hpm_setWaveform(0, 1, &sine);
+#endif
+    setConstant(1, 11, 0.5, /* noise */ 0.0);
+    setConstant(1, 12, 1.0, /* noise */ 0.01);
+    setConstant(1, 13, 2.0, /* noise */ 0.01);
+    setConstant(1, 14, 3.0, /* noise */ 0.01);
+    hpm_setReferenceVoltage(1, 3.2);
+
+    adc_initDriver(/* priorityOfIRQ */ 15, /* cbEndOfConversion */ onEndOfConversion);
+    ihw_resumeAllInterrupts();
+    adc_startConversions();
+
+    testDataPath();
+    testCalibration();
+    testTemperature();
+    testTiming();
+    testFailedConversion();
+    testChannelGroups();
+    testSampleBlocks();
+    testDecimationFilter();
+    benchmarkFilter();
+    printStatistics();
+
+    if(_noErrors == 0)
+        printf("All tests passed\n");
+    else
+        printf("%u checks failed\n", _noErrors);
+
+    return _noErrors == 0? 0: 1;
+
+} /* End of main */
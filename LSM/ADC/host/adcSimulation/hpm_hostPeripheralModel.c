@@ -0,0 +1,1816 @@
+/**
+ * @file hpm_hostPeripheralModel.c
+ * Host model of the MPC5643L peripherals, which are used by the ADC driver
+ * adc_eTimerClockedAdc.c: eTimer_1, CTU, ADC_0, ADC_1, eDMA with DMAMUX and the INTC.\n
+ *   The model permits to compile and run the unmodified driver on a Linux/x86-64 host.
+ * The peripheral registers are mapped into the address space of the host process at
+ * their true MCU addresses, such that the register access macros of the MCU header
+ * MPC5643L.h can be used without change. (The bit fields of the header are mirrored for
+ * the little endian host, see mirrorBitFields.awk.)\n
+ *   The CPU can read the registers without any restriction. Write accesses are trapped:
+ * The register memory is mapped read-only for the CPU. A write causes a page fault, the
+ * model makes the page writable, lets the CPU execute the single write instruction and
+ * write-protects the page again. Now it knows the written register, its old and its new
+ * value and simulates the side effects of the write, e.g. write-1-to-clear or starting
+ * the timer. The model itself writes the registers through a second, writable mapping of
+ * the same memory.\n
+ *   The time is simulated. It advances only in hpm_runFor(). The model computes the
+ * next hardware event (timer output toggle, start and end of conversion, entry into an
+ * interrupt) and processes the events in order. The interrupt service routines of the
+ * driver are called synchronously at the simulated time of entry. The time base of the
+ * CPU, which the driver reads for time stamping, is the simulated time.
+ *   @remark
+ * The model covers the configuration, which is used by the ADC driver, but not the
+ * complete functionality of the devices. Unsupported configurations are reported and
+ * abort the simulation. Modelling assumptions, which are not backed by the MCU reference
+ * manual:\n
+ *   - The duration of a conversion is INPSAMP + 12*(INPCMP+3) + 2 ADC clock cycles; the
+ *     input is sampled at the end of the first phase of INPSAMP cycles\n
+ *   - The read side effects of the registers CDR (reset of VALID, setting of OVERW) are
+ *     not modelled. Each conversion yields a VALID result but for the injected failures,
+ *     see hpm_failNextConversions()\n
+ *   - The eDMA serves a request without any delay\n
+ *   - Interrupts are not nested and the execution of an interrupt service routine doesn't
+ *     consume simulated time\n
+ *   - The temperature sensor output is a linear function of the temperature in both
+ *     sensor modes, which exactly meets the calibration points in the test and calibration
+ *     data of the MCU, see rcc_readTestData()
+ *   @remark
+ * The implementation depends on Linux and on the x86-64 architecture (trap flag for
+ * single stepping). The executable needs to be linked with -no-pie; the driver stores
+ * addresses of its RAM buffers in 32 Bit DMA registers.
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   hpm_initModel
+ *   hpm_setWaveform
+ *   hpm_getSignal
+ *   hpm_setReferenceVoltage
+ *   hpm_setIrqLatency
+ *   hpm_delayNextIrq
+ *   hpm_failNextConversions
+ *   hpm_runFor
+ *   hpm_getTime
+ *   hpm_getLastSample
+ *   hpm_getStatistics
+ *   ihw_initMcuCoreHW
+ *   ihw_installINTCInterruptHandler
+ *   ihw_suspendAllInterrupts
+ *   ihw_resumeAllInterrupts
+ *   ihw_enterCriticalSection
+ *   ihw_leaveCriticalSection
+ *   rcc_readTestData
+ * Local functions
+ *   fatalError
+ *   findRegion
+ *   toAlias
+ *   getOldValue
+ *   onSegv
+ *   onTrap
+ *   mapRegions
+ *   getRandom
+ *   evalWaveform
+ *   getIrqLatency
+ *   isIrqAsserted
+ *   updateIrqs
+ *   updateMsr
+ *   convert
+ *   scheduleConversion
+ *   ctuTrigger
+ *   ctuMasterReload
+ *   eTimerStart
+ *   eTimerToggle
+ *   addModulo
+ *   dmaMinorLoop
+ *   dmaRequest
+ *   endOfConversion
+ *   onWriteAdc
+ *   onWriteCtu
+ *   onWriteETimer
+ *   onWriteEDma
+ *   onRegisterWrite
+ *   serveIrq
+ */
+
+/*
+ * Include files
+ */
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "MPC5643L.h"
+#include "typ_types.h"
+#include "ihw_initMcuCoreHW.h"
+#include "rcc_readCalibrationConstants.h"
+#include "tac_mcuTestAndCalibrationData.h"
+#include "hpm_hostPeripheralModel.h"
+
+
+/*
+ * Defines
+ */
+
+#if !defined(__x86_64__)  ||  !defined(__linux__)
+# error The trapping of register writes is implemented for Linux on x86-64 only
+#endif
+
+#ifndef MAP_FIXED_NOREPLACE
+# define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+/** The size of a mapped peripheral region. All modelled devices fit into 16k. */
+#define SIZE_OF_REGION      0x4000u
+
+/** The trap flag in the x86 flags register. */
+#define EFLAGS_TF           0x100
+
+/** The number of interrupt vectors of the INTC. */
+#define NO_INTC_VECTORS     256u
+
+/** The interrupt vectors of ADC_0 and ADC_1. */
+#define VECTOR_ADC_0        62u
+#define VECTOR_ADC_1        82u
+
+/** The interrupt vector of DMA channel 0. Channel n has vector #VECTOR_DMA_0+n. */
+#define VECTOR_DMA_0        11u
+
+/** The number of modelled DMA channels. */
+#define NO_DMA_CHNS         16u
+
+/** The DMAMUX inputs of ADC_0 and ADC_1. */
+#define DMAMUX_SOURCE_ADC_0 26u
+
+/** The maximum number of conversions, which can be queued for an ADC in one cycle. */
+#define MAX_NO_QUEUED_CONVERSIONS 32u
+
+/** The temperatures of the calibration points of TSENS, see MCU reference manual. */
+#define TSENS_T1            (150.0)
+#define TSENS_T2            (-40.0)
+
+/** Get a model accessible, writable reference to a register. */
+#define MODEL(reg)          (*(__typeof__(&(reg)))toAlias(&(reg)))
+
+
+/*
+ * Local type definitions
+ */
+
+/** The indexes of the mapped peripheral regions. */
+typedef enum idxRegion_t
+{
+    idxRegSIUL,
+    idxRegADC_0,
+    idxRegADC_1,
+    idxRegCTU,
+    idxRegETIMER_0,
+    idxRegETIMER_1,
+    idxRegEDMA,
+    idxRegDMAMUX,
+    noRegions
+
+} idxRegion_t;
+
+
+/** A mapped peripheral region. */
+typedef struct region_t
+{
+    /** The MCU address, which is the address of the read-only mapping for the CPU. */
+    uintptr_t address;
+
+    /** The writable mapping of the same memory for the model. */
+    uint8_t *pAlias;
+
+} region_t;
+
+
+/** A conversion, which has been commanded by the CTU. */
+typedef struct conversion_t
+{
+    /** The converted channel. */
+    unsigned int idxChn;
+
+    /** The times of start of conversion, end of sampling phase and end of conversion. */
+    hpm_time_t tiStart, tiSample, tiEnd;
+
+    /** The sampled input signal. */
+    double input;
+
+    /** The conversion result, 12 Bit left aligned. */
+    uint16_t result;
+
+} conversion_t;
+
+
+/** The state of an ADC. */
+typedef struct adc_t
+{
+    /** The queue of commanded conversions. */
+    conversion_t queueAry[MAX_NO_QUEUED_CONVERSIONS];
+
+    /** The index of the head of the queue and the number of queued conversions. */
+    unsigned int idxHead, noQueued;
+
+    /** The conversion at the head of the queue is running. */
+    bool isHeadStarted;
+
+    /** The input signals. */
+    hpm_waveform_t waveformAry[HPM_NO_ADC_CHNS];
+
+    /** The true reference voltage. */
+    double vRef;
+
+    /** The number of conversions, which still need to fail. */
+    unsigned int noFailingConversions;
+
+    /** The last recent conversions of all channels. */
+    hpm_sampleInfo_t sampleInfoAry[HPM_NO_ADC_CHNS];
+
+} adc_t;
+
+
+/** An interrupt source. */
+typedef struct irq_t
+{
+    /** The installed service routine or NULL. */
+    void (*isr)(void);
+
+    /** The priority of the interrupt. */
+    unsigned int priority;
+
+    /** The interrupt is asserted and waiting for service. */
+    bool isPending;
+
+    /** The time of entry into the service routine if \a isPending is set. */
+    hpm_time_t tiEntry;
+
+} irq_t;
+
+
+/*
+ * Local prototypes
+ */
+
+static void onRegisterWrite(idxRegion_t idxRegion, uintptr_t address);
+
+
+/*
+ * Data definitions
+ */
+
+/** The mapped peripheral regions. */
+static region_t _regionAry[noRegions];
+
+/** The page size of the host. */
+static uintptr_t _pageSize = 4096;
+
+/** The state of the trap of a register write, between the page fault and the single
+    step trap. */
+static struct
+{
+    /** A write is being trapped. */
+    bool isActive;
+
+    /** The region and the address of the write access. */
+    idxRegion_t idxRegion;
+    uintptr_t address;
+
+    /** The contents of the aligned double word, which contains \a address, before the
+        write. */
+    uint8_t oldAry[8];
+
+} _trap = {.isActive = false};
+
+/** The simulated time. */
+static hpm_time_t _tiNow = 0;
+
+/** The state of the eTimer channel, which triggers the CTU. */
+static struct
+{
+    /** The counter is enabled. */
+    bool isRunning;
+
+    /** The state of the output signal. */
+    bool output;
+
+    /** The prescaler as power of two. */
+    unsigned int log2Div;
+
+    /** The time of the next compare event, which toggles the output. */
+    hpm_time_t tiNextToggle;
+
+} _eTimer;
+
+/** The state of the CTU. */
+static struct
+{
+    /** A general reload has been requested but the master reload has not happened yet. */
+    bool isGrePending;
+
+    /** The index of the first command of the command list, which is triggered by trigger
+        0. */
+    unsigned int idxCmdFirst;
+
+    /** Trigger 0 has been scheduled. */
+    bool isTriggerPending;
+
+    /** The time of the scheduled trigger 0. */
+    hpm_time_t tiTrigger;
+
+} _ctu;
+
+/** The state of the ADCs. */
+static adc_t _adcAry[2];
+
+/** The interrupt sources. */
+static irq_t _irqAry[NO_INTC_VECTORS];
+
+/** The External Interrupts are enabled. */
+static bool _isExtIrqEnabled = false;
+
+/** The vector, which is currently served or #NO_INTC_VECTORS if the CPU is not in an
+    interrupt service routine. */
+static unsigned int _idxVectorInService = NO_INTC_VECTORS;
+
+/** The range of the interrupt latency. */
+static hpm_time_t _tiMinIrqLatency, _tiMaxIrqLatency;
+
+/** An additional latency, which is applied to the next interrupt only. */
+static hpm_time_t _tiExtraIrqLatency;
+
+/** The state of the pseudo random generator. */
+static uint32_t _prngState;
+
+/** The statistics. */
+static hpm_statistics_t _statistics;
+
+/** The calibration points of the temperature sensors as they are found in the test and
+    calibration data of the MCU. Order of words: TSENS_0 P2, TSENS_0 C2, TSENS_1 P2,
+    TSENS_1 C2, TSENS_0 P1, TSENS_0 C1, TSENS_1 P1, TSENS_1 C1. See
+    adc_eTimerClockedAdc.c for the interpretation. The values are arbitrary but
+    plausible. */
+static const uint16_t _tsensCalDataAry[8] =
+                                { 1475u, 1762u, 1480u, 1770u, 2225u, 1956u, 2230u, 1950u };
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Report an unrecoverable problem of the simulation and abort the process.
+ *   @param pMsg
+ * The message to print.
+ */
+static void fatalError(const char *pMsg)
+{
+    fprintf(stderr, "hpm_hostPeripheralModel: %s\n", pMsg);
+    abort();
+
+} /* End of fatalError */
+
+
+
+/**
+ * Find the mapped peripheral region, which contains an address.
+ *   @return
+ * Get the index of the region or #noRegions if the address doesn't belong to a mapped
+ * region.
+ *   @param address
+ * The address to look for.
+ */
+static idxRegion_t findRegion(uintptr_t address)
+{
+    unsigned int idxRegion;
+    for(idxRegion=0; idxRegion<noRegions; ++idxRegion)
+    {
+        const uintptr_t base = _regionAry[idxRegion].address;
+        if(address >= base  &&  address < base+SIZE_OF_REGION)
+            break;
+    }
+    return (idxRegion_t)idxRegion;
+
+} /* End of findRegion */
+
+
+
+/**
+ * Get the writable alias of the address of a register.
+ *   @return
+ * Get the address, which the model uses to write the register.
+ *   @param pReg
+ * The register by MCU address.
+ */
+static void *toAlias(const volatile void *pReg)
+{
+    const uintptr_t address = (uintptr_t)pReg;
+    const idxRegion_t idxRegion = findRegion(address);
+    if(idxRegion == noRegions)
+        fatalError("Access to a register outside the modelled devices");
+    return _regionAry[idxRegion].pAlias + (address - _regionAry[idxRegion].address);
+
+} /* End of toAlias */
+
+
+
+/**
+ * Get the value of a register before the trapped write.
+ *   @return
+ * Get the old value.
+ *   @param pReg
+ * The register by MCU address. It needs to be located in the double word, which
+ * contains the written address.
+ *   @param size
+ * The size of the register in Byte; 1, 2 or 4.
+ */
+static uint32_t getOldValue(const volatile void *pReg, size_t size)
+{
+    const uintptr_t address = (uintptr_t)pReg
+                  , idxByte = address - (_trap.address & ~(uintptr_t)7u);
+    assert(idxByte + size <= sizeof(_trap.oldAry));
+
+    uint32_t value = 0;
+    memcpy(&value, &_trap.oldAry[idxByte], size);
+    return value;
+
+} /* End of getOldValue */
+
+
+
+/**
+ * Signal handler for SIGSEGV: The CPU writes to a peripheral register. The page is made
+ * writable and the write instruction is single stepped.
+ *   @param sig
+ * The signal, SIGSEGV.
+ *   @param pInfo
+ * The signal information, which contains the faulting address.
+ *   @param pContext
+ * The CPU context of the faulting instruction.
+ */
+static void onSegv(int sig ATTRIB_UNUSED, siginfo_t *pInfo, void *pContext)
+{
+    const uintptr_t address = (uintptr_t)pInfo->si_addr;
+    const idxRegion_t idxRegion = findRegion(address);
+    if(idxRegion == noRegions  ||  _trap.isActive)
+    {
+        /* A true segmentation fault. Let the process crash at the repeated fault. */
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    const region_t * const pRegion = &_regionAry[idxRegion];
+    const uintptr_t offsDWord = (address - pRegion->address) & ~(uintptr_t)7u;
+    _trap.isActive = true;
+    _trap.idxRegion = idxRegion;
+    _trap.address = address;
+    memcpy(&_trap.oldAry[0], pRegion->pAlias + offsDWord, sizeof(_trap.oldAry));
+
+    mprotect((void*)(address & ~(_pageSize-1u)), _pageSize, PROT_READ | PROT_WRITE);
+    ((ucontext_t*)pContext)->uc_mcontext.gregs[REG_EFL] |= EFLAGS_TF;
+
+} /* End of onSegv */
+
+
+
+/**
+ * Signal handler for SIGTRAP: The write instruction has been executed. The page is
+ * write-protected again and the side effects of the write are simulated.
+ *   @param sig
+ * The signal, SIGTRAP.
+ *   @param pInfo
+ * The signal information.
+ *   @param pContext
+ * The CPU context after the write instruction.
+ */
+static void onTrap(int sig ATTRIB_UNUSED, siginfo_t *pInfo ATTRIB_UNUSED, void *pContext)
+{
+    if(!_trap.isActive)
+    {
+        /* A breakpoint or similar, which is not related to the model. */
+        signal(SIGTRAP, SIG_DFL);
+        raise(SIGTRAP);
+        return;
+    }
+
+    ((ucontext_t*)pContext)->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)EFLAGS_TF;
+    mprotect((void*)(_trap.address & ~(_pageSize-1u)), _pageSize, PROT_READ);
+
+    ++ _statistics.noRegisterWrites;
+    onRegisterWrite(_trap.idxRegion, _trap.address);
+    _trap.isActive = false;
+
+} /* End of onTrap */
+
+
+
+/**
+ * Map the memory of the modelled peripherals at their MCU addresses and install the
+ * signal handlers for trapping the write accesses.
+ */
+static void mapRegions(void)
+{
+    _regionAry[idxRegSIUL].address = (uintptr_t)&SIU;
+    _regionAry[idxRegADC_0].address = (uintptr_t)&ADC_0;
+    _regionAry[idxRegADC_1].address = (uintptr_t)&ADC_1;
+    _regionAry[idxRegCTU].address = (uintptr_t)&CTU;
+    _regionAry[idxRegETIMER_0].address = (uintptr_t)&ETIMER_0;
+    _regionAry[idxRegETIMER_1].address = (uintptr_t)&ETIMER_1;
+    _regionAry[idxRegEDMA].address = (uintptr_t)&EDMA;
+    _regionAry[idxRegDMAMUX].address = (uintptr_t)&DMAMUX;
+
+    _Static_assert( sizeof(SIUL_tag) <= SIZE_OF_REGION
+                    &&  sizeof(ADC_tag) <= SIZE_OF_REGION
+                    &&  sizeof(CTU_tag) <= SIZE_OF_REGION
+                    &&  sizeof(mcTIMER_tag) <= SIZE_OF_REGION
+                    &&  sizeof(SPP_DMA2_tag) <= SIZE_OF_REGION
+                    &&  sizeof(DMA_CH_MUX_tag) <= SIZE_OF_REGION
+                  , "Modelled device doesn't fit into mapped region"
+                  );
+
+    _pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    if(SIZE_OF_REGION % _pageSize != 0)
+        fatalError("Unsupported page size of host");
+
+    unsigned int idxRegion;
+    for(idxRegion=0; idxRegion<noRegions; ++idxRegion)
+    {
+        region_t * const pRegion = &_regionAry[idxRegion];
+        const int fd = memfd_create("hpm_peripheralRegion", /* flags */ 0);
+        if(fd < 0  ||  ftruncate(fd, SIZE_OF_REGION) != 0)
+            fatalError("Can't create memory for peripheral registers");
+
+        void * const pMcu = mmap( (void*)pRegion->address
+                                , SIZE_OF_REGION
+                                , PROT_READ
+                                , MAP_SHARED | MAP_FIXED_NOREPLACE
+                                , fd
+                                , /* offset */ 0
+                                );
+        if(pMcu != (void*)pRegion->address)
+            fatalError("Can't map peripheral registers at their MCU address");
+
+        pRegion->pAlias = mmap( NULL
+                              , SIZE_OF_REGION
+                              , PROT_READ | PROT_WRITE
+                              , MAP_SHARED
+                              , fd
+                              , /* offset */ 0
+                              );
+        if(pRegion->pAlias == MAP_FAILED)
+            fatalError("Can't map peripheral registers for the model");
+        close(fd);
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_flags = SA_SIGINFO;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_sigaction = onSegv;
+    sigaction(SIGSEGV, &sa, NULL);
+    sa.sa_sigaction = onTrap;
+    sigaction(SIGTRAP, &sa, NULL);
+
+} /* End of mapRegions */
+
+
+
+/**
+ * Pseudo random generator (xorshift32). The simulation is reproducible.
+ *   @return
+ * Get a random number in the range [0, 1).
+ */
+static double getRandom(void)
+{
+    uint32_t x = _prngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    _prngState = x;
+    return (double)x / 4294967296.0;
+
+} /* End of getRandom */
+
+
+
+/**
+ * Compute the noise-free value of a waveform.
+ *   @return
+ * Get the signal value.
+ *   @param pWaveform
+ * The waveform.
+ *   @param tiInS
+ * The time in s.
+ */
+static double evalWaveform(const hpm_waveform_t *pWaveform, double tiInS)
+{
+    const double pi = 3.14159265358979323846
+               , x = pWaveform->frequency*tiInS + pWaveform->phase/(2.0*pi)
+               , fracX = x - floor(x);
+    switch(pWaveform->kind)
+    {
+    case hpm_wfConstant:
+        return pWaveform->offset;
+    case hpm_wfSine:
+        return pWaveform->offset + pWaveform->amplitude*sin(2.0*pi*x);
+    case hpm_wfSquare:
+        return pWaveform->offset + (fracX < 0.5? pWaveform->amplitude: -pWaveform->amplitude);
+    case hpm_wfRamp:
+        return pWaveform->offset + pWaveform->amplitude*(2.0*fracX - 1.0);
+    case hpm_wfUser:
+        assert(pWaveform->userFct != NULL);
+        return pWaveform->userFct(tiInS);
+    default:
+        assert(false);
+        return 0.0;
+    }
+} /* End of evalWaveform */
+
+
+
+/**
+ * Get the latency of an interrupt, which is being asserted.
+ *   @return
+ * Get the time from assertion to the entry into the service routine.
+ */
+static hpm_time_t getIrqLatency(void)
+{
+    hpm_time_t tiLatency = _tiMinIrqLatency;
+    if(_tiMaxIrqLatency > _tiMinIrqLatency)
+    {
+        tiLatency += (hpm_time_t)(getRandom()
+                                  * (double)(_tiMaxIrqLatency - _tiMinIrqLatency + 1u)
+                                 );
+    }
+    tiLatency += _tiExtraIrqLatency;
+    _tiExtraIrqLatency = 0;
+    return tiLatency;
+
+} /* End of getIrqLatency */
+
+
+
+/**
+ * Evaluate the state of an interrupt request line.
+ *   @return
+ * Get \a true if the interrupt is asserted.
+ *   @param idxVector
+ * The interrupt vector.
+ */
+static bool isIrqAsserted(unsigned int idxVector)
+{
+    if(idxVector == VECTOR_ADC_0)
+        return (ADC_0.ISR.R & ADC_0.IMR.R) != 0;
+    else if(idxVector == VECTOR_ADC_1)
+        return (ADC_1.ISR.R & ADC_1.IMR.R) != 0;
+    else if(idxVector >= VECTOR_DMA_0  &&  idxVector < VECTOR_DMA_0+NO_DMA_CHNS)
+        return (EDMA.DMAINTL.R & (0x1u << (idxVector-VECTOR_DMA_0))) != 0;
+    else
+        return false;
+
+} /* End of isIrqAsserted */
+
+
+
+/**
+ * Update the pending state of all installed interrupts after a change of the devices.
+ * Newly asserted interrupts are scheduled for service after the interrupt latency. An
+ * interrupt, which is no longer asserted, is withdrawn.
+ */
+static void updateIrqs(void)
+{
+    unsigned int idxVector;
+    for(idxVector=0; idxVector<NO_INTC_VECTORS; ++idxVector)
+    {
+        irq_t * const pIrq = &_irqAry[idxVector];
+        if(pIrq->isr == NULL  ||  idxVector == _idxVectorInService)
+            continue;
+
+        const bool isAsserted = isIrqAsserted(idxVector);
+        if(isAsserted  &&  !pIrq->isPending)
+        {
+            pIrq->isPending = true;
+            pIrq->tiEntry = _tiNow + getIrqLatency();
+        }
+        else if(!isAsserted)
+            pIrq->isPending = false;
+    }
+} /* End of updateIrqs */
+
+
+
+/**
+ * Update the status register MSR of an ADC.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ */
+static void updateMsr(unsigned int idxAdc)
+{
+    volatile ADC_tag * const pADC = idxAdc == 0? &ADC_0: &ADC_1;
+    const adc_t * const pAdc = &_adcAry[idxAdc];
+
+    ADC_MSR_32B_tag MSR = {.R = pADC->MCR.R & 0x80000u /* Reference range bit */};
+    if(pADC->MCR.B.PWDN == 1)
+        MSR.B.ADCSTATUS = 1; /* Power down */
+    else
+    {
+        MSR.B.CTUSTART = pADC->MCR.B.CTUEN;
+        if(pAdc->isHeadStarted)
+        {
+            MSR.B.ADCSTATUS = 4; /* Sample */
+            MSR.B.CHADDR = pAdc->queueAry[pAdc->idxHead].idxChn;
+        }
+    }
+    MODEL(pADC->MSR.R) = MSR.R;
+
+} /* End of updateMsr */
+
+
+
+/**
+ * Compute the conversion result for a channel.
+ *   @return
+ * Get the result, 12 Bit left aligned.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ *   @param idxChn
+ * The channel.
+ *   @param input
+ * The sampled input signal.
+ */
+static uint16_t convert(unsigned int idxAdc, unsigned int idxChn, double input)
+{
+    volatile ADC_tag * const pADC = idxAdc == 0? &ADC_0: &ADC_1;
+    double cnt;
+    if(idxChn == 15)
+    {
+        /* The temperature sensor. The input is the temperature. The sensor output is
+           linear in the temperature and meets the calibration points of the selected
+           sensor mode. */
+        const double a = (input - TSENS_T2) / (TSENS_T1 - TSENS_T2);
+        const unsigned int sel = pADC->CTR1.B.TSENSOR_SEL
+                         , idxP2 = 2u*idxAdc + sel
+                         , idxP1 = 4u + 2u*idxAdc + sel;
+        const double P2 = _tsensCalDataAry[idxP2]
+                   , P1 = _tsensCalDataAry[idxP1];
+        cnt = P2 + a*(P1-P2);
+    }
+    else
+        cnt = input / _adcAry[idxAdc].vRef * 4096.0;
+
+    cnt = floor(cnt + 0.5);
+    if(cnt < 0.0)
+        cnt = 0.0;
+    else if(cnt > 4095.0)
+        cnt = 4095.0;
+    return (uint16_t)((unsigned int)cnt << 4);
+
+} /* End of convert */
+
+
+
+/**
+ * Append a conversion to the queue of an ADC.
+ *   @return
+ * Get the time of the end of the conversion.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ *   @param idxChn
+ * The channel to convert.
+ *   @param tiStart
+ * The time, when the ADC starts the conversion.
+ */
+static hpm_time_t scheduleConversion( unsigned int idxAdc
+                                    , unsigned int idxChn
+                                    , hpm_time_t tiStart
+                                    )
+{
+    volatile ADC_tag * const pADC = idxAdc == 0? &ADC_0: &ADC_1;
+    adc_t * const pAdc = &_adcAry[idxAdc];
+
+    if(pAdc->noQueued >= MAX_NO_QUEUED_CONVERSIONS)
+        fatalError("Too many conversions commanded in one cycle");
+
+    /* The timing. The channels 10 and 15 use CTR1. The LSB of its field INPSAMP is the
+       sensor selection of TSENS. */
+    unsigned int INPSAMP, INPCMP;
+    if(idxChn == 10  ||  idxChn == 15)
+    {
+        INPSAMP = (pADC->CTR1.B.INSAMP << 1) | pADC->CTR1.B.TSENSOR_SEL;
+        INPCMP = pADC->CTR1.B.INPCMP;
+    }
+    else
+    {
+        INPSAMP = pADC->CTR0.B.INSAMP;
+        INPCMP = pADC->CTR0.B.INPCMP;
+    }
+    const hpm_time_t ticksPerAdcClock = pADC->MCR.B.ADCLKSEL == 1? 1u: 2u;
+
+    conversion_t * const pConv = &pAdc->queueAry[(pAdc->idxHead + pAdc->noQueued)
+                                                 % MAX_NO_QUEUED_CONVERSIONS
+                                                ];
+    ++ pAdc->noQueued;
+    pConv->idxChn = idxChn;
+    pConv->tiStart = tiStart;
+    pConv->tiSample = tiStart + ticksPerAdcClock*INPSAMP;
+    pConv->tiEnd = tiStart + ticksPerAdcClock*(INPSAMP + 12u*(INPCMP+3u) + 2u);
+
+    /* The input is a function of time. We can sample it already now. */
+    const hpm_waveform_t * const pWaveform = &pAdc->waveformAry[idxChn];
+    pConv->input = evalWaveform(pWaveform, (double)pConv->tiSample/HPM_TICKS_PER_SECOND)
+                   + pWaveform->noise*(2.0*getRandom() - 1.0);
+    pConv->result = convert(idxAdc, idxChn, pConv->input);
+
+    return pConv->tiEnd;
+
+} /* End of scheduleConversion */
+
+
+
+/**
+ * Trigger 0 of the CTU: The command list is executed. The commands are translated into
+ * conversions of the ADCs. A command is issued as soon as the addressed ADCs are ready.
+ */
+static void ctuTrigger(void)
+{
+    _ctu.isTriggerPending = false;
+
+    if(_adcAry[0].noQueued > 0  ||  _adcAry[1].noQueued > 0)
+    {
+        /* The conversions of the previous cycle are still running. We report an overrun
+           error (TGS overrun, bit TGS_OSM) and skip the cycle. */
+        ++ _statistics.noCtuOverruns;
+        MODEL(CTU.CTUEFR.R) |= 0x0004u;
+        return;
+    }
+
+    unsigned int idxCmd = _ctu.idxCmdFirst;
+    if(idxCmd >= sizeOfAry(CTU.CLR)  ||  (CTU.CLR[idxCmd].R & 0x4000u) == 0)
+        fatalError("The CTU command list doesn't begin with a first command");
+
+    hpm_time_t tiReadyAry[2] = {_tiNow, _tiNow}
+             , tiCmd = _tiNow;
+    do
+    {
+        const unsigned int CLR = CTU.CLR[idxCmd].R;
+        if((CLR & 0x2000u) != 0)
+        {
+            /* Dual conversion mode: Both ADCs start at the same time. */
+            hpm_time_t tiStart = tiCmd;
+            if(tiReadyAry[0] > tiStart)
+                tiStart = tiReadyAry[0];
+            if(tiReadyAry[1] > tiStart)
+                tiStart = tiReadyAry[1];
+            tiReadyAry[0] = scheduleConversion(0, CLR & 0xfu, tiStart);
+            tiReadyAry[1] = scheduleConversion(1, (CLR >> 5) & 0xfu, tiStart);
+            tiCmd = tiStart;
+        }
+        else
+        {
+            const unsigned int idxAdc = (CLR >> 5) & 0x1u;
+            const hpm_time_t tiStart = tiReadyAry[idxAdc] > tiCmd? tiReadyAry[idxAdc]: tiCmd;
+            tiReadyAry[idxAdc] = scheduleConversion(idxAdc, CLR & 0xfu, tiStart);
+            tiCmd = tiStart;
+        }
+        ++ idxCmd;
+    }
+    while(idxCmd < sizeOfAry(CTU.CLR)  &&  (CTU.CLR[idxCmd].R & 0x4000u) == 0);
+
+} /* End of ctuTrigger */
+
+
+
+/**
+ * The CTU sees a rising edge at its input from eTimer_1, channel 2: The master reload
+ * takes over the double buffered registers and starts the trigger generation.
+ */
+static void ctuMasterReload(void)
+{
+    if(CTU.TGSISR.B.I14_RE == 0)
+        return;
+
+    ++ _statistics.noCtuTriggers;
+    if(_ctu.isGrePending)
+    {
+        _ctu.idxCmdFirst = CTU.CLCR1.B.T0INDEX;
+        _ctu.isGrePending = false;
+        MODEL(CTU.CTUCR.R) &= ~0x0002u;
+    }
+
+    if(CTU.THCR1.B.T0_E == 1  &&  CTU.THCR1.B.T0_ADCE == 1)
+    {
+        _ctu.isTriggerPending = true;
+        _ctu.tiTrigger = _tiNow + CTU.TCR[0].R;
+    }
+} /* End of ctuMasterReload */
+
+
+
+/**
+ * eTimer_1, channel 2 has been enabled. The configuration of the channel is checked
+ * against the mode of operation, which is supported by the model.
+ */
+static void eTimerStart(void)
+{
+    volatile const mcTIMER_CHANNEL_tag * const pChn = &ETIMER_1.CHANNEL[2];
+    if(pChn->CTRL1.B.CNTMODE != 1
+       ||  pChn->CTRL1.B.PRISRC < 0x18
+       ||  pChn->CTRL1.B.LENGTH != 1
+       ||  pChn->CTRL1.B.DIR != 1
+       ||  pChn->CTRL1.B.ONCE != 0
+       ||  pChn->CTRL2.B.OUTMODE != 3
+       ||  pChn->COMP1.R != 0
+      )
+    {
+        fatalError("Unsupported configuration of eTimer_1, channel 2");
+    }
+
+    _eTimer.isRunning = true;
+    _eTimer.output = false;
+    _eTimer.log2Div = pChn->CTRL1.B.PRISRC - 0x18u;
+    _eTimer.tiNextToggle = _tiNow + ((hpm_time_t)pChn->CNTR.R << _eTimer.log2Div);
+
+} /* End of eTimerStart */
+
+
+
+/**
+ * The eTimer counter reaches the compare value: The output toggles and the counter is
+ * reloaded from register LOAD.
+ */
+static void eTimerToggle(void)
+{
+    _eTimer.output = !_eTimer.output;
+    _eTimer.tiNextToggle = _tiNow + (((hpm_time_t)ETIMER_1.CHANNEL[2].LOAD.R + 1u)
+                                     << _eTimer.log2Div
+                                    );
+    if(_eTimer.output)
+        ctuMasterReload();
+
+} /* End of eTimerToggle */
+
+
+
+/**
+ * eDMA address arithmetics with modulo feature.
+ *   @return
+ * Get the new address.
+ *   @param address
+ * The current address.
+ *   @param offset
+ * The signed offset to add.
+ *   @param MOD
+ * The modulo field of the TCD. 0: Disabled, otherwise the number of address bits, which
+ * are modified.
+ */
+static uint32_t addModulo(uint32_t address, int32_t offset, unsigned int MOD)
+{
+    const uint32_t newAddress = address + (uint32_t)offset;
+    if(MOD == 0)
+        return newAddress;
+    const uint32_t mask = (1u << MOD) - 1u;
+    return (address & ~mask) | (newAddress & mask);
+
+} /* End of addModulo */
+
+
+
+/**
+ * Execute one minor loop of an eDMA channel.
+ *   @return
+ * Get the channel, which is started by channel-to-channel linking or -1 if there is
+ * none.
+ *   @param idxChn
+ * The DMA channel.
+ */
+static signed int dmaMinorLoop(unsigned int idxChn)
+{
+    volatile SPP_DMA2_CHANNEL_tag * const pTCD = &EDMA.CHANNEL[idxChn];
+    const uint32_t w4 = pTCD->TCDWORD4_.R
+                 , w8 = pTCD->TCDWORD8_.R
+                 , w20 = pTCD->TCDWORD20_.R
+                 , w28 = pTCD->TCDWORD28_.R;
+
+    const unsigned int SSIZE = (w4 >> 24) & 0x7u
+                     , DSIZE = (w4 >> 16) & 0x7u
+                     , SMOD = (w4 >> 27) & 0x1fu
+                     , DMOD = (w4 >> 19) & 0x1fu;
+    const int32_t SOFF = (int16_t)(w4 & 0xffffu)
+                , DOFF = (int16_t)(w20 & 0xffffu);
+    const uint32_t NBYTES = (w8 & 0xc0000000u) != 0? (w8 & 0x3ffu): w8;
+    if(SSIZE != DSIZE  ||  SSIZE > 2  ||  (w8 & 0xc0000000u) != 0)
+        fatalError("Unsupported eDMA transfer configuration");
+
+    /* The iteration counts have 9 or 15 Bit, depending on the minor loop link. */
+    const bool isMinorLink = (w20 & 0x80000000u) != 0;
+    const uint32_t maskIter = isMinorLink? 0x1ffu: 0x7fffu;
+    unsigned int CITER = (w20 >> 16) & maskIter;
+    const unsigned int BITER = (w28 >> 16) & ((w28 & 0x80000000u) != 0? 0x1ffu: 0x7fffu);
+
+    /* The transfers of the minor loop. */
+    const unsigned int sizeOfTransfer = 1u << SSIZE;
+    uint32_t SADDR = pTCD->TCDWORD0_.R
+           , DADDR = pTCD->TCDWORD16_.R;
+    unsigned int u;
+    for(u=0; u<NBYTES/sizeOfTransfer; ++u)
+    {
+        uint8_t *pDest = (uint8_t*)(uintptr_t)DADDR;
+        if(findRegion(DADDR) != noRegions)
+            pDest = toAlias(pDest);
+        memcpy(pDest, (const void*)(uintptr_t)SADDR, sizeOfTransfer);
+        SADDR = addModulo(SADDR, SOFF, SMOD);
+        DADDR = addModulo(DADDR, DOFF, DMOD);
+    }
+    ++ _statistics.noDmaMinorLoops;
+
+    /* The major loop. */
+    signed int idxLinkedChn = -1;
+    uint32_t newW28 = w28;
+    if(CITER <= 1)
+    {
+        SADDR += pTCD->TCDWORD12_.R /* SLAST */;
+        DADDR += pTCD->TCDWORD24_.R /* DLAST */;
+        CITER = BITER;
+        newW28 |= 0x80u; /* DONE */
+        if((w28 & 0x2u) != 0) /* INT_MAJ */
+            MODEL(EDMA.DMAINTL.R) |= 0x1u << idxChn;
+        if((w28 & 0x20u) != 0) /* MAJOR_E_LINK */
+            idxLinkedChn = (signed int)((w28 >> 8) & 0x3fu);
+        if((w28 & 0x8u) != 0) /* D_REQ */
+            MODEL(EDMA.DMAERQL.R) &= ~(0x1u << idxChn);
+    }
+    else
+    {
+        -- CITER;
+        if(isMinorLink)
+            idxLinkedChn = (signed int)((w20 >> 25) & 0x3fu);
+        if((w28 & 0x4u) != 0  &&  CITER == BITER/2u) /* INT_HALF */
+            MODEL(EDMA.DMAINTL.R) |= 0x1u << idxChn;
+    }
+
+    MODEL(pTCD->TCDWORD0_.R) = SADDR;
+    MODEL(pTCD->TCDWORD16_.R) = DADDR;
+    MODEL(pTCD->TCDWORD20_.R) = (w20 & ~(maskIter << 16)) | (CITER << 16);
+    MODEL(pTCD->TCDWORD28_.R) = newW28;
+
+    if(idxLinkedChn >= (signed int)NO_DMA_CHNS)
+        fatalError("Link to a not modelled eDMA channel");
+    return idxLinkedChn;
+
+} /* End of dmaMinorLoop */
+
+
+
+/**
+ * A peripheral raises a DMA request. It is routed by the DMAMUX to an eDMA channel and
+ * served immediately if the channel is enabled.
+ *   @param source
+ * The input of the DMAMUX.
+ */
+static void dmaRequest(unsigned int source)
+{
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<NO_DMA_CHNS; ++idxChn)
+    {
+        const unsigned int CHCONFIG = DMAMUX.CHCONFIG[idxChn].R;
+        if((CHCONFIG & 0x80u) != 0
+           &&  (CHCONFIG & 0x3fu) == source
+           &&  (EDMA.DMAERQL.R & (0x1u << idxChn)) != 0
+          )
+        {
+            signed int idxNextChn = (signed int)idxChn;
+            do
+                idxNextChn = dmaMinorLoop((unsigned int)idxNextChn);
+            while(idxNextChn >= 0);
+        }
+    }
+} /* End of dmaRequest */
+
+
+
+/**
+ * The conversion at the head of the queue of an ADC completes. The result is written
+ * into the register CDR and the completion is signalled.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ */
+static void endOfConversion(unsigned int idxAdc)
+{
+    volatile ADC_tag * const pADC = idxAdc == 0? &ADC_0: &ADC_1;
+    adc_t * const pAdc = &_adcAry[idxAdc];
+    assert(pAdc->noQueued > 0  &&  pAdc->isHeadStarted);
+
+    const conversion_t * const pConv = &pAdc->queueAry[pAdc->idxHead];
+    pAdc->idxHead = (pAdc->idxHead + 1u) % MAX_NO_QUEUED_CONVERSIONS;
+    -- pAdc->noQueued;
+    pAdc->isHeadStarted = false;
+
+    const unsigned int idxChn = pConv->idxChn;
+    ++ _statistics.noConversionsAry[idxAdc];
+
+    hpm_sampleInfo_t * const pInfo = &pAdc->sampleInfoAry[idxChn];
+    ++ pInfo->noConversions;
+    pInfo->tiSample = pConv->tiSample;
+    pInfo->tiEndOfConversion = _tiNow;
+    pInfo->input = pConv->input;
+    pInfo->result = pConv->result;
+
+    /* CDR: VALID, 0x80000, and RESULT=CTU mode, 0x20000. An injected failure is reported
+       as overwritten result, OVERW, 0x40000. */
+    uint32_t CDR = 0x000a0000u | pConv->result;
+    pInfo->isValid = true;
+    if(pAdc->noFailingConversions > 0)
+    {
+        -- pAdc->noFailingConversions;
+        CDR |= 0x00040000u;
+        pInfo->isValid = false;
+    }
+    MODEL(pADC->CDR[idxChn].R) = CDR;
+    MODEL(pADC->CEOCFR0.R) |= 0x1u << idxChn;
+
+    /* The end-of-CTU-conversion interrupt is raised for the channels, which are enabled
+       in CIMR0. */
+    if((pADC->CIMR0.R & (0x1u << idxChn)) != 0)
+        MODEL(pADC->ISR.R) |= 0x10u;
+
+    updateMsr(idxAdc);
+
+    /* DMA request. */
+    if(pADC->DMAE.B.DMAEN == 1  &&  (pADC->DMAR0.R & (0x1u << idxChn)) != 0)
+        dmaRequest(DMAMUX_SOURCE_ADC_0 + idxAdc);
+
+} /* End of endOfConversion */
+
+
+
+/**
+ * Side effects of a write to an ADC register.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ *   @param address
+ * The written address.
+ */
+static void onWriteAdc(unsigned int idxAdc, uintptr_t address)
+{
+    volatile ADC_tag * const pADC = idxAdc == 0? &ADC_0: &ADC_1;
+    if(address == (uintptr_t)&pADC->ISR.R)
+    {
+        /* Write 1 to clear. */
+        MODEL(pADC->ISR.R) = getOldValue(&pADC->ISR.R, 4) & ~pADC->ISR.R;
+    }
+    else if(address == (uintptr_t)&pADC->CEOCFR0.R)
+        MODEL(pADC->CEOCFR0.R) = getOldValue(&pADC->CEOCFR0.R, 4) & ~pADC->CEOCFR0.R;
+    else if(address >= (uintptr_t)&pADC->MCR.R  &&  address < (uintptr_t)&pADC->MCR.R + 4u)
+        updateMsr(idxAdc);
+    else if(address >= (uintptr_t)&pADC->MSR.R  &&  address < (uintptr_t)&pADC->MSR.R + 4u)
+    {
+        /* Read-only register. */
+        MODEL(pADC->MSR.R) = getOldValue(&pADC->MSR.R, 4);
+    }
+} /* End of onWriteAdc */
+
+
+
+/**
+ * Side effects of a write to a CTU register.
+ *   @param address
+ * The written address.
+ */
+static void onWriteCtu(uintptr_t address)
+{
+    if(address == (uintptr_t)&CTU.CTUIFR.R)
+        MODEL(CTU.CTUIFR.R) = (uint16_t)(getOldValue(&CTU.CTUIFR.R, 2) & ~CTU.CTUIFR.R);
+    else if(address == (uintptr_t)&CTU.CTUEFR.R)
+        MODEL(CTU.CTUEFR.R) = (uint16_t)(getOldValue(&CTU.CTUEFR.R, 2) & ~CTU.CTUEFR.R);
+    else if(address == (uintptr_t)&CTU.CTUCR.R)
+    {
+        /* The bits are commands. Only GRE is modelled; it reads back as 1 until the next
+           master reload. */
+        if((CTU.CTUCR.R & 0x0002u) != 0)
+            _ctu.isGrePending = true;
+        MODEL(CTU.CTUCR.R) = _ctu.isGrePending? 0x0002u: 0x0000u;
+    }
+} /* End of onWriteCtu */
+
+
+
+/**
+ * Side effects of a write to an eTimer_1 register.
+ *   @param address
+ * The written address.
+ */
+static void onWriteETimer(uintptr_t address)
+{
+    volatile mcTIMER_CHANNEL_tag * const pChn = &ETIMER_1.CHANNEL[2];
+    if(address == (uintptr_t)&ETIMER_1.ENBL.R)
+    {
+        const bool isEnabled = (ETIMER_1.ENBL.R & 0x4u) != 0;
+        if(isEnabled  &&  !_eTimer.isRunning)
+            eTimerStart();
+        else if(!isEnabled)
+            _eTimer.isRunning = false;
+    }
+    else if(address == (uintptr_t)&pChn->STS.R)
+        MODEL(pChn->STS.R) = (uint16_t)(getOldValue(&pChn->STS.R, 2) & ~pChn->STS.R);
+
+} /* End of onWriteETimer */
+
+
+
+/**
+ * Side effects of a write to an eDMA register.
+ *   @param address
+ * The written address.
+ */
+static void onWriteEDma(uintptr_t address)
+{
+    if(address == (uintptr_t)&EDMA.DMASERQ.R)
+    {
+        /* NOP, 0x80; SAER, 0x40: all channels; else the channel number. */
+        const unsigned int SERQ = EDMA.DMASERQ.R;
+        if((SERQ & 0x80u) == 0)
+        {
+            MODEL(EDMA.DMAERQL.R) |= (SERQ & 0x40u) != 0
+                                     ? 0xffffffffu
+                                     : 0x1u << (SERQ & 0x1fu);
+        }
+    }
+    else if(address == (uintptr_t)&EDMA.DMACERQ.R)
+    {
+        const unsigned int CERQ = EDMA.DMACERQ.R;
+        if((CERQ & 0x80u) == 0)
+        {
+            MODEL(EDMA.DMAERQL.R) &= (CERQ & 0x40u) != 0
+                                     ? 0x0u
+                                     : ~(0x1u << (CERQ & 0x1fu));
+        }
+    }
+    else if(address == (uintptr_t)&EDMA.DMACINT.R)
+    {
+        const unsigned int CINT = EDMA.DMACINT.R;
+        if((CINT & 0x80u) == 0)
+        {
+            MODEL(EDMA.DMAINTL.R) &= (CINT & 0x40u) != 0
+                                     ? 0x0u
+                                     : ~(0x1u << (CINT & 0x1fu));
+        }
+    }
+    else if(address == (uintptr_t)&EDMA.DMAINTL.R)
+        MODEL(EDMA.DMAINTL.R) = getOldValue(&EDMA.DMAINTL.R, 4) & ~EDMA.DMAINTL.R;
+
+} /* End of onWriteEDma */
+
+
+
+/**
+ * The CPU has written to a peripheral register. Simulate the side effects of the write.
+ *   @param idxRegion
+ * The peripheral region of the written register.
+ *   @param address
+ * The written address.
+ */
+static void onRegisterWrite(idxRegion_t idxRegion, uintptr_t address)
+{
+    switch(idxRegion)
+    {
+    case idxRegADC_0:
+        onWriteAdc(0, address);
+        break;
+    case idxRegADC_1:
+        onWriteAdc(1, address);
+        break;
+    case idxRegCTU:
+        onWriteCtu(address);
+        break;
+    case idxRegETIMER_1:
+        onWriteETimer(address);
+        break;
+    case idxRegEDMA:
+        onWriteEDma(address);
+        break;
+    default:
+        /* The other devices are plain memory. */
+        break;
+    }
+
+    /* A write can e.g. acknowledge or enable an interrupt. */
+    updateIrqs();
+
+} /* End of onRegisterWrite */
+
+
+
+/**
+ * Call an interrupt service routine.
+ *   @param idxVector
+ * The interrupt to serve.
+ */
+static void serveIrq(unsigned int idxVector)
+{
+    irq_t * const pIrq = &_irqAry[idxVector];
+    assert(pIrq->isPending  &&  pIrq->isr != NULL);
+    pIrq->isPending = false;
+
+    struct timespec tiStart, tiEnd;
+    clock_gettime(CLOCK_MONOTONIC, &tiStart);
+    _idxVectorInService = idxVector;
+    _isExtIrqEnabled = false;
+    pIrq->isr();
+    _isExtIrqEnabled = true;
+    _idxVectorInService = NO_INTC_VECTORS;
+    clock_gettime(CLOCK_MONOTONIC, &tiEnd);
+
+    ++ _statistics.noInterrupts;
+    _statistics.tiHostInIsrsInNs += (uint64_t)((tiEnd.tv_sec - tiStart.tv_sec) * 1000000000ll
+                                               + (tiEnd.tv_nsec - tiStart.tv_nsec)
+                                              );
+    if(isIrqAsserted(idxVector))
+        ++ _statistics.noUnacknowledgedInterrupts;
+
+} /* End of serveIrq */
+
+
+
+/**
+ * Initialize the model. The peripheral registers are mapped into the address space of
+ * the process on first call and set to their reset values. All inputs are set to their
+ * defaults: 0V at all normal channels, 1.24V at VREG_1.2V (channel 10) and 25 degree
+ * centigrade at TSENS (channel 15). The reference voltage is 3.3V and the interrupt
+ * latency is 0.5 .. 1 us.
+ *   @remark
+ * The function needs to be called before any of the other functions and before the ADC
+ * driver is initialized. The ADC driver can't be initialized a second time; the function
+ * should not be called more than once per process.
+ */
+void hpm_initModel(void)
+{
+    if(_regionAry[0].pAlias == NULL)
+        mapRegions();
+
+    unsigned int idxRegion;
+    for(idxRegion=0; idxRegion<noRegions; ++idxRegion)
+        memset(_regionAry[idxRegion].pAlias, 0, SIZE_OF_REGION);
+
+    /* Reset values. */
+    MODEL(ADC_0.MCR.R) = 0x00000001u;
+    MODEL(ADC_1.MCR.R) = 0x00000001u;
+    updateMsr(0);
+    updateMsr(1);
+    MODEL(ETIMER_0.ENBL.R) = 0x003fu;
+    MODEL(ETIMER_1.ENBL.R) = 0x003fu;
+
+    _tiNow = 0;
+    memset(&_eTimer, 0, sizeof(_eTimer));
+    memset(&_ctu, 0, sizeof(_ctu));
+    memset(&_adcAry[0], 0, sizeof(_adcAry));
+    memset(&_irqAry[0], 0, sizeof(_irqAry));
+    memset(&_statistics, 0, sizeof(_statistics));
+    _isExtIrqEnabled = false;
+    _idxVectorInService = NO_INTC_VECTORS;
+    _tiMinIrqLatency = HPM_US_TO_TICKS(1)/2u;
+    _tiMaxIrqLatency = HPM_US_TO_TICKS(1);
+    _tiExtraIrqLatency = 0;
+    _prngState = 0x2545f491u;
+
+    unsigned int idxAdc;
+    for(idxAdc=0; idxAdc<2; ++idxAdc)
+    {
+        adc_t * const pAdc = &_adcAry[idxAdc];
+        pAdc->vRef = 3.3;
+        unsigned int idxChn;
+        for(idxChn=0; idxChn<HPM_NO_ADC_CHNS; ++idxChn)
+        {
+            hpm_waveform_t * const pWaveform = &pAdc->waveformAry[idxChn];
+            pWaveform->kind = hpm_wfConstant;
+            pWaveform->offset = idxChn == 10? 1.24: idxChn == 15? 25.0: 0.0;
+        }
+    }
+} /* End of hpm_initModel */
+
+
+
+/**
+ * Apply a signal to an ADC input.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ *   @param idxChn
+ * The channel, 0 .. 15. The signal at channel 15 is the chip temperature in degree
+ * centigrade.
+ *   @param pWaveform
+ * The signal. The object is copied.
+ */
+void hpm_setWaveform( unsigned int idxAdc
+                    , unsigned int idxChn
+                    , const hpm_waveform_t *pWaveform
+                    )
+{
+    assert(idxAdc < 2  &&  idxChn < HPM_NO_ADC_CHNS);
+    assert(pWaveform->kind != hpm_wfUser  ||  pWaveform->userFct != NULL);
+    _adcAry[idxAdc].waveformAry[idxChn] = *pWaveform;
+
+} /* End of hpm_setWaveform */
+
+
+
+/**
+ * Get the value of an input signal at a given time, without noise.
+ *   @return
+ * Get the signal value in Volt or degree centigrade for channel 15.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ *   @param idxChn
+ * The channel, 0 .. 15.
+ *   @param tiSignal
+ * The time of interest.
+ */
+double hpm_getSignal(unsigned int idxAdc, unsigned int idxChn, hpm_time_t tiSignal)
+{
+    assert(idxAdc < 2  &&  idxChn < HPM_NO_ADC_CHNS);
+    return evalWaveform( &_adcAry[idxAdc].waveformAry[idxChn]
+                       , (double)tiSignal/HPM_TICKS_PER_SECOND
+                       );
+} /* End of hpm_getSignal */
+
+
+
+/**
+ * Set the true reference voltage of an ADC. It may differ from the configured, nominal
+ * value; the calibration of the driver with channel 10, VREG_1.2V, can then be tested.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ *   @param vRef
+ * The reference voltage in Volt.
+ */
+void hpm_setReferenceVoltage(unsigned int idxAdc, double vRef)
+{
+    assert(idxAdc < 2  &&  vRef > 0.0);
+    _adcAry[idxAdc].vRef = vRef;
+
+} /* End of hpm_setReferenceVoltage */
+
+
+
+/**
+ * Set the range of the interrupt latency. The latency of each interrupt is drawn from a
+ * uniform distribution in the given range.
+ *   @param tiMinInTicks
+ * The minimum latency.
+ *   @param tiMaxInTicks
+ * The maximum latency. Needs to be no less than \a tiMinInTicks.
+ */
+void hpm_setIrqLatency(hpm_time_t tiMinInTicks, hpm_time_t tiMaxInTicks)
+{
+    assert(tiMinInTicks <= tiMaxInTicks);
+    _tiMinIrqLatency = tiMinInTicks;
+    _tiMaxIrqLatency = tiMaxInTicks;
+
+} /* End of hpm_setIrqLatency */
+
+
+
+/**
+ * Delay the entry into the next asserted interrupt by an additional time span. This
+ * simulates e.g. a long critical section in the application code.
+ *   @param tiDelayInTicks
+ * The additional latency.
+ */
+void hpm_delayNextIrq(hpm_time_t tiDelayInTicks)
+{
+    _tiExtraIrqLatency = tiDelayInTicks;
+
+} /* End of hpm_delayNextIrq */
+
+
+
+/**
+ * Let the next conversions of an ADC fail. The results are reported as overwritten (bit
+ * OVERW in register CDR).
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ *   @param noConversions
+ * The number of failing conversions.
+ */
+void hpm_failNextConversions(unsigned int idxAdc, unsigned int noConversions)
+{
+    assert(idxAdc < 2);
+    _adcAry[idxAdc].noFailingConversions = noConversions;
+
+} /* End of hpm_failNextConversions */
+
+
+
+/**
+ * Advance the simulated time. All hardware events in the time span are processed in
+ * order and the interrupt service routines are called at their simulated time of entry.
+ *   @param tiInTicks
+ * The time span to simulate.
+ *   @remark
+ * The function must not be called from an interrupt service routine or a callback of the
+ * driver.
+ */
+void hpm_runFor(hpm_time_t tiInTicks)
+{
+    assert(_idxVectorInService == NO_INTC_VECTORS);
+    const hpm_time_t tiEnd = _tiNow + tiInTicks;
+
+    /* Pending interrupts, which had been asserted or enabled in the meantime. */
+    updateIrqs();
+
+    while(true)
+    {
+        /* Find the next event. On equal times, the order of the checks decides. */
+        enum {evNone, evEndOfConversion, evStartOfConversion, evCtuTrigger, evETimer, evIrq}
+            event = evNone;
+        unsigned int idxEvent = 0;
+        hpm_time_t tiEvent = tiEnd;
+
+        unsigned int idxAdc;
+        for(idxAdc=0; idxAdc<2; ++idxAdc)
+        {
+            const adc_t * const pAdc = &_adcAry[idxAdc];
+            if(pAdc->noQueued > 0)
+            {
+                const conversion_t * const pConv = &pAdc->queueAry[pAdc->idxHead];
+                if(pAdc->isHeadStarted
+                   &&  (pConv->tiEnd < tiEvent
+                        ||  (event == evNone  &&  pConv->tiEnd == tiEvent)
+                       )
+                  )
+                {
+                    event = evEndOfConversion;
+                    idxEvent = idxAdc;
+                    tiEvent = pConv->tiEnd;
+                }
+            }
+        }
+        for(idxAdc=0; idxAdc<2; ++idxAdc)
+        {
+            const adc_t * const pAdc = &_adcAry[idxAdc];
+            if(pAdc->noQueued > 0  &&  !pAdc->isHeadStarted)
+            {
+                const hpm_time_t tiStart = pAdc->queueAry[pAdc->idxHead].tiStart;
+                if(tiStart < tiEvent  ||  (event == evNone  &&  tiStart == tiEvent))
+                {
+                    event = evStartOfConversion;
+                    idxEvent = idxAdc;
+                    tiEvent = tiStart;
+                }
+            }
+        }
+        if(_ctu.isTriggerPending
+           &&  (_ctu.tiTrigger < tiEvent
+                ||  (event == evNone  &&  _ctu.tiTrigger == tiEvent)
+               )
+          )
+        {
+            event = evCtuTrigger;
+            tiEvent = _ctu.tiTrigger;
+        }
+        if(_eTimer.isRunning
+           &&  (_eTimer.tiNextToggle < tiEvent
+                ||  (event == evNone  &&  _eTimer.tiNextToggle == tiEvent)
+               )
+          )
+        {
+            event = evETimer;
+            tiEvent = _eTimer.tiNextToggle;
+        }
+        if(_isExtIrqEnabled)
+        {
+            unsigned int idxVector;
+            for(idxVector=0; idxVector<NO_INTC_VECTORS; ++idxVector)
+            {
+                const irq_t * const pIrq = &_irqAry[idxVector];
+                if(!pIrq->isPending)
+                    continue;
+
+                /* The service starts not before now, even if the interrupt had been
+                   locked for a while. */
+                const hpm_time_t tiEntry = pIrq->tiEntry > _tiNow? pIrq->tiEntry: _tiNow;
+                if(tiEntry < tiEvent
+                   ||  (tiEntry == tiEvent
+                        &&  (event == evNone
+                             ||  (event == evIrq
+                                  &&  pIrq->priority > _irqAry[idxEvent].priority
+                                 )
+                            )
+                       )
+                  )
+                {
+                    event = evIrq;
+                    idxEvent = idxVector;
+                    tiEvent = tiEntry;
+                }
+            }
+        }
+
+        if(event == evNone)
+            break;
+
+        assert(tiEvent >= _tiNow);
+        _tiNow = tiEvent;
+        switch(event)
+        {
+        case evEndOfConversion:
+            endOfConversion(idxEvent);
+            break;
+        case evStartOfConversion:
+            _adcAry[idxEvent].isHeadStarted = true;
+            updateMsr(idxEvent);
+            break;
+        case evCtuTrigger:
+            ctuTrigger();
+            break;
+        case evETimer:
+            eTimerToggle();
+            break;
+        case evIrq:
+            serveIrq(idxEvent);
+            break;
+        default:
+            assert(false);
+        }
+        updateIrqs();
+
+    } /* while(Events to process in the time span) */
+
+    _tiNow = tiEnd;
+
+} /* End of hpm_runFor */
+
+
+
+/**
+ * Get the simulated time.
+ *   @return
+ * Get the time in ticks of the peripheral clock since hpm_initModel().
+ */
+hpm_time_t hpm_getTime(void)
+{
+    return _tiNow;
+
+} /* End of hpm_getTime */
+
+
+
+/**
+ * Get the information about the last recent conversion of a channel.
+ *   @return
+ * Get a pointer to the information. It is updated with each conversion of the channel.
+ *   @param idxAdc
+ * The ADC, 0 or 1.
+ *   @param idxChn
+ * The channel, 0 .. 15.
+ */
+const hpm_sampleInfo_t *hpm_getLastSample(unsigned int idxAdc, unsigned int idxChn)
+{
+    assert(idxAdc < 2  &&  idxChn < HPM_NO_ADC_CHNS);
+    return &_adcAry[idxAdc].sampleInfoAry[idxChn];
+
+} /* End of hpm_getLastSample */
+
+
+
+/**
+ * Get the statistics about the simulated hardware.
+ *   @param pStatistics
+ * The statistics are copied into * \a pStatistics.
+ */
+void hpm_getStatistics(hpm_statistics_t *pStatistics)
+{
+    *pStatistics = _statistics;
+
+} /* End of hpm_getStatistics */
+
+
+
+/**
+ * Host replacement of the core HW initialization. Nothing to do; the External Interrupts
+ * are initially disabled as on the MCU.
+ */
+void ihw_initMcuCoreHW(void)
+{
+} /* End of ihw_initMcuCoreHW */
+
+
+
+/**
+ * Host replacement: Install an interrupt service routine in the model of the INTC.
+ *   @param interruptHandler
+ * The service routine.
+ *   @param vectorNum
+ * The interrupt vector.
+ *   @param psrPriority
+ * The priority of the interrupt, 1 .. 15. It decides only, which interrupt is served
+ * first if two are due at the same time.
+ *   @param isPreemptable
+ * Not modelled, interrupts are not nested.
+ */
+void ihw_installINTCInterruptHandler( void (*interruptHandler)(void)
+                                    , unsigned short vectorNum
+                                    , unsigned char psrPriority
+                                    , bool isPreemptable ATTRIB_UNUSED
+                                    )
+{
+    assert(vectorNum < NO_INTC_VECTORS  &&  psrPriority >= 1  &&  psrPriority <= 15);
+    irq_t * const pIrq = &_irqAry[vectorNum];
+    pIrq->isr = interruptHandler;
+    pIrq->priority = psrPriority;
+    pIrq->isPending = false;
+
+} /* End of ihw_installINTCInterruptHandler */
+
+
+
+/**
+ * Host replacement: Disable all External Interrupts.
+ */
+void ihw_suspendAllInterrupts(void)
+{
+    _isExtIrqEnabled = false;
+
+} /* End of ihw_suspendAllInterrupts */
+
+
+
+/**
+ * Host replacement: Enable all External Interrupts. Interrupts, which became due in the
+ * meantime, are served at the next call of hpm_runFor().
+ */
+void ihw_resumeAllInterrupts(void)
+{
+    _isExtIrqEnabled = true;
+
+} /* End of ihw_resumeAllInterrupts */
+
+
+
+/**
+ * Host replacement: Start a critical section.
+ *   @return
+ * Get the state of the External Interrupts as the bit EE of the machine status register.
+ */
+uint32_t ihw_enterCriticalSection(void)
+{
+    const uint32_t msr = _isExtIrqEnabled? 0x8000u: 0x0u;
+    _isExtIrqEnabled = false;
+    return msr;
+
+} /* End of ihw_enterCriticalSection */
+
+
+
+/**
+ * Host replacement: End a critical section.
+ *   @param msr
+ * The value got from ihw_enterCriticalSection().
+ */
+void ihw_leaveCriticalSection(uint32_t msr)
+{
+    _isExtIrqEnabled = (msr & 0x8000u) != 0;
+
+} /* End of ihw_leaveCriticalSection */
+
+
+
+/**
+ * Host replacement of the access to the test and calibration data page of the flash ROM.
+ * The model provides the calibration points of the temperature sensors, which it uses to
+ * simulate TSENS. All other words are zero.
+ *   @param testDataAry
+ * The data is written into this array.
+ *   @param noUInt16Words
+ * The number of words to read.
+ */
+void rcc_readTestData(uint16_t testDataAry[], unsigned int noUInt16Words)
+{
+    unsigned int u;
+    for(u=0; u<noUInt16Words; ++u)
+        testDataAry[u] = u < sizeOfAry(_tsensCalDataAry)? _tsensCalDataAry[u]: 0u;
+
+} /* End of rcc_readTestData */
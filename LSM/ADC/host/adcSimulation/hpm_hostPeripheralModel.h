@@ -0,0 +1,199 @@
+#ifndef HPM_HOSTPERIPHERALMODEL_INCLUDED
+#define HPM_HOSTPERIPHERALMODEL_INCLUDED
+/**
+ * @file hpm_hostPeripheralModel.h
+ * Definition of global interface of module hpm_hostPeripheralModel.c
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*
+ * Defines
+ */
+
+/** The clock rate of the simulated time. It is the peripheral clock of the MCU, which
+    clocks the eTimer and the CTU, and the clock of the CPU's time base. Unit is Hz. */
+#define HPM_TICKS_PER_SECOND    (120000000ull)
+
+/** Convert a time designation in Microseconds into simulated time. */
+#define HPM_US_TO_TICKS(tiInUs) ((hpm_time_t)((tiInUs) * (HPM_TICKS_PER_SECOND/1000000ull)))
+
+/** The number of channels of an ADC. */
+#define HPM_NO_ADC_CHNS         16u
+
+
+/*
+ * Global type definitions
+ */
+
+/** The simulated time in ticks of the peripheral clock, see #HPM_TICKS_PER_SECOND. */
+typedef uint64_t hpm_time_t;
+
+/** The kinds of signals, which can be applied to the ADC inputs. */
+typedef enum hpm_waveformKind_t
+{
+    hpm_wfConstant,     /// offset
+    hpm_wfSine,         /// offset + amplitude * sin(2*pi*frequency*t + phase)
+    hpm_wfSquare,       /// offset +/- amplitude, positive in the first half period
+    hpm_wfRamp,         /// Sawtooth from offset-amplitude to offset+amplitude
+    hpm_wfUser,         /// A function of time, provided by the client code
+
+} hpm_waveformKind_t;
+
+
+/** The signal at an ADC input. All voltages are in Volt, but for channel 15, which is
+    connected to the temperature sensor TSENS: Here, the signal is the chip temperature in
+    degree centigrade. */
+typedef struct hpm_waveform_t
+{
+    /** The kind of signal. */
+    hpm_waveformKind_t kind;
+
+    /** The mean value of the signal. */
+    double offset;
+
+    /** The amplitude of the signal. Not used for hpm_wfConstant. */
+    double amplitude;
+
+    /** The frequency of the signal in Hz. Not used for hpm_wfConstant. */
+    double frequency;
+
+    /** The phase of the signal in rad at time zero. Not used for hpm_wfConstant. */
+    double phase;
+
+    /** The peak value of a uniformly distributed noise, which is added to the signal. The
+        noise is generated by a deterministic pseudo random generator; the simulation is
+        reproducible. */
+    double noise;
+
+    /** The signal of kind hpm_wfUser. Gets the time in s and returns the signal value. */
+    double (*userFct)(double tiInS);
+
+} hpm_waveform_t;
+
+
+/** The information about the last recent conversion of a channel. */
+typedef struct hpm_sampleInfo_t
+{
+    /** The number of conversions of the channel so far. */
+    unsigned long noConversions;
+
+    /** The time at which the input was sampled, i.e. the end of the sampling phase. */
+    hpm_time_t tiSample;
+
+    /** The time at which the result was written into the register CDR. */
+    hpm_time_t tiEndOfConversion;
+
+    /** The input signal at \a tiSample, including noise. */
+    double input;
+
+    /** The conversion result, left aligned in 16 Bit, as found in register CDR. */
+    uint16_t result;
+
+    /** \a false if the conversion had been made to fail, see hpm_failNextConversions(). */
+    bool isValid;
+
+} hpm_sampleInfo_t;
+
+
+/** Statistics about the simulated hardware. */
+typedef struct hpm_statistics_t
+{
+    /** The number of master reloads of the CTU, i.e. the number of started conversion
+        cycles. */
+    unsigned long noCtuTriggers;
+
+    /** The number of triggers, which were ignored because the conversions of the previous
+        cycle had not completed yet. */
+    unsigned long noCtuOverruns;
+
+    /** The number of conversions done by ADC_0 and ADC_1. */
+    unsigned long noConversionsAry[2];
+
+    /** The number of DMA minor loops. */
+    unsigned long noDmaMinorLoops;
+
+    /** The number of invocations of interrupt service routines. */
+    unsigned long noInterrupts;
+
+    /** The number of interrupts, which were still asserted after return from their
+        service routine. */
+    unsigned long noUnacknowledgedInterrupts;
+
+    /** The number of trapped CPU write accesses to peripheral registers. */
+    unsigned long noRegisterWrites;
+
+    /** The host CPU time spent in interrupt service routines in ns. It includes the cost
+        of trapping the register writes. */
+    uint64_t tiHostInIsrsInNs;
+
+} hpm_statistics_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Map the peripheral registers into the address space and reset the model. */
+void hpm_initModel(void);
+
+/** Apply a signal to an ADC input. */
+void hpm_setWaveform( unsigned int idxAdc
+                    , unsigned int idxChn
+                    , const hpm_waveform_t *pWaveform
+                    );
+
+/** Get the noise-free value of an input signal at a given time. */
+double hpm_getSignal(unsigned int idxAdc, unsigned int idxChn, hpm_time_t tiSignal);
+
+/** Set the true reference voltage of an ADC. */
+void hpm_setReferenceVoltage(unsigned int idxAdc, double vRef);
+
+/** Set the range of the interrupt latency. */
+void hpm_setIrqLatency(hpm_time_t tiMinInTicks, hpm_time_t tiMaxInTicks);
+
+/** Delay the entry into the next interrupt by an additional time span. */
+void hpm_delayNextIrq(hpm_time_t tiDelayInTicks);
+
+/** Let the next conversions of an ADC fail. */
+void hpm_failNextConversions(unsigned int idxAdc, unsigned int noConversions);
+
+/** Advance the simulated time and serve all hardware events and interrupts. */
+void hpm_runFor(hpm_time_t tiInTicks);
+
+/** Get the current simulated time. */
+hpm_time_t hpm_getTime(void);
+
+/** Get the information about the last recent conversion of a channel. */
+const hpm_sampleInfo_t *hpm_getLastSample(unsigned int idxAdc, unsigned int idxChn);
+
+/** Get the statistics about the simulated hardware. */
+void hpm_getStatistics(hpm_statistics_t *pStatistics);
+
+#endif  /* HPM_HOSTPERIPHERALMODEL_INCLUDED */
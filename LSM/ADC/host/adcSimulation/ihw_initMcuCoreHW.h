@@ -0,0 +1,96 @@
+#ifndef IHW_INITMCUCOREHW_INCLUDED
+#define IHW_INITMCUCOREHW_INCLUDED
+/**
+ * @file ihw_initMcuCoreHW.h
+ * Host variant of the interface of module ihw_initMcuCoreHW.c: The ADC driver is compiled
+ * for the host against the peripheral model hpm_hostPeripheralModel.c. This header
+ * replaces the MCU core related part of the startup code. The functions are implemented
+ * by the model, which simulates interrupt handling and the time base.
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "typ_types.h"
+#include "hpm_hostPeripheralModel.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global inline functions
+ */
+
+/**
+ * Read the lower half of the time base of the CPU. In the simulation, this is the lower
+ * half of the simulated time.
+ *   @return
+ * Get the current register value. The value is incremented every 1/120MHz.
+ */
+static inline uint32_t ihw_getTBL(void)
+{
+    return (uint32_t)hpm_getTime();
+
+} /* End of ihw_getTBL */
+
+
+
+/*
+ * Global prototypes
+ */
+
+/** Init core HW of MCU so that it can be safely operated. */
+void ihw_initMcuCoreHW(void);
+
+/** Let the client code install an interrupt handler. */
+void ihw_installINTCInterruptHandler( void (*interruptHandler)(void)
+                                    , unsigned short vectorNum
+                                    , unsigned char psrPriority
+                                    , bool isPreemptable
+                                    );
+
+/** Disable all External Interrupts. */
+void ihw_suspendAllInterrupts(void);
+
+/** Enable all External Interrupts. */
+void ihw_resumeAllInterrupts(void);
+
+/** Start a critical section. */
+uint32_t ihw_enterCriticalSection(void);
+
+/** End a critical section. */
+void ihw_leaveCriticalSection(uint32_t msr);
+
+#endif  /* IHW_INITMCUCOREHW_INCLUDED */
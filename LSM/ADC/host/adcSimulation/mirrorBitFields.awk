@@ -0,0 +1,117 @@
+#
+# Generate the host variant of the MCU header file MPC5643L.h.
+#
+# The header describes each peripheral register as union of the register value R and a
+# struct B of bit fields. The bit fields are listed from the most significant to the least
+# significant bit, which is the allocation order of the GCC for the big endian PowerPC.
+# The GCC for a little endian host allocates bit fields the other way round. The script
+# reverses the order of the fields in each struct B so that the host sees all register bits
+# at the same positions in R as the MCU does.
+#   A field, which is enclosed in a group of preprocessor conditions (#ifndef, #else,
+# #endif), is moved as a whole. All other lines of the header are copied unchanged.
+#
+# Usage:
+#   awk -f mirrorBitFields.awk MPC5643L.h > hostMPC5643L/MPC5643L.h
+#
+# Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+#
+# This program is free software: you can redistribute it and/or modify it
+# under the terms of the GNU Lesser General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+# for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+# Print the collected lines of a struct unchanged and leave the collecting state.
+function flush(    i)
+{
+    for(i=1; i<=noLines; ++i)
+        print lineAry[i]
+    noLines = 0
+    isInStruct = 0
+}
+
+# Print the collected fields of a struct B in reverse order.
+function printMirrored(    i)
+{
+    for(i=noUnits; i>=1; --i)
+        printf "%s", unitAry[i]
+    noUnits = 0
+}
+
+BEGIN {
+    isInStruct = 0
+    noLines = 0
+    noMirroredStructs = 0
+}
+
+# The opening of a struct, which may be the bit field struct B.
+/^[ \t]*struct[ \t]*\{[ \t]*$/ {
+    if(isInStruct)
+        flush()
+    print
+    isInStruct = 1
+    noLines = 0
+    noUnits = 0
+    isInCondition = 0
+    next
+}
+
+# The end of the bit field struct B: The collected fields are emitted in reverse order.
+isInStruct  &&  /^[ \t]*\}[ \t]*B[ \t]*;/ {
+    if(isInCondition)
+    {
+        print "mirrorBitFields.awk: Unterminated preprocessor condition in line " NR \
+              > "/dev/stderr"
+        exit 1
+    }
+    printMirrored()
+    print
+    ++ noMirroredStructs
+    isInStruct = 0
+    noLines = 0
+    next
+}
+
+isInStruct {
+    lineAry[++noLines] = $0
+
+    if(/^[ \t]*#[ \t]*if/)
+    {
+        isInCondition = 1
+        unitAry[++noUnits] = $0 "\n"
+    }
+    else if(isInCondition)
+    {
+        unitAry[noUnits] = unitAry[noUnits] $0 "\n"
+        if(/^[ \t]*#[ \t]*endif/)
+            isInCondition = 0
+    }
+    else if(/^[ \t]*vuint(8|16|32)_t[ \t]*[A-Za-z0-9_]*[ \t]*:[ \t]*[0-9]+[ \t]*;/)
+        unitAry[++noUnits] = $0 "\n"
+    else
+    {
+        # Anything else means that this is not a bit field struct. Nested structs of the
+        # peripheral layout definitions are found here.
+        flush()
+    }
+    next
+}
+
+{ print }
+
+END {
+    if(isInStruct)
+        flush()
+    if(noMirroredStructs == 0)
+    {
+        print "mirrorBitFields.awk: No bit field struct found" > "/dev/stderr"
+        exit 1
+    }
+}
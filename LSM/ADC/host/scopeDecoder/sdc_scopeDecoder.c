@@ -0,0 +1,575 @@
+/**
+ * @file sdc_scopeDecoder.c
+ * Host tool: Decoder for the captures, which are streamed by the ADC sample through the
+ * serial interface, see scp_scopeCapture.c and sfr_scopeFrame.c.\n
+ *   The tool reads the byte stream as received from the serial port, e.g. saved by a
+ * terminal program to a file, from a file or from stdin. It ignores all text output,
+ * which is interleaved with the binary frames, reassembles the captures from their frames
+ * and prints each completed capture as a block of CSV text to stdout. The time axis is
+ * relative to the trigger event.\n
+ *   Usage:\n
+ *   scopeDecoder [inputFile]\n
+ *   scopeDecoder -t\n
+ * The second form runs a self-test: Synthetic captures are encoded, embedded into text
+ * and partly corrupted, then decoded and compared with the original data. The exit code
+ * is 0 if the test succeeds.
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   main
+ * Local functions
+ *   initCapture
+ *   addFrame
+ *   decodeStream
+ *   onCapturePrint
+ *   appendToStream
+ *   getSyntheticSample
+ *   encodeSyntheticCapture
+ *   onCaptureCheck
+ *   selfTest
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#include "sfr_scopeFrame.h"
+
+
+/*
+ * Defines
+ */
+
+/** The maximum number of rows of a capture. The frame format limits the number to 16 Bit. */
+#define MAX_NO_SAMPLES      0xffffu
+
+/** The number of synthetic captures, which are generated by the self-test. */
+#define NO_TEST_CAPTURES    5u
+
+
+/*
+ * Local type definitions
+ */
+
+/** A capture, which is reassembled from its frames. */
+typedef struct capture_t
+{
+    /** The meta data of the capture as got from its first frame. */
+    sfr_frameHeader_t header;
+
+    /** The number of rows, which have been received so far. */
+    unsigned int noRowsReceived;
+
+    /** The samples, \a header.noSamples rows of \a header.noChns samples. */
+    uint16_t sampleAry[MAX_NO_SAMPLES*SFR_MAX_NO_CHNS];
+
+    /** A flag per row, whether the row has been received. */
+    bool isRowReceivedAry[MAX_NO_SAMPLES];
+
+} capture_t;
+
+
+/** The callback, which is invoked for each completely received capture. */
+typedef void (*onCapture_t)(const capture_t *pCapture, void *pContext);
+
+
+/** The byte stream, which is built by the self-test. */
+typedef struct stream_t
+{
+    uint8_t *buf;
+    size_t noBytes, size;
+
+} stream_t;
+
+
+/** The context of the self-test's capture callback. */
+typedef struct testContext_t
+{
+    /** The number of captures, which have been received and checked so far. */
+    unsigned int noCaptures;
+
+    /** The number of captures found with wrong contents. */
+    unsigned int noErrors;
+
+} testContext_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The capture, which is currently reassembled. It is too large for the stack. */
+static capture_t _capture;
+
+/** The statistics of the reassembly. */
+static unsigned long _noFrames = 0
+                   , _noIncompleteCaptures = 0;
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Start the reassembly of a new capture.
+ *   @param pCapture
+ * The capture object.
+ *   @param pHeader
+ * The meta data of the first received frame of the capture.
+ */
+static void initCapture(capture_t * const pCapture, const sfr_frameHeader_t * const pHeader)
+{
+    pCapture->header = *pHeader;
+    pCapture->noRowsReceived = 0;
+    memset(pCapture->isRowReceivedAry, 0, sizeof(pCapture->isRowReceivedAry));
+
+} /* End of initCapture */
+
+
+
+/**
+ * Add a received frame to the reassembled capture.
+ *   @return
+ * Get \a true if the frame completes the capture.
+ *   @param pCapture
+ * The capture object.
+ *   @param pHeader
+ * The meta data of the frame.
+ *   @param sampleAry
+ * The samples of the frame.
+ */
+static bool addFrame( capture_t * const pCapture
+                    , const sfr_frameHeader_t * const pHeader
+                    , const uint16_t sampleAry[]
+                    )
+{
+    const sfr_frameHeader_t * const pCaptHeader = &pCapture->header;
+    const bool isSameCapture = pCapture->noRowsReceived > 0
+                               && pHeader->sequenceNo == pCaptHeader->sequenceNo
+                               && pHeader->noChns == pCaptHeader->noChns
+                               && pHeader->noSamples == pCaptHeader->noSamples;
+    if(!isSameCapture)
+    {
+        if(pCapture->noRowsReceived > 0)
+            ++ _noIncompleteCaptures;
+        initCapture(pCapture, pHeader);
+    }
+
+    /* A frame can be repeated by the target; the rows are counted only once. */
+    const unsigned int noChns = pHeader->noChns;
+    unsigned int idxRow;
+    for(idxRow=0; idxRow<pHeader->noRows; ++idxRow)
+    {
+        const unsigned int idxRowCapt = pHeader->idxFirstRow + idxRow;
+        if(idxRowCapt >= pHeader->noSamples)
+            break;
+
+        memcpy( &pCapture->sampleAry[idxRowCapt*noChns]
+              , &sampleAry[idxRow*noChns]
+              , noChns*sizeof(sampleAry[0])
+              );
+        if(!pCapture->isRowReceivedAry[idxRowCapt])
+        {
+            pCapture->isRowReceivedAry[idxRowCapt] = true;
+            ++ pCapture->noRowsReceived;
+        }
+    }
+
+    if(pCapture->noRowsReceived >= pHeader->noSamples)
+    {
+        /* Complete; the next frame will start a new capture. */
+        pCapture->noRowsReceived = 0;
+        return true;
+    }
+    else
+        return false;
+
+} /* End of addFrame */
+
+
+
+/**
+ * Decode a byte stream and notify all completely received captures.
+ *   @return
+ * Get the number of corrupted frames, which had been dropped.
+ *   @param pDecoder
+ * The frame decoder, which keeps the state across the calls.
+ *   @param buf
+ * The next portion of the byte stream.
+ *   @param noBytes
+ * The number of bytes in \a buf.
+ *   @param onCapture
+ * The callback, which is invoked for each completed capture.
+ *   @param pContext
+ * A pointer, which is passed to \a onCapture.
+ */
+static unsigned long decodeStream( sfr_decoder_t * const pDecoder
+                                 , const uint8_t buf[]
+                                 , size_t noBytes
+                                 , onCapture_t onCapture
+                                 , void *pContext
+                                 )
+{
+    size_t u;
+    for(u=0; u<noBytes; ++u)
+    {
+        sfr_frameHeader_t header;
+        uint16_t sampleAry[SFR_MAX_NO_ROWS*SFR_MAX_NO_CHNS];
+        if(sfr_decodeByte(pDecoder, buf[u], &header, sampleAry))
+        {
+            ++ _noFrames;
+            if(addFrame(&_capture, &header, sampleAry))
+                onCapture(&_capture, pContext);
+        }
+    }
+    return pDecoder->noBadFrames;
+
+} /* End of decodeStream */
+
+
+
+/**
+ * Print a capture as CSV.
+ *   @param pCapture
+ * The capture.
+ *   @param pContext
+ * The output stream.
+ */
+static void onCapturePrint(const capture_t *pCapture, void *pContext)
+{
+    FILE * const pOut = (FILE*)pContext;
+    const sfr_frameHeader_t * const pHeader = &pCapture->header;
+    fprintf( pOut
+           , "# Capture %u: %u samples, trigger at sample %u on channel %u, cycle time %lu us,"
+             " %u stale samples\n"
+           , (unsigned)pHeader->sequenceNo
+           , (unsigned)pHeader->noSamples
+           , (unsigned)pHeader->idxTrigger
+           , (unsigned)pHeader->idxChnAry[pHeader->idxTriggerChn]
+           , (unsigned long)pHeader->tiCycleInUs
+           , (unsigned)pHeader->noStaleSamples
+           );
+    fprintf(pOut, "t/s");
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<pHeader->noChns; ++idxChn)
+        fprintf(pOut, ",chn%u", (unsigned)pHeader->idxChnAry[idxChn]);
+    fprintf(pOut, "\n");
+
+    unsigned int idxRow;
+    for(idxRow=0; idxRow<pHeader->noSamples; ++idxRow)
+    {
+        const double t = ((double)idxRow - pHeader->idxTrigger) * pHeader->tiCycleInUs * 1e-6;
+        fprintf(pOut, "%.6f", t);
+        for(idxChn=0; idxChn<pHeader->noChns; ++idxChn)
+            fprintf(pOut, ",%u", (unsigned)pCapture->sampleAry[idxRow*pHeader->noChns+idxChn]);
+        fprintf(pOut, "\n");
+    }
+    fprintf(pOut, "\n");
+
+} /* End of onCapturePrint */
+
+
+
+/**
+ * Self-test: Append some bytes to the synthetic stream.
+ *   @param pStream
+ * The stream.
+ *   @param data
+ * The bytes to append.
+ *   @param noBytes
+ * The number of bytes.
+ */
+static void appendToStream(stream_t * const pStream, const void *data, size_t noBytes)
+{
+    if(pStream->noBytes + noBytes > pStream->size)
+    {
+        pStream->size = 2*(pStream->noBytes + noBytes);
+        pStream->buf = realloc(pStream->buf, pStream->size);
+        if(pStream->buf == NULL)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    memcpy(&pStream->buf[pStream->noBytes], data, noBytes);
+    pStream->noBytes += noBytes;
+
+} /* End of appendToStream */
+
+
+
+/**
+ * Self-test: Get the synthetic sample of a channel. Each channel is a sine wave of its own
+ * frequency and phase, which is modulated by the sequence number.
+ *   @return
+ * Get the sample value.
+ *   @param seqNo
+ * The sequence number of the capture.
+ *   @param idxRow
+ * The row in the capture.
+ *   @param idxChn
+ * The channel.
+ */
+static uint16_t getSyntheticSample(unsigned int seqNo, unsigned int idxRow, unsigned int idxChn)
+{
+    const double x = 0.5 + 0.45*sin(0.05*(idxChn+1)*idxRow + 0.3*seqNo + idxChn);
+    return (uint16_t)(x * 0xfff0u);
+
+} /* End of getSyntheticSample */
+
+
+
+/**
+ * Self-test: Encode a synthetic capture as frames the same way as the target does,
+ * interleaved with text and with some disturbed frames.
+ *   @param pStream
+ * The frames are appended to this stream.
+ *   @param seqNo
+ * The sequence number of the capture. It determines the size of the capture and the
+ * kind of disturbances.
+ */
+static void encodeSyntheticCapture(stream_t * const pStream, unsigned int seqNo)
+{
+    sfr_frameHeader_t header =
+        { .sequenceNo = (uint16_t)seqNo
+        , .noChns = 1u + seqNo % SFR_MAX_NO_CHNS
+        , .idxTriggerChn = 0
+        , .noSamples = (uint16_t)(50u + 37u*seqNo)
+        , .idxTrigger = (uint16_t)(10u + seqNo)
+        , .tiCycleInUs = 1000u
+        , .noStaleSamples = (uint16_t)(seqNo & 1u)
+        };
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<header.noChns; ++idxChn)
+        header.idxChnAry[idxChn] = (uint8_t)(3u*idxChn + 1u);
+
+    unsigned int idxFrame = 0
+               , idxRow = 0;
+    while(idxRow < header.noSamples)
+    {
+        header.idxFirstRow = (uint16_t)idxRow;
+        header.noRows = header.noSamples - idxRow;
+        if(header.noRows > SFR_MAX_NO_ROWS)
+            header.noRows = SFR_MAX_NO_ROWS;
+
+        uint16_t sampleAry[SFR_MAX_NO_ROWS*SFR_MAX_NO_CHNS];
+        unsigned int u;
+        for(u=0; u<header.noRows; ++u)
+        {
+            for(idxChn=0; idxChn<header.noChns; ++idxChn)
+            {
+                sampleAry[u*header.noChns+idxChn] =
+                                        getSyntheticSample(seqNo, idxRow+u, idxChn);
+            }
+        }
+
+        uint8_t frameBuf[SFR_MAX_SIZE_OF_FRAME];
+        const unsigned int sizeOfFrame = sfr_encodeFrame(frameBuf, &header, sampleAry);
+
+        /* Disturbances as seen in practice: The target truncates a frame if the serial
+           output buffer is full and repeats it later. Text output appears between the
+           frames. Transmission errors corrupt a byte. */
+        switch((seqNo + idxFrame) % 5u)
+        {
+        case 1:
+            appendToStream(pStream, frameBuf, sizeOfFrame/2u);
+            break;
+        case 2:
+        {
+            static const char text[] = "CPU load is 0.123\r\n";
+            appendToStream(pStream, text, sizeof(text)-1u);
+            break;
+        }
+        case 3:
+        {
+            /* A corrupted copy, which needs to be dropped by CRC check. */
+            uint8_t badFrame[SFR_MAX_SIZE_OF_FRAME];
+            memcpy(badFrame, frameBuf, sizeOfFrame);
+            badFrame[sizeOfFrame-5u] ^= 0x10u;
+            appendToStream(pStream, badFrame, sizeOfFrame);
+            break;
+        }
+        default:;
+        }
+        appendToStream(pStream, frameBuf, sizeOfFrame);
+
+        idxRow += header.noRows;
+        ++ idxFrame;
+    }
+} /* End of encodeSyntheticCapture */
+
+
+
+/**
+ * Self-test: Compare a received capture with the synthetic original.
+ *   @param pCapture
+ * The capture.
+ *   @param pContext
+ * The test context.
+ */
+static void onCaptureCheck(const capture_t *pCapture, void *pContext)
+{
+    testContext_t * const pTestContext = (testContext_t*)pContext;
+    const sfr_frameHeader_t * const pHeader = &pCapture->header;
+    const unsigned int seqNo = pTestContext->noCaptures++;
+
+    bool isOk = pHeader->sequenceNo == seqNo
+                && pHeader->noChns == 1u + seqNo % SFR_MAX_NO_CHNS
+                && pHeader->noSamples == 50u + 37u*seqNo
+                && pHeader->idxTrigger == 10u + seqNo
+                && pHeader->tiCycleInUs == 1000u
+                && pHeader->noStaleSamples == (seqNo & 1u);
+    unsigned int idxRow, idxChn;
+    for(idxRow=0; isOk && idxRow<pHeader->noSamples; ++idxRow)
+    {
+        for(idxChn=0; idxChn<pHeader->noChns; ++idxChn)
+        {
+            if(pCapture->sampleAry[idxRow*pHeader->noChns+idxChn]
+               != getSyntheticSample(seqNo, idxRow, idxChn)
+              )
+            {
+                isOk = false;
+            }
+        }
+    }
+
+    printf("Capture %u: %s\n", seqNo, isOk? "ok": "ERROR");
+    if(!isOk)
+        ++ pTestContext->noErrors;
+
+} /* End of onCaptureCheck */
+
+
+
+/**
+ * Self-test: Encode synthetic captures, disturb the stream, decode it and check the
+ * result.
+ *   @return
+ * Get \a true if the test succeeded.
+ */
+static bool selfTest(void)
+{
+    stream_t stream = {.buf = NULL, .noBytes = 0, .size = 0};
+    static const char text[] = "Some text output prior to the first frame\r\n";
+    appendToStream(&stream, text, sizeof(text)-1u);
+
+    unsigned int seqNo;
+    for(seqNo=0; seqNo<NO_TEST_CAPTURES; ++seqNo)
+        encodeSyntheticCapture(&stream, seqNo);
+
+    /* The stream is decoded in portions of varying size as it'd be read from the port. */
+    sfr_decoder_t decoder;
+    sfr_initDecoder(&decoder);
+    testContext_t context = {.noCaptures = 0, .noErrors = 0};
+    size_t idxByte = 0
+         , sizeOfChunk = 1;
+    unsigned long noBadFrames = 0;
+    while(idxByte < stream.noBytes)
+    {
+        if(idxByte + sizeOfChunk > stream.noBytes)
+            sizeOfChunk = stream.noBytes - idxByte;
+        noBadFrames = decodeStream( &decoder
+                                  , &stream.buf[idxByte]
+                                  , sizeOfChunk
+                                  , onCaptureCheck
+                                  , &context
+                                  );
+        idxByte += sizeOfChunk;
+        sizeOfChunk = sizeOfChunk % 97u + 13u;
+    }
+    free(stream.buf);
+
+    const bool isOk = context.noErrors == 0
+                      &&  context.noCaptures == NO_TEST_CAPTURES
+                      &&  _noIncompleteCaptures == 0;
+    printf( "Self-test %s: %u captures, %u errors, %lu frames, %lu dropped frames,"
+            " %lu incomplete captures\n"
+          , isOk? "passed": "FAILED"
+          , context.noCaptures
+          , context.noErrors
+          , _noFrames
+          , noBadFrames
+          , _noIncompleteCaptures
+          );
+    return isOk;
+
+} /* End of selfTest */
+
+
+
+/**
+ * Entry point of the tool.
+ *   @return
+ * Get the exit code, 0 on success.
+ *   @param argc
+ * The number of command line arguments.
+ *   @param argv
+ * The command line arguments.
+ */
+int main(int argc, char *argv[])
+{
+    if(argc > 2  ||  (argc == 2 && strcmp(argv[1], "-h") == 0))
+    {
+        fprintf(stderr, "usage: %s [inputFile | -t]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    else if(argc == 2  &&  strcmp(argv[1], "-t") == 0)
+        return selfTest()? EXIT_SUCCESS: EXIT_FAILURE;
+
+    FILE *pIn = stdin;
+    if(argc == 2)
+    {
+        pIn = fopen(argv[1], "rb");
+        if(pIn == NULL)
+        {
+            fprintf(stderr, "Can't open input file %s\n", argv[1]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    sfr_decoder_t decoder;
+    sfr_initDecoder(&decoder);
+    unsigned long noBadFrames = 0;
+    uint8_t buf[1024];
+    size_t noBytes;
+    while((noBytes = fread(buf, 1, sizeof(buf), pIn)) > 0)
+        noBadFrames = decodeStream(&decoder, buf, noBytes, onCapturePrint, stdout);
+    if(pIn != stdin)
+        fclose(pIn);
+
+    fprintf( stderr
+           , "%lu frames decoded, %lu dropped frames, %lu incomplete captures\n"
+           , _noFrames
+           , noBadFrames
+           , _noIncompleteCaptures
+           );
+    return EXIT_SUCCESS;
+
+} /* End of main */
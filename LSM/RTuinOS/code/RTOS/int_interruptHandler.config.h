@@ -47,6 +47,18 @@
     configurations, with or without stack sharing support. */
 #define INT_USE_SHARED_STACKS   0
 
+/** The registers of the SPE, i.e. the upper halves of the 64 Bit GPRs, the accumulator and
+    the status and control register SPEFSCR, can be supported for contexts, which make use
+    of the SIMD instructions. The context switch itself remains unchanged for all contexts;
+    it just disables the SPE for the resumed context. The SPE registers are saved and
+    restored only on demand, in the SPE unavailable exception (IVOR #32), when a context,
+    which has a save area for the SPE registers, uses a SIMD instruction the first time
+    after it has been resumed.
+      Note, RTuinOS doesn't make use of the SPE, lazy saving of the SPE registers is turned
+    off. If it is turned on then tasks must not set bit MSR[SPE] themselves, see test case
+    tc12, which only does so without lazy saving. */
+#define INT_USE_LAZY_SPE_SAVE   0
+
     
 /*
  * Global type definitions
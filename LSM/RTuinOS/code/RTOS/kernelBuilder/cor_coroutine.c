@@ -0,0 +1,329 @@
+/**
+ * @file cor_coroutine.c
+ * Stackful coroutines for cooperative multitasking inside one execution context. The
+ * coroutines of a set are run by one and the same context, e.g. a task of an RTOS built
+ * with kernelBuilder. They hand over control to one another by explicit function calls
+ * only, cor_resume(), cor_yield() and cor_awaitEvent(). Each coroutine has its own stack,
+ * which makes it possible to suspend it from inside of arbitrarily nested sub-functions.
+ * A typical use case is the implementation of a protocol state machine per connection as
+ * straight sequential code, without the cost of an OS task per connection.\n
+ *   Other than the context switches of kernelBuilder, a switch between coroutines doesn't
+ * require a system call. The switch is a normal function call, which saves and restores
+ * the non-volatile registers only, see cor_swapContext.S. All functions can be used in
+ * user mode. Interrupts are not affected; an External Interrupt preempts the coroutine,
+ * which is currently running, and it uses its stack. Similarly, a context switch of the
+ * kernel preempts the running coroutine together with the context, which runs the set of
+ * coroutines.\n
+ *   Note, there's no global data in this module. A coroutine is entirely described by its
+ * object of type \a cor_coroutine_t. Different tasks may safely run their own, disjoint
+ * sets of coroutines at the same time.\n
+ *   Note, the upper halves of the 64 Bit GPRs, which are used by the SIMD instructions of
+ * the SPE, are not saved by a coroutine switch. Coroutines must not rely on the contents of
+ * these registers across a call of cor_resume(), cor_yield() or cor_awaitEvent().
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   cor_createCoroutine
+ *   cor_resume
+ *   cor_yield
+ *   cor_awaitEvent
+ *   cor_runFibers
+ * Local functions
+ *   coroutineMain
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "int_defStackFrame.h"
+#include "cor_swapContext.h"
+#include "cor_coroutine.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * The common entry function of all coroutines. It is entered on the very first resume of a
+ * coroutine. It calls the coroutine function and returns to the resuming context, when the
+ * coroutine function returns.
+ *   @param pCo
+ * The coroutine object by reference. The value is passed in by cor_resume() in the
+ * register, which holds the return value of cor_swapContext().
+ *   @remark
+ * Note, the function has no calling parent function; it is entered by the return from
+ * cor_swapContext(). Any attempt to return from this function will surely lead to a crash.
+ */
+static _Noreturn void coroutineMain(uint32_t pCo)
+{
+    cor_coroutine_t * const pThis = (cor_coroutine_t*)pCo;
+    const uint32_t retVal = pThis->fct(pThis->argOnStart);
+    pThis->state = cor_stCo_terminated;
+
+    /* The terminated coroutine is left for ever. Its stack contents are abandoned and the
+       stack pointer save location is overwritten with a value, which is never used. */
+    cor_swapContext(&pThis->sp, pThis->spResumer, retVal);
+
+    /* A terminated coroutine is never resumed again. */
+    assert(false);
+    while(true)
+        ;
+
+} /* End of coroutineMain */
+
+
+
+
+/**
+ * Initialize a coroutine object such that it can be started by cor_resume(). The function
+ * can be used for re-initialization of a terminated coroutine, too.
+ *   @param pCo
+ * The caller provides the location of the coroutine object.
+ *   @param fctCoroutine
+ * The coroutine function. It is entered on the very first call of cor_resume().
+ *   @param pStackArea
+ * The caller provides the memory for the stack of the coroutine. The stack is owned by the
+ * coroutine until it has terminated or until the coroutine object is abandoned.\n
+ *   The stack area needs to be 8 Byte aligned; this is double-checked by assertion.
+ *   @param sizeOfStackArea
+ * The size of the memory \a pStackArea in Byte. The size needs to consider the stack
+ * consumption of the coroutine function and of the External Interrupts, which may preempt
+ * the coroutine, see ccx_createContextSaveDesc() for details. The size needs to be at
+ * least #COR_MIN_STACK_SIZE; this is double-checked by assertion.
+ */
+void cor_createCoroutine( cor_coroutine_t *pCo
+                        , cor_fctCoroutine_t fctCoroutine
+                        , void *pStackArea
+                        , unsigned int sizeOfStackArea
+                        )
+{
+    /* The alignment matters. EABI requires 8 Byte alignment. */
+    assert(pCo != NULL  &&  fctCoroutine != NULL
+           &&  pStackArea != NULL  &&  ((uint32_t)pStackArea & 0x7) == 0
+           &&  sizeOfStackArea >= COR_MIN_STACK_SIZE
+          );
+
+    pCo->fct = fctCoroutine;
+    pCo->argOnStart = 0;
+    pCo->state = cor_stCo_created;
+    pCo->postedEventVec = 0;
+    pCo->awaitedEventMask = 0;
+    pCo->spResumer = NULL;
+
+#define IDX(OFFSET)                                                                         \
+    ({ _Static_assert(((OFFSET) & 0x3) == 0, "Bad stack word offset");                  \
+       (OFFSET)/sizeof(uint32_t);                                                       \
+    })
+
+    /* Our stacks grow downwards. The initial stack pointer value is the end of the
+       provided area, rounded down to the next 8 Byte boundary. */
+    uint32_t *sp = (uint32_t*)(((uint32_t)pStackArea + sizeOfStackArea) & ~0x7u);
+
+    /* The stack frame of the hypothetic parent function of the coroutine entry function.
+       The first word is the stack pointer of its parent, which we don't have; we write a
+       null pointer to terminate the chain of stack frames for a debugger. The second word
+       is reserved for the storage of the LR by the children of this function. */
+    sp -= 2;
+    sp[0] = 0;
+    sp[1] = 0;
+
+    /* Now we see the stack pointer value as it is on entry into the coroutine entry
+       function. */
+    uint32_t * const spOnEntryIntoCoroutineMain = sp;
+
+    /* The stack frame of cor_swapContext is prepared such that a return from that function
+       is a branch into the common coroutine entry function. cor_swapContext takes the
+       return address from the word above its stack frame, like any EABI function. */
+    _Static_assert((S_COR_StFr & 0x7) == 0, "Bad stack frame size");
+    sp -= IDX(S_COR_StFr);
+    *sp = (uint32_t)spOnEntryIntoCoroutineMain;
+    sp[IDX(4+S_COR_StFr)] = (uint32_t)&coroutineMain;
+
+    /* We initialize the non volatile registers to zero. This is not necessary but
+       provides a reproducible state of the CPU on entry into the coroutine. */
+    sp[IDX(O_COR_CR)] = 0;
+    unsigned int idxReg;
+    for(idxReg=0; idxReg<18; ++idxReg)
+        sp[IDX(O_COR_R14) + idxReg] = 0;
+
+#undef IDX
+
+    pCo->sp = (void*)sp;
+
+} /* End of cor_createCoroutine */
+
+
+
+
+/**
+ * Start or continue a coroutine. The calling context is suspended and the coroutine is run
+ * until it calls cor_yield(), cor_awaitEvent() or until it terminates.\n
+ *   The function can be called from any context, including other coroutines. Coroutines
+ * can be nested this way but a coroutine must not resume itself or another coroutine,
+ * which is currently running.
+ *   @return
+ * Get the \a value of the call of cor_yield(), which suspended the coroutine, or the return
+ * value of the coroutine function if the coroutine has terminated. If the coroutine was
+ * suspended in cor_awaitEvent() then the value is zero.
+ *   @param pCo
+ * The coroutine by reference. It must have been created with cor_createCoroutine() and it
+ * must not have terminated yet, which is double-checked by assertion.
+ *   @param arg
+ * If the coroutine is started, i.e. on the very first call of this function after
+ * cor_createCoroutine(), then \a arg is passed to the coroutine function. Otherwise, it
+ * becomes the return value of the call of cor_yield(), which had suspended the coroutine.
+ * The argument is ignored if the coroutine is suspended in cor_awaitEvent().
+ */
+uint32_t cor_resume(cor_coroutine_t *pCo, uint32_t arg)
+{
+    assert(pCo->state == cor_stCo_created  ||  pCo->state == cor_stCo_suspended);
+
+    /* The coroutine entry function receives its argument by reference to the coroutine
+       object. */
+    if(pCo->state == cor_stCo_created)
+    {
+        pCo->argOnStart = arg;
+        arg = (uint32_t)pCo;
+    }
+
+    pCo->state = cor_stCo_running;
+    return cor_swapContext(&pCo->spResumer, pCo->sp, arg);
+
+} /* End of cor_resume */
+
+
+
+
+/**
+ * Suspend the calling coroutine and return to the context, which has resumed it.
+ *   @return
+ * Get the argument \a arg of the call of cor_resume(), which continues the coroutine.
+ *   @param pCo
+ * The calling coroutine by reference. It is double-checked by assertion that it is
+ * currently running.
+ *   @param value
+ * The value is returned by the call of cor_resume(), which had resumed the calling
+ * coroutine.
+ */
+uint32_t cor_yield(cor_coroutine_t *pCo, uint32_t value)
+{
+    assert(pCo->state == cor_stCo_running);
+
+    pCo->state = cor_stCo_suspended;
+    return cor_swapContext(&pCo->sp, pCo->spResumer, value);
+
+} /* End of cor_yield */
+
+
+
+
+/**
+ * Suspend the calling coroutine until one out of a set of events has been posted to it by
+ * cor_postEvent(). The function returns immediately if one of the events had already been
+ * posted before.\n
+ *   While waiting, the coroutine yields with value zero to its resuming context. It is not
+ * ready, see cor_isReady(), and cor_runFibers() will not resume it. If another context
+ * resumes the coroutine while none of the events has been posted then it yields again.
+ *   @return
+ * Get the set of awaited events, which have been posted. The returned events are consumed;
+ * they are reset in the set of posted events. Events, which are posted but not awaited,
+ * are not affected.
+ *   @param pCo
+ * The calling coroutine by reference.
+ *   @param eventMask
+ * The set of awaited events. Each bit is one event. The mask must not be zero, which is
+ * double-checked by assertion.
+ */
+uint32_t cor_awaitEvent(cor_coroutine_t *pCo, uint32_t eventMask)
+{
+    assert(eventMask != 0);
+
+    pCo->awaitedEventMask = eventMask;
+    while((pCo->postedEventVec & eventMask) == 0)
+        cor_yield(pCo, /* value */ 0);
+
+    const uint32_t eventVec = pCo->postedEventVec & eventMask;
+    pCo->postedEventVec &= ~eventVec;
+    pCo->awaitedEventMask = 0;
+
+    return eventVec;
+
+} /* End of cor_awaitEvent */
+
+
+
+
+/**
+ * A simple round-robin scheduler for a set of coroutines, which are used as fibers: All
+ * coroutines of the set, which are ready, see cor_isReady(), are resumed once in the order
+ * of the array. The resume argument is zero and the value yielded by the coroutines is
+ * ignored.\n
+ *   The function is intended to be called cyclically from a task, e.g. in the infinite
+ * loop of the task function, after it has waited for the next regular activation or for
+ * new input. The task will post events to the fibers before.
+ *   @return
+ * Get the number of coroutines, which have been resumed. Zero means that all coroutines
+ * are idle or have terminated.
+ *   @param pCoAry
+ * The set of coroutines by reference to an array of pointers to the coroutine objects.
+ *   @param noCoroutines
+ * The number of entries in \a pCoAry.
+ */
+unsigned int cor_runFibers(cor_coroutine_t * const pCoAry[], unsigned int noCoroutines)
+{
+    unsigned int noResumed = 0
+               , idxCo;
+    for(idxCo=0; idxCo<noCoroutines; ++idxCo)
+    {
+        cor_coroutine_t * const pCo = pCoAry[idxCo];
+        if(cor_isReady(pCo))
+        {
+            cor_resume(pCo, /* arg */ 0);
+            ++ noResumed;
+        }
+    }
+
+    return noResumed;
+
+} /* End of cor_runFibers */
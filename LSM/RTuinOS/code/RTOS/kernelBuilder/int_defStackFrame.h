@@ -128,6 +128,22 @@
 #define S_SSC_StFr 16       /* No content bytes rounded to next multiple of eight */
 
 
+/* Define the offsets of words saved in the stack frame. After creation of the stack frame,
+   the words are addressed by O_SPE_xxx(sp).
+     Here for the stack frame of the IVOR #32 SPE unavailable exception handler. It holds
+   the lower halves of all GPRs (but the stack pointer), which are overwritten when loading
+   the 64 Bit registers of another context. */
+#define O_SPE_CR   8        /* saved on handler entry */
+#define O_SPE_R00 12        /* saved only if the SPE registers are exchanged */
+#define O_SPE_R02 16        /* r2: Constant lower half but the upper half is exchanged */
+#define O_SPE_R03 20        /* saved on handler entry */
+#define O_SPE_R04 24        /* saved on handler entry */
+#define O_SPE_R05 28        /* r5-r31: 27*4 Byte, saved only if the SPE registers are
+                               exchanged */
+
+#define S_SPE_StFr 136      /* No content bytes rounded to next multiple of eight */
+
+
 /* Define the offsets of words saved in the stack frame. After creation of the stack frame,
    the words are addressed by O_yyy_xxx(sp).
      Here for the assembler written context start function ccx_startContext. */
@@ -135,6 +151,17 @@
 #define S_StCtxt_StFr  16       /* No content bytes rounded to next multiple of eight */
 
 
+/* Define the offsets of words saved in the stack frame. After creation of the stack frame,
+   the words are addressed by O_COR_xxx(sp).
+     Here for the assembler written coroutine switch function cor_swapContext. It holds
+   the non-volatile registers of the left coroutine. The LR is saved in the stack frame of
+   the calling function, as for any EABI function. */
+#define O_COR_CR    8       /* cr2-cr4 are non-volatile */
+#define O_COR_R14  12       /* r14-r31: 18*4 Byte */
+
+#define S_COR_StFr 88       /* No content bytes rounded to next multiple of eight */
+
+
 /*
  * Global type definitions
  */
@@ -27,6 +27,7 @@
  */
 /* Module interface
  *   rtos_initializeTask
+ *   rtos_setTaskSpeContextSaveArea
  *   rtos_initRTOS
  *   setupAfterKernelInit (default implementation of callback)
  *   rtos_enableIRQUser00 (callback without default implementation)
@@ -37,19 +38,46 @@
  *   isrUser00
  *   isrUser01
  *   rtos_sc_waitForEvent (system call, invoked through macro #rtos_waitForEvent)
+ *   rtos_sc_sendToQueue (system call, invoked through macro #rtos_sendToQueue)
+ *   rtos_sc_receiveFromQueue (system call, invoked through macro #rtos_receiveFromQueue)
+ *   rtos_osSendToQueueFromIsr
+ *   rtos_osReceiveFromQueueFromIsr
  *   rtos_getTaskOverrunCounter
  *   rtos_getStackReserve
+ *   rtos_getTaskCpuTime
  * Local functions
  *   isrSystemTimerTick
+ *   restartSystemTimer
+ *   advanceSystemTime
+ *   startTicklessPeriod
+ *   endTicklessPeriod
  *   enableIRQTimerTick
  *   prepareTaskStack
+ *   startTimer
+ *   stopTimer
+ *   addDueTask
+ *   getHighestPrioDueTask
+ *   registerWaiter
+ *   unregisterWaiter
+ *   getFirstWaiter
+ *   removeDueTask
+ *   updateOwnersOfAwaitedMutexes
+ *   setPrioClass
+ *   updateInheritedPrio
+ *   changeMutexOwner
+ *   isResumeConditionFulfilled
+ *   makeTaskDue
  *   checkTaskForActivation
+ *   accountTaskSwitch
  *   lookForActiveTask
  *   onTimerTick
  *   sendEvent
  *   acquireFreeSyncObjs
  *   storeResumeCondition
+ *   suspendActiveTask
  *   waitForEvent
+ *   sendToQueue
+ *   receiveFromQueue
  */
 
 
@@ -92,9 +120,44 @@
          - MASK_EVT_IS_SEMAPHORE                                                \
         )
 
+/** A bit mask, which selects all the queue events in an event vector. */
+#define MASK_EVT_IS_QUEUE                                                       \
+        ((((uint32_t)1<<(RTOS_NO_QUEUE_EVENTS+RTOS_NO_MUTEX_EVENTS              \
+                         +RTOS_NO_SEMAPHORE_EVENTS                              \
+                        )                                                       \
+          )-1u                                                                  \
+         )                                                                      \
+         - MASK_EVT_IS_MUTEX - MASK_EVT_IS_SEMAPHORE                            \
+        )
+
 /** A bit mask, which selects all timer events in a vector of events. */
 #define MASK_EVT_IS_TIMER (RTOS_EVT_ABSOLUTE_TIMER | RTOS_EVT_DELAY_TIMER)
 
+/** The index of the lowest event, which is reserved for the timers and the application
+    interrupts. These events are located at the upper end of the event vector. */
+#if RTOS_USE_APPL_INTERRUPT_01 == RTOS_FEATURE_ON
+# define IDX_LOWEST_RESERVED_EVT    28u
+#elif RTOS_USE_APPL_INTERRUPT_00 == RTOS_FEATURE_ON
+# define IDX_LOWEST_RESERVED_EVT    29u
+#else
+# define IDX_LOWEST_RESERVED_EVT    30u
+#endif
+
+/* The event vector is 32 Bit wide. Semaphores, mutexes and queues occupy one event each,
+   starting at bit 0, and they share the space with the timer and interrupt events. */
+_Static_assert( RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS
+                <= IDX_LOWEST_RESERVED_EVT
+                &&  IDX_LOWEST_RESERVED_EVT < 8u*sizeof(uint32_t)
+              , "Semaphores, mutexes and queues exceed the 32 Bit event vector"
+              );
+
+/** The number of events, which can be posted by rtos_sendEvent(). These are all events
+    but the two timer events. */
+#define NO_POSTABLE_EVENTS  30u
+
+/** The number of 32 Bit words of a bit vector with one bit per task. */
+#define NO_WORDS_TASK_VEC   (RTOS_NO_TASKS > 0? (RTOS_NO_TASKS+31u)/32u: 1u)
+
 /** A pattern byte, which is used as prefill byte of any task stack area. A simple and
     inexpensive stack usage check at runtime can be implemented by looking for up to where
     this pattern has been destroyed. Any value which is not the null and which is
@@ -115,6 +178,20 @@
     clock sources (normally only PIT3). */
 #define TEST_USE_IRREGULAR_SYS_CLOCK    0
 
+#if TEST_USE_IRREGULAR_SYS_CLOCK == 1  &&  RTOS_TICKLESS_IDLE == RTOS_FEATURE_ON
+# error The irregular test clock and the tickless idle mode are mutually exclusive
+#endif
+
+/** The period of the system timer tick in cycles of the peripheral clock, which clocks the
+    PIT. The peripheral clock has been initialized to 120 MHz. */
+#define NO_CYCLES_PER_TICK  ((uint32_t)((RTOS_TICK) * 120e6))
+
+#if RTOS_TICKLESS_IDLE == RTOS_FEATURE_ON
+/** The maximum number of system timer ticks, which can be skipped at once in tickless idle
+    mode. It's limited by the range of the 32 Bit PIT counter. */
+# define MAX_NO_TICKS_IN_PERIOD (0xffffffffu / NO_CYCLES_PER_TICK)
+#endif
+
 
 /*
  * Local type definitions
@@ -129,16 +206,38 @@
     structure had a size which is a power of 2. (Maybe with a few padding bytes.) This
     would speed-up - and maybe significantly - the address computations the kernel often has
     to do when accessing the task information. */
-typedef struct
+typedef struct task_t
 {
     /** The execution context information (mainly the stack pointer) of this task whenever
         it is not active. */
     int_contextSaveDesc_t contextSaveDesc;
 
     /** The priority class this task belongs to. Priority class 255 has the highest
-        possible priority and the lower the value the lower the priority. */
+        possible priority and the lower the value the lower the priority.\n
+          If priority inheritance is configured then this is the effective priority
+        class. It is raised above \a basePrioClass while the task owns a mutex, which a
+        task of higher priority waits for. */
     unsigned int prioClass;
 
+#if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+    /** The priority class, which the task has been configured with by
+        rtos_initializeTask(). The effective priority \a prioClass falls back to this
+        value when the task doesn't own a mutex awaited by a task of higher priority. */
+    unsigned int basePrioClass;
+#endif
+
+    /** The successor in the due list of the priority class or NULL for the last task. Not
+        used while the task is suspended. */
+    struct task_t *pNext;
+
+    /** The sequence number of the last suspend command of the task. Amongst suspended
+        tasks of same priority, the one with the lowest number waits the longest. It is
+        served first when a mutex or semaphore is released and it becomes due first if
+        several tasks are resumed by the same event.\n
+          The number is a 64 Bit counter; it won't wrap around during the lifetime of the
+        system. */
+    uint64_t suspendSeqNo;
+
     /** The task function as a function pointer. It is used once and only once: The task
         function is invoked the first time the task becomes active and must never end. A
         return statement would cause an immediate reset of the controller. */
@@ -167,13 +266,26 @@ typedef struct
         the task. Each task may have an individual stack size. */
     unsigned int stackSize;
 
-    /** The timer tick decremented counter triggering the task local delay-timer event.\n
-          The initial value determines at which system timer tick the task becomes due the
-        very first time. This may always by 1 (task becomes due immediately). In the use
-        case of regular tasks it may however pay off to distribute the tasks on the time
-        grid in order to avoid too many due tasks regularly at specific points in time. See
-        documentation for more. */
-    unsigned int cntDelay;
+    /** A suspended task, which waits for either the delay-timer or the absolute-timer
+        event, is linked into the list of running timers, \a _pTimerList. This is the next
+        task in this list or NULL for the last one. */
+    struct task_t *pNextTimer;
+
+    /** The link, which points to this task in the list of running timers. It is either
+        the list head \a _pTimerList or the field \a pNextTimer of the predecessor. The
+        pointer is NULL if and only if the task is not in the list. */
+    struct task_t **ppLinkToThisTimer;
+
+    /** The number of system timer ticks between the expiration of the timer of the
+        predecessor in the list of running timers and the expiration of the timer of this
+        task. The sum of all deltas up to and including a task is the number of ticks from
+        now till its timer event.\n
+          Between rtos_initializeTask() and rtos_initRTOS() the field holds the number of
+        ticks till the task becomes due the very first time. This may always be 1 (task
+        becomes due immediately). In the use case of regular tasks it may however pay off
+        to distribute the tasks on the time grid in order to avoid too many due tasks
+        regularly at specific points in time. See documentation for more. */
+    unsigned int cntTimerDelta;
 
 #if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
     /** The timer tick decremented counter triggering a task switch in round-robin mode. */
@@ -189,6 +301,13 @@ typedef struct
     /** Do we need to wait for the first posted event or for all events? */
     bool waitForAnyEvent;
 
+#if RTOS_USE_QUEUE == RTOS_FEATURE_ON
+    /** The message of a task, which is suspended in rtos_sendToQueue(), or the receive
+        buffer of a task, which is suspended in rtos_receiveFromQueue(). The kernel copies
+        the message from or into this buffer when it resumes the task. */
+    void *pMsgBuffer;
+#endif
+
     /** All recognized overruns of the timing of this task are recorded in this variable.
           Task overruns are defined only in the (typical) use case of regular real time
         tasks. In all other applications of a task this value is useless and undefined.\n
@@ -196,6 +315,30 @@ typedef struct
         variable. */
     unsigned int cntOverrun;
 
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+    /** The CPU time consumed by the task in ticks of the time base. The time of the
+        current activation is not included while the task is active. */
+    uint64_t tiCpu;
+
+    /** The value of the time base when the task became due or zero if it has become
+        active since. */
+    uint64_t tiBecameDue;
+
+    /** The number of task switches, which made this task the active task. */
+    unsigned int noActivations;
+
+    /** The longest time span from becoming due till becoming active in ticks of the time
+        base. */
+    uint32_t tiMaxLatency;
+#endif
+
+#if INT_USE_LAZY_SPE_SAVE == 1
+    /** The save area for the SPE registers if the task uses the SIMD instructions or NULL
+        otherwise. The field is copied into the context save descriptor when the task is
+        created in rtos_initRTOS(). */
+    int_speContextSaveArea_t *pSpeContextSaveArea;
+#endif
+
 } task_t;
 
 
@@ -212,14 +355,21 @@ static bool waitForEvent( uint32_t eventMask
 #else
 static void waitForEvent(uint32_t eventMask, bool all, unsigned int timeout);
 #endif
+static void suspendActiveTask(uint32_t eventMask, bool all, unsigned int timeout);
+#if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+static void updateInheritedPrio(task_t * const pT);
+#endif
+#if RTOS_TICKLESS_IDLE == RTOS_FEATURE_ON
+static void endTicklessPeriod(void);
+#endif
 
 
 /*
  * Data definitions
  */
 
-#if RTOS_NO_TASKS > RTOS_NO_PRIO_CLASSES*RTOS_MAX_NO_TASKS_IN_PRIO_CLASS
-# error Bad configuration of number of tasks and priority classes
+#if RTOS_NO_PRIO_CLASSES > 32
+# error The bit vector of non empty due lists supports no more than 32 priority classes
 #endif
 
 /** The RTuinOS startup message. All applications, which make use of the serial connection
@@ -253,18 +403,42 @@ static task_t *_pActiveTask = &_taskAry[IDLE_TASK_ID];
     used in the instance of a task switch. */
 static task_t *_pSuspendedTask = NULL;
 
-/** Array holding all due (but not active) tasks. Ordered according to their priority
-    class. */
-static task_t *_pDueTaskAryAry[RTOS_NO_PRIO_CLASSES][RTOS_MAX_NO_TASKS_IN_PRIO_CLASS];
+/** The due tasks, one FIFO list per priority class. The active task is the head of its
+    list. The lists are linked through field \a pNext of the task objects.\n
+      An application without tasks has no priority classes. The array has at least one
+    element in order to avoid a zero length array; the element is unused in this case. */
+static struct
+{
+    /** The first due task of the class or NULL if the list is empty. */
+    task_t *pHead;
+
+    /** The last due task of the class or NULL if the list is empty. */
+    task_t *pTail;
+
+} _dueListAry[RTOS_NO_PRIO_CLASSES > 0? RTOS_NO_PRIO_CLASSES: 1];
 
-/** Number of due tasks in the different priority classes. */
-static unsigned int _noDueTasksAry[RTOS_NO_PRIO_CLASSES];
+/** A bit vector, bit i is set if and only if the due list of priority class i is not
+    empty. The highest priority class with due tasks is found by a single count leading
+    zeros instruction. */
+static uint32_t _dueListNotEmptyVec = 0;
 
-/** Array holding all currently suspended tasks. */
-static task_t *_pSuspendedTaskAry[RTOS_NO_TASKS];
+/** The sequence number of the next suspend command. See field \a suspendSeqNo of the
+    task object. */
+static uint64_t _nextSuspendSeqNo = 0;
 
-/** Number of currently suspended tasks. */
-static unsigned int _noSuspendedTasks;
+/** The waiters for the postable events. For each event there's a bit vector with one bit
+    per task. The bit of a task is set if and only if the task is suspended, its event
+    mask contains the event and it didn't receive the event yet. Bit i of word j relates
+    to the task with index 32*j+i. sendEvent() only visits the tasks, which are found in
+    the bit vectors of the posted events. */
+static uint32_t _waitingTaskVecAry[NO_POSTABLE_EVENTS][NO_WORDS_TASK_VEC];
+
+/** The list of running timers. All suspended tasks, which wait for a timer event, are
+    linked in the order of expiration of their timers. The list is a delta list: Each task
+    holds the number of ticks relative to its predecessor. A timer tick only needs to
+    decrement the head element and it needs to visit those tasks only, whose timer actually
+    elapses. */
+static task_t *_pTimerList = NULL;
 
 #if RTOS_USE_MUTEX == RTOS_FEATURE_ON
 /** All of the mutex events are combined in a bit vector. The mutexes are initially
@@ -272,6 +446,26 @@ static unsigned int _noSuspendedTasks;
 static uint32_t _mutexVec = MASK_EVT_IS_MUTEX;
 #endif
 
+#if RTOS_TICKLESS_IDLE == RTOS_FEATURE_ON
+/** The number of system timer ticks, which the currently running period of the PIT
+    stands for. It is one in normal operation. If only the idle task is ready then the
+    PIT is reprogrammed to skip the ticks, which won't have an effect, and the number is
+    greater than one. */
+static unsigned int _noTicksInPeriod = 1;
+#endif
+
+#if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+/** The owner of each mutex or NULL if the mutex is currently released. Element i relates
+    to the mutex with event index #RTOS_NO_SEMAPHORE_EVENTS+i. */
+static task_t *_mutexOwnerAry[RTOS_NO_MUTEX_EVENTS];
+#endif
+
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+/** The value of the time base at the most recent task switch. The CPU time since then
+    belongs to the active task. */
+static uint64_t _tiLastTaskSwitch = 0;
+#endif
+
 
 /*
  * Function implementation
@@ -313,23 +507,403 @@ static void prepareTaskStack(uint32_t * const pEmptyTaskStack, unsigned int stac
 
 
 
+/**
+ * A task, which is suspended with a timeout condition, is put into the delta list of
+ * running timers. The cost of the insertion is linear in the number of timers, which
+ * elapse earlier.
+ *   @param pT
+ * The task, which waits for the timer event. It must not be in the list yet.
+ *   @param noTicks
+ * The number of system timer ticks from now till the timer event, i.e. the timer elapses
+ * in the \a noTicks-th call of onTimerTick() from now on. The range is 1..max_value(\a
+ * unsigned int).
+ *   @remark
+ * Tasks, whose timers elapse in the same tick, are linked in the order of their insertion.
+ * This way, they will become due in the same order as with the original implementation,
+ * which inspected all suspended tasks in each tick.
+ */
+static inline void startTimer(task_t * const pT, unsigned int noTicks)
+{
+    assert(pT->ppLinkToThisTimer == NULL  &&  noTicks > 0);
+
+    /* Look for the first timer, which elapses later than the new one. <= rather than <: The
+       new timer is placed behind all timers of same expiration. */
+    task_t **ppLink = &_pTimerList;
+    while(*ppLink != NULL  &&  (*ppLink)->cntTimerDelta <= noTicks)
+    {
+        noTicks -= (*ppLink)->cntTimerDelta;
+        ppLink = &(*ppLink)->pNextTimer;
+    }
+
+    /* Link the task in. The successor's delta is now relative to the new timer. */
+    task_t * const pNext = *ppLink;
+    pT->cntTimerDelta = noTicks;
+    pT->pNextTimer = pNext;
+    pT->ppLinkToThisTimer = ppLink;
+    if(pNext != NULL)
+    {
+        pNext->cntTimerDelta -= noTicks;
+        pNext->ppLinkToThisTimer = &pT->pNextTimer;
+    }
+    *ppLink = pT;
+
+} /* End of startTimer */
+
+
+
 
 /**
- * When an event has been posted to a currently suspended task, it might easily be that
- * this task is resumed and becomes due. This routine checks a suspended task for resume
- * and moves it into the due task lists if it is resumed.
+ * Take a task out of the list of running timers. This is required if a suspended task is
+ * resumed by another event than its timer event. The operation doesn't depend on the
+ * number of running timers.
+ *   @param pT
+ * The task, whose timer is cancelled. It needs to be in the list.
+ */
+static inline void stopTimer(task_t * const pT)
+{
+    assert(pT->ppLinkToThisTimer != NULL);
+
+    /* The ticks of the removed task are inherited by its successor, which keeps its
+       absolute expiration time. */
+    task_t * const pNext = pT->pNextTimer;
+    *pT->ppLinkToThisTimer = pNext;
+    if(pNext != NULL)
+    {
+        pNext->cntTimerDelta += pT->cntTimerDelta;
+        pNext->ppLinkToThisTimer = pT->ppLinkToThisTimer;
+    }
+    pT->pNextTimer = NULL;
+    pT->ppLinkToThisTimer = NULL;
+
+} /* End of stopTimer */
+
+
+
+
+/**
+ * Put a task at the end of the due list of its priority class.
+ *   @param pT
+ * The task, which becomes due.
+ */
+static inline void addDueTask(task_t * const pT)
+{
+    const unsigned int prio = pT->prioClass;
+
+    pT->pNext = NULL;
+    if(_dueListAry[prio].pTail != NULL)
+        _dueListAry[prio].pTail->pNext = pT;
+    else
+    {
+        _dueListAry[prio].pHead = pT;
+        _dueListNotEmptyVec |= 1u << prio;
+    }
+    _dueListAry[prio].pTail = pT;
+
+} /* End of addDueTask */
+
+
+
+
+/**
+ * Find the task, which is to be activated: It's the first task in the highest non-empty
+ * priority class.
  *   @return
- * The Boolean information whether the task is resumed and becomes due is returned.
- *   @param idxSuspTask
- * The index of the investigated task. It is the index in the global list
- * \a _pSuspendedTaskAry of suspended tasks.
+ * Get the first due task of the highest priority class or the idle task if there's no due
+ * task at all.
+ *   @remark
+ * The highest non-empty class is found by a count leading zeros instruction. The cost
+ * doesn't depend on the number of tasks and priority classes.
+ */
+static inline task_t *getHighestPrioDueTask(void)
+{
+    if(_dueListNotEmptyVec != 0)
+    {
+        const unsigned int prio = 31u - (unsigned int)__builtin_clz(_dueListNotEmptyVec);
+        return _dueListAry[prio].pHead;
+    }
+    else
+        return _pIdleTask;
+
+} /* End of getHighestPrioDueTask */
+
+
+
+
+/**
+ * Register a task as waiter for a set of events. This is done when the task is suspended.
+ *   @param pT
+ * The task, which waits for the events.
+ *   @param eventVec
+ * The set of events. Timer events are ignored.
+ */
+static inline void registerWaiter(const task_t * const pT, uint32_t eventVec)
+{
+    const unsigned int idxTask = (unsigned int)(pT - _taskAry)
+                     , idxWord = idxTask / 32u;
+    const uint32_t maskTask = 1u << (idxTask % 32u);
+
+    eventVec &= ~MASK_EVT_IS_TIMER;
+    while(eventVec != 0)
+    {
+        const unsigned int idxEvt = (unsigned int)__builtin_ctz(eventVec);
+        eventVec &= eventVec - 1u;
+        _waitingTaskVecAry[idxEvt][idxWord] |= maskTask;
+    }
+} /* End of registerWaiter */
+
+
+
+
+/**
+ * Unregister a task as waiter for a set of events. This is done when the task receives
+ * the events or when it becomes due.
+ *   @param pT
+ * The task, which no longer waits for the events.
+ *   @param eventVec
+ * The set of events. Timer events are ignored. It doesn't matter if the task had not been
+ * registered for some of the events.
+ */
+static inline void unregisterWaiter(const task_t * const pT, uint32_t eventVec)
+{
+    const unsigned int idxTask = (unsigned int)(pT - _taskAry)
+                     , idxWord = idxTask / 32u;
+    const uint32_t maskTask = 1u << (idxTask % 32u);
+
+    eventVec &= ~MASK_EVT_IS_TIMER;
+    while(eventVec != 0)
+    {
+        const unsigned int idxEvt = (unsigned int)__builtin_ctz(eventVec);
+        eventVec &= eventVec - 1u;
+        _waitingTaskVecAry[idxEvt][idxWord] &= ~maskTask;
+    }
+} /* End of unregisterWaiter */
+
+
+
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON  \
+    ||  RTOS_USE_QUEUE == RTOS_FEATURE_ON
+/**
+ * Find the task, which a released mutex or semaphore or a queued message is passed to.
+ * This is the waiter of highest priority and, among those of same priority, the one,
+ * which waits the longest.
+ *   @return
+ * Get the task or NULL if no task waits for the event.
+ *   @param idxEvt
+ * The index of the mutex, semaphore or queue event, i.e. the bit number in the event
+ * vector.
+ *   @remark
+ * The cost is linear in the number of waiters. In the common case of a single waiter
+ * this is a single iteration.
+ */
+static inline task_t *getFirstWaiter(unsigned int idxEvt)
+{
+    task_t *pFirst = NULL;
+    unsigned int idxWord;
+    for(idxWord=0; idxWord<NO_WORDS_TASK_VEC; ++idxWord)
+    {
+        uint32_t waitingTaskVec = _waitingTaskVecAry[idxEvt][idxWord];
+        while(waitingTaskVec != 0)
+        {
+            task_t * const pT = &_taskAry[32u*idxWord
+                                          + (unsigned int)__builtin_ctz(waitingTaskVec)
+                                         ];
+            waitingTaskVec &= waitingTaskVec - 1u;
+
+            if(pFirst == NULL
+               ||  pT->prioClass > pFirst->prioClass
+               ||  (pT->prioClass == pFirst->prioClass
+                    &&  pT->suspendSeqNo < pFirst->suspendSeqNo
+                   )
+              )
+            {
+                pFirst = pT;
+            }
+        }
+    }
+
+    return pFirst;
+
+} /* End of getFirstWaiter */
+#endif
+
+
+
+
+#if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+/**
+ * Take a task out of the due list of its priority class if it is in this list.
+ *   @return
+ * Get \a true if the task had been due and has been removed from the list or \a false if
+ * the task is suspended.
+ *   @param pT
+ * The task.
+ *   @remark
+ * The cost is linear in the number of due tasks of the priority class.
+ */
+static bool removeDueTask(task_t * const pT)
+{
+    const unsigned int prio = pT->prioClass;
+    task_t *pPred = NULL
+         , *pCur = _dueListAry[prio].pHead;
+    while(pCur != NULL  &&  pCur != pT)
+    {
+        pPred = pCur;
+        pCur = pCur->pNext;
+    }
+    if(pCur == NULL)
+        return false;
+
+    if(pPred == NULL)
+        _dueListAry[prio].pHead = pT->pNext;
+    else
+        pPred->pNext = pT->pNext;
+    if(_dueListAry[prio].pTail == pT)
+        _dueListAry[prio].pTail = pPred;
+    if(_dueListAry[prio].pHead == NULL)
+        _dueListNotEmptyVec &= ~(1u << prio);
+
+    return true;
+
+} /* End of removeDueTask */
+
+
+
+
+/**
+ * The set of waiters for some mutexes has changed. The owners of these mutexes get their
+ * inherited priority updated.
+ *   @param mutexVec
+ * The set of affected mutexes as bit vector of events.
+ */
+static inline void updateOwnersOfAwaitedMutexes(uint32_t mutexVec)
+{
+    mutexVec &= MASK_EVT_IS_MUTEX;
+    while(mutexVec != 0)
+    {
+        const unsigned int idxEvt = (unsigned int)__builtin_ctz(mutexVec);
+        mutexVec &= mutexVec - 1u;
+
+        task_t * const pOwner = _mutexOwnerAry[idxEvt - RTOS_NO_SEMAPHORE_EVENTS];
+        if(pOwner != NULL)
+            updateInheritedPrio(pOwner);
+    }
+} /* End of updateOwnersOfAwaitedMutexes */
+
+
+
+
+/**
+ * Change the effective priority class of a task. A due task is moved into the due list of
+ * the new class. A suspended task, which waits for mutexes, passes its new priority on to
+ * the owners of these mutexes.
+ *   @param pT
+ * The task.
+ *   @param prioClass
+ * The new priority class.
+ *   @remark
+ * The function doesn't decide about a task switch. The caller needs to look for the task
+ * to activate after the change.
+ */
+static void setPrioClass(task_t * const pT, unsigned int prioClass)
+{
+    if(removeDueTask(pT))
+    {
+        pT->prioClass = prioClass;
+        if(pT == _pActiveTask)
+        {
+            /* The active task needs to become the head of its new list. If it is demoted
+               and a task of higher priority is due then it is the first one to continue
+               in its new class, like any preempted task. */
+            pT->pNext = _dueListAry[prioClass].pHead;
+            _dueListAry[prioClass].pHead = pT;
+            if(pT->pNext == NULL)
+            {
+                _dueListAry[prioClass].pTail = pT;
+                _dueListNotEmptyVec |= 1u << prioClass;
+            }
+        }
+        else
+            addDueTask(pT);
+    }
+    else
+    {
+        pT->prioClass = prioClass;
+
+        /* The mutexes, which the suspended task still waits for, are those in its mask,
+           which it didn't receive yet. Their owners may inherit the new priority. The
+           recursion ends where the priority doesn't change, even in case of a deadlock
+           cycle. */
+        updateOwnersOfAwaitedMutexes(pT->eventMask & ~pT->postedEventVec);
+    }
+} /* End of setPrioClass */
+
+
+
+
+/**
+ * Recompute the effective priority class of a task: It is the maximum of its configured
+ * class and of the effective classes of the first waiters for all mutexes, which it owns.
+ *   @param pT
+ * The task.
+ *   @remark
+ * The cost is linear in the number of mutexes and waiters.
+ */
+static void updateInheritedPrio(task_t * const pT)
+{
+    unsigned int prioClass = pT->basePrioClass
+               , idxMutex;
+    for(idxMutex=0; idxMutex<RTOS_NO_MUTEX_EVENTS; ++idxMutex)
+    {
+        if(_mutexOwnerAry[idxMutex] == pT)
+        {
+            const task_t * const pWaiter = getFirstWaiter(RTOS_NO_SEMAPHORE_EVENTS+idxMutex);
+            if(pWaiter != NULL  &&  pWaiter->prioClass > prioClass)
+                prioClass = pWaiter->prioClass;
+        }
+    }
+
+    if(prioClass != pT->prioClass)
+        setPrioClass(pT, prioClass);
+
+} /* End of updateInheritedPrio */
+
+
+
+
+/**
+ * Record the new owner of a mutex. The previous owner loses the priority, which it may
+ * have inherited from the waiters for the mutex, and the new owner inherits it.
+ *   @param idxEvt
+ * The index of the mutex event, i.e. the bit number in the event vector.
+ *   @param pNewOwner
+ * The task, which the mutex is passed to, or NULL if the mutex is released.
  */
-static inline bool checkTaskForActivation(unsigned int idxSuspTask)
+static void changeMutexOwner(unsigned int idxEvt, task_t * const pNewOwner)
 {
-    task_t * const pT = _pSuspendedTaskAry[idxSuspTask];
-    uint32_t eventVec;
-    bool taskBecomesDue;
+    task_t * const pOldOwner = _mutexOwnerAry[idxEvt - RTOS_NO_SEMAPHORE_EVENTS];
+    _mutexOwnerAry[idxEvt - RTOS_NO_SEMAPHORE_EVENTS] = pNewOwner;
 
+    if(pOldOwner != NULL)
+        updateInheritedPrio(pOldOwner);
+    if(pNewOwner != NULL)
+        updateInheritedPrio(pNewOwner);
+
+} /* End of changeMutexOwner */
+#endif /* RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON */
+
+
+
+
+/**
+ * Check the resume condition of a suspended task after events have been posted to it.
+ *   @return
+ * The Boolean information whether the task is resumed is returned.
+ *   @param pT
+ * The investigated task. It is a suspended task.
+ */
+static inline bool isResumeConditionFulfilled(const task_t * const pT)
+{
     /* Check if the task becomes due because of the events posted prior to calling this
        function. The optimally supported case is the more probable OR combination of
        events.
@@ -338,45 +912,125 @@ static inline bool checkTaskForActivation(unsigned int idxSuspTask)
        does not include the timer events. All postable events need to be set in both
        the mask and the vector of posted events OR any of the timer events in the mask
        are set in the vector of posted events. */
-    eventVec = pT->postedEventVec;
-    if((pT->waitForAnyEvent &&  eventVec != 0)
-       ||  (!pT->waitForAnyEvent
-            &&  (((eventVec ^ pT->eventMask) & ~MASK_EVT_IS_TIMER) == 0
-                 ||  (eventVec & pT->eventMask & MASK_EVT_IS_TIMER) != 0
-                )
-           )
-      )
-    {
-        unsigned int u
-                   , prio = pT->prioClass;
+    const uint32_t eventVec = pT->postedEventVec;
+    return (pT->waitForAnyEvent &&  eventVec != 0)
+           ||  (!pT->waitForAnyEvent
+                &&  (((eventVec ^ pT->eventMask) & ~MASK_EVT_IS_TIMER) == 0
+                     ||  (eventVec & pT->eventMask & MASK_EVT_IS_TIMER) != 0
+                    )
+               );
 
-        /* This task becomes due. */
+} /* End of isResumeConditionFulfilled */
+
+
+
+
+/**
+ * A suspended task is resumed: It no longer waits for events and it is moved into the due
+ * list of its priority class.
+ *   @param pT
+ * The resumed task.
+ */
+static inline void makeTaskDue(task_t * const pT)
+{
+    /* A still running timer is no longer needed. The timer is not running any more if the
+       task is resumed by the timer event itself. */
+    if(pT->ppLinkToThisTimer != NULL)
+        stopTimer(pT);
+
+    /* The task doesn't wait any longer for those events, which it didn't receive. */
+    unregisterWaiter(pT, pT->eventMask);
+
+#if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+    /* If the task gives up waiting for a mutex, e.g. because of a timeout, then the owner
+       may lose the priority inherited from it. */
+    updateOwnersOfAwaitedMutexes(pT->eventMask & ~pT->postedEventVec);
+#endif
 
 #if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
-        /* If a round robin task voluntarily suspends it gets the right for a complete
-           new time slice. Reload the counter. */
-        pT->cntRoundRobin = pT->timeRoundRobin;
-#endif
-        /* Move the task from the list of suspended tasks to the list of due tasks of
-           its priority class. */
-        _pDueTaskAryAry[prio][_noDueTasksAry[prio]++] = pT;
-        -- _noSuspendedTasks;
-        for(u=idxSuspTask; u<_noSuspendedTasks; ++u)
-            _pSuspendedTaskAry[u] = _pSuspendedTaskAry[u+1];
-
-        /* Since a task became due there might be a change of the active task. */
-        taskBecomesDue = true;
+    /* If a round robin task voluntarily suspends it gets the right for a complete new time
+       slice. Reload the counter. */
+    pT->cntRoundRobin = pT->timeRoundRobin;
+#endif
+
+#if RTOS_TICKLESS_IDLE == RTOS_FEATURE_ON
+    /* The system timer may skip ticks while only the idle task is ready. A task, which
+       becomes due, needs the regular tick again, e.g. for its next timeout. */
+    if(_noTicksInPeriod > 1)
+        endTicklessPeriod();
+#endif
+
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+    /* The latency till the task becomes active is measured from now on. */
+    pT->tiBecameDue = ihw_getTimeBase();
+#endif
+
+    /* Put the task into the list of due tasks of its priority class. */
+    addDueTask(pT);
+
+} /* End of makeTaskDue */
+
+
+
+
+/**
+ * When an event has been posted to a currently suspended task, it might easily be that
+ * this task is resumed and becomes due. This routine checks a suspended task for resume
+ * and moves it into the due task lists if it is resumed.
+ *   @return
+ * The Boolean information whether the task is resumed and becomes due is returned.
+ *   @param pT
+ * The investigated task. It is a suspended task.
+ */
+static inline bool checkTaskForActivation(task_t * const pT)
+{
+    if(isResumeConditionFulfilled(pT))
+    {
+        /* This task becomes due. Since a task became due there might be a change of the
+           active task. */
+        makeTaskDue(pT);
+        return true;
     }
     else
-        taskBecomesDue = false;
-
-    return taskBecomesDue;
+        return false;
 
 } /* End of checkTaskForActivation */
 
 
 
 
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+/**
+ * A task switch from \a _pSuspendedTask to \a _pActiveTask has been decided. The CPU time
+ * since the previous task switch is charged to the suspended task and the activation of
+ * the other task is recorded.
+ *   @remark
+ * The function is called with all interrupts disabled, from the kernel functions, which
+ * set \a _pActiveTask. The time between this call and the actual context switch is
+ * charged to the newly active task.
+ */
+static inline void accountTaskSwitch(void)
+{
+    const uint64_t tiNow = ihw_getTimeBase();
+    _pSuspendedTask->tiCpu += tiNow - _tiLastTaskSwitch;
+    _tiLastTaskSwitch = tiNow;
+
+    task_t * const pT = _pActiveTask;
+    ++ pT->noActivations;
+    if(pT->tiBecameDue != 0)
+    {
+        /* The latency is saturated at about 35s. */
+        const uint64_t tiLatency = tiNow - pT->tiBecameDue;
+        if(tiLatency > pT->tiMaxLatency)
+            pT->tiMaxLatency = tiLatency <= UINT32_MAX? (uint32_t)tiLatency: UINT32_MAX;
+        pT->tiBecameDue = 0;
+    }
+} /* End of accountTaskSwitch */
+#endif
+
+
+
+
 /**
  * After posting an event to one or more currently suspended tasks, it might easily be that
  * one such task is resumed and ready and becomes active because of its higher priority. To
@@ -394,29 +1048,22 @@ static inline bool lookForActiveTask()
        true. Otherwise it'll simply do a "reti" to the interrupted context and continue
        it. */
 
-    signed int idxPrio;
+    /* This function is called under the precondition that a task was put into a due
+       list, so there is surely a due task. */
+    assert(_dueListNotEmptyVec != 0);
 
     /* Look for the task we will return to. It's the first entry in the highest
-       non-empty priority class. The loop requires a signed index. */
-    for(idxPrio=RTOS_NO_PRIO_CLASSES-1; idxPrio>=0; --idxPrio)
-    {
-        if(_noDueTasksAry[idxPrio] > 0)
-        {
-            _pSuspendedTask = _pActiveTask;
-            _pActiveTask    = _pDueTaskAryAry[idxPrio][0];
-
-            /* If we only entered the outermost if clause we made at least one task
-               due; these statements are thus surely reached. As the due becoming task
-               might however be of lower priority it can easily be that we nonetheless
-               don't have a task switch. */
-            return _pActiveTask != _pSuspendedTask;
-        }
-    }
+       non-empty priority class. As the due becoming task might however be of lower
+       priority it can easily be that we nonetheless don't have a task switch. */
+    _pSuspendedTask = _pActiveTask;
+    _pActiveTask    = getHighestPrioDueTask();
+    const bool isTaskSwitch = _pActiveTask != _pSuspendedTask;
 
-    /* We never get here. This function is called under the precondition that a task was
-       put into a due list, so the search above will surely have found one. */
-    assert(false);
-    return false;
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+    if(isTaskSwitch)
+        accountTaskSwitch();
+#endif
+    return isTaskSwitch;
 
 } /* End of lookForActiveTask */
 
@@ -425,7 +1072,7 @@ static inline bool lookForActiveTask()
 
 /**
  * This function is called from the system interrupt triggered by the main clock. The
- * timers of all suspended tasks are served and - in case they elapse - timer events are
+ * list of running timers is served and - in case they elapse - timer events are
  * generated. These events may then resume some of the tasks. If so, they are placed in
  * the appropriate list of due tasks. Finally, the longest due task in the highest none
  * empty priority class is activated.
@@ -444,58 +1091,44 @@ static bool onTimerTick(void)
 
     bool activeTaskMayChange = false;
 
-    /* Check for all suspended tasks if a timer event has to be posted. */
-    unsigned int idxSuspTask = 0;
-    while(idxSuspTask<_noSuspendedTasks)
+    /* Only the head of the delta list of running timers needs to be clocked. The code here
+       should optimally support the standard situation that no timer elapses in this
+       tick. */
+    if(_pTimerList != NULL  &&  --_pTimerList->cntTimerDelta == 0)
     {
-        task_t * const pT = _pSuspendedTaskAry[idxSuspTask];
-
-        /* Remember the received events before (possibly) getting some more in this
-           timer tick: Only if this set changes it is necessary to check for a state
-           transition of the task. */
-        const uint32_t postedEventVecBefore = pT->postedEventVec;
-
-        /* Check for absolute timer event. */
-        if(_time == pT->timeDueAt)
-        {
-            /* Setting the absolute timer event when it already is set looks like a task
-               overrun indication. It isn't for the following reason. The absolute timer
-               event can't be AND combined with other events, so the event will immediately
-               change the status to due (see checkForTaskActivation), so that setting it a
-               second time will never occur. */
-            pT->postedEventVec |= (RTOS_EVT_ABSOLUTE_TIMER & pT->eventMask);
-        }
-
-        /* Check for delay timer event. The code here should optimally support the standard
-           situation that the counter is constantly 0. */
-        if(pT->cntDelay != 0)
+        /* All timers at the beginning of the list with a delta of zero elapse in the same
+           tick. */
+        do
         {
-            if(-- pT->cntDelay == 0)
-                pT->postedEventVec |= (RTOS_EVT_DELAY_TIMER & pT->eventMask);
-        }
+            task_t * const pT = _pTimerList;
+
+            /* Unlink the elapsed timer. */
+            _pTimerList = pT->pNextTimer;
+            if(_pTimerList != NULL)
+                _pTimerList->ppLinkToThisTimer = &_pTimerList;
+            pT->pNextTimer = NULL;
+            pT->ppLinkToThisTimer = NULL;
+
+            /* Post the timer event. A task is in the list only if its event mask contains
+               exactly one of the two timer events. Setting the absolute timer event when
+               it already is set looks like a task overrun indication. It isn't for the
+               following reason. A timer event can't be AND combined with other events, so
+               the event will immediately change the status to due (see
+               checkTaskForActivation), so that setting it a second time will never
+               occur. */
+            assert((pT->postedEventVec & MASK_EVT_IS_TIMER) == 0);
+            pT->postedEventVec |= (pT->eventMask & MASK_EVT_IS_TIMER);
+
+            /* The timer event surely makes the task due. */
+            const bool isDue ATTRIB_DBG_ONLY = checkTaskForActivation(pT);
+            assert(isDue);
 
-        /* Check if this suspended task becomes due because of a timer event, which was
-           posted to it. */
-        if(postedEventVecBefore != pT->postedEventVec  && checkTaskForActivation(idxSuspTask))
-        {
             /* The task becomes due, which may cause a task switch. */
             activeTaskMayChange = true;
-
-            /* Check next suspended task, which is in this case found in the array
-               element with same index: The task which became due has been removed into the
-               due list of its priority class. */
         }
-        else
-        {
-            /* The task remains suspended. */
-
-            /* Check next suspended task, which is in this case found in the next array
-               element. */
-            ++ idxSuspTask;
-
-        } /* End if(Did this suspended task become due?) */
+        while(_pTimerList != NULL  &&  _pTimerList->cntTimerDelta == 0);
 
-    } /* End while(All suspended tasks) */
+    } /* End if(Does at least one timer elapse in this tick?) */
 
 
 #if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
@@ -509,22 +1142,20 @@ static bool onTimerTick(void)
             /* Time slice of active task has elapsed. Reload the counter. */
             _pActiveTask->cntRoundRobin = _pActiveTask->timeRoundRobin;
 
-            unsigned int prio = _pActiveTask->prioClass
-                       , noTasks = _noDueTasksAry[prio];
+            const unsigned int prio = _pActiveTask->prioClass;
 
             /* If there are more due tasks in the same class the next one will be made the
                active one by a cyclic move of the positions in the list. */
-            if(noTasks-- > 1)
+            if(_dueListAry[prio].pHead != _dueListAry[prio].pTail)
             {
-                unsigned int idxTask;
-
-                /* The list of due tasks in the active priority class is rolled by one task.
-                   The next due task will become active.
-                     Note: noTasks has been decremented before in the if. */
-/// @todo Try using void *__memcpy(void *, const void *, size_t);
-                for(idxTask=0; idxTask<noTasks; ++idxTask)
-                    _pDueTaskAryAry[prio][idxTask] = _pDueTaskAryAry[prio][idxTask+1];
-                _pDueTaskAryAry[prio][idxTask] = _pActiveTask;
+                /* The list of due tasks in the active priority class is rolled by one task:
+                   The active task is the head of the list and it is moved to the end. The
+                   next due task will become active. */
+                assert(_dueListAry[prio].pHead == _pActiveTask);
+                _dueListAry[prio].pHead = _pActiveTask->pNext;
+                _pActiveTask->pNext = NULL;
+                _dueListAry[prio].pTail->pNext = _pActiveTask;
+                _dueListAry[prio].pTail = _pActiveTask;
 
                 /* Force check for new active task - even if no suspended task should have been
                    resumed. */
@@ -552,6 +1183,143 @@ static bool onTimerTick(void)
 
 
 
+#if RTOS_TICKLESS_IDLE == RTOS_FEATURE_ON
+/**
+ * Restart the system timer PIT 3 with a period of given length. The next timeouts follow
+ * with the regular period of the system timer tick.
+ *   @param noCycles
+ * The time till the next timeout in cycles of the peripheral clock. Range is
+ * 1..0xffffffff.
+ *   @remark
+ * A write to LDVAL doesn't affect the running period of the timer. Disabling and enabling
+ * the timer loads the counter with the new value. The few clock cycles in between are lost;
+ * the phase of the system timer tick shifts by this amount.
+ */
+static void restartSystemTimer(uint32_t noCycles)
+{
+    PIT.TCTRL3.R = 0x2;
+    ihw_memoryBarrier();
+    PIT.LDVAL3.R = noCycles - 1u;
+    PIT.TCTRL3.R = 0x3;
+    ihw_memoryBarrier();
+
+    /* The value is loaded at the next timeout. */
+    PIT.LDVAL3.R = NO_CYCLES_PER_TICK - 1u;
+
+} /* End of restartSystemTimer */
+
+
+
+
+/**
+ * Clock the system time by a number of ticks, in which no timer elapses.
+ *   @param noTicks
+ * The number of ticks. The timer of the head of the list of running timers needs to be
+ * later.
+ */
+static inline void advanceSystemTime(unsigned int noTicks)
+{
+    _time += noTicks;
+    if(_pTimerList != NULL)
+    {
+        assert(_pTimerList->cntTimerDelta > noTicks);
+        _pTimerList->cntTimerDelta -= noTicks;
+    }
+} /* End of advanceSystemTime */
+
+
+
+
+/**
+ * Only the idle task is ready after a system timer tick: The ticks, in which no timer
+ * elapses, are skipped. The system timer is reprogrammed such that its next timeout is
+ * the tick of the first timer to elapse.\n
+ *   If a slack is configured then the timers, which elapse a few ticks later, are delayed
+ * to elapse in the same tick as the first one. The number of interrupts is reduced at the
+ * cost of a less accurate timing of the tasks.
+ *   @param cntCyclesAtEntry
+ * The value of the PIT counter at entry into the system timer interrupt. If the counter
+ * has been reloaded since, then the next tick has begun and no tick is skipped.
+ *   @remark
+ * The function is called from the system timer interrupt, shortly after the timeout of
+ * the PIT. The runtime of the interrupt needs to be less than a tick.
+ */
+static void startTicklessPeriod(uint32_t cntCyclesAtEntry)
+{
+    assert(_noTicksInPeriod == 1  &&  _dueListNotEmptyVec == 0);
+
+    unsigned int noTicks = MAX_NO_TICKS_IN_PERIOD;
+    task_t * const pHead = _pTimerList;
+    if(pHead != NULL  &&  pHead->cntTimerDelta < noTicks)
+    {
+        noTicks = pHead->cntTimerDelta;
+
+#if RTOS_TICKLESS_IDLE_SLACK > 0
+        /* The timers elapsing within the slack window are coalesced. They get a delta of
+           zero to the first timer and the delta of their successor doesn't change. */
+        unsigned int noTicksMax = noTicks + (RTOS_TICKLESS_IDLE_SLACK);
+        if(noTicksMax > MAX_NO_TICKS_IN_PERIOD)
+            noTicksMax = MAX_NO_TICKS_IN_PERIOD;
+        task_t *pT = pHead->pNextTimer;
+        while(pT != NULL  &&  noTicks + pT->cntTimerDelta <= noTicksMax)
+        {
+            noTicks += pT->cntTimerDelta;
+            pT->cntTimerDelta = 0;
+            pT = pT->pNextTimer;
+        }
+        pHead->cntTimerDelta = noTicks;
+#endif
+    }
+
+    /* The first of the ticks is already running. The counter counts down; a greater value
+       than at entry into the ISR means that the end of this tick is reached already. We
+       don't skip any tick then. */
+    ihw_memoryBarrier();
+    const uint32_t cntCycles = PIT.CVAL3.R;
+    if(noTicks > 1  &&  cntCycles <= cntCyclesAtEntry)
+    {
+        restartSystemTimer(cntCycles + 1u + (noTicks-1u)*NO_CYCLES_PER_TICK);
+        _noTicksInPeriod = noTicks;
+    }
+} /* End of startTicklessPeriod */
+
+
+
+
+/**
+ * A task becomes due while the system timer skips ticks. The system time is updated to
+ * the last passed tick and the system timer is reprogrammed to timeout at the next tick.
+ *   @remark
+ * The function is called from the kernel functions, which can make a task due, with all
+ * interrupts disabled.
+ */
+static void endTicklessPeriod(void)
+{
+    assert(_noTicksInPeriod > 1);
+
+    ihw_memoryBarrier();
+    if(PIT.TFLG3.B.TIF == 0)
+    {
+        /* The counter tells how many ticks are still ahead. */
+        const uint32_t cntCycles = PIT.CVAL3.R
+                     , noTicksLeft = cntCycles / NO_CYCLES_PER_TICK;
+        restartSystemTimer(cntCycles - noTicksLeft*NO_CYCLES_PER_TICK + 1u);
+        advanceSystemTime(_noTicksInPeriod - 1u - noTicksLeft);
+    }
+    else
+    {
+        /* All skipped ticks have passed and the interrupt is pending. It'll clock the
+           last one. The counter is already running with the regular period. */
+        advanceSystemTime(_noTicksInPeriod - 1u);
+    }
+    _noTicksInPeriod = 1;
+
+} /* End of endTicklessPeriod */
+#endif /* RTOS_TICKLESS_IDLE == RTOS_FEATURE_ON */
+
+
+
+
 
 
 /**
@@ -579,8 +1347,32 @@ static uint32_t isrSystemTimerTick(int_cmdContextSwitch_t *pCmdContextSwitch)
     assert(PIT.TFLG3.B.TIF == 0x1);
     PIT.TFLG3.B.TIF = 0x1;
 
+#if RTOS_TICKLESS_IDLE == RTOS_FEATURE_ON
+    /* The counter value is needed to recognize the end of the next tick, see
+       startTicklessPeriod(). */
+    ihw_memoryBarrier();
+    const uint32_t cntCyclesAtEntry = PIT.CVAL3.R;
+
+    /* If the timer has skipped ticks then these are clocked now. No timer elapses in
+       these ticks. The last one is clocked as usual. */
+    if(_noTicksInPeriod > 1)
+    {
+        advanceSystemTime(_noTicksInPeriod - 1u);
+        _noTicksInPeriod = 1;
+    }
+#endif
+
     /* Check for all suspended tasks if this change in time is an event for them. */
-    if(onTimerTick())
+    const bool isTaskSwitch = onTimerTick();
+
+#if RTOS_TICKLESS_IDLE == RTOS_FEATURE_ON
+    /* If only the idle task is ready then the next ticks are skipped until the first
+       timer elapses. */
+    if(_dueListNotEmptyVec == 0)
+        startTicklessPeriod(cntCyclesAtEntry);
+#endif
+
+    if(isTaskSwitch)
     {
         /* Yes, another task becomes active with this timer tick. Command the calling
            system call handler on return to switch to the other task. The vector of
@@ -705,7 +1497,7 @@ static void enableIRQTimerTick(void)
     _Static_assert( (RTOS_TICK) >= 1e-5  &&  (RTOS_TICK) <= 30.0
                   , "System clock period RTOS_TICK configured out of range"
                   );
-    PIT.LDVAL3.R = (uint32_t)((RTOS_TICK) * 120e6)-1; /* Interrupt rate configurable */
+    PIT.LDVAL3.R = NO_CYCLES_PER_TICK-1; /* Interrupt rate configurable */
 #else
     _Static_assert( (RTOS_TICK) == 1e-3  ||  (RTOS_TICK) == 1e-4
                   , "Test TEST_USE_IRREGULAR_SYS_CLOCK is hard-coded for a system clock"
@@ -760,13 +1552,16 @@ static void enableIRQTimerTick(void)
  *   @remark
  * This function and particularly passing the return codes via a global variable will
  * operate only if all interrupts are disabled.
+ *   @remark
+ * The function doesn't inspect all suspended tasks. The bit vectors of waiting tasks of
+ * the posted events tell, which tasks are affected. The cost depends on the number of
+ * receiving tasks.
  */
 static bool sendEvent(uint32_t postedEventVec)
 {
-    bool activeTaskMayChange = false;
-
-    /* The timer events must not be set manually. */
-    assert((postedEventVec & MASK_EVT_IS_TIMER) == 0);
+    /* The timer events must not be set manually. The queue events are posted only by
+       the system calls of the queues, which transfer the messages. */
+    assert((postedEventVec & (MASK_EVT_IS_TIMER | MASK_EVT_IS_QUEUE)) == 0);
 
     /* We keep track of all semaphores and mutexes, which have to be posted (released)
        exactly once - to the first task, which is waiting for them. This task is done,
@@ -786,85 +1581,118 @@ static bool sendEvent(uint32_t postedEventVec)
     postedEventVec &= ~(MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE);
 #endif
 
-    /* Post ordinary events to all suspended tasks which are waiting for it.
-         Pass mutexes and semaphores to a single task each, those task, which is of highest
-       priority and waits the longest for it. This loop is the reason, why we need to have
-       the list of suspended tasks always sorted, when at least one semaphore or mutex is in
-       use. */
-    unsigned int idxSuspTask = 0;
-    while(idxSuspTask<_noSuspendedTasks)
-    {
-        task_t * const pT = _pSuspendedTaskAry[idxSuspTask];
-
-        /* Remember the received events before (possibly) getting some more by this
-           sendEvent: Only if this set changes it is necessary to check for a state
-           transition of the task. */
-        const uint32_t postedEventVecBefore = pT->postedEventVec;
+    /* All tasks, which receive at least one event, are collected in a bit vector. */
+    uint32_t receivingTaskVec[NO_WORDS_TASK_VEC];
+    unsigned int idxWord;
+    for(idxWord=0; idxWord<NO_WORDS_TASK_VEC; ++idxWord)
+        receivingTaskVec[idxWord] = 0;
 
 #if RTOS_USE_MUTEX == RTOS_FEATURE_ON
-        /* Mutexes are Boolean and can't be posted twice to a task. This is easily possible
-           but an application error. This assertion fires if the application doesn't
-           properly keep track of who owns which mutex. */
-        assert((pT->postedEventVec & dbg_allMutexesToReleaseVec) == 0);
-
-        /* The vector of all events this task will receive. */
-        uint32_t gotEvtVec = (postedEventVec | mutexToReleaseVec) & pT->eventMask;
-
-        /* Collect the events in the task object. */
-        pT->postedEventVec |= gotEvtVec;
-
-        /* Subtract the given mutexes from the vector of all, which are to release in this
-           call. It doesn't matter that the mask also contains ordinary events - all these
-           bits can do is to reset already reset bits. */
-        mutexToReleaseVec &= ~gotEvtVec;
-#else
-        pT->postedEventVec |= (postedEventVec & pT->eventMask);
-
-#endif /* RTOS_USE_MUTEX == RTOS_FEATURE_ON */
+# ifdef DEBUG
+    /* Mutexes are Boolean and can't be posted twice to a task. This is easily possible but
+       an application error. This assertion fires if the application doesn't properly keep
+       track of who owns which mutex. Note, this check is expensive, it visits all tasks. */
+    {
+        unsigned int idxTask;
+        for(idxTask=0; idxTask<RTOS_NO_TASKS; ++idxTask)
+            assert((_taskAry[idxTask].postedEventVec & dbg_allMutexesToReleaseVec) == 0);
+    }
+# endif
+#endif
+#if RTOS_USE_MUTEX == RTOS_FEATURE_ON  ||  RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
+    /* Pass mutexes and semaphores to a single task each, those task, which is of highest
+       priority and waits the longest for it. */
+    uint32_t syncObjToReleaseVec = 0;
+# if RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    syncObjToReleaseVec |= mutexToReleaseVec;
+# endif
+# if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
+    syncObjToReleaseVec |= semaphoreToReleaseVec;
+# endif
+    while(syncObjToReleaseVec != 0)
+    {
+        const unsigned int idxEvt = (unsigned int)__builtin_ctz(syncObjToReleaseVec);
+        const uint32_t maskEvt = 1u << idxEvt;
+        syncObjToReleaseVec &= ~maskEvt;
 
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
-        /* Now pass all released semaphores to tasks waiting for them. This can't be done
-           all at once as semaphores are not simply a bit. We need a second loop to do so. */
-        uint32_t semMask = 0x01;
-        while(semaphoreToReleaseVec != 0  &&  (semMask & MASK_EVT_IS_SEMAPHORE) != 0)
+        task_t * const pT = getFirstWaiter(idxEvt);
+        if(pT != NULL)
         {
-            /* Check if this task is waiting for this semaphore but didn't get it yet (i.e.
-               in an earlier call of this routine). */
-            if((semaphoreToReleaseVec & semMask & pT->eventMask & ~pT->postedEventVec) != 0)
-            {
-                /* The semaphore release operation is handled by passing the semaphore to
-                   the task. */
-                pT->postedEventVec    |= semMask;
-                semaphoreToReleaseVec &= ~semMask;
-            }
+            /* The release operation is handled by passing the mutex or semaphore to the
+               task. The task doesn't wait for it any longer. */
+            pT->postedEventVec |= maskEvt;
+            unregisterWaiter(pT, maskEvt);
+# if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+            if((maskEvt & MASK_EVT_IS_MUTEX) != 0)
+                changeMutexOwner(idxEvt, pT);
+# endif
 
-            /* Shift mask one Bit to the left to test next semaphore in next cycle. */
-            semMask <<= 1;
+            const unsigned int idxTask = (unsigned int)(pT - _taskAry);
+            receivingTaskVec[idxTask/32u] |= 1u << (idxTask%32u);
+
+            /* Subtract the given mutex or semaphore from the vectors of all, which are to
+               release in this call. */
+# if RTOS_USE_MUTEX == RTOS_FEATURE_ON
+            mutexToReleaseVec &= ~maskEvt;
+# endif
+# if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
+            semaphoreToReleaseVec &= ~maskEvt;
+# endif
         }
-#endif
+    } /* End while(All released mutexes and semaphores) */
+#endif /* RTOS_USE_MUTEX == RTOS_FEATURE_ON  ||  RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON */
 
-        /* Check if this suspended task becomes due because of an event, which was posted
-           to it. */
-        if(postedEventVecBefore != pT->postedEventVec  && checkTaskForActivation(idxSuspTask))
-        {
-            /* The task becomes due. */
-            activeTaskMayChange = true;
+    /* Ordinary events are broadcasted to all tasks waiting for them. */
+    uint32_t evtVec = postedEventVec;
+    while(evtVec != 0)
+    {
+        const unsigned int idxEvt = (unsigned int)__builtin_ctz(evtVec);
+        evtVec &= evtVec - 1u;
+        for(idxWord=0; idxWord<NO_WORDS_TASK_VEC; ++idxWord)
+            receivingTaskVec[idxWord] |= _waitingTaskVecAry[idxEvt][idxWord];
+    }
 
-            /* Check next suspended task, which is in this case found in the array
-               element with same index: The task which became due has been removed into the
-               due list of its priority class. */
-        }
-        else
+    /* Deliver the ordinary events and check the receiving tasks for resume. The resumed
+       tasks are collected; they become due in the order of their suspension, which is the
+       same order as if all suspended tasks had been inspected in order of their
+       suspension. The array has at least one element; an application without tasks
+       would otherwise declare a zero length array. */
+    task_t *pResumedTaskAry[RTOS_NO_TASKS > 0? RTOS_NO_TASKS: 1];
+    unsigned int noResumedTasks = 0;
+    for(idxWord=0; idxWord<NO_WORDS_TASK_VEC; ++idxWord)
+    {
+        uint32_t taskVec = receivingTaskVec[idxWord];
+        while(taskVec != 0)
         {
-            /* The task remains suspended. */
+            task_t * const pT = &_taskAry[32u*idxWord + (unsigned int)__builtin_ctz(taskVec)];
+            taskVec &= taskVec - 1u;
 
-            /* Check next suspended task, which is in this case found in the next array
-               element. */
-            ++ idxSuspTask;
+            /* Collect the events in the task object. The task surely received at least one
+               event it had still been waiting for; its state may change. */
+            const uint32_t gotEvtVec = postedEventVec & pT->eventMask;
+            pT->postedEventVec |= gotEvtVec;
+            unregisterWaiter(pT, gotEvtVec);
 
-        } /* End if(Did this suspended task become due?) */
+            if(isResumeConditionFulfilled(pT))
+            {
+                /* Sorted insertion. The number of tasks resumed by a single call is
+                   normally very low. */
+                unsigned int idxPos = noResumedTasks++;
+                while(idxPos > 0
+                      &&  pResumedTaskAry[idxPos-1]->suspendSeqNo > pT->suspendSeqNo
+                     )
+                {
+                    pResumedTaskAry[idxPos] = pResumedTaskAry[idxPos-1];
+                    -- idxPos;
+                }
+                pResumedTaskAry[idxPos] = pT;
+            }
+        }
+    } /* End for(All receiving tasks) */
 
-    } /* End while(All suspended tasks) */
+    unsigned int u;
+    for(u=0; u<noResumedTasks; ++u)
+        makeTaskDue(pResumedTaskAry[u]);
 
 #if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
     /* The remaining semaphores (more precise: semaphore counter values) are accumulated in
@@ -899,15 +1727,31 @@ static bool sendEvent(uint32_t postedEventVec)
     assert((_mutexVec & dbg_allMutexesToReleaseVec) == 0);
     _mutexVec |= mutexToReleaseVec;
 #endif /* RTOS_USE_MUTEX == RTOS_FEATURE_ON */
+#if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+    /* The released mutexes don't have an owner any more. */
+    while(mutexToReleaseVec != 0)
+    {
+        const unsigned int idxEvt = (unsigned int)__builtin_ctz(mutexToReleaseVec);
+        mutexToReleaseVec &= mutexToReleaseVec - 1u;
+        changeMutexOwner(idxEvt, /* pNewOwner */ NULL);
+    }
+#endif
 
     /* Check if another task becomes active because of the posted events.
-         activeTaskMayChange: We do the search for the new active task only if at least one
-       suspended task was resumed.
+         We do the search for the new active task only if at least one suspended task was
+       resumed.
          The function has side effects: If there's a task which was suspended before and
        which is resumed because of an event and which is of higher priority than the one
        being active so far then the references to the old and newly active task are written
-       into the global variables _pSuspendedTask and _pActiveTask. */
-    return activeTaskMayChange && lookForActiveTask();
+       into the global variables _pSuspendedTask and _pActiveTask.
+         With priority inheritance, a task switch can be due to the changed priority of a
+       task, which has passed or received a mutex, too. */
+#if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+    return (noResumedTasks > 0  ||  getHighestPrioDueTask() != _pActiveTask)
+           &&  lookForActiveTask();
+#else
+    return noResumedTasks > 0  &&  lookForActiveTask();
+#endif
 
 } /* End of sendEvent */
 
@@ -1066,6 +1910,10 @@ static uint32_t isrUser01(int_cmdContextSwitch_t *pCmdContextSwitch)
  * See function \a rtos_waitForEvent for details.
  *   @param timeout
  * See function \a rtos_waitForEvent for details.
+ *   @return
+ * Get the number of system timer ticks from now till the timer event, which is part of the
+ * resume condition. The value is meant for startTimer(). The function returns 0 if \a
+ * eventMask doesn't contain a timer event.
  *   @see
  * void rtos_waitForEvent(uint32_t, bool, unsigned int)
  *   @remark
@@ -1073,11 +1921,11 @@ static uint32_t isrUser01(int_cmdContextSwitch_t *pCmdContextSwitch)
  * alternative.
  */
 
-static inline void storeResumeCondition( task_t * const pT
-                                       , uint32_t eventMask
-                                       , bool all
-                                       , unsigned int timeout
-                                       )
+static inline unsigned int storeResumeCondition( task_t * const pT
+                                               , uint32_t eventMask
+                                               , bool all
+                                               , unsigned int timeout
+                                               )
 {
     /* Check event condition: It must not be empty. The two timers can't be used at the
        same time (which is a rather harmless application design error) and at least one
@@ -1093,9 +1941,15 @@ static inline void storeResumeCondition( task_t * const pT
            &&  (!all || (eventMask & ~MASK_EVT_IS_TIMER) != 0)
           );
 
+    pT->eventMask = eventMask;
+    pT->waitForAnyEvent = !all;
+
+    /* The task is registered as waiter for all events it didn't receive yet. (Mutexes and
+       semaphores may have been acquired already on entry into the suspend command.) */
+    registerWaiter(pT, eventMask & ~pT->postedEventVec);
+
     /* The timing parameter may refer to different timers. Depending on the event mask we
-       either load the one or the other timer. Default is the less expensive delay
-       counter. */
+       either compute the ticks till the one or the other timer event. */
     if((eventMask & RTOS_EVT_ABSOLUTE_TIMER) != 0)
     {
         /* This suspend command wants a reactivation at a certain time. The new time is
@@ -1112,24 +1966,26 @@ static inline void storeResumeCondition( task_t * const pT
                Let the task become due in the very next timer tick. */
             pT->timeDueAt = _time + 1;
         }
+
+        /* The difference is in the range 1..max_value(unsigned int)/2. */
+        return pT->timeDueAt - _time;
     }
-    else
+    else if((eventMask & RTOS_EVT_DELAY_TIMER) != 0)
     {
-        /* The timeout counter is reloaded. We could do this conditionally if the bit is
-           set, but in all normal use cases it'll and if not it doesn't harm. We will
-           just decrement the delay counter in onTimerTick once but not set the event.
-             ++ timeout: The call of the suspend function is in no way synchronized with the
+        /* ++ timeout: The call of the suspend function is in no way synchronized with the
            system clock. We define the delay to be a minimum and implement the resolution
            caused uncertainty as an additional delay. */
         if(timeout+1 != 0)
             ++ timeout;
-        pT->cntDelay = timeout;
+        return timeout;
+    }
+    else
+    {
+        /* No timeout condition, the task doesn't need a timer. */
+        return 0;
 
     } /* if(Which timer is addressed for the timeout condition?) */
 
-    pT->eventMask = eventMask;
-    pT->waitForAnyEvent = !all;
-
 } /* End of storeResumeCondition */
 
 
@@ -1164,6 +2020,18 @@ static inline bool acquireFreeSyncObjs(uint32_t eventMask, bool all)
        don't need to be masked. They may reset some anyway reset don't-care bits in
        _mutexVec. */
     _mutexVec &= ~eventMask;
+
+# if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+    /* The calling task becomes the owner of the locked mutexes. Nobody waits for a free
+       mutex; the priorities don't change. */
+    uint32_t lockedMutexVec = _pActiveTask->postedEventVec & MASK_EVT_IS_MUTEX;
+    while(lockedMutexVec != 0)
+    {
+        const unsigned int idxEvt = (unsigned int)__builtin_ctz(lockedMutexVec);
+        lockedMutexVec &= lockedMutexVec - 1u;
+        _mutexOwnerAry[idxEvt - RTOS_NO_SEMAPHORE_EVENTS] = _pActiveTask;
+    }
+# endif
 #endif
 
 #if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
@@ -1245,69 +2113,88 @@ static void waitForEvent(uint32_t eventMask, bool all, unsigned int timeout)
        tolerance, and so do we here. */
     assert(_pActiveTask != _pIdleTask);
 
+    /* A queue event in the mask would resume the task without transferring a message. */
+    assert((eventMask & MASK_EVT_IS_QUEUE) == 0);
+
 #if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
     if(acquireFreeSyncObjs(eventMask, all))
         return false;
 #endif
 
-    signed int idxPrio;
-    signed int idxTask;
+    /* The calling task is suspended and another one becomes active. */
+    suspendActiveTask(eventMask, all, timeout);
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    return true;
+#endif
+} /* End of waitForEvent */
+
+
+
+
+/**
+ * The active task is suspended: It is taken out of the list of due tasks, its resume
+ * condition is stored and the task to be activated next is determined.
+ *   @param eventMask
+ * See function \a rtos_waitForEvent for details.
+ *   @param all
+ * See function \a rtos_waitForEvent for details.
+ *   @param timeout
+ * See function \a rtos_waitForEvent for details.
+ *   @remark
+ * The function reports the task switch in the global variables \a _pActiveTask and \a
+ * _pSuspendedTask. It will operate only if all interrupts are disabled.
+ */
+static void suspendActiveTask(uint32_t eventMask, bool all, unsigned int timeout)
+{
+    /* The idle task can't be suspended. */
+    assert(_pActiveTask != _pIdleTask);
 
-    /* Take the active task out of the list of due tasks. */
+    /* Take the active task out of the list of due tasks. It is the head of the list of its
+       priority class. */
     task_t * const pT = _pActiveTask;
-    unsigned int prio = pT->prioClass;
-    signed int noDueNow = (int)(-- _noDueTasksAry[prio]);
-    for(idxTask=0; idxTask<noDueNow; ++idxTask)
-        _pDueTaskAryAry[prio][idxTask] = _pDueTaskAryAry[prio][idxTask+1];
+    const unsigned int prio = pT->prioClass;
+    assert(_dueListAry[prio].pHead == pT);
+    _dueListAry[prio].pHead = pT->pNext;
+    if(_dueListAry[prio].pHead == NULL)
+    {
+        _dueListAry[prio].pTail = NULL;
+        _dueListNotEmptyVec &= ~(1u << prio);
+    }
 
     /* This suspend command wants a reactivation by a combination of events (which may
        include the timeout event). Save the resume condition in the task object. The
        operation is implemented as inline function to be able to reuse the code in the
-       task initialization routine. */
-    storeResumeCondition(pT, eventMask, all, timeout);
-
-    /* Put the task in the list of suspended tasks. If mutexes or semaphores are in use
-       this list is sorted with decreasing priority. */
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
-    /* < rather than <=: The now suspended task becomes the last one in its prio class. The
-       others of same priority are waiting longer and will receive a later posted event
-       with priority. */
-    signed int idxPos;
-    for(idxPos=0; idxPos<(int)_noSuspendedTasks; ++idxPos)
-        if(_pSuspendedTaskAry[idxPos]->prioClass < prio)
-            break;
-
-    /* Shift rest of the list one to the end. This loop requires a signed index. */
-    for(idxTask=(int)_noSuspendedTasks++ - 1; idxTask>=idxPos; --idxTask)
-        _pSuspendedTaskAry[idxTask+1] = _pSuspendedTaskAry[idxTask];
-
-    /* Insert the suspended task at the priority determined right position. */
-    _pSuspendedTaskAry[idxPos] = pT;
-#else
-    _pSuspendedTaskAry[_noSuspendedTasks++] = pT;
+       task initialization routine. A timeout condition starts the timer of the task. */
+    const unsigned int noTicksTillTimeout = storeResumeCondition(pT, eventMask, all, timeout);
+    if(noTicksTillTimeout != 0)
+        startTimer(pT, noTicksTillTimeout);
+
+#if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+    /* The owners of the mutexes, which the task is now waiting for, inherit its priority
+       if it is higher than their own. */
+    updateOwnersOfAwaitedMutexes(eventMask & ~pT->postedEventVec);
 #endif
 
+    /* The now suspended task becomes the last one in its prio class. The others of same
+       priority are waiting longer and will receive a later posted event with priority. */
+    pT->suspendSeqNo = _nextSuspendSeqNo++;
+
     /* Record which task suspends itself for the assembly code in the calling function
        which actually switches the context. */
     _pSuspendedTask = _pActiveTask;
 
     /* Look for the task we will return to. It's the first entry in the highest non-empty
-       priority class. The loop requires a signed index.
+       priority class.
          It's not guaranteed that there is any due task. Idle is the fallback. */
-    _pActiveTask = _pIdleTask;
-    for(idxPrio=RTOS_NO_PRIO_CLASSES-1; idxPrio>=0; --idxPrio)
-    {
-        if(_noDueTasksAry[idxPrio] > 0)
-        {
-            _pActiveTask = _pDueTaskAryAry[idxPrio][0];
-            break;
-        }
-    }
+    _pActiveTask = getHighestPrioDueTask();
 
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
-    return true;
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+    /* The suspended task is no longer due; this is a task switch in any case. */
+    accountTaskSwitch();
 #endif
-} /* End of waitForEvent */
+
+} /* End of suspendActiveTask */
 
 
 
@@ -1412,6 +2299,345 @@ uint32_t rtos_sc_waitForEvent( int_cmdContextSwitch_t *pCmdContextSwitch
 
 
 
+#if RTOS_USE_QUEUE == RTOS_FEATURE_ON
+/**
+ * Actual implementation of system call \a rtos_sendToQueue. The message is either handed
+ * over to the receiver, which waits the longest, or it is appended to the queue or the
+ * calling task is suspended until there's space in the queue.
+ *   @return
+ * The function returns \a true if another task becomes active. The task switch is
+ * reported in the global variables \a _pActiveTask and \a _pSuspendedTask.\n
+ *   The result of the system call for the calling task is placed in its \a postedEventVec.
+ * It is returned to the task when it continues.
+ *   @param idxQueue
+ * See system call \a rtos_sendToQueue.
+ *   @param pMsg
+ * See system call \a rtos_sendToQueue.
+ *   @param timeout
+ * See system call \a rtos_sendToQueue.
+ *   @remark
+ * This function will operate only if all interrupts are disabled.
+ */
+static bool sendToQueue(unsigned int idxQueue, const void *pMsg, unsigned int timeout)
+{
+    assert(idxQueue < RTOS_NO_QUEUE_EVENTS);
+    rtos_queue_t * const pQ = &rtos_queueAry[idxQueue];
+    const unsigned int idxEvt = RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + idxQueue;
+    const uint32_t maskEvt = RTOS_EVT_OF_QUEUE(idxQueue);
+
+    if(pQ->noMsgs < pQ->maxNoMsgs)
+    {
+        /* The message can be delivered, the caller is successful without suspension. */
+        _pActiveTask->postedEventVec = maskEvt;
+
+        /* Receivers can wait only while the queue is empty. */
+        task_t * const pReceiver = pQ->noMsgs == 0? getFirstWaiter(idxEvt): NULL;
+        if(pReceiver != NULL)
+        {
+            /* The message is directly copied into the buffer of the receiver, which waits
+               the longest. It doesn't pass the queue. The receiver is resumed and may
+               preempt the calling task. */
+            memcpy(pReceiver->pMsgBuffer, pMsg, pQ->sizeOfMsg);
+            pReceiver->postedEventVec |= maskEvt;
+            makeTaskDue(pReceiver);
+            return lookForActiveTask();
+        }
+        else
+        {
+            unsigned int idxWrite = pQ->idxRead + pQ->noMsgs;
+            if(idxWrite >= pQ->maxNoMsgs)
+                idxWrite -= pQ->maxNoMsgs;
+            memcpy(&pQ->pBuffer[idxWrite*pQ->sizeOfMsg], pMsg, pQ->sizeOfMsg);
+            ++ pQ->noMsgs;
+            return false;
+        }
+    }
+    else if(timeout == 0)
+    {
+        /* The queue is full and the caller doesn't want to wait. The result is the empty
+           event vector. */
+        return false;
+    }
+    else
+    {
+        /* The queue is full. The calling task waits for a receiver, which takes its
+           message from the task object into the queue. The message is not modified, the
+           const qualifier is lost only by storing it in the common buffer pointer. */
+        _pActiveTask->pMsgBuffer = (void*)pMsg;
+        if(timeout == RTOS_QUEUE_WAIT_FOREVER)
+            suspendActiveTask(maskEvt, /* all */ false, /* timeout */ 0);
+        else
+            suspendActiveTask(maskEvt | RTOS_EVT_DELAY_TIMER, /* all */ false, timeout);
+        return true;
+    }
+} /* End of sendToQueue */
+
+
+
+
+/**
+ * Actual implementation of system call \a rtos_receiveFromQueue. The oldest message is
+ * taken from the queue and the space is filled with the message of the sender, which waits
+ * the longest. If the queue is empty, the calling task is suspended until a message is
+ * sent.
+ *   @return
+ * The function returns \a true if another task becomes active. The task switch is
+ * reported in the global variables \a _pActiveTask and \a _pSuspendedTask.\n
+ *   The result of the system call for the calling task is placed in its \a postedEventVec.
+ * It is returned to the task when it continues.
+ *   @param idxQueue
+ * See system call \a rtos_receiveFromQueue.
+ *   @param pMsg
+ * See system call \a rtos_receiveFromQueue.
+ *   @param timeout
+ * See system call \a rtos_receiveFromQueue.
+ *   @remark
+ * This function will operate only if all interrupts are disabled.
+ */
+static bool receiveFromQueue(unsigned int idxQueue, void *pMsg, unsigned int timeout)
+{
+    assert(idxQueue < RTOS_NO_QUEUE_EVENTS);
+    rtos_queue_t * const pQ = &rtos_queueAry[idxQueue];
+    const unsigned int idxEvt = RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + idxQueue;
+    const uint32_t maskEvt = RTOS_EVT_OF_QUEUE(idxQueue);
+
+    if(pQ->noMsgs > 0)
+    {
+        /* A message is available, the caller is successful without suspension. */
+        _pActiveTask->postedEventVec = maskEvt;
+        uint8_t * const pSlot = &pQ->pBuffer[pQ->idxRead*pQ->sizeOfMsg];
+        memcpy(pMsg, pSlot, pQ->sizeOfMsg);
+        if(++pQ->idxRead == pQ->maxNoMsgs)
+            pQ->idxRead = 0;
+
+        /* Senders can wait only while the queue is full. */
+        task_t * const pSender = pQ->noMsgs == pQ->maxNoMsgs? getFirstWaiter(idxEvt): NULL;
+        if(pSender != NULL)
+        {
+            /* In a full ring buffer, the slot of the oldest message is the slot of the
+               next message. The message of the sender, which waits the longest, is copied
+               into the queue, which stays full. The sender is resumed and may preempt the
+               calling task. */
+            memcpy(pSlot, pSender->pMsgBuffer, pQ->sizeOfMsg);
+            pSender->postedEventVec |= maskEvt;
+            makeTaskDue(pSender);
+            return lookForActiveTask();
+        }
+        else
+        {
+            -- pQ->noMsgs;
+            return false;
+        }
+    }
+    else if(timeout == 0)
+    {
+        /* The queue is empty and the caller doesn't want to wait. The result is the empty
+           event vector. */
+        return false;
+    }
+    else
+    {
+        /* The queue is empty. The calling task waits for a sender, which copies its
+           message directly into the buffer of the task. */
+        _pActiveTask->pMsgBuffer = pMsg;
+        if(timeout == RTOS_QUEUE_WAIT_FOREVER)
+            suspendActiveTask(maskEvt, /* all */ false, /* timeout */ 0);
+        else
+            suspendActiveTask(maskEvt | RTOS_EVT_DELAY_TIMER, /* all */ false, timeout);
+        return true;
+    }
+} /* End of receiveFromQueue */
+
+
+
+
+/**
+ * Send a message to a queue. See macro #rtos_sendToQueue for details.
+ *   @return
+ * The function returns \a int_rcIsr_switchContext if another task becomes active. It
+ * states the task switch in \a pCmdContextSwitch.
+ *   @param pCmdContextSwitch
+ * The context switch command for the system call handler. The result value of the system
+ * call is returned to the calling task or to the activated task in field \a
+ * signalToResumedContext.
+ *   @param idxQueue
+ * See macro #rtos_sendToQueue.
+ *   @param pMsg
+ * See macro #rtos_sendToQueue.
+ *   @param timeout
+ * See macro #rtos_sendToQueue.
+ *   @remark
+ * This is the implementation of system call index #SC_IDX_SYS_CALL_SEND_TO_QUEUE. You
+ * must never invoke the function directly; ISRs use rtos_osSendToQueueFromIsr().
+ */
+uint32_t rtos_sc_sendToQueue( int_cmdContextSwitch_t *pCmdContextSwitch
+                            , unsigned int idxQueue
+                            , const void *pMsg
+                            , unsigned int timeout
+                            )
+{
+    const bool isTaskSwitch = sendToQueue(idxQueue, pMsg, timeout);
+
+    /* The result is returned to the task, which continues. If the calling task is
+       preempted by a receiver then its result is kept in its postedEventVec until it
+       becomes active again. */
+    pCmdContextSwitch->signalToResumedContext = _pActiveTask->postedEventVec;
+    _pActiveTask->postedEventVec = 0;
+    if(isTaskSwitch)
+    {
+        pCmdContextSwitch->pSuspendedContextSaveDesc = &_pSuspendedTask->contextSaveDesc;
+        pCmdContextSwitch->pResumedContextSaveDesc = &_pActiveTask->contextSaveDesc;
+        return int_rcIsr_switchContext;
+    }
+    else
+        return int_rcIsr_doNotSwitchContext;
+
+} /* End of rtos_sc_sendToQueue */
+
+
+
+
+/**
+ * Receive a message from a queue. See macro #rtos_receiveFromQueue for details.
+ *   @return
+ * The function returns \a int_rcIsr_switchContext if another task becomes active. It
+ * states the task switch in \a pCmdContextSwitch.
+ *   @param pCmdContextSwitch
+ * The context switch command for the system call handler. The result value of the system
+ * call is returned to the calling task or to the activated task in field \a
+ * signalToResumedContext.
+ *   @param idxQueue
+ * See macro #rtos_receiveFromQueue.
+ *   @param pMsg
+ * See macro #rtos_receiveFromQueue.
+ *   @param timeout
+ * See macro #rtos_receiveFromQueue.
+ *   @remark
+ * This is the implementation of system call index #SC_IDX_SYS_CALL_RECEIVE_FROM_QUEUE.
+ * You must never invoke the function directly; ISRs use rtos_osReceiveFromQueueFromIsr().
+ */
+uint32_t rtos_sc_receiveFromQueue( int_cmdContextSwitch_t *pCmdContextSwitch
+                                 , unsigned int idxQueue
+                                 , void *pMsg
+                                 , unsigned int timeout
+                                 )
+{
+    const bool isTaskSwitch = receiveFromQueue(idxQueue, pMsg, timeout);
+
+    /* The result is returned to the task, which continues. If the calling task is
+       preempted by a sender then its result is kept in its postedEventVec until it
+       becomes active again. */
+    pCmdContextSwitch->signalToResumedContext = _pActiveTask->postedEventVec;
+    _pActiveTask->postedEventVec = 0;
+    if(isTaskSwitch)
+    {
+        pCmdContextSwitch->pSuspendedContextSaveDesc = &_pSuspendedTask->contextSaveDesc;
+        pCmdContextSwitch->pResumedContextSaveDesc = &_pActiveTask->contextSaveDesc;
+        return int_rcIsr_switchContext;
+    }
+    else
+        return int_rcIsr_doNotSwitchContext;
+
+} /* End of rtos_sc_receiveFromQueue */
+
+
+
+
+/**
+ * Send a message to a queue from a kernel relevant ISR. An ISR can't wait; if the queue
+ * is full then the message is not sent. A receiving task, which waits for the message, is
+ * resumed and it may preempt the interrupted task.
+ *   @return
+ * The function returns \a int_rcIsr_switchContext if a receiver becomes active. It
+ * states the task switch in \a pCmdContextSwitch. The ISR returns the value to the
+ * kernel.
+ *   @param pCmdContextSwitch
+ * The context switch command of the ISR. After return, field \a signalToResumedContext
+ * holds RTOS_EVT_OF_QUEUE(\a idxQueue) if the message has been sent and zero if the queue
+ * was full. A task switch happens only if the message has been sent.
+ *   @param idxQueue
+ * See macro #rtos_sendToQueue.
+ *   @param pMsg
+ * See macro #rtos_sendToQueue.
+ *   @remark
+ * The function must be called from kernel relevant ISRs only. Tasks use macro
+ * #rtos_sendToQueue.
+ */
+uint32_t rtos_osSendToQueueFromIsr( int_cmdContextSwitch_t *pCmdContextSwitch
+                                  , unsigned int idxQueue
+                                  , const void *pMsg
+                                  )
+{
+    /* The interrupted task is not in a system call. sendToQueue() places the result in its
+       postedEventVec, which is otherwise unused while the task is running. A zero timeout
+       never suspends the interrupted task. */
+    task_t * const pInterruptedTask = _pActiveTask;
+    const bool isTaskSwitch = sendToQueue(idxQueue, pMsg, /* timeout */ 0);
+
+    /* The result is signalled to the ISR. If the receiver is resumed then it is the result
+       of its system call, too, which is the same event. */
+    pCmdContextSwitch->signalToResumedContext = _pActiveTask->postedEventVec;
+    _pActiveTask->postedEventVec = 0;
+    pInterruptedTask->postedEventVec = 0;
+    if(isTaskSwitch)
+    {
+        pCmdContextSwitch->pSuspendedContextSaveDesc = &_pSuspendedTask->contextSaveDesc;
+        pCmdContextSwitch->pResumedContextSaveDesc = &_pActiveTask->contextSaveDesc;
+        return int_rcIsr_switchContext;
+    }
+    else
+        return int_rcIsr_doNotSwitchContext;
+
+} /* End of rtos_osSendToQueueFromIsr */
+
+
+
+
+/**
+ * Receive a message from a queue from a kernel relevant ISR. An ISR can't wait; if the
+ * queue is empty then no message is received. A sending task, which waits for space in
+ * the queue, is resumed and it may preempt the interrupted task.
+ *   @return
+ * The function returns \a int_rcIsr_switchContext if a sender becomes active. It states
+ * the task switch in \a pCmdContextSwitch. The ISR returns the value to the kernel.
+ *   @param pCmdContextSwitch
+ * The context switch command of the ISR. After return, field \a signalToResumedContext
+ * holds RTOS_EVT_OF_QUEUE(\a idxQueue) if a message has been received and zero if the
+ * queue was empty. A task switch happens only if a message has been received.
+ *   @param idxQueue
+ * See macro #rtos_receiveFromQueue.
+ *   @param pMsg
+ * See macro #rtos_receiveFromQueue.
+ *   @remark
+ * The function must be called from kernel relevant ISRs only. Tasks use macro
+ * #rtos_receiveFromQueue.
+ */
+uint32_t rtos_osReceiveFromQueueFromIsr( int_cmdContextSwitch_t *pCmdContextSwitch
+                                       , unsigned int idxQueue
+                                       , void *pMsg
+                                       )
+{
+    /* See rtos_osSendToQueueFromIsr() for the handling of the result. */
+    task_t * const pInterruptedTask = _pActiveTask;
+    const bool isTaskSwitch = receiveFromQueue(idxQueue, pMsg, /* timeout */ 0);
+
+    pCmdContextSwitch->signalToResumedContext = _pActiveTask->postedEventVec;
+    _pActiveTask->postedEventVec = 0;
+    pInterruptedTask->postedEventVec = 0;
+    if(isTaskSwitch)
+    {
+        pCmdContextSwitch->pSuspendedContextSaveDesc = &_pSuspendedTask->contextSaveDesc;
+        pCmdContextSwitch->pResumedContextSaveDesc = &_pActiveTask->contextSaveDesc;
+        return int_rcIsr_switchContext;
+    }
+    else
+        return int_rcIsr_doNotSwitchContext;
+
+} /* End of rtos_osReceiveFromQueueFromIsr */
+#endif /* RTOS_USE_QUEUE == RTOS_FEATURE_ON */
+
+
+
 
 
 /**
@@ -1577,6 +2803,65 @@ unsigned int rtos_getStackReserve(unsigned int idxTask)
 
 
 
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+/**
+ * Get the CPU time measurement of a task. The kernel reads the time base of the CPU at
+ * each task switch; the execution time of a task is the sum of the time spans between
+ * its activation and the next task switch. Interrupts, which don't switch the task, are
+ * charged to the interrupted task. Hence, the sum of the CPU times of all tasks,
+ * including the idle task, is the world time.\n
+ *   A useful measure of the CPU load of a task is the CPU time divided by the world time
+ * elapsed since the previous call with \a doReset set to true.\n
+ *   The function may be called from a task or from the idle task.
+ *   @param idxTask
+ * The index of the task the CPU time of which is to be returned. The index is the
+ * same as used when initializing the tasks, see rtos_initializeTask(). To query the CPU
+ * time of the idle task pass the pseudo task index #RTOS_NO_TASKS.
+ *   @param pTaskCpuTime
+ * The measurement results are returned in * \a pTaskCpuTime. If \a idxTask designates
+ * the calling task then its current activation is included up to now.
+ *   @param doReset
+ * Boolean flag, which tells whether to restart the measurement from now on.
+ *   @remark
+ * The data is read in a critical section; the function globally enables the interrupts
+ * finally. Therefore this call may destroy a surrounding critical section.
+ */
+void rtos_getTaskCpuTime( unsigned int idxTask
+                        , rtos_taskCpuTime_t * const pTaskCpuTime
+                        , bool doReset
+                        )
+{
+    assert(idxTask < RTOS_NO_TASKS+1);
+
+    task_t * const pT = &_taskAry[idxTask];
+    rtos_enterCriticalSection();
+    {
+        /* The active task hasn't been charged for its current activation yet. */
+        const uint64_t tiCpuActive = pT == _pActiveTask
+                                     ? ihw_getTimeBase() - _tiLastTaskSwitch
+                                     : 0;
+        pTaskCpuTime->tiCpu = pT->tiCpu + tiCpuActive;
+        pTaskCpuTime->noActivations = pT->noActivations;
+        pTaskCpuTime->tiMaxLatency = pT->tiMaxLatency;
+
+        if(doReset)
+        {
+            /* The time of the current activation, which has already been reported, is
+               deducted in advance; modulo arithmetics makes the sum right at the next task
+               switch. */
+            pT->tiCpu = 0u - tiCpuActive;
+            pT->noActivations = 0;
+            pT->tiMaxLatency = 0;
+        }
+    }
+    rtos_leaveCriticalSection();
+
+} /* End of rtos_getTaskCpuTime */
+#endif
+
+
+
+
 /**
  * Initialize the contents of a single task object.\n
  *   This routine needs to be called from within setup() once for each task. The number of
@@ -1682,19 +2967,44 @@ void rtos_initializeTask( unsigned int idxTask
 
     /* To which priority class does the task belong? */
     pT->prioClass = prioClass;
+#if RTOS_USE_PRIO_INHERITANCE == RTOS_FEATURE_ON
+    pT->basePrioClass = prioClass;
+#endif
 
     /* Set the start condition. */
     assert(startEventMask != 0);
 
-    /* Start condition "wait for sync object" is not implemented. */
-#if RTOS_USE_MUTEX == RTOS_FEATURE_ON  ||  RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
-    assert((startEventMask & (MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE)) == 0);
+    /* Start condition "wait for sync object" or "wait for message" is not implemented. */
+#if RTOS_USE_MUTEX == RTOS_FEATURE_ON  ||  RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  \
+    ||  RTOS_USE_QUEUE == RTOS_FEATURE_ON
+    assert((startEventMask & (MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE | MASK_EVT_IS_QUEUE))
+           == 0
+          );
 #endif
 
-    pT->cntDelay = 0;
     pT->timeDueAt = 0;
     pT->cntOverrun = 0;
-    storeResumeCondition(pT, startEventMask, startByAllEvents, startTimeout);
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+    pT->tiCpu = 0;
+    pT->tiBecameDue = 0;
+    pT->noActivations = 0;
+    pT->tiMaxLatency = 0;
+#endif
+#if INT_USE_LAZY_SPE_SAVE == 1
+    /* By default, a task doesn't use the SPE. See rtos_setTaskSpeContextSaveArea(). */
+    pT->pSpeContextSaveArea = NULL;
+#endif
+
+    /* The timer of the task can't be started yet; the list of running timers is built up
+       in rtos_initRTOS() in the order of task indexes. Until then, the field of the timer
+       holds the number of ticks till the start timeout. */
+    pT->pNextTimer = NULL;
+    pT->ppLinkToThisTimer = NULL;
+    pT->cntTimerDelta = storeResumeCondition( pT
+                                            , startEventMask
+                                            , startByAllEvents
+                                            , startTimeout
+                                            );
 
 #if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
     /* The maximum execution time in round robin mode. */
@@ -1706,6 +3016,41 @@ void rtos_initializeTask( unsigned int idxTask
 
 
 
+#if INT_USE_LAZY_SPE_SAVE == 1
+/**
+ * Permit a task the use of the SIMD instructions of the SPE. The kernelBuilder saves the
+ * SPE registers lazily: A task switch doesn't touch them but disables the SPE. The SPE
+ * registers are exchanged only if a task, which has a save area, executes a SIMD
+ * instruction and if another task has used the SPE meanwhile. Tasks without save area
+ * must not use SIMD instructions.\n
+ *   The function needs to be called from setup() after rtos_initializeTask() has been
+ * called for the same task.
+ *   @param idxTask
+ * The index of the task, which may use the SPE. The index is the same as used when
+ * initializing the task, see rtos_initializeTask(). The idle task can't use the SPE.
+ *   @param pSpeContextSaveArea
+ * The save area for the SPE registers of the task. The object needs to be statically
+ * allocated; it is accessed throughout the lifetime of the task and even thereafter.
+ *   @remark
+ * Note, the application code, which makes use of the SPE, needs to be compiled with
+ * option -mspe. Only the source files of the SPE using tasks should be compiled with this
+ * option; the compiler may emit SPE instructions anywhere in such a file.
+ */
+void rtos_setTaskSpeContextSaveArea( unsigned int idxTask
+                                   , int_speContextSaveArea_t * const pSpeContextSaveArea
+                                   )
+{
+    assert(idxTask < RTOS_NO_TASKS  &&  pSpeContextSaveArea != NULL
+           &&  ((uint32_t)pSpeContextSaveArea & 0x7) == 0
+          );
+    _taskAry[idxTask].pSpeContextSaveArea = pSpeContextSaveArea;
+
+} /* End of rtos_setTaskSpeContextSaveArea */
+#endif
+
+
+
+
 /**
  * The e200z4 port offers a more open and flexible way to deal with kernel interrupts.
  * These interrupts must not be initialized prior to the initialization of the kernel;
@@ -1825,6 +3170,9 @@ _Noreturn void rtos_initRTOS(void)
                         , /* fctEntryIntoContext */(int_fctEntryIntoContext_t)pT->taskFunction
                         , /* privilegedMode */ true
                         );
+#if INT_USE_LAZY_SPE_SAVE == 1
+        pT->contextSaveDesc.pSpeContextSaveArea = pT->pSpeContextSaveArea;
+#endif
 #ifdef DEBUG
 # if RTOS_NO_TASKS <= 3
         {
@@ -1866,35 +3214,22 @@ _Noreturn void rtos_initRTOS(void)
         /* Initialize overrun counter. */
         pT->cntOverrun = 0;
 
-        /* Any task is suspended at the beginning. No task is active, see before. If
-           mutexes or semaphores are in use this list is sorted with decreasing priority.
+        /* Start the timer if the start condition includes a timeout. */
+        if(pT->cntTimerDelta != 0)
+            startTimer(pT, pT->cntTimerDelta);
+
+        /* Any task is suspended at the beginning. No task is active, see before. Tasks of
+           same priority are served in the order of their indexes.
              Note Daijie Zhang <zdaijie@gmail.com> (see
            http://forum.arduino.cc/index.php?topic=138643 as of Jan 8, 2016): The
            preprocessor condition was wrong in
            https://vranken@svn.code.sf.net/p/rtuinos/code/trunk/code/RTOS/rtos.c?&r=1. This
            let to wrong first assignment of free semphores to tasks of different priority
            and has been fixed in r2. */
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_OFF  &&   RTOS_USE_MUTEX == RTOS_FEATURE_OFF
-        _pSuspendedTaskAry[idxTask] = pT;
-#else
-        signed int idxPos;
-        for(idxPos=0; idxPos<(int)idxTask; ++idxPos)
-            if(_pSuspendedTaskAry[idxPos]->prioClass < pT->prioClass)
-                break;
-
-        /* Shift rest of the list one to the end. This loop requires a signed index. */
-        signed int i;
-        for(i=(int)idxTask-1; i>=idxPos; --i)
-            _pSuspendedTaskAry[i+1] = _pSuspendedTaskAry[i];
+        pT->suspendSeqNo = _nextSuspendSeqNo++;
 
-        /* Insert the suspended task at the priority determined right position. */
-        _pSuspendedTaskAry[idxPos] = pT;
-#endif
     } /* for(All tasks to initialize) */
 
-    /* Number of currently suspended tasks: All. */
-    _noSuspendedTasks = RTOS_NO_TASKS;
-
     /* The idle task is stored in the last array entry. It differs, there's e.g. no task
        function defined. We mainly need the storage location for the stack pointer.
          The information of the stack area is retrieved from the linker; the according
@@ -1922,7 +3257,11 @@ _Noreturn void rtos_initRTOS(void)
 #endif
     pT->pStackArea = (uint32_t*)ld_stackStart;  /* Used for stack reserve computation. */
     pT->stackSize = (uint32_t)(ld_stackEnd - ld_stackStart);  /* Not used at all. */
-    pT->cntDelay = 0;               /* Not used at all. */
+    pT->pNext = NULL;               /* Not used at all. */
+    pT->suspendSeqNo = 0;           /* Not used at all. */
+    pT->pNextTimer = NULL;          /* Not used at all. */
+    pT->ppLinkToThisTimer = NULL;   /* Not used at all. */
+    pT->cntTimerDelta = 0;          /* Not used at all. */
 
     /* The next element always needs to be 0. Otherwise any interrupt or a call of
        sendEvent would corrupt the stack assuming that a suspend command would require a
@@ -1932,12 +3271,25 @@ _Noreturn void rtos_initRTOS(void)
     pT->eventMask = 0;              /* Not used at all. */
     pT->waitForAnyEvent = true;     /* Not used at all. */
     pT->cntOverrun = 0;             /* Not used at all. */
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+    pT->tiCpu = 0;
+    pT->tiBecameDue = 0;            /* The idle task is never made due. */
+    pT->noActivations = 0;
+    pT->tiMaxLatency = 0;
+#endif
 
     /* Any task is suspended at the beginning. No task is active, see before. */
     for(idxClass=0; idxClass<RTOS_NO_PRIO_CLASSES; ++idxClass)
-        _noDueTasksAry[idxClass] = 0;
+    {
+        _dueListAry[idxClass].pHead = NULL;
+        _dueListAry[idxClass].pTail = NULL;
+    }
+    _dueListNotEmptyVec = 0;
     _pActiveTask    = _pIdleTask;
     _pSuspendedTask = _pIdleTask;
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+    _tiLastTaskSwitch = ihw_getTimeBase();
+#endif
 
     /* All data is prepared and the kernel is ready to react on task switch demands. Being
        in this state, we can let the application install kernel interrupts. */
@@ -46,17 +46,15 @@
 
 /** Number of distinct priorities of tasks. Since several tasks may share the same
     priority, this number is lower or equal to NO_TASKS. Permitted range is 0..NO_TASKS,
-    but 1..NO_TASKS if at least one task is defined.\n
+    but 1..NO_TASKS if at least one task is defined. The number must not exceed 32.\n
       A runtime check is not done. The code will crash in case of a bad setting. */
 #define RTOS_NO_PRIO_CLASSES    3
 
 
-/** Since many tasks will belong to distinct priority classes, the maximum number of tasks
-    belonging to the same class will be significantly lower than the number of tasks. This
-    setting is used to reduce the required memory size for the statically allocated data
-    structures. Set the value as low as possible. Permitted range is min(1, NO_TASKS)..127,
-    but a value greater than NO_TASKS is not reasonable.\n
-      A runtime check is not done. The code will crash in case of a bad setting. */
+/** The maximum number of tasks belonging to the same priority class. The setting is no
+    longer used by the kernel; the due tasks of a class are held in a linked list rather
+    than in an array of this size. The definition is kept for compatibility with existing
+    configuration files. */
 #define RTOS_MAX_NO_TASKS_IN_PRIO_CLASS 2
 
 
@@ -86,12 +84,68 @@
 #define RTOS_NO_MUTEX_EVENTS    0
 
 
+/** Priority inheritance for mutexes. If on, a task, which owns a mutex, temporarily
+    inherits the priority class of the task of highest priority, which waits for this
+    mutex. The inherited priority is passed on along a chain of tasks, which own a mutex
+    and wait for another one, and it is withdrawn when the mutex is released. A task of
+    medium priority can then no longer delay a high priority waiter for an unbounded time
+    (priority inversion).\n
+      The switch has an effect only if #RTOS_NO_MUTEX_EVENTS is greater than zero. The
+    kernel records the owner of each mutex; a mutex should be released only by the task,
+    which had acquired it. The overhead of acquiring and releasing a mutex increases
+    moderately.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_MUTEX_PRIORITY_INHERITANCE     RTOS_FEATURE_OFF
+
+
+/** The number of message queues. Each queue occupies an event; the queue events follow
+    the mutex events in the event vector. Tasks exchange messages with the system calls
+    rtos_sendToQueue() and rtos_receiveFromQueue(), which block on a full or empty queue.
+    The message is copied from the sender directly to a waiting receiver and vice versa,
+    no additional semaphore is needed.\n
+      The queues are declared extern to RTuinOS. Please refer to rtos.h for the
+    declaration of \a rtos_queueAry and define \b and \b initialize this array in your
+    application code. */
+#define RTOS_NO_QUEUE_EVENTS    0
+
+
 /** The period of the system timer tick is defined here as floating point constant. The
     unit is s. The permitted range is 10us ... 30s. The constant is considered by the
     intialization of the system timer at RTOS initialization time. */
 #define RTOS_TICK (1e-3f)
 
 
+/** Tickless idle mode. If on, the system timer skips the ticks, in which only the idle
+    task is ready and no timer elapses. The interrupt load of a mostly idle system drops
+    and the idle task gets the time for background computations. The decision is taken in
+    the system timer interrupt; if the last task suspends between two ticks then the next
+    tick still occurs. A task, which is made due by an interrupt or by the idle task, ends
+    the skipping immediately.\n
+      The skipped ticks are clocked when the idle period ends, either by the system timer
+    interrupt or by the interrupt or system call, which makes a task due. The kernel's time
+    lags behind in between but no task can see the stale value; only the idle task runs
+    and the kernel has no function to read its time. Timers and timeouts are unaffected.
+    Time stamps taken by the application from the CPU's time base are unaffected, too.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_TICKLESS_IDLE      RTOS_FEATURE_OFF
+
+
+/** The timer slack in tickless idle mode in system timer ticks. When the ticks are skipped
+    till the next timer elapses then the timers, which elapse up to this number of ticks
+    later, are delayed and coalesced with the first one; all of them elapse in the same
+    interrupt. Set to zero to have all timers elapse in time. The setting is irrelevant if
+    #RTOS_TICKLESS_IDLE is off. */
+#define RTOS_TICKLESS_IDLE_SLACK    0
+
+
+/** Measure the CPU time of the tasks. If on, the kernel reads the CPU's time base at each
+    task switch. It accumulates the execution time of the tasks, counts their activations
+    and records the longest time span from becoming due till running. The figures are
+    queried with rtos_getTaskCpuTime().\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_MEASURE_TASK_CPU_TIME  RTOS_FEATURE_OFF
+
+
 /** Enable the application defined interrupt 0. (Two such interrupts are pre-configured in
     the code and more can be implemented by taking these two as a code template.)\n
       To install the application interrupt this define is set to #RTOS_FEATURE_ON.\n
@@ -28,6 +28,7 @@
 
 #include "MPC5643L.h"
 #include "typ_types.h"
+#include "ihw_initMcuCoreHW.h"
 #include "sc_systemCalls.h"
 #include "int_defStackFrame.h"
 #include "int_interruptHandler.h"
@@ -91,6 +92,52 @@
 #endif
 
 
+/** Priority inheritance for mutexes has been added to the configuration later; an
+    rtos.config.h, which doesn't mention it, doesn't use it. */
+#ifndef RTOS_MUTEX_PRIORITY_INHERITANCE
+# define RTOS_MUTEX_PRIORITY_INHERITANCE RTOS_FEATURE_OFF
+#endif
+
+/** Derive a switch telling whether the priority of mutex owners is raised. */
+#if RTOS_USE_MUTEX == RTOS_FEATURE_ON  \
+    &&  RTOS_MUTEX_PRIORITY_INHERITANCE == RTOS_FEATURE_ON
+# define RTOS_USE_PRIO_INHERITANCE RTOS_FEATURE_ON
+#else
+# define RTOS_USE_PRIO_INHERITANCE RTOS_FEATURE_OFF
+#endif
+
+
+/** The number of message queues. Message queues have been added to the configuration
+    later; an rtos.config.h, which doesn't mention them, configures none. */
+#ifndef RTOS_NO_QUEUE_EVENTS
+# define RTOS_NO_QUEUE_EVENTS 0
+#endif
+
+/** Derive a switch telling whether message queues are in use. */
+#if RTOS_NO_QUEUE_EVENTS > 0
+# define RTOS_USE_QUEUE RTOS_FEATURE_ON
+#else
+# define RTOS_USE_QUEUE RTOS_FEATURE_OFF
+#endif
+
+
+/** The tickless idle mode has been added to the configuration later; an rtos.config.h,
+    which doesn't mention it, operates the system timer with the regular tick. */
+#ifndef RTOS_TICKLESS_IDLE
+# define RTOS_TICKLESS_IDLE RTOS_FEATURE_OFF
+#endif
+#ifndef RTOS_TICKLESS_IDLE_SLACK
+# define RTOS_TICKLESS_IDLE_SLACK 0
+#endif
+
+
+/** The measurement of the task CPU times has been added to the configuration later; an
+    rtos.config.h, which doesn't mention it, doesn't measure. */
+#ifndef RTOS_MEASURE_TASK_CPU_TIME
+# define RTOS_MEASURE_TASK_CPU_TIME RTOS_FEATURE_OFF
+#endif
+
+
 /* Some global, general purpose events and the two timer events. Used to specify the
    resume condition when suspending a task.
      Conditional definition: If the application defines an interrupt which triggers an
@@ -100,6 +147,8 @@
 # define RTOS_EVT_SEMAPHORE_00      ((uint32_t)1<<0)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 0
 # define RTOS_EVT_MUTEX_00          ((uint32_t)1<<0)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 0
+# define RTOS_EVT_QUEUE_00          ((uint32_t)1<<0)
 #else
 # define RTOS_EVT_EVENT_00          ((uint32_t)1<<0)
 #endif
@@ -109,6 +158,8 @@
 # define RTOS_EVT_SEMAPHORE_01      ((uint32_t)1<<1)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 1
 # define RTOS_EVT_MUTEX_01          ((uint32_t)1<<1)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 1
+# define RTOS_EVT_QUEUE_01          ((uint32_t)1<<1)
 #else
 # define RTOS_EVT_EVENT_01          ((uint32_t)1<<1)
 #endif
@@ -118,6 +169,8 @@
 # define RTOS_EVT_SEMAPHORE_02      ((uint32_t)1<<2)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 2
 # define RTOS_EVT_MUTEX_02          ((uint32_t)1<<2)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 2
+# define RTOS_EVT_QUEUE_02          ((uint32_t)1<<2)
 #else
 # define RTOS_EVT_EVENT_02          ((uint32_t)1<<2)
 #endif
@@ -127,6 +180,8 @@
 # define RTOS_EVT_SEMAPHORE_03      ((uint32_t)1<<3)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 3
 # define RTOS_EVT_MUTEX_03          ((uint32_t)1<<3)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 3
+# define RTOS_EVT_QUEUE_03          ((uint32_t)1<<3)
 #else
 # define RTOS_EVT_EVENT_03          ((uint32_t)1<<3)
 #endif
@@ -136,6 +191,8 @@
 # define RTOS_EVT_SEMAPHORE_04      ((uint32_t)1<<4)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 4
 # define RTOS_EVT_MUTEX_04          ((uint32_t)1<<4)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 4
+# define RTOS_EVT_QUEUE_04          ((uint32_t)1<<4)
 #else
 # define RTOS_EVT_EVENT_04          ((uint32_t)1<<4)
 #endif
@@ -145,6 +202,8 @@
 # define RTOS_EVT_SEMAPHORE_05      ((uint32_t)1<<5)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 5
 # define RTOS_EVT_MUTEX_05          ((uint32_t)1<<5)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 5
+# define RTOS_EVT_QUEUE_05          ((uint32_t)1<<5)
 #else
 # define RTOS_EVT_EVENT_05          ((uint32_t)1<<5)
 #endif
@@ -154,6 +213,8 @@
 # define RTOS_EVT_SEMAPHORE_06      ((uint32_t)1<<6)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 6
 # define RTOS_EVT_MUTEX_06          ((uint32_t)1<<6)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 6
+# define RTOS_EVT_QUEUE_06          ((uint32_t)1<<6)
 #else
 # define RTOS_EVT_EVENT_06          ((uint32_t)1<<6)
 #endif
@@ -163,6 +224,8 @@
 # define RTOS_EVT_SEMAPHORE_07      ((uint32_t)1<<7)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 7
 # define RTOS_EVT_MUTEX_07          ((uint32_t)1<<7)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 7
+# define RTOS_EVT_QUEUE_07          ((uint32_t)1<<7)
 #else
 # define RTOS_EVT_EVENT_07          ((uint32_t)1<<7)
 #endif
@@ -172,6 +235,8 @@
 # define RTOS_EVT_SEMAPHORE_07      ((uint32_t)1<<7)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 7
 # define RTOS_EVT_MUTEX_07          ((uint32_t)1<<7)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 7
+# define RTOS_EVT_QUEUE_07          ((uint32_t)1<<7)
 #else
 # define RTOS_EVT_EVENT_07          ((uint32_t)1<<7)
 #endif
@@ -181,6 +246,8 @@
 # define RTOS_EVT_SEMAPHORE_08      ((uint32_t)1<<8)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 8
 # define RTOS_EVT_MUTEX_08          ((uint32_t)1<<8)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 8
+# define RTOS_EVT_QUEUE_08          ((uint32_t)1<<8)
 #else
 # define RTOS_EVT_EVENT_08          ((uint32_t)1<<8)
 #endif
@@ -190,6 +257,8 @@
 # define RTOS_EVT_SEMAPHORE_09      ((uint32_t)1<<9)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 9
 # define RTOS_EVT_MUTEX_09          ((uint32_t)1<<9)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 9
+# define RTOS_EVT_QUEUE_09          ((uint32_t)1<<9)
 #else
 # define RTOS_EVT_EVENT_09          ((uint32_t)1<<9)
 #endif
@@ -199,6 +268,8 @@
 # define RTOS_EVT_SEMAPHORE_10      ((uint32_t)1<<10)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 10
 # define RTOS_EVT_MUTEX_10          ((uint32_t)1<<10)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 10
+# define RTOS_EVT_QUEUE_10          ((uint32_t)1<<10)
 #else
 # define RTOS_EVT_EVENT_10          ((uint32_t)1<<10)
 #endif
@@ -208,6 +279,8 @@
 # define RTOS_EVT_SEMAPHORE_11      ((uint32_t)1<<11)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 11
 # define RTOS_EVT_MUTEX_11          ((uint32_t)1<<11)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 11
+# define RTOS_EVT_QUEUE_11          ((uint32_t)1<<11)
 #else
 # define RTOS_EVT_EVENT_11          ((uint32_t)1<<11)
 #endif
@@ -217,6 +290,8 @@
 # define RTOS_EVT_SEMAPHORE_12      ((uint32_t)1<<12)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 12
 # define RTOS_EVT_MUTEX_12          ((uint32_t)1<<12)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 12
+# define RTOS_EVT_QUEUE_12          ((uint32_t)1<<12)
 #else
 # define RTOS_EVT_EVENT_12          ((uint32_t)1<<12)
 #endif
@@ -226,6 +301,8 @@
 # define RTOS_EVT_SEMAPHORE_13      ((uint32_t)1<<13)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 13
 # define RTOS_EVT_MUTEX_13          ((uint32_t)1<<13)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 13
+# define RTOS_EVT_QUEUE_13          ((uint32_t)1<<13)
 #else
 # define RTOS_EVT_EVENT_13          ((uint32_t)1<<13)
 #endif
@@ -235,6 +312,8 @@
 # define RTOS_EVT_SEMAPHORE_14      ((uint32_t)1<<14)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 14
 # define RTOS_EVT_MUTEX_14          ((uint32_t)1<<14)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 14
+# define RTOS_EVT_QUEUE_14          ((uint32_t)1<<14)
 #else
 # define RTOS_EVT_EVENT_14          ((uint32_t)1<<14)
 #endif
@@ -244,6 +323,8 @@
 # define RTOS_EVT_SEMAPHORE_15      ((uint32_t)1<<15)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 15
 # define RTOS_EVT_MUTEX_15          ((uint32_t)1<<15)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 15
+# define RTOS_EVT_QUEUE_15          ((uint32_t)1<<15)
 #else
 # define RTOS_EVT_EVENT_15          ((uint32_t)1<<15)
 #endif
@@ -253,6 +334,8 @@
 # define RTOS_EVT_SEMAPHORE_16      ((uint32_t)1<<16)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 16
 # define RTOS_EVT_MUTEX_16          ((uint32_t)1<<16)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 16
+# define RTOS_EVT_QUEUE_16          ((uint32_t)1<<16)
 #else
 # define RTOS_EVT_EVENT_16          ((uint32_t)1<<16)
 #endif
@@ -262,6 +345,8 @@
 # define RTOS_EVT_SEMAPHORE_17      ((uint32_t)1<<17)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 17
 # define RTOS_EVT_MUTEX_17          ((uint32_t)1<<17)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 17
+# define RTOS_EVT_QUEUE_17          ((uint32_t)1<<17)
 #else
 # define RTOS_EVT_EVENT_17          ((uint32_t)1<<17)
 #endif
@@ -271,6 +356,8 @@
 # define RTOS_EVT_SEMAPHORE_18      ((uint32_t)1<<18)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 18
 # define RTOS_EVT_MUTEX_18          ((uint32_t)1<<18)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 18
+# define RTOS_EVT_QUEUE_18          ((uint32_t)1<<18)
 #else
 # define RTOS_EVT_EVENT_18          ((uint32_t)1<<18)
 #endif
@@ -280,6 +367,8 @@
 # define RTOS_EVT_SEMAPHORE_19      ((uint32_t)1<<19)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 19
 # define RTOS_EVT_MUTEX_19          ((uint32_t)1<<19)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 19
+# define RTOS_EVT_QUEUE_19          ((uint32_t)1<<19)
 #else
 # define RTOS_EVT_EVENT_19          ((uint32_t)1<<19)
 #endif
@@ -289,6 +378,8 @@
 # define RTOS_EVT_SEMAPHORE_20      ((uint32_t)1<<20)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 20
 # define RTOS_EVT_MUTEX_20          ((uint32_t)1<<20)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 20
+# define RTOS_EVT_QUEUE_20          ((uint32_t)1<<20)
 #else
 # define RTOS_EVT_EVENT_20          ((uint32_t)1<<20)
 #endif
@@ -298,6 +389,8 @@
 # define RTOS_EVT_SEMAPHORE_21      ((uint32_t)1<<21)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 21
 # define RTOS_EVT_MUTEX_21          ((uint32_t)1<<21)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 21
+# define RTOS_EVT_QUEUE_21          ((uint32_t)1<<21)
 #else
 # define RTOS_EVT_EVENT_21          ((uint32_t)1<<21)
 #endif
@@ -307,6 +400,8 @@
 # define RTOS_EVT_SEMAPHORE_22      ((uint32_t)1<<22)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 22
 # define RTOS_EVT_MUTEX_22          ((uint32_t)1<<22)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 22
+# define RTOS_EVT_QUEUE_22          ((uint32_t)1<<22)
 #else
 # define RTOS_EVT_EVENT_22          ((uint32_t)1<<22)
 #endif
@@ -316,6 +411,8 @@
 # define RTOS_EVT_SEMAPHORE_23      ((uint32_t)1<<23)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 23
 # define RTOS_EVT_MUTEX_23          ((uint32_t)1<<23)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 23
+# define RTOS_EVT_QUEUE_23          ((uint32_t)1<<23)
 #else
 # define RTOS_EVT_EVENT_23          ((uint32_t)1<<23)
 #endif
@@ -325,6 +422,8 @@
 # define RTOS_EVT_SEMAPHORE_24      ((uint32_t)1<<24)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 24
 # define RTOS_EVT_MUTEX_24          ((uint32_t)1<<24)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 24
+# define RTOS_EVT_QUEUE_24          ((uint32_t)1<<24)
 #else
 # define RTOS_EVT_EVENT_24          ((uint32_t)1<<24)
 #endif
@@ -334,6 +433,8 @@
 # define RTOS_EVT_SEMAPHORE_25      ((uint32_t)1<<25)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 25
 # define RTOS_EVT_MUTEX_25          ((uint32_t)1<<25)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 25
+# define RTOS_EVT_QUEUE_25          ((uint32_t)1<<25)
 #else
 # define RTOS_EVT_EVENT_25          ((uint32_t)1<<25)
 #endif
@@ -343,6 +444,8 @@
 # define RTOS_EVT_SEMAPHORE_26      ((uint32_t)1<<26)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 26
 # define RTOS_EVT_MUTEX_26          ((uint32_t)1<<26)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 26
+# define RTOS_EVT_QUEUE_26          ((uint32_t)1<<26)
 #else
 # define RTOS_EVT_EVENT_26          ((uint32_t)1<<26)
 #endif
@@ -352,6 +455,8 @@
 # define RTOS_EVT_SEMAPHORE_27      ((uint32_t)1<<27)
 #elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 27
 # define RTOS_EVT_MUTEX_27          ((uint32_t)1<<27)
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 27
+# define RTOS_EVT_QUEUE_27          ((uint32_t)1<<27)
 #else
 # define RTOS_EVT_EVENT_27          ((uint32_t)1<<27)
 #endif
@@ -359,8 +464,8 @@
 /* The name of the next event depends on the configuration of RTuinOS. */
 #if RTOS_USE_APPL_INTERRUPT_01 == RTOS_FEATURE_ON
 # define RTOS_EVT_ISR_USER_01       ((uint32_t)1<<28)
-# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 28
-#  error Too many semaphores and mutexes specified. The limit is 28 when using two application interrupts
+# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 28
+#  error Too many semaphores, mutexes and queues. The limit is 28 with two appl. ISRs
 # endif
 #else
 /** General purpose event, posted explicitly by rtos_sendEvent. */
@@ -368,6 +473,8 @@
 #  define RTOS_EVT_SEMAPHORE_28      ((uint32_t)1<<28)
 # elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 28
 #  define RTOS_EVT_MUTEX_28          ((uint32_t)1<<28)
+# elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 28
+#  define RTOS_EVT_QUEUE_28          ((uint32_t)1<<28)
 # else
 #  define RTOS_EVT_EVENT_28          ((uint32_t)1<<28)
 # endif
@@ -376,8 +483,8 @@
 /* The name of the next event depends on the configuration of RTuinOS. */
 #if RTOS_USE_APPL_INTERRUPT_00 == RTOS_FEATURE_ON
 # define RTOS_EVT_ISR_USER_00       (0x0001<<29)
-# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 29
-#  error Too many semaphores and mutexes specified. The limit is 29 when using a single application interrupt
+# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 29
+#  error Too many semaphores, mutexes and queues. The limit is 29 with one appl. ISR
 # endif
 #else
 /** General purpose event, posted explicitly by rtos_sendEvent. */
@@ -385,13 +492,15 @@
 #  define RTOS_EVT_SEMAPHORE_29      ((uint32_t)1<<29)
 # elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 29
 #  define RTOS_EVT_MUTEX_29          ((uint32_t)1<<29)
+# elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 29
+#  define RTOS_EVT_QUEUE_29          ((uint32_t)1<<29)
 # else
 #  define RTOS_EVT_EVENT_29          ((uint32_t)1<<29)
 # endif
 #endif
 
-#if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 30
-# error Too many semaphores and mutexes specified. The limit is 30 in total
+#if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_QUEUE_EVENTS > 30
+# error Too many semaphores, mutexes and queues specified. The limit is 30 in total
 #endif
 
 /** Real time clock is elapsed for the task. */
@@ -566,6 +675,112 @@
                                 int_systemCall(SC_IDX_SYS_CALL_SEND_EVENT, (eventVec))
 
 
+#if RTOS_USE_QUEUE == RTOS_FEATURE_ON
+/** A value of the timeout of rtos_sendToQueue() and rtos_receiveFromQueue(): The calling
+    task waits without timeout until the message could be transferred. */
+#define RTOS_QUEUE_WAIT_FOREVER     ((unsigned int)-1)
+
+/** The event of a message queue. The queues follow the mutexes in the event vector, the
+    event of queue \a idxQueue is one of the RTOS_EVT_QUEUE_xx. */
+#define RTOS_EVT_OF_QUEUE(idxQueue)                                                      \
+            ((uint32_t)1<<(RTOS_NO_SEMAPHORE_EVENTS+RTOS_NO_MUTEX_EVENTS+(idxQueue)))
+
+/** Initializer expression for an element of \a rtos_queueAry.
+      @param bufferAry
+    The ring buffer of the queue. This needs to be an array (not a pointer) with static
+    storage duration. It holds the queued messages.
+      @param msgSize
+    The size of a message in Byte. All messages of a queue have the same size. The size of
+    \a bufferAry needs to be a multiple of \a msgSize; the quotient is the capacity of the
+    queue, which needs to be at least one. */
+#define RTOS_QUEUE_INIT(bufferAry, msgSize)                                              \
+            { .pBuffer = (uint8_t*)(bufferAry)                                           \
+            , .sizeOfMsg = (msgSize)                                                     \
+            , .maxNoMsgs = sizeof(bufferAry)/(msgSize)                                   \
+            , .idxRead = 0                                                               \
+            , .noMsgs = 0                                                                \
+            }
+
+/**
+ * Send a message to a queue. The message is copied into the queue. If a task is waiting
+ * for a message from this queue then the message is handed over directly into the
+ * receive buffer of the task and the task is resumed; if it is of higher priority then
+ * the sending task is preempted by it. No additional semaphore or event needs to be
+ * posted.\n
+ *   If the queue is full then the calling task is suspended until another task receives
+ * a message from the queue or until the timeout elapses. The idle task must not specify a
+ * timeout other than zero.\n
+ *   A message can be a block of data of any size, e.g. an array of samples. The cost of
+ * the system call and of the context switches is spent once per block. A zero-copy
+ * transfer is achieved by a queue of pointers: The message is the address of a buffer
+ * and the ownership of the buffer is handed over to the receiver. Typically, a second
+ * queue returns the consumed buffers to the producer.
+ *   @return
+ * The event vector, which tells about success. It is RTOS_EVT_OF_QUEUE(\a idxQueue) if
+ * the message has been sent. It is #RTOS_EVT_DELAY_TIMER in case of a timeout and 0 if
+ * the queue is full and \a timeout is zero.
+ *   @param idxQueue
+ * The queue by index into \a rtos_queueAry.
+ *   @param pMsg
+ * The pointer to the message, which has the size configured for the queue. The message
+ * is not accessed any more after return.
+ *   @param timeout
+ * The number of system timer ticks to wait at maximum for free space in the queue. See
+ * #rtos_waitForEvent() and #RTOS_EVT_DELAY_TIMER for the precise meaning of the timeout.
+ * If \a timeout is zero then the function returns immediately if the queue is full.
+ * #RTOS_QUEUE_WAIT_FOREVER means not to use a timeout.
+ *   @remark
+ * This macro invokes the system call trap with system call index
+ * #SC_IDX_SYS_CALL_SEND_TO_QUEUE.
+ *   @remark
+ * A kernel relevant ISR can't use the system call; it uses rtos_osSendToQueueFromIsr().
+ */
+#define /* uint32_t */ rtos_sendToQueue( /* unsigned int */ idxQueue                     \
+                                       , /* const void * */ pMsg                         \
+                                       , /* unsigned int */ timeout                      \
+                                       )                                                 \
+            int_systemCall( SC_IDX_SYS_CALL_SEND_TO_QUEUE                                \
+                          , (idxQueue), (pMsg), (timeout)                                \
+                          )
+
+
+/**
+ * Receive a message from a queue. The oldest message is copied from the queue into the
+ * buffer of the calling task. If a task is waiting for free space in the queue then its
+ * message is copied into the queue and the task is resumed.\n
+ *   If the queue is empty then the calling task is suspended until another task sends a
+ * message to the queue or until the timeout elapses. The message is then directly
+ * copied into the buffer of the calling task. The idle task must not specify a timeout
+ * other than zero.
+ *   @return
+ * The event vector, which tells about success. It is RTOS_EVT_OF_QUEUE(\a idxQueue) if
+ * a message has been received. It is #RTOS_EVT_DELAY_TIMER in case of a timeout and 0 if
+ * the queue is empty and \a timeout is zero.
+ *   @param idxQueue
+ * The queue by index into \a rtos_queueAry.
+ *   @param pMsg
+ * The pointer to the buffer, which receives the message. It needs to have the size
+ * configured for the queue.
+ *   @param timeout
+ * The number of system timer ticks to wait at maximum for a message. See
+ * #rtos_sendToQueue().
+ *   @remark
+ * This macro invokes the system call trap with system call index
+ * #SC_IDX_SYS_CALL_RECEIVE_FROM_QUEUE.
+ *   @remark
+ * A kernel relevant ISR can't use the system call; it uses
+ * rtos_osReceiveFromQueueFromIsr().
+ */
+#define /* uint32_t */ rtos_receiveFromQueue( /* unsigned int */ idxQueue                \
+                                            , /* void * */       pMsg                    \
+                                            , /* unsigned int */ timeout                 \
+                                            )                                            \
+            int_systemCall( SC_IDX_SYS_CALL_RECEIVE_FROM_QUEUE                           \
+                          , (idxQueue), (pMsg), (timeout)                                \
+                          )
+#endif /* RTOS_USE_QUEUE == RTOS_FEATURE_ON */
+
+
 /*
  * Global type definitions
  */
@@ -577,6 +792,49 @@
     event. */
 typedef void (*rtos_taskFunction_t)(uint32_t postedEventVec);
 
+#if RTOS_USE_QUEUE == RTOS_FEATURE_ON
+/** A message queue. The queue is a ring buffer of messages of fixed size. Initialize the
+    elements of \a rtos_queueAry with #RTOS_QUEUE_INIT. All fields but the buffer
+    configuration are owned by the kernel. */
+typedef struct rtos_queue_t
+{
+    /** The ring buffer of messages. The application provides the memory. */
+    uint8_t *pBuffer;
+
+    /** The size of a single message in Byte. */
+    unsigned int sizeOfMsg;
+
+    /** The capacity of the queue as number of messages. */
+    unsigned int maxNoMsgs;
+
+    /** The index of the oldest message in the ring buffer. */
+    unsigned int idxRead;
+
+    /** The number of messages currently in the queue. */
+    unsigned int noMsgs;
+
+} rtos_queue_t;
+#endif
+
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+/** The CPU time measurement of a task, see rtos_getTaskCpuTime(). All times are in ticks
+    of the CPU's time base, i.e. in units of 1/120 us. */
+typedef struct rtos_taskCpuTime_t
+{
+    /** The execution time of the task. It includes the time spent in interrupts, which
+        didn't switch to another task. */
+    uint64_t tiCpu;
+
+    /** The number of task switches, which made the task the active task. */
+    unsigned int noActivations;
+
+    /** The longest time span from becoming due, i.e. from the event or timeout, till
+        running. Preemptions of a due task are not considered. */
+    uint32_t tiMaxLatency;
+
+} rtos_taskCpuTime_t;
+#endif
+
 
 /*
  * Global data declarations
@@ -599,6 +857,15 @@ extern unsigned int rtos_semaphoreAry[RTOS_NO_SEMAPHORE_EVENTS];
 #endif
 
 
+#if RTOS_USE_QUEUE == RTOS_FEATURE_ON
+/** All declared message queues are held in an array. The array is declared extern and it
+    is defined by the application code, which provides the memory for the messages. Use
+    #RTOS_QUEUE_INIT to initialize the elements. Queue \a i is related to the event
+    RTOS_EVT_OF_QUEUE(\a i). */
+extern rtos_queue_t rtos_queueAry[RTOS_NO_QUEUE_EVENTS];
+#endif
+
+
 /*
  * Global inline functions
  */
@@ -634,7 +901,7 @@ static ALWAYS_INLINE void rtos_enterCriticalSection()
 {
     /* MCU reference manual, section 28.6.6.2, p. 932: The change of the current priority
        in the INTC should be done under global interrupt lock. */
-    asm volatile ( "wrteei 0\n" ::: );
+    ihw_suspendAllInterrupts();
     
     /* The assertion can help detecting unpermitted, nested use of the function pair or
        unpermitted use from a system call or an External Interrupt handler. */
@@ -652,15 +919,9 @@ static ALWAYS_INLINE void rtos_enterCriticalSection()
        already asserted interrupt. The isync instruction ensures that this last interrupt
        has completed prior to the execution of the first code inside the critical section.
        See https://community.nxp.com/message/993795 for more. */
-    asm volatile ( "mbar\n\t"
-                   "wrteei 1\n\t"
-#ifndef __VLE__
-                   "isync\n"
-#else
-                   "se_isync\n"
-#endif
-                   :::
-                 );
+    ihw_memoryBarrier();
+    ihw_resumeAllInterrupts();
+    ihw_instructionSync();
     
     /* A single interrupt at prio 1, which occured in the short time span between wrteei 0
        and the write to CPR, can preempt us here. The critical section is however not
@@ -682,13 +943,11 @@ static ALWAYS_INLINE void rtos_leaveCriticalSection()
     /* MCU reference manual, section 28.6.6.2, p. 932: The change of the current priority
        in the INTC should be done under global interrupt lock. A memory barrier ensures
        that all memory operations inside the now left critical section are completed. */
-    asm volatile ( "mbar\n\t"
-                   "wrteei 0\n"
-                   :::
-                 );
+    ihw_memoryBarrier();
+    ihw_suspendAllInterrupts();
     assert( /* priorityLevelSoFar */ INTC.CPR_PRC0.R == 1);
     INTC.CPR_PRC0.R = 0;
-    asm volatile ( "wrteei 1\n" ::: );
+    ihw_resumeAllInterrupts();
 
 } /* End of rtos_leaveCriticalSection */
 
@@ -750,6 +1009,28 @@ void rtos_initializeTask( unsigned int idxTask
                         , unsigned int startTimeout
                         );
 
+#if INT_USE_LAZY_SPE_SAVE == 1
+/** Permit a task the use of the SPE. To be called from setup() after initializing the
+    task. */
+void rtos_setTaskSpeContextSaveArea( unsigned int idxTask
+                                   , int_speContextSaveArea_t * const pSpeContextSaveArea
+                                   );
+#endif
+
+#if RTOS_USE_QUEUE == RTOS_FEATURE_ON
+/** Send a message to a queue from a kernel relevant ISR, without waiting. */
+uint32_t rtos_osSendToQueueFromIsr( int_cmdContextSwitch_t *pCmdContextSwitch
+                                  , unsigned int idxQueue
+                                  , const void *pMsg
+                                  );
+
+/** Receive a message from a queue from a kernel relevant ISR, without waiting. */
+uint32_t rtos_osReceiveFromQueueFromIsr( int_cmdContextSwitch_t *pCmdContextSwitch
+                                       , unsigned int idxQueue
+                                       , void *pMsg
+                                       );
+#endif
+
 /** Configure and enable the interrupt which clocks the system time of RTuinOS. This
     function has a default implementation, the application may but need not to implement
     it.\n
@@ -787,4 +1068,12 @@ unsigned int rtos_getTaskOverrunCounter(unsigned int idxTask, bool doReset);
 /** How many bytes of the stack of a task are still unused? */
 unsigned int rtos_getStackReserve(unsigned int idxTask);
 
+#if RTOS_MEASURE_TASK_CPU_TIME == RTOS_FEATURE_ON
+/** How much CPU time did a task consume? */
+void rtos_getTaskCpuTime( unsigned int idxTask
+                        , rtos_taskCpuTime_t * const pTaskCpuTime
+                        , bool doReset
+                        );
+#endif
+
 #endif  /* RTOS_INCLUDED */
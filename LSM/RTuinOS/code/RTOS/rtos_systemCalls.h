@@ -78,4 +78,24 @@ uint32_t rtos_sc_waitForEvent( int_cmdContextSwitch_t *pCmdContextSwitch
                              , unsigned int timeout
                              );
 
+/** Send a message to a queue. Suspend the current task if the queue is full or if the
+    message resumes a receiving task of higher priority.
+      @remark This is the implementation of a system call. Never call this function
+    directly; ISRs use rtos_osSendToQueueFromIsr(). */
+uint32_t rtos_sc_sendToQueue( int_cmdContextSwitch_t *pCmdContextSwitch
+                            , unsigned int idxQueue
+                            , const void *pMsg
+                            , unsigned int timeout
+                            );
+
+/** Receive a message from a queue. Suspend the current task if the queue is empty or if
+    the freed space resumes a sending task of higher priority.
+      @remark This is the implementation of a system call. Never call this function
+    directly. */
+uint32_t rtos_sc_receiveFromQueue( int_cmdContextSwitch_t *pCmdContextSwitch
+                                 , unsigned int idxQueue
+                                 , void *pMsg
+                                 , unsigned int timeout
+                                 );
+
 #endif  /* RTOS_SYSTEMCALLS_INCLUDED */
@@ -71,6 +71,10 @@
 const SECTION(.rodata.ivor) int_systemCallFct_t int_systemCallHandlerAry[SC_NO_SYSTEM_CALLS] =
     { [~SC_IDX_SYS_CALL_WAIT_FOR_EVENT] = (int_systemCallFct_t)rtos_sc_waitForEvent
     , [~SC_IDX_SYS_CALL_SEND_EVENT] = (int_systemCallFct_t)rtos_sc_sendEvent
+#if RTOS_USE_QUEUE == RTOS_FEATURE_ON
+    , [~SC_IDX_SYS_CALL_SEND_TO_QUEUE] = (int_systemCallFct_t)rtos_sc_sendToQueue
+    , [~SC_IDX_SYS_CALL_RECEIVE_FROM_QUEUE] = (int_systemCallFct_t)rtos_sc_receiveFromQueue
+#endif
     };
 
 /** The table of C functions, which implement the simple system calls (i.e. the kernel
@@ -48,9 +48,11 @@
     pointers! */
 #define SC_IDX_SYS_CALL_WAIT_FOR_EVENT      (-1)
 #define SC_IDX_SYS_CALL_SEND_EVENT          (-2)
+#define SC_IDX_SYS_CALL_SEND_TO_QUEUE       (-3)
+#define SC_IDX_SYS_CALL_RECEIVE_FROM_QUEUE  (-4)
 
 /** The number of system calls. */
-#define SC_NO_SYSTEM_CALLS                  2
+#define SC_NO_SYSTEM_CALLS                  4
 
 /** System call: Create a new execution context and possibly start it.\n
       This macro invokes the system call trap with system call index
@@ -105,29 +105,6 @@ static unsigned int _cpuLoad = 1000;
  * Function implementation
  */
 
-/**
- * Helper function: Read high resolution timer register of CPU. The register wraps around
- * after about 35s. The return value can be used to measure time spans up to this length.
- *   @return
- * Get the current register value. The value is incremented every 1/120MHz = (8+1/3)ns
- * regardless of the CPU activity.
- */
-static inline uint32_t getTBL()
-{
-    uint32_t TBL;
-    asm volatile ( /* AssemblerTemplate */
-                   "mfspr %0, 268\n\r" /* SPR 268 = TBL, 269 = TBU */
-                 : /* OutputOperands */ "=r" (TBL)
-                 : /* InputOperands */
-                 : /* Clobbers */
-                 );
-    return TBL;
-
-} /* End of getTBL */
-
-
-
-
 /**
  * The only task in this test case (besides idle).
  *   @param initCondition
@@ -139,7 +116,7 @@ static _Noreturn void task01_class00(uint32_t initCondition)
 {
 #define TICS_CYCLE  250
 
-    uint32_t ti = getTBL()
+    uint32_t ti = ihw_getTBL()
            , tiCycle
            , u;
     
@@ -156,7 +133,7 @@ static _Noreturn void task01_class00(uint32_t initCondition)
         
         iprintf("task01_class00: Suspending...\r\n");
         u = rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TICS_CYCLE);
-        tiCycle = getTBL();
+        tiCycle = ihw_getTBL();
         iprintf("task01_class00: Released with 0x%lx\r\n", u);
         
         /* The system timer tick has a frequency of 1/RTOS_TICK Hz.
@@ -90,6 +90,12 @@
 #define RTOS_TICK (1e-3f)
 
 
+/** Skip the system timer ticks while all tasks are suspended. The long idle periods of
+    this sample make it a good example for the tickless idle mode.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_TICKLESS_IDLE      RTOS_FEATURE_ON
+
+
 /** Enable the application defined interrupt 0. (Two such interrupts are pre-configured in
     the code and more can be implemented by taking these two as a code template.)\n
       To install the application interrupt this define is set to #RTOS_FEATURE_ON.\n
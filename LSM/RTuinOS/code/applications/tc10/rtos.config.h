@@ -39,14 +39,14 @@
 /** Number of tasks in the system. Tasks aren't created dynamically. This number of tasks
     will always be existent and alive. Permitted range is 0..127.\n
       A runtime check is not done. The code will crash in case of a bad setting. */
-#define RTOS_NO_TASKS    3
+#define RTOS_NO_TASKS    4
 
 
 /** Number of distinct priorities of tasks. Since several tasks may share the same
     priority, this number is lower or equal to NO_TASKS. Permitted range is 0..NO_TASKS,
     but 1..NO_TASKS if at least one task is defined.\n
       A runtime check is not done. The code will crash in case of a bad setting. */
-#define RTOS_NO_PRIO_CLASSES 3
+#define RTOS_NO_PRIO_CLASSES 4
 
 
 /** Since many tasks will belong to distinct priority classes, the maximum number of tasks
@@ -90,6 +90,12 @@
 #define RTOS_TICK (2.04e-3f)
 
 
+/** Measure the CPU time of the tasks. The report task of this sample prints the
+    figures.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_MEASURE_TASK_CPU_TIME  RTOS_FEATURE_ON
+
+
 /** Enable the application defined interrupt 0. (Two such interrupts are pre-configured in
     the code and more can be implemented by taking these two as a code template.)\n
       To install the application interrupt this define is set to #RTOS_FEATURE_ON.\n
@@ -39,7 +39,12 @@
  * RTuinOS application would require this because of very slow regular tasks.\n
  *   Besides measuring the current system load, \a loop is used to let the Arduino LED
  * blink. This is basically useless but demonstrates that the idle task is available to
- * other (infrequent) jobs even if gsl_getSystemLoad(void) is applied.
+ * other (infrequent) jobs even if gsl_getSystemLoad(void) is applied.\n
+ *   A fourth task of lowest priority regularly reports the CPU load of each task, as
+ * measured by the kernel, see rtos_getTaskCpuTime(). Different to the system load
+ * estimation, it doesn't consume the idle time and it splits the load into the tasks.
+ * The reported figures include the interrupts and the kernel overhead, which the tasks
+ * suffer from. The idle task's load is its busy wait in gsl_getSystemLoad().
  *
  * Copyright (C) 2012-2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -64,6 +69,7 @@
  *   taskT0C0
  *   taskT0C1
  *   taskT0C2
+ *   taskReport
  */
 
 /*
@@ -96,6 +102,10 @@
 #define STACK_SIZE_IN_BYTE \
             (RTOS_REQUIRED_STACK_SIZE_IN_BYTE(STACK_USAGE_IN_BYTE, NO_IRQ_LEVELS_IN_USE))
 
+/** The stack size of the report task. It needs more stack for formatted output. */
+#define STACK_SIZE_REPORT_IN_BYTE \
+            (RTOS_REQUIRED_STACK_SIZE_IN_BYTE(1000, NO_IRQ_LEVELS_IN_USE))
+
 /** The number of system timer ticks required to implement the time span given in Milliseconds.
     Consider to use an expression like \a TIME_IN_MS(10) as argument to the time
     related RTuinOS API functions in order to get readable code.
@@ -121,6 +131,7 @@
 static void taskT0C0(uint32_t taskParam);
 static void taskT0C1(uint32_t taskParam);
 static void taskT0C2(uint32_t taskParam);
+static void taskReport(uint32_t taskParam);
 
  
 /*
@@ -129,7 +140,8 @@ static void taskT0C2(uint32_t taskParam);
  
 static _Alignas(uint64_t) uint8_t _taskStackT0C0[STACK_SIZE_IN_BYTE]
                                 , _taskStackT0C1[STACK_SIZE_IN_BYTE]
-                                , _taskStackT0C2[STACK_SIZE_IN_BYTE];
+                                , _taskStackT0C2[STACK_SIZE_IN_BYTE]
+                                , _taskStackReport[STACK_SIZE_REPORT_IN_BYTE];
 
 
 /*
@@ -254,6 +266,59 @@ static void taskT0C2(uint32_t taskCondition ATTRIB_UNUSED)
 
 
 
+/**
+ * The report task. It regularly prints the CPU load of each task, the number of
+ * activations and the longest latency from becoming due till running.
+ *   @param initCondition
+ * The task gets an initialization parameter for whatever configuration purpose.
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+static void taskReport(uint32_t taskCondition ATTRIB_UNUSED)
+{
+#define TI_CYCLE_MS 2000
+
+    static const char * const taskNameAry[RTOS_NO_TASKS+1] =
+        {"T0C0", "T0C1", "T0C2", "Report", "Idle"};
+    rtos_taskCpuTime_t cpuTime;
+    unsigned int idxTask;
+
+    /* Start the measurement of all tasks at the same time. */
+    for(idxTask=0; idxTask<RTOS_NO_TASKS+1; ++idxTask)
+        rtos_getTaskCpuTime(idxTask, &cpuTime, /* doReset */ true);
+    uint64_t tiStart = ihw_getTimeBase();
+
+    while(rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TIME_IN_MS(TI_CYCLE_MS)))
+    {
+        const uint64_t tiEnd = ihw_getTimeBase()
+                     , tiWorld = tiEnd - tiStart;
+        tiStart = tiEnd;
+
+        for(idxTask=0; idxTask<RTOS_NO_TASKS+1; ++idxTask)
+        {
+            rtos_getTaskCpuTime(idxTask, &cpuTime, /* doReset */ true);
+
+            /* The time base is clocked with 120 MHz. */
+            const unsigned int load = (unsigned int)((1000u*cpuTime.tiCpu + tiWorld/2)
+                                                     / tiWorld
+                                                    );
+            iprintf( "Task %s: CPU load %u.%u%%, activations: %u, max latency: %lu us\r\n"
+                   , taskNameAry[idxTask]
+                   , load/10
+                   , load%10
+                   , cpuTime.noActivations
+                   , (unsigned long)(cpuTime.tiMaxLatency / 120u)
+                   );
+        }
+    }
+
+#undef TI_CYCLE_MS
+} /* End of taskReport */
+
+
+
+
+
 /**
  * The initalization of the RTOS tasks and general board initialization.
  */ 
@@ -262,9 +327,10 @@ void setup(void)
     /* Print standard greeting of RTuinOS applications. */
     iprintf(RTOS_EOL RTOS_RTUINOS_STARTUP_MSG RTOS_EOL);
     
-    /* Configure task 0 of priority class 0 */
+    /* Configure the load producing tasks in priority classes 1..3. The report task has
+       the lowest priority. */
     uint8_t idxTask = 0
-          , idxClass = 0;
+          , idxClass = 1;
     rtos_initializeTask( /* idxTask */          idxTask++
                        , /* taskFunction */     taskT0C0
                        , /* prioClass */        idxClass++
@@ -292,6 +358,15 @@ void setup(void)
                        , /* startByAllEvents */ false
                        , /* startTimeout */     25
                        );
+    rtos_initializeTask( /* idxTask */          idxTask++
+                       , /* taskFunction */     taskReport
+                       , /* prioClass */        0
+                       , /* pStackArea */       &_taskStackReport[0]
+                       , /* stackSize */        sizeof(_taskStackReport)
+                       , /* startEventMask */   RTOS_EVT_ABSOLUTE_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout */     1
+                       );
                        
     /* Test if GCC actually recognizes the constant expression. */
     assert(__builtin_constant_p(TIME_IN_MS(/* tiInMs */ 37)));
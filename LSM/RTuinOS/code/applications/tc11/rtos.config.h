@@ -84,6 +84,11 @@
 #define RTOS_NO_MUTEX_EVENTS    1
 
 
+/** The owner of the mutex inherits the priority of the task of highest priority, which
+    waits for it. Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_MUTEX_PRIORITY_INHERITANCE     RTOS_FEATURE_ON
+
+
 /** The period of the system timer tick is defined here as floating point constant. The
     unit is s. The permitted range is 10us ... 30s. The constant is considered by the
     intialization of the system timer at RTOS initialization time. */
@@ -0,0 +1,463 @@
+/**
+ * @file isb_integerSineBlock.c
+ *   Block processing variant of the sine generator, which is implemented by the Simulink
+ * model integerSineZ. The generated code of the model computes one sample per call of
+ * integerSineZ_step(); its state and output are global data. The per sample overhead of
+ * function call and data access dominates the cost of the tiny arithmetics. The
+ * functions in this module produce a complete block of samples per call and keep the
+ * state in CPU registers while doing so.\n
+ *   The computation is a recursion; sample n depends on samples n-1 and n-2. There's no
+ * parallelism in the computation of a single generator, which could be exploited without
+ * losing bit-exactness with the model. The paired variant isb_generateBlockPair()
+ * therefore computes two independent generators at once, one in each 32 Bit half of the
+ * 64 Bit SPE registers of the e200z4 core.\n
+ *   All functions are bit-exact with integerSineZ_step(). This is proven by the host
+ * test in folder host/integerSineBlock.
+ *   @remark
+ * If the lazy save of the SPE registers is configured, see #INT_USE_LAZY_SPE_SAVE, then
+ * the SPE implementation of isb_generateBlockPair() can be used by all tasks, which have
+ * a save area for the SPE registers, see rtos_setTaskSpeContextSaveArea(). The kernel
+ * enables the SPE on first use. Otherwise, RTuinOS doesn't save the upper halves of the
+ * 64 Bit GPRs on a context switch, the function enables the SPE itself and it must not be
+ * used by more than one task (or interrupt) in an application.
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   isb_initState
+ *   isb_generateBlock
+ *   isb_generateBlockPair
+ * Local functions
+ *   step
+ *   evCreate
+ *   evGetUpper
+ *   evGetLower
+ *   evStep
+ *   enableSpe
+ *   disableSpe
+ *   generateBlockPair
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+
+#include "typ_types.h"
+#include "isb_integerSineBlock.h"
+#if ISB_USE_SPE == 1
+# include <spe.h>
+# include "int_interruptHandler.config.h"
+#endif
+
+
+/*
+ * Defines
+ */
+
+/** The gain of the model, cos(omega) in Q15. */
+#define GAIN_Q15            32188
+
+/** The initial conditions of the model, y(-1) and y(-2), see integerSineZ_initialize(). */
+#define INITIAL_Z1          (-5526)
+#define INITIAL_Z2          (-10856)
+
+/** The MSR bit, which enables the 64 Bit SPE instructions. */
+#define MSR_SPE             0x02000000u
+
+
+/*
+ * Local type definitions
+ */
+
+#if ISB_USE_SPE == 1
+/** A pair of 32 Bit integers in a 64 Bit SPE register. */
+typedef __ev64_opaque__ ev_t;
+#else
+/** A pair of 32 Bit integers. The emulation of the SPE register makes the paired
+    algorithm available on other platforms than the e200z4. */
+typedef struct ev_t
+{
+    int32_t upper, lower;
+
+} ev_t;
+#endif
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * A single step of the generator. This is the arithmetics of integerSineZ_step().
+ *   @return
+ * Get the next sample y(n).
+ *   @param z1
+ * The last recent sample y(n-1).
+ *   @param z2
+ * The sample before, y(n-2).
+ */
+static inline int16_t step(int16_t z1, int16_t z2)
+{
+    return (int16_t)(((int16_t)((int32_t)GAIN_Q15 * (int32_t)z1 >> 15) << 1U) - z2);
+
+} /* End of step */
+
+
+
+#if ISB_USE_SPE == 1
+/**
+ * Load a pair of integers into an SPE register.
+ *   @return
+ * Get the register contents.
+ *   @param upper
+ * The value in the upper half of the register.
+ *   @param lower
+ * The value in the lower half of the register.
+ */
+static inline ev_t evCreate(int32_t upper, int32_t lower)
+{
+    return __ev_create_s32(upper, lower);
+
+} /* End of evCreate */
+
+
+
+/**
+ * Get the upper half of an SPE register.
+ *   @return
+ * Get the 32 Bit value.
+ *   @param ev
+ * The register contents.
+ */
+static inline int32_t evGetUpper(ev_t ev)
+{
+    return __ev_get_upper_s32(ev);
+
+} /* End of evGetUpper */
+
+
+
+/**
+ * Get the lower half of an SPE register.
+ *   @return
+ * Get the 32 Bit value.
+ *   @param ev
+ * The register contents.
+ */
+static inline int32_t evGetLower(ev_t ev)
+{
+    return __ev_get_lower_s32(ev);
+
+} /* End of evGetLower */
+
+
+
+/**
+ * A single step of two generators at a time. The arithmetics of integerSineZ_step() is
+ * done with four SPE instructions:\n
+ *   evmhosmi multiplies the lower 16 Bit of the two words of z1 with the gain. The product
+ * of two 16 Bit operands is the 32 Bit product of the model.\n
+ *   evsrwis and evslwi shift the product right by 15 and back by 1. The model casts the
+ * intermediate result to 16 Bit before shifting left; this is not needed here, the lower
+ * 16 Bit of the shifted word are identical.\n
+ *   evsubfw subtracts z2. The model casts the difference to 16 Bit; again, the lower 16
+ * Bit of the 32 Bit difference are identical. Only the lower halfword of the result is
+ * used: evmhosmi uses only the lower halfwords of its operands and the final outputs are
+ * casted to 16 Bit.
+ *   @return
+ * Get the next two samples y(n) in the lower halfwords of the two words.
+ *   @param z1
+ * The last recent samples y(n-1) in the lower halfwords of the two words.
+ *   @param z2
+ * The samples before, y(n-2), in the lower halfwords of the two words.
+ *   @param gain
+ * The gain of the model in the lower halfwords of the two words.
+ */
+static inline ev_t evStep(ev_t z1, ev_t z2, ev_t gain)
+{
+    const ev_t p = __ev_slwi(__ev_srwis(__ev_mhosmi(z1, gain), 15), 1);
+
+    /* Caution, __ev_subfw(a, b) computes b-a. */
+    return __ev_subfw(z2, p);
+
+} /* End of evStep */
+
+
+
+#if INT_USE_LAZY_SPE_SAVE != 1
+/**
+ * Enable the SPE instructions for the calling context.
+ */
+static inline void enableSpe(void)
+{
+    uint32_t msr;
+    asm volatile ( /* AssemblerTemplate */
+                   "mfmsr %0\n\t"
+                 : /* OutputOperands */ "=r" (msr)
+                 : /* InputOperands */
+                 : /* Clobbers */
+                 );
+    msr |= MSR_SPE;
+    asm volatile ( /* AssemblerTemplate */
+                   "mtmsr %0\n\t"
+                   "isync\n\t"
+                 : /* OutputOperands */
+                 : /* InputOperands */ "r" (msr)
+                 : /* Clobbers */ "memory"
+                 );
+} /* End of enableSpe */
+
+
+
+/**
+ * Disable the SPE instructions for the calling context.
+ */
+static inline void disableSpe(void)
+{
+    uint32_t msr;
+    asm volatile ( /* AssemblerTemplate */
+                   "mfmsr %0\n\t"
+                 : /* OutputOperands */ "=r" (msr)
+                 : /* InputOperands */
+                 : /* Clobbers */ "memory"
+                 );
+    msr &= ~MSR_SPE;
+    asm volatile ( /* AssemblerTemplate */
+                   "mtmsr %0\n\t"
+                   "isync\n\t"
+                 : /* OutputOperands */
+                 : /* InputOperands */ "r" (msr)
+                 : /* Clobbers */ "memory"
+                 );
+} /* End of disableSpe */
+
+#else /* INT_USE_LAZY_SPE_SAVE == 1 */
+
+/* With lazy save of the SPE registers, the kernel owns bit MSR[SPE]. It is cleared on
+   each context switch and set by the SPE unavailable exception after exchanging the SPE
+   registers. Setting it by software would bypass the exchange. */
+static inline void enableSpe(void)
+{
+} /* End of enableSpe */
+
+
+
+static inline void disableSpe(void)
+{
+} /* End of disableSpe */
+#endif /* INT_USE_LAZY_SPE_SAVE != 1 */
+
+#else /* SPE emulation */
+
+static inline ev_t evCreate(int32_t upper, int32_t lower)
+{
+    return (ev_t){.upper = upper, .lower = lower};
+
+} /* End of evCreate */
+
+
+
+static inline int32_t evGetUpper(ev_t ev)
+{
+    return ev.upper;
+
+} /* End of evGetUpper */
+
+
+
+static inline int32_t evGetLower(ev_t ev)
+{
+    return ev.lower;
+
+} /* End of evGetLower */
+
+
+
+/**
+ * Emulation of evStep() for a platform without SPE. The operations are the same; note,
+ * evmhosmi takes the lower 16 Bit of the operands as signed and the word operations wrap
+ * around.
+ */
+static inline ev_t evStep(ev_t z1, ev_t z2, ev_t gain)
+{
+    const int32_t pU = (int32_t)(int16_t)z1.upper * (int32_t)(int16_t)gain.upper
+                , pL = (int32_t)(int16_t)z1.lower * (int32_t)(int16_t)gain.lower;
+    const uint32_t sU = (uint32_t)(pU >> 15) << 1
+                 , sL = (uint32_t)(pL >> 15) << 1;
+    return (ev_t){ .upper = (int32_t)(sU - (uint32_t)z2.upper)
+                 , .lower = (int32_t)(sL - (uint32_t)z2.lower)
+                 };
+} /* End of evStep */
+
+
+
+static inline void enableSpe(void)
+{
+} /* End of enableSpe */
+
+
+
+static inline void disableSpe(void)
+{
+} /* End of disableSpe */
+
+#endif /* ISB_USE_SPE == 1 */
+
+
+
+/**
+ * Initialize the state of a generator. After initialization, the generator produces the
+ * same sequence of samples as the Simulink model integerSineZ after
+ * integerSineZ_initialize().
+ *   @param pState
+ * The state object to initialize.
+ *   @param noSamplesAhead
+ * The state can be advanced by a number of samples. The generator will then produce the
+ * same sequence as the model, but \a noSamplesAhead samples ahead in time. A quarter of
+ * the period of 33.35 samples makes a cosine of a sine generator.
+ */
+void isb_initState(isb_state_t *pState, unsigned int noSamplesAhead)
+{
+    pState->z1 = INITIAL_Z1;
+    pState->z2 = INITIAL_Z2;
+    while(noSamplesAhead-- > 0)
+    {
+        const int16_t y = step(pState->z1, pState->z2);
+        pState->z2 = pState->z1;
+        pState->z1 = y;
+    }
+} /* End of isb_initState */
+
+
+
+/**
+ * Generate a block of samples with a single generator.
+ *   @param pState
+ * The state of the generator. It is read at entry and updated at return.
+ *   @param yAry
+ * The \a noSamples samples are written into this array.
+ *   @param noSamples
+ * The number of samples to produce.
+ */
+void isb_generateBlock(isb_state_t *pState, int16_t yAry[], unsigned int noSamples)
+{
+    /* The state is held in local variables, the compiler will keep them in registers. */
+    int16_t z1 = pState->z1
+          , z2 = pState->z2;
+
+    while(noSamples-- > 0)
+    {
+        const int16_t y = step(z1, z2);
+        *yAry++ = y;
+        z2 = z1;
+        z1 = y;
+    }
+
+    pState->z1 = z1;
+    pState->z2 = z2;
+
+} /* End of isb_generateBlock */
+
+
+
+/**
+ * Generate a block of samples with each of two generators at a time.
+ *   @param pState0
+ * The state of the first generator. It is read at entry and updated at return.
+ *   @param y0Ary
+ * The samples of the first generator are written into this array.
+ *   @param pState1
+ * The state of the second generator. It is read at entry and updated at return.
+ *   @param y1Ary
+ * The samples of the second generator are written into this array.
+ *   @param noSamples
+ * The number of samples to produce per generator.
+ *   @remark
+ * The function must not be inlined: The compiler must not move any SPE instruction in
+ * front of enableSpe() or behind disableSpe().
+ */
+static NO_INLINE void generateBlockPair( isb_state_t *pState0
+                                       , int16_t y0Ary[]
+                                       , isb_state_t *pState1
+                                       , int16_t y1Ary[]
+                                       , unsigned int noSamples
+                                       )
+{
+    const ev_t gain = evCreate(GAIN_Q15, GAIN_Q15);
+    ev_t z1 = evCreate(pState0->z1, pState1->z1)
+       , z2 = evCreate(pState0->z2, pState1->z2);
+
+    while(noSamples-- > 0)
+    {
+        const ev_t y = evStep(z1, z2, gain);
+        *y0Ary++ = (int16_t)evGetUpper(y);
+        *y1Ary++ = (int16_t)evGetLower(y);
+        z2 = z1;
+        z1 = y;
+    }
+
+    pState0->z1 = (int16_t)evGetUpper(z1);
+    pState0->z2 = (int16_t)evGetUpper(z2);
+    pState1->z1 = (int16_t)evGetLower(z1);
+    pState1->z2 = (int16_t)evGetLower(z2);
+
+} /* End of generateBlockPair */
+
+
+
+/**
+ * Generate a block of samples with each of two generators at a time. On the target, the
+ * two generators are computed in the two halves of the 64 Bit SPE registers.
+ *   @param pState0
+ * The state of the first generator. It is read at entry and updated at return.
+ *   @param y0Ary
+ * The \a noSamples samples of the first generator are written into this array.
+ *   @param pState1
+ * The state of the second generator. It is read at entry and updated at return.
+ *   @param y1Ary
+ * The \a noSamples samples of the second generator are written into this array.
+ *   @param noSamples
+ * The number of samples to produce per generator.
+ *   @remark
+ * Without lazy save of the SPE registers, the SPE implementation changes bit MSR[SPE] of
+ * the calling context and the function must not be used by more than one context of the
+ * application. With lazy save, the calling task needs to have a save area for the SPE
+ * registers. See module description.
+ */
+void isb_generateBlockPair( isb_state_t *pState0
+                          , int16_t y0Ary[]
+                          , isb_state_t *pState1
+                          , int16_t y1Ary[]
+                          , unsigned int noSamples
+                          )
+{
+    enableSpe();
+    generateBlockPair(pState0, y0Ary, pState1, y1Ary, noSamples);
+    disableSpe();
+
+} /* End of isb_generateBlockPair */
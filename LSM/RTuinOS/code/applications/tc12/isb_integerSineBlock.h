@@ -0,0 +1,87 @@
+#ifndef ISB_INTEGERSINEBLOCK_INCLUDED
+#define ISB_INTEGERSINEBLOCK_INCLUDED
+/**
+ * @file isb_integerSineBlock.h
+ * Definition of global interface of module isb_integerSineBlock.c
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+
+
+/*
+ * Defines
+ */
+
+/** The paired generator isb_generateBlockPair() is implemented with the SPE instructions
+    of the e200z4 core if this switch is set to 1. Otherwise, or if the compiler doesn't
+    support the SPE, a portable C implementation of the same arithmetics is used. This is
+    the case for the host build of the test of the module, too. */
+#ifndef ISB_USE_SPE
+# ifdef __SPE__
+#  define ISB_USE_SPE   1
+# else
+#  define ISB_USE_SPE   0
+# endif
+#endif
+
+
+/*
+ * Global type definitions
+ */
+
+/** The state of a sine generator. The generator is a second order recursive filter with
+    two unit delays. The state holds the two last recent outputs. */
+typedef struct isb_state_t
+{
+    /** The last recent output, y(n-1). */
+    int16_t z1;
+
+    /** The output before, y(n-2). */
+    int16_t z2;
+
+} isb_state_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize a generator to the state of the Simulink model integerSineZ. */
+void isb_initState(isb_state_t *pState, unsigned int noSamplesAhead);
+
+/** Generate a block of samples with a single generator. */
+void isb_generateBlock(isb_state_t *pState, int16_t yAry[], unsigned int noSamples);
+
+/** Generate a block of samples with each of two generators at a time. */
+void isb_generateBlockPair( isb_state_t *pState0
+                          , int16_t y0Ary[]
+                          , isb_state_t *pState1
+                          , int16_t y1Ary[]
+                          , unsigned int noSamples
+                          );
+
+#endif  /* ISB_INTEGERSINEBLOCK_INCLUDED */
@@ -9,7 +9,11 @@
  * find at least one element in the queue. (As writing to the task and incrementing
  * the semaphore are not atomic, the number of queued data elements can temporarily differ
  * from the number signaled by the semaphore, which doesn't matter because of the strong
- * statement made before.)
+ * statement made before.)\n
+ *   Alternatively, the queue can transfer blocks of #ITQ_NO_ELEMS_PER_BLOCK elements. The
+ * cost of the critical section and of the semaphore is spent only once per block. If the
+ * block interface is used then the semaphore counts blocks rather than elements. The two
+ * interfaces must not be mixed.
  *   @remark The semaphore, which is related to the queue, is defined in tc12_applEvents.h.
  * Neither the relation to the semaphore nor the interface of the queue is designed generic
  * for sake of code reusability; the main intention is to demonstrate the synchronization
@@ -33,6 +37,8 @@
 /* Module interface
  *   itq_writeElem
  *   itq_readElem
+ *   itq_writeBlock
+ *   itq_readBlock
  * Local functions
  */
 
@@ -40,6 +46,7 @@
  * Include files
  */
 
+#include <string.h>
 #include <assert.h>
 
 #include "rtos.h"
@@ -50,6 +57,9 @@
 /*
  * Defines
  */
+
+/** The size of the ring buffer in elements. */
+#define SIZE_OF_RING_BUFFER     256u
  
  
 /*
@@ -69,7 +79,7 @@
 /** The implementation of the queue is most simple using a ring buffer. The size needs to be
     256 as all cyclically incremented index are uint8_t without further masking or modulo
     operations. Therefore we avoid using a macro here. */
-static int16_t _ringBuf[256];
+static int16_t _ringBuf[SIZE_OF_RING_BUFFER];
 
 /** Incremented after writing. FIFO full if new position is equal to _readPos. This is
     considered an error. */
@@ -159,3 +169,72 @@ int16_t itq_readElem(void)
 
 
 
+/**
+ * Append a block of elements to the queue. This is the block processing variant of
+ * itq_writeElem(): The block is copied into the queue in a single critical section and the
+ * related semaphore is incremented once per block. An assertion fires if the queue would
+ * overrun.
+ *   @param blockAry
+ * The block of #ITQ_NO_ELEMS_PER_BLOCK elements, which is appended to the queue.
+ *   @remark
+ * The element and the block interface must not be used both for the same queue.
+ *   @see void itq_readBlock(int16_t [])
+ */
+
+void itq_writeBlock(const int16_t blockAry[ITQ_NO_ELEMS_PER_BLOCK])
+{
+    _Static_assert( SIZE_OF_RING_BUFFER == 256u
+                    &&  SIZE_OF_RING_BUFFER % ITQ_NO_ELEMS_PER_BLOCK == 0
+                  , "Block size doesn't fit into the ring buffer"
+                  );
+
+    rtos_enterCriticalSection();
+    {
+        /* All blocks start at a multiple of the block size. A block never wraps around at
+           the end of the ring buffer and it can be copied at once. */
+        assert(_writePos % ITQ_NO_ELEMS_PER_BLOCK == 0);
+
+        /* See itq_writeElem: An overrun is a failure in this test case. The queue is full
+           if the write position would reach the read position. */
+        assert((uint8_t)(_readPos - _writePos) == 0
+               ||  (uint8_t)(_readPos - _writePos) > ITQ_NO_ELEMS_PER_BLOCK
+              );
+
+        memcpy(&_ringBuf[_writePos], &blockAry[0], ITQ_NO_ELEMS_PER_BLOCK*sizeof(int16_t));
+        _writePos += ITQ_NO_ELEMS_PER_BLOCK;
+    }
+    rtos_leaveCriticalSection();
+
+    /* See itq_writeElem: Signaling the new data needs not be atomic with queuing. */
+    rtos_sendEvent(EVT_SEMAPHORE_ELEM_IN_QUEUE);
+
+} /* End of itq_writeBlock */
+
+
+
+
+/**
+ * Read the next block of elements from the queue. The caller of the function needs to
+ * have the related semaphore acquired; this guarantees the availability of at least one
+ * block in the queue. An assertion fires if not.
+ *   @param blockAry
+ * The block of #ITQ_NO_ELEMS_PER_BLOCK elements is read from the queue into this array.
+ *   @see void itq_writeBlock(const int16_t [])
+ */
+
+void itq_readBlock(int16_t blockAry[ITQ_NO_ELEMS_PER_BLOCK])
+{
+    rtos_enterCriticalSection();
+    {
+        assert(_writePos != _readPos  &&  _readPos % ITQ_NO_ELEMS_PER_BLOCK == 0);
+
+        memcpy(&blockAry[0], &_ringBuf[_readPos], ITQ_NO_ELEMS_PER_BLOCK*sizeof(int16_t));
+        _readPos += ITQ_NO_ELEMS_PER_BLOCK;
+    }
+    rtos_leaveCriticalSection();
+
+} /* End of itq_readBlock */
+
+
+
+
@@ -24,11 +24,18 @@
  * Include files
  */
 
+#include <stdint.h>
+
 
 /*
  * Defines
  */
 
+/** The number of elements of a block, which is transferred by itq_writeBlock() and
+    itq_readBlock(). The size of the queue, 256 elements, needs to be a multiple of the
+    block size. */
+#define ITQ_NO_ELEMS_PER_BLOCK  8u
+
 
 /*
  * Global type definitions
@@ -46,6 +53,8 @@
 
 void itq_writeElem(int16_t queuedElem);
 int16_t itq_readElem(void);
+void itq_writeBlock(const int16_t blockAry[ITQ_NO_ELEMS_PER_BLOCK]);
+void itq_readBlock(int16_t blockAry[ITQ_NO_ELEMS_PER_BLOCK]);
 
 
 #endif  /* ITQ_INTERTASKQUEUE_INCLUDED */
@@ -23,7 +23,10 @@
  *   @remark: This application produces a lot of screen output and requires a terminal Baud
  * rate higher then the standard setting. It'll produce a lot of trash in the Arduino
  * console window if you do not switch the Baud rate in Arduino's Serial Monitor to 115200
- * Baud. See setup() for more.
+ * Baud. See setup() for more.\n
+ *   The application can be compiled with block processing, see #USE_BLOCK_PROCESSING. The
+ * producer then computes blocks of samples of two sine generators at a time and the queue
+ * transfers complete blocks.
  *
  * Copyright (C) 2013-2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -62,6 +65,7 @@
 #include "mai_main.h"
 #include "rtos.h"
 #include "integerSineZ.h"
+#include "isb_integerSineBlock.h"
 #include "gsl_systemLoad.h"
 #include "itq_interTaskQueue.h"
 #include "aev_applEvents.h"
@@ -71,6 +75,19 @@
  * Defines
  */
 
+/** The producer can either compute and queue single samples of the Simulink model
+    integerSineZ or blocks of samples of two generators, which are computed at once with
+    module isb_integerSineBlock. Set this switch to 1 for block processing. */
+#define USE_BLOCK_PROCESSING    1
+
+/** In block processing mode, the queued block contains the same number of samples of
+    either generator. */
+#define NO_SAMPLES_PER_BLOCK    (ITQ_NO_ELEMS_PER_BLOCK/2u)
+
+/** The second generator runs ahead of the first one by a quarter of its period of 33.35
+    samples: We get a cosine. */
+#define NO_SAMPLES_COSINE_AHEAD 8u
+
 /** The number of interrupt levels, we use in this application is required for an
     estimation of the appropriate stack sizes.\n
       We have 2 interrupts for the serial interface and the RTOS system timer. */
@@ -128,7 +145,8 @@ static volatile unsigned int _cpuLoad = 1000;
  
  
 /** The semaphore of type uint8_t counts the number of samples in the queue, which are
-    already produced but not yet consumed. The start value needs to be null.
+    already produced but not yet consumed. In block processing mode it counts the blocks.
+    The start value needs to be null.
       @remark Although this variable is shared between tasks and although its value is
    shared by others tasks it must not be declared as volatile. Actually, no task will
    directly read or write to this variable, tasks do this only indirectly by calling the
@@ -136,6 +154,18 @@ static volatile unsigned int _cpuLoad = 1000;
 unsigned int rtos_semaphoreAry[RTOS_NO_SEMAPHORE_EVENTS] =
                                             {[0 ... RTOS_NO_SEMAPHORE_EVENTS-1] = 0};
 
+#if USE_BLOCK_PROCESSING == 1
+/** The states of the two generators in block processing mode. */
+static isb_state_t _stateSine
+                 , _stateCosine;
+
+# if INT_USE_LAZY_SPE_SAVE == 1
+/** The producer uses the SIMD instructions. With lazy save of the SPE registers, it needs
+    a save area for these registers. */
+static int_speContextSaveArea_t _speContextSaveAreaT0C0;
+# endif
+#endif
+
 
 /*
  * Function implementation
@@ -175,6 +205,27 @@ static void taskT0C0_producer()
           );
     tiLastCall_ = tiNow;
     
+#if USE_BLOCK_PROCESSING == 1
+    /* Produce a block of data. The first half of the block holds the samples of the sine
+       and the second half those of the cosine. */
+    int16_t blockAry[ITQ_NO_ELEMS_PER_BLOCK];
+    isb_generateBlockPair( &_stateSine
+                         , &blockAry[0]
+                         , &_stateCosine
+                         , &blockAry[NO_SAMPLES_PER_BLOCK]
+                         , NO_SAMPLES_PER_BLOCK
+                         );
+
+    /* Queue the data. See below, the only difference is that the semaphore now counts
+       blocks. */
+    itq_writeBlock(blockAry);
+
+    printf( "  Queued data samples %8lu..%8lu" RTOS_EOL
+          , cnt_
+          , cnt_ + NO_SAMPLES_PER_BLOCK - 1u
+          );
+    cnt_ += NO_SAMPLES_PER_BLOCK;
+#else
     /* Produce data. */
     integerSineZ_step();
     int16_t nextSampleSine = integerSineZ_Y.y;
@@ -188,6 +239,7 @@ static void taskT0C0_producer()
     
     /* Do some more reporting after task switch hence and force. We still own the mutex. */
     printf("  Queued data sample %8lu = %.6f" RTOS_EOL, cnt_++, f2d(nextSampleSine/32768.0));
+#endif
     
     /* We need to release the mutex, so that the consumer can report its activities. */
     rtos_sendEvent(EVT_MUTEX_SERIAL);
@@ -210,7 +262,12 @@ static void tT0C0(uint32_t initCondition ATTRIB_UNUSED)
 #define TASK_TIME  120  /* ms */
 
     /* Initialize the external sinus generator module. */
+#if USE_BLOCK_PROCESSING == 1
+    isb_initState(&_stateSine, /* noSamplesAhead */ 0);
+    isb_initState(&_stateCosine, NO_SAMPLES_COSINE_AHEAD);
+#else
     integerSineZ_initialize();
+#endif
 
     /* The basic pattern is to run the producer task function regularly. */
     do
@@ -284,6 +341,21 @@ static void taskT0C1_consumer(uint32_t eventToWaitForVec)
            producer. */
         do
         {
+#if USE_BLOCK_PROCESSING == 1
+            int16_t blockAry[ITQ_NO_ELEMS_PER_BLOCK];
+            itq_readBlock(blockAry);
+            unsigned int u;
+            for(u=0; u<NO_SAMPLES_PER_BLOCK; ++u)
+            {
+                ++ noElemGot;
+                printf( "  Received data sample %6lu = %.6f, %.6f" RTOS_EOL
+                      , cnt_
+                      , f2d(blockAry[u]/32768.0)
+                      , f2d(blockAry[NO_SAMPLES_PER_BLOCK+u]/32768.0)
+                      );
+                ++ cnt_;
+            }
+#else
             int16_t nextSampleSine = itq_readElem();
             ++ noElemGot;
             printf( "  Received data sample %6lu = %.6f" RTOS_EOL
@@ -291,6 +363,7 @@ static void taskT0C1_consumer(uint32_t eventToWaitForVec)
                   , f2d(nextSampleSine/32768.0)
                   );
             ++ cnt_;
+#endif
 
             /* The while condition of this loop necessarily needs to use a timeout: If data
                is available in the queue, rtos_waitForEvent will return immediately with
@@ -357,6 +430,9 @@ void setup(void)
                        , /* startByAllEvents */ false
                        , /* startTimeout */     0
                        );
+#if USE_BLOCK_PROCESSING == 1  &&  INT_USE_LAZY_SPE_SAVE == 1
+    rtos_setTaskSpeContextSaveArea(_idxTaskT0C0, &_speContextSaveAreaT0C0);
+#endif
 
     /* Configure task 0 of priority class 1. The consumer has the higher priority. It is
        started by: Data available AND access to object Serial granted. */
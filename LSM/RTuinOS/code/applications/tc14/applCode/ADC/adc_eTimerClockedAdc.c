@@ -84,6 +84,8 @@
 /* Module interface
  *   adc_initDriver
  *   adc_startConversions
+ *   adc_getLatestSnapshot
+ *   adc_isSnapshotValid
  *   adc_getChannelRawValue
  *   adc_getChannelVoltage
  *   adc_getTsens0
@@ -93,6 +95,7 @@
  *   initCTU
  *   compileAdcCommandList
  *   initADC
+ *   publishSnapshot
  *   isrCtuAllConversionsDone
  */
 
@@ -183,6 +186,14 @@ static unsigned short _ageOfConversionResults = USHRT_MAX;
     ADC_1. */
 static uint16_t _conversionResAry[ADC_NO_ACTIVE_CHNS] = {[0 ... ADC_NO_ACTIVE_CHNS-1] = 0};
 
+/** The ring of snapshots of the conversion results. The end-of-conversion interrupt
+    overwrites the oldest one in every cycle; the clients read them in place. */
+static adc_snapshot_t _snapshotAry[ADC_NO_SNAPSHOTS];
+
+/** The sequence number of the last recently completed snapshot or zero if there is no
+    snapshot yet. The number selects the snapshot in \a _snapshotAry. */
+static volatile uint32_t _seqNoLatestSnapshot = 0;
+
 #if ADC_USE_ADC_0_CHANNEL_10 == 1
 /** The averaged and scaled reading of channel 10, ADC_0, which is internally connected to
     signal VREG_1.2V. */
@@ -699,7 +710,54 @@ static void initADC(unsigned int idxAdc)
 
 
 
-/// @todo doc
+/**
+ * Publish the results of the current conversion cycle as a new snapshot. The oldest
+ * snapshot in the ring is overwritten. Its sequence number is reset before and set after
+ * the update of the results; a client, which still uses the overwritten snapshot,
+ * recognizes this from the changed sequence number, see adc_isSnapshotValid().\n
+ *   The function is called from the end-of-conversion interrupt. Clients can't preempt it
+ * and will never see a partly written snapshot as the latest one.
+ */
+static inline void publishSnapshot(void)
+{
+    _Static_assert( ADC_NO_SNAPSHOTS >= 2
+                    &&  (ADC_NO_SNAPSHOTS & (ADC_NO_SNAPSHOTS-1)) == 0
+                    &&  sizeOfAry(_snapshotAry[0].rawValueAry) == ADC_NO_ACTIVE_CHNS
+                  , "Bad configuration of snapshot ring"
+                  );
+
+    /* Zero is reserved for invalid snapshots; it is skipped on wrap-around. */
+    uint32_t seqNo = _seqNoLatestSnapshot + 1u;
+    if(seqNo == 0)
+        seqNo = 1u;
+
+    adc_snapshot_t * const pSnapshot = &_snapshotAry[seqNo & (ADC_NO_SNAPSHOTS-1u)];
+    pSnapshot->seqNo = 0;
+    atomic_thread_fence(memory_order_release);
+
+    pSnapshot->age = _ageOfConversionResults;
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<ADC_NO_ACTIVE_CHNS; ++idxChn)
+        pSnapshot->rawValueAry[idxChn] = _conversionResAry[idxChn];
+
+    atomic_thread_fence(memory_order_release);
+    pSnapshot->seqNo = seqNo;
+    _seqNoLatestSnapshot = seqNo;
+
+} /* End of publishSnapshot */
+
+
+
+/**
+ * The end-of-conversion interrupt. It fetches the results from the ADCs, does the
+ * diagnosis, publishes a new snapshot of the results and notifies the client code.
+ *   @return
+ * Only for kernel relevant interrupt: The value returned by the client's notification
+ * callback, which decides about a context switch.
+ *   @param pCmdContextSwitch
+ * Only for kernel relevant interrupt: Passed through to the client's notification
+ * callback.
+ */
 #if ADC_ENABLE_INTERRUPT_AS_KERNEL_RELEVANT != 0
 static uint32_t isrCtuAllConversionsDone(int_cmdContextSwitch_t *pCmdContextSwitch)
 #else
@@ -817,6 +875,9 @@ static void isrCtuAllConversionsDone(void)
         if(ageOfConversionResults != 0)
             _ageOfConversionResults = ageOfConversionResults;
     }
+
+    /* Make the results available to the clients, which read them without locking. */
+    publishSnapshot();
     
     /* Clear the interrupt flag to be ready for the next conversion cycle. */
     assert(CTU_0.CTUIFR.B.T1_I == 1);
@@ -1022,6 +1083,60 @@ unsigned short adc_getChannelAge()
 
 
 
+/**
+ * Get the snapshot of the results of the last recent conversion cycle. The results of all
+ * channels are coherent, they stem from the same cycle. The snapshot is not copied, the
+ * client code reads it in place.\n
+ *   The function can be called from any task or interrupt context. It doesn't lock; no
+ * critical section is required. Instead, the client code needs to call
+ * adc_isSnapshotValid() after having read the required data from the snapshot. If this
+ * function returns \a false then the driver has overwritten the snapshot meanwhile and
+ * the read data needs to be discarded.
+ *   @return
+ * Get the pointer to the snapshot or NULL if no conversion cycle has completed yet.
+ *   @param pSeqNo
+ * The sequence number of the returned snapshot is placed in * \a pSeqNo. It is required
+ * for the later call of adc_isSnapshotValid(). Moreover, the client code can compare the
+ * sequence numbers of subsequent calls to recognize conversion cycles, which it has missed.
+ *   @remark
+ * The snapshot stays valid for at least #ADC_NO_SNAPSHOTS-1 conversion cycles. A task,
+ * which is triggered by the end-of-conversion callback, normally completes its work on
+ * the snapshot long before.
+ */
+const adc_snapshot_t *adc_getLatestSnapshot(uint32_t *pSeqNo)
+{
+    const uint32_t seqNo = _seqNoLatestSnapshot;
+    atomic_thread_fence(memory_order_acquire);
+
+    *pSeqNo = seqNo;
+    if(seqNo != 0)
+        return &_snapshotAry[seqNo & (ADC_NO_SNAPSHOTS-1u)];
+    else
+        return NULL;
+
+} /* End of adc_getLatestSnapshot */
+
+
+
+/**
+ * Check if a snapshot, which had been got by adc_getLatestSnapshot(), is still valid.
+ *   @return
+ * Get \a true if the snapshot has not been overwritten by the driver since it had been
+ * got. All data read from the snapshot before is coherent and can be used.
+ *   @param pSnapshot
+ * The snapshot as returned by adc_getLatestSnapshot().
+ *   @param seqNo
+ * The sequence number as returned by adc_getLatestSnapshot() together with \a pSnapshot.
+ */
+bool adc_isSnapshotValid(const adc_snapshot_t *pSnapshot, uint32_t seqNo)
+{
+    atomic_thread_fence(memory_order_acquire);
+    return seqNo != 0  &&  pSnapshot->seqNo == seqNo;
+
+} /* End of adc_isSnapshotValid */
+
+
+
 /**
  * Get the last recent uncalibrated conversion result for a single channel. (See
  * adc_getChannelVoltage() and adc_getChannelVoltageAbdAge() for getting calibrated
@@ -137,6 +137,12 @@
     from the same conversion cycle. */
 #define ADC_FILTER_COEF_VREG_1_2V   (0.99f)
 
+/** The number of snapshots of the conversion results, which are held by the driver for
+    lock-free reading, see adc_getLatestSnapshot(). The driver overwrites the oldest
+    snapshot in every conversion cycle; a client can use a snapshot in place for up to
+    #ADC_NO_SNAPSHOTS-1 conversion cycles. The number needs to be a power of two. */
+#define ADC_NO_SNAPSHOTS            4
+
 
 #if ADC_ENABLE_FOR_BUILD_WITH_KERNEL_BUILDER != 0
 # include "int_interruptHandler.h"
@@ -274,6 +280,25 @@ typedef enum adc_idxEnabledChannel_t
 } adc_idxEnabledChannel_t;
 
 
+/** A snapshot of the conversion results of all enabled channels, which have been acquired
+    in one and the same conversion cycle. The snapshots are owned and written by the
+    driver; clients get read access in place, see adc_getLatestSnapshot(). */
+typedef struct adc_snapshot_t
+{
+    /** The sequence number of the conversion cycle, which the results belong to. The
+        numbers are counted from one; zero means that the snapshot is currently being
+        rewritten by the driver. */
+    volatile uint32_t seqNo;
+
+    /** The age of the results, see adc_getChannelAge(). */
+    unsigned short age;
+
+    /** The uncalibrated results of all channels, see adc_getChannelRawValue(). */
+    uint16_t rawValueAry[adc_linkElement1];
+
+} adc_snapshot_t;
+
+
 /*
  * Global data declarations
  */
@@ -296,6 +321,12 @@ void adc_startConversions(void);
 /** Validity of channel results: Get the age of the currently available results. */
 unsigned short adc_getChannelAge(void);
 
+/** Get the snapshot of the results of the last recent conversion cycle for in place use. */
+const adc_snapshot_t *adc_getLatestSnapshot(uint32_t *pSeqNo);
+
+/** Check if a snapshot has not been overwritten since it had been got. */
+bool adc_isSnapshotValid(const adc_snapshot_t *pSnapshot, uint32_t seqNo);
+
 /** Get the last recent uncalibrated conversion result for a single channel. */
 uint16_t adc_getChannelRawValue(adc_idxEnabledChannel_t idxChn);
 
@@ -86,9 +86,10 @@ static unsigned int _idxDisplayedAdcChn = adc_adc0_idxChn10;
  * End of conversion callback: This function is called from the ADC driver every time a new
  * ADC sample result is available. The function is executed in the context of the ADC
  * interrupt. The driver is configured to use a kernel interrupt, which gives us the chance
- * to send an event from the callback. A task is configured to be activated by this event.
- * It'll run synchronously with the ADC conversion cycle and can process the result data
- * coherently.
+ * to send events from the callback. The tasks, which consume the ADC results, are
+ * configured to be activated by these events. They'll run synchronously with the ADC
+ * conversion cycle and can process the result data coherently, see
+ * #EVT_VEC_ADC_NEW_SAMPLE_SET and adc_getLatestSnapshot().
  *   @return
  * A kernel interrupt returns \a true if it initiates a task switch and \a false if it
  * should continue the preempted context as an ordinary interrupt generally does.
@@ -108,7 +109,7 @@ static uint32_t onEndOfConversion(int_cmdContextSwitch_t *pCmdContextSwitch)
        interrupt (system call) but here we are already inside an interrupt. A system call
        from here would crash the system. Instead, we call the kernel function, which is
        called by the system call implementation, too. */
-    return rtos_sc_sendEvent(pCmdContextSwitch, /* eventVec */ EVT_ADC_CONVERSION_COMPLETE);
+    return rtos_sc_sendEvent(pCmdContextSwitch, /* eventVec */ EVT_VEC_ADC_NEW_SAMPLE_SET);
 
 } /* End of onEndOfConversion */
 
@@ -48,6 +48,18 @@
 /** An ordinary event is used to signal a new ADC conversion result. */
 #define EVT_ADC_CONVERSION_COMPLETE         (RTOS_EVT_EVENT_04)
 
+/** An ordinary event is used to signal a new ADC conversion result to the monitoring
+    task. */
+#define EVT_ADC_TRIGGER_TASK_MONITOR        (RTOS_EVT_EVENT_05)
+
+/** The set of events, which is posted by the ADC end-of-conversion interrupt. Every task,
+    which consumes the ADC results, has its own event in this set; tasks are connected to
+    or disconnected from the conversion cycle by adding or removing their event here. All
+    of them read the same snapshot of results, see adc_getLatestSnapshot(). */
+#define EVT_VEC_ADC_NEW_SAMPLE_SET          (EVT_ADC_CONVERSION_COMPLETE                    \
+                                             | EVT_ADC_TRIGGER_TASK_MONITOR                 \
+                                            )
+
 
 /*
  * Global type definitions
@@ -39,7 +39,7 @@
 /** Number of tasks in the system. Tasks aren't created dynamically. This number of tasks
     will always be existent and alive. Permitted range is 0..127.\n
       A runtime check is not done. The code will crash in case of a bad setting. */
-#define RTOS_NO_TASKS    5
+#define RTOS_NO_TASKS    6
 
 
 /** Number of distinct priorities of tasks. Since several tasks may share the same
@@ -73,6 +73,9 @@
  * *) A totally asynchronous, irregular task also competes for the display. The idle task
  * estimates the CPU load and an associated display task of low priority prints the result
  * on the LCD.\n
+ * *) Two tasks of different priority consume the same ADC results. The ADC interrupt
+ * posts an event to each of them and they read the results from a snapshot of the ADC
+ * driver in place, without copying and without a critical section.\n
  *
  *   TRK-USB-MPC5643L port:\n
  *
@@ -132,6 +135,7 @@
  *   taskIdleFollower
  *   taskButton
  *   taskDisplayVoltage
+ *   taskMonitorAdc
  */
 
 /*
@@ -165,6 +169,7 @@ enum { idxTaskOnADCComplete
      , idxTaskIdleFollower
      , idxTaskButton
      , idxTaskDisplayVoltage
+     , idxTaskMonitorAdc
      , noTasks
      };
 
@@ -201,11 +206,19 @@ static _Alignas(uint64_t) uint8_t _stackTaskOnADCComplete[STACK_SIZE_IN_BYTE]
                                 , _stackTaskRTC[STACK_SIZE_IN_BYTE]
                                 , _stackTaskIdleFollower[STACK_SIZE_IN_BYTE]
                                 , _stackTaskButton[STACK_SIZE_IN_BYTE]
-                                , _stackTaskDisplayVoltage[STACK_SIZE_IN_BYTE];
+                                , _stackTaskDisplayVoltage[STACK_SIZE_IN_BYTE]
+                                , _stackTaskMonitorAdc[STACK_SIZE_IN_BYTE];
 
 /* Results of the idle task. */
 volatile unsigned int _cpuLoad = 1000;
 
+/* Results of the ADC monitoring task: The range of the temperature voltage from u4 and
+   the number of missed and discarded snapshots of ADC results. */
+static volatile uint16_t _adcMinU4 = UINT16_MAX
+                       , _adcMaxU4 = 0;
+static volatile uint32_t _noMissedAdcSnapshots = 0
+                       , _noDiscardedAdcSnapshots = 0;
+
 
 /*
  * Function implementation
@@ -377,6 +390,60 @@ static void taskDisplayVoltage(uint32_t initialResumeCondition ATTRIB_DBG_ONLY)
 
 
 
+/**
+ * A second consumer of the ADC conversion results besides taskOnADCComplete. It is
+ * triggered by the same end-of-conversion interrupt but has a lower priority. The task
+ * tracks the range of the temperature voltage from u4. It demonstrates the use of the
+ * snapshots of the ADC driver: The results are read in place and without a critical
+ * section. The sequence number tells if the task has missed conversion cycles and if the
+ * driver has overwritten the snapshot while the task was still reading it.
+ *   @param initialResumeCondition
+ * The vector of events which made the task due the very first time.
+ */
+
+static void taskMonitorAdc(uint32_t initialResumeCondition ATTRIB_DBG_ONLY)
+{
+    assert(initialResumeCondition == EVT_ADC_TRIGGER_TASK_MONITOR);
+
+    uint32_t seqNoLast = 0;
+    do
+    {
+        uint32_t seqNo;
+        const adc_snapshot_t * const pSnapshot = adc_getLatestSnapshot(&seqNo);
+        if(pSnapshot != NULL  &&  seqNo != seqNoLast)
+        {
+            if(seqNoLast != 0)
+                _noMissedAdcSnapshots += seqNo - seqNoLast - 1u;
+            seqNoLast = seqNo;
+
+            const uint16_t adcU4 = pSnapshot->rawValueAry[adc_adc0_idxChn01];
+            const bool isUpToDate = pSnapshot->age == 0;
+
+            /* The read data must not be used if the driver has overwritten the snapshot
+               meanwhile. */
+            if(adc_isSnapshotValid(pSnapshot, seqNo))
+            {
+                if(isUpToDate)
+                {
+                    if(adcU4 < _adcMinU4)
+                        _adcMinU4 = adcU4;
+                    if(adcU4 > _adcMaxU4)
+                        _adcMaxU4 = adcU4;
+                }
+            }
+            else
+                ++ _noDiscardedAdcSnapshots;
+        }
+    }
+    while(rtos_waitForEvent(EVT_ADC_TRIGGER_TASK_MONITOR, /* all */ false, 0));
+    assert(false);
+
+} /* End of taskMonitorAdc */
+
+
+
+
+
 /**
  * The initalization of the RTOS tasks and general board initialization.
  */
@@ -443,6 +510,18 @@ void setup()
                        , /* startTimeout */     0
                        );
     
+    /* Configure the ADC monitoring task. It is triggered by the ADC interrupt, too, but has
+       a lower priority than the interrupt task. */
+    rtos_initializeTask( /* idxTask */          idxTaskMonitorAdc
+                       , /* taskFunction */     taskMonitorAdc
+                       , /* prioClass */        1
+                       , /* pStackArea */       &_stackTaskMonitorAdc[0]
+                       , /* stackSize */        sizeof(_stackTaskMonitorAdc)
+                       , /* startEventMask */   EVT_ADC_TRIGGER_TASK_MONITOR
+                       , /* startByAllEvents */ false
+                       , /* startTimeout */     0
+                       );
+
     /* Initialize other modules. */
     tac_initTestAndCalibrationDataAry();
     init_button();    
@@ -504,6 +583,10 @@ void loop()
     uint8_t hour = clk_noHour
           , min  = clk_noMin
           , sec  = clk_noSec;
+    uint16_t adcMinU4 = _adcMinU4
+           , adcMaxU4 = _adcMaxU4;
+    uint32_t noMissedAdcSnapshots = _noMissedAdcSnapshots
+           , noDiscardedAdcSnapshots = _noDiscardedAdcSnapshots;
     ihw_resumeAllInterrupts();
 
     iprintf("At %02u:%02u:%02u:" RTOS_EOL, hour, min, sec);
@@ -517,6 +600,13 @@ void loop()
           , f2d(adc_getTsens0())
           , f2d(adc_getTsens1())
           );
+    printf( "Range of u4: %.4f .. %.4f V, missed/discarded ADC snapshots: %lu/%lu"
+            RTOS_EOL
+          , f2d(ADC_SCALING_BIN_TO_V(adcMinU4))
+          , f2d(ADC_SCALING_BIN_TO_V(adcMaxU4))
+          , noMissedAdcSnapshots
+          , noDiscardedAdcSnapshots
+          );
     assert(rtos_getTaskOverrunCounter(/* idxTask */ idxTaskRTC, /* doReset */ false) == 0);
     
     uint8_t u;
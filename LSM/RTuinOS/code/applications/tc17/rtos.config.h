@@ -0,0 +1,218 @@
+#ifndef RTOS_CONFIG_INCLUDED
+#define RTOS_CONFIG_INCLUDED
+/**
+ * @file rtos.config.h
+ * Switches to define the most relevant compile-time settings of RTuinOS in an application
+ * specific way.
+ *
+ * Copyright (C) 2012-2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+
+/*
+ * Defines
+ */
+
+/** Does the task scheduling concept support time slices of limited length for activated
+    tasks? If on, the overhead of the scheduler slightly increases.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_ROUND_ROBIN_MODE_SUPPORTED     RTOS_FEATURE_OFF
+
+
+/** Number of tasks in the system. Tasks aren't created dynamically. This number of tasks
+    will always be existent and alive. Permitted range is 0..127.\n
+      A runtime check is not done. The code will crash in case of a bad setting. */
+#define RTOS_NO_TASKS   4
+
+
+/** Number of distinct priorities of tasks. Since several tasks may share the same
+    priority, this number is lower or equal to NO_TASKS. Permitted range is 0..NO_TASKS,
+    but 1..NO_TASKS if at least one task is defined. The number must not exceed 32.\n
+      A runtime check is not done. The code will crash in case of a bad setting. */
+#define RTOS_NO_PRIO_CLASSES    3
+
+
+/** The maximum number of tasks belonging to the same priority class. The setting is no
+    longer used by the kernel; the due tasks of a class are held in a linked list rather
+    than in an array of this size. The definition is kept for compatibility with existing
+    configuration files. */
+#define RTOS_MAX_NO_TASKS_IN_PRIO_CLASS 2
+
+
+/** The number of events, which behave like semaphores. When posted, they are not
+    broadcasted like ordinary events but only posted to the very task, which is the one of
+    highest priority that is currently waiting for this event. If no such task exists,
+    the semaphore-event is counted in the related semaphore for future requests of the
+    semaphore by any task.\n
+      Having semaphores in the application increases the overhead of RTuinOS significantly.
+    The number should be zero as long as semaphores are not essential to the application.
+    In particular, one should not use semaphores where mutexes suffice. Mutexes are a
+    sub-set of semaphores; it are semaphores with start value one and they can be
+    implemented much more efficient by bit operations.
+      The use case of a semaphore pre-determines its initial value. To make it most easy
+    and efficient for the application the array of semaphores is declared extern to
+    RTuinOS. Please refer to rtos.h for the declaration of \a rtos_semaphoreAry and define
+    \b and \b initialize this array in your application code. */
+#define RTOS_NO_SEMAPHORE_EVENTS    0
+
+
+/** The number of events, which behave like mutexes. When posted, they are not broadcasted
+    like ordinary events but only posted to the very task, which is the one of highest
+    priority that is currently waiting for this event. If no such task exists, the
+    mutex-event is saved until the first task requests it.\n
+      Having mutexes in the application increases the overhead of RTuinOS. It should be
+    zero as long as mutexes are not essential to the application. */
+#define RTOS_NO_MUTEX_EVENTS    0
+
+
+/** Priority inheritance for mutexes. If on, a task, which owns a mutex, temporarily
+    inherits the priority class of the task of highest priority, which waits for this
+    mutex. The inherited priority is passed on along a chain of tasks, which own a mutex
+    and wait for another one, and it is withdrawn when the mutex is released. A task of
+    medium priority can then no longer delay a high priority waiter for an unbounded time
+    (priority inversion).\n
+      The switch has an effect only if #RTOS_NO_MUTEX_EVENTS is greater than zero. The
+    kernel records the owner of each mutex; a mutex should be released only by the task,
+    which had acquired it. The overhead of acquiring and releasing a mutex increases
+    moderately.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_MUTEX_PRIORITY_INHERITANCE     RTOS_FEATURE_OFF
+
+
+/** The number of message queues. Each queue occupies an event; the queue events follow
+    the mutex events in the event vector. Tasks exchange messages with the system calls
+    rtos_sendToQueue() and rtos_receiveFromQueue(), which block on a full or empty queue.
+    The message is copied from the sender directly to a waiting receiver and vice versa,
+    no additional semaphore is needed.\n
+      The queues are declared extern to RTuinOS. Please refer to rtos.h for the
+    declaration of \a rtos_queueAry and define \b and \b initialize this array in your
+    application code. */
+#define RTOS_NO_QUEUE_EVENTS    4
+
+
+/** The period of the system timer tick is defined here as floating point constant. The
+    unit is s. The permitted range is 10us ... 30s. The constant is considered by the
+    intialization of the system timer at RTOS initialization time. */
+#define RTOS_TICK (1e-3f)
+
+
+/** Tickless idle mode. If on, the system timer skips the ticks, in which only the idle
+    task is ready and no timer elapses. The interrupt load of a mostly idle system drops
+    and the idle task gets the time for background computations. The decision is taken in
+    the system timer interrupt; if the last task suspends between two ticks then the next
+    tick still occurs. A task, which is made due by an interrupt or by the idle task, ends
+    the skipping immediately.\n
+      The skipped ticks are clocked when the idle period ends, either by the system timer
+    interrupt or by the interrupt or system call, which makes a task due. The kernel's time
+    lags behind in between but no task can see the stale value; only the idle task runs
+    and the kernel has no function to read its time. Timers and timeouts are unaffected.
+    Time stamps taken by the application from the CPU's time base are unaffected, too.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_TICKLESS_IDLE      RTOS_FEATURE_OFF
+
+
+/** The timer slack in tickless idle mode in system timer ticks. When the ticks are skipped
+    till the next timer elapses then the timers, which elapse up to this number of ticks
+    later, are delayed and coalesced with the first one; all of them elapse in the same
+    interrupt. Set to zero to have all timers elapse in time. The setting is irrelevant if
+    #RTOS_TICKLESS_IDLE is off. */
+#define RTOS_TICKLESS_IDLE_SLACK    0
+
+
+/** Measure the CPU time of the tasks. If on, the kernel reads the CPU's time base at each
+    task switch. It accumulates the execution time of the tasks, counts their activations
+    and records the longest time span from becoming due till running. The figures are
+    queried with rtos_getTaskCpuTime().
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_MEASURE_TASK_CPU_TIME  RTOS_FEATURE_OFF
+
+
+/** Enable the application defined interrupt 0. (Two such interrupts are pre-configured in
+    the code and more can be implemented by taking these two as a code template.)\n
+      To install the application interrupt this define is set to #RTOS_FEATURE_ON.\n
+      Secondary, you will define #RTOS_ISR_USER_00 in order to specify the interrupt
+    source and #RTOS_ISR_USER_00_ACKNOWLEDGE_IRQ to specify some interrupt source dependent
+    code.\n
+      Then, you will implement the callback \a rtos_enableIRQUser00(void) which enables the
+    interrupt, typically by accessing the interrupt control register of some peripheral.\n
+      Now the interrupt is enabled and if it occurs it'll post the event
+    #RTOS_EVT_ISR_USER_00. You will probably have a task of high priority which is waiting
+    for this event in order to handle the interrupt when it is resumed by the event. */
+#define RTOS_USE_APPL_INTERRUPT_00 RTOS_FEATURE_OFF
+
+/** The index of the interrupt which is assigned to application interrupt 0.\n
+      All possible external interrupt sources are hardwired to the interrupt controller.
+    They are indentified by index. The table, which interrupt source (mostly I/O device) is
+    connected to the controller at which index can be found in the MCU reference manual,
+    section 28.7, table 28-4. */
+#define RTOS_ISR_USER_00    -1
+
+/** The interrupt service routines, which are installed for the application defined
+    interrupts are widely generic and part of the RTuinOS kernel implementation. However,
+    the acknowledge of the interrupt bit in the interrupt source device depends on the
+    interrupt source and can't be anticipated by the kernel. You need to add appropriate
+    code to the implementation of the ISR through this macro. Assign an expression, which
+    is then compiled as part of the ISR. Mostly, the expression will be a simple assignment
+    to a register of the configured device but if this should not suffice you can define
+    the call to an arbitrary, application owned function; now the configuration by macro
+    behaves like a standard callback mechanism.\n
+      Here for application defined interrupt 0. */
+#define RTOS_ISR_USER_00_ACKNOWLEDGE_IRQ
+
+
+/** Enable the application defined interrupt 1. See #RTOS_USE_APPL_INTERRUPT_00 for
+    details. */
+#define RTOS_USE_APPL_INTERRUPT_01 RTOS_FEATURE_OFF
+
+/** The name of the interrupt vector which is assigned to application interrupt 1. See
+    #RTOS_ISR_USER_00 for details. */
+#define RTOS_ISR_USER_01    -1
+
+/** The code to acknowledge the interrupt bit in the interrupt source of application
+    defined interrupt 1. See #RTOS_ISR_USER_00_ACKNOWLEDGE_IRQ for details. */
+#define RTOS_ISR_USER_01_ACKNOWLEDGE_IRQ
+
+
+/** The default EOL character sequence used in the startup message is overridden. Our
+    serial interface doesn't do newline conversion and requires carriage return and
+    newline. However, this depends on the terminal software on the host machine, too,
+    and might be changed in other environments.
+      @todo Find the default EOL, which is compatible with Eclipse' terminal - this should
+    be the reference. */
+#define RTOS_EOL "\r\n"
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+
+
+#endif  /* RTOS_CONFIG_INCLUDED */
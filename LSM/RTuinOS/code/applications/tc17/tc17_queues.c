@@ -0,0 +1,672 @@
+/**
+ * @file tc17_queues.c
+ *   Test case 17 of RTuinOS. The message queues are tested. A sequencer task runs a fixed
+ * set of scenarios in a cycle of one second and prints the observations:\n
+ *   - Direct handoff: A message, which is sent to an empty queue while a task of higher
+ * priority is waiting for it, is copied into the receive buffer of that task. The
+ * receiver preempts the sender and the message doesn't pass the queue\n
+ *   - Slot reuse: A sender, which is blocked by a full queue, is resumed by the receiver
+ * of the oldest message. Its message is copied into the freed slot and the FIFO order of
+ * messages is not violated. The queue capacity doesn't divide the number of messages per
+ * cycle; the ring buffer index wraps at different positions from cycle to cycle\n
+ *   - Timeouts: Send to a full queue and receive from an empty queue with zero and
+ * non-zero timeout\n
+ *   - Use from an ISR: A kernel interrupt sends messages with zero timeout. Messages,
+ * which find a waiting receiver, resume it immediately; messages, which find a full
+ * queue, are lost and counted
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   setup
+ *   setupAfterKernelInit
+ *   loop
+ * Local functions
+ *   isrPit0
+ *   resultToStr
+ *   testHandoff
+ *   testFullQueue
+ *   testTimeouts
+ *   testIsr
+ *   taskSequencer
+ *   taskReceiver
+ *   taskConsumer
+ *   taskIsrReceiver
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "MPC5643L.h"
+#include "ihw_initMcuCoreHW.h"
+#include "mai_main.h"
+#include "rtos.h"
+
+
+/*
+ * Defines
+ */
+
+/** The number of interrupt levels, we use in this application is required for an
+    estimation of the appropriate stack sizes.\n
+      We have 2 interrupts for the serial interface, the RTOS system timer and the PIT 0
+    interrupt, which sends messages. */
+#define NO_IRQ_LEVELS_IN_USE    4
+
+/** The stack usage by the application tasks itself; interrupts disregarded here. */
+#define STACK_USAGE_IN_BYTE     512
+
+/** The stack size. */
+#define STACK_SIZE_IN_BYTE \
+            (RTOS_REQUIRED_STACK_SIZE_IN_BYTE(STACK_USAGE_IN_BYTE, NO_IRQ_LEVELS_IN_USE))
+
+/** The queue for the test of the direct handoff. It conveys blocks of data. */
+#define IDX_QUEUE_HANDOFF       0u
+
+/** The queue for the test of the slot reuse in a full queue. */
+#define IDX_QUEUE_SLOT          1u
+
+/** The queue for the test of the timeouts. */
+#define IDX_QUEUE_TIMEOUT       2u
+
+/** The queue, which is filled by the ISR. */
+#define IDX_QUEUE_ISR           3u
+
+/** The capacity of the queue for the test of the slot reuse. */
+#define SIZE_OF_QUEUE_SLOT      3u
+
+/** The number of messages, which the sequencer sends to the queue for the test of the
+    slot reuse. The first one is handed over to the waiting consumer, the next ones fill
+    the queue and the last one blocks the sender. */
+#define NO_MSGS_SLOT            (SIZE_OF_QUEUE_SLOT+2u)
+
+/** The capacity of the queue, which is filled by the ISR. */
+#define SIZE_OF_QUEUE_ISR       2u
+
+/** The number of interrupts per test cycle, which send a message. */
+#define NO_ISR_MSGS             40u
+
+/** The number of messages, which are handed over from the ISR to the waiting receiver
+    before the receiver pauses. */
+#define NO_ISR_MSGS_HANDOFF     20u
+
+/** The period of the interrupt of PIT 0 in cycles of the peripheral clock of 120 MHz. The
+    interrupt rate is 4 kHz. */
+#define TI_CYCLE_ISR            30000u
+
+
+/*
+ * Local type definitions
+ */
+
+/** The message of the queue for the test of the direct handoff. It is a block of data,
+    which is transferred as a whole. */
+typedef struct block_t
+{
+    /** The sequence number of the block. */
+    uint32_t seqNo;
+
+    /** Some payload. */
+    int16_t sampleAry[10];
+
+} block_t;
+
+/** The task IDs. */
+enum
+{
+    idxTaskSequencer = 0
+    , idxTaskReceiver
+    , idxTaskConsumer
+    , idxTaskIsrReceiver
+    , noTasks
+};
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+static _Alignas(uint64_t) uint8_t _stackSequencer[STACK_SIZE_IN_BYTE]
+                                , _stackReceiver[STACK_SIZE_IN_BYTE]
+                                , _stackConsumer[STACK_SIZE_IN_BYTE]
+                                , _stackIsrReceiver[STACK_SIZE_IN_BYTE];
+
+/** The ring buffers of the queues. */
+static block_t _bufferQueueHandoff[2];
+static uint32_t _bufferQueueSlot[SIZE_OF_QUEUE_SLOT]
+              , _bufferQueueTimeout[1]
+              , _bufferQueueIsr[SIZE_OF_QUEUE_ISR];
+
+/** The message queues of the application. */
+rtos_queue_t rtos_queueAry[RTOS_NO_QUEUE_EVENTS] =
+    { [IDX_QUEUE_HANDOFF] = RTOS_QUEUE_INIT(_bufferQueueHandoff, sizeof(block_t))
+    , [IDX_QUEUE_SLOT] = RTOS_QUEUE_INIT(_bufferQueueSlot, sizeof(uint32_t))
+    , [IDX_QUEUE_TIMEOUT] = RTOS_QUEUE_INIT(_bufferQueueTimeout, sizeof(uint32_t))
+    , [IDX_QUEUE_ISR] = RTOS_QUEUE_INIT(_bufferQueueIsr, sizeof(uint32_t))
+    };
+
+/** The last block, which has been received by taskReceiver. */
+static block_t _lastBlock;
+
+/** The number of blocks received by taskReceiver. */
+static volatile unsigned int _noBlocksReceived = 0;
+
+/** The messages received by taskConsumer in the current test cycle. */
+static uint32_t _consumedMsgAry[NO_MSGS_SLOT];
+
+/** The number of messages received by taskConsumer in the current test cycle. */
+static volatile unsigned int _noConsumedMsgs = 0;
+
+/** The number of interrupts of PIT 0 in the current test cycle. */
+static volatile unsigned int _noIsrMsgs = 0;
+
+/** The number of messages, which the ISR could successfully send. */
+static volatile unsigned int _noIsrMsgsSent = 0;
+
+/** The messages, which taskIsrReceiver received from the ISR. */
+static uint32_t _isrMsgAry[NO_ISR_MSGS];
+
+/** The number of messages received by taskIsrReceiver in the current test cycle. */
+static volatile unsigned int _noIsrMsgsReceived = 0;
+
+/** The number of messages, which taskIsrReceiver received by direct handoff. */
+static volatile unsigned int _noIsrMsgsByHandoff = 0;
+
+/** The result of the final receive operation of taskIsrReceiver, which times out after
+    the ISR has been stopped. */
+static volatile uint32_t _resultFinalIsrReceive = 0;
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * A kernel interrupt, which sends a message to a queue. It is clocked by PIT 0. The
+ * interrupt stops itself after #NO_ISR_MSGS messages.
+ *   @return
+ * A kernel interrupt returns \a int_rcIsr_switchContext if it initiates a task switch.
+ *   @param pCmdContextSwitch
+ * The context switch command, which is filled by the kernel if the message resumes a
+ * task of higher priority than the interrupted one.
+ */
+static uint32_t isrPit0(int_cmdContextSwitch_t *pCmdContextSwitch)
+{
+    /* Acknowledge the interrupt in the causing HW device. */
+    PIT.TFLG0.B.TIF = 0x1;
+
+    const uint32_t msg = ++ _noIsrMsgs;
+    if(_noIsrMsgs >= NO_ISR_MSGS)
+        PIT.TCTRL0.R = 0;
+
+    /* An ISR must not wait; it uses the ISR entry of the kernel, which doesn't wait. A
+       waiting receiver gets the message directly and may preempt the interrupted task. */
+    const uint32_t rc = rtos_osSendToQueueFromIsr(pCmdContextSwitch, IDX_QUEUE_ISR, &msg);
+
+    /* The queue event is signalled to the ISR if the message has been sent. */
+    if((pCmdContextSwitch->signalToResumedContext & RTOS_EVT_OF_QUEUE(IDX_QUEUE_ISR)) != 0)
+        ++ _noIsrMsgsSent;
+
+    return rc;
+
+} /* End of isrPit0 */
+
+
+
+/**
+ * Translate the result of a queue operation into printable text.
+ *   @return
+ * Get the text.
+ *   @param result
+ * The event vector returned by the queue operation.
+ *   @param idxQueue
+ * The queue the operation was applied to.
+ */
+static const char *resultToStr(uint32_t result, unsigned int idxQueue)
+{
+    if(result == RTOS_EVT_OF_QUEUE(idxQueue))
+        return "ok";
+    else if(result == RTOS_EVT_DELAY_TIMER)
+        return "timeout";
+    else if(result == 0)
+        return "failed";
+    else
+        return "unexpected";
+
+} /* End of resultToStr */
+
+
+
+/**
+ * Send a block to a queue, which taskReceiver is waiting for. The receiver has the higher
+ * priority; it needs to receive the block before the send operation returns.
+ *   @param idxCycle
+ * The test cycle. Used for the contents of the message.
+ */
+static void testHandoff(unsigned int idxCycle)
+{
+    block_t block = {.seqNo = idxCycle};
+    unsigned int u;
+    for(u=0; u<sizeof(block.sampleAry)/sizeof(block.sampleAry[0]); ++u)
+        block.sampleAry[u] = (int16_t)(1000*idxCycle + u);
+
+    const unsigned int noBlocksBefore = _noBlocksReceived;
+    const uint32_t result = rtos_sendToQueue(IDX_QUEUE_HANDOFF, &block, /* timeout */ 0);
+    const bool isReceived = _noBlocksReceived == noBlocksBefore+1
+             , isIntact = memcmp(&_lastBlock, &block, sizeof(block)) == 0;
+    const unsigned int noMsgs = rtos_queueAry[IDX_QUEUE_HANDOFF].noMsgs;
+    assert(result == RTOS_EVT_OF_QUEUE(IDX_QUEUE_HANDOFF)  &&  isReceived  &&  isIntact
+           &&  noMsgs == 0
+          );
+    iprintf( "Handoff: Send %s, received before sender continued: %s, block intact: %s"
+             ", messages in queue: %u" RTOS_EOL
+           , resultToStr(result, IDX_QUEUE_HANDOFF)
+           , isReceived? "yes": "no"
+           , isIntact? "yes": "no"
+           , noMsgs
+           );
+} /* End of testHandoff */
+
+
+
+/**
+ * Send more messages to a queue than it can hold. The receiver, taskConsumer, has a lower
+ * priority. The first message is handed over, the next ones fill the queue and the last
+ * one blocks the sequencer until the consumer has taken the oldest message.
+ *   @param idxCycle
+ * The test cycle. Used for the contents of the messages.
+ */
+static void testFullQueue(unsigned int idxCycle)
+{
+    const rtos_queue_t * const pQ = &rtos_queueAry[IDX_QUEUE_SLOT];
+    _noConsumedMsgs = 0;
+
+    unsigned int u;
+    for(u=0; u<NO_MSGS_SLOT; ++u)
+    {
+        const uint32_t msg = 100u*idxCycle + u
+                     , result = rtos_sendToQueue( IDX_QUEUE_SLOT
+                                                , &msg
+                                                , RTOS_QUEUE_WAIT_FOREVER
+                                                );
+        assert(result == RTOS_EVT_OF_QUEUE(IDX_QUEUE_SLOT));
+        if(u == 0)
+            assert(pQ->noMsgs == 0);
+    }
+
+    /* The last send has been blocked until the consumer took one message from the queue.
+       Our message has been placed into the freed slot; the queue is still full. The
+       consumer has been preempted by us in its system call, which resumed us; it has
+       recorded only the first, handed over message so far. */
+    const unsigned int noMsgs = pQ->noMsgs
+                     , idxRead = pQ->idxRead
+                     , noConsumedMsgs = _noConsumedMsgs;
+    assert(noMsgs == SIZE_OF_QUEUE_SLOT  &&  noConsumedMsgs == 1);
+
+    /* Let the consumer drain the queue. */
+    rtos_delay(2);
+    assert(_noConsumedMsgs == NO_MSGS_SLOT  &&  pQ->noMsgs == 0);
+
+    iprintf( "Full queue: Sender resumed with %u messages in queue, read index %u, %u"
+             " message recorded by consumer so far" RTOS_EOL
+             "Full queue: Messages in order of reception:"
+           , noMsgs
+           , idxRead
+           , noConsumedMsgs
+           );
+    for(u=0; u<NO_MSGS_SLOT; ++u)
+    {
+        assert(_consumedMsgAry[u] == 100u*idxCycle + u);
+        iprintf(" %lu", _consumedMsgAry[u]);
+    }
+    iprintf(RTOS_EOL);
+
+} /* End of testFullQueue */
+
+
+
+/**
+ * Apply send and receive with zero and non-zero timeout to a queue, which no other task
+ * uses.
+ */
+static void testTimeouts(void)
+{
+    uint32_t msg = 0
+           , result;
+    unsigned long tiStart, tiElapsed;
+
+    /* The elapsed time is measured in ms. The timeout is counted in ticks of the system
+       timer of 1 ms and begins with the next tick; the measured time can be one more or
+       less than the timeout. */
+
+    result = rtos_receiveFromQueue(IDX_QUEUE_TIMEOUT, &msg, /* timeout */ 0);
+    assert(result == 0);
+    iprintf("Timeout: Receive from empty queue, timeout 0: %s" RTOS_EOL
+           , resultToStr(result, IDX_QUEUE_TIMEOUT)
+           );
+
+    tiStart = millis();
+    result = rtos_receiveFromQueue(IDX_QUEUE_TIMEOUT, &msg, /* timeout */ 10);
+    tiElapsed = millis() - tiStart;
+    assert(result == RTOS_EVT_DELAY_TIMER  &&  tiElapsed >= 9  &&  tiElapsed <= 11);
+    iprintf("Timeout: Receive from empty queue, timeout 10: %s after %lu ms" RTOS_EOL
+           , resultToStr(result, IDX_QUEUE_TIMEOUT)
+           , tiElapsed
+           );
+
+    msg = 0x11;
+    result = rtos_sendToQueue(IDX_QUEUE_TIMEOUT, &msg, /* timeout */ 0);
+    assert(result == RTOS_EVT_OF_QUEUE(IDX_QUEUE_TIMEOUT));
+    iprintf("Timeout: Send to empty queue, timeout 0: %s" RTOS_EOL
+           , resultToStr(result, IDX_QUEUE_TIMEOUT)
+           );
+
+    msg = 0x22;
+    result = rtos_sendToQueue(IDX_QUEUE_TIMEOUT, &msg, /* timeout */ 0);
+    assert(result == 0);
+    iprintf("Timeout: Send to full queue, timeout 0: %s" RTOS_EOL
+           , resultToStr(result, IDX_QUEUE_TIMEOUT)
+           );
+
+    msg = 0x33;
+    tiStart = millis();
+    result = rtos_sendToQueue(IDX_QUEUE_TIMEOUT, &msg, /* timeout */ 5);
+    tiElapsed = millis() - tiStart;
+    assert(result == RTOS_EVT_DELAY_TIMER  &&  tiElapsed >= 4  &&  tiElapsed <= 6);
+    iprintf("Timeout: Send to full queue, timeout 5: %s after %lu ms" RTOS_EOL
+           , resultToStr(result, IDX_QUEUE_TIMEOUT)
+           , tiElapsed
+           );
+
+    /* The failed send operations must not have modified the queue. */
+    msg = 0;
+    result = rtos_receiveFromQueue(IDX_QUEUE_TIMEOUT, &msg, /* timeout */ 0);
+    assert(result == RTOS_EVT_OF_QUEUE(IDX_QUEUE_TIMEOUT)  &&  msg == 0x11);
+    iprintf("Timeout: Receive from full queue, timeout 0: %s, message 0x%02lx" RTOS_EOL
+           , resultToStr(result, IDX_QUEUE_TIMEOUT)
+           , msg
+           );
+
+    result = rtos_receiveFromQueue(IDX_QUEUE_TIMEOUT, &msg, /* timeout */ 0);
+    assert(result == 0);
+    iprintf("Timeout: Receive from empty queue, timeout 0: %s" RTOS_EOL
+           , resultToStr(result, IDX_QUEUE_TIMEOUT)
+           );
+} /* End of testTimeouts */
+
+
+
+/**
+ * Start the ISR, which sends messages to taskIsrReceiver, and report the result after
+ * it has stopped.
+ */
+static void testIsr(void)
+{
+    _noIsrMsgs = 0;
+    _noIsrMsgsSent = 0;
+    _noIsrMsgsReceived = 0;
+    _noIsrMsgsByHandoff = 0;
+    _resultFinalIsrReceive = 0;
+
+    /* Start PIT 0. The interrupt stops the timer after the last message. */
+    PIT.LDVAL0.R = TI_CYCLE_ISR - 1u;
+    PIT.TCTRL0.R = 0x3;
+
+    /* The ISR runs for 10 ms. Wait until the receiver has timed out after the last
+       message. */
+    rtos_delay(30);
+    assert(_noIsrMsgs == NO_ISR_MSGS
+           &&  _noIsrMsgsSent == NO_ISR_MSGS_HANDOFF + SIZE_OF_QUEUE_ISR
+           &&  _noIsrMsgsReceived == _noIsrMsgsSent
+           &&  _noIsrMsgsByHandoff == NO_ISR_MSGS_HANDOFF
+           &&  _resultFinalIsrReceive == RTOS_EVT_DELAY_TIMER
+          );
+
+    iprintf( "ISR: %u messages sent with timeout 0, %u successful, %u lost at full queue"
+             RTOS_EOL
+           , _noIsrMsgs
+           , _noIsrMsgsSent
+           , _noIsrMsgs - _noIsrMsgsSent
+           );
+    iprintf( "ISR: Receiver got %u messages by direct handoff and %u from the queue, then"
+             " %s" RTOS_EOL
+             "ISR: Messages in order of reception:"
+           , _noIsrMsgsByHandoff
+           , _noIsrMsgsReceived - _noIsrMsgsByHandoff
+           , resultToStr(_resultFinalIsrReceive, IDX_QUEUE_ISR)
+           );
+    unsigned int u;
+    for(u=0; u<_noIsrMsgsReceived; ++u)
+        iprintf(" %lu", _isrMsgAry[u]);
+    iprintf(RTOS_EOL);
+
+} /* End of testIsr */
+
+
+
+/**
+ * The sequencer task. It runs all test scenarios once a second.
+ *   @param initialResumeCondition
+ * The vector of events, which made this task initially due.
+ */
+static void taskSequencer(uint32_t initialResumeCondition ATTRIB_UNUSED)
+{
+    unsigned int idxCycle = 0;
+    do
+    {
+        iprintf("Test cycle %u at %lu ms" RTOS_EOL, idxCycle, millis());
+        testHandoff(idxCycle);
+        testFullQueue(idxCycle);
+        testTimeouts();
+        testIsr();
+        ++ idxCycle;
+    }
+    while(rtos_suspendTaskTillTime(/* deltaTimeTillResume */ 1000));
+
+} /* End of taskSequencer */
+
+
+
+/**
+ * The receiver of the blocks sent in testHandoff(). It has a higher priority than the
+ * sequencer.
+ *   @param initialResumeCondition
+ * The vector of events, which made this task initially due.
+ */
+static void taskReceiver(uint32_t initialResumeCondition ATTRIB_UNUSED)
+{
+    for(;;)
+    {
+        block_t block;
+#ifdef DEBUG
+        const uint32_t result =
+#endif
+        rtos_receiveFromQueue(IDX_QUEUE_HANDOFF, &block, RTOS_QUEUE_WAIT_FOREVER);
+        assert(result == RTOS_EVT_OF_QUEUE(IDX_QUEUE_HANDOFF));
+        _lastBlock = block;
+        ++ _noBlocksReceived;
+    }
+} /* End of taskReceiver */
+
+
+
+/**
+ * The consumer of the messages sent in testFullQueue(). It has a lower priority than the
+ * sequencer.
+ *   @param initialResumeCondition
+ * The vector of events, which made this task initially due.
+ */
+static void taskConsumer(uint32_t initialResumeCondition ATTRIB_UNUSED)
+{
+    for(;;)
+    {
+        uint32_t msg;
+#ifdef DEBUG
+        const uint32_t result =
+#endif
+        rtos_receiveFromQueue(IDX_QUEUE_SLOT, &msg, RTOS_QUEUE_WAIT_FOREVER);
+        assert(result == RTOS_EVT_OF_QUEUE(IDX_QUEUE_SLOT)
+               &&  _noConsumedMsgs < NO_MSGS_SLOT
+              );
+        _consumedMsgAry[_noConsumedMsgs++] = msg;
+    }
+} /* End of taskConsumer */
+
+
+
+/**
+ * The receiver of the messages sent by the ISR. It waits for the first
+ * #NO_ISR_MSGS_HANDOFF messages, which are handed over directly. Then it pauses; the ISR
+ * fills the queue and the remaining messages are lost. Eventually, it empties the queue
+ * and waits for another message, which doesn't come.
+ *   @param initialResumeCondition
+ * The vector of events, which made this task initially due.
+ */
+static void taskIsrReceiver(uint32_t initialResumeCondition ATTRIB_UNUSED)
+{
+    for(;;)
+    {
+        uint32_t result;
+        unsigned int u;
+        for(u=0; u<NO_ISR_MSGS_HANDOFF; ++u)
+        {
+            result = rtos_receiveFromQueue( IDX_QUEUE_ISR
+                                          , &_isrMsgAry[_noIsrMsgsReceived]
+                                          , RTOS_QUEUE_WAIT_FOREVER
+                                          );
+            assert(result == RTOS_EVT_OF_QUEUE(IDX_QUEUE_ISR));
+
+            /* We have the higher priority than all other tasks. If the ISR found the
+               queue empty then we have been waiting and we are resumed by the
+               interrupt, before it sends the next message. */
+            if(_noIsrMsgs == _noIsrMsgsReceived+1)
+                ++ _noIsrMsgsByHandoff;
+            ++ _noIsrMsgsReceived;
+        }
+
+        /* Pause until the ISR has stopped. */
+        rtos_delay(8);
+
+        /* Empty the queue without waiting. */
+        do
+        {
+            result = rtos_receiveFromQueue( IDX_QUEUE_ISR
+                                          , &_isrMsgAry[_noIsrMsgsReceived]
+                                          , /* timeout */ 0
+                                          );
+            if(result != 0)
+            {
+                assert(result == RTOS_EVT_OF_QUEUE(IDX_QUEUE_ISR));
+                ++ _noIsrMsgsReceived;
+            }
+        }
+        while(result != 0);
+
+        /* No further message is sent. */
+        uint32_t msg;
+        _resultFinalIsrReceive = rtos_receiveFromQueue( IDX_QUEUE_ISR
+                                                      , &msg
+                                                      , /* timeout */ 10
+                                                      );
+    }
+} /* End of taskIsrReceiver */
+
+
+
+/**
+ * Initialization of system, particularly specification of tasks and their properties.
+ */
+void setup()
+{
+    /* Print standard greeting of RTuinOS applications. */
+    iprintf(RTOS_EOL RTOS_RTUINOS_STARTUP_MSG RTOS_EOL);
+
+    assert(noTasks == RTOS_NO_TASKS);
+    rtos_initializeTask( /* idxTask          */ idxTaskSequencer
+                       , /* taskFunction     */ taskSequencer
+                       , /* prioClass        */ 1
+                       , /* pStackArea       */ _stackSequencer
+                       , /* stackSize        */ sizeof(_stackSequencer)
+                       , /* startEventMask   */ RTOS_EVT_DELAY_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout     */ 10
+                       );
+    rtos_initializeTask( /* idxTask          */ idxTaskReceiver
+                       , /* taskFunction     */ taskReceiver
+                       , /* prioClass        */ 2
+                       , /* pStackArea       */ _stackReceiver
+                       , /* stackSize        */ sizeof(_stackReceiver)
+                       , /* startEventMask   */ RTOS_EVT_DELAY_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout     */ 1
+                       );
+    rtos_initializeTask( /* idxTask          */ idxTaskConsumer
+                       , /* taskFunction     */ taskConsumer
+                       , /* prioClass        */ 0
+                       , /* pStackArea       */ _stackConsumer
+                       , /* stackSize        */ sizeof(_stackConsumer)
+                       , /* startEventMask   */ RTOS_EVT_DELAY_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout     */ 1
+                       );
+    rtos_initializeTask( /* idxTask          */ idxTaskIsrReceiver
+                       , /* taskFunction     */ taskIsrReceiver
+                       , /* prioClass        */ 2
+                       , /* pStackArea       */ _stackIsrReceiver
+                       , /* stackSize        */ sizeof(_stackIsrReceiver)
+                       , /* startEventMask   */ RTOS_EVT_DELAY_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout     */ 1
+                       );
+} /* End of setup */
+
+
+
+/**
+ * The kernel is initialized; the kernel interrupt, which sends to a queue, can be
+ * installed. The timer is started later by the sequencer.
+ */
+void setupAfterKernelInit()
+{
+    PIT.TCTRL0.R = 0;
+    ihw_installINTCInterruptHandler
+                        ( (int_externalInterruptHandler_t){.kernelIsr = isrPit0}
+                        , /* vectorNum */ 59 /* Timer PIT 0 */
+                        , /* psrPriority */ 1
+                        , /* isPreemptable */ true
+                        , /* isKernelInterrupt */ true
+                        );
+} /* End of setupAfterKernelInit */
+
+
+
+/**
+ * The idle task loop function. Is cyclically invoked by the RTuinOS kernel if no other
+ * task is due.
+ */
+void loop()
+{
+} /* End of loop */
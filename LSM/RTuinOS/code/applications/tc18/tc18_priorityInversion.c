@@ -0,0 +1,409 @@
+/**
+ * @file tc18_priorityInversion.c
+ *   Test case 18 of RTuinOS. The priority inheritance of mutexes is tested with a chain of
+ * two locks. Four tasks of different priority run once a second:\n
+ *   - Task L2 of lowest priority acquires lock B and works for #TI_WORK_L2_US\n
+ *   - Task L1 acquires lock A and then requests lock B; it has to wait for L2. Once it got
+ * B, it works shortly and releases both locks\n
+ *   - Task H of highest priority requests lock A; it has to wait for L1, which waits for
+ * L2\n
+ *   - Task M of medium priority doesn't use any lock but produces a long lasting load\n
+ *   The cycles alternate between two kinds of locks. In even cycles, the locks are
+ * semaphores. A semaphore has no owner and doesn't pass on a priority. When M becomes
+ * due, it preempts L2 and H is blocked for the full load time of M, too: This is the
+ * classic priority inversion.\n
+ *   In odd cycles, the locks are mutexes. H lends its priority to L1, the owner of A, and
+ * L1 passes it on to L2, the owner of B, which L1 is waiting for. M can't preempt L2. When
+ * L2 releases B, the mutex is handed over to L1 together with the inherited priority; L2
+ * falls back to its own priority. When L1 releases A, H gets the mutex and L1 falls back,
+ * too. M runs after H.\n
+ *   L2, the task of lowest priority, prints the timeline of the cycle and the time H had
+ * been blocked.
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   setup
+ *   loop
+ * Local functions
+ *   trace
+ *   acquire
+ *   release
+ *   taskL2
+ *   taskL1
+ *   taskM
+ *   taskH
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdio.h>
+#include <assert.h>
+
+#include "ihw_initMcuCoreHW.h"
+#include "mai_main.h"
+#include "del_delay.h"
+#include "rtos.h"
+
+
+/*
+ * Defines
+ */
+
+/** The number of interrupt levels, we use in this application is required for an
+    estimation of the appropriate stack sizes.\n
+      We have 2 interrupts for the serial interface and the RTOS system timer. */
+#define NO_IRQ_LEVELS_IN_USE    3
+
+/** The stack usage by the application tasks itself; interrupts disregarded here. */
+#define STACK_USAGE_IN_BYTE     512
+
+/** The stack size. */
+#define STACK_SIZE_IN_BYTE \
+            (RTOS_REQUIRED_STACK_SIZE_IN_BYTE(STACK_USAGE_IN_BYTE, NO_IRQ_LEVELS_IN_USE))
+
+/** Lock A, which is shared by H and L1, if implemented as semaphore. */
+#define EVT_SEMAPHORE_A         (RTOS_EVT_SEMAPHORE_00)
+
+/** Lock B, which is shared by L1 and L2, if implemented as semaphore. */
+#define EVT_SEMAPHORE_B         (RTOS_EVT_SEMAPHORE_01)
+
+/** Lock A, which is shared by H and L1, if implemented as mutex. */
+#define EVT_MUTEX_A             (RTOS_EVT_MUTEX_02)
+
+/** Lock B, which is shared by L1 and L2, if implemented as mutex. */
+#define EVT_MUTEX_B             (RTOS_EVT_MUTEX_03)
+
+/** The time in ms, at which L2, L1, H and M become due in each cycle. They start in this
+    order at an interval of 1 ms. */
+#define TI_START_L2             10u
+
+/** The time in us, which L2 spends while holding lock B. */
+#define TI_WORK_L2_US           20000u
+
+/** The time in us, which L1 spends while holding both locks. */
+#define TI_WORK_L1_US           2000u
+
+/** The time in us, which H spends while holding lock A. */
+#define TI_WORK_H_US            1000u
+
+/** The load time in us of M. */
+#define TI_LOAD_M_US            50000u
+
+/** The maximum number of entries in the timeline of a cycle. */
+#define MAX_NO_TRACE_ENTRIES    16u
+
+
+/*
+ * Local type definitions
+ */
+
+/** An entry of the timeline of a test cycle. */
+typedef struct traceEntry_t
+{
+    /** The time of the entry in us since the start of the cycle. */
+    unsigned long tiUs;
+
+    /** The event, which happened at this time. */
+    const char *text;
+
+} traceEntry_t;
+
+/** The task IDs. */
+enum
+{
+    idxTaskL2 = 0
+    , idxTaskL1
+    , idxTaskM
+    , idxTaskH
+    , noTasks
+};
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+static _Alignas(uint64_t) uint8_t _stackL2[STACK_SIZE_IN_BYTE]
+                                , _stackL1[STACK_SIZE_IN_BYTE]
+                                , _stackM[STACK_SIZE_IN_BYTE]
+                                , _stackH[STACK_SIZE_IN_BYTE];
+
+/** The semaphores, which implement the locks in the cycles without priority inheritance.
+    Both are initially available. */
+unsigned int rtos_semaphoreAry[RTOS_NO_SEMAPHORE_EVENTS] = {1, 1};
+
+/** The kind of locks, which is used in the current cycle. Set by L2, which starts first,
+    and read by the other tasks. */
+static volatile bool _isPrioInheritance = false;
+
+/** The time in us, at which the current cycle started. */
+static volatile unsigned long _tiCycleStart = 0;
+
+/** The timeline of the current cycle. */
+static traceEntry_t _traceAry[MAX_NO_TRACE_ENTRIES];
+
+/** The number of entries in \a _traceAry. */
+static volatile unsigned int _noTraceEntries = 0;
+
+/** The time in us, which H had been blocked by the lock in the current cycle. */
+static volatile unsigned long _tiBlockedH = 0;
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Add an entry to the timeline of the current cycle.
+ *   @param text
+ * The event, which is recorded. The string needs to be a constant.
+ */
+static void trace(const char *text)
+{
+    ihw_suspendAllInterrupts();
+    if(_noTraceEntries < MAX_NO_TRACE_ENTRIES)
+    {
+        _traceAry[_noTraceEntries].tiUs = micros() - _tiCycleStart;
+        _traceAry[_noTraceEntries].text = text;
+        ++ _noTraceEntries;
+    }
+    ihw_resumeAllInterrupts();
+
+} /* End of trace */
+
+
+
+/**
+ * Acquire one of the locks, as semaphore or as mutex, depending on the current cycle. The
+ * function waits as long as the lock is owned by another task.
+ *   @param isLockA
+ * \a true for lock A, \a false for lock B.
+ */
+static void acquire(bool isLockA)
+{
+    uint32_t evt;
+    if(_isPrioInheritance)
+        evt = isLockA? EVT_MUTEX_A: EVT_MUTEX_B;
+    else
+        evt = isLockA? EVT_SEMAPHORE_A: EVT_SEMAPHORE_B;
+
+#ifdef DEBUG
+    const uint32_t gotEvtVec =
+#endif
+    rtos_waitForEvent(evt, /* all */ false, /* timeout */ 0);
+    assert(gotEvtVec == evt);
+
+} /* End of acquire */
+
+
+
+/**
+ * Release one of the locks, which has been acquired by acquire().
+ *   @param isLockA
+ * \a true for lock A, \a false for lock B.
+ */
+static void release(bool isLockA)
+{
+    if(_isPrioInheritance)
+        rtos_sendEvent(isLockA? EVT_MUTEX_A: EVT_MUTEX_B);
+    else
+        rtos_sendEvent(isLockA? EVT_SEMAPHORE_A: EVT_SEMAPHORE_B);
+
+} /* End of release */
+
+
+
+/**
+ * Task L2 of lowest priority. It owns lock B for a while. It starts the cycle and, being
+ * the last one, which completes it, it prints the timeline.
+ *   @param initialResumeCondition
+ * The vector of events, which made this task initially due.
+ */
+static void taskL2(uint32_t initialResumeCondition ATTRIB_UNUSED)
+{
+    unsigned int idxCycle = 0;
+    do
+    {
+        _tiCycleStart = micros();
+        _noTraceEntries = 0;
+        _tiBlockedH = 0;
+        _isPrioInheritance = (idxCycle & 1u) != 0;
+
+        acquire(/* isLockA */ false);
+        trace("L2 got B");
+        del_delayMicroseconds(TI_WORK_L2_US);
+        trace("L2 releases B");
+        release(/* isLockA */ false);
+        trace("L2 done");
+
+        /* Priority inheritance: H must not wait for the load of M. Semaphores: H waits for
+           the load of M and for the remaining work of L2. */
+        assert(!_isPrioInheritance
+               ||  _tiBlockedH < (unsigned long)(TI_WORK_L2_US+TI_WORK_L1_US)
+              );
+        assert(_isPrioInheritance  ||  _tiBlockedH > (unsigned long)TI_LOAD_M_US);
+
+        iprintf( "Cycle %u, %s:" RTOS_EOL
+               , idxCycle
+               , _isPrioInheritance? "mutexes with priority inheritance"
+                                   : "semaphores, no priority inheritance"
+               );
+        unsigned int u;
+        for(u=0; u<_noTraceEntries; ++u)
+            iprintf("  %6lu us: %s" RTOS_EOL, _traceAry[u].tiUs, _traceAry[u].text);
+        iprintf("  H has been blocked for %lu us" RTOS_EOL, _tiBlockedH);
+
+        ++ idxCycle;
+    }
+    while(rtos_suspendTaskTillTime(/* deltaTimeTillResume */ 1000));
+
+} /* End of taskL2 */
+
+
+
+/**
+ * Task L1. It acquires lock A and then requests lock B, which is owned by L2. It holds
+ * both locks for a short while and releases them in reverse order.
+ *   @param initialResumeCondition
+ * The vector of events, which made this task initially due.
+ */
+static void taskL1(uint32_t initialResumeCondition ATTRIB_UNUSED)
+{
+    do
+    {
+        acquire(/* isLockA */ true);
+        trace("L1 got A, requests B");
+        acquire(/* isLockA */ false);
+        trace("L1 got B");
+        del_delayMicroseconds(TI_WORK_L1_US);
+        release(/* isLockA */ false);
+        trace("L1 released B, releases A");
+        release(/* isLockA */ true);
+        trace("L1 done");
+    }
+    while(rtos_suspendTaskTillTime(/* deltaTimeTillResume */ 1000));
+
+} /* End of taskL1 */
+
+
+
+/**
+ * Task M of medium priority. It doesn't use any lock but produces a long lasting load.
+ *   @param initialResumeCondition
+ * The vector of events, which made this task initially due.
+ */
+static void taskM(uint32_t initialResumeCondition ATTRIB_UNUSED)
+{
+    do
+    {
+        trace("M starts load");
+        del_delayMicroseconds(TI_LOAD_M_US);
+        trace("M done");
+    }
+    while(rtos_suspendTaskTillTime(/* deltaTimeTillResume */ 1000));
+
+} /* End of taskM */
+
+
+
+/**
+ * Task H of highest priority. It requests lock A and measures, how long it is blocked.
+ *   @param initialResumeCondition
+ * The vector of events, which made this task initially due.
+ */
+static void taskH(uint32_t initialResumeCondition ATTRIB_UNUSED)
+{
+    do
+    {
+        trace("H requests A");
+        const unsigned long tiRequest = micros();
+        acquire(/* isLockA */ true);
+        _tiBlockedH = micros() - tiRequest;
+        trace("H got A");
+        del_delayMicroseconds(TI_WORK_H_US);
+        release(/* isLockA */ true);
+        trace("H done");
+    }
+    while(rtos_suspendTaskTillTime(/* deltaTimeTillResume */ 1000));
+
+} /* End of taskH */
+
+
+
+/**
+ * Initialization of system, particularly specification of tasks and their properties.
+ */
+void setup()
+{
+    /* Print standard greeting of RTuinOS applications. */
+    iprintf(RTOS_EOL RTOS_RTUINOS_STARTUP_MSG RTOS_EOL);
+
+    assert(noTasks == RTOS_NO_TASKS);
+    rtos_initializeTask( /* idxTask          */ idxTaskL2
+                       , /* taskFunction     */ taskL2
+                       , /* prioClass        */ 0
+                       , /* pStackArea       */ _stackL2
+                       , /* stackSize        */ sizeof(_stackL2)
+                       , /* startEventMask   */ RTOS_EVT_ABSOLUTE_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout     */ TI_START_L2
+                       );
+    rtos_initializeTask( /* idxTask          */ idxTaskL1
+                       , /* taskFunction     */ taskL1
+                       , /* prioClass        */ 1
+                       , /* pStackArea       */ _stackL1
+                       , /* stackSize        */ sizeof(_stackL1)
+                       , /* startEventMask   */ RTOS_EVT_ABSOLUTE_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout     */ TI_START_L2+1
+                       );
+    rtos_initializeTask( /* idxTask          */ idxTaskH
+                       , /* taskFunction     */ taskH
+                       , /* prioClass        */ 3
+                       , /* pStackArea       */ _stackH
+                       , /* stackSize        */ sizeof(_stackH)
+                       , /* startEventMask   */ RTOS_EVT_ABSOLUTE_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout     */ TI_START_L2+2
+                       );
+    rtos_initializeTask( /* idxTask          */ idxTaskM
+                       , /* taskFunction     */ taskM
+                       , /* prioClass        */ 2
+                       , /* pStackArea       */ _stackM
+                       , /* stackSize        */ sizeof(_stackM)
+                       , /* startEventMask   */ RTOS_EVT_ABSOLUTE_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout     */ TI_START_L2+3
+                       );
+} /* End of setup */
+
+
+
+/**
+ * The idle task loop function. Is cyclically invoked by the RTuinOS kernel if no other
+ * task is due.
+ */
+void loop()
+{
+} /* End of loop */
@@ -26,6 +26,10 @@
  *   ihw_resumeAllInterrupts
  *   ihw_enterCriticalSection
  *   ihw_leaveCriticalSection
+ *   ihw_memoryBarrier
+ *   ihw_instructionSync
+ *   ihw_getTBL
+ *   ihw_getTimeBase
  */
 
 /*
@@ -160,6 +164,98 @@ static ALWAYS_INLINE void ihw_leaveCriticalSection(uint32_t msr)
 
 
 
+/**
+ * Memory barrier: All memory operations, which precede the barrier, are completed before
+ * any memory operation behind the barrier is started. This is required, e.g. if the write
+ * to an I/O register needs to be effective before the next instruction is executed.
+ */
+static ALWAYS_INLINE void ihw_memoryBarrier()
+{
+    asm volatile ( /* AssemblerTemplate */
+                   "mbar\n"
+                 : /* OutputOperands */
+                 : /* InputOperands */
+                 : /* Clobbers */ "memory"
+                 );
+} /* End of ihw_memoryBarrier */
+
+
+
+/**
+ * Instruction synchronization: All instructions before complete and a pending, no longer
+ * masked interrupt is taken before the next instruction is executed.
+ */
+static ALWAYS_INLINE void ihw_instructionSync()
+{
+    asm volatile ( /* AssemblerTemplate */
+#ifndef __VLE__
+                   "isync\n"
+#else
+                   "se_isync\n"
+#endif
+                 : /* OutputOperands */
+                 : /* InputOperands */
+                 : /* Clobbers */ "memory"
+                 );
+} /* End of ihw_instructionSync */
+
+
+
+/**
+ * Read the lower half of the time base of the CPU. The register wraps around after about
+ * 35s.
+ *   @return
+ * Get the current register value. The value is incremented with the system clock, every
+ * 1/120MHz = (8+1/3)ns, regardless of the CPU activity.
+ */
+static ALWAYS_INLINE uint32_t ihw_getTBL()
+{
+    uint32_t TBL;
+    asm volatile ( /* AssemblerTemplate */
+                   "mfspr %0, 268\n\r" /* SPR 268 = TBL, 269 = TBU */
+                 : /* OutputOperands */ "=r" (TBL)
+                 : /* InputOperands */
+                 : /* Clobbers */
+                 );
+    return TBL;
+
+} /* End of ihw_getTBL */
+
+
+
+/**
+ * Return the world time, which has elapsed since power up in units of CPU clock ticks.
+ * In VLE mode, this function is a substitute for the GCC builtin \a
+ * __builtin_ppc_get_timebase(), which fails to compile with MinGW-powerpc-eabivle-4.9.4.
+ * See https://community.nxp.com/message/966808 for details.
+ *   @return Get the world time elapsed since power up in units of 8.333... ns; our startup
+ * code configures the CPU clock frequency to 120 Mhz=1/(8+1/3)ns.
+ */
+static ALWAYS_INLINE uint64_t ihw_getTimeBase()
+{
+#ifdef __VLE__
+    uint32_t TBU, TBU2nd, TBL;
+    while(true)
+    {
+        asm volatile ( /* AssemblerTemplate */
+                       "mfspr %0, 269\n\r" // SPR 269 = TBU
+                       "mfspr %2, 268\n\r" // SPR 268 = TBL
+                       "mfspr %1, 269\n\r" // SPR 269 = TBU
+                     : /* OutputOperands */ "=r" (TBU),  "=r" (TBU2nd), "=r" (TBL)
+                     : /* InputOperands */
+                     : /* Clobbers */
+                     );
+        if(TBU == TBU2nd)
+            break;
+    }
+    return ((uint64_t)TBU << 32) | TBL;
+#else
+    return __builtin_ppc_get_timebase();
+#endif
+} /* End of ihw_getTimeBase */
+
+
+
 /*
  * Global prototypes
  */
@@ -0,0 +1,410 @@
+/**
+ * @file ibt_integerSineBlockTest.c
+ * Test of the block processing sine generator isb_integerSineBlock.c and of the block
+ * interface of the inter task queue itq_interTaskQueue.c of RTuinOS test case tc12 on a
+ * Linux host. The generators are compared bit by bit with the generated code of the
+ * Simulink model integerSineZ, which is compiled unmodified. A simple benchmark compares
+ * the cost per sample.\n
+ *   On the host, the paired generator runs with the emulation of the SPE registers. The
+ * emulation implements the same sequence of operations as the SPE code.\n
+ *   The process returns 0 if all tests pass.
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   rtos_sendEvent
+ *   main
+ * Local functions
+ *   check
+ *   modelStep
+ *   testSequence
+ *   testAllStates
+ *   testQueue
+ *   getTimeInNs
+ *   benchmark
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "typ_types.h"
+#include "rtos.h"
+#include "integerSineZ.h"
+#include "isb_integerSineBlock.h"
+#include "itq_interTaskQueue.h"
+
+
+/*
+ * Defines
+ */
+
+/** Check a condition and count the failure. */
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+/** The length of the reference sequence of the model. */
+#define NO_REF_SAMPLES  10000u
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The number of posted semaphore events. */
+unsigned int rtos_noSentSemaphoreEvents = 0;
+
+/** The number of failed checks. */
+static unsigned int _noErrors = 0;
+
+/** The output of the model after integerSineZ_initialize(). */
+static int16_t _refAry[NO_REF_SAMPLES];
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Host variant of the RTuinOS API: Count the posted semaphore events.
+ *   @param eventVec
+ * The posted events.
+ */
+void rtos_sendEvent(uint32_t eventVec)
+{
+    if((eventVec & RTOS_EVT_SEMAPHORE_00) != 0)
+        ++ rtos_noSentSemaphoreEvents;
+
+} /* End of rtos_sendEvent */
+
+
+
+/**
+ * Count a failed check and report it.
+ *   @param condition
+ * The result of the check.
+ *   @param pCondition
+ * The checked condition as text.
+ *   @param line
+ * The source code line of the check.
+ */
+static void check(bool condition, const char *pCondition, unsigned int line)
+{
+    if(!condition)
+    {
+        ++ _noErrors;
+        printf("Line %u: Check failed: %s\n", line, pCondition);
+    }
+} /* End of check */
+
+
+
+/**
+ * Run the model for a single step from a given state.
+ *   @return
+ * Get the output of the model.
+ *   @param z1
+ * The state of the model, the last recent output.
+ *   @param z2
+ * The state of the model, the output before.
+ */
+static int16_t modelStep(int16_t z1, int16_t z2)
+{
+    integerSineZ_DWork.UnitDelay_1_DSTATE = z1;
+    integerSineZ_DWork.UnitDelay_2_DSTATE = z2;
+    integerSineZ_step();
+    return integerSineZ_Y.y;
+
+} /* End of modelStep */
+
+
+
+/**
+ * Compare the sequences of the generators with the output of the model. The blocks have
+ * varying length, including zero.
+ */
+static void testSequence(void)
+{
+    printf("Test sequence of samples\n");
+
+    unsigned int u;
+    integerSineZ_initialize();
+    for(u=0; u<NO_REF_SAMPLES; ++u)
+    {
+        integerSineZ_step();
+        _refAry[u] = integerSineZ_Y.y;
+    }
+
+    /* Single generator. */
+    isb_state_t state;
+    isb_initState(&state, /* noSamplesAhead */ 0);
+    static int16_t yAry[NO_REF_SAMPLES];
+    unsigned int noSamples = 0
+               , blockSize = 0;
+    while(noSamples < NO_REF_SAMPLES)
+    {
+        if(blockSize > NO_REF_SAMPLES - noSamples)
+            blockSize = NO_REF_SAMPLES - noSamples;
+        isb_generateBlock(&state, &yAry[noSamples], blockSize);
+        noSamples += blockSize;
+        blockSize = (blockSize + 7u) % 23u;
+    }
+    unsigned int noDiffs = 0;
+    for(u=0; u<NO_REF_SAMPLES; ++u)
+        if(yAry[u] != _refAry[u])
+            ++ noDiffs;
+    CHECK(noDiffs == 0);
+
+    /* Paired generators, the second one ahead in time. */
+    enum {noSamplesAhead = 8};
+    isb_state_t state0, state1;
+    isb_initState(&state0, /* noSamplesAhead */ 0);
+    isb_initState(&state1, noSamplesAhead);
+    static int16_t y0Ary[NO_REF_SAMPLES], y1Ary[NO_REF_SAMPLES];
+    noSamples = 0;
+    blockSize = 0;
+    while(noSamples < NO_REF_SAMPLES)
+    {
+        if(blockSize > NO_REF_SAMPLES - noSamples)
+            blockSize = NO_REF_SAMPLES - noSamples;
+        isb_generateBlockPair( &state0
+                             , &y0Ary[noSamples]
+                             , &state1
+                             , &y1Ary[noSamples]
+                             , blockSize
+                             );
+        noSamples += blockSize;
+        blockSize = (blockSize + 5u) % 17u;
+    }
+    noDiffs = 0;
+    for(u=0; u<NO_REF_SAMPLES; ++u)
+    {
+        if(y0Ary[u] != _refAry[u])
+            ++ noDiffs;
+        if(u+noSamplesAhead < NO_REF_SAMPLES  &&  y1Ary[u] != _refAry[u+noSamplesAhead])
+            ++ noDiffs;
+    }
+    CHECK(noDiffs == 0);
+
+    /* The signal is a sine of nearly full range. */
+    int16_t min = 0, max = 0;
+    for(u=0; u<NO_REF_SAMPLES; ++u)
+    {
+        if(_refAry[u] < min)
+            min = _refAry[u];
+        if(_refAry[u] > max)
+            max = _refAry[u];
+    }
+    printf("  %u samples, range %d .. %d\n", NO_REF_SAMPLES, min, max);
+
+} /* End of testSequence */
+
+
+
+/**
+ * Compare a single step of the generators with the model for all values of z1 and a set of
+ * values of z2. The states include those, which the sine generator never reaches; this
+ * proves the bit-exactness including the overflow behavior of the model.
+ */
+static void testAllStates(void)
+{
+    printf("Test all states\n");
+
+    static const int16_t z2Ary[] = {INT16_MIN, INT16_MIN+1, -12345, -1, 0, 1, 9876
+                                   , INT16_MAX-1, INT16_MAX
+                                   };
+    unsigned long noDiffs = 0
+                , noTests = 0;
+    unsigned int idxZ2;
+    for(idxZ2=0; idxZ2<sizeOfAry(z2Ary); ++idxZ2)
+    {
+        int32_t z1;
+        for(z1=INT16_MIN; z1<=INT16_MAX; ++z1)
+        {
+            const int16_t z2 = z2Ary[idxZ2]
+                        , yModel = modelStep((int16_t)z1, z2);
+
+            isb_state_t state = {.z1 = (int16_t)z1, .z2 = z2};
+            int16_t y;
+            isb_generateBlock(&state, &y, 1);
+            if(y != yModel  ||  state.z1 != yModel  ||  state.z2 != (int16_t)z1)
+                ++ noDiffs;
+
+            /* The second generator uses the mirrored state. */
+            isb_state_t state0 = {.z1 = (int16_t)z1, .z2 = z2}
+                      , state1 = {.z1 = z2, .z2 = (int16_t)z1};
+            int16_t y0, y1;
+            isb_generateBlockPair(&state0, &y0, &state1, &y1, 1);
+            if(y0 != yModel  ||  y1 != modelStep(z2, (int16_t)z1))
+                ++ noDiffs;
+
+            noTests += 3;
+        }
+    }
+    CHECK(noDiffs == 0);
+    printf("  %lu comparisons, %lu differences\n", noTests, noDiffs);
+
+} /* End of testAllStates */
+
+
+
+/**
+ * Test the block interface of the queue: Fill it to the capacity, read it empty and repeat
+ * with varying filling levels, such that the ring buffer wraps around many times.
+ */
+static void testQueue(void)
+{
+    printf("Test block interface of queue\n");
+
+    enum {maxNoBlocks = 256/ITQ_NO_ELEMS_PER_BLOCK - 1};
+    int16_t nextWrite = 0
+          , nextRead = 0;
+    unsigned int noBlocksRead = 0
+               , noDiffs = 0
+               , noBlocks = 1
+               , u;
+    for(u=0; u<100; ++u)
+    {
+        unsigned int idxBlock, idxElem;
+        for(idxBlock=0; idxBlock<noBlocks; ++idxBlock)
+        {
+            int16_t blockAry[ITQ_NO_ELEMS_PER_BLOCK];
+            for(idxElem=0; idxElem<ITQ_NO_ELEMS_PER_BLOCK; ++idxElem)
+                blockAry[idxElem] = nextWrite++;
+            itq_writeBlock(blockAry);
+        }
+        for(idxBlock=0; idxBlock<noBlocks; ++idxBlock)
+        {
+            int16_t blockAry[ITQ_NO_ELEMS_PER_BLOCK];
+            itq_readBlock(blockAry);
+            ++ noBlocksRead;
+            for(idxElem=0; idxElem<ITQ_NO_ELEMS_PER_BLOCK; ++idxElem)
+                if(blockAry[idxElem] != nextRead++)
+                    ++ noDiffs;
+        }
+        noBlocks = noBlocks % maxNoBlocks + 1u;
+    }
+    CHECK(noDiffs == 0);
+    CHECK(rtos_noSentSemaphoreEvents == noBlocksRead);
+    printf("  %u blocks transferred\n", noBlocksRead);
+
+} /* End of testQueue */
+
+
+
+/**
+ * Get the current time.
+ *   @return
+ * Get the time in ns.
+ */
+static double getTimeInNs(void)
+{
+    struct timespec ti;
+    clock_gettime(CLOCK_MONOTONIC, &ti);
+    return (double)ti.tv_sec * 1e9 + (double)ti.tv_nsec;
+
+} /* End of getTimeInNs */
+
+
+
+/**
+ * Benchmark of model and block generators on the host.
+ */
+static void benchmark(void)
+{
+    enum {blockSize = 64, noLoops = 100000};
+    static volatile int16_t sink ATTRIB_UNUSED;
+    static int16_t y0Ary[blockSize], y1Ary[blockSize];
+    unsigned int u, idxSample;
+
+    integerSineZ_initialize();
+    double tiStart = getTimeInNs();
+    for(u=0; u<noLoops; ++u)
+    {
+        for(idxSample=0; idxSample<blockSize; ++idxSample)
+        {
+            integerSineZ_step();
+            y0Ary[idxSample] = integerSineZ_Y.y;
+        }
+        sink = y0Ary[u % blockSize];
+    }
+    const double tiModel = getTimeInNs() - tiStart;
+
+    isb_state_t state0, state1;
+    isb_initState(&state0, 0);
+    isb_initState(&state1, 8);
+    tiStart = getTimeInNs();
+    for(u=0; u<noLoops; ++u)
+    {
+        isb_generateBlock(&state0, y0Ary, blockSize);
+        sink = y0Ary[u % blockSize];
+    }
+    const double tiBlock = getTimeInNs() - tiStart;
+
+    tiStart = getTimeInNs();
+    for(u=0; u<noLoops; ++u)
+    {
+        isb_generateBlockPair(&state0, y0Ary, &state1, y1Ary, blockSize);
+        sink = y1Ary[u % blockSize];
+    }
+    const double tiPair = getTimeInNs() - tiStart;
+
+    const double noSamples = (double)noLoops * blockSize;
+    printf( "Benchmark (host), ns per sample: integerSineZ_step %.2f, isb_generateBlock"
+            " %.2f, isb_generateBlockPair %.2f\n"
+          , tiModel / noSamples
+          , tiBlock / noSamples
+          , tiPair / (2.0*noSamples)
+          );
+} /* End of benchmark */
+
+
+
+/**
+ * Entry point of the test.
+ *   @return
+ * Get 0 if all tests passed.
+ */
+int main(void)
+{
+    testSequence();
+    testAllStates();
+    testQueue();
+    benchmark();
+
+    if(_noErrors == 0)
+        printf("All tests passed\n");
+    else
+        printf("%u checks failed\n", _noErrors);
+
+    return _noErrors == 0? 0: 1;
+
+} /* End of main */
@@ -0,0 +1,67 @@
+#ifndef RTOS_INCLUDED
+#define RTOS_INCLUDED
+/**
+ * @file rtos.h
+ * Host variant of the RTuinOS interface for the test of the inter task queue of test case
+ * tc12. The test runs single threaded; the critical section is void and the events are
+ * only counted.
+ *
+ * Copyright (C) 2018 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*
+ * Defines
+ */
+
+/** The events of the application, see aev_applEvents.h. */
+#define RTOS_EVT_SEMAPHORE_00       ((uint32_t)1<<0)
+#define RTOS_EVT_MUTEX_01           ((uint32_t)1<<1)
+#define RTOS_EVT_EVENT_02           ((uint32_t)1<<2)
+
+/** A critical section is not required in the single threaded test. */
+#define rtos_enterCriticalSection()
+#define rtos_leaveCriticalSection()
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+/** The number of posted semaphore events. The test compares it with the queue contents. */
+extern unsigned int rtos_noSentSemaphoreEvents;
+
+
+/*
+ * Global prototypes
+ */
+
+/** Post an event. */
+void rtos_sendEvent(uint32_t eventVec);
+
+#endif  /* RTOS_INCLUDED */
@@ -0,0 +1,67 @@
+#ifndef LXP_MPC5643L_INCLUDED
+#define LXP_MPC5643L_INCLUDED
+/**
+ * @file MPC5643L.h
+ * Host variant of the MCU header: The register definitions of the original header are
+ * used unchanged but the peripherals, which are used by RTuinOS and its test applications,
+ * are not found at their MCU addresses. SIUL, PIT and INTC are ordinary data objects,
+ * which are owned by the simulation lxp_linuxPort.c. All other peripherals are not
+ * available on the host.
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+/* The original header from the startup folder. */
+#include "../../code/startup/MPC5643L.h"
+
+
+/*
+ * Defines
+ */
+
+#undef SIUL
+#undef PIT_RTI
+#undef INTC
+
+/** The simulated SIUL. Only the GPIO data registers are used. */
+#define SIUL    (lxp_siul)
+
+/** The simulated PIT. The simulation implements the timers and their interrupts. */
+#define PIT_RTI (lxp_pit)
+
+/** The simulated INTC. The simulation only uses the current priority register. */
+#define INTC    (lxp_intc)
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+/** The simulated peripherals. */
+extern volatile SIUL_tag lxp_siul;
+extern volatile PIT_RTI_tag lxp_pit;
+extern volatile INTC_tag lxp_intc;
+
+#endif  /* LXP_MPC5643L_INCLUDED */
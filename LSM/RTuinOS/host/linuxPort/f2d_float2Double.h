@@ -0,0 +1,32 @@
+#ifndef F2D_FLOAT2DOUBLE_INCLUDED
+#define F2D_FLOAT2DOUBLE_INCLUDED
+/**
+ * @file f2d_float2Double.h
+ * Host variant of the interface of module f2d_float2Double.S: On the host, double is a
+ * true 64 Bit type and a float argument of printf is normally promoted to double. The
+ * conversion is a simple type cast.
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Defines
+ */
+
+/** Convert a float into a double, which can be passed to printf. */
+#define f2d(f)  ((double)(f))
+
+#endif  /* F2D_FLOAT2DOUBLE_INCLUDED */
@@ -0,0 +1,118 @@
+#ifndef IHW_INITMCUCOREHW_INCLUDED
+#define IHW_INITMCUCOREHW_INCLUDED
+/**
+ * @file ihw_initMcuCoreHW.h
+ * Host variant of the interface of module ihw_initMcuCoreHW.c: RTuinOS and its test
+ * applications are compiled for Linux and run on the simulation lxp_linuxPort.c. This
+ * header replaces the MCU core related part of the startup code. The functions are
+ * implemented by the simulation, which models the External Interrupts and the time base.
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "typ_types.h"
+#include "int_interruptHandler.h"
+#include "lxp_linuxPort.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global inline functions
+ */
+
+/**
+ * Memory barrier. The simulation runs single threaded and the simulated I/O registers are
+ * ordinary memory; the compiler must not reorder the memory accesses. The register writes
+ * done so far take effect in the simulated peripherals; a read after the barrier sees
+ * their current state.
+ */
+static inline void ihw_memoryBarrier(void)
+{
+    asm volatile ("" ::: "memory");
+    lxp_syncPeripherals();
+    asm volatile ("" ::: "memory");
+
+} /* End of ihw_memoryBarrier */
+
+
+
+/**
+ * Instruction synchronization. The simulation takes a pending, no longer masked interrupt
+ * already when the interrupts are re-enabled, there's nothing left to do.
+ */
+static inline void ihw_instructionSync(void)
+{
+    asm volatile ("" ::: "memory");
+
+} /* End of ihw_instructionSync */
+
+
+
+/*
+ * Global prototypes
+ */
+
+/** Init core HW of MCU so that it can be safely operated. */
+void ihw_initMcuCoreHW(void);
+
+/** Let the client code install an interrupt handler. */
+void ihw_installINTCInterruptHandler( int_externalInterruptHandler_t interruptHandler
+                                    , unsigned short vectorNum
+                                    , unsigned char psrPriority
+                                    , bool isPreemptable
+                                    , bool isKernelInterrupt
+                                    );
+
+/** Disable all External Interrupts. */
+void ihw_suspendAllInterrupts(void);
+
+/** Enable all External Interrupts. */
+void ihw_resumeAllInterrupts(void);
+
+/** Start a critical section. */
+uint32_t ihw_enterCriticalSection(void);
+
+/** End a critical section. */
+void ihw_leaveCriticalSection(uint32_t msr);
+
+/** Read the lower half of the time base of the CPU. */
+uint32_t ihw_getTBL(void);
+
+/** Read the complete, 64 Bit time base of the CPU. */
+uint64_t ihw_getTimeBase(void);
+
+#endif  /* IHW_INITMCUCOREHW_INCLUDED */
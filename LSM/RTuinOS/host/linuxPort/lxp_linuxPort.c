@@ -0,0 +1,1254 @@
+/**
+ * @file lxp_linuxPort.c
+ * Linux port of RTuinOS: The kernel and its test applications are compiled with the
+ * native GCC of the host and run in a single Linux process. This module replaces all code,
+ * which RTuinOS uses to access the hardware:
+ *   - The kernelBuilder's context switch (int_interruptHandler.*.S, ccx_startContext.S)
+ *     is implemented with the ucontext API of the C library. Each execution context gets
+ *     its own host stack; the stack areas of the RTuinOS tasks are prepared by the kernel
+ *     but they are not used. Stack reserve figures are meaningless on the host
+ *   - The time is simulated. Code execution doesn't consume simulated time with three
+ *     exceptions: del_delayMicroseconds() consumes the demanded CPU time, a read of the
+ *     time base, the re-enabling of the interrupts and a system call consume a few clock
+ *     ticks (#LXP_TI_READ_TIME_BASE, #LXP_TI_RESUME_ALL_INTERRUPTS, #LXP_TI_SYSTEM_CALL)
+ *     and an iteration of the idle loop, which didn't consume any time, ends at the next
+ *     interrupt
+ *   - The PIT is simulated; the timers count the simulated time and request their
+ *     interrupts. The timer flag is reset on return from the interrupt handler; the write
+ *     of a one into TFLG[TIF], which acknowledges the timer on the MCU, can't be
+ *     observed in the simulation. The other register writes take effect before the
+ *     simulated time advances, after an interrupt handler and at a memory barrier. The
+ *     counter values CVAL are updated at the same points
+ *   - The INTC is simulated. Interrupts are taken at the points in the code, where the
+ *     simulated time advances or where interrupts are re-enabled. The priority scheme of
+ *     the INTC, including interrupt nesting, is implemented
+ *
+ * Since the points of preemption are defined by the simulated time, the behavior of an
+ * application and its output are reproducible. This is not the case for code, which
+ * polls a condition in an infinite loop without ever calling one of the functions, which
+ * let the simulated time advance. Such a loop is detected by a watchdog, which is clocked
+ * by the CPU time of the process. The watchdog will let the simulated time advance till
+ * the next interrupt. The point in the code, where this happens, is not reproducible.
+ * However, for the most typical case, an empty infinite loop (e.g. in the idle task), the
+ * point doesn't matter and the behavior is still deterministic.
+ *
+ * The simulation ends at a given point in simulated time. Statistics about context
+ * switches, system calls and interrupts are written to stdout; they are reproducible and
+ * can be used to compare the behavior of different kernel implementations. The host CPU
+ * time consumed by the kernel interrupts, the system calls and the context switches is
+ * written to stderr.
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   lxp_initLinuxPort
+ *   lxp_getTime
+ *   lxp_consumeCpuTime
+ *   lxp_waitUntil
+ *   lxp_syncPeripherals
+ *   lxp_idleLoop
+ *   ihw_initMcuCoreHW
+ *   ihw_installINTCInterruptHandler
+ *   ihw_suspendAllInterrupts
+ *   ihw_resumeAllInterrupts
+ *   ihw_enterCriticalSection
+ *   ihw_leaveCriticalSection
+ *   ihw_getTBL
+ *   ihw_getTimeBase
+ *   del_delayMicroseconds
+ *   ccx_createContextSaveDesc
+ *   ccx_createContextSaveDescOnTheFly
+ *   int_systemCall
+ * Local functions
+ *   getHostTime
+ *   enterSimulation
+ *   leaveSimulation
+ *   endOfSimulation
+ *   consumeCpuTime
+ *   pollPit
+ *   getTiNextEvent
+ *   advanceTime
+ *   switchContext
+ *   contextEntry
+ *   getPendingInterrupt
+ *   takeInterrupt
+ *   dispatchInterrupts
+ *   idle
+ *   isEmptyInfiniteLoop
+ *   onWatchdog
+ */
+
+/*
+ * Include files
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+#include "MPC5643L.h"
+#include "typ_types.h"
+#include "int_interruptHandler.h"
+#include "ccx_createContextSaveDesc.h"
+#include "ihw_initMcuCoreHW.h"
+#include "del_delay.h"
+#include "lxp_linuxPort.h"
+
+
+/*
+ * Defines
+ */
+
+/** The maximum number of execution contexts: All RTuinOS tasks and the idle task. */
+#define MAX_NO_CONTEXTS         33u
+
+/** The size of the host stack of an execution context in Byte. The RTuinOS stacks are far
+    too little for the x86-64 code and the C library. */
+#define SIZE_OF_HOST_STACK      (256u*1024u)
+
+/** The size of the stack of the startup context in the linker script of the MCU. The
+    simulation provides an area of this size, which is prepared like an unused stack, so
+    that the kernel can apply its stack reserve computation to the idle task. */
+#define SIZE_OF_IDLE_STACK      4096u
+
+/** The number of vectors of the INTC. */
+#define NO_INTC_VECTORS         256u
+
+/** The number of PIT timers. */
+#define NO_PIT_CHNS             4u
+
+/** The External Interrupt enable bit in the MSR. */
+#define MSR_EE                  0x00008000ul
+
+/** The number of kernel relevant system calls, which are counted in the statistics. */
+#define MAX_NO_SYSTEM_CALLS     8u
+
+/** The period of the watchdog, which detects infinite loops, in Microseconds of process
+    CPU time. */
+#define TI_WATCHDOG_IN_US       2000
+
+/** Marker for "no interrupt pending". */
+#define NO_INTERRUPT            UINT_MAX
+
+
+/*
+ * Local type definitions
+ */
+
+/** An execution context. The context save descriptor of the kernelBuilder points to it by
+    its field pStack. */
+typedef struct context_t
+{
+    /** The saved CPU state of a suspended context. */
+    ucontext_t uc;
+
+    /** The C function, which is entered on first resume of the context. */
+    int_fctEntryIntoContext_t fctEntryIntoContext;
+
+    /** The value signalled to the context on resume. It is either the function argument
+        of the entry function or the return value of the system call, which suspended the
+        context. */
+    uint32_t signal;
+
+} context_t;
+
+
+/** The configuration of an INTC vector and its statistics. */
+typedef struct intcVector_t
+{
+    /** The interrupt service routine. */
+    int_externalInterruptHandler_t handler;
+
+    /** The INTC priority, 1..15. Zero means not installed; such an interrupt is never
+        served. */
+    unsigned int priority;
+
+    /** The handler is run with External Interrupts enabled. */
+    bool isPreemptable;
+
+    /** The handler is a kernel interrupt, which may demand a context switch. */
+    bool isKernelInterrupt;
+
+    /** The number of serviced requests. */
+    unsigned long noRequests;
+
+    /** The number of context switches demanded by the handler. */
+    unsigned long noContextSwitches;
+
+    /** The host time spent in the handler in ns. */
+    unsigned long long tiHost;
+
+} intcVector_t;
+
+
+/** The simulation state of a PIT timer. */
+typedef struct pitChannel_t
+{
+    /** The timer is enabled, TCTRL[TEN] is set. */
+    bool isEnabled;
+
+    /** The timer is counting: It is enabled and the module is not disabled. */
+    bool isRunning;
+
+    /** The next timeout of a running timer. */
+    lxp_time_t tiDue;
+
+    /** The remaining time till timeout of a stopped timer. */
+    lxp_time_t tiRemaining;
+
+} pitChannel_t;
+
+
+/** The interface of a kernel relevant system call handler as it is called by the
+    simulation: The arguments are propagated as full machine words. */
+typedef uint32_t (*systemCallFct_t)( int_cmdContextSwitch_t *pCmdContextSwitch
+                                   , uintptr_t, uintptr_t, uintptr_t, uintptr_t
+                                   , uintptr_t, uintptr_t, uintptr_t
+                                   );
+
+/** The interface of a simple system call handler as it is called by the simulation. */
+typedef uint32_t (*simpleSystemCallFct_t)( uint32_t * const pMSR
+                                         , uintptr_t, uintptr_t, uintptr_t, uintptr_t
+                                         , uintptr_t, uintptr_t, uintptr_t
+                                         );
+
+
+/*
+ * Local prototypes
+ */
+
+static void consumeCpuTime(lxp_time_t tiCpu);
+
+
+/*
+ * Data definitions
+ */
+
+/** The simulated peripherals. */
+volatile SIUL_tag lxp_siul;
+volatile PIT_RTI_tag lxp_pit;
+volatile INTC_tag lxp_intc;
+
+/** The current simulated time. */
+static lxp_time_t _tiSim = 0;
+
+/** The simulation ends when reaching this point in time. */
+static lxp_time_t _tiEndOfSimulation = 0;
+
+/** The state of the External Interrupt enable bit in the MSR of the running context. */
+static bool _isEE = false;
+
+/** The configuration of the INTC. */
+static intcVector_t _intcVectorAry[NO_INTC_VECTORS];
+
+/** The INTC vectors of the PIT timers. */
+static const unsigned int _pitVectorAry[NO_PIT_CHNS] = {59u, 60u, 61u, 127u};
+
+/** The simulation state of the PIT timers. */
+static pitChannel_t _pitChnAry[NO_PIT_CHNS];
+
+/** All execution contexts. Context 0 is the context of main(), which becomes the idle
+    task. */
+static context_t _contextAry[MAX_NO_CONTEXTS];
+
+/** The host stacks of the contexts. */
+static _Alignas(16) uint8_t _hostStackAry[MAX_NO_CONTEXTS][SIZE_OF_HOST_STACK];
+
+/** The number of created contexts. */
+static unsigned int _noContexts = 0;
+
+/** The running context. */
+static context_t *_pActiveContext = NULL;
+
+/** The statistics of the system calls. */
+static unsigned long _noSystemCallAry[MAX_NO_SYSTEM_CALLS]
+                   , _noSimpleSystemCalls = 0
+                   , _noContextSwitchesBySystemCall = 0;
+static unsigned long long _tiHostSystemCalls = 0;
+
+/** The host time spent in context switches, measured from suspension of one to resumption
+    of the other context. */
+static unsigned long long _tiHostContextSwitches = 0, _tiHostStartOfContextSwitch = 0;
+
+/** The number of iterations of the idle loop, which ended at the next interrupt. */
+static unsigned long _noIdleLoops = 0;
+
+/** The simulation code is currently executed. The watchdog must not interfere. */
+static volatile sig_atomic_t _isInSimulation = 0;
+
+/** A counter, which is incremented whenever the simulated time advances. The watchdog
+    detects an infinite loop, if it doesn't change for a period. */
+static volatile unsigned long _cntProgress = 0;
+
+/** The watchdog's copy of _cntProgress. */
+static volatile unsigned long _cntProgressAtLastWatchdog = 0;
+
+/** The number of infinite loops broken by the watchdog. */
+static volatile unsigned long _noWatchdogEvents = 0;
+
+/* The linker script of the MCU defines the stack area of the startup context, which
+   becomes the idle task. The kernel uses the symbols for the stack reserve computation.
+   The area is filled with the pattern of an unused stack; the host stack is not
+   observed. */
+asm( "    .data\n"
+     "    .balign 16\n"
+     "    .globl ld_stackStart\n"
+     "ld_stackStart:\n"
+     "    .fill " "4096" ", 1, 0xa5\n"
+     "    .globl ld_stackEnd\n"
+     "ld_stackEnd:\n"
+     "    .text\n"
+   );
+_Static_assert(SIZE_OF_IDLE_STACK == 4096u, "Size of idle stack inconsistent with asm");
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Read the host clock.
+ *   @return
+ * Get the time in ns.
+ */
+static unsigned long long getHostTime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec*1000000000ull + (unsigned long long)ts.tv_nsec;
+
+} /* End of getHostTime */
+
+
+
+/**
+ * Mark the entry into the simulation code. The watchdog doesn't interfere with the
+ * simulation.
+ */
+static inline void enterSimulation(void)
+{
+    _isInSimulation = 1;
+
+} /* End of enterSimulation */
+
+
+
+/**
+ * Mark the return from the simulation code into the code of RTuinOS or an application.
+ */
+static inline void leaveSimulation(void)
+{
+    _isInSimulation = 0;
+
+} /* End of leaveSimulation */
+
+
+
+/**
+ * The simulated time has reached the end of the simulation. The statistics are printed
+ * and the process is terminated.
+ */
+static _Noreturn void endOfSimulation(void)
+{
+    unsigned long noInterrupts = 0, noKernelInterrupts = 0, noContextSwitchesByIsr = 0;
+    unsigned long long tiHostKernelIsrs = 0;
+    unsigned int u;
+    for(u=0; u<NO_INTC_VECTORS; ++u)
+    {
+        const intcVector_t * const pVec = &_intcVectorAry[u];
+        noInterrupts += pVec->noRequests;
+        if(pVec->isKernelInterrupt)
+        {
+            noKernelInterrupts += pVec->noRequests;
+            tiHostKernelIsrs += pVec->tiHost;
+        }
+        noContextSwitchesByIsr += pVec->noContextSwitches;
+    }
+
+    unsigned long noSystemCalls = _noSimpleSystemCalls;
+    for(u=0; u<MAX_NO_SYSTEM_CALLS; ++u)
+        noSystemCalls += _noSystemCallAry[u];
+
+    const unsigned long noContextSwitches = noContextSwitchesByIsr
+                                            + _noContextSwitchesBySystemCall;
+
+    /* The reproducible results go to stdout. */
+    printf( "\r\n"
+            "lxp_linuxPort: End of simulation at %.3f s\r\n"
+            "lxp_linuxPort: Context switches: %lu (by interrupt: %lu, by system call: %lu)\r\n"
+            "lxp_linuxPort: System calls: %lu\r\n"
+          , (double)_tiSim / LXP_TICKS_PER_SECOND
+          , noContextSwitches
+          , noContextSwitchesByIsr
+          , _noContextSwitchesBySystemCall
+          , noSystemCalls
+          );
+    for(u=0; u<MAX_NO_SYSTEM_CALLS; ++u)
+    {
+        if(_noSystemCallAry[u] > 0)
+            printf("lxp_linuxPort:   System call %d: %lu\r\n", ~(int)u, _noSystemCallAry[u]);
+    }
+    if(_noSimpleSystemCalls > 0)
+        printf("lxp_linuxPort:   Simple system calls: %lu\r\n", _noSimpleSystemCalls);
+    printf("lxp_linuxPort: Interrupts: %lu\r\n", noInterrupts);
+    for(u=0; u<NO_INTC_VECTORS; ++u)
+    {
+        const intcVector_t * const pVec = &_intcVectorAry[u];
+        if(pVec->noRequests > 0)
+        {
+            printf( "lxp_linuxPort:   Vector %u (%s, priority %u): %lu, context switches: %lu"
+                    "\r\n"
+                  , u
+                  , pVec->isKernelInterrupt? "kernel": "simple"
+                  , pVec->priority
+                  , pVec->noRequests
+                  , pVec->noContextSwitches
+                  );
+        }
+    }
+    printf("lxp_linuxPort: Idle loops ended at next interrupt: %lu\r\n", _noIdleLoops);
+    fflush(stdout);
+
+    /* The host dependent results go to stderr. */
+    fprintf( stderr
+           , "lxp_linuxPort: Host CPU time per kernel interrupt: %.1f ns, per system call:"
+             " %.1f ns, per context switch: %.1f ns\n"
+             "lxp_linuxPort: Infinite loops broken by the watchdog: %lu\n"
+           , noKernelInterrupts > 0? (double)tiHostKernelIsrs / noKernelInterrupts: 0.0
+           , noSystemCalls > 0? (double)_tiHostSystemCalls / noSystemCalls: 0.0
+           , noContextSwitches > 0? (double)_tiHostContextSwitches / noContextSwitches: 0.0
+           , _noWatchdogEvents
+           );
+    exit(EXIT_SUCCESS);
+
+} /* End of endOfSimulation */
+
+
+
+/**
+ * Update the state of the PIT timers after the client code may have changed the
+ * configuration registers. Registers writes don't consume simulated time. Therefore, it
+ * is sufficient to look at them before the simulated time advances and after calling an
+ * interrupt handler.
+ */
+static void pollPit(void)
+{
+    /* PITMCR[MDIS] stops all timers. */
+    const bool isModuleEnabled = (PIT.PITMCR.R & 0x2u) == 0;
+
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<NO_PIT_CHNS; ++idxChn)
+    {
+        pitChannel_t * const pChn = &_pitChnAry[idxChn];
+        const bool isEnabled = (PIT.CHANNEL[idxChn].TCTRL.R & 0x1u) != 0
+                 , isRunning = isEnabled && isModuleEnabled;
+
+        /* Enabling a timer loads the counter with LDVAL. The period is LDVAL+1. */
+        if(isEnabled && !pChn->isEnabled)
+            pChn->tiRemaining = (lxp_time_t)PIT.CHANNEL[idxChn].LDVAL.R + 1u;
+
+        if(isRunning && !pChn->isRunning)
+            pChn->tiDue = _tiSim + pChn->tiRemaining;
+        else if(!isRunning && pChn->isRunning)
+            pChn->tiRemaining = pChn->tiDue - _tiSim;
+
+        pChn->isEnabled = isEnabled;
+        pChn->isRunning = isRunning;
+
+        /* The counter counts down to zero. */
+        if(isRunning  &&  pChn->tiDue > _tiSim)
+            PIT.CHANNEL[idxChn].CVAL.R = (uint32_t)(pChn->tiDue - _tiSim - 1u);
+        else if(isEnabled  &&  !isRunning)
+            PIT.CHANNEL[idxChn].CVAL.R = (uint32_t)(pChn->tiRemaining - 1u);
+    }
+} /* End of pollPit */
+
+
+
+/**
+ * Get the point in time of the next event of the simulated peripherals.
+ *   @return
+ * Get the time of the next timeout of a PIT timer or the end of the simulation.
+ */
+static lxp_time_t getTiNextEvent(void)
+{
+    lxp_time_t tiNext = _tiEndOfSimulation;
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<NO_PIT_CHNS; ++idxChn)
+    {
+        const pitChannel_t * const pChn = &_pitChnAry[idxChn];
+        if(pChn->isRunning  &&  pChn->tiDue < tiNext)
+            tiNext = pChn->tiDue;
+    }
+    return tiNext;
+
+} /* End of getTiNextEvent */
+
+
+
+/**
+ * Advance the simulated time. The timers, which elapse at the new time, set their flags.
+ *   @param tiTo
+ * The new simulated time. It must not be later than the next event, see getTiNextEvent().
+ */
+static void advanceTime(lxp_time_t tiTo)
+{
+    assert(tiTo >= _tiSim  &&  tiTo <= getTiNextEvent());
+    if(tiTo > _tiSim)
+    {
+        _tiSim = tiTo;
+        ++ _cntProgress;
+    }
+
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<NO_PIT_CHNS; ++idxChn)
+    {
+        pitChannel_t * const pChn = &_pitChnAry[idxChn];
+        if(pChn->isRunning  &&  pChn->tiDue == _tiSim)
+        {
+            /* The flag is set regardless of TCTRL[TIE]. The timer reloads with the current
+               value of LDVAL. */
+            PIT.CHANNEL[idxChn].TFLG.B.TIF = 1;
+            pChn->tiDue += (lxp_time_t)PIT.CHANNEL[idxChn].LDVAL.R + 1u;
+        }
+    }
+
+    if(_tiSim >= _tiEndOfSimulation)
+        endOfSimulation();
+
+} /* End of advanceTime */
+
+
+
+/**
+ * Execute a context switch as commanded by a kernel interrupt or a system call. The
+ * function returns when the suspended context is resumed again.
+ *   @param pCmdContextSwitch
+ * The command from the kernel: Which context to suspend and which one to resume.
+ */
+static void switchContext(const int_cmdContextSwitch_t *pCmdContextSwitch)
+{
+    context_t * const pSuspendedContext =
+                                (context_t*)pCmdContextSwitch->pSuspendedContextSaveDesc->pStack;
+    context_t * const pResumedContext =
+                                (context_t*)pCmdContextSwitch->pResumedContextSaveDesc->pStack;
+    assert(pSuspendedContext == _pActiveContext  &&  pResumedContext != NULL
+           &&  pResumedContext != pSuspendedContext
+          );
+
+    pResumedContext->signal = pCmdContextSwitch->signalToResumedContext;
+    _pActiveContext = pResumedContext;
+    _tiHostStartOfContextSwitch = getHostTime();
+    swapcontext(&pSuspendedContext->uc, &pResumedContext->uc);
+
+    /* Here, we are resumed again. */
+    _tiHostContextSwitches += getHostTime() - _tiHostStartOfContextSwitch;
+    assert(_pActiveContext == pSuspendedContext);
+
+} /* End of switchContext */
+
+
+
+/**
+ * The entry into a new context on its first resume.
+ */
+static void contextEntry(void)
+{
+    _tiHostContextSwitches += getHostTime() - _tiHostStartOfContextSwitch;
+
+    /* A new context is started with External Interrupts enabled. */
+    const context_t * const pContext = _pActiveContext;
+    _isEE = true;
+    leaveSimulation();
+    const uint32_t retVal = pContext->fctEntryIntoContext(pContext->signal);
+    int_fctOnContextEnd(retVal);
+
+} /* End of contextEntry */
+
+
+
+/**
+ * Find the pending interrupt, which is served next by the INTC.
+ *   @return
+ * Get the vector number or #NO_INTERRUPT if there's no pending interrupt with a priority
+ * higher than the current priority of the INTC.
+ */
+static unsigned int getPendingInterrupt(void)
+{
+    unsigned int idxVec = NO_INTERRUPT
+               , priority = INTC.CPR_PRC0.R;
+
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<NO_PIT_CHNS; ++idxChn)
+    {
+        if((PIT.CHANNEL[idxChn].TCTRL.R & 0x2u) != 0  &&  PIT.CHANNEL[idxChn].TFLG.B.TIF)
+        {
+            /* Of several requests with same priority, the lowest vector number wins. */
+            const unsigned int idxVecChn = _pitVectorAry[idxChn];
+            if(_intcVectorAry[idxVecChn].priority > priority
+               ||  (_intcVectorAry[idxVecChn].priority == priority
+                    &&  idxVec != NO_INTERRUPT  &&  idxVecChn < idxVec
+                   )
+              )
+            {
+                idxVec = idxVecChn;
+                priority = _intcVectorAry[idxVecChn].priority;
+            }
+        }
+    }
+    return idxVec;
+
+} /* End of getPendingInterrupt */
+
+
+
+/**
+ * Serve an interrupt: The current priority of the INTC is raised to the priority of the
+ * interrupt and the handler is called. A kernel interrupt can demand a context switch
+ * at return.
+ *   @param idxVec
+ * The vector number of the interrupt.
+ */
+static void takeInterrupt(unsigned int idxVec)
+{
+    intcVector_t * const pVec = &_intcVectorAry[idxVec];
+    const uint32_t priorityLevelSoFar = INTC.CPR_PRC0.R;
+    assert(_isEE  &&  pVec->priority > priorityLevelSoFar);
+
+    ++ pVec->noRequests;
+    INTC.CPR_PRC0.R = pVec->priority;
+    _isEE = pVec->isPreemptable;
+
+    int_cmdContextSwitch_t cmdContextSwitch;
+    uint32_t rc = int_rcIsr_doNotSwitchContext;
+    const unsigned long long tiHostStart = getHostTime();
+    leaveSimulation();
+    if(pVec->isKernelInterrupt)
+        rc = pVec->handler.kernelIsr(&cmdContextSwitch);
+    else
+        pVec->handler.simpleIsr();
+    enterSimulation();
+    pVec->tiHost += getHostTime() - tiHostStart;
+
+    /* The handler of a PIT interrupt acknowledges the timer by writing a one into
+       TFLG[TIF]. This write doesn't change the register value in memory; the
+       simulation can't observe it and clears the flag on return from the handler
+       instead. */
+    unsigned int idxChn;
+    for(idxChn=0; idxChn<NO_PIT_CHNS; ++idxChn)
+    {
+        if(_pitVectorAry[idxChn] == idxVec)
+            PIT.CHANNEL[idxChn].TFLG.B.TIF = 0;
+    }
+
+    /* End of interrupt: The INTC restores the priority of the interrupted context. */
+    _isEE = false;
+    INTC.CPR_PRC0.R = priorityLevelSoFar;
+
+    if(rc != int_rcIsr_doNotSwitchContext)
+    {
+        ++ pVec->noContextSwitches;
+        switchContext(&cmdContextSwitch);
+    }
+
+    /* The interrupted context is continued with External Interrupts enabled. */
+    _isEE = true;
+
+} /* End of takeInterrupt */
+
+
+
+/**
+ * Serve all pending interrupts, which are not masked.
+ */
+static void dispatchInterrupts(void)
+{
+    while(_isEE)
+    {
+        /* An interrupt handler may have reconfigured the timers. */
+        pollPit();
+
+        const unsigned int idxVec = getPendingInterrupt();
+        if(idxVec == NO_INTERRUPT)
+            break;
+
+        if(_intcVectorAry[idxVec].handler.simpleIsr == NULL)
+        {
+            fprintf(stderr, "lxp_linuxPort: No handler installed for vector %u\n", idxVec);
+            abort();
+        }
+        takeInterrupt(idxVec);
+    }
+} /* End of dispatchInterrupts */
+
+
+
+/**
+ * The calling context waits for the next interrupt: The simulated time advances to the
+ * next event.
+ */
+static void idle(void)
+{
+    pollPit();
+    dispatchInterrupts();
+    advanceTime(getTiNextEvent());
+    dispatchInterrupts();
+
+} /* End of idle */
+
+
+
+/**
+ * Check if an instruction is an empty infinite loop, which is e.g. the result of
+ * compiling while(true);
+ *   @return
+ * \a true if the instruction is a jump to itself.
+ *   @param pInstr
+ * The address of the instruction.
+ */
+static bool isEmptyInfiniteLoop(const uint8_t *pInstr)
+{
+    extern const uint8_t __executable_start[], etext[];
+
+    /* Only the code of the executable is inspected. The code of the C library must not be
+       interrupted anyway. */
+    if(pInstr < __executable_start  ||  pInstr + 2 > etext)
+        return false;
+
+    /* x86-64: jmp rel8 with displacement -2. */
+    return pInstr[0] == 0xeb  &&  pInstr[1] == 0xfe;
+
+} /* End of isEmptyInfiniteLoop */
+
+
+
+/**
+ * The watchdog. It is called by a signal, which is clocked by the CPU time of the
+ * process. If the simulation hasn't been entered since the last call then the running
+ * context is considered to poll a condition in an infinite loop. The simulated time is
+ * advanced to the next interrupt. An empty infinite loop is continued by waiting for the
+ * next interrupt, again and again.
+ *   @param sig
+ * The signal number.
+ *   @param pInfo
+ * Information about the signal.
+ *   @param pUContext
+ * The interrupted CPU state.
+ */
+static void onWatchdog(int sig ATTRIB_UNUSED, siginfo_t *pInfo ATTRIB_UNUSED, void *pUContext)
+{
+    if(_isInSimulation  ||  _cntProgress != _cntProgressAtLastWatchdog)
+    {
+        _cntProgressAtLastWatchdog = _cntProgress;
+        return;
+    }
+
+    extern const uint8_t __executable_start[], etext[];
+    const uint8_t * const pInstr =
+                    (const uint8_t*)((ucontext_t*)pUContext)->uc_mcontext.gregs[REG_RIP];
+    if(pInstr < __executable_start  ||  pInstr >= etext)
+    {
+        /* We are in the C library. We must not interfere now, try again later. */
+        return;
+    }
+
+    ++ _noWatchdogEvents;
+    enterSimulation();
+    do
+    {
+        idle();
+    }
+    while(isEmptyInfiniteLoop(pInstr));
+    _cntProgressAtLastWatchdog = _cntProgress;
+    leaveSimulation();
+
+} /* End of onWatchdog */
+
+
+
+/**
+ * Initialize the simulation. Needs to be called first from main(). The calling context
+ * becomes the idle task of RTuinOS.
+ *   @param tiEndOfSimulation
+ * The simulation ends when reaching this point in simulated time.
+ */
+void lxp_initLinuxPort(lxp_time_t tiEndOfSimulation)
+{
+    _tiEndOfSimulation = tiEndOfSimulation;
+
+    /* Reset values of the peripherals. PITMCR: Module disabled, timers stopped in debug
+       mode. The buttons are connected to ground if pressed. */
+    PIT.PITMCR.R = 0x6u;
+    SIU.GPDI[86].B.PDI = 1;
+    SIU.GPDI[87].B.PDI = 1;
+
+    /* The calling context is context 0. */
+    assert(_noContexts == 0);
+    _pActiveContext = &_contextAry[_noContexts++];
+
+    /* Install the watchdog. */
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = onWatchdog;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGVTALRM, &sa, NULL);
+    const struct itimerval period = { .it_interval = {.tv_sec = 0, .tv_usec = TI_WATCHDOG_IN_US}
+                                    , .it_value = {.tv_sec = 0, .tv_usec = TI_WATCHDOG_IN_US}
+                                    };
+    setitimer(ITIMER_VIRTUAL, &period, NULL);
+
+} /* End of lxp_initLinuxPort */
+
+
+
+/**
+ * Get the current simulated time.
+ *   @return
+ * Get the time in ticks of the CPU clock.
+ */
+lxp_time_t lxp_getTime(void)
+{
+    return _tiSim;
+
+} /* End of lxp_getTime */
+
+
+
+/**
+ * The calling context consumes CPU time. The simulated time advances and interrupts are
+ * served when they become due. The CPU time spent in the interrupts and other contexts
+ * doesn't count.
+ *   @param tiCpu
+ * The CPU time to consume in ticks of the CPU clock.
+ */
+void lxp_consumeCpuTime(lxp_time_t tiCpu)
+{
+    enterSimulation();
+    consumeCpuTime(tiCpu);
+    leaveSimulation();
+
+} /* End of lxp_consumeCpuTime */
+
+
+
+/**
+ * The running context consumes CPU time. The simulated time advances and interrupts are
+ * served when they become due.
+ *   @param tiCpu
+ * The CPU time to consume in ticks of the CPU clock.
+ *   @remark
+ * This function must be called from inside the simulation.
+ */
+static void consumeCpuTime(lxp_time_t tiCpu)
+{
+    while(true)
+    {
+        pollPit();
+        dispatchInterrupts();
+        if(tiCpu == 0)
+            break;
+
+        lxp_time_t tiStep = getTiNextEvent() - _tiSim;
+        if(tiStep > tiCpu)
+            tiStep = tiCpu;
+        advanceTime(_tiSim + tiStep);
+        tiCpu -= tiStep;
+    }
+} /* End of consumeCpuTime */
+
+
+
+/**
+ * The calling context waits busy until the simulated world time has reached a given point
+ * in time. Interrupts are served when they become due.
+ *   @param tiEnd
+ * The point in simulated time, when to return.
+ */
+void lxp_waitUntil(lxp_time_t tiEnd)
+{
+    enterSimulation();
+    while(true)
+    {
+        pollPit();
+        dispatchInterrupts();
+        if(_tiSim >= tiEnd)
+            break;
+
+        lxp_time_t tiNext = getTiNextEvent();
+        if(tiNext > tiEnd)
+            tiNext = tiEnd;
+        advanceTime(tiNext);
+    }
+    leaveSimulation();
+
+} /* End of lxp_waitUntil */
+
+
+
+/**
+ * Let the register writes to the simulated peripherals take effect and update their
+ * status registers. This is called at a memory barrier of the client code. The function
+ * can be called from inside and outside of the simulation.
+ */
+void lxp_syncPeripherals(void)
+{
+    const sig_atomic_t isInSimulation = _isInSimulation;
+    enterSimulation();
+    pollPit();
+    _isInSimulation = isInSimulation;
+
+} /* End of lxp_syncPeripherals */
+
+
+
+/**
+ * The idle task of RTuinOS calls this function instead of the application's loop(). (The
+ * kernel is compiled with -Dloop=lxp_idleLoop.) If an iteration of loop() doesn't
+ * consume simulated time, then the idle task waits for the next interrupt. Otherwise an
+ * idle task, which runs in zero time, would hang the simulation.
+ */
+void lxp_idleLoop(void)
+{
+    extern void loop(void);
+
+    const lxp_time_t tiStart = _tiSim;
+    loop();
+    if(_tiSim == tiStart)
+    {
+        enterSimulation();
+        ++ _noIdleLoops;
+        idle();
+        leaveSimulation();
+    }
+} /* End of lxp_idleLoop */
+
+
+
+/**
+ * The application's idle function loop() is optional. This is the default
+ * implementation.
+ */
+__attribute__((weak)) void loop(void)
+{
+} /* End of loop */
+
+
+
+/**
+ * Init core HW of MCU so that it can be safely operated. Nothing to do in the
+ * simulation.
+ */
+void ihw_initMcuCoreHW(void)
+{
+} /* End of ihw_initMcuCoreHW */
+
+
+
+/**
+ * Install an interrupt service routine for a given INTC vector.
+ *   @param interruptHandler
+ * The interrupt service routine.
+ *   @param vectorNum
+ * The interrupt vector number.
+ *   @param psrPriority
+ * The INTC priority, 1..15.
+ *   @param isPreemptable
+ * The handler is run with External Interrupts enabled.
+ *   @param isKernelInterrupt
+ * The handler is a kernel interrupt, which may demand a context switch.
+ */
+void ihw_installINTCInterruptHandler( int_externalInterruptHandler_t interruptHandler
+                                    , unsigned short vectorNum
+                                    , unsigned char psrPriority
+                                    , bool isPreemptable
+                                    , bool isKernelInterrupt
+                                    )
+{
+    assert(vectorNum < NO_INTC_VECTORS  &&  psrPriority >= 1  &&  psrPriority <= 15
+           &&  interruptHandler.simpleIsr != NULL
+          );
+    const uint32_t msr = ihw_enterCriticalSection();
+    intcVector_t * const pVec = &_intcVectorAry[vectorNum];
+    pVec->handler = interruptHandler;
+    pVec->priority = psrPriority;
+    pVec->isPreemptable = isPreemptable;
+    pVec->isKernelInterrupt = isKernelInterrupt;
+    ihw_leaveCriticalSection(msr);
+
+} /* End of ihw_installINTCInterruptHandler */
+
+
+
+/**
+ * Disable all External Interrupts.
+ */
+void ihw_suspendAllInterrupts(void)
+{
+    _isEE = false;
+
+} /* End of ihw_suspendAllInterrupts */
+
+
+
+/**
+ * Enable all External Interrupts. Pending interrupts are served immediately. The
+ * operation consumes #LXP_TI_RESUME_ALL_INTERRUPTS of simulated CPU time.
+ */
+void ihw_resumeAllInterrupts(void)
+{
+    enterSimulation();
+    _isEE = true;
+    consumeCpuTime(LXP_TI_RESUME_ALL_INTERRUPTS);
+    leaveSimulation();
+
+} /* End of ihw_resumeAllInterrupts */
+
+
+
+/**
+ * Start a critical section by disabling all External Interrupts.
+ *   @return
+ * Get the MSR as it was before. Only the EE bit is simulated.
+ */
+uint32_t ihw_enterCriticalSection(void)
+{
+    const uint32_t msr = _isEE? MSR_EE: 0;
+    _isEE = false;
+    return msr;
+
+} /* End of ihw_enterCriticalSection */
+
+
+
+/**
+ * End a critical section by restoring the External Interrupt enable bit.
+ *   @param msr
+ * The MSR as returned by the related call of ihw_enterCriticalSection().
+ */
+void ihw_leaveCriticalSection(uint32_t msr)
+{
+    if((msr & MSR_EE) != 0)
+        ihw_resumeAllInterrupts();
+
+} /* End of ihw_leaveCriticalSection */
+
+
+
+/**
+ * Read the lower half of the time base of the CPU.
+ *   @return
+ * Get the lower 32 Bit of the simulated time.
+ */
+uint32_t ihw_getTBL(void)
+{
+    return (uint32_t)ihw_getTimeBase();
+
+} /* End of ihw_getTBL */
+
+
+
+/**
+ * Read the time base of the CPU. The read consumes #LXP_TI_READ_TIME_BASE of simulated
+ * CPU time so that a loop, which polls the time base, makes the time progress.
+ *   @return
+ * Get the simulated time.
+ */
+uint64_t ihw_getTimeBase(void)
+{
+    lxp_consumeCpuTime(LXP_TI_READ_TIME_BASE);
+    return _tiSim;
+
+} /* End of ihw_getTimeBase */
+
+
+
+/**
+ * Delay code execution: The calling context consumes the demanded CPU time. The delay is
+ * extended by the time spent in interrupts and other contexts.
+ *   @param tiCpuInUs
+ * The delay time in Microseconds.
+ */
+void del_delayMicroseconds(unsigned int tiCpuInUs)
+{
+    lxp_consumeCpuTime(LXP_US_TO_TICKS(tiCpuInUs));
+
+} /* End of del_delayMicroseconds */
+
+
+
+/**
+ * Create the context save descriptor of a new context, which is started on its first
+ * resume.
+ *   @param pContextSaveDesc
+ * The descriptor to initialize.
+ *   @param stackPointer
+ * The initial stack pointer value of the context on the target. It is not used; the
+ * context runs on a host stack.
+ *   @param fctEntryIntoContext
+ * The C function to enter on first resume.
+ *   @param privilegedMode
+ * The mode of the context. Doesn't matter on the host.
+ */
+void ccx_createContextSaveDesc( int_contextSaveDesc_t *pContextSaveDesc
+                              , void *stackPointer ATTRIB_DBG_ONLY
+                              , int_fctEntryIntoContext_t fctEntryIntoContext
+                              , bool privilegedMode
+                              )
+{
+    assert(stackPointer != NULL  &&  fctEntryIntoContext != NULL);
+    if(_noContexts >= MAX_NO_CONTEXTS)
+    {
+        fprintf(stderr, "lxp_linuxPort: Too many contexts, see MAX_NO_CONTEXTS\n");
+        abort();
+    }
+
+    const unsigned int idxContext = _noContexts++;
+    context_t * const pContext = &_contextAry[idxContext];
+    getcontext(&pContext->uc);
+    pContext->uc.uc_stack.ss_sp = _hostStackAry[idxContext];
+    pContext->uc.uc_stack.ss_size = sizeof(_hostStackAry[idxContext]);
+    pContext->uc.uc_link = NULL;
+    makecontext(&pContext->uc, contextEntry, 0);
+    pContext->fctEntryIntoContext = fctEntryIntoContext;
+    pContext->signal = 0;
+
+    pContextSaveDesc->idxSysCall = 0;
+    pContextSaveDesc->pStack = pContext;
+    pContextSaveDesc->fctEntryIntoContext = fctEntryIntoContext;
+    pContextSaveDesc->privilegedMode = privilegedMode;
+
+} /* End of ccx_createContextSaveDesc */
+
+
+
+/**
+ * Create the context save descriptor of a context, which is started on the fly. On the
+ * host, only the calling context can be referenced by a descriptor of this kind; this is
+ * the way RTuinOS makes the context of main() the idle task.
+ *   @param pNewContextSaveDesc
+ * The descriptor to initialize.
+ *   @param stackPointer
+ * Must be NULL.
+ *   @param fctEntryIntoOnTheFlyStartedContext
+ * Must be NULL.
+ *   @param privilegedMode
+ * The mode of the context. Doesn't matter on the host.
+ */
+void ccx_createContextSaveDescOnTheFly
+                        ( int_contextSaveDesc_t *pNewContextSaveDesc
+                        , void *stackPointer ATTRIB_DBG_ONLY
+                        , int_fctEntryIntoContext_t fctEntryIntoOnTheFlyStartedContext
+                                                                            ATTRIB_DBG_ONLY
+                        , bool privilegedMode
+                        )
+{
+    assert(stackPointer == NULL  &&  fctEntryIntoOnTheFlyStartedContext == NULL);
+    pNewContextSaveDesc->idxSysCall = 0;
+    pNewContextSaveDesc->pStack = _pActiveContext;
+    pNewContextSaveDesc->fctEntryIntoContext = NULL;
+    pNewContextSaveDesc->privilegedMode = privilegedMode;
+
+} /* End of ccx_createContextSaveDescOnTheFly */
+
+
+
+/**
+ * Execute a system call. The handler is taken from the tables of the kernel. A kernel
+ * relevant system call may demand a context switch.
+ *   @return
+ * Get the value, which is signalled by the kernel to the calling context.
+ *   @param idxSysCall
+ * The index of the system call. Kernel relevant system calls have negative indexes.
+ *   @param ...
+ * Up to seven arguments of the system call. As on the target, only integer and pointer
+ * arguments are supported.
+ */
+uint32_t int_systemCall(int32_t idxSysCall, ...)
+{
+    /* The number of arguments is not known. We read the maximum number; surplus values
+       are ignored by the handler. */
+    uintptr_t a[7];
+    va_list ap;
+    va_start(ap, idxSysCall);
+    unsigned int u;
+    for(u=0; u<sizeOfAry(a); ++u)
+        a[u] = va_arg(ap, uintptr_t);
+    va_end(ap);
+
+    enterSimulation();
+
+    /* A system call is executed with External Interrupts disabled. */
+    bool isEE = _isEE;
+    _isEE = false;
+
+    uint32_t retVal;
+    const unsigned long long tiHostStart = getHostTime();
+    if(idxSysCall < 0)
+    {
+        const unsigned int idxTable = (unsigned int)~idxSysCall;
+        assert(idxTable < int_noSystemCalls  &&  idxTable < MAX_NO_SYSTEM_CALLS);
+        ++ _noSystemCallAry[idxTable];
+
+        int_cmdContextSwitch_t cmdContextSwitch;
+        const systemCallFct_t fct = (systemCallFct_t)int_systemCallHandlerAry[idxTable];
+        leaveSimulation();
+        const uint32_t rc = fct(&cmdContextSwitch, a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+        enterSimulation();
+        _tiHostSystemCalls += getHostTime() - tiHostStart;
+
+        if(rc != int_rcIsr_doNotSwitchContext)
+        {
+            ++ _noContextSwitchesBySystemCall;
+            switchContext(&cmdContextSwitch);
+            retVal = _pActiveContext->signal;
+        }
+        else
+            retVal = cmdContextSwitch.signalToResumedContext;
+    }
+    else
+    {
+        assert((unsigned)idxSysCall < int_noSimpleSystemCalls);
+        ++ _noSimpleSystemCalls;
+
+        uint32_t msr = isEE? MSR_EE: 0;
+        const simpleSystemCallFct_t fct =
+                            (simpleSystemCallFct_t)int_simpleSystemCallHandlerAry[idxSysCall];
+        leaveSimulation();
+        retVal = fct(&msr, a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+        enterSimulation();
+        _tiHostSystemCalls += getHostTime() - tiHostStart;
+        isEE = (msr & MSR_EE) != 0;
+    }
+
+    /* Return to the calling context, serve interrupts, which might have become pending
+       while other contexts had the interrupts disabled. The calling context is charged
+       with the CPU time of the system call. */
+    _isEE = isEE;
+    consumeCpuTime(LXP_TI_SYSTEM_CALL);
+    leaveSimulation();
+
+    return retVal;
+
+} /* End of int_systemCall */
@@ -0,0 +1,92 @@
+#ifndef LXP_LINUXPORT_INCLUDED
+#define LXP_LINUXPORT_INCLUDED
+/**
+ * @file lxp_linuxPort.h
+ * Definition of global interface of module lxp_linuxPort.c
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*
+ * Defines
+ */
+
+/** The clock rate of the simulated time. It is the CPU clock of the MCU, which clocks the
+    time base and the PIT. Unit is Hz. */
+#define LXP_TICKS_PER_SECOND    (120000000ull)
+
+/** Convert a time designation in Microseconds into simulated time. */
+#define LXP_US_TO_TICKS(tiInUs) ((lxp_time_t)(tiInUs) * (LXP_TICKS_PER_SECOND/1000000ull))
+
+/** The simulated CPU time, which is consumed by a read of the time base. A polling loop on
+    the time base will make the simulated time progress. Unit is CPU clock ticks. */
+#define LXP_TI_READ_TIME_BASE   10u
+
+/** The simulated CPU time, which is consumed by re-enabling the External Interrupts. A
+    loop, which protects its operation by a critical section, will make the simulated time
+    progress. Unit is CPU clock ticks. */
+#define LXP_TI_RESUME_ALL_INTERRUPTS 10u
+
+/** The simulated CPU time, which is consumed by a system call. A loop of system calls,
+    which don't suspend the calling task, will make the simulated time progress. Unit is
+    CPU clock ticks. */
+#define LXP_TI_SYSTEM_CALL      50u
+
+
+/*
+ * Global type definitions
+ */
+
+/** The simulated time in ticks of the CPU clock, see #LXP_TICKS_PER_SECOND. */
+typedef uint64_t lxp_time_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize the simulation. To be called first from main(). */
+void lxp_initLinuxPort(lxp_time_t tiEndOfSimulation);
+
+/** Get the current simulated time. */
+lxp_time_t lxp_getTime(void);
+
+/** Consume CPU time: The simulated time advances while the calling context executes. */
+void lxp_consumeCpuTime(lxp_time_t tiCpu);
+
+/** Busy wait until the simulated world time has reached a given point in time. */
+void lxp_waitUntil(lxp_time_t tiEnd);
+
+/** Let the register writes to the simulated peripherals take effect. */
+void lxp_syncPeripherals(void);
+
+/** The replacement of the application's idle function loop(). */
+void lxp_idleLoop(void);
+
+#endif  /* LXP_LINUXPORT_INCLUDED */
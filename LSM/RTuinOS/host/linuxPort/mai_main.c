@@ -0,0 +1,200 @@
+/**
+ * @file mai_main.c
+ *   Host variant of the main module of the RTuinOS samples: The entry point into the code
+ * is the normal main function of a Linux process. It initializes the simulation of the
+ * MCU, lxp_linuxPort.c, and then it behaves as the main function on the target: The
+ * devices are initialized and the RTuinOS initialization is invoked from where code
+ * execution never returns. The process ends when the simulated time has reached the
+ * demanded duration of the simulation.\n
+ *   The Arduino style timing functions are implemented on the simulated time base.
+ *
+ * Copyright (C) 2017-2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   delay
+ *   millis
+ *   micros
+ *   mai_blink
+ *   main
+ * Local functions
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "typ_types.h"
+#include "ihw_initMcuCoreHW.h"
+#include "lbd_ledAndButtonDriver.h"
+#include "lxp_linuxPort.h"
+#include "rtos.h"
+#include "mai_main.h"
+
+
+/*
+ * Defines
+ */
+
+/** The default duration of the simulation in s, if it is not specified on the command
+    line. */
+#define TI_DEFAULT_SIMULATION   10.0
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Delay code execution for a number of Milliseconds of world time. The delay is
+ * independent of the system load.\n
+ *   Note, this function emulates an Arduino standard function. This explains, why the name
+ * doesn't comply with our normal naming pattern.
+ *   @param tiInMs
+ * The number of Milliseconds to stay in the function. The range is limited to 0..INT_MAX
+ */
+void delay(unsigned int tiInMs)
+{
+    assert(tiInMs <= INT_MAX);
+    lxp_waitUntil(lxp_getTime() + LXP_US_TO_TICKS(1000ull*tiInMs));
+
+} /* End of delay */
+
+
+
+/**
+ * System time elapsed since startup in Milliseconds.\n
+ *   Note, this function emulates an Arduino standard function. This explains, why the name
+ * doesn't comply with our normal naming pattern.
+ *   @return
+ * Get the time elapsed since startup in Milliseconds.
+ *   @remark
+ * The 32 Bit result wraps around after 49d 17h 2min 47s.
+ */
+unsigned long millis(void)
+{
+    return (unsigned long)(uint32_t)(ihw_getTimeBase() / 120000ull);
+
+} /* End of millis */
+
+
+
+/**
+ * System time elapsed since startup in Microseconds.
+ *   @return
+ * Get the time elapsed since startup in Microseconds.
+ *   @remark
+ * The 32 Bit result wraps around after 1h 11min 35s.
+ */
+unsigned long micros(void)
+{
+    return (unsigned long)(uint32_t)(ihw_getTimeBase() / 120ull);
+
+} /* End of micros */
+
+
+
+/**
+ * Trivial routine that flashes the LED a number of times to give simple feedback. The
+ * routine is blocking. The timing doesn't depend on the system load, it is coupled to a real
+ * time clock.
+ *   @param noFlashes
+ * The number of times the LED is lit.
+ */
+void mai_blink(unsigned int noFlashes)
+{
+#define TI_FLASH_MS 200
+
+    while(noFlashes-- > 0)
+    {
+        lbd_setLED(lbd_led_D4_red, /* isOn */ true); /* Turn the LED on. */
+        delay(/* tiInMs */ TI_FLASH_MS);
+        lbd_setLED(lbd_led_D4_red, /* isOn */ false); /* Turn the LED off. */
+        delay(/* tiInMs */ TI_FLASH_MS);
+    }
+
+    /* Wait for a second after the last flash - this command could easily be invoked
+       immediately again and the bursts need to be separated. */
+    delay(/* tiInMs */ (1000-TI_FLASH_MS));
+
+#undef TI_FLASH_MS
+} /* End mai_blink */
+
+
+
+/**
+ * Entry point into the simulation. The only, optional command line argument is the
+ * duration of the simulation in seconds of simulated time.
+ *   @return
+ * The function doesn't return. The process is terminated by the simulation.
+ *   @param argc
+ * The number of command line arguments.
+ *   @param argv
+ * The command line arguments.
+ */
+int main(int argc, char *argv[])
+{
+    double tiSimulation = TI_DEFAULT_SIMULATION;
+    if(argc > 2  ||  (argc == 2  &&  (tiSimulation = atof(argv[1])) <= 0.0))
+    {
+        fprintf(stderr, "usage: %s [durationOfSimulationInS]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* The output of the application is line oriented. It's written line by line to be
+       visible in time if the simulation runs slowly. */
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    /* Initialize the simulation of the MCU. */
+    lxp_initLinuxPort((lxp_time_t)(tiSimulation * LXP_TICKS_PER_SECOND));
+
+    /* Init core HW of MCU so that it can be safely operated. */
+    ihw_initMcuCoreHW();
+
+    /* Initialize the button and LED driver for the eval board. */
+    lbd_initLEDAndButtonDriver();
+
+    /* The external interrupts are enabled after configuring I/O devices and registering
+       the interrupt handlers. */
+    ihw_resumeAllInterrupts();
+
+    /* The next function will never return. */
+    rtos_initRTOS();
+
+    /* This code is never reached. */
+    assert(false);
+    return EXIT_FAILURE;
+
+} /* End of main */
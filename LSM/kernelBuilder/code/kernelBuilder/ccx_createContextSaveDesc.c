@@ -250,6 +250,12 @@ void ccx_createContextSaveDesc( int_contextSaveDesc_t *pContextSaveDesc
        on-the-fly start becomes an option if we set this field nonetheless. */
     pContextSaveDesc->privilegedMode = privilegedMode;
     
+#if INT_USE_LAZY_SPE_SAVE == 1
+    /* By default, the new context doesn't use the SPE. The scheduler can set a save area
+       for the SPE registers before the context is activated the first time. */
+    pContextSaveDesc->pSpeContextSaveArea = NULL;
+#endif
+
 } /* End of ccx_createContextSaveDesc */
 
 
@@ -344,6 +350,11 @@ void ccx_createContextSaveDescOnTheFly
 #endif
     pNewContextSaveDesc->idxSysCall = -1;
 
+#if INT_USE_LAZY_SPE_SAVE == 1
+    /* By default, the new context doesn't use the SPE. */
+    pNewContextSaveDesc->pSpeContextSaveArea = NULL;
+#endif
+
 } /* End of ccx_createContextSaveDescOnTheFly */
 
 
@@ -409,5 +420,10 @@ void ccx_createContextSaveDescShareStack
     pNewContextSaveDesc->pStackOnEntry = NULL;
     pNewContextSaveDesc->idxSysCall = 0;
 
+#if INT_USE_LAZY_SPE_SAVE == 1
+    /* By default, the new context doesn't use the SPE. */
+    pNewContextSaveDesc->pSpeContextSaveArea = NULL;
+#endif
+
 } /* End of ccx_createContextSaveDescShareStack */
 #endif
\ No newline at end of file
@@ -0,0 +1,200 @@
+#ifndef COR_COROUTINE_INCLUDED
+#define COR_COROUTINE_INCLUDED
+/**
+ * @file cor_coroutine.h
+ * Definition of global interface of module cor_coroutine.c\n
+ *   Note, coroutines must not use the SIMD instructions of the SPE. Under the SPE EABI,
+ * the upper halves of the 64 Bit GPRs r14..r31 are non-volatile but a coroutine switch
+ * saves and restores the lower halves only. The upper halves are shared by all coroutines
+ * and the resuming context; whatever a coroutine writes into them is seen and overwritten
+ * by the others.
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*
+ * Defines
+ */
+
+/** The minimum size in Byte of the stack area of a coroutine. The stack needs to hold the
+    stack frame of the coroutine switch and the stack consumption of the coroutine
+    function. Moreover, each External Interrupt, which preempts the coroutine, places its
+    stack frame on the stack of the coroutine, see ccx_createContextSaveDesc() for
+    details. The value here is a technical lower bound only; real applications will
+    require much more. */
+#define COR_MIN_STACK_SIZE      256u
+
+
+/*
+ * Global type definitions
+ */
+
+/** The type of a coroutine function. The function is entered on the first call of
+    cor_resume() and the argument of that call is passed in. On return, the coroutine
+    terminates and the returned value is passed to the resuming context as result of
+    its call of cor_resume(). */
+typedef uint32_t (*cor_fctCoroutine_t)(uint32_t argOnStart);
+
+/** The states of a coroutine. */
+typedef enum cor_stateCoroutine_t
+{
+    /** Created by cor_createCoroutine() but not yet started by cor_resume(). */
+    cor_stCo_created,
+
+    /** Started and currently suspended by cor_yield() or cor_awaitEvent(). */
+    cor_stCo_suspended,
+
+    /** Resumed and not yet suspended again. */
+    cor_stCo_running,
+
+    /** The coroutine function has returned. */
+    cor_stCo_terminated,
+
+} cor_stateCoroutine_t;
+
+/** The management data of a coroutine. The client code will allocate an object of this
+    type for each of its coroutines; it is initialized by cor_createCoroutine(). All
+    fields are private to the implementation in cor_coroutine.c. */
+typedef struct cor_coroutine_t
+{
+    /** The saved stack pointer of the suspended coroutine. All other elements of the
+        context of the coroutine are found in the stack frame this pointer points to. */
+    void *sp;
+
+    /** The saved stack pointer of the context, which has resumed the coroutine. Used to
+        return to that context on yield or termination of the coroutine. */
+    void *spResumer;
+
+    /** The coroutine function. */
+    cor_fctCoroutine_t fct;
+
+    /** The argument of the very first call of cor_resume(), which is passed to the
+        coroutine function. */
+    uint32_t argOnStart;
+
+    /** The current state of the coroutine. */
+    cor_stateCoroutine_t state;
+
+    /** The set of events, which have been posted to the coroutine but which have not been
+        consumed yet by cor_awaitEvent(). */
+    uint32_t postedEventVec;
+
+    /** The set of events, the coroutine is currently waiting for in cor_awaitEvent(). Zero
+        if the coroutine is not waiting. */
+    uint32_t awaitedEventMask;
+
+} cor_coroutine_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global static inline functions
+ */
+
+/**
+ * Query if a coroutine has terminated, i.e. if its coroutine function has returned. A
+ * terminated coroutine must not be resumed again but it may be re-initialized with
+ * cor_createCoroutine().
+ *   @return
+ * Get \a true if the coroutine has terminated.
+ *   @param pCo
+ * The coroutine by reference.
+ */
+static inline bool cor_isTerminated(const cor_coroutine_t *pCo)
+{
+    return pCo->state == cor_stCo_terminated;
+
+} /* End of cor_isTerminated */
+
+
+
+/**
+ * Query if a coroutine is ready to be resumed. It is ready if it has not terminated and
+ * if it doesn't wait for an event or if at least one of the awaited events has been
+ * posted.
+ *   @return
+ * Get \a true if the coroutine is ready.
+ *   @param pCo
+ * The coroutine by reference.
+ */
+static inline bool cor_isReady(const cor_coroutine_t *pCo)
+{
+    return pCo->state != cor_stCo_terminated
+           &&  (pCo->awaitedEventMask == 0
+                ||  (pCo->postedEventVec & pCo->awaitedEventMask) != 0
+               );
+
+} /* End of cor_isReady */
+
+
+
+/**
+ * Post events to a coroutine. The events will be consumed by the coroutine in its call of
+ * cor_awaitEvent().\n
+ *   The function may be called from another coroutine or from the context, which runs the
+ * coroutines. It must not be called from other tasks or from an ISR; the operation is not
+ * atomic. All coroutines, which interact with one another, need to be run by one and the
+ * same task.
+ *   @param pCo
+ * The coroutine to post the events to.
+ *   @param eventVec
+ * The set of posted events. Each bit is one event. Events are counted as Boolean; an
+ * already posted but not yet consumed event is not posted a second time.
+ */
+static inline void cor_postEvent(cor_coroutine_t *pCo, uint32_t eventVec)
+{
+    pCo->postedEventVec |= eventVec;
+
+} /* End of cor_postEvent */
+
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize a coroutine object such that it can be started by cor_resume(). */
+void cor_createCoroutine( cor_coroutine_t *pCo
+                        , cor_fctCoroutine_t fctCoroutine
+                        , void *pStackArea
+                        , unsigned int sizeOfStackArea
+                        );
+
+/** Start or continue a coroutine. */
+uint32_t cor_resume(cor_coroutine_t *pCo, uint32_t arg);
+
+/** Suspend the calling coroutine and return to the context, which has resumed it. */
+uint32_t cor_yield(cor_coroutine_t *pCo, uint32_t value);
+
+/** Suspend the calling coroutine until one out of a set of events has been posted. */
+uint32_t cor_awaitEvent(cor_coroutine_t *pCo, uint32_t eventMask);
+
+/** Round-robin scheduler: Resume all ready coroutines of a set once. */
+unsigned int cor_runFibers(cor_coroutine_t * const pCoAry[], unsigned int noCoroutines);
+
+#endif  /* COR_COROUTINE_INCLUDED */
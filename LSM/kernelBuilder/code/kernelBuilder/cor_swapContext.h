@@ -0,0 +1,81 @@
+#ifndef COR_SWAPCONTEXT_INCLUDED
+#define COR_SWAPCONTEXT_INCLUDED
+/**
+ * @file cor_swapContext.h
+ * Definition of global interface of module cor_swapContext.S.\n
+ *   Note, this file is shared between C and assembly code. Therefore, the contained C
+ * elements are put into preprocessor conditions so that they are read by a C compilation
+ * process only.
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#if defined(__STDC_VERSION__)
+# include <stdint.h>
+# include <stdbool.h>
+#endif
+
+
+/*
+ * Defines
+ */
+
+/* The software is written as portable as reasonably possible. This requires the awareness
+   of the C language standard it is compiled with. */
+#if defined(__STDC_VERSION__)
+# if (__STDC_VERSION__)/100 == 2011
+#  define _STDC_VERSION_C11
+# elif (__STDC_VERSION__)/100 == 1999
+#  define _STDC_VERSION_C99
+# endif
+#endif
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+#ifdef __STDC_VERSION__
+/**
+ * Prototype of assembler function, which suspends the calling coroutine and continues
+ * another one by exchanging the stack pointer and the non-volatile registers.
+ *   @return
+ * The value passed in by the coroutine, which later continues the calling one.
+ *   @param ppStackSave
+ * The stack pointer of the calling coroutine is saved in * \a ppStackSave.
+ *   @param pStackResume
+ * The saved stack pointer of the continued coroutine.
+ *   @param value
+ * The value, which is returned by cor_swapContext() in the continued coroutine.
+ */
+uint32_t cor_swapContext(void **ppStackSave, void *pStackResume, uint32_t value);
+#endif
+
+#endif  /* COR_SWAPCONTEXT_INCLUDED */
@@ -52,13 +52,28 @@
     these compile time tests.\n
       @todo You need to put an instance of this macro somewhere in your compiled C code. It
     is a pure compile time test and does not consume any CPU time. */
+#if INT_USE_LAZY_SPE_SAVE == 1
+/* The context save descriptor is extended by the reference to the SPE save area. */
+# define INT_C2AS_SIZE_OF_CONTEXT_SAVE_DESC(size)                                           \
+    (sizeof(int_contextSaveDesc_t) == (size)+4                                              \
+     &&  offsetof(int_contextSaveDesc_t, pSpeContextSaveArea) == (size)                     \
+     &&  sizeof(((int_contextSaveDesc_t*)NULL)->pSpeContextSaveArea) == sizeof(uint32_t)    \
+     &&  sizeof(int_speContextSaveArea_t) == 272                                            \
+     &&  _Alignof(int_speContextSaveArea_t) == 8                                            \
+     &&  offsetof(int_speContextSaveArea_t, gprAry) == 0                                    \
+     &&  offsetof(int_speContextSaveArea_t, acc) == 256                                     \
+     &&  offsetof(int_speContextSaveArea_t, spefscr) == 264                                 \
+    )
+#else
+# define INT_C2AS_SIZE_OF_CONTEXT_SAVE_DESC(size) (sizeof(int_contextSaveDesc_t) == (size))
+#endif
 #if INT_USE_SHARED_STACKS == 1
 #define INT_STATIC_ASSERT_INTERFACE_CONSISTENCY_C2AS                                        \
     _Static_assert( sizeof(int_cmdContextSwitch_t) == 12                                    \
                     &&  offsetof(int_cmdContextSwitch_t, signalToResumedContext) == 0       \
                     &&  offsetof(int_cmdContextSwitch_t, pSuspendedContextSaveDesc) == 4    \
                     &&  offsetof(int_cmdContextSwitch_t, pResumedContextSaveDesc) == 8      \
-                    &&  sizeof(int_contextSaveDesc_t) == 24                                 \
+                    &&  INT_C2AS_SIZE_OF_CONTEXT_SAVE_DESC(24)                              \
                     &&  offsetof(int_contextSaveDesc_t, idxSysCall) == 0                    \
                     &&  sizeof(((int_contextSaveDesc_t*)NULL)->idxSysCall)                  \
                         == sizeof(uint32_t)                                                 \
@@ -83,7 +98,7 @@
                     &&  offsetof(int_cmdContextSwitch_t, signalToResumedContext) == 0       \
                     &&  offsetof(int_cmdContextSwitch_t, pSuspendedContextSaveDesc) == 4    \
                     &&  offsetof(int_cmdContextSwitch_t, pResumedContextSaveDesc) == 8      \
-                    &&  sizeof(int_contextSaveDesc_t) == 16                                 \
+                    &&  INT_C2AS_SIZE_OF_CONTEXT_SAVE_DESC(16)                              \
                     &&  offsetof(int_contextSaveDesc_t, idxSysCall) == 0                    \
                     &&  sizeof(((int_contextSaveDesc_t*)NULL)->idxSysCall)                  \
                         == sizeof(uint32_t)                                                 \
@@ -170,6 +185,28 @@ typedef enum int_retCodeKernelIsr_t
 } int_retCodeKernelIsr_t;
 
 
+#if INT_USE_LAZY_SPE_SAVE == 1
+/** A context, which makes use of the SPE, needs a save area for the SPE registers. The
+    area is written when another context starts using the SPE and it is read when the
+    context itself uses the SPE again after having been suspended.
+      @remark The assembler doesn't know or use this typedef. The binary build-up is
+    double-checked by the static assertion #INT_STATIC_ASSERT_INTERFACE_CONSISTENCY_C2AS. */
+typedef struct int_speContextSaveArea_t
+{
+    /** The 64 Bit GPRs r0..r31. Only the upper halves matter; the lower halves are
+        saved and restored by the normal context switch. */
+    uint64_t gprAry[32];
+
+    /** The 64 Bit accumulator of the SPE. */
+    uint64_t acc;
+
+    /** The SPE/floating point status and control register SPEFSCR. */
+    uint32_t spefscr;
+
+} __attribute__((aligned(8))) int_speContextSaveArea_t;
+#endif
+
+
 /** The assembly code to switch a CPU execution context interfaces with the C code that
     implements an actual scheduler with this data structure. It contains the information
     about a suspended context, which is written on suspend and read on later resume of the
@@ -229,6 +266,17 @@ typedef struct int_contextSaveDesc_t
         mode. */
     bool privilegedMode;
 
+#if INT_USE_LAZY_SPE_SAVE == 1
+    /** A context, which uses the SIMD instructions of the SPE, needs to have a save area
+        for the SPE registers. All other contexts must have NULL. If such a context would
+        nonetheless use an SIMD instruction then it'd be caught in an error trap.\n
+          This field is initialized to NULL at context creation. The scheduler code may set
+        it after creation of the context and prior to its first activation. The referenced
+        object needs to stay valid as long as the context exists; static allocation is
+        recommended. */
+    int_speContextSaveArea_t *pSpeContextSaveArea;
+#endif
+
 } int_contextSaveDesc_t;
 
 
@@ -370,6 +418,17 @@ extern const SECTION(.rodata.ivor) int_simpleSystemCallFct_t int_simpleSystemCal
 extern const uint32_t int_noSimpleSystemCalls;
 #endif
 
+#if INT_USE_LAZY_SPE_SAVE == 1
+/** The SPE register save area of the currently running context or NULL if this context
+    doesn't have one. The variable is maintained by the assembly code on context switch. */
+extern int_speContextSaveArea_t * volatile int_pActiveSpeContextSaveArea;
+
+/** The SPE register save area of the context, whose contents is currently held in the SPE
+    registers, or NULL if the SPE had not been used yet. The variable is maintained by the
+    assembly code in the SPE unavailable exception handler. */
+extern int_speContextSaveArea_t * volatile int_pSpeOwnerContextSaveArea;
+#endif
+
 
 /*
  * Global static inline functions
@@ -0,0 +1,431 @@
+/**
+ * @file crs_coroutineSample.c
+ * This kernelBuilder sample demonstrates the stackful coroutines of module
+ * cor_coroutine.c. The coroutines are run by a user mode context, which is resumed by the
+ * idle context (the startup context) with a system call. In each of its cycles, the user
+ * context runs two tests and then hands back control with the same system call:\n
+ *   A generator is a coroutine, which is directly resumed with cor_resume(). It yields the
+ * squares of 1, 2, 3, ... and the resuming code acknowledges each value with its index,
+ * which the generator receives as return value of cor_yield(). Eventually, the generator
+ * returns the sum of all acknowledgements.\n
+ *   Two fibers, a producer and a consumer, are scheduled by cor_runFibers(). They wait for
+ * events in cor_awaitEvent(): The producer waits for a tick event, which is posted by the
+ * user context, and then produces a data item and posts a data event to the consumer. The
+ * consumer double-checks the sequence of items. With the last item, the producer posts an
+ * end event, too, and both fibers terminate.\n
+ *   All yielded, resumed and returned values and the numbers of resumed fibers are
+ * compared with their expected values. The idle context regularly reports the number of
+ * test cycles and failures. (Serial port at 115200 Bd, 8 Bit, 1 Start, 1 Stop bit)
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   crs_runCoroutines
+ * Local functions
+ *   sc_switchContext
+ *   checkValue
+ *   generator
+ *   testGenerator
+ *   producer
+ *   consumer
+ *   testFibers
+ *   userContext
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+
+#include "typ_types.h"
+#include "ihw_initMcuCoreHW.h"
+#include "int_interruptHandler.h"
+#include "sc_systemCalls.h"
+#include "sio_sysCallInterface.h"
+#include "ccx_createContextSaveDesc.h"
+#include "cor_coroutine.h"
+#include "crs_coroutineSample.h"
+
+
+/*
+ * Defines
+ */
+
+/* System call index: Switch between idle and user context. (Kernel relevant handlers use
+   the negative index range.) */
+#define IDX_SYS_CALL_SWITCH_CONTEXT     (-1)
+
+/** The index of the idle context in the array of context save descriptors. */
+#define IDX_CTXT_IDLE                   0u
+
+/** The index of the user context, which runs the coroutines, in the array of context
+    save descriptors. */
+#define IDX_CTXT_USER                   1u
+
+/** The number of contexts. */
+#define NO_CONTEXTS                     2u
+
+/** The stack size of the user context in Byte. */
+#define STACK_SIZE_CTXT_IN_BYTE         1024u
+
+/** The stack size of each coroutine in Byte. */
+#define STACK_SIZE_CO_IN_BYTE           512u
+
+/** The number of values yielded by the generator. */
+#define NO_GENERATED_VALUES             10u
+
+/** The number of data items produced by the producer fiber. */
+#define NO_PRODUCED_ITEMS               5u
+
+/** The event, which makes the producer produce the next item. */
+#define EVT_TICK                        0x1u
+
+/** The event, which notifies the consumer of a new item. */
+#define EVT_DATA                        0x2u
+
+/** The event, which notifies the consumer of the end of the data stream. */
+#define EVT_END                         0x4u
+
+/** The number of test cycles between two reports of the idle context. */
+#define NO_CYCLES_PER_REPORT            10000u
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+static uint32_t sc_switchContext(int_cmdContextSwitch_t *pCmdContextSwitch);
+
+
+/*
+ * Data definitions
+ */
+
+/** The context save descriptors of idle and user context. */
+static int_contextSaveDesc_t _contextSaveDescAry[NO_CONTEXTS];
+
+/** The index of the currently running context. */
+static unsigned int _idxActiveCtxt = IDX_CTXT_IDLE;
+
+/** The stack of the user context. The idle context uses the startup stack. */
+static _Alignas(uint64_t) uint8_t _stackUserCtxt[STACK_SIZE_CTXT_IN_BYTE];
+
+/** The coroutine objects. */
+static cor_coroutine_t _coGenerator
+                     , _coProducer
+                     , _coConsumer;
+
+/** The stacks of the coroutines. */
+static _Alignas(uint64_t) uint8_t _stackGenerator[STACK_SIZE_CO_IN_BYTE]
+                                , _stackProducer[STACK_SIZE_CO_IN_BYTE]
+                                , _stackConsumer[STACK_SIZE_CO_IN_BYTE];
+
+/** The set of fibers, which are scheduled by cor_runFibers(). */
+static cor_coroutine_t * const _fiberAry[] = {&_coProducer, &_coConsumer};
+
+/** The data item, which is passed from producer to consumer. */
+static uint32_t _dataItem = 0;
+
+/** The number of items received by the consumer. */
+static unsigned int _noReceivedItems = 0;
+
+/** The number of completed test cycles. Written by the user context, read by the idle
+    context. */
+static volatile unsigned long _cntTestCycles = 0;
+
+/** The number of failed checks. Written by the user context, read by the idle context. */
+static volatile unsigned long _cntErrors = 0;
+
+/** The table of C functions, which implement the kernel relevant system calls. */
+const SECTION(.rodata.ivor) int_systemCallFct_t int_systemCallHandlerAry[] =
+    { [~IDX_SYS_CALL_SWITCH_CONTEXT] = (int_systemCallFct_t)sc_switchContext,
+    };
+
+/** The table of C functions, which implement the simple system calls. */
+const SECTION(.rodata.ivor) int_simpleSystemCallFct_t int_simpleSystemCallHandlerAry[] =
+    { SIO_SIMPLE_SYSTEM_CALLS_TABLE_ENTRIES /* System calls for serial and printf */
+    };
+
+#ifdef DEBUG
+/* The number of entries in the tables of system calls. Only required for boundary
+   check in DEBUG compilation. */
+const uint32_t int_noSystemCalls = sizeOfAry(int_systemCallHandlerAry);
+const uint32_t int_noSimpleSystemCalls = sizeOfAry(int_simpleSystemCallHandlerAry);
+#endif
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * The implementation of our system call to switch from the idle context to the user
+ * context and vice versa.
+ *   @return
+ * Get \a int_rcIsr_switchContext; the system call always switches the context.
+ *   @param pCmdContextSwitch
+ * The context switch command, which is filled by the function.
+ */
+static uint32_t sc_switchContext(int_cmdContextSwitch_t *pCmdContextSwitch)
+{
+    /* No race conditions inside system call: We can use ordinary variables to maintain
+       our state. */
+    const unsigned int idxNextCtxt = _idxActiveCtxt == IDX_CTXT_IDLE? IDX_CTXT_USER
+                                                                     : IDX_CTXT_IDLE;
+    pCmdContextSwitch->pSuspendedContextSaveDesc = &_contextSaveDescAry[_idxActiveCtxt];
+    pCmdContextSwitch->pResumedContextSaveDesc = &_contextSaveDescAry[idxNextCtxt];
+    pCmdContextSwitch->signalToResumedContext = 0;
+    _idxActiveCtxt = idxNextCtxt;
+
+    return int_rcIsr_switchContext;
+
+} /* End of sc_switchContext */
+
+
+
+/**
+ * Compare a value with its expectation and count a failure if they differ.
+ *   @param value
+ * The value to check.
+ *   @param expectedValue
+ * The expected value.
+ */
+static inline void checkValue(uint32_t value, uint32_t expectedValue)
+{
+    if(value != expectedValue)
+        ++ _cntErrors;
+
+} /* End of checkValue */
+
+
+
+/**
+ * The generator coroutine. It yields the squares of 1, 2, 3, ...
+ *   @return
+ * Get the sum of all acknowledgements, which are received from the resuming context.
+ *   @param noValues
+ * The number of values to yield. The argument of the first call of cor_resume().
+ */
+static uint32_t generator(uint32_t noValues)
+{
+    uint32_t sum = 0
+           , n;
+    for(n=1; n<=noValues; ++n)
+    {
+        /* The resumer acknowledges each value with its index. */
+        const uint32_t ack = cor_yield(&_coGenerator, /* value */ n*n);
+        checkValue(ack, n);
+        sum += ack;
+    }
+
+    return sum;
+
+} /* End of generator */
+
+
+
+/**
+ * Run the generator from creation till termination and check all values.
+ */
+static void testGenerator(void)
+{
+    cor_createCoroutine( &_coGenerator
+                       , /* fctCoroutine */ generator
+                       , /* pStackArea */ &_stackGenerator[0]
+                       , /* sizeOfStackArea */ sizeof(_stackGenerator)
+                       );
+
+    /* The first resume passes the argument of the coroutine function. */
+    uint32_t value = cor_resume(&_coGenerator, /* arg */ NO_GENERATED_VALUES)
+           , n;
+    for(n=1; n<=NO_GENERATED_VALUES; ++n)
+    {
+        checkValue(value, n*n);
+        checkValue(cor_isTerminated(&_coGenerator), false);
+
+        /* Acknowledge the value. After the last value, the generator returns. */
+        value = cor_resume(&_coGenerator, /* arg */ n);
+    }
+
+    checkValue(cor_isTerminated(&_coGenerator), true);
+    checkValue(value, NO_GENERATED_VALUES*(NO_GENERATED_VALUES+1)/2);
+
+} /* End of testGenerator */
+
+
+
+/**
+ * The producer fiber. It produces a data item on each tick event.
+ *   @return
+ * Get the number of produced items.
+ *   @param arg
+ * Unused. cor_runFibers() starts the fibers with argument zero.
+ */
+static uint32_t producer(uint32_t arg ATTRIB_DBG_ONLY)
+{
+    assert(arg == 0);
+
+    uint32_t n;
+    for(n=1; n<=NO_PRODUCED_ITEMS; ++n)
+    {
+        checkValue(cor_awaitEvent(&_coProducer, /* eventMask */ EVT_TICK), EVT_TICK);
+
+        /* The consumer has consumed the previous item; it runs in the same round of
+           cor_runFibers() as the producer. */
+        _dataItem = 1000u + n;
+        cor_postEvent(&_coConsumer, n < NO_PRODUCED_ITEMS? EVT_DATA: EVT_DATA+EVT_END);
+    }
+
+    return n-1;
+
+} /* End of producer */
+
+
+
+/**
+ * The consumer fiber. It checks the data items of the producer.
+ *   @return
+ * Get the number of received items.
+ *   @param arg
+ * Unused. cor_runFibers() starts the fibers with argument zero.
+ */
+static uint32_t consumer(uint32_t arg ATTRIB_DBG_ONLY)
+{
+    assert(arg == 0);
+
+    uint32_t eventVec;
+    do
+    {
+        /* Data and end event may be received together, the data needs to be consumed
+           first. */
+        eventVec = cor_awaitEvent(&_coConsumer, /* eventMask */ EVT_DATA+EVT_END);
+        checkValue((eventVec & EVT_DATA) != 0, true);
+        ++ _noReceivedItems;
+        checkValue(_dataItem, 1000u + _noReceivedItems);
+    }
+    while((eventVec & EVT_END) == 0);
+
+    return _noReceivedItems;
+
+} /* End of consumer */
+
+
+
+/**
+ * Run the fibers from creation till termination and check the number of resumed fibers
+ * in each round.
+ */
+static void testFibers(void)
+{
+    cor_createCoroutine( &_coProducer
+                       , /* fctCoroutine */ producer
+                       , /* pStackArea */ &_stackProducer[0]
+                       , /* sizeOfStackArea */ sizeof(_stackProducer)
+                       );
+    cor_createCoroutine( &_coConsumer
+                       , /* fctCoroutine */ consumer
+                       , /* pStackArea */ &_stackConsumer[0]
+                       , /* sizeOfStackArea */ sizeof(_stackConsumer)
+                       );
+    _dataItem = 0;
+    _noReceivedItems = 0;
+
+    /* The first round starts both fibers, which then wait for their events. */
+    checkValue(cor_runFibers(_fiberAry, sizeOfAry(_fiberAry)), 2);
+
+    unsigned int n;
+    for(n=1; n<=NO_PRODUCED_ITEMS; ++n)
+    {
+        /* No fiber is ready without an event. */
+        checkValue(cor_runFibers(_fiberAry, sizeOfAry(_fiberAry)), 0);
+
+        /* The tick makes the producer ready, which makes the consumer ready. Both
+           terminate after the last item. */
+        cor_postEvent(&_coProducer, EVT_TICK);
+        checkValue(cor_runFibers(_fiberAry, sizeOfAry(_fiberAry)), 2);
+        checkValue(_noReceivedItems, n);
+    }
+
+    checkValue(cor_isTerminated(&_coProducer) && cor_isTerminated(&_coConsumer), true);
+    checkValue(cor_runFibers(_fiberAry, sizeOfAry(_fiberAry)), 0);
+
+} /* End of testFibers */
+
+
+
+/**
+ * The entry function of the user context. It runs the tests forever.
+ *   @param signal
+ * Unused. The signal of the system call, which resumes the context the very first time.
+ */
+static _Noreturn uint32_t userContext(uint32_t signal ATTRIB_UNUSED)
+{
+    while(true)
+    {
+        testGenerator();
+        testFibers();
+        ++ _cntTestCycles;
+
+        /* Hand back to the idle context. */
+        int_systemCall(IDX_SYS_CALL_SWITCH_CONTEXT);
+    }
+} /* End of userContext */
+
+
+
+/**
+ * Main entry point into the coroutine sample. The startup context becomes the idle
+ * context. It creates the user context, which runs the coroutines, and resumes it again
+ * and again.
+ */
+void _Noreturn crs_runCoroutines(void)
+{
+    ccx_createContextSaveDescOnTheFly( &_contextSaveDescAry[IDX_CTXT_IDLE]
+                                     , /* stackPointer */ NULL
+                                     , /* fctEntryIntoOnTheFlyStartedContext */ NULL
+                                     , /* privilegedMode */ true
+                                     );
+    ccx_createContextSaveDesc( &_contextSaveDescAry[IDX_CTXT_USER]
+                             , /* stackPointer */ &_stackUserCtxt[0] + sizeof(_stackUserCtxt)
+                             , /* fctEntryIntoContext */ userContext
+                             , /* privilegedMode */ false
+                             );
+
+    while(true)
+    {
+        /* Let the user context run one test cycle. */
+        int_systemCall(IDX_SYS_CALL_SWITCH_CONTEXT);
+
+        if(_cntTestCycles % NO_CYCLES_PER_REPORT == 0)
+        {
+            printf( "%s: %lu test cycles, %lu failures\r\n"
+                  , __func__
+                  , _cntTestCycles
+                  , _cntErrors
+                  );
+        }
+    }
+} /* End of crs_runCoroutines */
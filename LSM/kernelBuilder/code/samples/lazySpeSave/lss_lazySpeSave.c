@@ -0,0 +1,417 @@
+/**
+ * @file lss_lazySpeSave.c
+ * This kernelBuilder sample demonstrates the lazy save of the SPE registers, see
+ * configuration setting #INT_USE_LAZY_SPE_SAVE. There are three execution contexts: The
+ * idle context, which inherits the startup context and which doesn't use the SPE, and two
+ * contexts A and B, which use the SIMD instructions. Only A and B have a save area for
+ * the SPE registers.\n
+ *   A kernel interrupt switches between the contexts every 100us in a fixed order, A, idle,
+ * A, B, idle, B. Moreover, A and B hand over to the next context in this order by system
+ * call after each test cycle. If the idle context interrupts A or B then the SPE
+ * registers need not be exchanged; the resumed SIMD context still owns them. If B
+ * follows A or vice versa then the SPE unavailable exception swaps the SPE registers.\n
+ *   In each test cycle, the SIMD contexts write a context and cycle specific test pattern
+ * into the upper halves of r14..r31 and into the accumulator. Then they busy-wait for a
+ * while, during which they are suspended and resumed several times, and eventually they
+ * double-check the pattern. The idle context regularly reports the number of test cycles
+ * and failures. (Serial port at 115200 Bd, 8 Bit, 1 Start, 1 Stop bit)
+ *
+ * Copyright (C) 2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   lss_scheduler
+ * Local functions
+ *   switchToNextContext
+ *   isrSwitchContext
+ *   sc_yield
+ *   enableIRQSwitchContext
+ *   setUpperHalves
+ *   checkUpperHalves
+ *   simdContext
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+
+#include "MPC5643L.h"
+
+#include "typ_types.h"
+#include "ihw_initMcuCoreHW.h"
+#include "int_interruptHandler.h"
+#include "sc_systemCalls.h"
+#include "sio_sysCallInterface.h"
+#include "ccx_createContextSaveDesc.h"
+#include "del_delay.h"
+#include "lss_lazySpeSave.h"
+
+
+/*
+ * Defines
+ */
+
+#if INT_USE_LAZY_SPE_SAVE != 1
+# error This sample requires the lazy save of the SPE registers
+#endif
+
+/* System call index: Hand over to the next context. (Kernel relevant handlers use the
+   negative index range.) */
+#define IDX_SYS_CALL_YIELD      (-1)
+
+/** The index of the idle context in the array of context save descriptors. */
+#define IDX_CTXT_IDLE           0u
+
+/** The index of SIMD context A in the array of context save descriptors. */
+#define IDX_CTXT_SIMD_A         1u
+
+/** The index of SIMD context B in the array of context save descriptors. */
+#define IDX_CTXT_SIMD_B         2u
+
+/** The number of contexts. */
+#define NO_CONTEXTS             3u
+
+/** The stack size of the SIMD contexts in Byte. */
+#define STACK_SIZE_IN_BYTE      1024u
+
+/** The time in us, which a SIMD context waits between writing and checking the test
+    pattern. It is a multiple of the period of the context switching interrupt. */
+#define TI_TEST_CYCLE_US        730u
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+static uint32_t sc_yield(int_cmdContextSwitch_t *pCmdContextSwitch);
+
+
+/*
+ * Data definitions
+ */
+
+/** The context save descriptors of all contexts. */
+static int_contextSaveDesc_t _contextSaveDescAry[NO_CONTEXTS];
+
+/** The save areas for the SPE registers of the two SIMD contexts. The idle context doesn't
+    use the SPE and has no save area. */
+static int_speContextSaveArea_t _speContextSaveAreaA, _speContextSaveAreaB;
+
+/** The stacks of the two SIMD contexts. The idle context uses the startup stack. */
+static _Alignas(uint64_t) uint8_t _stackSimdA[STACK_SIZE_IN_BYTE]
+                                , _stackSimdB[STACK_SIZE_IN_BYTE];
+
+/** The order, in which the contexts are run. The idle context interrupts both SIMD
+    contexts without exchanging the SPE registers. */
+static const unsigned int _scheduleAry[] =
+    { IDX_CTXT_SIMD_A
+    , IDX_CTXT_IDLE
+    , IDX_CTXT_SIMD_A
+    , IDX_CTXT_SIMD_B
+    , IDX_CTXT_IDLE
+    , IDX_CTXT_SIMD_B
+    };
+
+/** The index into \a _scheduleAry of the next context to run. */
+static unsigned int _idxSchedule = 0;
+
+/** The index of the currently running context. */
+static unsigned int _idxActiveCtxt = IDX_CTXT_IDLE;
+
+/** The number of completed test cycles per context. The entry of the idle context is
+    unused. */
+static volatile unsigned long _cntTestCyclesAry[NO_CONTEXTS] = {[0 ... NO_CONTEXTS-1] = 0};
+
+/** The number of test cycles per context, in which the test pattern got lost. */
+static volatile unsigned long _cntErrorsAry[NO_CONTEXTS] = {[0 ... NO_CONTEXTS-1] = 0};
+
+/** The table of C functions, which implement the kernel relevant system calls. */
+const SECTION(.rodata.ivor) int_systemCallFct_t int_systemCallHandlerAry[] =
+    { [~IDX_SYS_CALL_YIELD] = (int_systemCallFct_t)sc_yield,
+    };
+
+/** The table of C functions, which implement the simple system calls. */
+const SECTION(.rodata.ivor) int_simpleSystemCallFct_t int_simpleSystemCallHandlerAry[] =
+    { SIO_SIMPLE_SYSTEM_CALLS_TABLE_ENTRIES /* System calls for serial and printf */
+    };
+
+#ifdef DEBUG
+/* The number of entries in the tables of system calls. Only required for boundary
+   check in DEBUG compilation. */
+const uint32_t int_noSystemCalls = sizeOfAry(int_systemCallHandlerAry);
+const uint32_t int_noSimpleSystemCalls = sizeOfAry(int_simpleSystemCallHandlerAry);
+#endif
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * The scheduler: Command the switch from the running context to the next one in the
+ * order of \a _scheduleAry.
+ *   @return
+ * The return code of the kernel relevant ISR or system call; always
+ * \a int_rcIsr_switchContext.
+ *   @param pCmdContextSwitch
+ * The context switch command, which is filled by the function.
+ */
+static uint32_t switchToNextContext(int_cmdContextSwitch_t *pCmdContextSwitch)
+{
+    /* No race conditions inside scheduler: We can use ordinary variables to maintain
+       our state. */
+    const unsigned int idxNextCtxt = _scheduleAry[_idxSchedule];
+    if(++_idxSchedule >= sizeOfAry(_scheduleAry))
+        _idxSchedule = 0;
+    assert(idxNextCtxt != _idxActiveCtxt);
+
+    /* The signal is the argument of the context entry function if a SIMD context is
+       resumed the very first time. */
+    pCmdContextSwitch->pSuspendedContextSaveDesc = &_contextSaveDescAry[_idxActiveCtxt];
+    pCmdContextSwitch->pResumedContextSaveDesc = &_contextSaveDescAry[idxNextCtxt];
+    pCmdContextSwitch->signalToResumedContext = idxNextCtxt;
+    _idxActiveCtxt = idxNextCtxt;
+
+    return int_rcIsr_switchContext;
+
+} /* End of switchToNextContext */
+
+
+
+/**
+ * The kernel relevant interrupt, which preempts the running context every 100us in favor
+ * of the next one.
+ */
+static uint32_t isrSwitchContext(int_cmdContextSwitch_t *pCmdContextSwitch)
+{
+    /* Acknowledge the timer interrupt in the causing HW device. */
+    PIT.TFLG0.B.TIF = 0x1;
+
+    return switchToNextContext(pCmdContextSwitch);
+
+} /* End of isrSwitchContext */
+
+
+
+/**
+ * The implementation of our system call to voluntarily hand over to the next context.
+ */
+static uint32_t sc_yield(int_cmdContextSwitch_t *pCmdContextSwitch)
+{
+    return switchToNextContext(pCmdContextSwitch);
+
+} /* End of sc_yield */
+
+
+
+/**
+ * Start the interrupt, which switches the contexts.
+ */
+static void enableIRQSwitchContext(void)
+{
+    /* Disable all PIT timers during configuration. */
+    PIT.PITMCR.R = 0x2;
+
+    /* Install the interrupt handler for cyclic timer PIT 0. */
+    ihw_installINTCInterruptHandler
+                ( (int_externalInterruptHandler_t){.kernelIsr = &isrSwitchContext}
+                , /* vectorNum */ 59 /* Timer PIT 0 */
+                , /* psrPriority */ 1
+                , /* isPreemptable */ true
+                , /* isKernelInterrupt */ true
+                );
+
+    /* Peripheral clock has been initialized to 120 MHz. Set value for a 100us tick. */
+    PIT.LDVAL0.R = 12000-1;
+
+    /* Enable interrupts by this timer and start it. */
+    PIT.TCTRL0.R = 0x3;
+    PIT.PITMCR.R = 0x1;
+
+} /* End of enableIRQSwitchContext */
+
+
+
+/**
+ * Write a test pattern into the upper halves of the non-volatile GPRs r14..r31 and into
+ * the accumulator. Register r14 gets \a pattern, r15 gets \a pattern+1, and so on; the
+ * accumulator gets \a pattern+18 in both halves.\n
+ *   The lower halves of the GPRs are not touched; the compiler doesn't use the upper
+ * halves. The pattern persists until checkUpperHalves() unless the lazy save of the SPE
+ * registers fails.
+ *   @param pattern
+ * The test pattern.
+ *   @remark
+ * Only SPE and X-form integer instructions are used; the code is the same for Book E and
+ * VLE.
+ */
+static inline void setUpperHalves(uint32_t pattern)
+{
+#define SET_UPPER(r)                                                                        \
+            "evmergelo %%r" #r ", %[p], %%r" #r "\n\t"                                      \
+            "add       %[p], %[p], %[one]\n\t"
+
+    /* The operands are bound to volatile registers; the compiler must not choose one of the
+       registers under test. */
+    register uint32_t p asm("r9") = pattern;
+    register uint32_t one asm("r10") = 1u;
+    asm volatile ( /* AssemblerTemplate */
+                   SET_UPPER(14) SET_UPPER(15) SET_UPPER(16) SET_UPPER(17) SET_UPPER(18)
+                   SET_UPPER(19) SET_UPPER(20) SET_UPPER(21) SET_UPPER(22) SET_UPPER(23)
+                   SET_UPPER(24) SET_UPPER(25) SET_UPPER(26) SET_UPPER(27) SET_UPPER(28)
+                   SET_UPPER(29) SET_UPPER(30) SET_UPPER(31)
+                   "evmergelo %%r12, %[p], %[p]\n\t"
+                   "evmra     %%r12, %%r12\n\t"
+                 : /* OutputOperands */ [p] "+r" (p)
+                 : /* InputOperands */ [one] "r" (one)
+                 : /* Clobbers */ "r12"
+                 );
+#undef SET_UPPER
+} /* End of setUpperHalves */
+
+
+
+/**
+ * Double-check the test pattern, which has been written by setUpperHalves().
+ *   @return
+ * Get \a true if all registers still hold the pattern.
+ *   @param pattern
+ * The test pattern, which had been passed to setUpperHalves().
+ */
+static inline bool checkUpperHalves(uint32_t pattern)
+{
+#define CHECK_UPPER(r)                                                                      \
+            "evmergehi %%r12, %%r" #r ", %%r" #r "\n\t"                                     \
+            "xor       %%r12, %%r12, %[p]\n\t"                                              \
+            "or        %[err], %[err], %%r12\n\t"                                           \
+            "add       %[p], %[p], %[one]\n\t"
+
+    register uint32_t p asm("r9") = pattern;
+    register uint32_t one asm("r10") = 1u;
+    register uint32_t err asm("r8") = 0;
+    asm volatile ( /* AssemblerTemplate */
+                   CHECK_UPPER(14) CHECK_UPPER(15) CHECK_UPPER(16) CHECK_UPPER(17)
+                   CHECK_UPPER(18) CHECK_UPPER(19) CHECK_UPPER(20) CHECK_UPPER(21)
+                   CHECK_UPPER(22) CHECK_UPPER(23) CHECK_UPPER(24) CHECK_UPPER(25)
+                   CHECK_UPPER(26) CHECK_UPPER(27) CHECK_UPPER(28) CHECK_UPPER(29)
+                   CHECK_UPPER(30) CHECK_UPPER(31)
+                   "evxor     %%r12, %%r12, %%r12\n\t"
+                   "evmwumiaa %%r12, %%r12, %%r12\n\t"  /* Read ACC: r12 = ACC + 0*0 */
+                   "xor       %%r11, %%r12, %[p]\n\t"
+                   "or        %[err], %[err], %%r11\n\t"
+                   "evmergehi %%r12, %%r12, %%r12\n\t"
+                   "xor       %%r12, %%r12, %[p]\n\t"
+                   "or        %[err], %[err], %%r12\n\t"
+                 : /* OutputOperands */ [p] "+r" (p), [err] "+r" (err)
+                 : /* InputOperands */ [one] "r" (one)
+                 : /* Clobbers */ "r11", "r12"
+                 );
+#undef CHECK_UPPER
+
+    return err == 0;
+
+} /* End of checkUpperHalves */
+
+
+
+/**
+ * The common entry function of the two SIMD contexts. It runs the test cycles forever.
+ *   @param idxCtxt
+ * The index of the context. The value is passed in as signal on the very first resume of
+ * the context.
+ */
+static _Noreturn uint32_t simdContext(uint32_t idxCtxt)
+{
+    assert(idxCtxt == IDX_CTXT_SIMD_A  ||  idxCtxt == IDX_CTXT_SIMD_B);
+    while(true)
+    {
+        /* The pattern differs between the contexts and from cycle to cycle. */
+        const uint32_t pattern = (idxCtxt << 28) + (_cntTestCyclesAry[idxCtxt] << 8);
+        setUpperHalves(pattern);
+
+        /* The context is suspended several times while waiting. */
+        del_delayMicroseconds(/* tiCpuInUs */ TI_TEST_CYCLE_US);
+
+        if(!checkUpperHalves(pattern))
+            ++ _cntErrorsAry[idxCtxt];
+        ++ _cntTestCyclesAry[idxCtxt];
+
+        /* Hand over to the next context before its time slice begins. */
+        int_systemCall(IDX_SYS_CALL_YIELD);
+    }
+} /* End of simdContext */
+
+
+
+/**
+ * Main entry point into the scheduler. The startup context becomes the idle context. The
+ * two SIMD contexts are created with own stacks and with save areas for the SPE
+ * registers.
+ */
+void _Noreturn lss_scheduler(void)
+{
+    /* Create a context descriptor of the startup context (idle task). It doesn't use the
+       SPE and has no save area, which is the default. */
+    ccx_createContextSaveDescOnTheFly( &_contextSaveDescAry[IDX_CTXT_IDLE]
+                                     , /* stackPointer */ NULL
+                                     , /* fctEntryIntoOnTheFlyStartedContext */ NULL
+                                     , /* privilegedMode */ true
+                                     );
+
+    /* Create the two SIMD contexts. They get a save area for the SPE registers, which
+       needs to be done before they are resumed the first time. */
+    ccx_createContextSaveDesc( &_contextSaveDescAry[IDX_CTXT_SIMD_A]
+                             , /* stackPointer */ &_stackSimdA[0] + sizeof(_stackSimdA)
+                             , /* fctEntryIntoContext */ simdContext
+                             , /* privilegedMode */ false
+                             );
+    _contextSaveDescAry[IDX_CTXT_SIMD_A].pSpeContextSaveArea = &_speContextSaveAreaA;
+    ccx_createContextSaveDesc( &_contextSaveDescAry[IDX_CTXT_SIMD_B]
+                             , /* stackPointer */ &_stackSimdB[0] + sizeof(_stackSimdB)
+                             , /* fctEntryIntoContext */ simdContext
+                             , /* privilegedMode */ false
+                             );
+    _contextSaveDescAry[IDX_CTXT_SIMD_B].pSpeContextSaveArea = &_speContextSaveAreaB;
+
+    /* All contexts are ready for use, we can start the context switches. */
+    enableIRQSwitchContext();
+
+    /* We continue in the idle context. */
+    while(true)
+    {
+        volatile unsigned long u;
+        for(u=0; u<2500000; ++u)
+            ;
+        printf( "%s: Context A: %lu test cycles, %lu failures. Context B: %lu test cycles,"
+                " %lu failures\r\n"
+              , __func__
+              , _cntTestCyclesAry[IDX_CTXT_SIMD_A]
+              , _cntErrorsAry[IDX_CTXT_SIMD_A]
+              , _cntTestCyclesAry[IDX_CTXT_SIMD_B]
+              , _cntErrorsAry[IDX_CTXT_SIMD_B]
+              );
+    }
+} /* End of lss_scheduler */
@@ -0,0 +1,80 @@
+#ifndef SC_SYSTEMCALLS_INCLUDED
+#define SC_SYSTEMCALLS_INCLUDED
+/**
+ * @file sc_systemCalls.h
+ * Definition of global interface of module sc_systemCalls.c.\n
+ *   Definition of global enumeration \a sc_enum_simpleSystemCallIndex_t, which coordinates
+ * the indexes of all simple system calls from all I/O drivers.
+ *
+ * Copyright (C) 2018-2019 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "int_interruptHandler.h"
+#include "sio_sysCallInterface.tableEntries.h"
+
+
+/*
+ * Defines
+ */
+
+/* The software is written as portable as reasonably possible. This requires the awareness
+   of the C language standard it is compiled with. */
+#if defined(__STDC_VERSION__)
+# if (__STDC_VERSION__)/100 == 2011
+#  define _STDC_VERSION_C11
+# elif (__STDC_VERSION__)/100 == 1999
+#  define _STDC_VERSION_C99
+# endif
+#endif
+
+
+
+/*
+ * Global type definitions
+ */
+
+/** The enumeration of indexes of kernel unrelated, simple system calls.\n
+      Caution, this enumeration needs to be always in sync with table
+    int_simpleSystemCallHandlerAry of function pointers! */
+typedef enum sc_enum_simpleSystemCallIndex_t
+{
+    SIO_SIMPLE_SYSTEM_CALLS_ENUMERATION
+    
+    /** The number of kernel unrelated, simple system calls. */
+    SC_NO_SIMPLE_SYSTEM_CALLS
+
+} sc_enum_simpleSystemCallIndex_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+
+
+#endif  /* SC_SYSTEMCALLS_INCLUDED */
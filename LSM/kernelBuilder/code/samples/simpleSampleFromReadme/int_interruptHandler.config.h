@@ -47,6 +47,14 @@
     configurations, with or without stack sharing support. */
 #define INT_USE_SHARED_STACKS   1
 
+/** The registers of the SPE, i.e. the upper halves of the 64 Bit GPRs, the accumulator and
+    the status and control register SPEFSCR, can be supported for contexts, which make use
+    of the SIMD instructions. The SPE registers are saved and restored only on demand, in
+    the SPE unavailable exception (IVOR #32), when a context, which has a save area for the
+    SPE registers, uses a SIMD instruction the first time after it has been resumed.
+      Note, this sample doesn't make use of the SPE. */
+#define INT_USE_LAZY_SPE_SAVE   0
+
     
 /*
  * Global type definitions
@@ -16,7 +16,8 @@
  * Below it's explained why.\n
  *   The regular 1s task is used to report the system state, CPU load, stack usage and task
  * overrun events (more precise: failed activations).\n
- *   The idle task measures the CPU load.\n
+ *   The idle task measures the CPU load. It offers a small command shell on the serial
+ * interface, type help to get the list of commands.\n
  *   Three timer interrupts fire at high speed and on a time grid, which is asynchronous to
  * the normal application tasks. This leads to most variable preemption patterns. The
  * interrupts do nothing but producing system load and one of them participates the
@@ -82,6 +83,10 @@
  *   installInterruptServiceRoutines
  *   taskInitProcess
  *   taskIdlePID2
+ *   cmdBaud
+ *   cmdLoopback
+ *   cmdMem
+ *   cmdSerial
  */
 
 /*
@@ -103,6 +108,8 @@
 #include "ihw_initMcuCoreHW.h"
 #include "lbd_ledAndButtonDriver.h"
 #include "sio_serialIO.h"
+#include "csh_commandShell.h"
+#include "mem_memoryPool.h"
 #include "rtos.h"
 #include "del_delay.h"
 #include "gsl_systemLoad.h"
@@ -1063,6 +1070,138 @@ static int32_t taskIdlePID2(uint32_t PID, uint32_t taskParam)
 } /* taskIdlePID2 */
 
 
+
+/**
+ * Shell command "baud <rate> [<timeout>]": Change the Baud rate of the serial interface in
+ * agreement with the host. See sio_osNegotiateBaudRate() for the protocol.
+ *   @return
+ * Get \a true if the host confirmed the new Baud rate.
+ *   @param argC
+ * The number of arguments, 1 or 2.
+ *   @param argV
+ * The new Baud rate in Hz and optionally the timeout for the host's confirmation in ms.
+ */
+static bool cmdBaud(unsigned int argC, const csh_argValue_t argV[])
+{
+    const unsigned int tiTimeoutInMs = argC >= 2? (unsigned int)argV[1].u: 5000u;
+    return sio_osNegotiateBaudRate((unsigned int)argV[0].u, tiTimeoutInMs);
+
+} /* End of cmdBaud */
+
+
+
+/**
+ * Shell command "loopback [<rate>]": Run the loopback self-test of the serial interface.
+ *   @return
+ * Get \a true if the self-test succeeded.
+ *   @param argC
+ * The number of arguments, 0 or 1.
+ *   @param argV
+ * Optionally the Baud rate to test in Hz. The current rate is tested by default.
+ */
+static bool cmdLoopback(unsigned int argC, const csh_argValue_t argV[])
+{
+    const unsigned int baudRate = argC >= 1? (unsigned int)argV[0].u: sio_osGetBaudRate(NULL);
+    const bool success = sio_osRunLoopbackSelfTest(baudRate);
+
+    char msg[60];
+    const int noChars = sniprintf( msg, sizeof(msg)
+                                 , "Loopback test at %u Bd %s\r\n"
+                                 , baudRate
+                                 , success? "passed": "failed"
+                                 );
+    if(noChars > 0)
+        sio_osWriteSerialBlocking(msg, (unsigned int)noChars);
+    return success;
+
+} /* End of cmdLoopback */
+
+
+
+/**
+ * Shell command "mem": Print the usage statistics of the process memory arenas and of the
+ * heap of the C library.
+ *   @return
+ * Get \a true, the command can't fail.
+ *   @param argC
+ * The number of arguments, always 0.
+ *   @param argV
+ * The vector of arguments, not used.
+ */
+static bool cmdMem( unsigned int argC ATTRIB_UNUSED
+                  , const csh_argValue_t argV[] ATTRIB_UNUSED
+                  )
+{
+    extern unsigned long prf_sbrk_noBytesInUse, prf_sbrk_noFailedRequests;
+    char msg[100];
+    int noChars = sniprintf( msg, sizeof(msg)
+                           , "Heap of C library: %lu Byte in use, %lu failed requests\r\n"
+                           , prf_sbrk_noBytesInUse
+                           , prf_sbrk_noFailedRequests
+                           );
+    if(noChars > 0)
+        sio_osWriteSerialBlocking(msg, (unsigned int)noChars);
+
+    for(unsigned int PID=1; PID<=RTOS_NO_PROCESSES; ++PID)
+    {
+        const mem_arena_t * const pArena = mem_arenaByPIDAry[PID];
+        noChars = sniprintf( msg, sizeof(msg)
+                           , "Arena P%u: %u of %u Byte free, %lu allocations, %lu failed\r\n"
+                           , PID
+                           , (unsigned int)mem_getNoBytesFreeArena(pArena)
+                           , (unsigned int)(pArena->pEnd - pArena->pStart)
+                           , pArena->noAllocations
+                           , pArena->noFailedAllocations
+                           );
+        if(noChars > 0)
+            sio_osWriteSerialBlocking(msg, (unsigned int)noChars);
+    }
+    return true;
+
+} /* End of cmdMem */
+
+
+
+/**
+ * Shell command "serial": Print the state of the serial interface.
+ *   @return
+ * Get \a true, the command can't fail.
+ *   @param argC
+ * The number of arguments, always 0.
+ *   @param argV
+ * The vector of arguments, not used.
+ */
+static bool cmdSerial( unsigned int argC ATTRIB_UNUSED
+                     , const csh_argValue_t argV[] ATTRIB_UNUSED
+                     )
+{
+    signed int deviationInPpm;
+    const unsigned int baudRate = sio_osGetBaudRate(&deviationInPpm);
+    char msg[160];
+    const int noChars = sniprintf( msg, sizeof(msg)
+                                 , "Baud rate: %u Bd (%+i ppm)\r\n"
+                                   "Output: high water mark %lu Byte, %lu truncated messages,"
+                                   " %lu lost Byte\r\n"
+                                   "Input: %lu lost Byte\r\n"
+                                 , baudRate
+                                 , deviationInPpm
+                                 , sio_serialOutHighWaterMark
+                                 , sio_serialOutNoTruncatedMsgs
+                                 , sio_serialOutNoLostMsgBytes
+                                 , sio_serialInLostBytes
+                                 );
+    if(noChars > 0)
+    {
+        const unsigned int noBytes = (unsigned int)noChars < sizeof(msg)
+                                     ? (unsigned int)noChars
+                                     : sizeof(msg)-1u;
+        sio_osWriteSerialBlocking(msg, noBytes);
+    }
+    return true;
+
+} /* End of cmdSerial */
+
+
 /**
  * Entry point into C code. The C main function is entered without arguments and despite of
  * its return code definition it must never be left. (Returning from main would enter an
@@ -1311,6 +1450,26 @@ void main(void)
     /* The code down here becomes our idle task. It is executed when and only when no
        application task is running. */
 
+    /* The idle task offers a command shell on the serial interface. The table needs to be
+       sorted by command name. */
+    static const csh_cmdDesc_t cmdTable[] =
+    {
+        { .cmdName = "baud", .cmdHandler = cmdBaud, .argTypes = "u|u"
+        , .helpText = "baud <rate> [<timeoutInMs>], change Baud rate in agreement with host"
+        },
+        { .cmdName = "loopback", .cmdHandler = cmdLoopback, .argTypes = "|u"
+        , .helpText = "loopback [<rate>], run self-test of serial interface"
+        },
+        { .cmdName = "mem", .cmdHandler = cmdMem, .argTypes = ""
+        , .helpText = "Print usage statistics of dynamic memory"
+        },
+        { .cmdName = "serial", .cmdHandler = cmdSerial, .argTypes = ""
+        , .helpText = "Print state of serial interface"
+        },
+    };
+    static csh_shell_t shell SECTION(.bss.OS);
+    csh_osInitShell(&shell, cmdTable, CSH_NO_CMDS(cmdTable), /* prompt */ NULL);
+
     /* Prepare the run of the idle task of process 2. */
     static const rtos_taskDesc_t taskIdlePID2Config = { .addrTaskFct = (uintptr_t)taskIdlePID2
                                                       , .PID = 2
@@ -1322,6 +1481,9 @@ void main(void)
         testPCP(idTaskIdle);
         ++ mai_cntTaskIdle;
 
+        /* Process a command line if one has been entered meanwhile. */
+        csh_osRunShell(&shell);
+
         /* Activate the non cyclic task. Note, the execution time of this task activation
            will by principle not be considered by the CPU load measurement started from the
            same task (the idle task). */
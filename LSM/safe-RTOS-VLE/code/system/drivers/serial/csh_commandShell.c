@@ -0,0 +1,383 @@
+/**
+ * @file csh_commandShell.c
+ * A simple, table driven command interpreter for the serial interface. The application
+ * specifies its commands in a const table, together with the types of their arguments.
+ * The shell reads lines of input from the serial interface, looks the command up in the
+ * table, parses and checks the arguments and calls the command handler.\n
+ *   The command table is sorted by command name and the lookup is a binary search; the
+ * costs grow with the logarithm of the number of commands. No heap memory is used.\n
+ *   The shell is non-blocking. It is polled from a low priority context, typically the
+ * idle task; if no complete line of input has been received then a poll returns
+ * immediately.
+ *
+ * Copyright (C) 2020 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   csh_osInitShell
+ *   csh_osRunShell
+ * Local functions
+ *   print
+ *   tokenizeCmdLine
+ *   findCmd
+ *   parseArgs
+ *   printHelp
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <assert.h>
+
+#include "typ_types.h"
+#include "sio_serialIO.h"
+#include "csh_commandShell.h"
+
+
+/*
+ * Defines
+ */
+
+/** The name of the built-in help command. It is used only if the application's command
+    table doesn't contain a command of the same name. */
+#define CMD_NAME_HELP   "help"
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Print a C string to the serial output. The function waits for space in the serial output
+ * buffer if required; shell output is never truncated.
+ *   @param msg
+ * The zero terminated string to print.
+ */
+static inline void print(const char *msg)
+{
+    sio_osWriteSerialBlocking(msg, strlen(msg));
+
+} /* End of print */
+
+
+
+
+/**
+ * Split a command line into arguments. The arguments are separated by white space. The
+ * separating white space is replaced by zero bytes and the beginnings of the arguments are
+ * recorded.
+ *   @return
+ * Get the number of found arguments, i.e. the number of non white space regions in the
+ * command line. At maximum \a sizeOfArgV.
+ *   @param argV
+ * The vector of arguments, i.e. pointers to the non white space regions in the command
+ * line.
+ *   @param sizeOfArgV
+ * The number of entries available in \a argV.
+ *   @param cmdLine
+ * Prior to call: The original command line.\n
+ *   After return: White space in the command line is replaced by zero bytes. Note, not
+ * necessarily all white space due to the restriction superimposed by \a sizeOfArgV.
+ */
+static unsigned int tokenizeCmdLine( const char *argV[]
+                                   , unsigned int sizeOfArgV
+                                   , char * const cmdLine
+                                   )
+{
+    char *pC = cmdLine;
+    unsigned int noArgsFound = 0;
+    while(noArgsFound < sizeOfArgV)
+    {
+        /* Look for beginning of next argument. */
+        while(isspace((int)*pC))
+            ++ pC;
+
+        /* Leave the loop if we reached the end of the command line. */
+        if(*pC == '\0')
+            break;
+
+        /* New argument found. Record the beginning and look for its end. */
+        argV[noArgsFound++] = pC;
+        do
+        {
+            ++ pC;
+        }
+        while(*pC != '\0'  && !isspace((int)*pC));
+
+        /* Terminate the found argument if there are characters left in the command
+           line. */
+        if(*pC != '\0')
+            * pC++ = '\0';
+    }
+
+    return noArgsFound;
+
+} /* End of tokenizeCmdLine */
+
+
+
+
+/**
+ * Look a command up in the sorted command table by binary search.
+ *   @return
+ * Get the command descriptor or NULL if the command is unknown.
+ *   @param pShell
+ * The shell object, which owns the command table.
+ *   @param cmdName
+ * The name of the command to look for.
+ */
+static const csh_cmdDesc_t *findCmd(const csh_shell_t * const pShell, const char *cmdName)
+{
+    unsigned int idxFrom = 0
+               , idxTo = pShell->noCmds;
+    while(idxFrom < idxTo)
+    {
+        const unsigned int idxMid = (idxFrom + idxTo) / 2u;
+        const signed int cmp = strcmp(cmdName, pShell->cmdTable[idxMid].cmdName);
+        if(cmp == 0)
+            return &pShell->cmdTable[idxMid];
+        else if(cmp < 0)
+            idxTo = idxMid;
+        else
+            idxFrom = idxMid + 1u;
+    }
+    return NULL;
+
+} /* End of findCmd */
+
+
+
+
+/**
+ * Parse the arguments of a command according to its argument type specification.
+ *   @return
+ * Get \a true if the arguments match the specification. Otherwise a message has been
+ * printed and \a false is returned.
+ *   @param pCmd
+ * The descriptor of the command.
+ *   @param argValueAry
+ * The parsed values are returned in the first \a noArgs elements of this array.
+ *   @param noArgs
+ * The number of arguments.
+ *   @param argStrAry
+ * The \a noArgs arguments as found in the command line.
+ */
+static bool parseArgs( const csh_cmdDesc_t * const pCmd
+                     , csh_argValue_t argValueAry[]
+                     , unsigned int noArgs
+                     , const char * const argStrAry[]
+                     )
+{
+    const char *pType = pCmd->argTypes;
+    bool isOptional = false;
+    unsigned int idxArg = 0;
+    while(true)
+    {
+        if(*pType == '|')
+        {
+            isOptional = true;
+            ++ pType;
+            continue;
+        }
+
+        /* The arguments are checked if all types have been processed or if the remaining
+           types are optional. */
+        if(idxArg >= noArgs)
+        {
+            if(*pType == '\0'  ||  isOptional)
+                return true;
+
+            print("Too few arguments\r\n");
+            return false;
+        }
+        else if(*pType == '\0')
+        {
+            print("Too many arguments\r\n");
+            return false;
+        }
+
+        const char * const argStr = argStrAry[idxArg];
+        char *pEnd;
+        errno = 0;
+        switch(*pType)
+        {
+        case 'i':
+            argValueAry[idxArg].i = strtol(argStr, &pEnd, /* base */ 0);
+            break;
+        case 'u':
+            argValueAry[idxArg].u = strtoul(argStr, &pEnd, /* base */ 0);
+            if(*argStr == '-')
+                errno = ERANGE;
+            break;
+        case 's':
+            argValueAry[idxArg].s = argStr;
+            pEnd = (char*)argStr + strlen(argStr);
+            break;
+        default:
+            /* Bad type specification in the command table. */
+            assert(false);
+            pEnd = (char*)argStr;
+        }
+
+        if(*pEnd != '\0'  ||  errno != 0)
+        {
+            char msg[40];
+            sniprintf(msg, sizeof(msg), "Bad argument %u: %.16s\r\n", idxArg+1u, argStr);
+            print(msg);
+            return false;
+        }
+
+        ++ idxArg;
+        ++ pType;
+    }
+} /* End of parseArgs */
+
+
+
+
+/**
+ * The built-in help command: Print the list of commands with their help texts.
+ *   @param pShell
+ * The shell object, which owns the command table.
+ */
+static void printHelp(const csh_shell_t * const pShell)
+{
+    for(unsigned int u=0; u<pShell->noCmds; ++u)
+    {
+        const csh_cmdDesc_t * const pCmd = &pShell->cmdTable[u];
+        print(pCmd->cmdName);
+        print(": ");
+        print(pCmd->helpText != NULL? pCmd->helpText: "");
+        print("\r\n");
+    }
+} /* End of printHelp */
+
+
+
+
+/**
+ * Initialize a shell object. Needs to be called once before the shell is polled with
+ * csh_osRunShell().
+ *   @param pShell
+ * The shell object to initialize. It is owned by the application and it needs to stay
+ * alive as long as the shell is used.
+ *   @param cmdTable
+ * The command table. It needs to stay alive as long as the shell is used. The entries need
+ * to be sorted in ascending order of the command names. This is checked by assertion.
+ *   @param noCmds
+ * The number of entries in \a cmdTable. See macro #CSH_NO_CMDS.
+ *   @param prompt
+ * The prompt to print when the shell is ready for the next command or NULL if no prompt is
+ * wanted.
+ *   @remark
+ * This function must be called from the OS context only.
+ */
+void csh_osInitShell( csh_shell_t * const pShell
+                    , const csh_cmdDesc_t cmdTable[]
+                    , unsigned int noCmds
+                    , const char *prompt
+                    )
+{
+#ifdef DEBUG
+    /* Binary search requires a sorted table without duplicates. */
+    for(unsigned int u=1; u<noCmds; ++u)
+        assert(strcmp(cmdTable[u-1].cmdName, cmdTable[u].cmdName) < 0);
+#endif
+
+    pShell->cmdTable = cmdTable;
+    pShell->noCmds = noCmds;
+    pShell->prompt = prompt;
+    pShell->cmdLine[0] = '\0';
+
+    if(prompt != NULL)
+        print(prompt);
+
+} /* End of csh_osInitShell */
+
+
+
+
+/**
+ * Poll the shell. If a complete line of input has been received from the serial interface
+ * then it is interpreted as command and executed. Otherwise the function returns
+ * immediately.
+ *   @return
+ * Get \a true if a command line was processed, \a false if no input was available.
+ *   @param pShell
+ * The shell object, which had been initialized with csh_osInitShell().
+ *   @remark
+ * The function must be called from OS context but not from an ISR. The command handlers
+ * are executed in the calling context and the shell's output waits for space in the
+ * serial output buffer, if required. Call it from a low priority context, typically the
+ * idle task.
+ */
+bool csh_osRunShell(csh_shell_t * const pShell)
+{
+    if(sio_osGetLine(pShell->cmdLine, sizeOfAry(pShell->cmdLine)) == NULL)
+        return false;
+
+    /* One more argument than permitted lets us recognize too many arguments. */
+    const char *argStrAry[1 + CSH_MAX_NO_ARGS + 1];
+    const unsigned int argC = tokenizeCmdLine( argStrAry
+                                             , sizeOfAry(argStrAry)
+                                             , pShell->cmdLine
+                                             );
+    if(argC > 0)
+    {
+        const csh_cmdDesc_t * const pCmd = findCmd(pShell, argStrAry[0]);
+        if(pCmd != NULL)
+        {
+            csh_argValue_t argValueAry[CSH_MAX_NO_ARGS+1];
+            if(parseArgs(pCmd, argValueAry, argC-1u, &argStrAry[1]))
+            {
+                if(!pCmd->cmdHandler(argC-1u, argValueAry))
+                    print("Command failed\r\n");
+            }
+        }
+        else if(strcmp(argStrAry[0], CMD_NAME_HELP) == 0)
+            printHelp(pShell);
+        else
+        {
+            print("Unknown command. Type " CMD_NAME_HELP " to get a list of all commands\r\n");
+        }
+    }
+
+    if(pShell->prompt != NULL)
+        print(pShell->prompt);
+
+    return true;
+
+} /* End of csh_osRunShell */
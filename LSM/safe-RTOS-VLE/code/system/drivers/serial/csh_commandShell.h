@@ -0,0 +1,138 @@
+#ifndef CSH_COMMANDSHELL_INCLUDED
+#define CSH_COMMANDSHELL_INCLUDED
+/**
+ * @file csh_commandShell.h
+ * Definition of global interface of module csh_commandShell.c
+ *
+ * Copyright (C) 2020 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*
+ * Defines
+ */
+
+/** The maximum number of arguments of a command, not counting the command name itself. */
+#define CSH_MAX_NO_ARGS         8u
+
+/** The maximum length of a command line in characters. Longer input is truncated. */
+#define CSH_MAX_LEN_CMD_LINE    80u
+
+/** Helper to state the number of entries of a command table in the call of
+    csh_osInitShell(). */
+#define CSH_NO_CMDS(cmdTable)   (sizeof(cmdTable)/sizeof((cmdTable)[0]))
+
+
+/*
+ * Global type definitions
+ */
+
+/** The value of a parsed command argument. Which field is valid depends on the argument
+    type specification of the command, see \a csh_cmdDesc_t::argTypes. */
+typedef union csh_argValue_t
+{
+    /** Argument of type 'i', a signed integer. */
+    signed long i;
+
+    /** Argument of type 'u', an unsigned integer. */
+    unsigned long u;
+
+    /** Argument of type 's', a string. It points into the command line buffer of the shell
+        and is valid only during the execution of the command handler. */
+    const char *s;
+
+} csh_argValue_t;
+
+
+/** The type of a command handler.
+      @return Get \a true if the command succeeded or \a false otherwise. The shell reports
+    the failure.
+      @param argC The number of parsed arguments. It is in the range of mandatory up to
+    all, mandatory and optional arguments of the command.
+      @param argV The vector of \a argC parsed arguments. */
+typedef bool (*csh_cmdHandler_t)(unsigned int argC, const csh_argValue_t argV[]);
+
+
+/** The description of a command. An application has a const table of such objects. The
+    table needs to be sorted in ascending order of the command names (in the sense of \a
+    strcmp), which enables the shell to find a command by binary search. */
+typedef struct csh_cmdDesc_t
+{
+    /** The name of the command. */
+    const char *cmdName;
+
+    /** The function, which implements the command. */
+    csh_cmdHandler_t cmdHandler;
+
+    /** The specification of the command arguments. One character per argument: 'i' for a
+        signed integer, 'u' for an unsigned integer and 's' for a string. Integer input
+        may be decimal, hexadecimal (0x) or octal (0). A '|' separates the mandatory from
+        the optional arguments. Example: "u|s" is one mandatory unsigned integer and an
+        optional string. Use "" for a command without arguments. */
+    const char *argTypes;
+
+    /** A one line help text, which is printed by the built-in command "help". */
+    const char *helpText;
+
+} csh_cmdDesc_t;
+
+
+/** An instance of the command shell. The object is filled by csh_osInitShell() and must
+    not be touched by the application. */
+typedef struct csh_shell_t
+{
+    /** The command table. */
+    const csh_cmdDesc_t *cmdTable;
+
+    /** The number of entries in \a cmdTable. */
+    unsigned int noCmds;
+
+    /** The prompt to print after each command or NULL. */
+    const char *prompt;
+
+    /** The buffer for the input line. */
+    char cmdLine[CSH_MAX_LEN_CMD_LINE+1];
+
+} csh_shell_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize a shell object with its command table. */
+void csh_osInitShell( csh_shell_t * const pShell
+                    , const csh_cmdDesc_t cmdTable[]
+                    , unsigned int noCmds
+                    , const char *prompt
+                    );
+
+/** Poll the shell: Process a command line if one has been received. Non-blocking. */
+bool csh_osRunShell(csh_shell_t * const pShell);
+
+#endif  /* CSH_COMMANDSHELL_INCLUDED */
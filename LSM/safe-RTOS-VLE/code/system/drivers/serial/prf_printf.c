@@ -73,6 +73,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <errno.h>
 #include <assert.h>
 
 #include "typ_types.h"
@@ -107,6 +108,14 @@ unsigned long prf_sbrk_noRequests = 0;
     \a sbrk is recorded. (This includes those requests, which could not be satisfied.) */
 unsigned long prf_sbrk_totalIncrement = 0;
 
+/** Debug support for adjusting the memory allocation to your needs. The number of requests
+    of \a sbrk, which couldn't be satisfied because the heap is exhausted, is counted. */
+unsigned long prf_sbrk_noFailedRequests = 0;
+
+/** Debug support for adjusting the memory allocation to your needs. The number of bytes of
+    the heap, which are currently given away. Compare with linker setting ld_heapSize. */
+unsigned long prf_sbrk_noBytesInUse = 0;
+
 
 /*
  * Function implementation
@@ -126,9 +135,14 @@ unsigned long prf_sbrk_totalIncrement = 0;
  * first returned pointer is guaranteed to be properly aligned.
  *   @return
  * The pointer to next chunk of free memory, which can be used by the caller. The pointer
- * point to a chunk of \a increment Byte.
+ * point to a chunk of \a increment Byte. If the heap is exhausted then (void*)-1 is
+ * returned and \a errno is set to ENOMEM; \a malloc will return NULL.
  *   @param increment
- * The number of requested Byte of memory.
+ * The number of requested Byte of memory. A negative value returns memory to the heap.
+ *   @remark
+ * The heap of the C library is located in the RAM of process 1 and only the tasks of this
+ * process can use \a malloc and else. The other processes can use their memory arena and
+ * pools of fixed size blocks instead, see module mem_memoryPool.c.
  *   @remark
  * Refer to https://github.com/eblot/newlib/blob/master/newlib/libc/reent/sbrkr.c,
  * https://en.wikipedia.org/wiki/Sbrk and
@@ -150,15 +164,18 @@ void *sbrk(ptrdiff_t increment)
     assert(((uintptr_t)ld_sbrkStart & (8-1)) == 0);
     
     static uint8_t *pNextChunk_ = ld_sbrkStart;
-    if(pNextChunk_ + increment <= ld_sbrkEnd)
+    if(increment <= ld_sbrkEnd - pNextChunk_  &&  -increment <= pNextChunk_ - ld_sbrkStart)
     {
         void *result = (void*)pNextChunk_;
         pNextChunk_ += increment;
+        prf_sbrk_noBytesInUse = (unsigned long)(pNextChunk_ - ld_sbrkStart);
         return result;
     }
     else
     {
-        assert(false);
+        /* Out of memory is reported to the C library, which lets malloc return NULL. */
+        ++ prf_sbrk_noFailedRequests;
+        errno = ENOMEM;
         return (void*)-1;
     }
 } /* End of sbrk */
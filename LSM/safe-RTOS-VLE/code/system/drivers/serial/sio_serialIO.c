@@ -30,17 +30,39 @@
  */
 /* Module interface
  *   sio_osInitSerialInterface
+ *   sio_osRegisterSpaceAvailableEvent
  *   sio_scFlHdlr_writeSerial
+ *   sio_scFlHdlr_tryWriteSerial
  *   sio_writeSerial (inline)
+ *   sio_tryWriteSerial (inline)
  *   sio_osWriteSerial
+ *   sio_osTryWriteSerial
+ *   sio_osWriteSerialBlocking
+ *   sio_osGetBaudRateAccuracy
+ *   sio_osGetBaudRate
+ *   sio_osChangeBaudRate
+ *   sio_osNegotiateBaudRate
+ *   sio_osRunLoopbackSelfTest
  *   sio_osGetChar
  *   sio_osGetLine
  * Local functions
  *   configSIULForUseWithOpenSDA
  *   configDMA
+ *   computeBaudRateDivider
  *   configLINFlex
  *   linFlexRxInterrupt
+ *   getNoBytesFree
+ *   dmaSerialOutInterrupt
  *   registerInterrupts
+ *   writeSerial
+ *   enableDmaIrq
+ *   getNoBytesInPrcQueue
+ *   enqueue
+ *   flushPrcQueue
+ *   flushPrcQueues
+ *   writeSerialOfProcess
+ *   enterInitMode
+ *   waitForTxIdleAndLock
  */
 
 /*
@@ -48,6 +70,7 @@
  */
 
 #include <stdatomic.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -57,6 +80,8 @@
 #include "typ_types.h"
 #include "sio_serialIO_defSysCalls.h"
 #include "rtos_ivorHandler.h"
+#include "rtos_scheduler.h"
+#include "gsl_systemLoad.h"
 #include "rtos.h"
 
 
@@ -82,11 +107,33 @@
     that makes use of the input related API functions of this module. */
 #define INTC_PRIO_IRQ_UART_FOR_SERIAL_INPUT     6
 
+/** The interrupt priority for the DMA completion interrupt of the serial output. The
+    interrupt is requested by the DMA channel, when half or all of the currently queued
+    output has been transmitted. It is enabled only while a context waits for free space in
+    the output ring buffer, see sio_osRegisterSpaceAvailableEvent(). The range is 1..15.
+      @remark The interrupt handler triggers an RTOS event. The priority must therefore not
+    exceed the kernel's priority #RTOS_KERNEL_IRQ_PRIORITY. */
+#define INTC_PRIO_IRQ_DMA_FOR_SERIAL_OUTPUT     (RTOS_KERNEL_IRQ_PRIORITY)
+
 /** The size of the ring buffer for serial output can be chosen as a power of two of bytes.
-      @remark The permitted range of values depends on the reservation of space made
-    in the linker control file. The macro here needs to be maintained in sync with the
-    symbol ld_noBitsDmaRingBuffer, that is maintained in the linker file. */
-#define SERIAL_OUTPUT_RING_BUFFER_SIZE_PWR_OF_TWO   10
+    The setting can be made per build, by passing a C define on the compiler command line.
+    The permitted range is 4..15.
+      @remark The macro needs to be maintained in sync with the symbol
+    ld_noBitsDmaRingBuffer, that is maintained in the linker file. The makefile variable
+    SIO_RING_BUF_PWR_OF_TWO takes care of both, see GNUmakefile. */
+#ifndef SIO_SERIAL_OUTPUT_RING_BUFFER_SIZE_PWR_OF_TWO
+# define SIO_SERIAL_OUTPUT_RING_BUFFER_SIZE_PWR_OF_TWO  10
+#endif
+#define SERIAL_OUTPUT_RING_BUFFER_SIZE_PWR_OF_TWO                                           \
+                                        (SIO_SERIAL_OUTPUT_RING_BUFFER_SIZE_PWR_OF_TWO)
+#if SERIAL_OUTPUT_RING_BUFFER_SIZE_PWR_OF_TWO < 4                                           \
+    ||  SERIAL_OUTPUT_RING_BUFFER_SIZE_PWR_OF_TWO > 15
+# error Invalid configuration of serial output ring buffer size. The DMA major loop \
+        counter has 15 Bit, which limits the size of the buffer to 2^15 Byte
+#endif
+#if INTC_PRIO_IRQ_DMA_FOR_SERIAL_OUTPUT > RTOS_KERNEL_IRQ_PRIORITY
+# error The DMA interrupt triggers RTOS events and must not have a priority above the kernel
+#endif
 
 /** The size of the ring buffer for serial input as number of bytes. The maximum capacity
     is one Byte less than the size. For this buffer, there's no penalty in not using a
@@ -118,6 +165,75 @@
 #define SERIAL_OUTPUT_RING_BUFFER_IDX_MASK  (SERIAL_OUTPUT_RING_BUFFER_SIZE-1)
 
 
+/** The clock rate of the LINFlexD devices in Hz. The code assumes the peripheral clock
+    setting of the startup code. */
+#define PERIPHERAL_CLOCK_RATE   120000000ul
+
+/** The output of the user processes is not directly written into the DMA ring buffer but
+    each process has an own queue. An arbiter moves the queued data into the ring buffer
+    when space becomes available. This way, a process, which floods the output, can't
+    suppress the output of other processes.\n
+      Here, we have the size of the queue of process 1 in Byte. 0 disables the queue; the
+    process writes directly into the ring buffer (with truncation) as if there were no
+    per-process queueing. The setting can be made per build, by passing a C define on the
+    compiler command line. */
+#ifndef SIO_PRC_OUTPUT_QUEUE_SIZE_P1
+# define SIO_PRC_OUTPUT_QUEUE_SIZE_P1   256
+#endif
+
+/** The size in Byte of the output queue of process 2. See #SIO_PRC_OUTPUT_QUEUE_SIZE_P1. */
+#ifndef SIO_PRC_OUTPUT_QUEUE_SIZE_P2
+# define SIO_PRC_OUTPUT_QUEUE_SIZE_P2   256
+#endif
+
+/** The size in Byte of the output queue of process 3. See #SIO_PRC_OUTPUT_QUEUE_SIZE_P1. */
+#ifndef SIO_PRC_OUTPUT_QUEUE_SIZE_P3
+# define SIO_PRC_OUTPUT_QUEUE_SIZE_P3   256
+#endif
+
+/** The size in Byte of the output queue of process 4. See #SIO_PRC_OUTPUT_QUEUE_SIZE_P1. */
+#ifndef SIO_PRC_OUTPUT_QUEUE_SIZE_P4
+# define SIO_PRC_OUTPUT_QUEUE_SIZE_P4   256
+#endif
+
+/** The arbitration of the per-process output queues. If 0 then the queues are served in
+    order of process privileges: The queue of the process with highest PID is emptied
+    first. If 1 then a weighted round robin is applied. In each round, the arbiter takes
+    up to #SIO_PRC_OUTPUT_WEIGHT_P1 ... #SIO_PRC_OUTPUT_WEIGHT_P4 bytes from the
+    different queues. */
+#ifndef SIO_PRC_OUTPUT_ARBITRATION_WRR
+# define SIO_PRC_OUTPUT_ARBITRATION_WRR 0
+#endif
+
+/** Weighted round robin: The number of bytes taken per round from the queue of process 1.
+    The weights need to be greater than zero. */
+#ifndef SIO_PRC_OUTPUT_WEIGHT_P1
+# define SIO_PRC_OUTPUT_WEIGHT_P1       16
+#endif
+
+/** Weighted round robin: Bytes per round taken from the queue of process 2. */
+#ifndef SIO_PRC_OUTPUT_WEIGHT_P2
+# define SIO_PRC_OUTPUT_WEIGHT_P2       32
+#endif
+
+/** Weighted round robin: Bytes per round taken from the queue of process 3. */
+#ifndef SIO_PRC_OUTPUT_WEIGHT_P3
+# define SIO_PRC_OUTPUT_WEIGHT_P3       64
+#endif
+
+/** Weighted round robin: Bytes per round taken from the queue of process 4. */
+#ifndef SIO_PRC_OUTPUT_WEIGHT_P4
+# define SIO_PRC_OUTPUT_WEIGHT_P4       128
+#endif
+
+#if RTOS_NO_PROCESSES != 4
+# error Configuration of per-process output queues needs to be adapted to number of processes
+#endif
+#if SIO_PRC_OUTPUT_WEIGHT_P1 <= 0 || SIO_PRC_OUTPUT_WEIGHT_P2 <= 0 \
+    || SIO_PRC_OUTPUT_WEIGHT_P3 <= 0 || SIO_PRC_OUTPUT_WEIGHT_P4 <= 0
+# error Weights of round robin arbitration of output queues need to be greater than zero
+#endif
+
 /* The LINFlex device to be used is selected by name depending on the setting of
    #IDX_LINFLEX_D. */
 #if IDX_LINFLEX_D == 0
@@ -133,12 +249,48 @@
  * Local type definitions
  */
  
+/** The different behaviors of the internal write function on insufficient space in the
+    ring buffer. */
+typedef enum writeMode_t
+{
+    wrMode_truncate         /// Truncate message and count the lost bytes
+    , wrMode_backPressure   /// Return remainder to caller and request space available event
+    , wrMode_polling        /// Return remainder to caller, who will poll for space
+
+} writeMode_t;
+
+
+/** The output queue of a process. It's a ring buffer with read and write index. Same index
+    values mean empty queue, i.e. the capacity of the queue is one less than \a size. */
+typedef struct prcOutputQueue_t
+{
+    /** The memory area of the queue, \a size Byte. */
+    uint8_t * const pBuf;
+    
+    /** The number of bytes in \a pBuf. A value of one means no queue. */
+    const unsigned int size;
+    
+    /** The read position, index of next byte to send. */
+    unsigned int idxRd;
+
+    /** The write position, index of next free byte. */
+    unsigned int idxWr;
+
+} prcOutputQueue_t;
+
  
 /*
  * Local prototypes
  */
  
- 
+static void flushPrcQueues(void);
+static unsigned int writeSerialOfProcess( unsigned int PID
+                                        , const char *msg
+                                        , unsigned int noBytes
+                                        , writeMode_t mode
+                                        );
+
+
 /*
  * Data definitions
  */
@@ -167,6 +319,110 @@ volatile unsigned long SBSS_OS(sio_serialOutNoTruncatedMsgs) = 0;
     sio_serialOutNoLostMsgBytes. */
 volatile unsigned long SBSS_OS(sio_serialOutNoLostMsgBytes) = 0;
 
+/** This development support variable holds the maximum number of bytes, which had ever
+    been pending for transmission in the output ring buffer since power-up. Compare it with
+    the buffer capacity, which is 2^#SIO_SERIAL_OUTPUT_RING_BUFFER_SIZE_PWR_OF_TWO-1 Byte,
+    to tune the buffer size. */
+volatile unsigned long SBSS_OS(sio_serialOutHighWaterMark) = 0;
+
+/** The number of write operations using back-pressure (see sio_osTryWriteSerial()), which
+    could not queue the entire message and which returned to the caller with a remainder. */
+volatile unsigned long SBSS_OS(sio_serialOutNoBackPressureWrites) = 0;
+
+/** The ID of the RTOS event, which is triggered when a context, which had been rejected
+    by sio_osTryWriteSerial(), can continue with output. #RTOS_INVALID_EVENT_ID if no such
+    event has been registered. */
+static unsigned int SDATA_OS(_idEventSpaceAvailable) = RTOS_INVALID_EVENT_ID;
+
+/** The minimum number of free bytes in the output ring buffer, which is required before
+    event \a _idEventSpaceAvailable is triggered. */
+static unsigned int SBSS_OS(_minNoBytesFreeForEvent) = 0;
+
+/** The flag is set if a call of sio_osTryWriteSerial() couldn't queue all of its data.
+    The DMA completion interrupt is enabled as long as the flag is set and it'll trigger
+    the event \a _idEventSpaceAvailable and reset the flag as soon as enough space has been
+    freed. */
+static volatile bool SBSS_OS(_isSpaceEventRequested) = false;
+
+/** The Baud rate, which had been requested by the last configuration of the LINFlexD. */
+static unsigned int SBSS_OS(_baudRate) = 0;
+
+/** The Baud rate, which is actually achieved with the divider settings of the LINFlexD. It
+    differs from \a _baudRate by the quantization of the fractional divider. */
+static unsigned int SBSS_OS(_actualBaudRate) = 0;
+
+/** The flag reflects the state of the interrupt enable bits INT_HALF and INT_MAJ of the DMA
+    channel. */
+static bool SBSS_OS(_isDmaIrqEnabled) = false;
+
+/** The memory of all per-process output queues. Each queue gets one extra byte because of
+    the empty-queue convention of the ring buffer. */
+static uint8_t BSS_OS(_prcQueueMem)[ SIO_PRC_OUTPUT_QUEUE_SIZE_P1
+                                     + SIO_PRC_OUTPUT_QUEUE_SIZE_P2
+                                     + SIO_PRC_OUTPUT_QUEUE_SIZE_P3
+                                     + SIO_PRC_OUTPUT_QUEUE_SIZE_P4
+                                     + RTOS_NO_PROCESSES
+                                   ];
+
+/** The per-process output queues. Process i uses element i-1. */
+static prcOutputQueue_t DATA_OS(_prcQueueAry)[RTOS_NO_PROCESSES] =
+{
+    [0] = { .pBuf = &_prcQueueMem[0]
+          , .size = SIO_PRC_OUTPUT_QUEUE_SIZE_P1 + 1
+          , .idxRd = 0
+          , .idxWr = 0
+          },
+    [1] = { .pBuf = &_prcQueueMem[SIO_PRC_OUTPUT_QUEUE_SIZE_P1 + 1]
+          , .size = SIO_PRC_OUTPUT_QUEUE_SIZE_P2 + 1
+          , .idxRd = 0
+          , .idxWr = 0
+          },
+    [2] = { .pBuf = &_prcQueueMem[ SIO_PRC_OUTPUT_QUEUE_SIZE_P1 + SIO_PRC_OUTPUT_QUEUE_SIZE_P2
+                                   + 2
+                                 ]
+          , .size = SIO_PRC_OUTPUT_QUEUE_SIZE_P3 + 1
+          , .idxRd = 0
+          , .idxWr = 0
+          },
+    [3] = { .pBuf = &_prcQueueMem[ SIO_PRC_OUTPUT_QUEUE_SIZE_P1 + SIO_PRC_OUTPUT_QUEUE_SIZE_P2
+                                   + SIO_PRC_OUTPUT_QUEUE_SIZE_P3 + 3
+                                 ]
+          , .size = SIO_PRC_OUTPUT_QUEUE_SIZE_P4 + 1
+          , .idxRd = 0
+          , .idxWr = 0
+          },
+};
+
+#if SIO_PRC_OUTPUT_ARBITRATION_WRR == 1
+/** The weights of the round robin arbitration of the process output queues. Process i uses
+    element i-1. */
+static const unsigned int _prcOutputWeightAry[RTOS_NO_PROCESSES] =
+    { [0] = SIO_PRC_OUTPUT_WEIGHT_P1
+    , [1] = SIO_PRC_OUTPUT_WEIGHT_P2
+    , [2] = SIO_PRC_OUTPUT_WEIGHT_P3
+    , [3] = SIO_PRC_OUTPUT_WEIGHT_P4
+    };
+#endif
+
+/** The total number of bytes, which are currently buffered in all process queues. */
+static unsigned int SBSS_OS(_noBytesInPrcQueues) = 0;
+
+/** The number of messages of a process, which underwent truncation since power-up, because
+    neither the ring buffer nor the process' output queue had enough space. The array is
+    indexed by PID; element 0 is not used.
+      @remark The global counter \a sio_serialOutNoTruncatedMsgs includes these counts. */
+volatile unsigned long BSS_OS(sio_serialOutPrcNoTruncatedMsgsAry)[1+RTOS_NO_PROCESSES];
+
+/** The number of message characters of a process, which had been lost due to truncation
+    since power-up. The array is indexed by PID; element 0 is not used.
+      @remark The global counter \a sio_serialOutNoLostMsgBytes includes these counts. */
+volatile unsigned long BSS_OS(sio_serialOutPrcNoLostMsgBytesAry)[1+RTOS_NO_PROCESSES];
+
+/** The maximum fill level of the output queue of a process since power-up. The array is
+    indexed by PID; element 0 is not used. Compare with the configured queue sizes, e.g.
+    #SIO_PRC_OUTPUT_QUEUE_SIZE_P1, to tune the sizes. */
+volatile unsigned long BSS_OS(sio_serialOutPrcQueueHighWaterMarkAry)[1+RTOS_NO_PROCESSES];
+
 /** The ring buffer used for the DMA based serial output.
       @remark The size of the buffer is defined here in the C source code but there is a
     strong dependency on the linker control file, too. The log2(sizeOfBuffer) least
@@ -412,6 +668,44 @@ static void configDMA(void)
 
 
 
+/**
+ * Compute the setting of the fractional Baud rate divider of the LINFlexD device.
+ *   @return
+ * Get the Baud rate, which is actually achieved with the computed divider. The deviation
+ * from the requested Baud rate is due to the quantization of the divider.
+ *   @param pIBR
+ * The integer part of the divider is returned in * \a pIBR, i.e. the value for register
+ * LINIBRR.
+ *   @param pFBR
+ * The fractional part of the divider in units of 1/16 is returned in * \a pFBR, i.e. the
+ * value for register LINFBRR.
+ *   @param baudRate
+ * The wanted Baud rate in Hz. The range is #SIO_MIN_BAUD_RATE .. #SIO_MAX_BAUD_RATE.
+ */
+static unsigned int computeBaudRateDivider( unsigned int * const pIBR
+                                          , unsigned int * const pFBR
+                                          , unsigned int baudRate
+                                          )
+{
+    assert(baudRate >= SIO_MIN_BAUD_RATE  &&  baudRate <= SIO_MAX_BAUD_RATE);
+
+    /* LFDIV = f_periph/(16*baudRate), IBR:FBR is LFDIV in units of 1/16. This is nothing
+       else than f_periph/baudRate. We round to the nearest value; the error is half of
+       the error of truncation. */
+    unsigned long div = (PERIPHERAL_CLOCK_RATE + baudRate/2u) / baudRate;
+    if(div < 16)
+        div = 16;
+    *pIBR = (unsigned int)(div >> 4);
+    *pFBR = (unsigned int)(div & 0xful);
+    assert((*pIBR & ~0xfffffu) == 0);
+
+    return (unsigned int)((PERIPHERAL_CLOCK_RATE + div/2u) / div);
+
+} /* End of computeBaudRateDivider */
+
+
+
+
 /**
  * Initialization of the MPC5643L's I/O device LINFlex_0. The device is put into UART mode
  * for serial in-/output.
@@ -425,10 +719,10 @@ static void configDMA(void)
 static void configLINFlex(unsigned int baudRate)
 {
     /* Avoid over-/underflow down below. */
-    if(baudRate < 10)
-        baudRate = 10;
-    else if(baudRate > 1000000)
-        baudRate = 1000000;
+    if(baudRate < SIO_MIN_BAUD_RATE)
+        baudRate = SIO_MIN_BAUD_RATE;
+    else if(baudRate > SIO_MAX_BAUD_RATE)
+        baudRate = SIO_MAX_BAUD_RATE;
     
     /* Please find the UART register description in the MCU ref. manual, section 30.10, p.
        979ff. */
@@ -477,10 +771,12 @@ static void configLINFlex(unsigned int baudRate)
        115200 bd worked well with terminal.exe and putty
        128000 bd showed transmission errors with terminal.exe and putty
        256000 bd failed with terminal.exe and putty
-       921600 bd failed with terminal.exe (not tried with putty) */
-    const unsigned long IBR = 7500000ul / baudRate
-                      , FBR = (7500000ul - IBR*baudRate)*16 / baudRate;
-    assert((IBR & ~0xffffful) == 0  &&  (FBR & ~0xful) == 0);
+       921600 bd failed with terminal.exe (not tried with putty)
+       
+       The Baud rate can be changed at run-time, see sio_osChangeBaudRate(). */
+    unsigned int IBR, FBR;
+    _actualBaudRate = computeBaudRateDivider(&IBR, &FBR, baudRate);
+    _baudRate = baudRate;
     LINFLEX.LINIBRR.B.IBR = IBR;
     LINFLEX.LINFBRR.B.FBR = FBR;
 
@@ -576,6 +872,79 @@ static void linFlexRxInterrupt(void)
 
 
 
+/**
+ * Get the number of bytes, which can currently be queued for serial output without
+ * truncation.
+ *   @return
+ * Get the number of free bytes in the output ring buffer. The value is a snapshot; the
+ * possibly running DMA transfer continues to free space.
+ *   @remark
+ * This function needs to be called from inside a critical section if the result is used
+ * for a subsequent write operation.
+ */
+static inline unsigned int getNoBytesFree(void)
+{
+    /* The current transfer address of the DMA is the end of the free buffer area. Note the
+       -1: Same index values are used as empty-buffer-indication. */
+    const uint32_t idxEndOfFreeSpaceM =
+                                EDMA.CHANNEL[DMA_CHN_FOR_SERIAL_OUTPUT].TCDWORD0_.B.SADDR;
+    return (idxEndOfFreeSpaceM - _serialOutRingBufIdxWrM - 1)
+           & SERIAL_OUTPUT_RING_BUFFER_IDX_MASK;
+
+} /* End of getNoBytesFree */
+
+
+
+/**
+ * Interrupt handler for the DMA channel serving the serial output. The interrupt is
+ * requested when half or all of the bytes, which had been pending at the last start of
+ * the DMA transfer, have been transmitted. It is enabled only as long as a back-pressured
+ * writer waits for free space or as long as there is data in the process output queues.\n
+ *   The handler refills the ring buffer from the process output queues. Then it checks the
+ * free space in the ring buffer and triggers the registered event if the configured
+ * threshold is reached.
+ */
+static void dmaSerialOutInterrupt(void)
+{
+    /* Acknowledge the interrupt.
+         CAER, 0x40: 1: Clear all interrupt requests, 0: Only the addressed one
+         CINT, 0xf: Channel number */
+    EDMA.DMACINT.R = DMA_CHN_FOR_SERIAL_OUTPUT;
+
+    /* The interrupt may preempt a lower prioritized context, which is just in the middle of
+       a write operation. We need mutual exclusion when looking at the buffer state. */
+    bool isTrigger = false;
+    unsigned int noBytesFree;
+    uint32_t msr = rtos_osEnterCriticalSection();
+    {
+        /* The DMA has freed space in the ring buffer. Let the arbiter refill it from the
+           process output queues. */
+        flushPrcQueues();
+        
+        noBytesFree = getNoBytesFree();
+        if(_isSpaceEventRequested  &&  noBytesFree >= _minNoBytesFreeForEvent)
+        {
+            /* The request is served. We don't disable the interrupt sources in the TCD of
+               the running channel; the next write operation will reconfigure them. A
+               possible further interrupt is harmless. */
+            _isSpaceEventRequested = false;
+            isTrigger = true;
+        }
+    }
+    rtos_osLeaveCriticalSection(msr);
+
+    /* Notify the waiting context. The task parameter is the number of free bytes at the
+       time of triggering. A failing trigger (the task is still busy) is accounted by the
+       RTOS as activation loss. */
+    if(isTrigger)
+    {
+        assert(_idEventSpaceAvailable != RTOS_INVALID_EVENT_ID);
+        rtos_osTriggerEvent(_idEventSpaceAvailable, /* taskParam */ noBytesFree);
+    }
+} /* End of dmaSerialOutInterrupt */
+
+
+
 /**
  * Our locally implemented interrupt handlers are registered at the operating system for
  * serving the required I/O devices (DMA and LINFlex 0 or 1).
@@ -585,6 +954,7 @@ static void registerInterrupts(void)
 /* Interrupt offsets taken from MCU reference manual, p. 936. The DMA interrupts for the
    different channels start with 11, e.g. 26 for DMA channel 15. */
 #define IDX_LINFLEX_RX_IRQ  (79 + 20*IDX_LINFLEX_D)
+#define IDX_DMA_IRQ         (11 + DMA_CHN_FOR_SERIAL_OUTPUT)
 
     /* Register our IRQ handler. */
     rtos_osRegisterInterruptHandler( &linFlexRxInterrupt
@@ -592,7 +962,13 @@ static void registerInterrupts(void)
                                    , /* psrPriority */ INTC_PRIO_IRQ_UART_FOR_SERIAL_INPUT
                                    , /* isPreemptable */ true
                                    );
+    rtos_osRegisterInterruptHandler( &dmaSerialOutInterrupt
+                                   , /* vectorNum */ IDX_DMA_IRQ
+                                   , /* psrPriority */ INTC_PRIO_IRQ_DMA_FOR_SERIAL_OUTPUT
+                                   , /* isPreemptable */ true
+                                   );
 #undef IDX_LINFLEX_RX_IRQ
+#undef IDX_DMA_IRQ
 } /* End of registerInterrupts */
 
 
@@ -633,6 +1009,42 @@ void sio_osInitSerialInterface(unsigned int baudRate)
 
 
 
+/**
+ * Register an RTOS event, which is triggered when a writer, which had been rejected by
+ * sio_osTryWriteSerial() or sio_tryWriteSerial(), can continue to write. This is the
+ * event based "wait for space" for low priority tasks: A task of the run-to-completion
+ * scheduler can't block. Instead, it ends after having got a partial write and it is
+ * re-activated by the event, when enough space has been freed in the ring buffer.\n
+ *   The event is triggered by the DMA completion interrupt, at maximum once per rejected
+ * write. The task parameter of the triggered event is the number of free bytes at the
+ * time of triggering.
+ *   @param idEvent
+ * The ID of the event to be triggered. It had been got from rtos_osCreateEvent(). Pass
+ * #RTOS_INVALID_EVENT_ID to disable the notification.
+ *   @param minNoBytesFree
+ * The event is triggered only if at least this number of bytes is free in the ring
+ * buffer. The value is internally limited to the buffer capacity.
+ *   @remark
+ * This function must be called from the OS context only. It is intended for use in the
+ * operating system initialization phase.
+ */
+void sio_osRegisterSpaceAvailableEvent(unsigned int idEvent, unsigned int minNoBytesFree)
+{
+    if(minNoBytesFree > SERIAL_OUTPUT_RING_BUFFER_SIZE-1)
+        minNoBytesFree = SERIAL_OUTPUT_RING_BUFFER_SIZE-1;
+
+    uint32_t msr = rtos_osEnterCriticalSection();
+    {
+        _idEventSpaceAvailable = idEvent;
+        _minNoBytesFreeForEvent = minNoBytesFree;
+        _isSpaceEventRequested = false;
+    }
+    rtos_osLeaveCriticalSection(msr);
+
+} /* End of sio_osRegisterSpaceAvailableEvent */
+
+
+
 /** 
  * System call handler for entry into data output. A byte string is sent through the serial
  * interface. Actually, the bytes are queued for sending and the function is non-blocking. 
@@ -653,7 +1065,7 @@ void sio_osInitSerialInterface(unsigned int baudRate)
  * This function must never be called directly. The function is only made for placing it in
  * the global system call table.
  */
-unsigned int sio_scFlHdlr_writeSerial( uint32_t PID ATTRIB_UNUSED
+unsigned int sio_scFlHdlr_writeSerial( uint32_t PID
                                      , const char *msg
                                      , unsigned int noBytes
                                      )
@@ -670,36 +1082,65 @@ unsigned int sio_scFlHdlr_writeSerial( uint32_t PID ATTRIB_UNUSED
     }
     
     /* After checking the potentially bad user input we may delegate it to the "normal"
-       function implementation. */
-    return sio_osWriteSerial(msg, noBytes);
+       function implementation. The output is routed through the process' output queue. */
+    return writeSerialOfProcess(PID, msg, noBytes, wrMode_truncate);
 
 } /* End of sio_scFlHdlr_writeSerial */
+
+
+
+/**
+ * System call handler for entry into data output with back-pressure. See
+ * sio_osTryWriteSerial() for details.
+ *   @return
+ * The number of queued bytes is returned. The caller is in charge of sending the remaining
+ * bytes later.
+ *   @param PID
+ * The process ID of the calling task.
+ *   @param msg
+ * The byte sequence to send.
+ *   @param noBytes
+ * The number of bytes to send.
+ *   @remark
+ * This function must never be called directly. The function is only made for placing it in
+ * the global system call table.
+ */
+unsigned int sio_scFlHdlr_tryWriteSerial( uint32_t PID
+                                        , const char *msg
+                                        , unsigned int noBytes
+                                        )
+{
+    /* See sio_scFlHdlr_writeSerial() for the pointer validation. */
+    if(!rtos_checkUserCodeReadPtr(msg, noBytes))
+        rtos_osSystemCallBadArgument();
+
+    return writeSerialOfProcess(PID, msg, noBytes, wrMode_backPressure);
+
+} /* End of sio_scFlHdlr_tryWriteSerial */
         
         
 
         
 /** 
- * Principal API function for data output. A byte string is sent through the serial
- * interface. Actually, the bytes are queued for sending and the function is
- * non-blocking.\n
- *   The function can be called from any context. However, it must not be
- * called untill function sio_osInitSerialInterface() has completed.
+ * Implementation of the API functions for data output. A byte string is queued for sending
+ * through the serial interface. The function is non-blocking.
  *   @return
- * The number of queued bytes is returned. Normally, this is the same value as argument \a
- * noBytes. However, the byte sequence can be longer than the currently available space in
- * the send buffer. (Its size is fixed and no reallocation strategy is implemented.) The
- * tranmitted message will be truncated if the return value is less than function argument
- * \a noBytes.
+ * The number of queued bytes is returned. It is less than \a noBytes if the currently
+ * available space in the ring buffer doesn't suffice.
  *   @param msg
- * The byte sequence to send. Note, this may be but is not necessarily a C string with zero
- * terminations. Zero bytes can be send, too.
+ * The byte sequence to send.
  *   @param noBytes
- * The number of bytes to send. For a C string, this will mostly be \a strlen(msg).
- *   @remark
- * This function must be called by trusted code in supervisor mode only. It belongs to the
- * sphere of trusted code itself.
+ * The number of bytes to send.
+ *   @param mode
+ * If \a wrMode_truncate then a message is truncated if it doesn't fit and the loss of bytes
+ * is counted. Otherwise the loss is not counted; the caller is in charge of sending the
+ * remaining bytes later. In mode \a wrMode_backPressure, the event registered with
+ * sio_osRegisterSpaceAvailableEvent() is requested, too.
  */
-unsigned int sio_osWriteSerial(const char *msg, unsigned int noBytes)
+static unsigned int writeSerial( const char *msg
+                               , unsigned int noBytes
+                               , writeMode_t mode
+                               )
 {
     /* Do not interfere with a (possibly) running DMA transfer if we don't really need to
        do anything. */
@@ -737,12 +1178,23 @@ unsigned int sio_osWriteSerial(const char *msg, unsigned int noBytes)
         const unsigned int noBytesFree =
                                 MODULO(idxEndOfFreeSpaceM - _serialOutRingBufIdxWrM - 1);
          
-        /* Avoid buffer overrun by saturation of the user demand and report the number of
-           overrun events and the number of lost message characters. */
+        /* Avoid buffer overrun by saturation of the user demand. In normal mode, report
+           the number of overrun events and the number of lost message characters. With
+           back-pressure, the caller keeps the remainder; nothing is lost but we request
+           the notification, when the caller can continue. */
         if(noBytes > noBytesFree)
         {
-            ++ sio_serialOutNoTruncatedMsgs;
-            sio_serialOutNoLostMsgBytes += noBytes - noBytesFree;
+            if(mode == wrMode_truncate)
+            {
+                ++ sio_serialOutNoTruncatedMsgs;
+                sio_serialOutNoLostMsgBytes += noBytes - noBytesFree;
+            }
+            else if(mode == wrMode_backPressure)
+            {
+                ++ sio_serialOutNoBackPressureWrites;
+                if(_idEventSpaceAvailable != RTOS_INVALID_EVENT_ID)
+                    _isSpaceEventRequested = true;
+            }
             noBytes = noBytesFree;
         }
         
@@ -786,6 +1238,8 @@ unsigned int sio_osWriteSerial(const char *msg, unsigned int noBytes)
            situation of not writing any new character. */
         const uint32_t noBytesPending = MODULO(_serialOutRingBufIdxWrM - idxEndOfFreeSpaceM);
         assert(noBytesPending > 0);
+        if(noBytesPending > sio_serialOutHighWaterMark)
+            sio_serialOutHighWaterMark = noBytesPending;
     
         /* Set the number of bytes to transfer to the UART by DMA.
              Note, here we have a problem with the NXP support file MPC5643L.h. The
@@ -804,6 +1258,15 @@ unsigned int sio_osWriteSerial(const char *msg, unsigned int noBytes)
         EDMA.CHANNEL[DMA_CHN_FOR_SERIAL_OUTPUT].TCDWORD20_.R =
                                                     ((noBytesPending & 0x7fff) << 16) | doff;
 
+        /* The completion interrupts are required only while a writer waits for space or
+           while the process output queues hold data. We request them at half and at the
+           end of the now started transfer. The latter guarantees that a request is
+           served at latest when the buffer has been emptied. */
+        _isDmaIrqEnabled = _isSpaceEventRequested  ||  _noBytesInPrcQueues > 0;
+        const unsigned int enableIrq = _isDmaIrqEnabled? 1u: 0u;
+        EDMA.CHANNEL[DMA_CHN_FOR_SERIAL_OUTPUT].TCDWORD28_.B.INT_HALF = enableIrq;
+        EDMA.CHANNEL[DMA_CHN_FOR_SERIAL_OUTPUT].TCDWORD28_.B.INT_MAJ = enableIrq;
+
         /* Enable the DMA channel to accept the UART's requests for bytes. This
            initiates or resumes the DMA transfer.
              NOP, 0x80: 1: Ignore write to register (to permit 32 Bit access to more
@@ -819,10 +1282,691 @@ unsigned int sio_osWriteSerial(const char *msg, unsigned int noBytes)
     
     return noBytes;
     
+} /* End of writeSerial */
+
+
+
+/**
+ * Enable the completion interrupts of the DMA transfer if not yet done. They are required
+ * as long as the process output queues hold data.
+ *   @remark
+ * This function must be called from inside a critical section.
+ */
+static void enableDmaIrq(void)
+{
+    if(!_isDmaIrqEnabled)
+    {
+        /* Coherently stop the DMA channel, see writeSerial(). */
+        while((EDMA.DMAHRSL.R & (0x1<<DMA_CHN_FOR_SERIAL_OUTPUT)) != 0)
+        {}
+        EDMA.DMACERQ.R = DMA_CHN_FOR_SERIAL_OUTPUT;
+        
+        EDMA.CHANNEL[DMA_CHN_FOR_SERIAL_OUTPUT].TCDWORD28_.B.INT_HALF = 1;
+        EDMA.CHANNEL[DMA_CHN_FOR_SERIAL_OUTPUT].TCDWORD28_.B.INT_MAJ = 1;
+        _isDmaIrqEnabled = true;
+
+        /* Resume the transfer if it has not completed yet. A completed transfer must not
+           be re-enabled, this would repeat the major loop. Instead, the meanwhile emptied
+           ring buffer is refilled from the queues, which starts a new transfer. */
+        if(getNoBytesFree() < SERIAL_OUTPUT_RING_BUFFER_SIZE-1)
+            EDMA.DMASERQ.R = DMA_CHN_FOR_SERIAL_OUTPUT;
+        else
+            flushPrcQueues();
+    }
+} /* End of enableDmaIrq */
+
+
+
+/**
+ * Get the number of bytes, which are currently buffered in the output queue of a process.
+ *   @return
+ * Get the number of bytes.
+ *   @param pQ
+ * The queue to inspect.
+ */
+static inline unsigned int getNoBytesInPrcQueue(const prcOutputQueue_t * const pQ)
+{
+    return pQ->idxWr >= pQ->idxRd? pQ->idxWr - pQ->idxRd
+                                 : pQ->size - pQ->idxRd + pQ->idxWr;
+
+} /* End of getNoBytesInPrcQueue */
+
+
+
+/**
+ * Append bytes to the output queue of a process as far as it has room.
+ *   @return
+ * Get the number of queued bytes, 0..\a noBytes.
+ *   @param PID
+ * The ID of the owning process, 1..#RTOS_NO_PROCESSES.
+ *   @param msg
+ * The bytes to append.
+ *   @param noBytes
+ * The number of bytes to append.
+ *   @remark
+ * This function must be called from inside a critical section.
+ */
+static unsigned int enqueue(unsigned int PID, const char *msg, unsigned int noBytes)
+{
+    prcOutputQueue_t * const pQ = &_prcQueueAry[PID-1];
+    const unsigned int noBytesFree = pQ->size - 1 - getNoBytesInPrcQueue(pQ);
+    if(noBytes > noBytesFree)
+        noBytes = noBytesFree;
+
+    /* One or two copy operations are required depending on wrapping at the end of the
+       linear memory area. */
+    const unsigned int noBytesTillEnd = pQ->size - pQ->idxWr
+                     , noBytesAtEnd = noBytes <= noBytesTillEnd? noBytes: noBytesTillEnd;
+    memcpy(&pQ->pBuf[pQ->idxWr], msg, noBytesAtEnd);
+    if(noBytes > noBytesAtEnd)
+        memcpy(&pQ->pBuf[0], msg+noBytesAtEnd, noBytes-noBytesAtEnd);
+
+    pQ->idxWr += noBytes;
+    if(pQ->idxWr >= pQ->size)
+        pQ->idxWr -= pQ->size;
+    _noBytesInPrcQueues += noBytes;
+
+    const unsigned int noBytesInQueue = getNoBytesInPrcQueue(pQ);
+    if(noBytesInQueue > sio_serialOutPrcQueueHighWaterMarkAry[PID])
+        sio_serialOutPrcQueueHighWaterMarkAry[PID] = noBytesInQueue;
+
+    return noBytes;
+
+} /* End of enqueue */
+
+
+
+/**
+ * Move bytes from the output queue of a process into the DMA ring buffer.
+ *   @return
+ * Get \a true if the ring buffer is full, i.e. if not all requested bytes could be moved.
+ *   @param pQ
+ * The queue to serve.
+ *   @param maxNoBytes
+ * The function moves up to this number of bytes.
+ *   @remark
+ * This function must be called from inside a critical section.
+ */
+static bool flushPrcQueue(prcOutputQueue_t * const pQ, unsigned int maxNoBytes)
+{
+    while(maxNoBytes > 0  &&  pQ->idxRd != pQ->idxWr)
+    {
+        /* Copy the contiguous chunk up to the write position or to the end of the linear
+           memory area. */
+        unsigned int noBytesChunk = pQ->idxWr > pQ->idxRd? pQ->idxWr - pQ->idxRd
+                                                         : pQ->size - pQ->idxRd;
+        if(noBytesChunk > maxNoBytes)
+            noBytesChunk = maxNoBytes;
+        
+        const unsigned int noBytesWritten = writeSerial( (const char*)&pQ->pBuf[pQ->idxRd]
+                                                       , noBytesChunk
+                                                       , wrMode_polling
+                                                       );
+        pQ->idxRd += noBytesWritten;
+        if(pQ->idxRd >= pQ->size)
+            pQ->idxRd -= pQ->size;
+        assert(_noBytesInPrcQueues >= noBytesWritten);
+        _noBytesInPrcQueues -= noBytesWritten;
+        maxNoBytes -= noBytesWritten;
+
+        if(noBytesWritten < noBytesChunk)
+            return true;
+    }
+    return false;
+
+} /* End of flushPrcQueue */
+
+
+
+/**
+ * The arbiter of the process output queues. Queued data is moved into the DMA ring buffer
+ * as far as it has room. The order depends on the configuration
+ * #SIO_PRC_OUTPUT_ARBITRATION_WRR; either strictly by process privileges or by weighted
+ * round robin.
+ *   @remark
+ * This function must be called from inside a critical section.
+ */
+static void flushPrcQueues(void)
+{
+    if(_noBytesInPrcQueues == 0)
+        return;
+
+#if SIO_PRC_OUTPUT_ARBITRATION_WRR == 0
+    /* Strict priority: The process with highest privileges is served first. */
+    for(unsigned int PID=RTOS_NO_PROCESSES; PID>0; --PID)
+    {
+        if(flushPrcQueue(&_prcQueueAry[PID-1], /* maxNoBytes */ UINT_MAX))
+            break;
+    }
+#elif SIO_PRC_OUTPUT_ARBITRATION_WRR == 1
+    /* Weighted round robin: In each round, each process gets its share of the ring buffer
+       space. We continue until either all queues are empty or the ring buffer is full. */
+    bool isRingBufferFull = false;
+    while(!isRingBufferFull  &&  _noBytesInPrcQueues > 0)
+    {
+        for(unsigned int PID=RTOS_NO_PROCESSES; PID>0 && !isRingBufferFull; --PID)
+        {
+            isRingBufferFull = flushPrcQueue( &_prcQueueAry[PID-1]
+                                            , /* maxNoBytes */ _prcOutputWeightAry[PID-1]
+                                            );
+        }
+    }
+#else
+# error Invalid configuration of SIO_PRC_OUTPUT_ARBITRATION_WRR
+#endif
+} /* End of flushPrcQueues */
+
+
+
+/**
+ * Data output on behalf of a user process. The process output queue is applied if
+ * configured: The bytes are written directly into the ring buffer if this is possible
+ * without overtaking earlier, still queued output; the rest is put into the process'
+ * output queue. Message truncation or back-pressure take place only if the process' queue
+ * is exhausted, too.
+ *   @return
+ * The number of queued bytes is returned, 0..\a noBytes.
+ *   @param PID
+ * The ID of the writing process, 1..#RTOS_NO_PROCESSES.
+ *   @param msg
+ * The byte sequence to send.
+ *   @param noBytes
+ * The number of bytes to send.
+ *   @param mode
+ * The behavior if not all bytes can be queued, either \a wrMode_truncate or \a
+ * wrMode_backPressure.
+ */
+static unsigned int writeSerialOfProcess( unsigned int PID
+                                        , const char *msg
+                                        , unsigned int noBytes
+                                        , writeMode_t mode
+                                        )
+{
+    assert(PID >= 1  &&  PID <= RTOS_NO_PROCESSES);
+    const prcOutputQueue_t * const pQ = &_prcQueueAry[PID-1];
+    
+    /* Without a queue we have the normal output straight into the ring buffer. */
+    if(pQ->size <= 1)
+        return writeSerial(msg, noBytes, mode);
+        
+    if(noBytes == 0)
+        return 0;
+
+    unsigned int noBytesQueued = 0;
+    uint32_t msr = rtos_osEnterCriticalSection();
+    {
+        /* Give queued output of other processes the chance to go first. */
+        flushPrcQueues();
+        
+        /* Direct output is possible only if no earlier output of the same process is still
+           waiting in the queue. */
+        if(pQ->idxRd == pQ->idxWr)
+            noBytesQueued = writeSerial(msg, noBytes, wrMode_polling);
+
+        if(noBytesQueued < noBytes)
+        {
+            noBytesQueued += enqueue(PID, msg+noBytesQueued, noBytes-noBytesQueued);
+            if(noBytesQueued < noBytes)
+            {
+                if(mode == wrMode_truncate)
+                {
+                    ++ sio_serialOutNoTruncatedMsgs;
+                    ++ sio_serialOutPrcNoTruncatedMsgsAry[PID];
+                    sio_serialOutNoLostMsgBytes += noBytes - noBytesQueued;
+                    sio_serialOutPrcNoLostMsgBytesAry[PID] += noBytes - noBytesQueued;
+                }
+                else
+                {
+                    assert(mode == wrMode_backPressure);
+                    ++ sio_serialOutNoBackPressureWrites;
+                    if(_idEventSpaceAvailable != RTOS_INVALID_EVENT_ID)
+                        _isSpaceEventRequested = true;
+                }
+            }
+            
+            /* The queue is not empty, we need the DMA interrupt for the arbiter. */
+            enableDmaIrq();
+        }
+    }
+    rtos_osLeaveCriticalSection(msr);
+
+    return noBytesQueued;
+
+} /* End of writeSerialOfProcess */
+
+
+
+/**
+ * Put the LINFlexD device into initialization mode and wait until the mode is entered.
+ * This is the prerequisite of changing the Baud rate or the buffer modes.
+ *   @remark
+ * This function must be called from inside a critical section.
+ */
+static void enterInitMode(void)
+{
+    /* INIT, 0x1: 1 init mode, 0 normal operation or sleep */
+    LINFLEX.LINCR1.R = 0x1;
+    while((LINFLEX.LINSR.R & 0xf000) != 0x1000 /* initialization mode*/)
+    {}
+} /* End of enterInitMode */
+
+
+
+/**
+ * Wait until all serial output has been transmitted and enter a critical section. On
+ * return, the ring buffer is empty, the DMA is idle and the last character has left the
+ * transmitter. No other context can queue new output until the critical section is left
+ * again.
+ *   @return
+ * Get the machine status as required for leaving the critical section with
+ * rtos_osLeaveCriticalSection().
+ *   @remark
+ * This function must not be called from an ISR or with suspended interrupts; it can take
+ * a long time to return.
+ */
+static uint32_t waitForTxIdleAndLock(void)
+{
+    while(true)
+    {
+        /* Wait for the ring buffer becoming empty. */
+        while(getNoBytesFree() < SERIAL_OUTPUT_RING_BUFFER_SIZE-1)
+        {}
+        
+        /* The LINFlexD doesn't indicate the empty TX FIFO. We wait for the transmission
+           time of the FIFO contents and the character in the shift register, 4+1
+           characters of 10 Bit. */
+        const unsigned long noDMATransfers = sio_serialOutNoDMATransfers;
+        const uint64_t tiEnd = GSL_PPC_GET_TIMEBASE()
+                               + RTOS_TI_US2TICKS(5u*(10000000u/_actualBaudRate + 1u));
+        while(GSL_PPC_GET_TIMEBASE() < tiEnd)
+        {}
+
+        /* Another context may have written meanwhile. We can't know without locking. */
+        const uint32_t msr = rtos_osEnterCriticalSection();
+        if(noDMATransfers == sio_serialOutNoDMATransfers
+           &&  (EDMA.DMAHRSL.R & (0x1<<DMA_CHN_FOR_SERIAL_OUTPUT)) == 0
+          )
+        {
+            return msr;
+        }
+        rtos_osLeaveCriticalSection(msr);
+    }
+} /* End of waitForTxIdleAndLock */
+
+
+
+/** 
+ * Principal API function for data output. A byte string is sent through the serial
+ * interface. Actually, the bytes are queued for sending and the function is
+ * non-blocking.\n
+ *   The function can be called from any context. However, it must not be
+ * called untill function sio_osInitSerialInterface() has completed.
+ *   @return
+ * The number of queued bytes is returned. Normally, this is the same value as argument \a
+ * noBytes. However, the byte sequence can be longer than the currently available space in
+ * the send buffer. (Its size is fixed and no reallocation strategy is implemented.) The
+ * tranmitted message will be truncated if the return value is less than function argument
+ * \a noBytes.
+ *   @param msg
+ * The byte sequence to send. Note, this may be but is not necessarily a C string with zero
+ * terminations. Zero bytes can be send, too.
+ *   @param noBytes
+ * The number of bytes to send. For a C string, this will mostly be \a strlen(msg).
+ *   @remark
+ * This function must be called by trusted code in supervisor mode only. It belongs to the
+ * sphere of trusted code itself.
+ */
+unsigned int sio_osWriteSerial(const char *msg, unsigned int noBytes)
+{
+    return writeSerial(msg, noBytes, wrMode_truncate);
+
 } /* End of sio_osWriteSerial */
 
 
 
+/** 
+ * API function for data output with back-pressure. A byte string is queued for sending
+ * through the serial interface as far as there is space in the send buffer. Other than
+ * sio_osWriteSerial(), the function doesn't truncate the message: The caller is informed
+ * about the number of actually queued bytes and is in charge of sending the remainder
+ * later.\n
+ *   The intended use case are tasks of low priority, which need to output larger amounts
+ * of data. Since a task can't block, it'll return after a partial write and it'll
+ * continue, when it is re-activated by the event, which had been registered with
+ * sio_osRegisterSpaceAvailableEvent().\n
+ *   The function can be called from any context. However, it must not be
+ * called untill function sio_osInitSerialInterface() has completed.
+ *   @return
+ * The number of queued bytes is returned. It is in the range 0..\a noBytes.
+ *   @param msg
+ * The byte sequence to send.
+ *   @param noBytes
+ * The number of bytes to send.
+ *   @remark
+ * This function must be called by trusted code in supervisor mode only. It belongs to the
+ * sphere of trusted code itself.
+ */
+unsigned int sio_osTryWriteSerial(const char *msg, unsigned int noBytes)
+{
+    return writeSerial(msg, noBytes, wrMode_backPressure);
+
+} /* End of sio_osTryWriteSerial */
+
+
+
+/** 
+ * API function for blocking data output. A byte string is sent through the serial
+ * interface. The function waits until all bytes have been queued in the send buffer; no
+ * byte is lost. Waiting is done by busy polling the progress of the DMA transfer.\n
+ *   The function is intended for bulk output from the idle task or from other contexts of
+ * lowest priority. Contexts of higher priority should stay with the non-blocking
+ * sio_osWriteSerial().\n
+ *   The function must not be called untill function sio_osInitSerialInterface() has
+ * completed.
+ *   @param msg
+ * The byte sequence to send.
+ *   @param noBytes
+ * The number of bytes to send.
+ *   @remark
+ * This function must be called by trusted code in supervisor mode only. It must not be
+ * called from an ISR or with suspended interrupts, which is double-checked by assertion.
+ */
+void sio_osWriteSerialBlocking(const char *msg, unsigned int noBytes)
+{
+    assert(!rtos_osIsInterrupt() &&  !rtos_osGetAllInterruptsSuspended());
+
+    while(true)
+    {
+        /* Waiting for space is done by polling here, we don't request the space available
+           event. */
+        const unsigned int noBytesQueued = writeSerial(msg, noBytes, wrMode_polling);
+        assert(noBytesQueued <= noBytes);
+        msg += noBytesQueued;
+        noBytes -= noBytesQueued;
+        if(noBytes == 0)
+            break;
+
+        /* Wait until a reasonable portion of the buffer is free again. Waiting for a quarter
+           of the buffer avoids many small, inefficient write operations. */
+        const unsigned int minNoBytesFree = noBytes < SERIAL_OUTPUT_RING_BUFFER_SIZE/4
+                                            ? noBytes
+                                            : SERIAL_OUTPUT_RING_BUFFER_SIZE/4;
+        while(getNoBytesFree() < minNoBytesFree)
+        {}
+    }
+} /* End of sio_osWriteSerialBlocking */
+
+
+
+/**
+ * Get the accuracy of a Baud rate. The LINFlexD generates the Baud rate with a fractional
+ * divider of 1/16 resolution from the peripheral clock. Not all Baud rates can be
+ * generated exactly, and the error grows with the Baud rate. This function can be used to
+ * check a Baud rate before switching to it. As a rule of thumb, an error of less than 2%
+ * (20000 ppm) is required for a reliable communication.
+ *   @return
+ * Get the actually achieved Baud rate in Hz.
+ *   @param baudRate
+ * The wanted Baud rate in Hz. The range is #SIO_MIN_BAUD_RATE .. #SIO_MAX_BAUD_RATE. Other
+ * values are saturated.
+ *   @param pDeviationInPpm
+ * If not NULL then the relative deviation of the achieved from the wanted Baud rate is
+ * returned in * \a pDeviationInPpm, in units of 1e-6.
+ *   @remark
+ * This function can be called from any OS context.
+ */
+unsigned int sio_osGetBaudRateAccuracy(unsigned int baudRate, signed int *pDeviationInPpm)
+{
+    if(baudRate < SIO_MIN_BAUD_RATE)
+        baudRate = SIO_MIN_BAUD_RATE;
+    else if(baudRate > SIO_MAX_BAUD_RATE)
+        baudRate = SIO_MAX_BAUD_RATE;
+
+    unsigned int IBR ATTRIB_UNUSED, FBR ATTRIB_UNUSED;
+    const unsigned int actualBaudRate = computeBaudRateDivider(&IBR, &FBR, baudRate);
+    if(pDeviationInPpm != NULL)
+    {
+        *pDeviationInPpm = (signed int)(((int64_t)actualBaudRate - (int64_t)baudRate)
+                                        * 1000000 / (int64_t)baudRate
+                                       );
+    }
+    return actualBaudRate;
+
+} /* End of sio_osGetBaudRateAccuracy */
+
+
+
+/**
+ * Get the currently configured Baud rate.
+ *   @return
+ * Get the actually applied Baud rate in Hz.
+ *   @param pDeviationInPpm
+ * If not NULL then the relative deviation of the applied from the requested Baud rate is
+ * returned in * \a pDeviationInPpm, in units of 1e-6. See sio_osGetBaudRateAccuracy().
+ *   @remark
+ * This function can be called from any OS context.
+ */
+unsigned int sio_osGetBaudRate(signed int *pDeviationInPpm)
+{
+    return sio_osGetBaudRateAccuracy(_baudRate, pDeviationInPpm);
+
+} /* End of sio_osGetBaudRate */
+
+
+
+/**
+ * Change the Baud rate of the serial interface at run-time. The function waits until all
+ * pending output has been transmitted, then it reprograms the divider of the LINFlexD.
+ *   @return
+ * Get \a true if the Baud rate has been changed or \a false if \a baudRate is out of
+ * range.
+ *   @param baudRate
+ * The new Baud rate in Hz. The range is #SIO_MIN_BAUD_RATE .. #SIO_MAX_BAUD_RATE. Check
+ * the accuracy with sio_osGetBaudRateAccuracy() before. Note, the OpenSDA bridge of the
+ * evaluation board TRK-USB-MPC5643L has proven to be reliable only up to 115200 Bd.
+ *   @remark
+ * Characters, which are being received during the change, can be corrupted.
+ *   @remark
+ * This function must be called from OS context but not from an ISR or with suspended
+ * interrupts. It waits for the completion of all pending output, which can take a long
+ * time. Use it from the idle task.
+ */
+bool sio_osChangeBaudRate(unsigned int baudRate)
+{
+    assert(!rtos_osIsInterrupt() &&  !rtos_osGetAllInterruptsSuspended());
+    if(baudRate < SIO_MIN_BAUD_RATE  ||  baudRate > SIO_MAX_BAUD_RATE)
+        return false;
+
+    unsigned int IBR, FBR;
+    const unsigned int actualBaudRate = computeBaudRateDivider(&IBR, &FBR, baudRate);
+    
+    uint32_t msr = waitForTxIdleAndLock();
+    {
+        enterInitMode();
+        LINFLEX.LINIBRR.B.IBR = IBR;
+        LINFLEX.LINFBRR.B.FBR = FBR;
+        _baudRate = baudRate;
+        _actualBaudRate = actualBaudRate;
+        
+        /* INIT, 0x1: 0, back to normal operation */
+        LINFLEX.LINCR1.R = 0x0;
+    }
+    rtos_osLeaveCriticalSection(msr);
+    
+    return true;
+
+} /* End of sio_osChangeBaudRate */
+
+
+
+/**
+ * Change the Baud rate in agreement with the host. This function implements the target
+ * side of a simple protocol:\n
+ *   - The target announces the change with a line "$BAUD <rate>" at the current Baud rate,
+ * where <rate> is the actually achieved Baud rate, see sio_osGetBaudRateAccuracy()\n
+ *   - The target switches to the new Baud rate as soon as the line has been transmitted\n
+ *   - The host switches, too, and confirms with a line "OK" at the new Baud rate\n
+ *   - The target acknowledges with "$BAUD OK". If the host doesn't confirm within the
+ * timeout then the target returns to the previous Baud rate and reports "$BAUD FAIL"
+ *   @return
+ * Get \a true if the Baud rate has been changed or \a false if the host didn't confirm the
+ * new rate or if \a baudRate is out of range.
+ *   @param baudRate
+ * The new Baud rate in Hz. The range is #SIO_MIN_BAUD_RATE .. #SIO_MAX_BAUD_RATE.
+ *   @param tiTimeoutInMs
+ * The time the host has to confirm the new rate in Milliseconds.
+ *   @remark
+ * The function consumes all serial input, which arrives in the time of waiting for the
+ * host's confirmation.
+ *   @remark
+ * This function must be called from OS context but not from an ISR or with suspended
+ * interrupts. It waits for the confirmation by busy polling. Use it from the idle task.
+ */
+bool sio_osNegotiateBaudRate(unsigned int baudRate, unsigned int tiTimeoutInMs)
+{
+    assert(!rtos_osIsInterrupt() &&  !rtos_osGetAllInterruptsSuspended());
+    if(baudRate < SIO_MIN_BAUD_RATE  ||  baudRate > SIO_MAX_BAUD_RATE)
+        return false;
+
+    const unsigned int oldBaudRate = _baudRate;
+    char msg[40];
+    const int noChars = sniprintf( msg, sizeof(msg)
+                                 , "\r\n" SIO_BAUD_RATE_CMD " %u\r\n"
+                                 , sio_osGetBaudRateAccuracy(baudRate, NULL)
+                                 );
+    assert(noChars > 0  &&  (unsigned)noChars < sizeof(msg));
+    sio_osWriteSerialBlocking(msg, (unsigned)noChars);
+
+    /* Switch and discard all input, which had been received at the old rate. */
+#ifdef DEBUG
+    const bool success =
+#endif
+    sio_osChangeBaudRate(baudRate);
+    assert(success);
+    uint32_t msr = rtos_osEnterCriticalSection();
+    {
+        _pRdSerialInRingBuf = _pWrSerialInRingBuf;
+        _serialInNoEOL = 0;
+    }
+    rtos_osLeaveCriticalSection(msr);
+
+    /* Poll for the host's confirmation. */
+    bool isConfirmed = false;
+    const uint64_t tiEnd = GSL_PPC_GET_TIMEBASE()
+                           + (uint64_t)tiTimeoutInMs * RTOS_TI_MS2TICKS(1u);
+    while(!isConfirmed &&  GSL_PPC_GET_TIMEBASE() < tiEnd)
+    {
+        char line[sizeof(SIO_BAUD_RATE_ACK)+1];
+        if(sio_osGetLine(line, sizeof(line)) != NULL)
+            isConfirmed = strcmp(line, SIO_BAUD_RATE_ACK) == 0;
+    }
+    
+    if(isConfirmed)
+        sio_osWriteSerialBlocking(SIO_STR($BAUD OK));
+    else
+    {
+        sio_osChangeBaudRate(oldBaudRate);
+        sio_osWriteSerialBlocking(SIO_STR($BAUD FAIL));
+    }
+    
+    return isConfirmed;
+
+} /* End of sio_osNegotiateBaudRate */
+
+
+
+/**
+ * Self-test of the serial interface in loopback mode. The LINFlexD is temporarily
+ * configured for internal loopback: The transmitter is internally connected to the
+ * receiver and the TX pin is held in idle state. A test pattern is sent at the given Baud
+ * rate and the received characters are compared.\n
+ *   All pending output is transmitted before the test. Output, which is written during
+ * the test, is delayed until the end of the test. Serial input, which arrives during the
+ * test, is lost.
+ *   @return
+ * Get \a true if all test characters were received correctly and in time.
+ *   @param baudRate
+ * The Baud rate to test in Hz. The range is #SIO_MIN_BAUD_RATE .. #SIO_MAX_BAUD_RATE. The
+ * current Baud rate is not changed.
+ *   @remark
+ * This function must be called from OS context but not from an ISR or with suspended
+ * interrupts. Use it from the idle task.
+ */
+bool sio_osRunLoopbackSelfTest(unsigned int baudRate)
+{
+    assert(!rtos_osIsInterrupt() &&  !rtos_osGetAllInterruptsSuspended());
+    if(baudRate < SIO_MIN_BAUD_RATE  ||  baudRate > SIO_MAX_BAUD_RATE)
+        return false;
+
+    unsigned int IBR, FBR;
+    const unsigned int actualBaudRate = computeBaudRateDivider(&IBR, &FBR, baudRate);
+    
+    /* Disconnect DMA and reception interrupt from the device and enter loopback mode. TX
+       is switched to buffer mode, which lets us poll the device character by character. */
+    uint32_t msr = waitForTxIdleAndLock();
+    {
+        LINFLEX.DMATXE.R = 0x0;
+        LINFLEX.LINIER.B.DRIE = 0;
+        enterInitMode();
+        LINFLEX.UARTCR.R = 0x0033; /* TX and RX buffer mode, 1 Byte, 8bit data, no parity,
+                                      TX and RX enabled, UART mode */
+        LINFLEX.LINIBRR.B.IBR = IBR;
+        LINFLEX.LINFBRR.B.FBR = FBR;
+        LINFLEX.UARTSR.R = 0x0000ffafu;
+        
+        /* LBKM, 0x20: Loopback mode, INIT, 0x1: 0, normal operation */
+        LINFLEX.LINCR1.R = 0x20;
+    }
+    rtos_osLeaveCriticalSection(msr);
+
+    /* A character takes 10 Bit. We permit twice the time before we report a failure. */
+    const uint32_t tiTimeout = RTOS_TI_US2TICKS(2u*(10000000u/actualBaudRate + 1u));
+    static const uint8_t testPatternAry[] = {0x55, 0xaa, 0x00, 0xff, 0x0f, 0xf0, 0x5a, 0xa5};
+    bool success = true;
+    for(unsigned int u=0; success && u<sizeof(testPatternAry); ++u)
+    {
+        LINFLEX.BDRL.B.DATA0 = testPatternAry[u];
+        
+        const uint64_t tiEnd = GSL_PPC_GET_TIMEBASE() + tiTimeout;
+        
+        /* DRF, 0x4: Data reception completed */
+        while((LINFLEX.UARTSR.R & 0x4) == 0  &&  GSL_PPC_GET_TIMEBASE() < tiEnd)
+        {}
+        
+        /* We check reception, data and the error bits FEF, 0x100 and BOF, 0x80. */
+        const uint32_t status = LINFLEX.UARTSR.R;
+        success = (status & (0x4 | 0x100 | 0x80)) == 0x4
+                  &&  LINFLEX.BDRM.B.DATA4 == testPatternAry[u];
+        
+        /* Clear all status bits by w2c access, including the release of the receive
+           buffer. */
+        LINFLEX.UARTSR.R = 0x0000ffafu;
+    }
+
+    /* Return to normal operation with the original settings. */
+    computeBaudRateDivider(&IBR, &FBR, _baudRate);
+    msr = rtos_osEnterCriticalSection();
+    {
+        enterInitMode();
+        LINFLEX.UARTCR.R = 0x0133; /* TX FIFO mode, RX buffer mode, 8bit data, no parity, Tx
+                                      enabled, UART mode stays set */
+        LINFLEX.LINIBRR.B.IBR = IBR;
+        LINFLEX.LINFBRR.B.FBR = FBR;
+        LINFLEX.UARTSR.R = 0x0000ffafu;
+        LINFLEX.LINIER.B.DRIE = 1;
+        LINFLEX.LINCR1.R = 0x0;
+        
+        /* Output, which has been queued during the test, is sent now. */
+        LINFLEX.DMATXE.R = 0x1;
+    }
+    rtos_osLeaveCriticalSection(msr);
+
+    return success;
+
+} /* End of sio_osRunLoopbackSelfTest */
+
+
+
 
 /**
  * Application API function to read a single character from serial input or EOF if there's
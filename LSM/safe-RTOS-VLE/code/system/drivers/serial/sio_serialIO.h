@@ -37,6 +37,25 @@
 /** Index of system call for writing into serial output. */
 #define SIO_SYSCALL_WRITE_SERIAL    20
 
+/** Index of system call for writing into serial output with back-pressure. */
+#define SIO_SYSCALL_TRY_WRITE_SERIAL    21
+
+/** The minimum Baud rate, which can be configured. */
+#define SIO_MIN_BAUD_RATE   10u
+
+/** The maximum Baud rate, which can be configured. The LINFlexD would permit up to 7.5
+    MBd but the fractional divider becomes too coarse and the OpenSDA bridge of the
+    evaluation board is anyway much slower. */
+#define SIO_MAX_BAUD_RATE   1000000u
+
+/** The protocol of sio_osNegotiateBaudRate(): The target announces a change of the Baud
+    rate with this command, followed by the new rate in Hz. */
+#define SIO_BAUD_RATE_CMD   "$BAUD"
+
+/** The protocol of sio_osNegotiateBaudRate(): The host confirms a change of the Baud rate
+    with this line of text, sent at the new rate. */
+#define SIO_BAUD_RATE_ACK   "OK"
+
 /** A trivial helper for the use of sio_osWriteSerial() with literal strings: The typical
     double use of the string literal in the argument list of the function, once as such,
     once to calculate its length, is encapsulated in a macro. The readability of the source
@@ -89,6 +108,26 @@ extern volatile unsigned long sio_serialOutNoLostMsgBytes;
     sio_serialOutNoLostMsgBytes. */ 
 extern volatile unsigned long sio_serialInLostBytes;
 
+/** The maximum number of bytes, which had ever been pending for transmission in the output
+    ring buffer since power-up. */
+extern volatile unsigned long sio_serialOutHighWaterMark;
+
+/** The number of write operations with back-pressure, which could not queue the entire
+    message. */
+extern volatile unsigned long sio_serialOutNoBackPressureWrites;
+
+/** The number of messages per process, which underwent truncation since power-up. Index is
+    the PID, entry 0 is unused. */
+extern volatile unsigned long sio_serialOutPrcNoTruncatedMsgsAry[1+RTOS_NO_PROCESSES];
+
+/** The number of lost message characters per process since power-up. Index is the PID,
+    entry 0 is unused. */
+extern volatile unsigned long sio_serialOutPrcNoLostMsgBytesAry[1+RTOS_NO_PROCESSES];
+
+/** The maximum fill level of the output queue of each process since power-up. Index is the
+    PID, entry 0 is unused. */
+extern volatile unsigned long sio_serialOutPrcQueueHighWaterMarkAry[1+RTOS_NO_PROCESSES];
+
 #ifdef DEBUG
 /** Count all input characters received since last reset. This variable is support in DEBUG
     compilation only. */
@@ -103,9 +142,33 @@ extern volatile unsigned long sio_serialInNoRxBytes;
 /** Module initialization. Configure the I/O devices for serial output. */
 void sio_osInitSerialInterface(unsigned int baudRate);
 
+/** Register the event to notify a back-pressured writer about free space. */
+void sio_osRegisterSpaceAvailableEvent(unsigned int idEvent, unsigned int minNoBytesFree);
+
 /** Write a character string into the serial interface. Can be called from OS context. */
 unsigned int sio_osWriteSerial(const char *msg, unsigned int noBytes);
 
+/** Write into the serial interface as far as there is space; no truncation. */
+unsigned int sio_osTryWriteSerial(const char *msg, unsigned int noBytes);
+
+/** Write into the serial interface; wait for space if required. Idle task only. */
+void sio_osWriteSerialBlocking(const char *msg, unsigned int noBytes);
+
+/** Get the actually achieved Baud rate and its error for a wanted Baud rate. */
+unsigned int sio_osGetBaudRateAccuracy(unsigned int baudRate, signed int *pDeviationInPpm);
+
+/** Get the currently applied Baud rate and its error. */
+unsigned int sio_osGetBaudRate(signed int *pDeviationInPpm);
+
+/** Change the Baud rate at run-time. Idle task only. */
+bool sio_osChangeBaudRate(unsigned int baudRate);
+
+/** Change the Baud rate in agreement with the host. Idle task only. */
+bool sio_osNegotiateBaudRate(unsigned int baudRate, unsigned int tiTimeoutInMs);
+
+/** Self-test of the serial interface in loopback mode. Idle task only. */
+bool sio_osRunLoopbackSelfTest(unsigned int baudRate);
+
 /** Application API function to read a single character from serial input. */
 signed int sio_osGetChar(void);
 
@@ -120,6 +183,9 @@ char *sio_osGetLine(char buf[], unsigned int sizeOfBuf);
 /** 
  * Principal API function for data output. A byte string is sent through the serial
  * interface. Actually, the bytes are queued for sending and the function is non-blocking. 
+ *   The output of each process is queued in a process owned buffer before it is moved
+ * into the common send buffer. Output of one process can't drown the output of another
+ * one.
  *   @return
  * The number of queued bytes is returned. Normally, this is the same value as argument \a
  * noBytes. However, the byte sequence can be longer than the currently available space in
@@ -145,6 +211,31 @@ static inline unsigned int sio_writeSerial(const char *msg, unsigned int noBytes
 } /* End of sio_writeSerial */
 
 
+
+/** 
+ * API function for data output with back-pressure. A byte string is queued for sending
+ * through the serial interface as far as there is space in the send buffer. Bytes, which
+ * don't fit are not lost but not queued and the caller is in charge of sending them later.
+ * See sio_osTryWriteSerial() for more details.
+ *   @return
+ * The number of queued bytes is returned. It is in the range 0..\a noBytes.
+ *   @param msg
+ * The byte sequence to send. The memory region spawn by \a msg and \a noBytes must be
+ * entirely inside the used portions of RAM and ROM. Any attempt to print other data will
+ * be punished with task abortion.
+ *   @param noBytes
+ * The number of bytes to send.
+ *   @remark
+ * This function must be called from the user task context only. Any attempt to use it from 
+ * OS code will lead to undefined behavior.
+ */
+static inline unsigned int sio_tryWriteSerial(const char *msg, unsigned int noBytes)
+{
+    return rtos_systemCall(SIO_SYSCALL_TRY_WRITE_SERIAL, msg, noBytes);
+
+} /* End of sio_tryWriteSerial */
+
+
 #endif  /* SIO_SERIALIO_INCLUDED */
 
 
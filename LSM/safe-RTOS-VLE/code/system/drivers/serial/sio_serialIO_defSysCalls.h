@@ -50,6 +50,16 @@
 # define RTOS_SYSCALL_TABLE_ENTRY_0020    RTOS_SYSCALL_DUMMY_TABLE_ENTRY
 #endif
 
+#ifndef RTOS_SYSCALL_TABLE_ENTRY_0021
+# if SIO_SYSCALL_TRY_WRITE_SERIAL != 21
+#  error Inconsistent definition of system call
+# endif
+# define RTOS_SYSCALL_TABLE_ENTRY_0021  RTOS_SC_TABLE_ENTRY(sio_scFlHdlr_tryWriteSerial, FULL)
+#else
+# error System call 0021 is ambiguously defined
+# define RTOS_SYSCALL_TABLE_ENTRY_0021    RTOS_SYSCALL_DUMMY_TABLE_ENTRY
+#endif
+
 
 /*
  * Global type definitions
@@ -71,4 +81,11 @@ unsigned int sio_scFlHdlr_writeSerial( uint32_t pidOfCallingTask
                                      , unsigned int noBytes
                                      );
 
+/* Preemptable system call implementation to write to the serial interface with
+   back-pressure. */
+unsigned int sio_scFlHdlr_tryWriteSerial( uint32_t pidOfCallingTask
+                                        , const char *msg
+                                        , unsigned int noBytes
+                                        );
+
 #endif  /* SIO_SERIALIO_DEFSYSCALLS_INCLUDED */
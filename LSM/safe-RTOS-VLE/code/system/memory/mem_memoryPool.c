@@ -0,0 +1,301 @@
+/**
+ * @file mem_memoryPool.c
+ * Dynamic memory allocation for the processes of safe-RTOS without use of the heap of the
+ * C library.\n
+ *   Each process can have a memory arena. It's a private RAM area of the process, which is
+ * reserved by the linker (see linkerControlFile.ld, ld_arenaSizeP1, ...) and which is
+ * located in the MPU protected RAM of the process. A process can't corrupt the dynamic
+ * memory of another process. Memory is taken from an arena piece by piece, there's no
+ * release of memory. This fits well to the typical embedded pattern of allocating all
+ * required memory in the initialization phase.\n
+ *   For data objects, which come and go at run-time, the module offers pools of fixed size
+ * blocks. A pool takes its memory from an arena. Blocks are allocated and released in
+ * constant time and without fragmentation.
+ *   @remark
+ * The functions of this module can be used by the tasks of the owning process only. They
+ * are not reentrant: If several tasks of the process use the same arena or pool then they
+ * need to have the same priority or mutual exclusion has to be implemented by the caller,
+ * e.g. with rtos_suspendAllTasksByPriority().
+ *
+ * Copyright (C) 2020 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   mem_allocArena
+ *   mem_getNoBytesFreeArena
+ *   mem_initPool
+ *   mem_allocBlock
+ *   mem_freeBlock
+ * Local functions
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+
+#include "typ_types.h"
+#include "rtos.h"
+#include "mem_memoryPool.h"
+
+
+/*
+ * Defines
+ */
+
+#if RTOS_NO_PROCESSES != 4
+# error Definition of process arenas needs to be adapted to number of processes
+#endif
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/* The linker provided memory areas of the process arenas. */
+extern uint8_t ld_arenaStartP1[0], ld_arenaEndP1[0]
+             , ld_arenaStartP2[0], ld_arenaEndP2[0]
+             , ld_arenaStartP3[0], ld_arenaEndP3[0]
+             , ld_arenaStartP4[0], ld_arenaEndP4[0];
+
+/** The memory arena of process 1. */
+mem_arena_t DATA_P1(mem_arenaP1) =
+    { .pStart = ld_arenaStartP1
+    , .pEnd = ld_arenaEndP1
+    , .pNext = ld_arenaStartP1
+    , .noAllocations = 0
+    , .noFailedAllocations = 0
+    };
+
+/** The memory arena of process 2. */
+mem_arena_t DATA_P2(mem_arenaP2) =
+    { .pStart = ld_arenaStartP2
+    , .pEnd = ld_arenaEndP2
+    , .pNext = ld_arenaStartP2
+    , .noAllocations = 0
+    , .noFailedAllocations = 0
+    };
+
+/** The memory arena of process 3. */
+mem_arena_t DATA_P3(mem_arenaP3) =
+    { .pStart = ld_arenaStartP3
+    , .pEnd = ld_arenaEndP3
+    , .pNext = ld_arenaStartP3
+    , .noAllocations = 0
+    , .noFailedAllocations = 0
+    };
+
+/** The memory arena of process 4. */
+mem_arena_t DATA_P4(mem_arenaP4) =
+    { .pStart = ld_arenaStartP4
+    , .pEnd = ld_arenaEndP4
+    , .pNext = ld_arenaStartP4
+    , .noAllocations = 0
+    , .noFailedAllocations = 0
+    };
+
+/** The arenas of all processes, indexed by PID. Entry 0 is unused. */
+mem_arena_t * const mem_arenaByPIDAry[1+RTOS_NO_PROCESSES] =
+    { [0] = NULL
+    , [1] = &mem_arenaP1
+    , [2] = &mem_arenaP2
+    , [3] = &mem_arenaP3
+    , [4] = &mem_arenaP4
+    };
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Allocate memory from a process arena. The operation is done in constant time.
+ *   @return
+ * Get the pointer to the allocated memory or NULL if the arena is exhausted. The memory is
+ * aligned to #MEM_ALIGNMENT Byte. The memory is not initialized; on first use it contains
+ * zeros.
+ *   @param pArena
+ * The arena to allocate from. It needs to be the arena of the calling process; any attempt
+ * to use another process' arena leads to an exception and abort of the calling task.
+ *   @param noBytes
+ * The number of requested bytes.
+ *   @remark
+ * There's no counterpart to release the memory. Use pools, see mem_initPool(), for
+ * objects, which need to be freed again.
+ */
+void *mem_allocArena(mem_arena_t * const pArena, size_t noBytes)
+{
+    /* Keep all chunks aligned. The rounding must not wrap around. */
+    const bool isSizeOk = noBytes <= SIZE_MAX - (MEM_ALIGNMENT-1u);
+    noBytes = (noBytes + (MEM_ALIGNMENT-1u)) & ~(size_t)(MEM_ALIGNMENT-1u);
+
+    assert(((uintptr_t)pArena->pNext & (MEM_ALIGNMENT-1u)) == 0);
+    if(isSizeOk  &&  noBytes <= (size_t)(pArena->pEnd - pArena->pNext))
+    {
+        void * const pChunk = pArena->pNext;
+        pArena->pNext += noBytes;
+        ++ pArena->noAllocations;
+        return pChunk;
+    }
+    else
+    {
+        ++ pArena->noFailedAllocations;
+        return NULL;
+    }
+} /* End of mem_allocArena */
+
+
+
+/**
+ * Get the number of still unused bytes of a process arena.
+ *   @return
+ * Get the number of bytes.
+ *   @param pArena
+ * The arena. The function can be used for the arenas of all processes.
+ */
+size_t mem_getNoBytesFreeArena(const mem_arena_t * const pArena)
+{
+    return (size_t)(pArena->pEnd - pArena->pNext);
+
+} /* End of mem_getNoBytesFreeArena */
+
+
+
+/**
+ * Create a pool of fixed size blocks. The memory of the pool is taken from the arena of
+ * the calling process.
+ *   @return
+ * Get \a true if the pool could be created or \a false if the arena is exhausted or if
+ * the arguments are invalid. Nothing is taken from the arena in the latter case.
+ *   @param pPool
+ * The pool object to initialize. It needs to be located in the RAM of the calling
+ * process.
+ *   @param pArena
+ * The arena of the calling process.
+ *   @param sizeOfBlock
+ * The size of a block in Byte. It is internally rounded up to a multiple of
+ * #MEM_ALIGNMENT.
+ *   @param noBlocks
+ * The number of blocks of the pool. It needs to be at least one.
+ */
+bool mem_initPool( mem_pool_t * const pPool
+                 , mem_arena_t * const pArena
+                 , size_t sizeOfBlock
+                 , unsigned int noBlocks
+                 )
+{
+    /* A free block needs to hold the link to the next one. */
+    if(sizeOfBlock < sizeof(void*))
+        sizeOfBlock = sizeof(void*);
+    sizeOfBlock = (sizeOfBlock + (MEM_ALIGNMENT-1u)) & ~(size_t)(MEM_ALIGNMENT-1u);
+
+    /* An empty pool is useless and the size of the pool must not overflow. Both is
+       rejected before the arena is touched. (The rounding up of the block size could
+       have wrapped around, too.) */
+    if(noBlocks == 0  ||  sizeOfBlock == 0  ||  noBlocks > SIZE_MAX/sizeOfBlock)
+        return false;
+
+    uint8_t * const pMem = mem_allocArena(pArena, sizeOfBlock*noBlocks);
+    if(pMem == NULL)
+        return false;
+
+    /* Link all blocks in the list of free blocks. */
+    void **pLink = &pPool->pFreeList;
+    for(unsigned int u=0; u<noBlocks; ++u)
+    {
+        void * const pBlock = pMem + u*sizeOfBlock;
+        *pLink = pBlock;
+        pLink = (void**)pBlock;
+    }
+    *pLink = NULL;
+
+    pPool->pStart = pMem;
+    pPool->pEnd = pMem + sizeOfBlock*noBlocks;
+    pPool->sizeOfBlock = sizeOfBlock;
+    pPool->noBlocks = noBlocks;
+    pPool->noBlocksInUse = 0;
+    pPool->maxNoBlocksInUse = 0;
+    pPool->noFailedAllocations = 0;
+
+    return true;
+
+} /* End of mem_initPool */
+
+
+
+/**
+ * Allocate a block from a pool. The operation is done in constant time.
+ *   @return
+ * Get the block or NULL if all blocks of the pool are in use. The block is aligned to
+ * #MEM_ALIGNMENT Byte and its contents are undefined.
+ *   @param pPool
+ * The pool to allocate from. It needs to belong to the calling process.
+ */
+void *mem_allocBlock(mem_pool_t * const pPool)
+{
+    void * const pBlock = pPool->pFreeList;
+    if(pBlock != NULL)
+    {
+        pPool->pFreeList = *(void**)pBlock;
+        if(++pPool->noBlocksInUse > pPool->maxNoBlocksInUse)
+            pPool->maxNoBlocksInUse = pPool->noBlocksInUse;
+    }
+    else
+        ++ pPool->noFailedAllocations;
+
+    return pBlock;
+
+} /* End of mem_allocBlock */
+
+
+
+/**
+ * Return a block to its pool. The operation is done in constant time.
+ *   @param pPool
+ * The pool, the block had been allocated from.
+ *   @param pBlock
+ * The block to release. It needs to have been returned by mem_allocBlock() for the same
+ * pool and it must not be used after release. NULL is permitted and ignored.
+ */
+void mem_freeBlock(mem_pool_t * const pPool, void * const pBlock)
+{
+    if(pBlock == NULL)
+        return;
+
+    /* Catch the use with the wrong pool or a bad pointer. */
+    assert((uint8_t*)pBlock >= pPool->pStart  &&  (uint8_t*)pBlock < pPool->pEnd
+           &&  ((uintptr_t)((uint8_t*)pBlock - pPool->pStart) % pPool->sizeOfBlock) == 0
+           &&  pPool->noBlocksInUse > 0
+          );
+
+    *(void**)pBlock = pPool->pFreeList;
+    pPool->pFreeList = pBlock;
+    -- pPool->noBlocksInUse;
+
+} /* End of mem_freeBlock */
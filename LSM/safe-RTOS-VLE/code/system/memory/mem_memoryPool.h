@@ -0,0 +1,146 @@
+#ifndef MEM_MEMORYPOOL_INCLUDED
+#define MEM_MEMORYPOOL_INCLUDED
+/**
+ * @file mem_memoryPool.h
+ * Definition of global interface of module mem_memoryPool.c
+ *
+ * Copyright (C) 2020 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rtos.h"
+
+
+/*
+ * Defines
+ */
+
+/** The alignment of all memory chunks, which are returned by the allocation functions. 8
+    Byte suffices for all data types, including double and the 64 Bit SPE data types. */
+#define MEM_ALIGNMENT   8u
+
+
+/*
+ * Global type definitions
+ */
+
+/** The memory arena of a process. It's a private RAM area of the process, which is
+    reserved by the linker and which is given away piece by piece. The arena object itself
+    is located in the RAM of its process, too; no other process can modify it. */
+typedef struct mem_arena_t
+{
+    /** The beginning of the arena. */
+    uint8_t * const pStart;
+
+    /** The end of the arena; first address outside. */
+    uint8_t * const pEnd;
+
+    /** The next free address. */
+    uint8_t *pNext;
+
+    /** Statistics: The number of successful allocations. */
+    unsigned long noAllocations;
+
+    /** Statistics: The number of allocation requests, which could not be satisfied. */
+    unsigned long noFailedAllocations;
+
+} mem_arena_t;
+
+
+/** A pool of fixed size memory blocks. Allocation and release of blocks are O(1)
+    operations and there is no fragmentation. The memory of the pool is taken from a
+    process arena. */
+typedef struct mem_pool_t
+{
+    /** The head of the linked list of free blocks. The first word of a free block points
+        to the next free block. */
+    void *pFreeList;
+
+    /** The beginning and the end of the memory area of the pool. Used for the validation
+        of released blocks. */
+    uint8_t *pStart, *pEnd;
+
+    /** The size of a block in Byte, a multiple of #MEM_ALIGNMENT. */
+    unsigned int sizeOfBlock;
+
+    /** The number of blocks of the pool. */
+    unsigned int noBlocks;
+
+    /** Statistics: The number of currently allocated blocks. */
+    unsigned int noBlocksInUse;
+
+    /** Statistics: The maximum number of simultaneously allocated blocks since
+        initialization of the pool. */
+    unsigned int maxNoBlocksInUse;
+
+    /** Statistics: The number of allocation requests, which could not be satisfied. */
+    unsigned long noFailedAllocations;
+
+} mem_pool_t;
+
+
+/*
+ * Global data declarations
+ */
+
+/** The memory arena of process 1. */
+extern mem_arena_t mem_arenaP1;
+
+/** The memory arena of process 2. */
+extern mem_arena_t mem_arenaP2;
+
+/** The memory arena of process 3. */
+extern mem_arena_t mem_arenaP3;
+
+/** The memory arena of process 4. */
+extern mem_arena_t mem_arenaP4;
+
+/** The arenas of all processes, indexed by PID. Entry 0 is unused. Only a task of the
+    owning process may allocate from an arena but any process can read the statistics. */
+extern mem_arena_t * const mem_arenaByPIDAry[1+RTOS_NO_PROCESSES];
+
+
+/*
+ * Global prototypes
+ */
+
+/** Allocate memory from a process arena. */
+void *mem_allocArena(mem_arena_t * const pArena, size_t noBytes);
+
+/** Get the number of still unused bytes of a process arena. */
+size_t mem_getNoBytesFreeArena(const mem_arena_t * const pArena);
+
+/** Create a pool of fixed size blocks in a process arena. */
+bool mem_initPool( mem_pool_t * const pPool
+                 , mem_arena_t * const pArena
+                 , size_t sizeOfBlock
+                 , unsigned int noBlocks
+                 );
+
+/** Allocate a block from a pool. */
+void *mem_allocBlock(mem_pool_t * const pPool);
+
+/** Return a block to its pool. */
+void mem_freeBlock(mem_pool_t * const pPool, void * const pBlock);
+
+#endif  /* MEM_MEMORYPOOL_INCLUDED */
@@ -370,6 +370,7 @@ $(targetDir)obj/listOfObjFiles.txt: $(objListWithPath)
 lFlags = -Wl,-Tmakefile/linkerControlFile.ld -Wl,--gc-sections $(targetFlags)               \
          -Wl,-sort-common -Wl,-Map="$(targetDir)$(target).map" -Wl,--cref                   \
          -Wl,--warn-common,--warn-once,--orphan-handling=warn -Wl,-g                        \
+         $(foreach sym,$(ldSymbolList),-Wl,--defsym=$(sym))                                 \
          $(cClibSpec)
 
 $(targetDir)$(target).elf: $(targetDir)obj/listOfObjFiles.txt makefile/linkerControlFile.ld